@@ -0,0 +1,840 @@
+#include "BuildState.h"
+
+#include <cstdio>
+#include <fstream>
+#include <utime.h>
+
+#include "hashtk/HashTk.h"
+
+#if defined _WIN32 || defined _WIN64
+#else  //*nix
+	#include <sys/mman.h>
+#endif
+
+BuildState buildState;
+
+const std::string BSTATE_MAGIC = std::string("NIFTBS\0\1", 8);
+
+DepFingerprint::DepFingerprint()
+{
+	mtime = size = -1;
+	hash = 0;
+	hashed = 0;
+}
+
+PageRecord::PageRecord()
+{
+	builtTime = 0;
+}
+
+long long mtime_ns(const struct stat& sb)
+{
+	#if defined _WIN32 || defined _WIN64
+		return (long long)sb.st_mtime*1000000000LL;
+	#elif defined __APPLE__
+		return (long long)sb.st_mtimespec.tv_sec*1000000000LL + sb.st_mtimespec.tv_nsec;
+	#else  //*nix
+		return (long long)sb.st_mtim.tv_sec*1000000000LL + sb.st_mtim.tv_nsec;
+	#endif
+}
+
+int stat_fingerprint(const std::string& pathStr, long long& mtime, long long& size)
+{
+	struct stat sb;
+	if(stat(pathStr.c_str(), &sb))
+		return 1;
+
+	mtime = mtime_ns(sb);
+	size = sb.st_size;
+
+	return 0;
+}
+
+void set_modified_time(const std::string& pathStr, const time_t& modTime)
+{
+	struct utimbuf times;
+	times.actime = times.modtime = modTime;
+	utime(pathStr.c_str(), &times);
+}
+
+int write_info_file(const Path& infoPath,
+                    const std::string& lastBuilt,
+                    const std::string& name,
+                    const std::string& title,
+                    const std::string& templatePath,
+                    const std::vector<std::string>& deps)
+{
+	//makes sure info file exists
+	infoPath.ensureDirExists();
+
+	//makes sure we can write to info file
+	chmod(infoPath.str().c_str(), 0644);
+
+	std::ofstream infoStream(infoPath.str());
+	infoStream << "{\n";
+	infoStream << "\t\"last-built\": \"" << lastBuilt << "\",\n";
+	infoStream << "\t\"name\": \"" << name << "\",\n";
+	infoStream << "\t\"title\": \"" << title << "\",\n";
+	infoStream << "\t\"template\": \"" << templatePath << "\",\n";
+
+	infoStream << "\t\"dependencies\": [\n";
+	for(size_t d=0; d<deps.size(); ++d)
+	{
+		if(d)
+			infoStream << ",\n";
+		infoStream << "\t\t\"" << deps[d] << "\"";
+	}
+	infoStream << "\n\t]\n";
+	infoStream << "}";
+	infoStream.close();
+
+	//makes sure user can't accidentally write to info file
+	chmod(infoPath.str().c_str(), 0444);
+
+	return 0;
+}
+
+static void put_u32(std::string& buf, const unsigned int& val)
+{
+	for(int b=0; b<4; ++b)
+		buf += (char)((val >> 8*b) & 0xff);
+}
+
+static void put_i64(std::string& buf, const long long& val)
+{
+	unsigned long long uval = val;
+	for(int b=0; b<8; ++b)
+		buf += (char)((uval >> 8*b) & 0xff);
+}
+
+static void put_str(std::string& buf, const std::string& str)
+{
+	put_u32(buf, str.size());
+	buf += str;
+}
+
+static void put_record(std::string& buf, const char& tag, const std::string& payload)
+{
+	buf += tag;
+	put_u32(buf, payload.size());
+	buf += payload;
+}
+
+//reads fields back out of a record payload, fails once it runs out of bytes
+struct RecordReader
+{
+	const char *pos, *end;
+
+	RecordReader(const char* Pos, const char* End)
+	{
+		pos = Pos;
+		end = End;
+	}
+
+	bool get_u32(unsigned int& val)
+	{
+		if(end - pos < 4)
+			return 0;
+		val = 0;
+		for(int b=0; b<4; ++b)
+			val |= (unsigned int)(unsigned char)pos[b] << 8*b;
+		pos += 4;
+		return 1;
+	}
+
+	bool get_i64(long long& val)
+	{
+		if(end - pos < 8)
+			return 0;
+		unsigned long long uval = 0;
+		for(int b=0; b<8; ++b)
+			uval |= (unsigned long long)(unsigned char)pos[b] << 8*b;
+		val = uval;
+		pos += 8;
+		return 1;
+	}
+
+	bool get_str(std::string& str)
+	{
+		unsigned int len;
+		if(!get_u32(len) || (size_t)(end - pos) < len)
+			return 0;
+		str = std::string(pos, len);
+		pos += len;
+		return 1;
+	}
+};
+
+//writes bytes to path, truncating at offset and appending when offset >= 0
+static int write_bytes(const std::string& pathStr, const std::string& bytes, const long long& offset)
+{
+	#if defined _WIN32 || defined _WIN64
+		std::ofstream ofs;
+		if(offset < 0)
+			ofs.open(pathStr, std::ios::binary | std::ios::trunc);
+		else
+			ofs.open(pathStr, std::ios::binary | std::ios::in | std::ios::out);
+		if(!ofs.is_open())
+			return 1;
+		if(offset >= 0)
+			ofs.seekp(offset);
+		ofs.write(bytes.c_str(), bytes.size());
+		ofs.close();
+		return !ofs;
+	#else  //*nix
+		int flags = O_WRONLY | O_CREAT;
+		if(offset < 0)
+			flags |= O_TRUNC;
+		int fd = ::open(pathStr.c_str(), flags, 0644);
+		if(fd < 0)
+			return 1;
+		if(offset >= 0 && (ftruncate(fd, offset) || lseek(fd, offset, SEEK_SET) < 0))
+		{
+			close(fd);
+			return 1;
+		}
+
+		size_t written = 0;
+		while(written < bytes.size())
+		{
+			ssize_t n = write(fd, bytes.c_str() + written, bytes.size() - written);
+			if(n < 0)
+			{
+				close(fd);
+				return 1;
+			}
+			written += n;
+		}
+
+		int result = fsync(fd);
+		close(fd);
+		return result != 0;
+	#endif
+}
+
+BuildState::BuildState()
+{
+	enabled = loaded = 0;
+	dbPath = Path(".nift/", "build-state.db");
+	noFileRecords = validSize = 0;
+}
+
+void BuildState::clear()
+{
+	loaded = 0;
+	paths.clear();
+	pathIds.clear();
+	fingerprints.clear();
+	pages.clear();
+	dependents.clear();
+	oldestBuilt.clear();
+	pending.clear();
+	noFileRecords = validSize = 0;
+}
+
+int BuildState::open(std::ostream& eos)
+{
+	if(loaded)
+		return 0;
+
+	bool corrupt;
+	if(read(eos, corrupt))
+		return 1;
+
+	if(corrupt)
+	{
+		start_warn(eos, dbPath) << "build state database is corrupt, all tracked files will be rebuilt" << std::endl;
+		clear();
+		loaded = 1;
+	}
+	else
+		reindex();
+
+	return 0;
+}
+
+//replays committed records from dbPath, without building the reverse index
+int BuildState::read(std::ostream& eos, bool& corrupt)
+{
+	clear();
+	loaded = 1;
+	corrupt = 0;
+
+	std::string dbPathStr = dbPath.str();
+	if(!file_exists(dbPathStr))
+		return 0;
+
+	const char* data = NULL;
+	size_t dataSize = 0;
+
+	#if defined _WIN32 || defined _WIN64
+		std::ifstream ifs(dbPathStr, std::ios::binary);
+		std::string contents((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+		ifs.close();
+		data = contents.c_str();
+		dataSize = contents.size();
+	#else  //*nix
+		int fd = ::open(dbPathStr.c_str(), O_RDONLY);
+		struct stat sb;
+		if(fd < 0 || fstat(fd, &sb))
+		{
+			if(fd >= 0)
+				close(fd);
+			start_err(eos, dbPath) << "failed to open build state database" << std::endl;
+			return 1;
+		}
+		dataSize = sb.st_size;
+		void* mapped = MAP_FAILED;
+		if(dataSize)
+			mapped = mmap(NULL, dataSize, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if(dataSize && mapped == MAP_FAILED)
+		{
+			start_err(eos, dbPath) << "failed to map build state database" << std::endl;
+			return 1;
+		}
+		if(dataSize)
+			data = (const char*)mapped;
+	#endif
+
+	if(dataSize < BSTATE_MAGIC.size() || std::string(data, BSTATE_MAGIC.size()) != BSTATE_MAGIC)
+		corrupt = 1;
+	else
+	{
+		//finds end of last committed batch of records
+		size_t pos = BSTATE_MAGIC.size(), noRecords = 0;
+		validSize = pos;
+		while(dataSize - pos >= 5)
+		{
+			RecordReader header(data + pos + 1, data + pos + 5);
+			unsigned int len;
+			header.get_u32(len);
+			if(dataSize - pos - 5 < len)
+				break;
+			pos += 5 + len;
+			if(data[pos - 5 - len] == 'C')
+			{
+				validSize = pos;
+				noFileRecords = noRecords;
+			}
+			else
+				++noRecords;
+		}
+
+		//replays committed records
+		pos = BSTATE_MAGIC.size();
+		while(!corrupt && pos < validSize)
+		{
+			char tag = data[pos];
+			unsigned int len;
+			RecordReader(data + pos + 1, data + pos + 5).get_u32(len);
+			RecordReader rr(data + pos + 5, data + pos + 5 + len);
+			pos += 5 + len;
+
+			if(tag == 'P')
+			{
+				unsigned int id;
+				std::string pathStr;
+				//ids are handed out in order, so one past the end is the most a record can add
+				if(!rr.get_u32(id) || id > paths.size() || !rr.get_str(pathStr))
+					corrupt = 1;
+				else
+				{
+					if(id == paths.size())
+					{
+						paths.resize(id+1);
+						fingerprints.resize(id+1);
+					}
+					paths[id] = pathStr;
+					pathIds[pathStr] = id;
+				}
+			}
+			else if(tag == 'H')
+			{
+				unsigned int id, hashed;
+				DepFingerprint fp;
+				if(!rr.get_u32(id) || id >= paths.size() ||
+				   !rr.get_i64(fp.mtime) || !rr.get_i64(fp.size) ||
+				   !rr.get_u32(fp.hash) || !rr.get_u32(hashed))
+					corrupt = 1;
+				else
+				{
+					fp.hashed = hashed;
+					fingerprints[id] = fp;
+				}
+			}
+			else if(tag == 'R')
+			{
+				std::string key;
+				PageRecord record;
+				unsigned int noDeps, id;
+				if(!rr.get_str(key) || !rr.get_str(record.name) || !rr.get_str(record.title) ||
+				   !rr.get_str(record.templatePath) || !rr.get_i64(record.builtTime) || !rr.get_u32(noDeps))
+					corrupt = 1;
+				for(unsigned int d=0; !corrupt && d<noDeps; ++d)
+				{
+					if(!rr.get_u32(id) || id >= paths.size())
+						corrupt = 1;
+					else
+						record.deps.push_back(id);
+				}
+				if(!corrupt)
+					pages[key] = record;
+			}
+			else if(tag == 'X')
+			{
+				std::string key;
+				if(!rr.get_str(key))
+					corrupt = 1;
+				else
+					pages.erase(key);
+			}
+			else if(tag != 'C')
+				corrupt = 1;
+		}
+	}
+
+	#if defined _WIN32 || defined _WIN64
+	#else  //*nix
+		if(dataSize)
+			munmap((void*)data, dataSize);
+	#endif
+
+	return 0;
+}
+
+unsigned int BuildState::intern(const std::string& pathStr)
+{
+	auto found = pathIds.find(pathStr);
+	if(found != pathIds.end())
+		return found->second;
+
+	unsigned int id = paths.size();
+	paths.push_back(pathStr);
+	pathIds[pathStr] = id;
+	fingerprints.push_back(DepFingerprint());
+	dependents.push_back(std::unordered_set<const std::string*>());
+	oldestBuilt.push_back(0);
+
+	std::string payload;
+	put_u32(payload, id);
+	put_str(payload, pathStr);
+	put_record(pending, 'P', payload);
+	++noFileRecords;
+
+	return id;
+}
+
+void BuildState::index_page(const std::string* key, const PageRecord& record)
+{
+	for(size_t d=0; d<record.deps.size(); ++d)
+	{
+		unsigned int id = record.deps[d];
+		if(!dependents[id].size() || record.builtTime < oldestBuilt[id])
+			oldestBuilt[id] = record.builtTime;
+		dependents[id].insert(key);
+	}
+}
+
+//leaves oldestBuilt alone, it only needs to be a lower bound
+void BuildState::unindex_page(const std::string* key, const PageRecord& record)
+{
+	for(size_t d=0; d<record.deps.size(); ++d)
+		dependents[record.deps[d]].erase(key);
+}
+
+void BuildState::reindex()
+{
+	dependents.clear();
+	dependents.resize(paths.size());
+	oldestBuilt.clear();
+	oldestBuilt.resize(paths.size(), 0);
+
+	for(auto page=pages.begin(); page!=pages.end(); ++page)
+		index_page(&page->first, page->second);
+}
+
+//replaces record for page, keeping reverse index up to date
+void BuildState::put_page(const std::string& key, const PageRecord& record)
+{
+	auto page = pages.find(key);
+	if(page == pages.end())
+		page = pages.insert(std::make_pair(key, record)).first;
+	else
+	{
+		unindex_page(&page->first, page->second);
+		page->second = record;
+	}
+	index_page(&page->first, page->second);
+
+	encode_page(pending, key, record);
+	++noFileRecords;
+}
+
+void BuildState::encode_page(std::string& buf, const std::string& key, const PageRecord& record)
+{
+	std::string payload;
+	put_str(payload, key);
+	put_str(payload, record.name);
+	put_str(payload, record.title);
+	put_str(payload, record.templatePath);
+	put_i64(payload, record.builtTime);
+	put_u32(payload, record.deps.size());
+	for(size_t d=0; d<record.deps.size(); ++d)
+		put_u32(payload, record.deps[d]);
+	put_record(buf, 'R', payload);
+}
+
+void BuildState::encode_fingerprint(std::string& buf, const unsigned int& id, const DepFingerprint& fp)
+{
+	std::string payload;
+	put_u32(payload, id);
+	put_i64(payload, fp.mtime);
+	put_i64(payload, fp.size);
+	put_u32(payload, fp.hash);
+	put_u32(payload, fp.hashed);
+	put_record(buf, 'H', payload);
+}
+
+int BuildState::commit(const std::set<TrackedInfo>& trackedAll, std::ostream& eos)
+{
+	mtx.lock();
+
+	//drops records of pages that are no longer tracked
+	std::set<std::string> trackedOutputPaths;
+	for(auto cInfo=trackedAll.begin(); cInfo!=trackedAll.end(); ++cInfo)
+		trackedOutputPaths.insert(cInfo->outputPath.str());
+	for(auto page=pages.begin(); page!=pages.end();)
+	{
+		if(!trackedOutputPaths.count(page->first))
+		{
+			std::string payload;
+			put_str(payload, page->first);
+			put_record(pending, 'X', payload);
+			++noFileRecords;
+			unindex_page(&page->first, page->second);
+			page = pages.erase(page);
+		}
+		else
+			++page;
+	}
+
+	size_t noLiveRecords = paths.size() + pages.size();
+	for(size_t f=0; f<fingerprints.size(); ++f)
+		if(fingerprints[f].hashed)
+			++noLiveRecords;
+
+	bool needsCompacting = !file_exists(dbPath.str()) || validSize == 0 || noFileRecords > 2*noLiveRecords;
+	#if defined _WIN32 || defined _WIN64
+		needsCompacting = 1;
+	#endif
+
+	if(needsCompacting)
+	{
+		mtx.unlock();
+		return compact(eos);
+	}
+	else if(pending.size())
+	{
+		put_record(pending, 'C', "");
+		if(write_bytes(dbPath.str(), pending, validSize))
+		{
+			mtx.unlock();
+			start_err(eos, dbPath) << "failed to write to build state database" << std::endl;
+			return 1;
+		}
+		validSize += pending.size();
+		pending.clear();
+	}
+
+	mtx.unlock();
+
+	return 0;
+}
+
+int BuildState::compact(std::ostream& eos)
+{
+	mtx.lock();
+
+	//renumbers paths so only those still used by a page are kept
+	std::vector<std::string> newPaths;
+	std::unordered_map<std::string, unsigned int> newPathIds;
+	std::vector<DepFingerprint> newFingerprints;
+	std::vector<unsigned int> newIds(paths.size(), (unsigned int)-1);
+
+	for(auto page=pages.begin(); page!=pages.end(); ++page)
+	{
+		for(size_t d=0; d<page->second.deps.size(); ++d)
+		{
+			unsigned int& id = page->second.deps[d];
+			if(newIds[id] == (unsigned int)-1)
+			{
+				newIds[id] = newPaths.size();
+				newPathIds[paths[id]] = newPaths.size();
+				newPaths.push_back(paths[id]);
+				newFingerprints.push_back(fingerprints[id]);
+			}
+			id = newIds[id];
+		}
+	}
+
+	paths.swap(newPaths);
+	pathIds.swap(newPathIds);
+	fingerprints.swap(newFingerprints);
+	reindex();
+
+	std::string data = BSTATE_MAGIC, payload;
+	noFileRecords = 0;
+	for(size_t p=0; p<paths.size(); ++p)
+	{
+		payload.clear();
+		put_u32(payload, p);
+		put_str(payload, paths[p]);
+		put_record(data, 'P', payload);
+		++noFileRecords;
+
+		if(fingerprints[p].hashed)
+		{
+			encode_fingerprint(data, p, fingerprints[p]);
+			++noFileRecords;
+		}
+	}
+	for(auto page=pages.begin(); page!=pages.end(); ++page)
+	{
+		encode_page(data, page->first, page->second);
+		++noFileRecords;
+	}
+	put_record(data, 'C', "");
+
+	pending.clear();
+	validSize = data.size();
+
+	mtx.unlock();
+
+	//writes to temporary file then renames over database so it's never half written
+	std::string tmpPathStr = dbPath.str() + ".tmp";
+	dbPath.ensureDirExists();
+	if(write_bytes(tmpPathStr, data, -1))
+	{
+		start_err(eos, dbPath) << "failed to write build state database" << std::endl;
+		return 1;
+	}
+	#if defined _WIN32 || defined _WIN64
+		remove(dbPath.str().c_str());
+	#endif
+	if(rename(tmpPathStr.c_str(), dbPath.str().c_str()))
+	{
+		start_err(eos, dbPath) << "failed to replace build state database" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+//merges pages from a shard's build state, along with fingerprints of their dependencies
+int BuildState::merge(const Path& fragmentPath, const std::set<TrackedInfo>& trackedAll, std::ostream& eos)
+{
+	if(!file_exists(fragmentPath.str()))
+	{
+		start_err(eos, fragmentPath) << "build state fragment does not exist" << std::endl;
+		return 1;
+	}
+
+	BuildState fragment;
+	fragment.enabled = 1;
+	fragment.dbPath = fragmentPath;
+	bool corrupt;
+	if(fragment.read(eos, corrupt))
+		return 1;
+
+	//records of the shard's pages are dropped so they get rebuilt
+	if(corrupt)
+	{
+		int shard, noShards;
+		bool fromShard = parse_shard_state_path(fragmentPath, shard, noShards);
+
+		if(fromShard)
+			start_err(eos, fragmentPath) << "build state fragment is corrupt, tracked files from shard " << shard << "/" << noShards << " will be rebuilt" << std::endl;
+		else
+			start_err(eos, fragmentPath) << "build state fragment is corrupt, all tracked files will be rebuilt" << std::endl;
+
+		for(auto cInfo=trackedAll.begin(); cInfo!=trackedAll.end(); ++cInfo)
+			if(!fromShard || FNVHash(cInfo->name) % noShards == (unsigned int)(shard-1))
+				erase_page(cInfo->outputPath);
+
+		return 1;
+	}
+
+	mtx.lock();
+	for(auto page=fragment.pages.begin(); page!=fragment.pages.end(); ++page)
+	{
+		PageRecord record = page->second;
+		for(size_t d=0; d<record.deps.size(); ++d)
+		{
+			unsigned int fragId = record.deps[d];
+			unsigned int id = intern(fragment.paths[fragId]);
+			const DepFingerprint& fp = fragment.fingerprints[fragId];
+
+			//shards sharing a dependency should have the same hash, keeps the most recent
+			if(fp.hashed && (!fingerprints[id].hashed || fp.mtime >= fingerprints[id].mtime))
+			{
+				fingerprints[id] = fp;
+				encode_fingerprint(pending, id, fp);
+				++noFileRecords;
+			}
+			record.deps[d] = id;
+		}
+		put_page(page->first, record);
+	}
+	mtx.unlock();
+
+	return 0;
+}
+
+Path shard_state_path(const int& shard, const int& noShards)
+{
+	return Path(".nift/", "build-state.shard-" + std::to_string(shard) + "-of-" + std::to_string(noShards) + ".db");
+}
+
+//gets shard i/n back from the name of a fragment written by build-all --shard i/n
+bool parse_shard_state_path(const Path& fragmentPath, int& shard, int& noShards)
+{
+	char end[4];
+	return std::sscanf(fragmentPath.file.c_str(), "build-state.shard-%d-of-%d%3s", &shard, &noShards, end) == 3 &&
+	       std::string(end) == ".db" && shard >= 1 && shard <= noShards;
+}
+
+bool BuildState::get_page(const Path& outputPath, PageRecord& record)
+{
+	mtx.lock();
+	auto page = pages.find(outputPath.str());
+	if(page == pages.end())
+	{
+		mtx.unlock();
+		return 0;
+	}
+	record = page->second;
+	mtx.unlock();
+
+	return 1;
+}
+
+bool BuildState::get_page(const Path& outputPath, PageRecord& record, std::vector<Path>& deps)
+{
+	mtx.lock();
+	auto page = pages.find(outputPath.str());
+	if(page == pages.end())
+	{
+		mtx.unlock();
+		return 0;
+	}
+	record = page->second;
+	deps.clear();
+	for(size_t d=0; d<record.deps.size(); ++d)
+		deps.push_back(Path(paths[record.deps[d]]));
+	mtx.unlock();
+
+	return 1;
+}
+
+void BuildState::set_page(const TrackedInfo& info, const std::set<Path>& deps)
+{
+	PageRecord record;
+	record.name = info.name;
+	record.title = unquote(info.title.str);
+	record.templatePath = info.templatePath.str();
+	record.builtTime = time(NULL);
+
+	std::string key = info.outputPath.str();
+
+	mtx.lock();
+	for(auto dep=deps.begin(); dep!=deps.end(); ++dep)
+		record.deps.push_back(intern(dep->str()));
+	put_page(key, record);
+	mtx.unlock();
+}
+
+void BuildState::set_page(const std::string& outputPathStr,
+                          const PageRecord& record,
+                          const std::vector<std::string>& deps)
+{
+	PageRecord newRecord = record;
+	newRecord.deps.clear();
+
+	mtx.lock();
+	for(size_t d=0; d<deps.size(); ++d)
+		newRecord.deps.push_back(intern(deps[d]));
+	put_page(outputPathStr, newRecord);
+	mtx.unlock();
+}
+
+void BuildState::erase_page(const Path& outputPath)
+{
+	mtx.lock();
+	auto page = pages.find(outputPath.str());
+	if(page != pages.end())
+	{
+		unindex_page(&page->first, page->second);
+		pages.erase(page);
+
+		std::string payload;
+		put_str(payload, outputPath.str());
+		put_record(pending, 'X', payload);
+		++noFileRecords;
+	}
+	mtx.unlock();
+}
+
+bool BuildState::get_fingerprint(const Path& path, DepFingerprint& fp)
+{
+	mtx.lock();
+	auto found = pathIds.find(path.str());
+	if(found == pathIds.end() || !fingerprints[found->second].hashed)
+	{
+		mtx.unlock();
+		return 0;
+	}
+	fp = fingerprints[found->second];
+	mtx.unlock();
+
+	return 1;
+}
+
+void BuildState::set_hash(const Path& path, const unsigned int& hash)
+{
+	DepFingerprint fp;
+	stat_fingerprint(path.str(), fp.mtime, fp.size);
+	fp.hash = hash;
+	fp.hashed = 1;
+
+	set_fingerprint(path, fp);
+}
+
+void BuildState::set_fingerprint(const Path& path, const DepFingerprint& fp)
+{
+	mtx.lock();
+	unsigned int id = intern(path.str());
+	DepFingerprint& oldFp = fingerprints[id];
+	if(oldFp.hashed != fp.hashed || oldFp.hash != fp.hash || oldFp.mtime != fp.mtime || oldFp.size != fp.size)
+	{
+		oldFp = fp;
+		encode_fingerprint(pending, id, fp);
+		++noFileRecords;
+	}
+	mtx.unlock();
+}
+
+void BuildState::clear_hashes()
+{
+	mtx.lock();
+	for(size_t f=0; f<fingerprints.size(); ++f)
+	{
+		if(fingerprints[f].hashed)
+		{
+			fingerprints[f] = DepFingerprint();
+			encode_fingerprint(pending, f, fingerprints[f]);
+			++noFileRecords;
+		}
+	}
+	mtx.unlock();
+}
@@ -0,0 +1,115 @@
+#ifndef BUILD_STATE_H_
+#define BUILD_STATE_H_
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "FileSystem.h"
+#include "TrackedInfo.h"
+
+//fingerprint of a dependency from when it was last hashed
+struct DepFingerprint
+{
+	long long mtime, size; //mtime in nanoseconds
+	unsigned int hash;
+	bool hashed;
+
+	DepFingerprint();
+};
+
+//what was recorded about a page the last time it was built
+struct PageRecord
+{
+	std::string name, title, templatePath;
+	long long builtTime; //seconds, compared against st_mtime of dependencies
+	std::vector<unsigned int> deps; //interned path ids
+
+	PageRecord();
+};
+
+long long mtime_ns(const struct stat& sb);
+int stat_fingerprint(const std::string& pathStr, long long& mtime, long long& size);
+void set_modified_time(const std::string& pathStr, const time_t& modTime);
+
+Path shard_state_path(const int& shard, const int& noShards);
+bool parse_shard_state_path(const Path& fragmentPath, int& shard, int& noShards);
+
+int write_info_file(const Path& infoPath,
+                    const std::string& lastBuilt,
+                    const std::string& name,
+                    const std::string& title,
+                    const std::string& templatePath,
+                    const std::vector<std::string>& deps);
+
+/*
+	single file alternative to per-page .info.json files and per-dependency
+	.hash files, used when "build-state" is set to "database" in the config.
+	also keeps a reverse index from each dependency to the pages depending
+	on it so changed dependencies can be expanded to the affected pages.
+
+	.nift/build-state.db is a log of tagged records. commits append the
+	records changed since the previous commit followed by a commit marker,
+	when loading anything after the last commit marker is ignored so an
+	interrupted build leaves the previous state intact. once stale records
+	outnumber live ones the file is compacted to a temporary file which is
+	then renamed over the original.
+
+	sharded builds (build-all --shard i/n) write the same format to
+	.nift/build-state.shard-i-of-n.db holding just their own pages, which
+	merge-build-state folds back into the main database. a corrupt fragment
+	is an error, and the pages of its shard are dropped so they get rebuilt.
+*/
+struct BuildState
+{
+	bool enabled, loaded;
+	std::mutex mtx;
+	Path dbPath;
+
+	std::vector<std::string> paths;
+	std::unordered_map<std::string, unsigned int> pathIds;
+	std::vector<DepFingerprint> fingerprints; //indexed by path id
+	std::unordered_map<std::string, PageRecord> pages; //keyed by output path
+
+	//reverse dependency index, pages are referred to by their keys in pages
+	std::vector<std::unordered_set<const std::string*> > dependents; //indexed by path id
+	std::vector<long long> oldestBuilt; //no later than when any dependent page was built
+
+	std::string pending; //records encoded since the last commit
+	size_t noFileRecords, validSize;
+
+	BuildState();
+
+	void clear();
+	int open(std::ostream& eos);
+	int read(std::ostream& eos, bool& corrupt);
+	int commit(const std::set<TrackedInfo>& trackedAll, std::ostream& eos);
+	int compact(std::ostream& eos);
+	int merge(const Path& fragmentPath, const std::set<TrackedInfo>& trackedAll, std::ostream& eos);
+
+	bool get_page(const Path& outputPath, PageRecord& record);
+	bool get_page(const Path& outputPath, PageRecord& record, std::vector<Path>& deps);
+	void set_page(const TrackedInfo& info, const std::set<Path>& deps);
+	void set_page(const std::string& outputPathStr,
+	              const PageRecord& record,
+	              const std::vector<std::string>& deps);
+	void erase_page(const Path& outputPath);
+
+	bool get_fingerprint(const Path& path, DepFingerprint& fp);
+	void set_hash(const Path& path, const unsigned int& hash);
+	void set_fingerprint(const Path& path, const DepFingerprint& fp);
+	void clear_hashes();
+
+	//below assume mtx is already locked
+	unsigned int intern(const std::string& pathStr);
+	void index_page(const std::string* key, const PageRecord& record);
+	void unindex_page(const std::string* key, const PageRecord& record);
+	void reindex();
+	void put_page(const std::string& key, const PageRecord& record);
+	void encode_page(std::string& buf, const std::string& key, const PageRecord& record);
+	void encode_fingerprint(std::string& buf, const unsigned int& id, const DepFingerprint& fp);
+};
+
+extern BuildState buildState;
+
+#endif //BUILD_STATE_H_
@@ -0,0 +1,318 @@
+#include "BuildWatcher.h"
+
+#if defined __linux__
+
+#include <cerrno>
+
+const uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB | IN_CREATE | IN_DELETE |
+                            IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+
+//reads recorded dependencies from page info file, quietly giving up on anything malformed
+void read_info_deps(const Path& infoPath, std::vector<Path>& deps)
+{
+	if(!file_exists(infoPath.str()))
+		return;
+
+	rapidjson::Document doc;
+	doc.Parse(string_from_file(infoPath.str()).c_str());
+
+	if(!doc.IsObject() || !doc.HasMember("dependencies") || !doc["dependencies"].IsArray())
+		return;
+
+	rapidjson::Value arr(rapidjson::kArrayType);
+	arr = doc["dependencies"].GetArray();
+
+	for(auto depStr=arr.Begin(); depStr!=arr.End(); ++depStr)
+		if(depStr->IsString())
+			deps.push_back(Path(depStr->GetString()));
+}
+
+BuildWatcher::BuildWatcher()
+{
+	fd = -1;
+	project = NULL;
+	reload = retrack = rewatch = 0;
+}
+
+BuildWatcher::~BuildWatcher()
+{
+	close();
+}
+
+int BuildWatcher::open(ProjectInfo* Project)
+{
+	project = Project;
+
+	fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if(fd < 0)
+		return 1;
+
+	return 0;
+}
+
+void BuildWatcher::close()
+{
+	if(fd >= 0)
+		::close(fd);
+	fd = -1;
+	watchedDirs.clear();
+}
+
+int BuildWatcher::add_dir(const Directory& dir)
+{
+	std::string dirStr = dir;
+	if(dirStr == "")
+		dirStr = ".";
+
+	if(!dir_exists(dirStr))
+		return 1;
+
+	//inotify hands back the existing watch descriptor for directories already watched
+	int wd = inotify_add_watch(fd, dirStr.c_str(), WATCH_MASK);
+	if(wd < 0)
+		return 1;
+	watchedDirs[wd] = dir;
+
+	return 0;
+}
+
+void BuildWatcher::index_page(const TrackedInfo& info)
+{
+	std::vector<Path> deps, recordedDeps;
+	Path depsPath = info.contentPath.getDepsPath();
+
+	deps.push_back(info.contentPath);
+	deps.push_back(info.templatePath);
+	deps.push_back(depsPath);
+
+	if(buildState.enabled)
+	{
+		PageRecord record;
+		if(buildState.get_page(info.outputPath, record, recordedDeps))
+			deps.insert(deps.end(), recordedDeps.begin(), recordedDeps.end());
+	}
+	else
+		read_info_deps(info.outputPath.getInfoPath(), deps);
+
+	//user-defined dependencies
+	if(file_exists(depsPath.str()))
+	{
+		rapidjson::Document doc;
+		doc.Parse(string_from_file(depsPath.str()).c_str());
+
+		if(doc.IsObject() && doc.HasMember("dependencies") && doc["dependencies"].IsArray())
+		{
+			rapidjson::Value arr(rapidjson::kArrayType);
+			arr = doc["dependencies"].GetArray();
+
+			for(auto depStr=arr.Begin(); depStr!=arr.End(); ++depStr)
+				if(depStr->IsString())
+					deps.push_back(Path(depStr->GetString()));
+		}
+	}
+
+	std::vector<std::string>& keys = pageDeps[info.name];
+	for(auto dep=deps.begin(); dep!=deps.end(); ++dep)
+	{
+		std::string key = dep->comparableStr();
+		dependents[key].insert(info.name);
+		keys.push_back(key);
+		add_dir(dep->dir);
+	}
+
+	outputPaths.insert(info.outputPath.comparableStr());
+}
+
+void BuildWatcher::unindex_page(const Name& name)
+{
+	auto page = pageDeps.find(name);
+	if(page == pageDeps.end())
+		return;
+
+	for(auto key=page->second.begin(); key!=page->second.end(); ++key)
+	{
+		auto dep = dependents.find(*key);
+		if(dep != dependents.end())
+		{
+			dep->second.erase(name);
+			if(!dep->second.size())
+				dependents.erase(dep);
+		}
+	}
+
+	pageDeps.erase(page);
+}
+
+void BuildWatcher::reindex(const std::vector<Name>& names)
+{
+	for(auto name=names.begin(); name!=names.end(); ++name)
+	{
+		unindex_page(*name);
+		if(project->tracking(*name))
+			index_page(project->get_info(*name));
+	}
+}
+
+int BuildWatcher::index_all()
+{
+	//drops all watches, inotify_rm_watch is not needed as watches on removed directories go with them
+	close();
+	fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if(fd < 0)
+		return 1;
+
+	dependents.clear();
+	pageDeps.clear();
+	outputPaths.clear();
+
+	add_dir(".nift/");
+	add_dir(".nift/.watch/");
+
+	wl.dirs.clear();
+	if(file_exists(".nift/.watch/watched.json") && wl.open())
+	{
+		start_err(std::cout) << "failed to open watch list '.nift/.watch/watched.json'" << std::endl;
+		return 1;
+	}
+	for(auto wd=wl.dirs.begin(); wd!=wl.dirs.end(); ++wd)
+		add_dir(wd->watchDir);
+
+	for(auto info=project->trackedAll.begin(); info!=project->trackedAll.end(); ++info)
+		index_page(*info);
+
+	reload = retrack = rewatch = 0;
+
+	return 0;
+}
+
+//whether a content file being added or removed at path changes what is tracked
+bool BuildWatcher::auto_tracked(const Path& path)
+{
+	size_t pos = path.file.find_last_of('.');
+	if(pos == std::string::npos)
+		return 0;
+	std::string ext = path.file.substr(pos, path.file.size()-pos);
+
+	for(auto wd=wl.dirs.begin(); wd!=wl.dirs.end(); ++wd)
+		if(comparable(wd->watchDir) == comparable(path.dir) && wd->contExts.count(ext))
+			return 1;
+
+	return 0;
+}
+
+void BuildWatcher::read_events(bool& pending)
+{
+	alignas(struct inotify_event) char buf[16384];
+	const struct inotify_event* event;
+	ssize_t len;
+
+	while((len = read(fd, buf, sizeof(buf))) > 0)
+	{
+		for(char* ptr=buf; ptr<buf+len; ptr+=sizeof(struct inotify_event)+event->len)
+		{
+			event = (const struct inotify_event*) ptr;
+
+			//events were dropped so we no longer know what changed
+			if(event->mask & IN_Q_OVERFLOW)
+			{
+				retrack = pending = 1;
+				continue;
+			}
+
+			auto wd = watchedDirs.find(event->wd);
+			if(wd == watchedDirs.end())
+				continue;
+
+			if(event->mask & IN_IGNORED)
+			{
+				//directory was removed or moved, it may come back so watches need refreshing
+				watchedDirs.erase(wd);
+				rewatch = 1;
+				continue;
+			}
+			else if(!event->len || (event->mask & IN_ISDIR))
+				continue;
+
+			Path path(wd->second, event->name);
+			std::string key = path.comparableStr();
+
+			if(key.substr(0, 6) == ".nift/")
+			{
+				if(key == ".nift/config.json" ||
+				   key == ".nift/tracked.json" ||
+				   key == ".nift/.watch/watched.json")
+					reload = pending = 1;
+			}
+			else if(outputPaths.count(key))
+				continue;
+			else if(dependents.count(key))
+			{
+				changed.insert(key);
+				pending = 1;
+			}
+			else if((event->mask & (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO)) && auto_tracked(path))
+				retrack = pending = 1;
+		}
+	}
+}
+
+/*
+	waits for changes to dependencies, returning once events have been
+	quiet for DEBOUNCE_MS or MAX_DEBOUNCE_MS after the first relevant one.
+	returns 1 if running is set to false before that.
+*/
+int BuildWatcher::wait_for_changes(const std::atomic<bool>& running)
+{
+	struct pollfd pfd;
+	pfd.fd = fd;
+	pfd.events = POLLIN;
+
+	Timer timer;
+	bool pending = 0;
+	int result;
+
+	changed.clear();
+
+	while(running)
+	{
+		result = poll(&pfd, 1, pending ? DEBOUNCE_MS : WATCH_POLL_MS);
+
+		if(result < 0 && errno != EINTR)
+			return 1;
+		else if(result > 0)
+		{
+			if(!pending)
+			{
+				read_events(pending);
+				if(pending)
+					timer.start();
+			}
+			else
+				read_events(pending);
+
+			if(pending && 1000*timer.getTime() >= MAX_DEBOUNCE_MS)
+				return 0;
+		}
+		else if(result == 0 && pending)
+			return 0;
+	}
+
+	return 1;
+}
+
+//names of tracked pages depending on changed paths
+std::vector<Name> BuildWatcher::changed_names()
+{
+	std::set<Name> names;
+
+	for(auto key=changed.begin(); key!=changed.end(); ++key)
+	{
+		auto dep = dependents.find(*key);
+		if(dep != dependents.end())
+			names.insert(dep->second.begin(), dep->second.end());
+	}
+
+	return std::vector<Name>(names.begin(), names.end());
+}
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef BUILD_WATCHER_H_
+#define BUILD_WATCHER_H_
+
+#include <map>
+
+#include "ProjectInfo.h"
+
+#if defined __linux__
+	#include <poll.h>
+	#include <sys/inotify.h>
+
+const int WATCH_POLL_MS = 200,     //how often to check whether to stop watching
+          DEBOUNCE_MS = 100,       //quiet period ending a burst of events
+          MAX_DEBOUNCE_MS = 1000;  //longest a burst of events can delay a build
+
+/*
+	watches the directories of content files, templates and recorded
+	dependencies along with the watch list directories using inotify
+	(directories rather than files so editors that save by renaming
+	are still picked up), keeping an index from dependency paths to the
+	names of the pages depending on them so build-auto only rebuilds the
+	pages affected by a change.
+*/
+struct BuildWatcher
+{
+	int fd;
+	ProjectInfo* project;
+	std::map<int, Directory> watchedDirs; //keyed by watch descriptor
+	std::map<std::string, std::set<Name> > dependents; //keyed by comparable path
+	std::map<Name, std::vector<std::string> > pageDeps;
+	std::set<std::string> outputPaths;
+	WatchList wl;
+
+	std::set<std::string> changed;
+	bool reload, retrack, rewatch;
+
+	BuildWatcher();
+	~BuildWatcher();
+
+	int open(ProjectInfo* Project);
+	void close();
+
+	int add_dir(const Directory& dir);
+	void index_page(const TrackedInfo& info);
+	void unindex_page(const Name& name);
+	void reindex(const std::vector<Name>& names);
+	int index_all();
+
+	bool auto_tracked(const Path& path);
+	void read_events(bool& pending);
+	int wait_for_changes(const std::atomic<bool>& running);
+	std::vector<Name> changed_names();
+};
+
+#endif
+
+#endif //BUILD_WATCHER_H_
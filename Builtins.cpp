@@ -0,0 +1,381 @@
+#include "Builtins.h"
+#include "Parser.h"
+
+BuiltinTable builtins;
+
+//a builtin Parser::read_and_process_fn hands calls to, with the arity checked before the handler is called
+struct ParserBuiltin
+{
+	const char* name;
+	BuiltinHandler handler;
+	int minParams, maxParams;
+};
+
+//builtins the parser handles itself, names without a handler are left to user-defined functions and system calls
+static const ParserBuiltin parserBuiltins[] = {
+	{"!", &Parser::builtin_not, -1, -1},
+	{"!=", &Parser::builtin_not_equal, -1, -1},
+	{"$", &Parser::builtin_dollar, -1, -1},
+	{"%", &Parser::builtin_mod, -1, -1},
+	{"%=", &Parser::builtin_mod_assign, -1, -1},
+	{"&&", &Parser::builtin_and, -1, -1},
+	{"*", &Parser::builtin_multiply, -1, -1},
+	{"*=", &Parser::builtin_multiply_assign, -1, -1},
+	{"+", &Parser::builtin_add, -1, -1},
+	{"++", &Parser::builtin_pre_increment, -1, -1},
+	{"+++", &Parser::builtin_post_increment, -1, -1},
+	{"+=", &Parser::builtin_add_assign, -1, -1},
+	{"-", &Parser::builtin_subtract, -1, -1},
+	{"--", &Parser::builtin_pre_decrement, -1, -1},
+	{"---", &Parser::builtin_post_decrement, -1, -1},
+	{"-=", &Parser::builtin_subtract_assign, -1, -1},
+	{"/", &Parser::builtin_divide, -1, -1},
+	{"/=", &Parser::builtin_divide_assign, -1, -1},
+	{":=", &Parser::builtin_define, -1, -1},
+	{"<", &Parser::builtin_less, -1, -1},
+	{"<=", &Parser::builtin_less_equal, -1, -1},
+	{"=", &Parser::builtin_assign, -1, -1},
+	{"==", &Parser::builtin_equal, -1, -1},
+	{">", &Parser::builtin_greater, -1, -1},
+	{">=", &Parser::builtin_greater_equal, -1, -1},
+	{"?", &Parser::builtin_ternary, -1, -1},
+	{"||", &Parser::builtin_or, -1, -1},
+	{"add_member_fns", &Parser::builtin_add_member_fns, 0, 1},
+	{"add_scope", &Parser::builtin_add_scope, 0, 1},
+	{"break", &Parser::builtin_break, 0, 0},
+	{"cat", NULL, -1, -1},
+	{"cd", &Parser::builtin_cd, -1, -1},
+	{"console", &Parser::builtin_console, -1, -1},
+	{"console.lock", &Parser::builtin_console_lock, 0, 0},
+	{"console.locked", &Parser::builtin_console_locked, 0, 0},
+	{"console.unlock", &Parser::builtin_console_unlock, 0, 0},
+	{"const", &Parser::builtin_const, -1, -1},
+	{"content", &Parser::builtin_content, -1, -1},
+	{"continue", &Parser::builtin_continue, 0, 0},
+	{"copy", NULL, -1, -1},
+	{"cp", NULL, -1, -1},
+	{"cpy", &Parser::builtin_cpy, -1, -1},
+	{"cssinclude", &Parser::builtin_cssinclude, 1, 1},
+	{"del", NULL, -1, -1},
+	{"dep", &Parser::builtin_dep, 1, -1},
+	{"dir", NULL, -1, -1},
+	{"do-while", &Parser::builtin_do_while, 1, 1},
+	{"ent", &Parser::builtin_ent, 1, 1},
+	{"error", &Parser::builtin_error, 1, -1},
+	{"exit", &Parser::builtin_exit, 0, 0},
+	{"exprtk", &Parser::builtin_exprtk, -1, -1},
+	{"exprtk.add_package", &Parser::builtin_exprtk_add_package, 1, -1},
+	{"exprtk.add_variable", &Parser::builtin_exprtk_add_variable, 1, -1},
+	{"exprtk.cache_hits", &Parser::builtin_exprtk_cache_stats, 0, 0},
+	{"exprtk.cache_misses", &Parser::builtin_exprtk_cache_stats, 0, 0},
+	{"exprtk.compile", &Parser::builtin_exprtk_compile, 0, 2},
+	{"exprtk.eval", &Parser::builtin_exprtk_eval, 0, 1},
+	{"exprtk.eval_params", &Parser::builtin_exprtk_eval_params, 1, 1},
+	{"exprtk.file", &Parser::builtin_exprtk_file, 1, 1},
+	{"exprtk.load", &Parser::builtin_exprtk_load, 1, 1},
+	{"exprtk.str", &Parser::builtin_exprtk_str, 0, 1},
+	{"f++", &Parser::builtin_fpp, 0, 1},
+	{"faviconinclude", &Parser::builtin_faviconinclude, 1, 1},
+	{"fn", &Parser::builtin_function, 1, 1},
+	{"for", &Parser::builtin_for, -1, -1},
+	{"forget", &Parser::builtin_forget, 1, -1},
+	{"function", &Parser::builtin_function, 1, 1},
+	{"getenv", &Parser::builtin_getenv, 1, 1},
+	{"getline", &Parser::builtin_getline, 1, -1},
+	{"hash", &Parser::builtin_hash, 1, 2},
+	{"if", &Parser::builtin_if, 1, 1},
+	{"imginclude", &Parser::builtin_imginclude, 1, 1},
+	{"in", &Parser::builtin_in, -1, -1},
+	{"include", &Parser::builtin_include, -1, -1},
+	{"inject", &Parser::builtin_input, 1, 1},
+	{"input", &Parser::builtin_input, 1, 1},
+	{"is_const", &Parser::builtin_is_const, 1, 1},
+	{"is_private", &Parser::builtin_is_private, 1, 1},
+	{"item", &Parser::builtin_item, 0, 0},
+	{"join", &Parser::builtin_join, 1, 4},
+	{"jsinclude", &Parser::builtin_jsinclude, 1, 1},
+	{"layer", &Parser::builtin_layer, 0, 1},
+	{"link", &Parser::builtin_link, 1, 2},
+	{"lolcat", &Parser::builtin_lolcat, -1, -1},
+	{"lolcat.activate", &Parser::builtin_lolcat_on, 0, 1},
+	{"lolcat.cmd", &Parser::builtin_lolcat_cmd, 0, 0},
+	{"lolcat.deactivate", &Parser::builtin_lolcat_off, 0, 0},
+	{"lolcat.off", &Parser::builtin_lolcat_off, 0, 0},
+	{"lolcat.on", &Parser::builtin_lolcat_on, 0, 1},
+	{"lolcat.status", &Parser::builtin_lolcat_status, 0, 0},
+	{"ls", NULL, -1, -1},
+	{"lst", &Parser::builtin_lst, -1, -1},
+	{"lua", &Parser::builtin_lua, -1, -1},
+	{"move", NULL, -1, -1},
+	{"mv", NULL, -1, -1},
+	{"mve", &Parser::builtin_mve, -1, -1},
+	{"n++", &Parser::builtin_npp, 0, 1},
+	{"nsm_lang", &Parser::builtin_nsm_lang, -1, -1},
+	{"nsm_mode", &Parser::builtin_nsm_mode, -1, -1},
+	{"paginate", &Parser::builtin_paginate, 0, 0},
+	{"paginate.no_items_per_page", &Parser::builtin_paginate_no_items_per_page, 1, 1},
+	{"paginate.separator", &Parser::builtin_paginate_separator, 0, 1},
+	{"paginate.template", &Parser::builtin_paginate_template, 0, 0},
+	{"parse", &Parser::builtin_parse, 2, 2},
+	{"pathto", &Parser::builtin_pathto, 1, 1},
+	{"pathtofile", &Parser::builtin_pathtofile, 1, 1},
+	{"pathtopage", &Parser::builtin_pathtopage, 1, 1},
+	{"pathtopageno", &Parser::builtin_pathtopageno, 1, 1},
+	{"poke", &Parser::builtin_poke, -1, -1},
+	{"precision", &Parser::builtin_precision, 0, 1},
+	{"private", &Parser::builtin_private, -1, -1},
+	{"prompt.char", &Parser::builtin_prompt_char, 1, 1},
+	{"pwd", &Parser::builtin_pwd, 0, 0},
+	{"quit", &Parser::builtin_quit, 0, 0},
+	{"quote", &Parser::builtin_quote, 1, 1},
+	{"read", &Parser::builtin_read, 1, -1},
+	{"refresh_completions", &Parser::builtin_refresh_completions, 0, 0},
+	{"replace_all", &Parser::builtin_replace_all, 3, 3},
+	{"replace_vars", &Parser::builtin_replace_vars, 0, 1},
+	{"return", &Parser::builtin_return, -1, -1},
+	{"rm", NULL, -1, -1},
+	{"rmv", &Parser::builtin_rmv, -1, -1},
+	{"scope", &Parser::builtin_scope, 0, 1},
+	{"script", &Parser::builtin_script, -1, -1},
+	{"size", &Parser::builtin_size, 1, 1},
+	{"struct", &Parser::builtin_struct, 1, 1},
+	{"substr", &Parser::builtin_substr, 3, 3},
+	{"sys", &Parser::builtin_system, -1, -1},
+	{"system", &Parser::builtin_system, -1, -1},
+	{"type", NULL, -1, -1},
+	{"typeof", &Parser::builtin_typeof, 1, 1},
+	{"unquote", &Parser::builtin_unquote, 1, 1},
+	{"valid_type", &Parser::builtin_valid_type, 1, -1},
+	{"vjoin", &Parser::builtin_vjoin, 1, 4},
+	{"warning", &Parser::builtin_warning, 1, 1},
+	{"while", &Parser::builtin_while, 1, 1},
+	{"write", &Parser::builtin_write, 1, -1}
+};
+
+//builtins the parser handles itself matched by the start of their name
+static const ParserBuiltin parserBuiltinPrefixes[] = {
+	{"$", NULL, -1, -1},
+	{"blank", &Parser::builtin_blank, -1, -1},
+	{"lua_", &Parser::builtin_lua_api, -1, -1},
+	{"std::vector.", &Parser::builtin_vector, -1, -1},
+	{"stream.", &Parser::builtin_stream, -1, -1}
+};
+
+//names called as the equivalent system command for the platform
+static const char* sysNames[][2] = {
+	#if defined _WIN32 || defined _WIN64
+		{"cat", "type"}, {"cp", "copy"}, {"ls", "dir"}, {"mv", "move"}, {"rm", "del"}
+	#else  //*nix
+		{"copy", "cp"}, {"del", "rm"}, {"dir", "ls"}, {"move", "mv"}, {"type", "cat"}
+	#endif
+};
+
+/*
+	builtins whose output depends on more than the page, its variables and
+	the files it records as dependencies (commands, the console, files and
+	paths of other tracked files, lua state and files written or moved).
+	pages calling them are never left alone as unchanged. includes prefixes.
+*/
+static const char* volatileBuiltins[] = {
+	"cat", "cd", "copy", "cp", "cpy", "cssinclude", "del", "dir", "exprtk.file", "exprtk.load",
+	"faviconinclude", "getenv", "getline", "hash", "imginclude", "in", "jsinclude", "link", "ls",
+	"lst", "lua", "lua_", "move", "mv", "mve", "pathto", "pathtofile", "pathtopage", "pathtopageno",
+	"poke", "pwd", "read", "rm", "rmv", "script", "stream.", "sys", "system", "write"
+};
+
+/*
+	builtins which only read and change the parser's own variables and
+	output, so pagination items calling nothing else can be rendered on
+	clones of the parser in parallel. includes prefixes.
+*/
+static const char* itemSafeBuiltins[] = {
+	"!", "!=", "$", "%", "%=", "&&", "*", "*=", "+", "++", "+++", "+=", "-", "--", "---", "-=",
+	"/", "/=", ":=", "<", "<=", "=", "==", ">", ">=", "?", "||",
+	"blank", "break", "const", "continue", "do-while", "ent", "exprtk", "fn", "for", "forget",
+	"function", "getenv", "if", "is_const", "is_private", "join", "layer", "parse", "pathto",
+	"pathtofile", "pathtopage", "private", "pwd", "quote", "replace_all", "return", "scope", "size",
+	"std::vector.", "struct", "substr", "type", "typeof", "unquote", "valid_type", "vjoin", "while"
+};
+
+static int parser_builtin_flags(const std::string& name)
+{
+	int flags = 0;
+
+	for(size_t v=0; v<sizeof(volatileBuiltins)/sizeof(volatileBuiltins[0]); ++v)
+		if(name == volatileBuiltins[v])
+			flags |= BUILTIN_VOLATILE;
+	for(size_t s=0; s<sizeof(itemSafeBuiltins)/sizeof(itemSafeBuiltins[0]); ++s)
+		if(name == itemSafeBuiltins[s])
+			flags |= BUILTIN_ITEM_SAFE;
+
+	return flags;
+}
+
+//cheap hash of the length, ends and middle of a name, collisions are resolved by probing
+static size_t slot_hash(const std::string& name)
+{
+	size_t size = name.size();
+	if(!size)
+		return 0;
+
+	unsigned int hash = size;
+	hash = hash*31 + (unsigned char)name[0];
+	hash = hash*31 + (unsigned char)name[size/2];
+	hash = hash*31 + (unsigned char)name[size-1];
+	hash = hash*31 + (unsigned char)name[size-1-(size>1)];
+	hash ^= hash >> 16;
+	hash *= 0x45d9f3b;
+	hash ^= hash >> 16;
+
+	return hash;
+}
+
+Builtin::Builtin()
+{
+	minParams = maxParams = maxOptions = -1;
+	flags = 0;
+	handler = NULL;
+}
+
+Builtin::Builtin(const std::string& Name,
+                 const BuiltinHandler& Handler,
+                 const int& MinParams,
+                 const int& MaxParams,
+                 const int& MaxOptions)
+{
+	name = Name;
+	minParams = MinParams;
+	maxParams = MaxParams;
+	maxOptions = MaxOptions;
+	flags = 0;
+	handler = Handler;
+}
+
+BuiltinTable::BuiltinTable()
+{
+	rehash(256);
+
+	Builtin builtin;
+	for(size_t b=0; b<sizeof(parserBuiltins)/sizeof(parserBuiltins[0]); ++b)
+	{
+		const ParserBuiltin& pb = parserBuiltins[b];
+		builtin = Builtin(pb.name, pb.handler, pb.minParams, pb.maxParams, -1);
+		builtin.flags = parser_builtin_flags(builtin.name);
+		for(size_t s=0; s<sizeof(sysNames)/sizeof(sysNames[0]); ++s)
+			if(builtin.name == sysNames[s][0])
+				builtin.sysName = sysNames[s][1];
+		add(builtin);
+	}
+
+	for(size_t b=0; b<sizeof(parserBuiltinPrefixes)/sizeof(parserBuiltinPrefixes[0]); ++b)
+	{
+		const ParserBuiltin& pb = parserBuiltinPrefixes[b];
+		builtin = Builtin(pb.name, pb.handler, pb.minParams, pb.maxParams, -1);
+		builtin.flags = parser_builtin_flags(builtin.name);
+		add_prefix(builtin);
+	}
+}
+
+//returns 1 if there is already a builtin with the same name
+int BuiltinTable::add(const Builtin& builtin)
+{
+	if(find(builtin.name))
+		return 1;
+
+	if(2*(entries.size() + 1) > slots.size())
+		rehash(2*slots.size());
+
+	size_t mask = slots.size() - 1,
+	       slot = slot_hash(builtin.name) & mask;
+	while(slots[slot] != -1)
+		slot = (slot + 1) & mask;
+
+	slots[slot] = entries.size();
+	entries.push_back(builtin);
+
+	return 0;
+}
+
+int BuiltinTable::add_prefix(const Builtin& builtin)
+{
+	for(size_t p=0; p<prefixes.size(); ++p)
+		if(prefixes[p].name == builtin.name)
+			return 1;
+
+	prefixes.push_back(builtin);
+
+	return 0;
+}
+
+//returns NULL if name is not a builtin
+const Builtin* BuiltinTable::find(const std::string& name) const
+{
+	size_t mask = slots.size() - 1,
+	       slot = slot_hash(name) & mask;
+	for(; slots[slot] != -1; slot = (slot + 1) & mask)
+		if(entries[slots[slot]].name == name)
+			return &entries[slots[slot]];
+
+	for(size_t p=0; p<prefixes.size(); ++p)
+		if(name[0] == prefixes[p].name[0] && name.compare(0, prefixes[p].name.size(), prefixes[p].name) == 0)
+			return &prefixes[p];
+
+	return NULL;
+}
+
+void BuiltinTable::rehash(const size_t& noSlots)
+{
+	slots = std::vector<int>(noSlots, -1);
+
+	size_t mask = noSlots - 1, slot;
+	for(size_t e=0; e<entries.size(); ++e)
+	{
+		slot = slot_hash(entries[e].name) & mask;
+		while(slots[slot] != -1)
+			slot = (slot + 1) & mask;
+		slots[slot] = e;
+	}
+}
+
+int check_arity(const Builtin& builtin,
+                const size_t& noOptions,
+                const size_t& noParams,
+                std::string& errStr)
+{
+	if(builtin.maxOptions != -1 && noOptions > (size_t)builtin.maxOptions)
+	{
+		errStr = "expected at most " + std::to_string(builtin.maxOptions) + " options, got " + std::to_string(noOptions);
+		return 1;
+	}
+
+	if((builtin.minParams != -1 && noParams < (size_t)builtin.minParams) ||
+	   (builtin.maxParams != -1 && noParams > (size_t)builtin.maxParams))
+	{
+		//worded the same as the parser's own errors
+		errStr = "expected ";
+		if(builtin.minParams == builtin.maxParams)
+			errStr += std::to_string(builtin.minParams) + " parameter" + (builtin.minParams == 1 ? "" : "s");
+		else if(builtin.maxParams == -1)
+			errStr += (builtin.minParams > 1 ? std::to_string(builtin.minParams) + "+ " : "") + "parameters";
+		else
+			errStr += std::to_string(builtin.minParams > 0 ? builtin.minParams : 0) + "-" + std::to_string(builtin.maxParams) + " parameters";
+		errStr += ", got " + std::to_string(noParams);
+		return 1;
+	}
+
+	return 0;
+}
+
+//adds a builtin with its own handler, returns 1 if the name is already taken
+//nothing is known about what the handler reads so it's treated as volatile
+int register_builtin(const std::string& name,
+                     const int& minParams,
+                     const int& maxParams,
+                     const int& maxOptions,
+                     const BuiltinFn& fn)
+{
+	Builtin builtin(name, &Parser::call_registered_builtin, minParams, maxParams, maxOptions);
+	builtin.flags = BUILTIN_VOLATILE;
+	builtin.fn = fn;
+	return builtins.add(builtin);
+}
@@ -0,0 +1,125 @@
+#ifndef BUILTINS_H_
+#define BUILTINS_H_
+
+#include <functional>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Indent.h"
+#include "Path.h"
+
+struct Builtin;
+struct Parser;
+struct SegmentedText;
+
+//handler for a registered builtin, output is added to the parsed output
+typedef std::function<int(Parser& parser,
+                          const std::vector<std::string>& options,
+                          const std::vector<std::string>& params,
+                          const Path& readPath,
+                          const int& lineNo,
+                          std::string& output,
+                          std::ostream& eos)> BuiltinFn;
+
+/*
+	a call being processed by Parser::read_and_process_fn, refers to its
+	parameters along with the name, options and parameters read for the
+	call so handlers can read and move on from the call as if inline.
+*/
+struct FnCall
+{
+	const bool& indent;
+	const Indent& baseIndentAmount;
+	const char& lang;
+	const bool& addOutput;
+	const std::string& inStr;
+	const SegmentedText* segmented; //inStr split up ahead of time, NULL if it wasn't
+	int& lineNo;
+	size_t& linePos;
+	const Path& readPath;
+	std::set<Path>& antiDepsOfReadPath;
+	std::string& outStr;
+	std::ostream& eos;
+	int& sLinePos;
+	int& sLineNo;
+	int& conditionLineNo;
+	std::string& funcName;
+	std::string& optionsStr;
+	std::string& paramsStr;
+	std::vector<std::string>& options;
+	std::vector<std::string>& params;
+	std::string& brackets;
+	bool& doNotParse;
+	bool& parseParams;
+	bool& replaceVars;
+	bool& hasIncrement;
+	const Builtin* builtin;
+	int paramId; //params[0] interned ahead of time, -1 if it wasn't
+};
+
+//handlers return the same as read_and_process_fn or NSM_NOT_BUILTIN (see Consts.h)
+typedef int (Parser::*BuiltinHandler)(FnCall& call);
+
+//flags for builtins
+const int BUILTIN_VOLATILE = 1;  //output can change without the page, its variables or files it records changing
+const int BUILTIN_ITEM_SAFE = 2; //only reads/changes the parser's own state, so can be called rendering items on a clone
+
+/*
+	entry for a builtin function. names without a handler are left to
+	user-defined functions and system calls, with sysName in place of the
+	name when set (eg. copy is cp on *nix). -1 for an arity means unchecked.
+*/
+struct Builtin
+{
+	std::string name, sysName;
+	int minParams, maxParams, maxOptions;
+	int flags;
+	BuiltinHandler handler;
+	BuiltinFn fn; //for builtins added with register_builtin
+
+	Builtin();
+	Builtin(const std::string& Name,
+	        const BuiltinHandler& Handler,
+	        const int& MinParams,
+	        const int& MaxParams,
+	        const int& MaxOptions);
+};
+
+/*
+	open addressing hash table of builtins so function calls are resolved
+	with a single lookup and their handler called directly, names not
+	found go straight to the user-defined function and type lookups.
+	not thread safe to add to once builds have started.
+*/
+struct BuiltinTable
+{
+	std::vector<Builtin> entries;
+	std::vector<int> slots; //entry indices, -1 for empty, size is a power of 2
+	std::vector<Builtin> prefixes; //builtins matched by the start of their name
+
+	BuiltinTable();
+
+	int add(const Builtin& builtin);
+	int add_prefix(const Builtin& builtin);
+	const Builtin* find(const std::string& name) const;
+
+	void rehash(const size_t& noSlots);
+};
+
+extern BuiltinTable builtins;
+
+//sets errStr and returns 1 if a call doesn't match the builtin's arity
+int check_arity(const Builtin& builtin,
+                const size_t& noOptions,
+                const size_t& noParams,
+                std::string& errStr);
+
+int register_builtin(const std::string& name,
+                     const int& minParams,
+                     const int& maxParams,
+                     const int& maxOptions,
+                     const BuiltinFn& fn);
+
+#endif //BUILTINS_H_
@@ -46,4 +46,14 @@ const int NSM_QUIT   = NSM_EXIT;
 const int NSM_RET    = -2043;
 const int NSM_SENTER = -2044;
 
+const int BSTATE_FILES = -2045;
+const int BSTATE_DB    = -2046;
+
+const int SYS_CONSOLE = -2047;
+const int SYS_INJECT  = -2048;
+const int SYS_RAW     = -2049;
+const int SYS_NO_OUT  = -2050;
+
+const int NSM_NOT_BUILTIN = -2051; //builtin handler left the call to user-defined functions and system calls
+
 #endif //CONSTS_H_
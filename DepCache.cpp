@@ -0,0 +1,139 @@
+#include "DepCache.h"
+
+DepCache depCache;
+
+DepStatus::DepStatus(const Path& Dep)
+{
+	path = Dep;
+	exists = isDir = 0;
+	mtime = 0;
+	hashRecorded = hashChanged = 0;
+}
+
+DepCache::DepCache()
+{
+	nextToCheck = noLookups = 0;
+}
+
+void DepCache::clear()
+{
+	for(size_t s=0; s<DEP_CACHE_SHARDS; ++s)
+		shards[s].clear();
+	distinct.clear();
+	listings.clear();
+	nextToCheck = noLookups = 0;
+}
+
+DepStatus* DepCache::add(const Path& dep)
+{
+	std::string key = dep.comparableStr();
+	size_t s = std::hash<std::string>()(key) % DEP_CACHE_SHARDS;
+
+	noLookups++;
+
+	shardMtxs[s].lock();
+	std::unique_ptr<DepStatus>& status = shards[s][key];
+	if(!status)
+		status.reset(new DepStatus(dep));
+	DepStatus* result = status.get();
+	shardMtxs[s].unlock();
+
+	return result;
+}
+
+//whether path is in the listing of its directory, each directory is listed once
+bool DepCache::listed(const Path& path)
+{
+	listingsMtx.lock();
+	auto listing = listings.find(path.dir);
+	if(listing == listings.end())
+	{
+		listing = listings.insert(std::make_pair(path.dir, std::unordered_set<std::string>())).first;
+
+		DIR *dir = opendir(path.dir.size() ? path.dir.c_str() : "./");
+		if(dir != NULL)
+		{
+			struct dirent *entry;
+			while((entry = readdir(dir)) != NULL)
+				listing->second.insert(entry->d_name);
+			closedir(dir);
+		}
+	}
+	bool found = listing->second.count(path.file);
+	listingsMtx.unlock();
+
+	return found;
+}
+
+void DepCache::check(DepStatus* status, const int& incrMode)
+{
+	struct stat sb;
+	std::string pathStr = status->path.str();
+
+	status->exists = !stat(pathStr.c_str(), &sb);
+	if(!status->exists)
+		return;
+	status->isDir = S_ISDIR(sb.st_mode);
+	status->mtime = sb.st_mtime;
+
+	if(incrMode == INCR_MOD || status->isDir)
+		return;
+
+	if(buildState.enabled)
+	{
+		DepFingerprint fp;
+		status->hashRecorded = buildState.get_fingerprint(status->path, fp);
+
+		//only rehashes when size or modified time differ from when hash was recorded
+		if(status->hashRecorded && (mtime_ns(sb) != fp.mtime || sb.st_size != fp.size))
+		{
+			std::shared_ptr<const FileContents> contents = fileCache.get(pathStr);
+			status->hashChanged = (!contents->ok || fp.hash != contents->hash);
+		}
+	}
+	else
+	{
+		std::string hashPathStr = status->path.getHashPath().str();
+
+		status->hashRecorded = file_exists(hashPathStr);
+		if(status->hashRecorded)
+		{
+			std::shared_ptr<const FileContents> contents = fileCache.get(pathStr);
+			status->hashChanged = (!contents->ok || (unsigned) std::atoi(string_from_file(hashPathStr).c_str()) != contents->hash);
+		}
+	}
+}
+
+void check_thread(const int& incrMode)
+{
+	size_t d;
+	while((d = depCache.nextToCheck++) < depCache.distinct.size())
+		depCache.check(depCache.distinct[d], incrMode);
+}
+
+void DepCache::check_all(const int& noThreads, const int& incrMode)
+{
+	distinct.clear();
+	for(size_t s=0; s<DEP_CACHE_SHARDS; ++s)
+		for(auto status=shards[s].begin(); status!=shards[s].end(); ++status)
+			distinct.push_back(status->second.get());
+
+	nextToCheck = 0;
+
+	std::vector<std::thread> threads;
+	for(int i=0; i<noThreads; i++)
+		threads.push_back(std::thread(check_thread, incrMode));
+
+	for(int i=0; i<noThreads; i++)
+		threads[i].join();
+}
+
+void DepCache::report(std::ostream& os)
+{
+	size_t noHits = noLookups - distinct.size();
+
+	os << "dependency cache: " << noLookups << " lookups, " << distinct.size() << " distinct dependencies checked";
+	if(noLookups)
+		os << ", " << (100*noHits)/noLookups << "% hit rate";
+	os << std::endl;
+}
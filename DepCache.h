@@ -0,0 +1,58 @@
+#ifndef DEP_CACHE_H_
+#define DEP_CACHE_H_
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <unordered_set>
+
+#include "BuildState.h"
+#include "Consts.h"
+#include "FileCache.h"
+#include "hashtk/HashTk.h"
+
+//what a dependency looked like when it was checked during the current run
+struct DepStatus
+{
+	Path path;
+	bool exists, isDir;
+	time_t mtime;
+	bool hashRecorded, hashChanged;
+
+	DepStatus(const Path& Dep);
+};
+
+const size_t DEP_CACHE_SHARDS = 64;
+
+/*
+	dependency statuses shared by dep threads so each distinct dependency
+	is stat'ed and hashed at most once per build-updated/status, however
+	many pages depend on it. dep threads add the dependencies of each page,
+	then check_all stats/hashes the distinct set in parallel.
+
+	whether the per-page files (content, template, output, deps file)
+	exist is answered from one listing of each directory rather than a
+	stat per page.
+*/
+struct DepCache
+{
+	std::mutex shardMtxs[DEP_CACHE_SHARDS];
+	std::unordered_map<std::string, std::unique_ptr<DepStatus> > shards[DEP_CACHE_SHARDS];
+	std::vector<DepStatus*> distinct;
+	std::atomic<size_t> nextToCheck, noLookups;
+	std::mutex listingsMtx;
+	std::unordered_map<std::string, std::unordered_set<std::string> > listings;
+
+	DepCache();
+
+	void clear();
+	DepStatus* add(const Path& dep);
+	bool listed(const Path& path);
+	void check(DepStatus* status, const int& incrMode);
+	void check_all(const int& noThreads, const int& incrMode);
+	void report(std::ostream& os);
+};
+
+extern DepCache depCache;
+
+#endif //DEP_CACHE_H_
@@ -1,50 +1,211 @@
 #include "Expr.h"
 
+//functions whose results depend on more than their parameters and the symbol table
+static const char* volatileFns[] = {
+	"cd", "close", "eof", "getline", "open", "read", "sys", "write"
+};
+
+ExprCache::ExprCache()
+{
+	symbol_table = NULL;
+	generation = noAdded = noHits = noMisses = 0;
+	volatileUsed = 0;
+	parser.dec().collect_functions() = true;
+}
+
+void ExprCache::set_symbol_table(exprtk::symbol_table<double>& Symbol_Table)
+{
+	symbol_table = &Symbol_Table;
+	symbols_removed();
+}
+
+bool ExprCache::add_variable(const std::string& name, double& value)
+{
+	symbols_added();
+	return symbol_table->add_variable(name, value);
+}
+
+bool ExprCache::add_stringvar(const std::string& name, std::string& str)
+{
+	symbols_added();
+	return symbol_table->add_stringvar(name, str);
+}
+
+bool ExprCache::add_vector(const std::string& name, std::vector<double>& vec)
+{
+	symbols_added();
+	return symbol_table->add_vector(name, vec);
+}
+
+bool ExprCache::remove_variable(const std::string& name)
+{
+	symbols_removed();
+	return symbol_table->remove_variable(name);
+}
+
+bool ExprCache::remove_stringvar(const std::string& name)
+{
+	symbols_removed();
+	return symbol_table->remove_stringvar(name);
+}
+
+bool ExprCache::remove_vector(const std::string& name)
+{
+	symbols_removed();
+	return symbol_table->remove_vector(name);
+}
+
+//whether name is bound to the given storage, which must be unbound before it is freed
+bool ExprCache::bound_to(const std::string& name, const double& value)
+{
+	exprtk::details::variable_node<double>* var = symbol_table->get_variable(name);
+	return var && &var->ref() == &value;
+}
+
+bool ExprCache::bound_to(const std::string& name, const std::string& str)
+{
+	exprtk::details::stringvar_node<double>* var = symbol_table->get_stringvar(name);
+	return var && &var->ref() == &str;
+}
+
+bool ExprCache::bound_to(const std::string& name, const std::vector<double>& vec)
+{
+	exprtk::details::vector_holder<double>* var = symbol_table->get_vector(name);
+	return var && vec.size() && var->data() == &vec[0];
+}
+
+//expressions that failed to compile may now compile
+void ExprCache::symbols_added()
+{
+	++noAdded;
+}
+
+//variables expressions were compiled against may no longer exist
+void ExprCache::symbols_removed()
+{
+	++generation;
+}
+
+bool ExprCache::compile(const std::string& Expr_Str, exprtk::expression<double>& expression, bool& callsVolatile)
+{
+	auto found = entries.find(Expr_Str);
+	if(found != entries.end())
+	{
+		CachedExpr& cached = *found->second;
+		if(cached.generation == generation && (cached.compiled || cached.noAdded == noAdded))
+		{
+			++noHits;
+			lru.splice(lru.begin(), lru, found->second);
+			expression = cached.expression;
+			callsVolatile = cached.callsVolatile;
+			return cached.compiled;
+		}
+
+		lru.erase(found->second);
+		entries.erase(found);
+	}
+
+	++noMisses;
+
+	if(entries.size() >= EXPR_CACHE_SIZE)
+	{
+		entries.erase(lru.back().expr_str);
+		lru.pop_back();
+	}
+
+	lru.push_front(CachedExpr());
+	CachedExpr& cached = lru.front();
+	cached.expr_str = Expr_Str;
+	cached.generation = generation;
+	cached.noAdded = noAdded;
+	cached.expression.register_symbol_table(*symbol_table);
+	cached.compiled = parser.compile(Expr_Str, cached.expression);
+	entries[Expr_Str] = lru.begin();
+
+	cached.callsVolatile = 0;
+	std::vector<exprtk::parser<double>::dependent_entity_collector::symbol_t> fns;
+	parser.dec().symbols(fns);
+	for(size_t f=0; f<fns.size() && !cached.callsVolatile; ++f)
+		for(size_t v=0; v<sizeof(volatileFns)/sizeof(volatileFns[0]); ++v)
+			if(fns[f].first == volatileFns[v])
+				cached.callsVolatile = 1;
+
+	expression = cached.expression;
+	callsVolatile = cached.callsVolatile;
+	return cached.compiled;
+}
+
+//compiles again so parser holds the errors, failures are often found in the cache
+const exprtk::parser<double>& ExprCache::errors(const std::string& Expr_Str)
+{
+	exprtk::expression<double> expression;
+	expression.register_symbol_table(*symbol_table);
+	parser.compile(Expr_Str, expression);
+
+	return parser;
+}
+
+//// Expr
+
 Expr::Expr()
 {
+	callsVolatile = 0;
+	cache = NULL;
 }
 
-void Expr::register_symbol_table(exprtk::symbol_table<double> &Symbol_Table)
+void Expr::use_cache(ExprCache& Cache)
 {
-	expression.register_symbol_table(Symbol_Table);
+	cache = &Cache;
 }
 
 int Expr::compile(const std::string &Expr_Str)
 {
 	expr_str = Expr_Str;
-	return parser.compile(expr_str, expression);
+	return cache->compile(expr_str, expression, callsVolatile);
 }
 
 double Expr::evaluate()
 {
+	if(callsVolatile)
+		cache->volatileUsed = 1;
 	return expression.value();
 }
 
+const exprtk::parser<double>& Expr::errors()
+{
+	return cache->errors(expr_str);
+}
+
 //// ExprSet
 
 ExprSet::ExprSet()
 {
+	cache = NULL;
 }
 
-void ExprSet::add_symbol_table(exprtk::symbol_table<double>* Symbol_Table)
+void ExprSet::use_cache(ExprCache& Cache)
 {
-	symbol_table = Symbol_Table;
-	for(auto expression=expressions.begin(); expression!=expressions.end(); ++expression)
-		expression->second.register_symbol_table(*symbol_table);
+	cache = &Cache;
 }
 
 int ExprSet::compile(const std::string& Name, const std::string &Expr_Str)
 {
-	expressions[Name].register_symbol_table(*symbol_table);
-	int result = parser.compile(Expr_Str, expressions[Name]);
+	bool callsVolatile;
+	int result = cache->compile(Expr_Str, expressions[Name], callsVolatile);
 	if(result)
 		expr_strs[Name] = Expr_Str;
 	else
 		expressions.erase(Name);
+	if(result && callsVolatile)
+		volatileNames.insert(Name);
+	else
+		volatileNames.erase(Name);
 	return result;
 }
 
 double ExprSet::evaluate(const std::string &Name)
 {
+	if(volatileNames.count(Name))
+		cache->volatileUsed = 1;
 	return expressions[Name].value();
 }
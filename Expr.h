@@ -4,34 +4,88 @@
 
 #include <cstdio>
 #include <iostream>
+#include <list>
+#include <set>
+#include <unordered_map>
 
 #include "exprtk/exprtk.h"
 
-struct Expr
+#define EXPR_CACHE_SIZE 256
+
+//compiled expression and the symbol table generation it was compiled against
+struct CachedExpr
 {
 	std::string expr_str;
 	exprtk::expression<double> expression;
+	bool compiled, callsVolatile; //callsVolatile when calling a function that reaches outside the page
+	size_t generation, noAdded;
+};
+
+/*
+	least recently used compiled expressions keyed by expression text.
+	compiled expressions refer directly to the variables in the symbol
+	table, so entries are recompiled once symbols have been removed since
+	they were compiled, failed compiles are also redone once symbols have
+	been added. symbols should be added/removed through the cache.
+	volatileUsed is set once an expression calling cd, sys or the file
+	functions is evaluated.
+*/
+struct ExprCache
+{
 	exprtk::parser<double> parser;
+	exprtk::symbol_table<double>* symbol_table;
+	std::list<CachedExpr> lru; //most recently used at the front
+	std::unordered_map<std::string, std::list<CachedExpr>::iterator> entries;
+	size_t generation, noAdded, noHits, noMisses;
+	bool volatileUsed;
+
+	ExprCache();
+
+	void set_symbol_table(exprtk::symbol_table<double>& Symbol_Table);
+
+	bool add_variable(const std::string& name, double& value);
+	bool add_stringvar(const std::string& name, std::string& str);
+	bool add_vector(const std::string& name, std::vector<double>& vec);
+	bool remove_variable(const std::string& name);
+	bool remove_stringvar(const std::string& name);
+	bool remove_vector(const std::string& name);
+	bool bound_to(const std::string& name, const double& value);
+	bool bound_to(const std::string& name, const std::string& str);
+	bool bound_to(const std::string& name, const std::vector<double>& vec);
+	void symbols_added();
+	void symbols_removed();
+
+	bool compile(const std::string& Expr_Str, exprtk::expression<double>& expression, bool& callsVolatile);
+	const exprtk::parser<double>& errors(const std::string& Expr_Str);
+};
+
+struct Expr
+{
+	std::string expr_str;
+	exprtk::expression<double> expression;
+	bool callsVolatile;
+	ExprCache* cache;
 
 	Expr();
 
-	void register_symbol_table(exprtk::symbol_table<double>& Symbol_Table);
+	void use_cache(ExprCache& Cache);
 
 	int compile(const std::string &Expr_Str);
 	double evaluate();
+	const exprtk::parser<double>& errors();
 };
 
 struct ExprSet
 {
-	exprtk::symbol_table<double>* symbol_table;
+	ExprCache* cache;
 	std::map<std::string, exprtk::expression<double> > expressions;
 	std::map<std::string, std::string> expr_strs;
-	exprtk::parser<double> parser;
-	
+	std::set<std::string> volatileNames; //expressions calling volatile functions
+
 
 	ExprSet();
 
-	void add_symbol_table(exprtk::symbol_table<double>* Symbol_Table);
+	void use_cache(ExprCache& Cache);
 
 	int compile(const std::string& Name, const std::string &Expr_Str);
 	double evaluate_last();
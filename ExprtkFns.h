@@ -211,7 +211,7 @@ struct exprtk_nsm_write : public exprtk::igeneric_function<T>
 	Variables* vars;
 	std::string* parsedText;
 	bool indent;
-	std::string* indentAmount;
+	Indent* indentAmount;
 	bool* consoleLocked; 
 	std::mutex* os_mtx;
 
@@ -222,7 +222,7 @@ struct exprtk_nsm_write : public exprtk::igeneric_function<T>
 
 	void add_info(Variables* Vars, 
 	              std::string* ParsedText,
-	              std::string* IndentAmount,
+	              Indent* IndentAmount,
 	              bool* ConsoleLocked,
 	              std::mutex* OS_mtx)
 	{
@@ -285,12 +285,12 @@ struct exprtk_nsm_write : public exprtk::igeneric_function<T>
 				{
 					getline(iss, ssLine);
 					if(0 < ssLineNo++)
-						*parsedText += "\n" + *indentAmount;
+						add_newline(*parsedText, *indentAmount);
 					oldLine = ssLine;
 					*parsedText += ssLine;
 				}
 				if(indent)
-					*indentAmount += into_whitespace(oldLine);
+					indentAmount->add_text(oldLine);
 
 				return 1;
 			}
@@ -0,0 +1,159 @@
+#include "FileCache.h"
+
+#include <cstdio>
+#include <cstring>
+
+#if defined _WIN32 || defined _WIN64
+	#include <fstream>
+#else  //*nix
+	#include <fcntl.h>
+#endif
+
+FileCache fileCache;
+
+std::string hex_digest(const std::string& str)
+{
+	char digest[32];
+	std::snprintf(digest, sizeof(digest), "%08x%08x", FNVHash(str), DJBHash(str));
+	return digest;
+}
+
+FileContents::FileContents()
+{
+	hash = 0;
+	dev = ino = size = mtime = 0;
+	ok = 0;
+}
+
+static void set_file_id(FileContents& contents, const struct stat& sb)
+{
+	contents.dev = sb.st_dev;
+	contents.ino = sb.st_ino;
+	contents.size = sb.st_size;
+	contents.mtime = mtime_ns(sb);
+}
+
+static bool same_file_id(const FileContents& contents, const struct stat& sb)
+{
+	return contents.mtime == mtime_ns(sb) &&
+	       contents.size == (long long)sb.st_size &&
+	       contents.ino == (long long)sb.st_ino &&
+	       contents.dev == (long long)sb.st_dev;
+}
+
+//reads file in to contents, stopping at the first null character like string_from_file
+//returns 0 if the file can't be opened or read, or changes size while being read
+static bool read_contents(const std::string& pathStr, const struct stat& sb, FileContents& contents)
+{
+	#if defined _WIN32 || defined _WIN64
+		set_file_id(contents, sb);
+		std::ifstream ifs(pathStr);
+		if(!ifs.is_open())
+			return 0;
+		getline(ifs, contents.str, (char) ifs.eof());
+		if(ifs.bad())
+			return 0;
+	#else  //*nix
+		int fd = ::open(pathStr.c_str(), O_RDONLY);
+		if(fd < 0)
+			return 0;
+
+		//id comes from the open file so it matches what is read
+		struct stat fdsb;
+		if(fstat(fd, &fdsb))
+			fdsb = sb;
+		set_file_id(contents, fdsb);
+
+		//one read for the whole file in almost all cases
+		contents.str.resize(fdsb.st_size);
+		size_t noRead = 0;
+		ssize_t n;
+		while(1)
+		{
+			if(noRead == contents.str.size())
+				contents.str.resize(2*noRead + 4096);
+			n = ::read(fd, &contents.str[noRead], contents.str.size() - noRead);
+			if(n <= 0)
+				break;
+			noRead += n;
+		}
+		close(fd);
+
+		//partial contents are never handed out
+		if(n < 0 || noRead != (size_t)fdsb.st_size)
+		{
+			contents.str.clear();
+			return 0;
+		}
+
+		const char* nullPos = (const char*)std::memchr(contents.str.c_str(), '\0', noRead);
+		contents.str.resize(nullPos ? nullPos - contents.str.c_str() : noRead);
+	#endif
+
+	//spare capacity from growing or truncating would count against the cache
+	if(contents.str.capacity() > contents.str.size())
+		contents.str.shrink_to_fit();
+
+	contents.hash = FNVHash(contents.str);
+	contents.ok = 1;
+
+	return 1;
+}
+
+FileCache::FileCache()
+{
+	noBytes = 0;
+}
+
+std::shared_ptr<const FileContents> FileCache::get(const std::string& pathStr)
+{
+	struct stat sb;
+	if(stat(pathStr.c_str(), &sb) || S_ISDIR(sb.st_mode))
+		return std::shared_ptr<const FileContents>(new FileContents());
+
+	size_t s = std::hash<std::string>()(pathStr) % FILE_CACHE_SHARDS;
+
+	shardMtxs[s].lock();
+	auto found = shards[s].find(pathStr);
+	if(found != shards[s].end() && same_file_id(*found->second, sb))
+	{
+		std::shared_ptr<const FileContents> result = found->second;
+		shardMtxs[s].unlock();
+		return result;
+	}
+	shardMtxs[s].unlock();
+
+	//reads outside the lock, threads reading the same file at once is harmless
+	std::shared_ptr<FileContents> contents(new FileContents());
+	if(!read_contents(pathStr, sb, *contents))
+		return contents;
+
+	shardMtxs[s].lock();
+	std::shared_ptr<const FileContents>& cached = shards[s][pathStr];
+	if(cached)
+	{
+		noBytes -= cached->str.capacity();
+		cached.reset();
+	}
+	if(noBytes + contents->str.capacity() <= FILE_CACHE_MAX_BYTES)
+	{
+		cached = contents;
+		noBytes += contents->str.capacity();
+	}
+	else
+		shards[s].erase(pathStr);
+	shardMtxs[s].unlock();
+
+	return contents;
+}
+
+void FileCache::clear()
+{
+	for(size_t s=0; s<FILE_CACHE_SHARDS; ++s)
+	{
+		shardMtxs[s].lock();
+		shards[s].clear();
+		shardMtxs[s].unlock();
+	}
+	noBytes = 0;
+}
@@ -0,0 +1,53 @@
+#ifndef FILE_CACHE_H_
+#define FILE_CACHE_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "BuildState.h"
+#include "hashtk/HashTk.h"
+
+//contents of a file along with what it looked like on disk when read
+struct FileContents
+{
+	std::string str;
+	unsigned int hash; //FNVHash of str
+	long long dev, ino, size, mtime; //mtime in nanoseconds
+	bool ok; //0 when the file was missing or couldn't be read in full
+
+	FileContents();
+};
+
+//64 bit hex digest of str made from its FNVHash and DJBHash
+std::string hex_digest(const std::string& str);
+
+const size_t FILE_CACHE_SHARDS = 64;
+const size_t FILE_CACHE_MAX_BYTES = 256*1024*1024;
+
+/*
+	read only file contents shared between build threads, keyed by path.
+	entries are revalidated with a stat on every get and only reread once
+	the device, inode, size or modified time change, so partials input by
+	every page are read and hashed once per build rather than once per use.
+	once FILE_CACHE_MAX_BYTES are cached further files are read but not kept.
+	missing files and failed or short reads give contents with ok unset,
+	which are never cached.
+*/
+struct FileCache
+{
+	std::mutex shardMtxs[FILE_CACHE_SHARDS];
+	std::unordered_map<std::string, std::shared_ptr<const FileContents> > shards[FILE_CACHE_SHARDS];
+	std::atomic<size_t> noBytes;
+
+	FileCache();
+
+	std::shared_ptr<const FileContents> get(const std::string& pathStr);
+	void clear();
+};
+
+extern FileCache fileCache;
+
+#endif //FILE_CACHE_H_
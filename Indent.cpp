@@ -0,0 +1,148 @@
+#include "Indent.h"
+
+#include <cstring>
+#include <iostream>
+
+Indent::Indent()
+{
+	noSpaces = 0;
+}
+
+Indent::Indent(const char* whitespace)
+{
+	noSpaces = 0;
+	add_text(whitespace);
+}
+
+Indent::Indent(const std::string& whitespace)
+{
+	noSpaces = 0;
+	add_text(whitespace);
+}
+
+void Indent::clear()
+{
+	head.clear();
+	noSpaces = 0;
+}
+
+bool Indent::empty() const
+{
+	return !noSpaces && head.empty();
+}
+
+size_t Indent::size() const
+{
+	return head.size() + noSpaces;
+}
+
+std::string Indent::str() const
+{
+	std::string whitespace = head;
+	whitespace.append(noSpaces, ' ');
+	return whitespace;
+}
+
+void Indent::add_text(const std::string& text)
+{
+	add_text(text, 0, text.size());
+}
+
+void Indent::add_text(const std::string& text, const size_t& pos, const size_t& len)
+{
+	if(!len)
+		return;
+
+	//only looks back as far as pos, rfind would carry on through the text before it
+	size_t lastTab = pos + len;
+	while(lastTab > pos && text[lastTab-1] != '\t')
+		--lastTab;
+	if(lastTab == pos)
+	{
+		noSpaces += len;
+		return;
+	}
+	--lastTab;
+
+	head.append(noSpaces, ' ');
+	for(size_t i=pos; i<=lastTab; ++i)
+		head += (text[i] == '\t') ? '\t' : ' ';
+	noSpaces = pos + len - lastTab - 1;
+}
+
+void Indent::add_spaces(const size_t& n)
+{
+	noSpaces += n;
+}
+
+Indent& Indent::operator+=(const char& c)
+{
+	if(c == '\t')
+	{
+		head.append(noSpaces, ' ');
+		head += '\t';
+		noSpaces = 0;
+	}
+	else
+		++noSpaces;
+
+	return *this;
+}
+
+Indent& Indent::operator+=(const char* whitespace)
+{
+	for(size_t i=0, len=std::strlen(whitespace); i<len; ++i)
+		*this += whitespace[i];
+
+	return *this;
+}
+
+Indent& Indent::operator+=(const std::string& whitespace)
+{
+	add_text(whitespace);
+
+	return *this;
+}
+
+bool Indent::operator==(const Indent& indent) const
+{
+	return noSpaces == indent.noSpaces && head == indent.head;
+}
+
+bool Indent::operator!=(const Indent& indent) const
+{
+	return !(*this == indent);
+}
+
+std::string& operator+=(std::string& str, const Indent& indent)
+{
+	str += indent.head;
+	str.append(indent.noSpaces, ' ');
+
+	return str;
+}
+
+std::string operator+(const std::string& str, const Indent& indent)
+{
+	std::string result = str;
+	result += indent;
+	return result;
+}
+
+std::string operator+(const char* str, const Indent& indent)
+{
+	std::string result = str;
+	result += indent;
+	return result;
+}
+
+std::ostream& operator<<(std::ostream& os, const Indent& indent)
+{
+	return os << indent.str();
+}
+
+void add_newline(std::string& str, const Indent& indent)
+{
+	str += '\n';
+	str += indent;
+}
@@ -0,0 +1,48 @@
+#ifndef INDENT_H_
+#define INDENT_H_
+
+#include <iosfwd>
+#include <string>
+
+/*
+	whitespace to indent lines with. kept as the whitespace up to and
+	including the last tab plus a count of the spaces after it, so the
+	usual case of adding spaces for output text doesn't grow a string.
+	only materialised when it is written out after a newline.
+*/
+struct Indent
+{
+	std::string head; //empty or ends with a tab
+	size_t noSpaces; //spaces after head
+
+	Indent();
+	Indent(const char* whitespace);
+	Indent(const std::string& whitespace);
+
+	void clear();
+	bool empty() const;
+	size_t size() const;
+	std::string str() const;
+
+	//adds the whitespace text takes up, tabs are kept and everything else is a space
+	void add_text(const std::string& text);
+	void add_text(const std::string& text, const size_t& pos, const size_t& len);
+	void add_spaces(const size_t& n);
+
+	Indent& operator+=(const char& c);
+	Indent& operator+=(const char* whitespace);
+	Indent& operator+=(const std::string& whitespace);
+
+	bool operator==(const Indent& indent) const;
+	bool operator!=(const Indent& indent) const;
+};
+
+std::string& operator+=(std::string& str, const Indent& indent);
+std::string operator+(const std::string& str, const Indent& indent);
+std::string operator+(const char* str, const Indent& indent);
+std::ostream& operator<<(std::ostream& os, const Indent& indent);
+
+//appends a newline followed by indent
+void add_newline(std::string& str, const Indent& indent);
+
+#endif //INDENT_H_
@@ -18,16 +18,88 @@ void process_lua_error(std::string& errStr, int& errLineNo)
 	}
 }
 
+//pushes the globals table
+static void push_globals(lua_State* L)
+{
+	#if LUA_VERSION_NUM >= 502
+		lua_rawgeti(L, LUA_REGISTRYINDEX, LUA_RIDX_GLOBALS);
+	#else  //5.1/LuaJIT
+		lua_pushvalue(L, LUA_GLOBALSINDEX);
+	#endif
+}
+
+static int abs_index(lua_State* L, const int& index)
+{
+	if(index < 0 && index > LUA_REGISTRYINDEX)
+		return lua_gettop(L) + index + 1;
+	return index;
+}
+
+//pushes a shallow copy of the table at index, only of string keys if stringKeys is set
+static void push_copy(lua_State* L, int index, const bool& stringKeys)
+{
+	index = abs_index(L, index);
+	lua_newtable(L);
+	lua_pushnil(L);
+	while(lua_next(L, index))
+	{
+		if(stringKeys && lua_type(L, -2) != LUA_TSTRING)
+		{
+			lua_pop(L, 1);
+			continue;
+		}
+		lua_pushvalue(L, -2);
+		lua_insert(L, -2);
+		lua_rawset(L, -4);
+	}
+}
+
+//makes the table at index hold what it did when copy was taken
+static void restore(lua_State* L, int index, int copyIndex, const bool& stringKeys)
+{
+	index = abs_index(L, index);
+	copyIndex = abs_index(L, copyIndex);
+
+	//removes keys added since, clearing fields is fine mid traversal
+	lua_pushnil(L);
+	while(lua_next(L, index))
+	{
+		lua_pop(L, 1);
+		if(stringKeys && lua_type(L, -1) != LUA_TSTRING)
+			continue;
+		lua_pushvalue(L, -1);
+		lua_rawget(L, copyIndex);
+		if(lua_isnil(L, -1))
+		{
+			lua_pop(L, 1);
+			lua_pushvalue(L, -1);
+			lua_pushnil(L);
+			lua_rawset(L, index);
+		}
+		else
+			lua_pop(L, 1);
+	}
+
+	//puts back values changed since
+	lua_pushnil(L);
+	while(lua_next(L, copyIndex))
+	{
+		lua_pushvalue(L, -2);
+		lua_insert(L, -2);
+		lua_rawset(L, index);
+	}
+}
+
 Lua::Lua()
 {
-	initialised = 0;
+	initialised = pageInitialised = 0;
 }
 
 Lua::~Lua()
 {
 	if(initialised)
 	{
-		initialised = 0;
+		initialised = pageInitialised = 0;
 		lua_close(L);
 	}
 }
@@ -39,15 +111,121 @@ void Lua::init()
 		initialised = 1;
 		L = luaL_newstate();
 		luaL_openlibs(L);
+		snapshot();
 	}
+	pageInitialised = 1;
 }
 
 void Lua::reset()
 {
 	if(initialised)
 	{
+		pageInitialised = 0;
 		lua_close(L);
+		chunks.clear();
 		L = luaL_newstate();
 		luaL_openlibs(L);
+		snapshot();
+	}
+}
+
+//records globals, library tables and the registry for new_page to go back to
+void Lua::snapshot()
+{
+	lua_newtable(L);
+	lua_pushvalue(L, -1);
+	lua_setfield(L, LUA_REGISTRYINDEX, "nsm_snapshot__");
+
+	push_globals(L);
+	push_copy(L, -1, 0);
+	lua_setfield(L, -3, "globals");
+
+	//libraries are copied a level deep, keyed by the library table
+	lua_newtable(L);
+	lua_pushnil(L);
+	while(lua_next(L, -3))
+	{
+		if(lua_istable(L, -1) && !lua_rawequal(L, -1, -4))
+		{
+			push_copy(L, -1, 0);
+			lua_rawset(L, -4);
+		}
+		else
+			lua_pop(L, 1);
+	}
+	lua_getfield(L, LUA_REGISTRYINDEX, "_LOADED");
+	if(lua_istable(L, -1))
+	{
+		lua_pushvalue(L, -1);
+		push_copy(L, -1, 0);
+		lua_rawset(L, -4);
+	}
+	lua_pop(L, 1);
+	lua_setfield(L, -3, "libs");
+	lua_pop(L, 1);
+
+	//integer keys are luaL_ref references, which includes cached chunks
+	push_copy(L, LUA_REGISTRYINDEX, 1);
+	lua_setfield(L, -2, "registry");
+
+	lua_pop(L, 1);
+}
+
+//isolates the next page from anything the last page did
+void Lua::new_page()
+{
+	pageInitialised = 0;
+	if(!initialised)
+		return;
+
+	lua_settop(L, 0);
+
+	lua_getfield(L, LUA_REGISTRYINDEX, "nsm_snapshot__");
+
+	push_globals(L);
+	lua_getfield(L, 1, "globals");
+	restore(L, 2, 3, 0);
+	lua_pushnil(L);
+	lua_setmetatable(L, 2);
+	lua_pop(L, 2);
+
+	lua_getfield(L, 1, "libs");
+	lua_pushnil(L);
+	while(lua_next(L, 2))
+	{
+		restore(L, -2, -1, 0);
+		lua_pop(L, 1);
 	}
+	lua_pop(L, 1);
+
+	lua_getfield(L, 1, "registry");
+	restore(L, LUA_REGISTRYINDEX, 2, 1);
+
+	lua_settop(L, 0);
+}
+
+//pushes the compiled chunk for source, or the error message if it fails to compile
+int Lua::load_chunk(const std::string& source)
+{
+	auto found = chunks.find(source);
+	if(found != chunks.end())
+	{
+		lua_rawgeti(L, LUA_REGISTRYINDEX, found->second);
+		return 0;
+	}
+
+	int result = luaL_loadstring(L, source.c_str());
+	if(result || chunks.size() >= LUA_CHUNK_CACHE_SIZE)
+		return result;
+
+	lua_pushvalue(L, -1);
+	chunks[source] = luaL_ref(L, LUA_REGISTRYINDEX);
+
+	return 0;
+}
+
+//same as luaL_dostring with the chunk compiled at most once
+int Lua::do_chunk(const std::string& source)
+{
+	return load_chunk(source) || lua_pcall(L, 0, LUA_MULTRET, 0);
 }
@@ -3,6 +3,7 @@
 
 #include <cstdio>
 #include <iostream>
+#include <unordered_map>
 
 #include "StrFns.h"
 
@@ -42,18 +43,35 @@
 	#endif
 #endif
 
+#define LUA_CHUNK_CACHE_SIZE 256
+
 void process_lua_error(std::string& errStr, int& errLineNo);
 
+/*
+	lua state kept for as long as its parser, rather than closed after every
+	page. new_page puts globals, library tables and string keyed registry
+	entries back to how they were straight after the libraries were opened,
+	and compiled chunks are cached by source so repeated blocks load once.
+	pageInitialised is reset by new_page, so code setting up the state
+	(eg. adding the nsm functions) runs again for each page as it did when
+	every page had a new state.
+*/
 struct Lua
 {
-	bool initialised;
+	bool initialised, pageInitialised;
 	lua_State* L;
+	std::unordered_map<std::string, int> chunks; //registry refs of compiled chunks
 
 	Lua();
 	~Lua();
 
 	void init();
 	void reset();
+	void snapshot();
+	void new_page();
+
+	int load_chunk(const std::string& source);
+	int do_chunk(const std::string& source);
 };
 
 
@@ -201,10 +201,11 @@ int lua_exprtk(lua_State* L)
 	{
 		//lua_nsm_pusherrmsg(L, "exprtk: failed to compile expression");
 
+		const exprtk::parser<double>& parser = expr->errors();
 		size_t errLineNo;
-		for(size_t i=0; i < expr->parser.error_count(); ++i)
+		for(size_t i=0; i < parser.error_count(); ++i)
 		{
-			exprtk::parser_error::type error = expr->parser.get_error(i);
+			exprtk::parser_error::type error = parser.get_error(i);
 
 			if(std::to_string(error.token.position) == "18446744073709551615")
 				errLineNo = 0;
@@ -250,10 +251,11 @@ int lua_exprtk_compile(lua_State* L)
 
 		if(!expr->compile(exprStr))
 		{
+			const exprtk::parser<double>& parser = expr->errors();
 			size_t errLineNo;
-			for(size_t i=0; i < expr->parser.error_count(); ++i)
+			for(size_t i=0; i < parser.error_count(); ++i)
 			{
-				exprtk::parser_error::type error = expr->parser.get_error(i);
+				exprtk::parser_error::type error = parser.get_error(i);
 
 				if(std::to_string(error.token.position) == "18446744073709551615")
 					errLineNo = 0;
@@ -301,10 +303,11 @@ int lua_exprtk_compile(lua_State* L)
 
 		if(!exprset->compile(name, exprStr))
 		{
+			const exprtk::parser<double>& parser = exprset->cache->errors(exprStr);
 			size_t errLineNo;
-			for(size_t i=0; i < exprset->parser.error_count(); ++i)
+			for(size_t i=0; i < parser.error_count(); ++i)
 			{
-				exprtk::parser_error::type error = exprset->parser.get_error(i);
+				exprtk::parser_error::type error = parser.get_error(i);
 
 				if(std::to_string(error.token.position) == "18446744073709551615")
 					errLineNo = 0;
@@ -673,7 +676,7 @@ int lua_nsm_write(lua_State* L)
 
 		if(param == NSM_OFILE)
 		{
-			std::string* indentAmount;
+			Indent* indentAmount;
 			std::string* parsedText;
 			bool indent = 1;
 
@@ -684,7 +687,7 @@ int lua_nsm_write(lua_State* L)
 				lua_error(L);
 				return 0;
 			}
-			indentAmount = (std::string*)lua_topointer(L, 1);
+			indentAmount = (Indent*)lua_topointer(L, 1);
 			lua_remove(L, 1);
 
 			lua_getglobal(L, "nsm_parsedText__");
@@ -705,12 +708,12 @@ int lua_nsm_write(lua_State* L)
 			{
 				getline(iss, ssLine);
 				if(0 < ssLineNo++)
-					*parsedText += "\n" + *indentAmount;
+					add_newline(*parsedText, *indentAmount);
 				oldLine = ssLine;
 				*parsedText += ssLine;
 			}
 			if(indent)
-				*indentAmount += into_whitespace(oldLine);
+				indentAmount->add_text(oldLine);
 
 			lua_pushnumber(L, 1);
 			return 1;
@@ -0,0 +1,86 @@
+#include "OutputSink.h"
+
+#include <algorithm>
+
+OutputSink::OutputSink()
+{
+	noBytes = 0;
+}
+
+void OutputSink::append(const char* str, const size_t& len)
+{
+	if(!len)
+		return;
+
+	std::string* chunk = chunks.size() ? chunks.back().get() : NULL;
+	if(!chunk || chunk->capacity() - chunk->size() < len)
+	{
+		chunks.push_back(std::unique_ptr<std::string>(new std::string()));
+		chunk = chunks.back().get();
+		chunk->reserve(std::max((size_t)SINK_CHUNK_SIZE, len));
+	}
+
+	//capacity is reserved up front so earlier slices into the chunk stay valid
+	const char* start = chunk->c_str() + chunk->size();
+	chunk->append(str, len);
+
+	//extends the previous slice when it ends where this starts
+	if(slices.size() && slices.back().str + slices.back().len == start)
+		slices.back().len += len;
+	else
+	{
+		Slice slice;
+		slice.str = start;
+		slice.len = len;
+		slices.push_back(slice);
+	}
+
+	noBytes += len;
+}
+
+void OutputSink::append(const std::string& str)
+{
+	append(str.c_str(), str.size());
+}
+
+void OutputSink::splice(const char* str, const size_t& len)
+{
+	if(!len)
+		return;
+
+	if(slices.size() && slices.back().str + slices.back().len == str)
+		slices.back().len += len;
+	else
+	{
+		Slice slice;
+		slice.str = str;
+		slice.len = len;
+		slices.push_back(slice);
+	}
+
+	noBytes += len;
+}
+
+void OutputSink::splice(const std::string& str)
+{
+	splice(str.c_str(), str.size());
+}
+
+void OutputSink::splice(const std::string& str, const size_t& pos, const size_t& len)
+{
+	splice(str.c_str() + pos, len);
+}
+
+size_t OutputSink::size() const
+{
+	return noBytes;
+}
+
+std::string OutputSink::str() const
+{
+	std::string result;
+	result.reserve(noBytes);
+	for(size_t s=0; s<slices.size(); ++s)
+		result.append(slices[s].str, slices[s].len);
+	return result;
+}
@@ -0,0 +1,48 @@
+#ifndef OUTPUT_SINK_H_
+#define OUTPUT_SINK_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#define SINK_CHUNK_SIZE 65536
+
+//piece of output, either in a chunk owned by the sink or spliced in from elsewhere
+struct Slice
+{
+	const char* str;
+	size_t len;
+};
+
+/*
+	output built up as a list of slices rather than one contiguous string.
+	appended text is copied into fixed size chunks which are never
+	reallocated, spliced text is referred to where it is without copying
+	so must outlive the sink. written out with writev by OutputWriter.
+
+	only used where output is written and pagination pages are spliced
+	in, parsedText stays a std::string as the parser reads back what has
+	been written so far (indentation of the current line, the position of
+	__paginate_here__, @return values), and exprtk/lua nsm_write are
+	handed a pointer to it. doing that through slices means flattening
+	them again, which is the copy the sink is there to avoid.
+*/
+struct OutputSink
+{
+	std::vector<std::unique_ptr<std::string> > chunks;
+	std::vector<Slice> slices;
+	size_t noBytes;
+
+	OutputSink();
+
+	void append(const char* str, const size_t& len);
+	void append(const std::string& str);
+	void splice(const char* str, const size_t& len);
+	void splice(const std::string& str);
+	void splice(const std::string& str, const size_t& pos, const size_t& len);
+
+	size_t size() const;
+	std::string str() const;
+};
+
+#endif //OUTPUT_SINK_H_
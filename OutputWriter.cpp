@@ -0,0 +1,162 @@
+#include "OutputWriter.h"
+
+#include <fstream>
+
+#if defined _WIN32 || defined _WIN64
+#else  //*nix
+	#include <sys/uio.h>
+#endif
+
+#include "Profiler.h"
+
+OutputWriter outputWriter;
+
+OutputWriter::OutputWriter()
+{
+	noWritten = noSkipped = 0;
+}
+
+void OutputWriter::reset()
+{
+	noWritten = noSkipped = 0;
+}
+
+//whether file at pathStr already holds exactly the contents of sink
+static bool same_contents(const std::string& pathStr, const OutputSink& sink)
+{
+	struct stat sb;
+
+	//sizes differing is enough in almost all cases
+	if(stat(pathStr.c_str(), &sb) || S_ISDIR(sb.st_mode) || (size_t)sb.st_size != sink.size())
+		return 0;
+
+	std::ifstream ifs(pathStr, std::ios::binary);
+	if(!ifs.is_open())
+		return 0;
+
+	char buf[65536];
+	size_t pos, len;
+	for(size_t s=0; s<sink.slices.size(); ++s)
+	{
+		const Slice& slice = sink.slices[s];
+		for(pos = 0; pos < slice.len; pos += len)
+		{
+			len = std::min(sizeof(buf), slice.len - pos);
+			ifs.read(buf, len);
+			if((size_t)ifs.gcount() != len || std::memcmp(buf, slice.str + pos, len))
+				return 0;
+		}
+	}
+
+	return 1;
+}
+
+#if defined _WIN32 || defined _WIN64
+#else  //*nix
+	#define WRITEV_MAX 1024
+
+	//writes every slice of sink with as few writev calls as possible
+	static bool write_all(const int& fd, const OutputSink& sink)
+	{
+		std::vector<struct iovec> iovs(sink.slices.size());
+		for(size_t s=0; s<sink.slices.size(); ++s)
+		{
+			iovs[s].iov_base = (void*)sink.slices[s].str;
+			iovs[s].iov_len = sink.slices[s].len;
+		}
+
+		size_t cIov = 0;
+		while(cIov < iovs.size())
+		{
+			ssize_t n = ::writev(fd, &iovs[cIov], std::min(iovs.size() - cIov, (size_t)WRITEV_MAX));
+			if(n < 0)
+				return 0;
+
+			//skips past fully written slices then moves into a partially written one
+			while(cIov < iovs.size() && n >= (ssize_t)iovs[cIov].iov_len)
+				n -= iovs[cIov++].iov_len;
+			if(n)
+			{
+				iovs[cIov].iov_base = (char*)iovs[cIov].iov_base + n;
+				iovs[cIov].iov_len -= n;
+			}
+		}
+
+		return 1;
+	}
+#endif
+
+int OutputWriter::write(const Path& path, const std::string& contents, const std::string& trailer)
+{
+	OutputSink sink;
+	sink.splice(contents);
+	sink.splice(trailer);
+
+	return write(path, sink);
+}
+
+int OutputWriter::write(const Path& path, const OutputSink& sink)
+{
+	std::string pathStr = path.str();
+	ProfileSpan writeSpan("write", "write", pathStr);
+
+	if(same_contents(pathStr, sink))
+	{
+		noSkipped++;
+		return 0;
+	}
+
+	//makes sure directory for output file exists
+	path.ensureDirExists();
+
+	#if defined _WIN32 || defined _WIN64
+		//rename can't replace existing files on Windows
+		chmod(pathStr.c_str(), 0666);
+		std::ofstream ofs(pathStr);
+		for(size_t s=0; s<sink.slices.size(); ++s)
+			ofs.write(sink.slices[s].str, sink.slices[s].len);
+		ofs.close();
+		chmod(pathStr.c_str(), 0444);
+		if(!ofs)
+			return 1;
+	#else  //*nix
+		std::string tmpPathStr = pathStr + ".nift-tmp";
+
+		int fd = ::open(tmpPathStr.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if(fd < 0)
+		{
+			//may be read only temporary file left behind by an interrupted build
+			unlink(tmpPathStr.c_str());
+			fd = ::open(tmpPathStr.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+			if(fd < 0)
+				return 1;
+		}
+
+		//makes sure user can't accidentally write to output file
+		if(!write_all(fd, sink) || fchmod(fd, 0444))
+		{
+			close(fd);
+			unlink(tmpPathStr.c_str());
+			return 1;
+		}
+		close(fd);
+
+		if(rename(tmpPathStr.c_str(), pathStr.c_str()))
+		{
+			unlink(tmpPathStr.c_str());
+			return 1;
+		}
+	#endif
+
+	noWritten++;
+
+	return 0;
+}
+
+void OutputWriter::report(std::ostream& os)
+{
+	if(noSkipped == 1)
+		os << "1 unchanged file not rewritten" << std::endl;
+	else if(noSkipped)
+		os << noSkipped << " unchanged files not rewritten" << std::endl;
+}
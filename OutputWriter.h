@@ -0,0 +1,32 @@
+#ifndef OUTPUT_WRITER_H_
+#define OUTPUT_WRITER_H_
+
+#include <atomic>
+#include <cstring>
+
+#include "FileSystem.h"
+#include "OutputSink.h"
+
+/*
+	writes built output (output files, paginated pages and pagination
+	files) through one place. info files are written directly as their
+	modified times are used as build times. files already holding exactly the new contents
+	are left alone so their modified times are preserved, otherwise contents
+	are written to a temporary file next to the target which is renamed over
+	it, so readers never see a partially written file.
+*/
+struct OutputWriter
+{
+	std::atomic<size_t> noWritten, noSkipped;
+
+	OutputWriter();
+
+	void reset();
+	int write(const Path& path, const std::string& contents, const std::string& trailer);
+	int write(const Path& path, const OutputSink& sink);
+	void report(std::ostream& os);
+};
+
+extern OutputWriter outputWriter;
+
+#endif //OUTPUT_WRITER_H_
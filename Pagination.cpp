@@ -1,5 +1,12 @@
 #include "Pagination.h"
 
+#include "RapidJSON.h"
+
+PageState::PageState()
+{
+	size = mtime = -1;
+}
+
 Pagination::Pagination()
 {
 	reset();
@@ -7,13 +14,142 @@ Pagination::Pagination()
 
 void Pagination::reset()
 {
-	cPageNo = noPages = 0;
+	cPageNo = noPages = splitStart = splitEnd = 0;
 	noItemsPerPage = 25;
 	callLineNo = separatorLineNo = templateCallLineNo = templateLineNo = -1;
-	indentAmount = paginateName = "";
+	indentAmount.clear();
+	paginateName = "";
 	separator = "\n\n";
 	templateStr = "$[paginate.page]";
 	items.clear();
 	pages.clear();
 	itemLineNos.clear();
+	itemCallLineNos.clear();
+	itemCallPaths.clear();
+	oldStates.clear();
+	states.clear();
+	skipped.clear();
+}
+
+//reads page states from the previous build, returning how many pages there were
+//files from before page states were recorded only have no-pages
+size_t Pagination::read_states(const std::string& pathStr)
+{
+	oldStates.clear();
+
+	if(!file_exists(pathStr))
+		return 0;
+
+	rapidjson::Document doc;
+	doc.Parse(string_from_file(pathStr).c_str());
+	if(!doc.IsObject() || !doc.HasMember("no-pages") || !doc["no-pages"].IsUint())
+		return 0;
+
+	if(doc.HasMember("pages") && doc["pages"].IsArray())
+	{
+		for(auto page=doc["pages"].Begin(); page!=doc["pages"].End(); ++page)
+		{
+			PageState state;
+			if(page->IsObject() &&
+			   page->HasMember("fingerprint") && (*page)["fingerprint"].IsString() &&
+			   page->HasMember("size") && (*page)["size"].IsInt64() &&
+			   page->HasMember("mtime") && (*page)["mtime"].IsInt64() &&
+			   page->HasMember("deps") && (*page)["deps"].IsObject())
+			{
+				state.fingerprint = (*page)["fingerprint"].GetString();
+				state.size = (*page)["size"].GetInt64();
+				state.mtime = (*page)["mtime"].GetInt64();
+				for(auto dep=(*page)["deps"].MemberBegin(); dep!=(*page)["deps"].MemberEnd(); ++dep)
+					if(dep->value.IsUint())
+						state.deps.push_back(std::make_pair(std::string(dep->name.GetString()), dep->value.GetUint()));
+			}
+			oldStates.push_back(state);
+		}
+	}
+
+	return doc["no-pages"].GetUint();
+}
+
+std::string Pagination::states_json() const
+{
+	rapidjson::StringBuffer sb;
+	rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(sb);
+	writer.SetIndent('\t', 1);
+
+	writer.StartObject();
+	writer.Key("no-pages");
+	writer.Uint64(states.size());
+	writer.Key("pages");
+	writer.StartArray();
+	for(size_t p=0; p<states.size(); ++p)
+	{
+		writer.StartObject();
+		writer.Key("fingerprint");
+		writer.String(states[p].fingerprint.c_str());
+		writer.Key("size");
+		writer.Int64(states[p].size);
+		writer.Key("mtime");
+		writer.Int64(states[p].mtime);
+		writer.Key("deps");
+		writer.StartObject();
+		for(size_t d=0; d<states[p].deps.size(); ++d)
+		{
+			writer.Key(states[p].deps[d].first.c_str());
+			writer.Uint(states[p].deps[d].second);
+		}
+		writer.EndObject();
+		writer.EndObject();
+	}
+	writer.EndArray();
+	writer.EndObject();
+
+	return sb.GetString();
+}
+
+//whether page p was built last time from the same fingerprint and files, with its output file untouched since
+bool Pagination::unchanged(const size_t& p, const std::string& fingerprint, const Path& outputPath) const
+{
+	if(p >= oldStates.size() || oldStates[p].fingerprint == "" || oldStates[p].fingerprint != fingerprint)
+		return 0;
+
+	struct stat sb;
+	if(stat(outputPath.str().c_str(), &sb) || 
+	   (long long)sb.st_size != oldStates[p].size || 
+	   mtime_ns(sb) != oldStates[p].mtime)
+		return 0;
+
+	std::shared_ptr<const FileContents> contents;
+	for(size_t d=0; d<oldStates[p].deps.size(); ++d)
+	{
+		contents = fileCache.get(oldStates[p].deps[d].first);
+		if(!contents->ok || contents->hash != oldStates[p].deps[d].second)
+			return 0;
+	}
+
+	return 1;
+}
+
+void Pagination::add_deps(const size_t& p, const std::set<Path>& deps)
+{
+	size_t noDeps = states[p].deps.size();
+	bool recorded;
+	for(auto dep=deps.begin(); dep!=deps.end(); ++dep)
+	{
+		std::string depStr = dep->str();
+		recorded = 0;
+		for(size_t d=0; d<noDeps && !recorded; ++d)
+			recorded = (states[p].deps[d].first == depStr);
+		if(!recorded)
+			states[p].deps.push_back(std::make_pair(depStr, fileCache.get(depStr)->hash));
+	}
+}
+
+void Pagination::set_output(const size_t& p, const Path& outputPath)
+{
+	struct stat sb;
+	if(!stat(outputPath.str().c_str(), &sb))
+	{
+		states[p].size = sb.st_size;
+		states[p].mtime = mtime_ns(sb);
+	}
 }
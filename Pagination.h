@@ -1,8 +1,36 @@
 #ifndef PAGINATION_H_
 #define PAGINATION_H_
 
+#include <set>
+#include <utility>
+
+#include "FileCache.h"
+#include "Indent.h"
 #include "Path.h"
 
+//fewest pagination items worth rendering as a separate task
+const size_t PAGINATE_ITEMS_PER_TASK = 256;
+
+//what a paginated page was built from, so it can be left alone next build if none of it changes
+struct PageState
+{
+	std::string fingerprint; //empty when the page always needs building
+	long long size, mtime;   //of the page's output file once written
+	std::vector<std::pair<std::string, unsigned int> > deps; //files read building the page along with the FNVHash of their contents
+
+	PageState();
+};
+
+//pages of pagination items rendered ahead of time in parallel, see Parser::render_items_in_parallel
+struct RenderedItems
+{
+	std::string varsBefore; //fingerprint of the variables the pages were rendered from
+	std::vector<char> rendered;
+	std::vector<std::string> pages;
+	std::vector<std::set<Path> > deps;
+	std::vector<char> volatileReads; //whether the page's items read anything volatile, see Parser::volatileRead
+};
+
 struct Pagination
 {
 	bool ftl; //first-to-last
@@ -12,20 +40,29 @@ struct Pagination
 	    separatorLineNo,
 	    templateCallLineNo,
 	    templateLineNo;
-	size_t cPageNo;
-	std::string indentAmount,
-	            paginateName,
+	size_t cPageNo,
+	       splitStart, splitEnd; //pages replace [splitStart, splitEnd) of splitFile
+	Indent indentAmount;
+	std::string paginateName,
 	            separator,
 	            templateStr;
 	Path callPath;
-	std::pair<std::string, std::string> splitFile;
+	std::string splitFile; //parsed output pages are spliced into, see OutputSink for why pages aren't parsed straight into a sink
 	std::vector<std::string> items, pages;
 	std::vector<int> itemLineNos, itemCallLineNos;
 	std::vector<Path> itemCallPaths;
+	std::vector<PageState> oldStates, states; //from the previous build and this build
+	std::vector<char> skipped; //pages left alone as unchanged since the previous build
 
 	Pagination();
 
 	void reset();
+
+	size_t read_states(const std::string& pathStr);
+	std::string states_json() const;
+	bool unchanged(const size_t& p, const std::string& fingerprint, const Path& outputPath) const;
+	void add_deps(const size_t& p, const std::set<Path>& deps);
+	void set_output(const size_t& p, const Path& outputPath);
 };
 
 
@@ -47,6 +47,7 @@ Parser::Parser(std::set<TrackedInfo>* TrackedAll,
 	defaultTemplate = DefaultTemplate;
 	addMemberFnsGlobal = addScopeGlobal = replaceVarsGlobal = 1;
 	backupScripts = BackupScripts;
+	prebuildExists = postbuildExists = -1;
 	consoleLocked = 0;
 	unixTextEditor = UnixTextEditor;
 	winTextEditor = WinTextEditor;
@@ -56,11 +57,28 @@ Parser::Parser(std::set<TrackedInfo>* TrackedAll,
 	mode = -1;
 	exprtkParams = 0;
 	lolcatActive = lolcatInit = 0;
+	volatileRead = itemClone = 0;
 
 	//lua.init(); //don't want this done always
 
-	symbol_table.add_package(basicio_package);
-	symbol_table.add_package(fileio_package);
+	add_exprtk_symbols();
+
+	exprCache.set_symbol_table(symbol_table);
+	expr.use_cache(exprCache);
+	exprset.use_cache(exprCache);
+
+	expr.compile("1");
+	//exprset.compile("1");
+}
+
+//adds the default exprtk packages, constants and functions, clones get none that reach outside the page
+void Parser::add_exprtk_symbols()
+{
+	if(!itemClone)
+	{
+		symbol_table.add_package(basicio_package);
+		symbol_table.add_package(fileio_package);
+	}
 	symbol_table.add_package(vectorops_package);
 
 	//symbol_table.add_stringvar("parsedText", parsedText);
@@ -68,10 +86,13 @@ Parser::Parser(std::set<TrackedInfo>* TrackedAll,
 	symbol_table.add_constant("endl", NSM_ENDL);
 	symbol_table.add_constant("ofile", NSM_OFILE);
 
-	symbol_table.add_function("cd", exprtk_cd_fn);
+	if(!itemClone)
+	{
+		symbol_table.add_function("cd", exprtk_cd_fn);
 
-	exprtk_sys_fn.setModePtr(&mode);
-	symbol_table.add_function("sys", exprtk_sys_fn);
+		exprtk_sys_fn.setModePtr(&mode);
+		symbol_table.add_function("sys", exprtk_sys_fn);
+	}
 
 	symbol_table.add_function("to_string", exprtk_to_string_fn);
 
@@ -85,14 +106,27 @@ Parser::Parser(std::set<TrackedInfo>* TrackedAll,
 	exprtk_nsm_setstring_fn.setVars(&vars);
 	symbol_table.add_function("nsm_setstring", exprtk_nsm_setstring_fn);
 
-	exprtk_nsm_write_fn.add_info(&vars, &parsedText, &indentAmount, &consoleLocked, OS_mtx);
-	symbol_table.add_function("nsm_write", exprtk_nsm_write_fn);
+	if(!itemClone)
+	{
+		exprtk_nsm_write_fn.add_info(&vars, &parsedText, &indentAmount, &consoleLocked, os_mtx);
+		symbol_table.add_function("nsm_write", exprtk_nsm_write_fn);
+	}
+}
 
-	expr.register_symbol_table(symbol_table);
-	exprset.add_symbol_table(&symbol_table);
+/*
+	makes the parser a clone for rendering pagination items, which refuses
+	to call builtins without BUILTIN_ITEM_SAFE and has no exprtk symbols
+	reaching outside the page. refused calls fail the item, so the page is
+	left to be rendered sequentially.
+*/
+void Parser::make_item_clone()
+{
+	itemClone = 1;
 
-	expr.compile("1");
-	//exprset.compile("1");
+	//functions can't all be removed from a symbol table, so the clone starts a new one
+	symbol_table = exprtk::symbol_table<double>();
+	add_exprtk_symbols();
+	exprCache.set_symbol_table(symbol_table);
 }
 
 int Parser::lua_addnsmfns()
@@ -279,15 +313,16 @@ int Parser::lolcat_init(const std::string& lolcat_cmd)
 	return 1;
 }
 
-int Parser::run_script(std::ostream& os, const Path& scriptPath, const bool& makeBackup, const bool& outputWhatDoing)
+int Parser::run_script(std::ostream& os, const Path& scriptPath, const bool& outputWhatDoing)
 {
 	if(file_exists(scriptPath.str()))
 	{
+		ProfileSpan scriptSpan("script", "script", scriptPath.str());
+
 		if(outputWhatDoing)
 			os << "running " << scriptPath << ".." << std::endl;
 
 		int result;
-		int c = sys_counter++;
 		size_t pos = scriptPath.str().substr(1, scriptPath.str().size()-1).find_last_of('.');
 		std::string cScriptExt = "";
 		if(pos != std::string::npos)
@@ -339,7 +374,7 @@ int Parser::run_script(std::ostream& os, const Path& scriptPath, const bool& mak
 		}
 		else if(cScriptExt == ".lua")
 		{
-			if(!lua.initialised)
+			if(!lua.pageInitialised)
 			{
 				lua.init();
 				lua_addnsmfns();
@@ -385,7 +420,7 @@ int Parser::run_script(std::ostream& os, const Path& scriptPath, const bool& mak
 				if(!consoleLocked)
 					os_mtx->lock();
 				start_err(os, scriptPath) << "exprtk: failed to compile script" << std::endl;
-				print_exprtk_parser_errs(os, expr.parser, toProcess, scriptPath, lineNo);
+				print_exprtk_parser_errs(os, expr.errors(), toProcess, scriptPath, lineNo);
 				os_mtx->unlock();
 			}
 			else
@@ -396,73 +431,34 @@ int Parser::run_script(std::ostream& os, const Path& scriptPath, const bool& mak
 		}
 		else
 		{
-			std::string execPath = "./.script" + std::to_string(c) + cScriptExt;
-			std::string output_filename = ".script.out" + std::to_string(c);
-			//std::string output_filename = scriptPath.str() + ".out" + std::to_string(c);
+			//runs the script where it is, so the same script can run from several threads at once
+			std::vector<std::string> execArgs;
+			std::string execPath = scriptPath.str();
 
 			#if defined _WIN32 || defined _WIN64
-				if(unquote(execPath).substr(0, 2) == "./")
-					execPath = unquote(execPath).substr(2, unquote(execPath).size()-2);
 			#else  //*nix
+				if(execPath.find('/') == std::string::npos)
+					execPath = "./" + execPath;
 			#endif
 
-			//copies script to backup location
-			if(makeBackup)
-			{
-				if(cpFile(scriptPath.str(), scriptPath.str() + ".backup", -1, Path("", ""), os, consoleLocked, os_mtx))
-				{
-					os_mtx->lock();
-					start_err(os) << "run_script(" << scriptPath << "): failed to copy " << scriptPath << " to " << quote(scriptPath.str() + ".backup") << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
-
-			//moves script to main directory
-			//note if just copy original script or move copied script get 'Text File Busy' errors (can be quite rare)
-			//sometimes this fails (on Windows) for some reason, so keeps trying until successful
-			int mcount = 0;
-			while(rename(scriptPath.str().c_str(), execPath.c_str()))
-			{
-				if(++mcount == 100)
-				{
-					os_mtx->lock();
-					start_warn(os) << "run_script(" << scriptPath << "): have tried to move " << scriptPath << " to " << quote(execPath) << " 100 times already, may need to abort" << std::endl;
-					os_mtx->unlock();
-				}
-			}
-
 			//checks whether we're running from flatpak
 			if(file_exists("/.flatpak-info"))
-				result = system(("flatpak-spawn --host bash -c " + quote(execPath) + " > " + output_filename).c_str());
-			else
-				result = system((execPath + " > " + output_filename).c_str());
-
-			//moves script back to its original location
-			//sometimes this fails (on Windows) for some reason, so keeps trying until successful
-			mcount = 0;
-			while(rename(execPath.c_str(), scriptPath.str().c_str()))
 			{
-				if(++mcount == 100)
-				{
-					os_mtx->lock();
-					start_warn(os) << "run_script(" << scriptPath << "): have tried to move " << quote(execPath) << " to " << scriptPath << " 100 times already, may need to abort" << std::endl;
-					os_mtx->unlock();
-				}
+				execArgs.push_back("flatpak-spawn");
+				execArgs.push_back("--host");
 			}
+			execArgs.push_back(execPath);
 
-			//deletes backup copy
-			if(makeBackup)
-				remove_file(Path("", scriptPath.str() + ".backup"));
+			bool timedOut;
+			std::string str;
+			result = spawn_argv(execArgs, &str, 0, timedOut);
 
-			std::string str = string_from_file(output_filename);
 			if(!is_whitespace(str))
 			{
 				os_mtx->lock();
 				os << str << std::endl;
 				os_mtx->unlock();
 			}
-			remove_file(Path("./", output_filename));
 		}
 
 		if(result)
@@ -534,7 +530,7 @@ int Parser::interactive(std::string& langStr, char& langCh, std::ostream& eos)
 
 	//makes sure variables are at default values
 	codeBlockDepth = htmlCommentDepth = 0;
-	indentAmount = "";
+	indentAmount.clear();
 	contentAdded = 0;
 	parsedText = "";
 	contentAdded = 0;
@@ -550,8 +546,9 @@ int Parser::interactive(std::string& langStr, char& langCh, std::ostream& eos)
 	exprtk_nsm_mode<double> exprtk_nsm_mode_fn;
 	exprtk_nsm_mode_fn.setModePtr(&mode);
 	symbol_table.add_function("nsm_mode", exprtk_nsm_mode_fn);
+	exprCache.symbols_added();
 
-	if(!lua.initialised)
+	if(!lua.pageInitialised)
 	{
 		lua.init();
 		lua_addnsmfns();
@@ -636,7 +633,7 @@ int Parser::interactive(std::string& langStr, char& langCh, std::ostream& eos)
 		}
 		toProcess += inLine;
 
-		indentAmount = "";
+		indentAmount.clear();
 
 		try
 		{
@@ -684,7 +681,7 @@ int Parser::interactive(std::string& langStr, char& langCh, std::ostream& eos)
 						if(!consoleLocked)
 							os_mtx->lock();
 						start_err(eos, emptyPath, 1) << c_light_blue << "exprtk" << c_white << ": failed to compile expression" << std::endl;
-						print_exprtk_parser_errs(eos, expr.parser, toProcess, emptyPath, 1);
+						print_exprtk_parser_errs(eos, expr.errors(), toProcess, emptyPath, 1);
 						if(!consoleLocked)
 							os_mtx->unlock();
 					}
@@ -798,6 +795,7 @@ int Parser::interactive(std::string& langStr, char& langCh, std::ostream& eos)
 	}
 
 	vars = Variables();
+	exprCache.symbols_removed();
 
 	if(consoleLocked && !result)
 	{
@@ -825,6 +823,52 @@ void setIncrMode(const int& IncrMode)
 	incrMode = IncrMode;
 }
 
+//records hash of dependency for incremental builds, once per dependency
+void record_dep_hash(const Path& dep)
+{
+	if(incrMode == INCR_MOD)
+		return;
+
+	checked_hash_mtx.lock();
+	if(checkedHashFile.count(dep))
+	{
+		checked_hash_mtx.unlock();
+		return;
+	}
+	checkedHashFile.insert(dep);
+	checked_hash_mtx.unlock();
+
+	//hashes what was read for the build rather than reading the file again
+	//files that couldn't be read are left without a hash so they are checked next build
+	std::shared_ptr<const FileContents> contents = fileCache.get(dep.str());
+	if(!contents->ok)
+		return;
+	unsigned int hash = contents->hash;
+
+	if(buildState.enabled)
+	{
+		DepFingerprint fp;
+		fp.mtime = contents->mtime;
+		fp.size = contents->size;
+		fp.hash = hash;
+		fp.hashed = 1;
+		buildState.set_fingerprint(dep, fp);
+	}
+	else
+	{
+		Path hashPath = dep.getHashPath();
+		std::string hashPathStr = hashPath.str();
+		if(!file_exists(hashPathStr) || 
+		   (unsigned) std::atoi(string_from_file(hashPathStr).c_str()) != hash)
+		{
+			hashPath.ensureDirExists();
+			std::ofstream ofs(hashPathStr);
+			ofs << hash << "\n";
+			ofs.close();
+		}
+	}
+}
+
 int Parser::run(const Path& path, char& langCh, const std::vector<std::string>& params, std::ostream& eos)
 {
 	mode = MODE_RUN;
@@ -845,7 +889,7 @@ int Parser::run(const Path& path, char& langCh, const std::vector<std::string>&
 
 	//makes sure variables are at default values
 	codeBlockDepth = htmlCommentDepth = 0;
-	indentAmount = "";
+	indentAmount.clear();
 	contentAdded = 0;
 	parsedText = "";
 	contentAdded = 0;
@@ -959,7 +1003,7 @@ int Parser::run(const Path& path, char& langCh, const std::vector<std::string>&
 					if(!consoleLocked)
 						os_mtx->lock();
 					start_err(eos, path) << "exprtk: failed to compile script" << std::endl;
-					print_exprtk_parser_errs(eos, expr.parser, scriptStr, path, lineNo);
+					print_exprtk_parser_errs(eos, expr.errors(), scriptStr, path, lineNo);
 					os_mtx->unlock();
 				}
 				else
@@ -977,6 +1021,7 @@ int Parser::run(const Path& path, char& langCh, const std::vector<std::string>&
 	}
 
 	vars = Variables();
+	exprCache.symbols_removed();
 
 	if(consoleLocked)
 	{
@@ -1006,6 +1051,8 @@ int Parser::build(const TrackedInfo& ToBuild,
 	mode = MODE_BUILD;
 	sys_counter = sys_counter%1000000000000000;
 	toBuild = ToBuild;
+	//reset before anything can fail so a failed page isn't paginated with the previous page's items
+	pagesInfo.reset();
 	vars.precision = 6;
 	vars.fixedPrecision = vars.scientificPrecision = 0;
 	bool blankTemplate = 0;
@@ -1048,130 +1095,78 @@ int Parser::build(const TrackedInfo& ToBuild,
 		cScriptExt = scriptExt;
 
 	//checks for pre-build scripts
-	if(file_exists("pre-build" + scriptExt))
+	if(prebuildExists == -1)
+		prebuildExists = file_exists("pre-build" + scriptExt);
+	if(prebuildExists)
 	{
 		Path dep("", "pre-build" + scriptExt);
-		if(incrMode != INCR_MOD)
-		{
-			checked_hash_mtx.lock();
-			if(!checkedHashFile.count(dep))
-			{
-				checkedHashFile.insert(dep);
-				checked_hash_mtx.unlock();
-				Path hashPath = dep.getHashPath();
-				std::string hashPathStr = hashPath.str();
-				unsigned int hash = FNVHash(string_from_file(dep.str()));
-				if(!file_exists(hashPathStr) || 
-				   (unsigned) std::atoi(string_from_file(hashPathStr).c_str()) != hash)
-				{
-					hashPath.ensureDirExists();
-					std::ofstream ofs(hashPathStr);
-					ofs << hash << "\n";
-					ofs.close();
-				}
-			}
-			else
-				checked_hash_mtx.unlock();
-		}
+		record_dep_hash(dep);
 		depFiles.insert(dep);
 	}
 	Path prebuildScript = toBuild.contentPath;
 	prebuildScript.file = prebuildScript.file.substr(0, prebuildScript.file.find_last_of('.')) + "-pre-build" + cScriptExt;
 	if(file_exists(prebuildScript.str()))
 	{
-		if(incrMode != INCR_MOD)
-		{
-			checked_hash_mtx.lock();
-			if(!checkedHashFile.count(prebuildScript))
-			{
-				checkedHashFile.insert(prebuildScript);
-				checked_hash_mtx.unlock();
-				Path hashPath = prebuildScript.getHashPath();
-				std::string hashPathStr = hashPath.str();
-				unsigned int hash = FNVHash(string_from_file(prebuildScript.str()));
-				if(!file_exists(hashPathStr) || 
-				   (unsigned) std::atoi(string_from_file(hashPathStr).c_str()) != hash)
-				{
-					hashPath.ensureDirExists();
-					std::ofstream ofs(hashPathStr);
-					ofs << hash << "\n";
-					ofs.close();
-				}
-			}
-			else
-				checked_hash_mtx.unlock();
-		}
+		record_dep_hash(prebuildScript);
 		depFiles.insert(prebuildScript);
+		if(run_script(eos, prebuildScript, 0))
+			return 1;
 	}
-	if(run_script(eos, prebuildScript, backupScripts, 0))
-		return 1;
 
 	//makes sure variables are at default values
 	codeBlockDepth = htmlCommentDepth = 0;
-	indentAmount = "";
+	indentAmount.clear();
 	contentAdded = 0;
 	addMemberFnsGlobal = addScopeGlobal = replaceVarsGlobal = 1;
 	parsedText = "";
 	contentAdded = 0;
 
-	pagesInfo.reset();
-
 	//checks number of pagination pages from previous build
 	Path paginationPath = toBuild.outputPath.getPaginationPath();
 	std::string paginationPathStr = paginationPath.str();
-	size_t oldNoPaginationPages = 0;
-	if(file_exists(paginationPathStr))
-	{
-		std::string str;
-		rapidjson::Document doc;
-
-		doc.Parse(string_from_file(paginationPathStr).c_str());
-		oldNoPaginationPages = doc["no-pages"].GetInt();
-	}
+	size_t oldNoPaginationPages = pagesInfo.read_states(paginationPathStr);
 
 	//adds template path to dependencies
 	if(!blankTemplate)
 	{
-		if(incrMode != INCR_MOD)
-		{
-			checked_hash_mtx.lock();
-			if(!checkedHashFile.count(toBuild.templatePath))
-			{
-				checkedHashFile.insert(toBuild.templatePath);
-				checked_hash_mtx.unlock();
-				Path hashPath = toBuild.templatePath.getHashPath();
-				std::string hashPathStr = hashPath.str();
-				unsigned int hash = FNVHash(string_from_file(toBuild.templatePath.str()));
-				if(!file_exists(hashPathStr) || 
-				   (unsigned) std::atoi(string_from_file(hashPathStr).c_str()) != hash)
-				{
-					hashPath.ensureDirExists();
-					std::ofstream ofs(hashPathStr);
-					ofs << hash << "\n";
-					ofs.close();
-				}
-			}
-			else
-				checked_hash_mtx.unlock();
-		}
+		record_dep_hash(toBuild.templatePath);
 		depFiles.insert(toBuild.templatePath);
 	}
 
 	//opens up template file to start parsing from
-	std::string fileStr;
+	std::shared_ptr<const FileContents> fileContents;
 	if(blankTemplate)
 	{
 		contentAdded = 1;
-		fileStr = string_from_file(toBuild.contentPath.str());
+		fileContents = fileCache.get(toBuild.contentPath.str());
 	}
 	else
-		fileStr = string_from_file(toBuild.templatePath.str());
+		fileContents = fileCache.get(toBuild.templatePath.str());
+	if(!fileContents->ok)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		if(blankTemplate)
+			start_err(eos) << "failed to read content file " << toBuild.contentPath << std::endl;
+		else
+			start_err(eos) << "failed to read template file " << toBuild.templatePath << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+	const std::string& fileStr = fileContents->str;
 
 	//creates anti-deps of template set
 	std::set<Path> antiDepsOfReadPath;
 
 	//starts read_and_process from templatePath
-	int result = n_read_and_process_fast(1, fileStr, 0, toBuild.templatePath, antiDepsOfReadPath, parsedText, eos);
+	int result;
+	{
+		ProfileSpan templateSpan("template", "input", toBuild.templatePath.str());
+		if(blankTemplate)
+			result = n_read_and_process_fast(1, fileStr, 0, toBuild.templatePath, antiDepsOfReadPath, parsedText, eos);
+		else
+			result = n_read_and_process_fast(1, *templateCache.get(toBuild.templatePath.str(), fileContents, *this), 0, toBuild.templatePath, antiDepsOfReadPath, parsedText, eos);
+	}
 
 	//pagination
 	size_t noItems = pagesInfo.items.size();
@@ -1180,16 +1175,6 @@ int Parser::build(const TrackedInfo& ToBuild,
 		pagesInfo.noPages = std::ceil((double)noItems/(double)pagesInfo.noItemsPerPage);
 		noPagesToBuild += pagesInfo.noPages;
 
-		//creates/updates pagination file
-		chmod(paginationPathStr.c_str(), 0666);
-		std::ofstream ofs(paginationPathStr);
-		ofs << "{\n";
-		ofs << "\t\"no-pages\": " << pagesInfo.noPages << "\n";
-		ofs << "}";
-		ofs.close();
-		//makes sure user can't accidentally write to pagination file
-		chmod(paginationPathStr.c_str(), 0444); 
-
 		//creates pages
 		size_t pos = parsedText.find("__paginate_here__");
 		if(pos == std::string::npos)
@@ -1200,42 +1185,96 @@ int Parser::build(const TrackedInfo& ToBuild,
 			os_mtx->unlock();
 			return 1;
 		}
-		parsedText.replace(pos, 17, "");
-		pagesInfo.splitFile = std::pair<std::string, std::string>(parsedText.substr(0, pos), parsedText.substr(pos, parsedText.size()-pos));
-		pagesInfo.indentAmount = "";
+		pagesInfo.indentAmount.clear();
 		for(int p=pos-1; p>=0 && parsedText[p] != '\n'; --p)
 		{
 			if(parsedText[p] == '\t')
-				pagesInfo.indentAmount += "\t";
+				pagesInfo.indentAmount += '\t';
 			else
-				pagesInfo.indentAmount += " ";
+				pagesInfo.indentAmount += ' ';
 		}
 
+		//pages are spliced in place of __paginate_here__ when written, parsed text isn't copied
+		pagesInfo.splitFile.swap(parsedText);
+		pagesInfo.splitStart = pos;
+		pagesInfo.splitEnd = pos + 17;
+		parsedText.clear();
+
 		//Directory outputDirBackup = outputDir;
 		Path outputPathBackup = toBuild.outputPath;
 
+		//pages are fingerprinted from their items along with everything else they're built from,
+		//pages with the same fingerprint, files read and output file as last build are left alone.
+		//pages whose items read anything else (see volatileRead) are always built
+		std::string context = std::to_string(pagesInfo.noPages) + " " + std::to_string(pagesInfo.noItemsPerPage) + "\n" +
+		                      outputPathBackup.str() + "\n" + pagesInfo.paginateName + "\n" + pagesInfo.indentAmount.str() + "\n" +
+		                      toBuild.name + "\n" + toBuild.title.str + "\n" + toBuild.contentPath.str() + "\n" + toBuild.templatePath.str() + "\n" +
+		                      toBuild.contentExt + " " + toBuild.outputExt + " " + toBuild.scriptExt + "\n" +
+		                      contentDir + " " + outputDir + " " + contentExt + " " + outputExt + " " + scriptExt + " " + defaultTemplate.str() + "\n" +
+		                      hex_digest(pagesInfo.splitFile) + hex_digest(pagesInfo.separator) + hex_digest(pagesInfo.templateStr);
+		std::string varsBefore = vars.fingerprint(), varsAfter, fingerprint;
+		std::set<Path> pageDeps;
+		Path pageOutputPath = outputPathBackup;
+		pagesInfo.states.assign(pagesInfo.noPages, PageState());
+		pagesInfo.skipped.assign(pagesInfo.noPages, 0);
+
 		std::string page;
-		int i=0, I, iStart;
+		RenderedItems ahead;
+		bool parallelTried = 0, pageVolatile;
 		for(size_t p=0; p<pagesInfo.noPages; ++p)
 		{
 			page = "";
 
-			iStart = i;
-			I = std::min(noItems, (p+1)*pagesInfo.noItemsPerPage);
-			for(; i<I; ++i)
+			fingerprint = page_fingerprint(context, varsBefore, p);
+			if(p)
+				pageOutputPath.file = pagesInfo.paginateName + std::to_string(p+1) + outputExt;
+			if(pagesInfo.unchanged(p, fingerprint, pageOutputPath))
 			{
-				if(i != iStart)
-				{
-					page += pagesInfo.separator;
-					toBuild.outputPath.file = pagesInfo.paginateName + std::to_string(p+1) + outputExt;
-				}
-				if(parse_replace('n', pagesInfo.items[i], "paginate item", pagesInfo.itemCallPaths[i], antiDepsOfReadPath, pagesInfo.itemLineNos[i], "item", pagesInfo.itemCallLineNos[i], eos))
+				skip_page(p);
+				estNoPagesFinished = estNoPagesFinished + 0.05;
+				continue;
+			}
+
+			//files read by the page's items are recorded with the page as well,
+			//pages rendered ahead of time from the same variables left them unchanged
+			if(p < ahead.rendered.size() && ahead.rendered[p] && varsBefore == ahead.varsBefore)
+			{
+				page.swap(ahead.pages[p]);
+				pageDeps.swap(ahead.deps[p]);
+				varsAfter = varsBefore;
+				pageVolatile = ahead.volatileReads[p];
+			}
+			else
+			{
+				pageDeps.swap(depFiles);
+				volatileRead = exprCache.volatileUsed = 0;
+				if(render_items(pagesInfo, p, page, antiDepsOfReadPath, eos))
 					return 1;
-				page += pagesInfo.items[i];
+				pageDeps.swap(depFiles);
+				varsAfter = vars.fingerprint();
+				pageVolatile = volatileRead || exprCache.volatileUsed;
 			}
+			pagesInfo.add_deps(p, pageDeps);
+			depFiles.insert(pageDeps.begin(), pageDeps.end());
+			pageDeps.clear();
+
+			//pages whose items change variables are always built, as later pages may rely on the changes
+			if(varsAfter == varsBefore && !pageVolatile)
+				pagesInfo.states[p].fingerprint = fingerprint;
+			else
+				varsBefore.swap(varsAfter);
 
 			pagesInfo.pages.push_back(page);
 			estNoPagesFinished = estNoPagesFinished + 0.05;
+
+			//the remaining pages are rendered ahead of time in parallel once a page's items leave variables
+			//unchanged, the first items rendered often change them (eg. the first function call defines params.at)
+			if(!parallelTried && varsAfter == varsBefore)
+			{
+				parallelTried = 1;
+				if(p+1 < pagesInfo.noPages && items_parallelisable())
+					render_items_in_parallel(p+1, context, varsBefore, outputPathBackup, antiDepsOfReadPath, ahead);
+			}
 		}
 		pagesInfo.items.clear();
 
@@ -1270,17 +1309,7 @@ int Parser::build(const TrackedInfo& ToBuild,
 		}
 	}
 
-	vars = Variables();
-
-	//deconstructs lua (if initialised) (has low initialise time, high deconstruct/reset time)
-	lua.~Lua();
-
-	//symbol_table.clear_functions();
-	symbol_table.clear_local_constants();
-	symbol_table.clear_strings();
-	symbol_table.clear_variables();
-	symbol_table.clear_vectors();
-	symbol_table.add_stringvar("parsedText", parsedText);
+	clear_page_state();
 
 	if(consoleLocked)
 	{
@@ -1310,186 +1339,526 @@ int Parser::build(const TrackedInfo& ToBuild,
 
 		if(!noItems)
 		{
-			//makes sure directory for output file exists
-			toBuild.outputPath.ensureDirExists();
-
-			//makes sure we can write to output file
-			chmod(toBuild.outputPath.str().c_str(), 0644);
-
-			//writes processed text to output file
-			std::ofstream outputFile(toBuild.outputPath.str());
-			outputFile << parsedText << "\n";
-			outputFile.close();
-
-			//makes sure user can't accidentally write to output file
-			chmod(toBuild.outputPath.str().c_str(), 0444);
+			//writes processed text to output file, unless it's unchanged
+			if(outputWriter.write(toBuild.outputPath, parsedText, "\n"))
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err(eos) << "failed to write output file " << toBuild.outputPath << std::endl;
+				os_mtx->unlock();
+				return 1;
+			}
 		}
 
 		//checks for post-build scripts
-		if(file_exists("post-build" + scriptExt))
+		if(postbuildExists == -1)
+			postbuildExists = file_exists("post-build" + scriptExt);
+		if(postbuildExists)
 		{
 			Path dep("", "post-build" + scriptExt);
-			if(incrMode != INCR_MOD)
-			{
-				checked_hash_mtx.lock();
-				if(!checkedHashFile.count(dep))
-				{
-					checkedHashFile.insert(dep);
-					checked_hash_mtx.unlock();
-					Path hashPath = dep.getHashPath();
-					std::string hashPathStr = hashPath.str();
-					unsigned int hash = FNVHash(string_from_file(dep.str()));
-					if(!file_exists(hashPathStr) || 
-					   (unsigned) std::atoi(string_from_file(hashPathStr).c_str()) != hash)
-					{
-						hashPath.ensureDirExists();
-						std::ofstream ofs(hashPathStr);
-						ofs << hash << "\n";
-						ofs.close();
-					}
-				}
-				else
-					checked_hash_mtx.unlock();
-			}
+			record_dep_hash(dep);
 			depFiles.insert(dep);
 		}
 		Path postbuildScript = toBuild.contentPath;
 		postbuildScript.file = postbuildScript.file.substr(0, postbuildScript.file.find_last_of('.')) + "-post-build" + cScriptExt;
 		if(file_exists(postbuildScript.str()))
 		{
-			if(incrMode != INCR_MOD)
-			{
-				checked_hash_mtx.lock();
-				if(!checkedHashFile.count(postbuildScript))
-				{
-					checkedHashFile.insert(postbuildScript);
-					checked_hash_mtx.unlock();
-					Path hashPath = postbuildScript.getHashPath();
-					std::string hashPathStr = hashPath.str();
-					unsigned int hash = FNVHash(string_from_file(postbuildScript.str()));
-					if(!file_exists(hashPathStr) || 
-					   (unsigned) std::atoi(string_from_file(hashPathStr).c_str()) != hash)
-					{
-						hashPath.ensureDirExists();
-						std::ofstream ofs(hashPathStr);
-						ofs << hash << "\n";
-						ofs.close();
-					}
-				}
-				else
-					checked_hash_mtx.unlock();
-			}
+			record_dep_hash(postbuildScript);
 			depFiles.insert(postbuildScript);
+			if(run_script(eos, postbuildScript, 0))
+				return 1; //should an output file be listed as failing to build if the post-build script fails?
 		}
-		if(run_script(eos, postbuildScript, backupScripts, 0))
-			return 1; //should an output file be listed as failing to build if the post-build script fails?
 
-		//gets path for storing info file
-		Path infoPath = toBuild.outputPath.getInfoPath();
+		if(buildState.enabled)
+			buildState.set_page(toBuild, depFiles);
+		else
+		{
+			std::vector<std::string> deps;
+			for(auto depFile=depFiles.begin(); depFile != depFiles.end(); depFile++)
+				deps.push_back(depFile->str());
+
+			//writes info file
+			//what if files are modified mid-build? at worst files will be rebuilt next build, but could be annoying for larger projects
+			write_info_file(toBuild.outputPath.getInfoPath(),
+			                dateTimeInfo.currentTime() + " " + dateTimeInfo.currentDate(),
+			                toBuild.name,
+			                unquote(toBuild.title.str),
+			                toBuild.templatePath.str(),
+			                deps);
+		}
+	}
 
-		//makes sure info file exists
-		infoPath.ensureDirExists();
+	return result;
+}
 
-		//makes sure we can write to info file_
-		chmod(infoPath.str().c_str(), 0644);
+//resets variables, lua and exprtk symbols ready for the next page
+void Parser::clear_page_state()
+{
+	vars = Variables();
 
-		//writes info file
-		std::ofstream infoStream(infoPath.str());
-		infoStream << "{\n";
-		infoStream << "\t\"last-built\": \"" << dateTimeInfo.currentTime() << " " << dateTimeInfo.currentDate() << "\",\n";
-		//what if files are modified mid-build? at worst files will be rebuilt next build, but could be annoying for larger projects
-		//infoStream << "\t\"last-built\": \"" << dateTimeInfo.cTime << " " << dateTimeInfo.cDate << "\"\n";
+	//resets lua (if initialised) for the next page, closing/reopening the state is much slower
+	lua.new_page();
 
-		infoStream << "\t\"name\": \"" <<  toBuild.name << "\",\n";
-		infoStream << "\t\"title\": \"" <<  unquote(toBuild.title.str) << "\",\n";
-		infoStream << "\t\"template\": \"" <<  toBuild.templatePath.str() << "\",\n";
+	//symbol_table.clear_functions();
+	symbol_table.clear_local_constants();
+	symbol_table.clear_strings();
+	symbol_table.clear_variables();
+	symbol_table.clear_vectors();
+	exprCache.symbols_removed();
+	exprCache.add_stringvar("parsedText", parsedText);
+}
 
-		infoStream << "\t\"dependencies\": [\n"; 
-		for(auto depFile=depFiles.begin(); depFile != depFiles.end(); depFile++)
-			infoStream << "\t\t\"" << depFile->str() << "\",\n";
-		infoStream.flush();
-		size_t pos = infoStream.tellp();
-		#if defined _WIN32 || defined _WIN64
-			infoStream.seekp(pos-3);
-		#else  //*nix
-			infoStream.seekp(pos-2);
-		#endif
-		infoStream << "\n\t]\n";
-		infoStream << "}";
-		infoStream.close();
+/*
+	exprtk symbols refer to the storage of the variables they were added for,
+	so each of the page's symbols is added to the clone for the clone's copy
+	of the same variable. returns 1 if the page has a symbol that isn't for
+	one of its variables, parsed text or the default constants. the clone
+	may be NULL to only check.
+*/
+static int copy_symbols(const Parser& page, Parser* clone)
+{
+	std::vector<std::string> names;
+	int layer;
 
-		//makes sure user can't accidentally write to info file
-		chmod(infoPath.str().c_str(), 0444);
+	page.symbol_table.get_variable_list(names);
+	for(size_t n=0; n<names.size(); ++n)
+	{
+		const double& value = page.symbol_table.get_variable(names[n])->ref();
+		layer = -1;
+		for(size_t l=0; l<page.vars.layers.size() && layer < 0; ++l)
+		{
+			if(page.vars.layers[l].doubles.get(names[n]) == &value)
+				layer = l;
+		}
+		if(layer >= 0)
+		{
+			if(clone)
+				clone->exprCache.add_variable(names[n], clone->vars.layers[layer].doubles[names[n]]);
+		}
+		else if(names[n] == "console" || names[n] == "endl" || names[n] == "ofile")
+		{
+			if(clone)
+				clone->symbol_table.add_constant(names[n], value);
+		}
+		else
+			return 1;
 	}
 
-	return result;
+	names.clear();
+	page.symbol_table.get_stringvar_list(names);
+	for(size_t n=0; n<names.size(); ++n)
+	{
+		const std::string& str = page.symbol_table.get_stringvar(names[n])->ref();
+		layer = -1;
+		for(size_t l=0; l<page.vars.layers.size() && layer < 0; ++l)
+		{
+			if(page.vars.layers[l].strings.get(names[n]) == &str)
+				layer = l;
+		}
+		if(&str == &page.parsedText)
+		{
+			if(clone)
+				clone->exprCache.add_stringvar(names[n], clone->parsedText);
+		}
+		else if(layer >= 0)
+		{
+			if(clone)
+				clone->exprCache.add_stringvar(names[n], clone->vars.layers[layer].strings[names[n]]);
+		}
+		else
+			return 1;
+	}
+
+	names.clear();
+	page.symbol_table.get_vector_list(names);
+	for(size_t n=0; n<names.size(); ++n)
+	{
+		const double* data = page.symbol_table.get_vector(names[n])->data();
+		layer = -1;
+		for(size_t l=0; l<page.vars.layers.size() && layer < 0; ++l)
+		{
+			const std::vector<double>* found = page.vars.layers[l].doubVecs.get(names[n]);
+			if(found && found->size() && &(*found)[0] == data)
+				layer = l;
+		}
+		if(layer < 0)
+			return 1;
+		if(clone)
+			clone->exprCache.add_vector(names[n], clone->vars.layers[layer].doubVecs[names[n]]);
+	}
+
+	if(clone)
+		clone->exprCache.symbols_added();
+
+	return 0;
 }
 
-int Parser::n_read_and_process(const bool& indent,
-                                  const std::string& inStr,
-                                  int lineNo,
-                                  const Path& readPath,
-                                  std::set<Path> antiDepsOfReadPath,
-                                  std::string& outStr,
-                                  std::ostream& eos)
+//seeds a clone with the state of the page whose pagination items it renders
+void Parser::copy_page_state(const Parser& page)
 {
-	//adds read path to anti dependencies of read path
-	if(file_exists(readPath.str()))
-		antiDepsOfReadPath.insert(readPath);
-
-	return n_read_and_process_fast(indent, 1, inStr, lineNo, readPath, antiDepsOfReadPath, outStr, eos);
+	clear_page_state();
+	exprCache.remove_stringvar("parsedText");
+	vars.copy_from(page.vars);
+	copy_symbols(page, this);
+
+	toBuild = page.toBuild;
+	dateTimeInfo = page.dateTimeInfo;
+	mode = page.mode;
+	promptChar = page.promptChar;
+	exprtkParams = page.exprtkParams;
+	codeBlockDepth = page.codeBlockDepth;
+	htmlCommentDepth = page.htmlCommentDepth;
+	indentAmount = page.indentAmount;
+	addMemberFnsGlobal = page.addMemberFnsGlobal;
+	addScopeGlobal = page.addScopeGlobal;
+	replaceVarsGlobal = page.replaceVarsGlobal;
+	contentAdded = page.contentAdded;
+	lolcatActive = page.lolcatActive;
+	lolcatInit = page.lolcatInit;
+	lolcatCmd = page.lolcatCmd;
+	includedFiles = page.includedFiles;
+	depFiles.clear();
 }
 
-int Parser::n_read_and_process_fast(const bool& indent,
-                                  const std::string& inStr,
-                                  int lineNo,
-                                  const Path& readPath,
-                                  std::set<Path>& antiDepsOfReadPath,
-                                  std::string& outStr,
-                                  std::ostream& eos)
+//whether the page's pagination items can be rendered on clones of this parser
+bool Parser::items_parallelisable() const
 {
-	return n_read_and_process_fast(indent, 1, inStr, lineNo, readPath, antiDepsOfReadPath, outStr, eos);
+	if(threadPool.threads.size() < 2 || pagesInfo.items.size() < 2*PAGINATE_ITEMS_PER_TASK)
+		return 0;
+	if(consoleLocked || lua.pageInitialised || vars.has_streams())
+		return 0;
+
+	if(copy_symbols(*this, NULL))
+		return 0;
+
+	return 1;
 }
 
-int Parser::n_read_and_process_fast(const bool& indent,
-                                  const bool& addOutput,
-                                  const std::string& inStr,
-                                  int lineNo,
-                                  const Path& readPath,
-                                  std::set<Path>& antiDepsOfReadPath,
-                                  std::string& outStr,
-                                  std::ostream& eos)
+std::string Parser::page_fingerprint(const std::string& context, const std::string& varsBefore, const size_t& p) const
 {
-	std::string baseIndentAmount = indentAmount;
-	std::string beforePreBaseIndentAmount;
-	if(!indent) // not sure if this is needed?
-		baseIndentAmount = "";
-	int baseCodeBlockDepth = codeBlockDepth;
+	size_t iStart = p*pagesInfo.noItemsPerPage,
+	       I = std::min(pagesInfo.items.size(), (p+1)*pagesInfo.noItemsPerPage);
 
-	int openCodeLineNo = 0;
-	bool firstLine = 1, lastLine = 0;
-	size_t linePos = 0;
-	while(linePos < inStr.size())
-	{
-		lineNo++;
-		if(!firstLine) //should be end-of-line character
-			linePos++;
+	std::string fingerprint = context + "\n" + varsBefore + " " + std::to_string(p);
+	for(size_t i=iStart; i<I; ++i)
+		fingerprint += "\n" + pagesInfo.itemCallPaths[i].str() + ":" + std::to_string(pagesInfo.itemCallLineNos[i]) + ":" + std::to_string(pagesInfo.itemLineNos[i]) + " " + hex_digest(pagesInfo.items[i]);
 
-		if(linePos >= inStr.size())
-			break;
+	return hex_digest(fingerprint);
+}
 
-		if(indent && addOutput && lineNo > 1 && !firstLine && !lastLine) //could check !is.eof() rather than last line (trying to be clear)
-		{
-			indentAmount = baseIndentAmount;
+//keeps the state of an unchanged page from the previous build
+void Parser::skip_page(const size_t& p)
+{
+	pagesInfo.skipped[p] = 1;
+	pagesInfo.states[p] = pagesInfo.oldStates[p];
+	for(size_t d=0; d<pagesInfo.states[p].deps.size(); ++d)
+	{
+		Path dep;
+		dep.set_file_path_from(pagesInfo.states[p].deps[d].first);
+		record_dep_hash(dep);
+		depFiles.insert(dep);
+	}
+
+	pagesInfo.pages.push_back("");
+}
+
+//renders the items of pagination page p, info may belong to the parser being cloned
+int Parser::render_items(const Pagination& info,
+                         const size_t& p,
+                         std::string& page,
+                         std::set<Path>& antiDepsOfReadPath,
+                         std::ostream& eos)
+{
+	size_t iStart = p*info.noItemsPerPage,
+	       I = std::min(info.items.size(), (p+1)*info.noItemsPerPage);
+
+	//the first item of a page sees the output path left by the previous page's items
+	if(p && info.noItemsPerPage > 1)
+		toBuild.outputPath.file = info.paginateName + std::to_string(p) + outputExt;
+
+	std::string item;
+	for(size_t i=iStart; i<I; ++i)
+	{
+		if(i != iStart)
+		{
+			page += info.separator;
+			toBuild.outputPath.file = info.paginateName + std::to_string(p+1) + outputExt;
+		}
+		item = info.items[i];
+		if(parse_replace('n', item, "paginate item", info.itemCallPaths[i], antiDepsOfReadPath, info.itemLineNos[i], "item", info.itemCallLineNos[i], eos))
+			return 1;
+		page += item;
+	}
+
+	return 0;
+}
+
+//pages of pagination items rendered on a clone
+struct ItemPages
+{
+	Parser* parser;
+	std::vector<size_t> pageNos;
+
+	ItemPages()
+	{
+		parser = NULL;
+	}
+};
+
+static void item_pages_task(ItemPages& task,
+                            const Parser& page,
+                            const std::set<Path>& antiDepsOfPage,
+                            RenderedItems& ahead)
+{
+	Parser& parser = *task.parser;
+	parser.copy_page_state(page);
+
+	std::set<Path> antiDepsOfReadPath;
+	std::ostringstream oss;
+	size_t p;
+	for(size_t n=0; n<task.pageNos.size(); ++n)
+	{
+		p = task.pageNos[n];
+		antiDepsOfReadPath = antiDepsOfPage;
+		oss.str("");
+		parser.depFiles.clear();
+		parser.volatileRead = parser.exprCache.volatileUsed = 0;
+		if(parser.render_items(page.pagesInfo, p, ahead.pages[p], antiDepsOfReadPath, oss) ||
+		   parser.vars.fingerprint() != ahead.varsBefore)
+			break;
+
+		//pages whose items print messages are left to be rendered sequentially, so they're printed as normal
+		if(oss.str().size())
+		{
+			ahead.pages[p].clear();
+			continue;
+		}
+
+		ahead.deps[p].swap(parser.depFiles);
+		ahead.volatileReads[p] = parser.volatileRead || parser.exprCache.volatileUsed;
+		ahead.rendered[p] = 1;
+	}
+}
+
+/*
+	renders pages of pagination items from firstPage on ahead of time, on
+	clones which each take a contiguous run of pages and are seeded with
+	the variables as they are before firstPage. each clone stops at the
+	first page which fails or changes variables, as the pages after it
+	would see different variables sequentially.
+*/
+void Parser::render_items_in_parallel(const size_t& firstPage,
+                                      const std::string& context,
+                                      const std::string& varsBefore,
+                                      const Path& outputPathBackup,
+                                      const std::set<Path>& antiDepsOfReadPath,
+                                      RenderedItems& ahead)
+{
+	size_t noItems = pagesInfo.items.size();
+	std::vector<size_t> toRender, itemsBefore;
+	Path pageOutputPath = outputPathBackup;
+	size_t noRenderItems = 0;
+	for(size_t p=firstPage; p<pagesInfo.noPages; ++p)
+	{
+		if(p)
+			pageOutputPath.file = pagesInfo.paginateName + std::to_string(p+1) + outputExt;
+		if(pagesInfo.unchanged(p, page_fingerprint(context, varsBefore, p), pageOutputPath))
+			continue;
+
+		toRender.push_back(p);
+		itemsBefore.push_back(noRenderItems);
+		noRenderItems += std::min(noItems, (p+1)*pagesInfo.noItemsPerPage) - p*pagesInfo.noItemsPerPage;
+	}
+
+	size_t noTasks = std::min(threadPool.threads.size(), noRenderItems/PAGINATE_ITEMS_PER_TASK);
+	if(noTasks < 2)
+		return;
+
+	std::vector<ItemPages> tasks(noTasks);
+	for(size_t r=0; r<toRender.size(); ++r)
+		tasks[itemsBefore[r]*noTasks/noRenderItems].pageNos.push_back(toRender[r]);
+
+	while(itemParsers.size() < noTasks)
+	{
+		itemParsers.push_back(std::unique_ptr<Parser>(new Parser(trackedAll,
+		                                                         os_mtx,
+		                                                         contentDir,
+		                                                         outputDir,
+		                                                         contentExt,
+		                                                         outputExt,
+		                                                         scriptExt,
+		                                                         defaultTemplate,
+		                                                         backupScripts,
+		                                                         unixTextEditor,
+		                                                         winTextEditor)));
+		itemParsers.back()->make_item_clone();
+	}
+
+	ahead.varsBefore = varsBefore;
+	ahead.rendered.assign(pagesInfo.noPages, 0);
+	ahead.pages.assign(pagesInfo.noPages, "");
+	ahead.deps.assign(pagesInfo.noPages, std::set<Path>());
+	ahead.volatileReads.assign(pagesInfo.noPages, 0);
+
+	TaskGroup itemGroup;
+	for(size_t t=0; t<noTasks; ++t)
+	{
+		if(!tasks[t].pageNos.size())
+			continue;
+
+		tasks[t].parser = itemParsers[t].get();
+		threadPool.submit(std::bind(item_pages_task,
+		                            std::ref(tasks[t]),
+		                            std::cref(*this),
+		                            std::cref(antiDepsOfReadPath),
+		                            std::ref(ahead)),
+		                  &itemGroup);
+	}
+	threadPool.wait(itemGroup);
+}
+
+int Parser::n_read_and_process(const bool& indent,
+                                  const std::string& inStr,
+                                  int lineNo,
+                                  const Path& readPath,
+                                  std::set<Path> antiDepsOfReadPath,
+                                  std::string& outStr,
+                                  std::ostream& eos)
+{
+	//adds read path to anti dependencies of read path
+	if(file_exists(readPath.str()))
+		antiDepsOfReadPath.insert(readPath);
+
+	return n_read_and_process_fast(indent, 1, inStr, lineNo, readPath, antiDepsOfReadPath, outStr, eos);
+}
+
+int Parser::n_read_and_process_fast(const bool& indent,
+                                  const std::string& inStr,
+                                  int lineNo,
+                                  const Path& readPath,
+                                  std::set<Path>& antiDepsOfReadPath,
+                                  std::string& outStr,
+                                  std::ostream& eos)
+{
+	return n_read_and_process_fast(indent, 1, inStr, lineNo, readPath, antiDepsOfReadPath, outStr, eos);
+}
+
+int Parser::n_read_and_process(const bool& indent,
+                                  const SegmentedText& segmented,
+                                  int lineNo,
+                                  const Path& readPath,
+                                  std::set<Path> antiDepsOfReadPath,
+                                  std::string& outStr,
+                                  std::ostream& eos)
+{
+	//adds read path to anti dependencies of read path
+	if(file_exists(readPath.str()))
+		antiDepsOfReadPath.insert(readPath);
+
+	return n_read_and_process_fast(indent, 1, segmented.text, &segmented, lineNo, readPath, antiDepsOfReadPath, outStr, eos);
+}
+
+int Parser::n_read_and_process_fast(const bool& indent,
+                                  const SegmentedText& segmented,
+                                  int lineNo,
+                                  const Path& readPath,
+                                  std::set<Path>& antiDepsOfReadPath,
+                                  std::string& outStr,
+                                  std::ostream& eos)
+{
+	return n_read_and_process_fast(indent, 1, segmented.text, &segmented, lineNo, readPath, antiDepsOfReadPath, outStr, eos);
+}
+
+int Parser::n_read_and_process_fast(const bool& indent,
+                                  const bool& addOutput,
+                                  const std::string& inStr,
+                                  int lineNo,
+                                  const Path& readPath,
+                                  std::set<Path>& antiDepsOfReadPath,
+                                  std::string& outStr,
+                                  std::ostream& eos)
+{
+	return n_read_and_process_fast(indent, addOutput, inStr, NULL, lineNo, readPath, antiDepsOfReadPath, outStr, eos);
+}
+
+//segmented is either NULL or inStr split in to literal runs and raw comments
+int Parser::n_read_and_process_fast(const bool& indent,
+                                  const bool& addOutput,
+                                  const std::string& inStr,
+                                  const SegmentedText* segmented,
+                                  int lineNo,
+                                  const Path& readPath,
+                                  std::set<Path>& antiDepsOfReadPath,
+                                  std::string& outStr,
+                                  std::ostream& eos)
+{
+	Indent baseIndentAmount = indentAmount;
+	Indent beforePreBaseIndentAmount;
+	if(!indent) // not sure if this is needed?
+		baseIndentAmount.clear();
+	int baseCodeBlockDepth = codeBlockDepth;
+
+	int openCodeLineNo = 0;
+	bool firstLine = 1, lastLine = 0;
+	size_t linePos = 0, seg = 0;
+	const Segment* segment;
+	const CallToken* token;
+	while(linePos < inStr.size())
+	{
+		lineNo++;
+		if(!firstLine) //should be end-of-line character
+			linePos++;
+
+		if(linePos >= inStr.size())
+			break;
+
+		if(indent && addOutput && lineNo > 1 && !firstLine && !lastLine) //could check !is.eof() rather than last line (trying to be clear)
+		{
+			indentAmount = baseIndentAmount;
 			/*if(codeBlockDepth)
 				outStr += "\n";
 			else*/
-			outStr += "\n" + baseIndentAmount;
+			add_newline(outStr, baseIndentAmount);
 		}
 		firstLine = 0;
 
 		for(; linePos < inStr.size() && inStr[linePos] != '\n';)
 		{
+			//literal runs and raw comments found when splitting are dealt with in one go,
+			//calls found are handed to read_and_process_fn already read
+			token = NULL;
+			if(segmented && (segment = segment_at(*segmented, seg, linePos)))
+			{
+				if(segment->type == SEG_LITERAL)
+				{
+					if(addOutput)
+					{
+						if(indent)
+							indentAmount.add_text(inStr, linePos, segment->end - linePos);
+						outStr.append(inStr, linePos, segment->end - linePos);
+					}
+					linePos = segment->end;
+					continue;
+				}
+				else if(segment->type == SEG_CALL)
+				{
+					if(segment->start == linePos)
+						token = &segmented->calls[segment->call];
+				}
+				else if(segment->start == linePos)
+				{
+					lineNo += segment->noLines;
+					linePos = segment->end;
+
+					if(linePos < inStr.size() && inStr[linePos] == '!')
+						++linePos;
+					else
+						skip_whitespace(0, inStr, lineNo, linePos, readPath, "<#--..--#>", eos);
+
+					continue;
+				}
+			}
+
 			if(inStr[linePos] == '\\') //checks whether to escape
 			{
 				linePos++;
@@ -1498,27 +1867,27 @@ int Parser::n_read_and_process_fast(const bool& indent,
 					outStr += "@";
 					linePos++;
 					if(indent)
-						indentAmount += " ";
+						indentAmount += ' ';
 				}
 				else if(inStr[linePos] == '#')
 				{
 					outStr += "#";
 					linePos++;
 					//if(indent)
-					indentAmount += " ";
+					indentAmount += ' ';
 				}
 				else if(inStr[linePos] == '$')
 				{
 					outStr += "$";
 					linePos++;
 					//if(indent)
-					indentAmount += " ";
+					indentAmount += ' ';
 				}
 				else
 				{
 					outStr += "\\";
 					if(indent)
-						indentAmount += " ";
+						indentAmount += ' ';
 				}
 
 				continue;
@@ -1574,13 +1943,13 @@ int Parser::n_read_and_process_fast(const bool& indent,
 				{
 					outStr += "&lt;";
 					if(indent)
-						indentAmount += into_whitespace("&lt;");
+						indentAmount.add_text("&lt;");
 				}
 				else if(addOutput)
 				{
 					outStr += '<';
 					if(indent)
-						indentAmount += " ";
+						indentAmount += ' ';
 				}
 
 				if(!finished)
@@ -1591,7 +1960,7 @@ int Parser::n_read_and_process_fast(const bool& indent,
 						if(codeBlockDepth == 0)
 						{
 							beforePreBaseIndentAmount = baseIndentAmount;
-							baseIndentAmount = "";
+							baseIndentAmount.clear();
 						}
 						if(codeBlockDepth == baseCodeBlockDepth)
 							openCodeLineNo = lineNo;
@@ -1624,7 +1993,7 @@ int Parser::n_read_and_process_fast(const bool& indent,
 				{
 					outStr += '-';
 					if(indent)
-						indentAmount += " ";
+						indentAmount += ' ';
 				}
 				linePos++;
 			}
@@ -1633,7 +2002,7 @@ int Parser::n_read_and_process_fast(const bool& indent,
 				try
 				{
 					linePos++;
-					int ret_val = read_and_process_fn(indent, baseIndentAmount, 'n', addOutput, inStr, lineNo, linePos, readPath, antiDepsOfReadPath, outStr, eos);
+					int ret_val = read_and_process_fn(indent, baseIndentAmount, 'n', addOutput, inStr, segmented, token, lineNo, linePos, readPath, antiDepsOfReadPath, outStr, eos);
 
 					//skips over 'end of statement' semicolons
 					while(linePos < inStr.size() && inStr[linePos] == ';')
@@ -1655,7 +2024,7 @@ int Parser::n_read_and_process_fast(const bool& indent,
 			}
 			else if(inStr[linePos] == '$' && (inStr[linePos+1] == '{' || inStr[linePos+1] == '[' || inStr[linePos+1] == '`'))
 			{
-				int ret_val = read_and_process_fn(indent, baseIndentAmount, 'n', addOutput, inStr, lineNo, linePos, readPath, antiDepsOfReadPath, outStr, eos);
+				int ret_val = read_and_process_fn(indent, baseIndentAmount, 'n', addOutput, inStr, segmented, token, lineNo, linePos, readPath, antiDepsOfReadPath, outStr, eos);
 
 				if(ret_val == NSM_CONT)
 					return 0;
@@ -1675,24 +2044,22 @@ int Parser::n_read_and_process_fast(const bool& indent,
 						/*if(codeBlockDepth) //do we want this? //baseIndentAmount updated at start of code block
 							outStr += "\n";
 						else*/
-						outStr += "\n" + baseIndentAmount;
+						add_newline(outStr, baseIndentAmount);
 					}
 				}
 				else
 				{
+					//outputs the run of regular characters in one go
+					size_t endPos = find_special(inStr, linePos+1);
+
 					if(addOutput)
 					{
 						if(indent)
-						{
-							if(inStr[linePos] == '\t')
-								indentAmount += '\t';
-							else
-								indentAmount += ' ';
-						}
+							indentAmount.add_text(inStr, linePos, endPos - linePos);
 
-						outStr += inStr[linePos];
+						outStr.append(inStr, linePos, endPos - linePos);
 					}
-					++linePos;
+					linePos = endPos;
 				}
 			}
 		}
@@ -1733,7 +2100,7 @@ int Parser::f_read_and_process_fast(const bool& addOutput,
                                   std::string& outStr,
                                   std::ostream& eos)
 {
-	std::string baseIndentAmount = indentAmount;
+	Indent baseIndentAmount = indentAmount;
 	size_t linePos = 0;
 	++lineNo;
 	while(linePos < inStr.size())
@@ -1759,11 +2126,11 @@ int Parser::f_read_and_process_fast(const bool& addOutput,
 			{
 				outStr += inStr[linePos];
 				/*if(inStr[linePos] == '\n')
-					indentAmount = "";
+					indentAmount.clear();
 				else if(inStr[linePos] == '\t')
-					indentAmount += "\t";
+					indentAmount += '\t';
 				else
-					indentAmount += " ";*/
+					indentAmount += ' ';*/
 			}
 			++linePos;
 
@@ -1777,41 +2144,41 @@ int Parser::f_read_and_process_fast(const bool& addOutput,
 				outStr += "@";
 				linePos++;
 				//if(indent)
-				indentAmount += " ";
+				indentAmount += ' ';
 			}
 			else if(inStr[linePos] == '#')
 			{
 				outStr += "#";
 				linePos++;
 				//if(indent)
-				indentAmount += " ";
+				indentAmount += ' ';
 			}
 			else if(inStr[linePos] == '$')
 			{
 				outStr += "$";
 				linePos++;
 				//if(indent)
-				indentAmount += " ";
+				indentAmount += ' ';
 			}
 			else if(inStr[linePos] == '`')
 			{
 				outStr += "`";
 				linePos++;
 				//if(indent)
-				indentAmount += " ";
+				indentAmount += ' ';
 			}
 			else if(inStr[linePos] == '(')
 			{
 				outStr += "(";
 				linePos++;
 				//if(indent)
-				indentAmount += " ";
+				indentAmount += ' ';
 			}
 			else
 			{
 				outStr += "\\";
 				//if(indent)
-				indentAmount += " ";
+				indentAmount += ' ';
 			}
 
 			continue;
@@ -1865,7 +2232,7 @@ int Parser::f_read_and_process_fast(const bool& addOutput,
 				if(addOutput)
 				{
 					outStr += inStr[linePos];
-					indentAmount += " ";
+					indentAmount += ' ';
 				}
 				++linePos;
 			}while(isdigit(inStr[linePos]));
@@ -1876,7 +2243,7 @@ int Parser::f_read_and_process_fast(const bool& addOutput,
 		//int ret_val = read_and_process_fn(0, "", 'f', 1, inStr, lineNo, linePos, readPath, antiDepsOfReadPath, outStr, eos);
 		try
 		{
-			int ret_val = read_and_process_fn(0, "", 'f', addOutput, inStr, lineNo, linePos, readPath, antiDepsOfReadPath, outStr, eos);
+			int ret_val = read_and_process_fn(0, "", 'f', addOutput, inStr, NULL, NULL, lineNo, linePos, readPath, antiDepsOfReadPath, outStr, eos);
 
 			//skips over 'end of statement' semicolons
 			while(linePos < inStr.size() && inStr[linePos] == ';')
@@ -1900,11 +2267,14 @@ int Parser::f_read_and_process_fast(const bool& addOutput,
 	return 0;
 }
 
+//token is the call at linePos read ahead of time, or NULL to read it here
 int Parser::read_and_process_fn(const bool& indent,
-                                const std::string& baseIndentAmount,
+                                const Indent& baseIndentAmount,
                                 const char& lang,
                                 const bool& addOutput,
                                 const std::string& inStr,
+                                const SegmentedText* segmented,
+                                const CallToken* token,
                                 int& lineNo,
                                 size_t& linePos,
                                 const Path& readPath,
@@ -1971,7 +2341,7 @@ int Parser::read_and_process_fn(const bool& indent,
 				if(!consoleLocked)
 					os_mtx->lock();
 				start_err(eos, readPath, sLineNo) << c_green << "$``" << c_white << ": exprtk: failed to compile expression" << std::endl;
-				print_exprtk_parser_errs(eos, expr.parser, expr_str, readPath, sLineNo);
+				print_exprtk_parser_errs(eos, expr.errors(), expr_str, readPath, sLineNo);
 				os_mtx->unlock();
 				return 1;
 			}
@@ -1979,7 +2349,7 @@ int Parser::read_and_process_fn(const bool& indent,
 
 			outStr += value;
 			if(indent)
-				indentAmount += into_whitespace(value);
+				indentAmount.add_text(value);
 
 			return 0;
 		}
@@ -2020,8 +2390,8 @@ int Parser::read_and_process_fn(const bool& indent,
 				//parses comment stringstream
 				if(lang == 'n')
 				{
-					std::string oldIndent = indentAmount;
-					indentAmount = "";
+					Indent oldIndent = indentAmount;
+					indentAmount.clear();
 
 					if(n_read_and_process_fast(0, 0, commentStr, openLine-1, readPath, antiDepsOfReadPath, commentOutput, eos))
 					{
@@ -2062,7 +2432,7 @@ int Parser::read_and_process_fn(const bool& indent,
 				linePos += 2;
 				outStr += "\\";
 				if(indent)
-					indentAmount += " ";
+					indentAmount += ' ';
 
 				return 0;
 			}
@@ -2071,7 +2441,7 @@ int Parser::read_and_process_fn(const bool& indent,
 				linePos += 2;
 				outStr += "\t";
 				if(indent)
-					indentAmount += "\t";
+					indentAmount += '\t';
 
 				return 0;
 			}
@@ -2082,7 +2452,7 @@ int Parser::read_and_process_fn(const bool& indent,
 				/*if(codeBlockDepth) //do we need this? //baseIndentAmount updated at start of code block
 					outStr += "\n";
 				else*/
-				outStr += "\n" + baseIndentAmount;
+				add_newline(outStr, baseIndentAmount);
 
 				return 0;
 			}
@@ -2091,7 +2461,7 @@ int Parser::read_and_process_fn(const bool& indent,
 				linePos += 2;
 				outStr += "&lt;";
 				if(indent)
-					indentAmount += into_whitespace("&lt;");
+					indentAmount.add_text("&lt;");
 
 				return 0;
 			}
@@ -2100,7 +2470,7 @@ int Parser::read_and_process_fn(const bool& indent,
 				linePos += 2;
 				outStr += "&commat;";
 				if(indent)
-					indentAmount += into_whitespace("&commat;");
+					indentAmount.add_text("&commat;");
 
 				return 0;
 			}
@@ -2116,7 +2486,7 @@ int Parser::read_and_process_fn(const bool& indent,
 				{
 					outStr += "\\";
 						if(indent)
-							indentAmount += " ";
+							indentAmount += ' ';
 				}
 
 				++linePos;
@@ -2195,8 +2565,8 @@ int Parser::read_and_process_fn(const bool& indent,
 
 				if(lang == 'n')
 				{
-					std::string oldIndent = indentAmount;
-					indentAmount = "";
+					Indent oldIndent = indentAmount;
+					indentAmount.clear();
 
 					if(n_read_and_process_fast(0, 0, restOfLine, lineNo-1, readPath, antiDepsOfReadPath, commentOutput, eos))
 					{
@@ -2274,7 +2644,7 @@ int Parser::read_and_process_fn(const bool& indent,
 			{
 				outStr += toBuild.title.str;
 				if(indent)
-					indentAmount += into_whitespace(toBuild.title.str);
+					indentAmount.add_text(toBuild.title.str);
 				linePos += std::string("pagetitle").length();
 
 				if(!consoleLocked)
@@ -2331,22 +2701,44 @@ int Parser::read_and_process_fn(const bool& indent,
 
 	//reads function name
 	parseFnName = 0;
-	if(read_func_name(funcName, parseFnName, linePos, inStr, readPath, lineNo, eos))
+	if(token)
+	{
+		funcName = token->funcName;
+		parseFnName = token->parseFuncName;
+		linePos = token->nameEnd;
+		lineNo += token->nameLines;
+	}
+	else if(read_func_name(funcName, parseFnName, linePos, inStr, readPath, lineNo, eos))
 		return 1;
 
 	//reads options
 	if(linePos < inStr.size() && inStr[linePos] == '{')
 	{
-		if(read_optionsStr(optionsStr, parseOptions, linePos, inStr, readPath, lineNo, funcName, eos))
+		if(token)
+		{
+			optionsStr = token->optionsStr;
+			parseOptions = token->parseOptions;
+			linePos = token->optionsEnd;
+			lineNo += token->optionsLines;
+		}
+		else if(read_optionsStr(optionsStr, parseOptions, linePos, inStr, readPath, lineNo, funcName, eos))
 			return 1;
 
 		if(parseOptions)
 			if(parse_replace(lang, optionsStr, "options string", readPath, antiDepsOfReadPath, lineNo, funcName, sLineNo, eos))
 				return 1;
 
-		size_t pos=0;
-		if(read_options(options, pos, optionsStr, readPath, lineNo, funcName, eos))
-			return 1;
+		if(token && !parseOptions)
+		{
+			options = token->options;
+			lineNo += token->optionsSplitLines;
+		}
+		else
+		{
+			size_t pos=0;
+			if(read_options(options, pos, optionsStr, readPath, lineNo, funcName, eos))
+				return 1;
+		}
 	}
 
 	if(options.size())
@@ -2419,7 +2811,7 @@ int Parser::read_and_process_fn(const bool& indent,
 				funcName = "'" + funcName + "'";
 			outStr += funcName + optionsStr;
 			if(indent)
-				indentAmount += into_whitespace(funcName + optionsStr);
+				indentAmount.add_text(funcName + optionsStr);
 			return 0;
 		}*/
 
@@ -2428,11 +2820,21 @@ int Parser::read_and_process_fn(const bool& indent,
 
 	std::string brackets = "()";
 
+	//parameters read ahead of time, only when how they're read didn't depend on parsing
+	if(token && !token->paramsRead)
+		token = NULL;
+
 	//reads parameters
 	if(funcName == "if" || funcName == "for" || funcName == "while" || funcName == "do-while" || funcName == "?")
 	{
 		conditionLineNo = lineNo;
-		if(read_params(params, ';', linePos, inStr, readPath, lineNo, funcName, eos))
+		if(token)
+		{
+			params.insert(params.end(), token->params.begin(), token->params.end());
+			linePos = token->end;
+			lineNo += token->paramsLines;
+		}
+		else if(read_params(params, ';', linePos, inStr, readPath, lineNo, funcName, eos))
 			return 1;
 	}
 	else if(funcName == "||" || funcName == "&&")
@@ -2440,12 +2842,25 @@ int Parser::read_and_process_fn(const bool& indent,
 		if(replaceVars && replace_vars(params, 0, readPath, sLineNo, funcName, eos))
 			return 1;
 
-		if(read_params(params, linePos, inStr, readPath, lineNo, funcName, eos))
+		if(token)
+		{
+			params.insert(params.end(), token->params.begin(), token->params.end());
+			linePos = token->end;
+			lineNo += token->paramsLines;
+		}
+		else if(read_params(params, linePos, inStr, readPath, lineNo, funcName, eos))
 			return 1;
 	}
 	else if(funcName == ":=")
 	{
-		if(read_paramsStr(paramsStr, parseParams, linePos, inStr, readPath, lineNo, funcName, eos))
+		if(token)
+		{
+			paramsStr = token->paramsStr;
+			parseParams = token->parseParams;
+			linePos = token->end;
+			lineNo += token->paramsLines;
+		}
+		else if(read_paramsStr(paramsStr, parseParams, linePos, inStr, readPath, lineNo, funcName, eos))
 			return 1;
 
 		if(parseParams && !doNotParse)
@@ -2458,12 +2873,25 @@ int Parser::read_and_process_fn(const bool& indent,
 			brackets = "[]";
 		if(doNotParse)
 		{
-			if(read_params(params, linePos, inStr, readPath, lineNo, funcName, eos))
+			if(token)
+			{
+				params.insert(params.end(), token->params.begin(), token->params.end());
+				linePos = token->end;
+				lineNo += token->paramsLines;
+			}
+			else if(read_params(params, linePos, inStr, readPath, lineNo, funcName, eos))
 				return 1;
 		}
 		else
 		{
-			if(read_paramsStr(paramsStr, parseParams, linePos, inStr, readPath, lineNo, funcName, eos))
+			if(token)
+			{
+				paramsStr = token->paramsStr;
+				parseParams = token->parseParams;
+				linePos = token->end;
+				lineNo += token->paramsLines;
+			}
+			else if(read_paramsStr(paramsStr, parseParams, linePos, inStr, readPath, lineNo, funcName, eos))
 				return 1;
 
 			if(parseParams)
@@ -2473,6 +2901,11 @@ int Parser::read_and_process_fn(const bool& indent,
 			size_t pos=0;
 			if(oneParamOpt)
 				params.push_back(unquote(paramsStr.substr(1, paramsStr.size()-2)));
+			else if(token && token->paramsSplit)
+			{
+				params.insert(params.end(), token->params.begin(), token->params.end());
+				lineNo += token->paramsSplitLines;
+			}
 			else if(read_params(params, pos, paramsStr, readPath, lineNo, funcName, eos))
 				return 1;
 		}
@@ -2484,11980 +2917,12767 @@ int Parser::read_and_process_fn(const bool& indent,
 					params[p] = std::to_string(expr.evaluate());
 	}
 
-	if(funcName[0] == '$' && !(funcName == "$" && brackets == "()"))
+	const Builtin* builtin = builtins.find(funcName);
+	if(builtin && (builtin->flags & BUILTIN_VOLATILE))
+		volatileRead = 1;
+	if(itemClone && builtin && !(builtin->flags & BUILTIN_ITEM_SAFE))
+		return 1;
+
+	if(builtin && builtin->sysName.size())
+		funcName = builtin->sysName;
+	else if(builtin && builtin->handler)
 	{
-		if(funcName == "$")
+		std::string errStr;
+		if(check_arity(*builtin, options.size(), params.size(), errStr))
 		{
-			if(params.size() != 1)
-			{
-				outStr += "$";
-				linePos = sLinePos+1;
-				if(indent)
-					indentAmount += " ";
-				return 0;
-			}
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": " << errStr << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+
+		//names interned ahead of time are only used while they're still what was read
+		int paramId = -1;
+		if(token && token->paramId >= 0 && params.size() && params[0] == token->params[0])
+			paramId = token->paramId;
+
+		FnCall call = {indent, baseIndentAmount, lang, addOutput, inStr, segmented, lineNo, linePos, readPath, antiDepsOfReadPath, outStr, eos,
+		               sLinePos, sLineNo, conditionLineNo, funcName, optionsStr, paramsStr, options, params, brackets,
+		               doNotParse, parseParams, replaceVars, hasIncrement, builtin, paramId};
+		int result = (this->*builtin->handler)(call);
+		if(result != NSM_NOT_BUILTIN)
+			return result;
+	}
+
+	VPos vpos;
+	int fnId = (token && funcName == token->funcName) ? token->nameId : name_id(funcName);
+	if(vars.find_fn(fnId, funcName, vpos))
+	{
+		size_t layer = vars.layers.size()-1;
 
-			bool round = 1;
-			std::string newline = "\n";
-			if(options.size())
+		if(vars.layers[vpos.layer].privates.count(funcName))
+		{
+			if(!vars.layers[vpos.layer].inScopes[funcName].count(vars.layers[layer].scope))
 			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "\\n")
-						newline = "\\n";
-					else if(options[o] == "!round")
-						round = 0;
-				}
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": attempted illegal access of private function" << std::endl;
+				os_mtx->unlock();
+				return 1;
 			}
+		}
 
-			VPos vpos;
-			std::string varName = params[0];
-			if(vars.typeDefs.count(varName))
-			{
-				std::istringstream iss(vars.typeDefs[varName]);
-				std::string ssLine, oldLine;
-				int ssLineNo = 0;
+		bool addScope = addScopeGlobal, addOut = 1;
 
-				while(!iss.eof())
-				{
-					getline(iss, ssLine);
-					if(0 < ssLineNo++)
-						outStr += newline + indentAmount;
-					oldLine = ssLine;
-					outStr += ssLine;
-				}
-				if(indent)
-					indentAmount += into_whitespace(oldLine);
-			}
-			else if(vars.find(varName, vpos)) //should this go after hard-coded variables?
-			{
-				if(!vars.add_str_from_var(vpos, outStr, round, indent, indentAmount))
-				{
-					std::string type = vpos.type.substr(0, vpos.type.find_first_of('<')),
-					            toParse = "@'" + type + ".$'" + optionsStr + paramsStr;
+		std::vector<std::string> oldOpts, oldPars;
+		std::string oldOptType, oldParType;
 
-					int result;
+		//options/params are touched on every call so their ids are only interned once
+		static const std::string optName = "options", parName = "params", oldOptName = "__options", oldParName = "__params";
+		static const int optId = name_id(optName), parId = name_id(parName), oldOptId = name_id(oldOptName), oldParId = name_id(oldParName);
+		static const std::string strVecType = "std::vector<string>";
 
-					if(lang == 'f')
-						result = f_read_and_process_fast(addOutput, toParse, lineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
-					else
-						result = n_read_and_process_fast(indent, toParse, lineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
+		bool optWasConst = 0, parWasConst = 0;
+		bool optWasPrivate = 0, parWasPrivate = 0;
+		bool addMemberFns = addMemberFnsGlobal;
 
-					if(result)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << c_light_blue << "$" << brackets << c_white << ": cannot get string of var type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-			}
-			else if(varName == "paginate.no_items_per_page")
-			{
-				std::string val = std::to_string(pagesInfo.noItemsPerPage);
-				outStr += val;
-				if(indent)
-					indentAmount += into_whitespace(val);
-			}
-			else if(varName == "paginate.no_pages")
-			{
-				std::string val = std::to_string((int) std::ceil((double)pagesInfo.items.size()/(double)pagesInfo.noItemsPerPage));
-				int x = pagesInfo.pages.size();
-				if(x)
-					val = std::to_string(x);
-				else
-					val = std::to_string((int) std::ceil((double)pagesInfo.items.size()/(double)pagesInfo.noItemsPerPage));
+		std::string oldScope;
 
-				outStr += val;
-				if(indent)
-					indentAmount += into_whitespace(val);
-			}
-			else if(varName == "paginate.page")
-			{
-				if(pagesInfo.cPageNo < 1 || pagesInfo.cPageNo-1 >= pagesInfo.pages.size())
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "$[" << varName << "]: no pagination page " << pagesInfo.cPageNo << std::endl;
-					os_mtx->unlock();
-					return 1;   
-				}
-
-				std::istringstream iss(pagesInfo.pages[pagesInfo.cPageNo-1]);
-				std::string str, oldLine;
-				int fileLineNo = 0;
+		if(vars.layers[vpos.layer].noOutput.count(funcName))
+			addOut = 0;
+		if(vars.layers[vpos.layer].unscopedFns.count(funcName))
+			addScope = 0;
 
-				while(!iss.eof())
-				{
-					getline(iss, str);
-					if(0 < fileLineNo++)
-						outStr += "\n" + indentAmount;
-					outStr += str;
-					oldLine = str;
-				}
-				if(indent)
-					indentAmount += into_whitespace(oldLine);
-			}
-			else if(varName == "paginate.page_no")
+		if(options.size())
+		{
+			for(size_t o=0; o<options.size(); o++)
 			{
-				std::string val = std::to_string(pagesInfo.cPageNo);
-				outStr += val;
-				if(indent)
-					indentAmount += into_whitespace(val);
+				if(options[o] == "mf")
+					addMemberFns = 1;
+				else if(options[o] == "!mf")
+					addMemberFns = 0;
+				else if(options[o] == "o")
+					addOut = 1;
+				else if(options[o] == "!o")
+					addOut = 0;
+				else if(options[o] == "s")
+					addScope = 1;
+				else if(options[o] == "!s")
+					addScope = 0;
 			}
-			else if(varName == "paginate.separator")
-			{
-				std::istringstream iss(pagesInfo.separator);
-				std::string str, oldLine;
-				int fileLineNo = 0;
+		}
 
-				while(!iss.eof())
-				{
-					getline(iss, str);
-					if(0 < fileLineNo++)
-						outStr += "\n" + indentAmount;
-					outStr += str;
-					oldLine = str;
-				}
-				if(indent)
-					indentAmount += into_whitespace(oldLine);
-			}
-			else if(varName == "line-no")
-			{
-				std::string val = std::to_string(lineNo);
-				outStr += val;
-				if(indent)
-					indentAmount += into_whitespace(val);
-			}
-			else if(varName == "title")
-			{
-				outStr += toBuild.title.str;
-				if(indent)
-					indentAmount += into_whitespace(toBuild.title.str);
-			}
-			else if(varName == "name")
-			{
-				outStr += toBuild.name;
-				if(indent)
-					indentAmount += into_whitespace(toBuild.name);
-			}
-			else if(varName == "content-path")
-			{
-				outStr += toBuild.contentPath.str();
-				if(indent)
-					indentAmount += into_whitespace(toBuild.contentPath.str());
-			}
-			else if(varName == "output-path")
-			{
-				outStr += toBuild.outputPath.str();
-				if(indent)
-					indentAmount += into_whitespace(toBuild.outputPath.str());
-			}
-			else if(varName == "content-ext")
-			{
-				if(toBuild.contentExt != "")
-				{
-					outStr += toBuild.contentExt;
-					if(indent)
-						indentAmount += into_whitespace(toBuild.contentExt);
-				}
-				else
-				{
-					outStr += contentExt;
-					if(indent)
-						indentAmount += into_whitespace(contentExt);
-				}
-			}
-			else if(varName == "output-ext")
-			{
-				if(toBuild.outputExt != "")
-				{
-					outStr += toBuild.outputExt;
-					if(indent)
-						indentAmount += into_whitespace(toBuild.outputExt);
-				}
-				else
-				{
-					outStr += outputExt;
-					if(indent)
-						indentAmount += into_whitespace(outputExt);
-				}
-			}
-			else if(varName == "script-ext")
-			{
-				if(toBuild.scriptExt != "")
-				{
-					outStr += toBuild.scriptExt;
-					if(indent)
-						indentAmount += into_whitespace(toBuild.scriptExt);
-				}
-				else
-				{
-					outStr += scriptExt;
-					if(indent)
-						indentAmount += into_whitespace(scriptExt);
-				}
-			}
-			else if(varName == "template-path")
-			{
-				outStr += toBuild.templatePath.str();
-				if(indent)
-					indentAmount += into_whitespace(toBuild.templatePath.str());
-			}
-			else if(varName == "content-dir")
-			{
-				outStr += contentDir;
-				if(indent)
-					indentAmount += into_whitespace(contentDir);
-			}
-			else if(varName == "output-dir")
-			{
-				outStr += outputDir;
-				if(indent)
-					indentAmount += into_whitespace(outputDir);
-			}
-			else if(varName == "default-content-ext")
-			{
-				outStr += contentExt;
-				if(indent)
-					indentAmount += into_whitespace(contentExt);
-			}
-			else if(varName == "default-output-ext")
-			{
-				outStr += outputExt;
-				if(indent)
-					indentAmount += into_whitespace(outputExt);
-			}
-			else if(varName == "default-script-ext")
-			{
-				outStr += scriptExt;
-				if(indent)
-					indentAmount += into_whitespace(scriptExt);
-			}
-			else if(varName == "default-template")
-			{
-				outStr += defaultTemplate.str();
-				if(indent)
-					indentAmount += into_whitespace(defaultTemplate.str());
-			}
-			else if(varName == "build-timezone")
-			{
-				outStr += dateTimeInfo.cTimezone;
-				if(indent)
-					indentAmount += into_whitespace(dateTimeInfo.cTimezone);
-			}
-			else if(varName == "load-timezone")
-			{
-				outStr += "<script>document.write(new Date().toString().split(\"(\")[1].split(\")\")[0])</script>";
-				if(indent)
-					indentAmount += std::string(82, ' ');
-			}
-			else if(varName == "timezone" || varName == "current-timezone")
-			{ //this is left for backwards compatibility
-				outStr += dateTimeInfo.cTimezone;
-				if(indent)
-					indentAmount += into_whitespace(dateTimeInfo.cTimezone);
-			}
-			else if(varName == "build-time")
-			{
-				outStr += dateTimeInfo.cTime;
-				if(indent)
-					indentAmount += into_whitespace(dateTimeInfo.cTime);
-			}
-			else if(varName == "build-UTC-time")
-			{
-				outStr += dateTimeInfo.currentUTCTime();
-				if(indent)
-					indentAmount += into_whitespace(dateTimeInfo.currentUTCTime());
-			}
-			else if(varName == "build-date")
-			{
-				outStr += dateTimeInfo.cDate;
-				if(indent)
-					indentAmount += into_whitespace(dateTimeInfo.cDate);
-			}
-			else if(varName == "build-UTC-date")
-			{
-				outStr += dateTimeInfo.currentUTCDate();
-				if(indent)
-					indentAmount += into_whitespace(dateTimeInfo.currentUTCDate());
-			}
-			else if(varName == "current-time")
-			{ //this is left for backwards compatibility
-				outStr += dateTimeInfo.cTime;
-				if(indent)
-					indentAmount += into_whitespace(dateTimeInfo.cTime);
-			}
-			else if(varName == "current-UTC-time")
-			{ //this is left for backwards compatibility
-				outStr += dateTimeInfo.currentUTCTime();
-				if(indent)
-					indentAmount += into_whitespace(dateTimeInfo.currentUTCTime());
-			}
-			else if(varName == "current-date")
-			{ //this is left for backwards compatibility
-				outStr += dateTimeInfo.cDate;
-				if(indent)
-					indentAmount += into_whitespace(dateTimeInfo.cDate);
-			}
-			else if(varName == "current-UTC-date")
-			{ //this is left for backwards compatibility
-				outStr += dateTimeInfo.currentUTCDate();
-				if(indent)
-					indentAmount += into_whitespace(dateTimeInfo.currentUTCDate());
-			}
-			else if(varName == "load-time")
-			{
-				outStr += "<script>document.write((new Date().toLocaleString()).split(\",\")[1])</script>";
-				if(indent)
-					indentAmount += std::string(76, ' ');
-			}
-			else if(varName == "load-UTC-time")
-			{
-				outStr += "<script>document.write((new Date().toISOString()).split(\"T\")[1].split(\".\")[0])</script>";
-				if(indent)
-					indentAmount += std::string(87, ' ');
-			}
-			else if(varName == "load-date")
-			{
-				outStr += "<script>document.write((new Date().toLocaleString()).split(\",\")[0])</script>";
-				if(indent)
-					indentAmount += std::string(76, ' ');
-			}
-			else if(varName == "load-UTC-date")
-			{
-				outStr += "<script>document.write((new Date().toISOString()).split(\"T\")[0])</script>";
-				if(indent)
-					indentAmount += std::string(73, ' ');
-			}
-			else if(varName == "build-YYYY")
-			{
-				outStr += dateTimeInfo.currentYYYY();
-				if(indent)
-					indentAmount += into_whitespace(dateTimeInfo.currentYYYY());
-			}
-			else if(varName == "build-YY")
-			{
-				outStr += dateTimeInfo.currentYY();
-				if(indent)
-					indentAmount += into_whitespace(dateTimeInfo.currentYY());
-			}
-			else if(varName == "current-YYYY")
-			{ //this is left for backwards compatibility
-				outStr += dateTimeInfo.currentYYYY();
-				if(indent)
-					indentAmount += into_whitespace(dateTimeInfo.currentYYYY());
-			}
-			else if(varName == "current-YY")
-			{ //this is left for backwards compatibility
-				outStr += dateTimeInfo.currentYY();
-				if(indent)
-					indentAmount += into_whitespace(dateTimeInfo.currentYY());
-			}
-			else if(varName == "load-YYYY")
-			{
-				outStr += "<script>document.write(new Date().getFullYear())</script>";
-				if(indent)
-					indentAmount += std::string(57, ' ');
-			}
-			else if(varName == "load-YY")
+		//adds scope to variables
+		if(addScope)
+		{
+			//vars.add_layer(vars.layers[vpos.layer].scopeOf[funcName]);
+			vars.add_layer(funcName.substr(0, funcName.find_last_of('.')+1));
+			//++layer;
+		}
+		else
+		{
+			oldScope = vars.layers[layer].scope;
+			vars.layers[layer].scope = funcName.substr(0, find_last_of_special(funcName)+1);
+		}
+
+		//backs up options/params variables already defined at this scope
+		if(vars.layers[0].typeOf.count(optId))
+		{
+			if(vars.layers[0].constants.count("options"))
+				optWasConst = 1;
+			if(vars.layers[0].privates.count("options"))
+				optWasPrivate = 1;
+
+			oldOptType = vars.layers[0].typeOf.at(optId, optName);
+
+			if(oldOptType == "std::vector<string>")
 			{
-				outStr += "<script>document.write(new Date().getFullYear()%100)</script>";
-				if(indent)
-					indentAmount += std::string(61, ' ');
+				oldOpts.swap(vars.layers[0].strVecs.at(optId, optName));
+				vars.layers[0].strVecs.at(oldOptId, oldOptName) = oldOpts;
 			}
-			else if(varName == "build-OS")
+
+			vars.layers[0].typeOf.erase(optId);
+		}
+
+		if(vars.layers[0].typeOf.count(parId))
+		{
+			if(vars.layers[0].constants.count("params"))
+				parWasConst = 1;
+			if(vars.layers[0].privates.count("params"))
+				parWasPrivate = 1;
+
+			oldParType = vars.layers[0].typeOf.at(parId, parName);
+
+			if(oldParType == "std::vector<string>")
 			{
-				outStr += dateTimeInfo.currentOS();
-				if(indent)
-					indentAmount += into_whitespace(dateTimeInfo.currentOS());
-			}
-			else if(varName == "current-OS")
-			{ //this is left for backwards compatibility
-				outStr += dateTimeInfo.currentOS();
-				if(indent)
-					indentAmount += into_whitespace(dateTimeInfo.currentOS());
+				oldPars.swap(vars.layers[0].strVecs.at(parId, parName));
+				vars.layers[0].strVecs.at(oldParId, oldParName) = oldPars;
 			}
-			else
+
+			vars.layers[0].typeOf.erase(parId);
+		}
+
+		//defines params/options vectors
+		if(addMemberFns && !vars.layers[0].functions.count("options.at"))
+		{
+			std::string toParse = ":={layer=0}(std::vector<string>, options)";
+			std::string trash;
+			if(f_read_and_process_fast(0, toParse, lineNo, readPath, antiDepsOfReadPath, trash, eos) > 0)
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "$[" << varName << "]: no typedef, funcdef or variable named " << quote(varName) << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to define options vector" << std::endl;
 				os_mtx->unlock();
 				return 1;
-
-				/*outStr += "@";
-				linePos = sLinePos;
-				if(indent)
-					indentAmount += " ";*/
 			}
-
-			return 0;
 		}
-	}
-	else if(funcName[0] == 'i')
-	{
-		if(funcName == "input" || funcName == "inject")
+		else
+			vars.layers[0].typeOf.at(optId, optName) = strVecType;
+		vars.layers[0].strVecs.at(optId, optName).swap(options);
+		vars.layers[0].constants.insert("options");
+
+		if(addMemberFns && !vars.layers[0].functions.count("params.at"))
 		{
-			if(params.size() != 1)
+			std::string toParse = ":={layer=0}(std::vector<string>, params)";
+			std::string trash;
+			if(f_read_and_process_fast(0, toParse, lineNo, readPath, antiDepsOfReadPath, trash, eos) > 0)
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to define params vector" << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+		}
+		else
+			vars.layers[0].typeOf.at(parId, parName) = strVecType;
 
-			std::string inputPathStr = params[0];
-			bool ifExists = 0, inputRaw = 0, noIndent = 0;
-			char inpLang = lang;
+		vars.layers[0].strVecs.at(parId, parName).swap(params);
+		vars.layers[0].constants.insert("params");
 
-			std::string oldIndent = indentAmount;
-			if(noIndent)
-				indentAmount = "";
+		//held here in case the function forgets or redefines itself
+		std::shared_ptr<const SegmentedText> segmentedFn = vars.segment_fn(vpos.layer, funcName, *this);
+		Path fnPath = vars.layers[vpos.layer].paths[funcName];
+		int fnLineNo = vars.layers[vpos.layer].ints.at(vpos.id, funcName)-1;
 
-			if(options.size())
+		std::string fnOutput;
+		if(lang == 'n')
+		{
+			if(n_read_and_process_fast(1, addOut, segmentedFn->text, segmentedFn.get(), fnLineNo, fnPath, antiDepsOfReadPath, fnOutput, eos) > 0)
 			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "f++")
-						inpLang = 'f';
-					else if(options[o] == "n++")
-						inpLang = 'n';
-					else if(options[o] == "raw")
-						inputRaw = 1;
-					else if(options[o] == "if-exists")
-						ifExists = 1;
-					else if(options[o] == "!i" || options[o] == "!indent")
-						noIndent = 1;
-				}
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed here" << std::endl;
+				os_mtx->unlock();
+				return 1;
 			}
-
-			if(!file_exists(inputPathStr)) 
+		}
+		else
+		{
+			if(f_read_and_process_fast(addOut, segmentedFn->text, fnLineNo, fnPath, antiDepsOfReadPath, fnOutput, eos) > 0)
 			{
-				if(file_exists(readPath.dir + inputPathStr))
-					inputPathStr = readPath.dir + inputPathStr;
-				else if(ifExists) 
-				{
-					skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
-
-					if(noIndent)
-						indentAmount = oldIndent;
-
-					return 0;
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					if(funcName == "input")
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "inputting file " << c_purple << params[0] << c_white << " failed as path does not exist" << std::endl;
-					else
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "injecting file " << c_purple << params[0] << c_white << " failed as path does not exist" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed here" << std::endl;
+				os_mtx->unlock();
+				return 1;
 			}
+		}
+		outStr += fnOutput;
 
-			Path inputPath;
-			inputPath.set_file_path_from(inputPathStr);
-
-			if(incrMode != INCR_MOD)
-			{
-				checked_hash_mtx.lock();
-				if(!checkedHashFile.count(inputPath))
-				{
-					checkedHashFile.insert(inputPath);
-					checked_hash_mtx.unlock();
-					Path hashPath = inputPath.getHashPath();
-					std::string hashPathStr = hashPath.str();
-					unsigned int hash = FNVHash(string_from_file(inputPathStr));
-					if(!file_exists(hashPathStr) || 
-					   (unsigned) std::atoi(string_from_file(hashPathStr).c_str()) != hash)
-					{
-						hashPath.ensureDirExists();
-						std::ofstream ofs(hashPathStr);
-						ofs << hash << "\n";
-						ofs.close();
-					}
-				}
-				else
-					checked_hash_mtx.unlock();
-			}
-			depFiles.insert(inputPath);
-
-			if(inputPath == toBuild.contentPath)
-				contentAdded = 1;
-
-			if(!inputRaw)
-			{
-				//ensures insert file isn't an anti dep of read path
-				if(antiDepsOfReadPath.count(inputPath))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					if(funcName == "input")
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "inputting file " << c_purple << inputPath << c_white << " would result in an input loop" << std::endl;
-					else
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "injecting file " << c_purple << inputPath << c_white << " would result in an input loop" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-
-				std::string fileStr = string_from_file(inputPath.str());
+		//removes added scope to variables
+		if(addScope)
+			vars.layers.pop_back();
+		else
+			vars.layers[layer].scope = oldScope;
 
-				//adds insert file
-				if(inpLang == 'f')
-				{
-					if(f_read_and_process(1, fileStr, 0, inputPath, antiDepsOfReadPath, outStr, eos) > 0)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << "(" << inputPath << ") failed" << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-				else if(n_read_and_process(1, fileStr, 0, inputPath, antiDepsOfReadPath, outStr, eos) > 0)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << "(" << inputPath << ") failed" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
+		//reverts existing options/params variables otherwise deletes them
+		if(!optWasConst)
+			vars.layers[0].constants.erase("options");
+		if(!optWasPrivate)
+			vars.layers[0].privates.erase("options");
+		if(oldOptType == "std::vector<string>")
+		{
+			vars.layers[0].strVecs.at(optId, optName).swap(oldOpts);
+			vars.layers[0].strVecs.erase(oldOptId);
+		}
+		else
+		{
+			vars.layers[0].strVecs.erase(optId);
+			if(oldOptType == "")
+				vars.layers[0].typeOf.erase(optId);
 			else
-			{
-				std::ifstream ifs(inputPath.str());
-				std::string fileLine, oldLine;
-				int fileLineNo = 0;
-
-				while(!ifs.eof())
-				{
-					getline(ifs, fileLine);
-					if(0 < fileLineNo++)
-						outStr += "\n" + indentAmount;
-					oldLine = fileLine;
-					outStr += fileLine;
-				}
-				indentAmount += into_whitespace(oldLine);
+				vars.layers[0].typeOf.at(optId, optName) = oldOptType;
+		}
 
-				ifs.close();
-			}
+		if(!parWasConst)
+			vars.layers[0].constants.erase("params");
+		if(!parWasPrivate)
+			vars.layers[0].privates.erase("params");
+		if(oldParType == "std::vector<string>")
+		{
+			vars.layers[0].strVecs.at(parId, parName).swap(oldPars);
+			vars.layers[0].strVecs.erase(oldParId);
+		}
+		else
+		{
+			vars.layers[0].strVecs.erase(parId);
+			if(oldParType == "")
+				vars.layers[0].typeOf.erase(parId);
+			else
+				vars.layers[0].typeOf.at(parId, parName) = oldParType;
+		}
+	}
+	else if(valid_type(funcName, readPath, antiDepsOfReadPath, lineNo, "valid_type(" + funcName + ")", sLineNo, eos))
+	{
+		if(params.size() < 1)
+		{
+			if(read_sh_params(params, ',', linePos, inStr, readPath, lineNo, funcName, eos))
+				return 1;
+		}
 
-			if(noIndent)
-				indentAmount = oldIndent;
+		if(!params.size())
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected parameters, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			return 0;
+		std::string toParse;
+		if(lang == 'n')
+			toParse = "@";
+		toParse += ":=";
+		if(options.size())
+		{
+			toParse += "{" + options[0];
+			for(size_t o=1; o<options.size(); ++o)
+				toParse += ", " + options[o];
+			toParse += '}';
 		}
-		else if(funcName == "item")
+		toParse += "(" + funcName;
+		for(size_t p=0; p<params.size(); ++p)
+			toParse += ", " + params[p];
+		toParse += ')';
+
+		if(lang == 'f')
 		{
-			if(params.size() != 0)
+			if(f_read_and_process_fast(addOutput, toParse, lineNo-1, readPath, antiDepsOfReadPath, outStr, eos))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "item: expected 0 parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) <<  funcName << ": definition failed" << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
-
-			std::string item;
-			int itemLineNo;
-
-			if(read_block(item, linePos, inStr, readPath, lineNo, itemLineNo, funcName, eos))
-				   return 1;
-
-			pagesInfo.items.push_back(item);
-			pagesInfo.itemLineNos.push_back(itemLineNo);
-			pagesInfo.itemCallLineNos.push_back(sLineNo);
-			pagesInfo.itemCallPaths.push_back(readPath);
-
-			//skip_whitespace(0, inStr, lineNo, linePos, readPath, funcNmae, eos);
-
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
-
-			return 0;
 		}
-		else if(funcName == "include")
+		else
 		{
-			if(params.size() == 0)
+			if(n_read_and_process_fast(indent, toParse, lineNo-1, readPath, antiDepsOfReadPath, outStr, eos))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "include: no files specified to include" << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) <<  funcName << ": definition failed" << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+		}
+
+		if(linePos < inStr.size() && inStr[linePos] == '!')
+			++linePos;
+		else
+			skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-			char incLang = lang;
+		return 0;
+	}
+	else if(zeroParams)
+	{
+		if(lang == 'n')
+		{
+			linePos = sLinePos;
+
+			if(inStr[sLinePos] == '$')
+				++linePos;
 
-			if(options.size())
+			if(addOutput)
 			{
-				for(size_t o=0; o<options.size(); ++o)
-				{
-					if(options[o] == "f++")
-						incLang = 'f';
-					else if(options[o] == "n++")
-						incLang = 'n';
-				}
+				if(inStr[sLinePos] == '$')
+					outStr += "$";
+				else
+					outStr += "@";
+				if(indent)
+					indentAmount += ' ';
 			}
 
-			Path inputPath;
-			std::string includeOutput;
-			std::string oldIndent = indentAmount;
-
-			for(size_t p=0; p<params.size(); p++)
+			return 0;
+		}
+		else
+		{
+			if(addOutput)
+			{
+				if(inStr[sLinePos] == '"')
+					funcName = "\"" + funcName + "\"";
+				else if(inStr[sLinePos] == '\'')
+					funcName = "'" + funcName + "'";
+				outStr += funcName + optionsStr;
+				if(indent)
+					indentAmount.add_text(funcName + optionsStr);
+				return 0;
+			}
+			else
 			{
-				inputPath.set_file_path_from(params[p]);
+				//std::string trash, toParse = "sys(" + funcName;
 
-				if(!includedFiles.count(inputPath))
+				/*if(options.size())
 				{
-					includedFiles.insert(inputPath);
-
-					if(!file_exists(params[p]))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "include: including file " << inputPath << " failed as path does not exist" << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-
-					//ensures insert file isn't an anti dep of read path
-					if(antiDepsOfReadPath.count(inputPath))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "include: including file " << inputPath << " would result in an input loop" << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-
-					if(incrMode != INCR_MOD)
+					for(size_t o=0; o<options.size(); ++o)
+						#if defined _WIN32 || defined _WIN64
+							toParse += " /" + options[o];
+						#else  // *nix
+							toParse += " -" + options[o];
+						#endif
+				}
+				else if(toParse[toParse.size()-1] == ';')
+					toParse = toParse.substr(0, toParse.size()-1);
+				else
+				{
+					for(;linePos < inStr.size() && inStr[linePos] != '\n'; ++linePos)
 					{
-						checked_hash_mtx.lock();
-						if(!checkedHashFile.count(inputPath))
+						if(inStr[linePos] == ';')
 						{
-							checkedHashFile.insert(inputPath);
-							checked_hash_mtx.unlock();
-							Path hashPath = inputPath.getHashPath();
-							std::string hashPathStr = hashPath.str();
-							unsigned int hash = FNVHash(string_from_file(inputPath.str()));
-							if(!file_exists(hashPathStr) || 
-							   (unsigned) std::atoi(string_from_file(hashPathStr).c_str()) != hash)
-							{
-								hashPath.ensureDirExists();
-								std::ofstream ofs(hashPathStr);
-								ofs << hash << "\n";
-								ofs.close();
-							}
+							++linePos;
+							break;
 						}
-						else
-							checked_hash_mtx.unlock();
+						toParse += inStr[linePos];
 					}
-					depFiles.insert(inputPath);
+				}
+				toParse += ")";*/
+
+				std::string trash,
+				            toParse;
+				if(mode == MODE_INTERP || mode == MODE_SHELL)
+				{
+					toParse = inStr.substr(sLinePos, inStr.size() - sLinePos);
+					linePos = inStr.size();
+				}
+				else
+					toParse = inStr.substr(sLinePos, (linePos = inStr.find_first_of("\n", sLinePos)) - sLinePos);
+
+				if(expr.compile(toParse) && expr.evaluate())
+					return 0;
+				else
+				{
+					std::string parseReplace = toParse;
+
+					lineNo = sLineNo;
+
+					if(parse_replace(lang, parseReplace, "expression", readPath, antiDepsOfReadPath, lineNo-1, parseReplace, sLineNo, eos))
+			   			return 1;
 
-					std::string fileStr = string_from_file(inputPath.str());
+			   		lineNo = sLineNo;
 
-					//parses include file
-					indentAmount = "";
-					if(incLang == 'f')
+			   		if(expr.compile(parseReplace) && expr.evaluate())
+			   			return 0;
+					else if(f_read_and_process(0, "sys{!p}(" + toParse + ")", lineNo-1, readPath, antiDepsOfReadPath, trash, eos))
 					{
-						if(f_read_and_process(0, fileStr, 0, inputPath, antiDepsOfReadPath, includeOutput, eos) > 0)
+						if(mode != MODE_INTERP && mode != MODE_SHELL)
 						{
 							if(!consoleLocked)
 								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << "include(" << inputPath << ") failed" << std::endl;
+							start_err_ml(eos, readPath, sLineNo, lineNo) << c_light_blue << funcName << c_white << ": function does not exist in this scope";
+							eos << " and failed as a system call" << std::endl;
+							print_exprtk_parser_errs(eos, expr.errors(), expr.expr_str, readPath, sLineNo);
 							os_mtx->unlock();
-							return 1;
 						}
-					}
-					else if(n_read_and_process(0, fileStr, 0, inputPath, antiDepsOfReadPath, includeOutput, eos) > 0)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "include(" << inputPath << ") failed" << std::endl;
-						os_mtx->unlock();
 						return 1;
 					}
 				}
-			}
-
-			indentAmount = oldIndent;
-
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-			return 0;
+				return 0;
+			}
 		}
-		else if(funcName == "if")
+	}
+	else if(lang == 'f')
+	{
+		if(addOutput)
 		{
-			if(params.size() != 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "if: expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+			if(inStr[sLinePos] == '"')
+				funcName = "\"" + funcName + "\"";
+			else if(inStr[sLinePos] == '\'')
+				funcName = "'" + funcName + "'";
+			outStr += funcName + optionsStr + paramsStr;
+			if(indent)
+				indentAmount.add_text(funcName + optionsStr + paramsStr);
+			return 0;
+		}
+		else
+		{
+			std::string trash;
+			return try_system_call(funcName, options, params, readPath, antiDepsOfReadPath, sLineNo, lineNo, eos, trash);
+		}
+	}
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << c_light_blue << funcName << c_white << ": function does not exist" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-			bool addScope = addScopeGlobal, addOut = addOutput, addWhitespace = 0;
-			char iLang = lang;
-			std::string block, parsedCondition, whitespace;
-			std::vector<std::string> blocks, conditions;
-			std::vector<int> bLineNos, cLineNos;
-			int bLineNo = lineNo;
+	return 0;
+}
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "f++")
-						iLang = 'f';
-					else if(options[o] == "n++")
-						iLang = 'n';
-					else if(options[o] == "o")
-						addOut = 1;
-					else if(options[o] == "!o")
-						addOut = 0;
-					if(options[o] == "s")
-						addScope = 1;
-					else if(options[o] == "!s")
-						addScope = 0;
-				}
-			}
+int Parser::builtin_dollar(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const char& lang = call.lang;
+	const bool& addOutput = call.addOutput;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLinePos = call.sLinePos;
+	int& sLineNo = call.sLineNo;
+	std::string& optionsStr = call.optionsStr;
+	std::string& paramsStr = call.paramsStr;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	std::string& brackets = call.brackets;
+
+	if(brackets == "()")
+		return NSM_NOT_BUILTIN;
+
+	if(params.size() != 1)
+	{
+		outStr += "$";
+		linePos = sLinePos+1;
+		if(indent)
+			indentAmount += ' ';
+		return 0;
+	}
 
-			if(linePos >= inStr.size())
+	bool round = 1;
+	std::string newline = "\n";
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "\\n")
+				newline = "\\n";
+			else if(options[o] == "!round")
+				round = 0;
+		}
+	}
+
+	VPos vpos;
+	std::string varName = params[0];
+
+	//times and dates change without anything the page is built from changing
+	if(varName.substr(0, 6) == "build-" || varName.substr(0, 8) == "current-" ||
+	   varName.substr(0, 5) == "load-" || varName == "timezone")
+		volatileRead = 1;
+	//clones don't have the pagination info
+	if(itemClone && varName.substr(0, 9) == "paginate.")
+		return 1;
+
+	if(vars.typeDefs.count(varName))
+	{
+		std::istringstream iss(vars.typeDefs[varName]);
+		std::string ssLine, oldLine;
+		int ssLineNo = 0;
+
+		while(!iss.eof())
+		{
+			getline(iss, ssLine);
+			if(0 < ssLineNo++)
+				outStr += newline + indentAmount;
+			oldLine = ssLine;
+			outStr += ssLine;
+		}
+		if(indent)
+			indentAmount.add_text(oldLine);
+	}
+	else if(call.paramId >= 0 ? vars.find(call.paramId, vpos) : vars.find(varName, vpos)) //should this go after hard-coded variables?
+	{
+		if(!vars.add_str_from_var(vpos, outStr, round, indent, indentAmount))
+		{
+			std::string type = vpos.type.substr(0, vpos.type.find_first_of('<')),
+			            toParse = "@'" + type + ".$'" + optionsStr + paramsStr;
+
+			int result;
+
+			if(lang == 'f')
+				result = f_read_and_process_fast(addOutput, toParse, lineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
+			else
+				result = n_read_and_process_fast(indent, toParse, lineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
+
+			if(result)
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "if: no proceeding block" << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << c_light_blue << "$" << brackets << c_white << ": cannot get string of var type " << quote(vpos.type) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+		}
+	}
+	else if(varName == "paginate.no_items_per_page")
+	{
+		std::string val = std::to_string(pagesInfo.noItemsPerPage);
+		outStr += val;
+		if(indent)
+			indentAmount.add_text(val);
+	}
+	else if(varName == "paginate.no_pages")
+	{
+		std::string val = std::to_string((int) std::ceil((double)pagesInfo.items.size()/(double)pagesInfo.noItemsPerPage));
+		int x = pagesInfo.pages.size();
+		if(x)
+			val = std::to_string(x);
+		else
+			val = std::to_string((int) std::ceil((double)pagesInfo.items.size()/(double)pagesInfo.noItemsPerPage));
 
-			if(read_block(block, linePos, inStr, readPath, lineNo, bLineNo, "if(" + params[0] + ")", eos))
-				return 1;
-
-			conditions.push_back(params[0]);
-			cLineNos.push_back(conditionLineNo);
-			blocks.push_back(block);
-			bLineNos.push_back(bLineNo);
+		outStr += val;
+		if(indent)
+			indentAmount.add_text(val);
+	}
+	else if(varName == "paginate.page")
+	{
+		if(pagesInfo.cPageNo < 1 || pagesInfo.cPageNo-1 >= pagesInfo.pages.size())
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "$[" << varName << "]: no pagination page " << pagesInfo.cPageNo << std::endl;
+			os_mtx->unlock();
+			return 1;   
+		}
 
-			if(read_else_blocks(conditions, cLineNos, blocks, bLineNos, whitespace, linePos, inStr, readPath, lineNo, "if(" + params[0] + ")", eos))
-				return 1;
+		std::istringstream iss(pagesInfo.pages[pagesInfo.cPageNo-1]);
+		std::string str, oldLine;
+		int fileLineNo = 0;
 
-			bool result;
+		while(!iss.eof())
+		{
+			getline(iss, str);
+			if(0 < fileLineNo++)
+				add_newline(outStr, indentAmount);
+			outStr += str;
+			oldLine = str;
+		}
+		if(indent)
+			indentAmount.add_text(oldLine);
+	}
+	else if(varName == "paginate.page_no")
+	{
+		std::string val = std::to_string(pagesInfo.cPageNo);
+		outStr += val;
+		if(indent)
+			indentAmount.add_text(val);
+	}
+	else if(varName == "paginate.separator")
+	{
+		std::istringstream iss(pagesInfo.separator);
+		std::string str, oldLine;
+		int fileLineNo = 0;
 
-			for(size_t b=0; b<blocks.size(); b++)
-			{
-				if(b < conditions.size())
-				{
-					if(!get_bool(result, conditions[b]))
-					{
-						VPos vpos;
-						if(vars.find(conditions[b], vpos)) {
-							vars.get_bool_from_var(vpos, result);
-						}
-						else {
-							if(conditions[b] != "" && expr.compile(conditions[b])) {
-								result = expr.evaluate();
-							}
-							else
-							{
-								parsedCondition = conditions[b];
+		while(!iss.eof())
+		{
+			getline(iss, str);
+			if(0 < fileLineNo++)
+				add_newline(outStr, indentAmount);
+			outStr += str;
+			oldLine = str;
+		}
+		if(indent)
+			indentAmount.add_text(oldLine);
+	}
+	else if(varName == "line-no")
+	{
+		std::string val = std::to_string(lineNo);
+		outStr += val;
+		if(indent)
+			indentAmount.add_text(val);
+	}
+	else if(varName == "title")
+	{
+		outStr += toBuild.title.str;
+		if(indent)
+			indentAmount.add_text(toBuild.title.str);
+	}
+	else if(varName == "name")
+	{
+		outStr += toBuild.name;
+		if(indent)
+			indentAmount.add_text(toBuild.name);
+	}
+	else if(varName == "content-path")
+	{
+		outStr += toBuild.contentPath.str();
+		if(indent)
+			indentAmount.add_text(toBuild.contentPath.str());
+	}
+	else if(varName == "output-path")
+	{
+		outStr += toBuild.outputPath.str();
+		if(indent)
+			indentAmount.add_text(toBuild.outputPath.str());
+	}
+	else if(varName == "content-ext")
+	{
+		if(toBuild.contentExt != "")
+		{
+			outStr += toBuild.contentExt;
+			if(indent)
+				indentAmount.add_text(toBuild.contentExt);
+		}
+		else
+		{
+			outStr += contentExt;
+			if(indent)
+				indentAmount.add_text(contentExt);
+		}
+	}
+	else if(varName == "output-ext")
+	{
+		if(toBuild.outputExt != "")
+		{
+			outStr += toBuild.outputExt;
+			if(indent)
+				indentAmount.add_text(toBuild.outputExt);
+		}
+		else
+		{
+			outStr += outputExt;
+			if(indent)
+				indentAmount.add_text(outputExt);
+		}
+	}
+	else if(varName == "script-ext")
+	{
+		if(toBuild.scriptExt != "")
+		{
+			outStr += toBuild.scriptExt;
+			if(indent)
+				indentAmount.add_text(toBuild.scriptExt);
+		}
+		else
+		{
+			outStr += scriptExt;
+			if(indent)
+				indentAmount.add_text(scriptExt);
+		}
+	}
+	else if(varName == "template-path")
+	{
+		outStr += toBuild.templatePath.str();
+		if(indent)
+			indentAmount.add_text(toBuild.templatePath.str());
+	}
+	else if(varName == "content-dir")
+	{
+		outStr += contentDir;
+		if(indent)
+			indentAmount.add_text(contentDir);
+	}
+	else if(varName == "output-dir")
+	{
+		outStr += outputDir;
+		if(indent)
+			indentAmount.add_text(outputDir);
+	}
+	else if(varName == "default-content-ext")
+	{
+		outStr += contentExt;
+		if(indent)
+			indentAmount.add_text(contentExt);
+	}
+	else if(varName == "default-output-ext")
+	{
+		outStr += outputExt;
+		if(indent)
+			indentAmount.add_text(outputExt);
+	}
+	else if(varName == "default-script-ext")
+	{
+		outStr += scriptExt;
+		if(indent)
+			indentAmount.add_text(scriptExt);
+	}
+	else if(varName == "default-template")
+	{
+		outStr += defaultTemplate.str();
+		if(indent)
+			indentAmount.add_text(defaultTemplate.str());
+	}
+	else if(varName == "build-timezone")
+	{
+		outStr += dateTimeInfo.cTimezone;
+		if(indent)
+			indentAmount.add_text(dateTimeInfo.cTimezone);
+	}
+	else if(varName == "load-timezone")
+	{
+		outStr += "<script>document.write(new Date().toString().split(\"(\")[1].split(\")\")[0])</script>";
+		if(indent)
+			indentAmount.add_spaces(82);
+	}
+	else if(varName == "timezone" || varName == "current-timezone")
+	{ //this is left for backwards compatibility
+		outStr += dateTimeInfo.cTimezone;
+		if(indent)
+			indentAmount.add_text(dateTimeInfo.cTimezone);
+	}
+	else if(varName == "build-time")
+	{
+		outStr += dateTimeInfo.cTime;
+		if(indent)
+			indentAmount.add_text(dateTimeInfo.cTime);
+	}
+	else if(varName == "build-UTC-time")
+	{
+		outStr += dateTimeInfo.currentUTCTime();
+		if(indent)
+			indentAmount.add_text(dateTimeInfo.currentUTCTime());
+	}
+	else if(varName == "build-date")
+	{
+		outStr += dateTimeInfo.cDate;
+		if(indent)
+			indentAmount.add_text(dateTimeInfo.cDate);
+	}
+	else if(varName == "build-UTC-date")
+	{
+		outStr += dateTimeInfo.currentUTCDate();
+		if(indent)
+			indentAmount.add_text(dateTimeInfo.currentUTCDate());
+	}
+	else if(varName == "current-time")
+	{ //this is left for backwards compatibility
+		outStr += dateTimeInfo.cTime;
+		if(indent)
+			indentAmount.add_text(dateTimeInfo.cTime);
+	}
+	else if(varName == "current-UTC-time")
+	{ //this is left for backwards compatibility
+		outStr += dateTimeInfo.currentUTCTime();
+		if(indent)
+			indentAmount.add_text(dateTimeInfo.currentUTCTime());
+	}
+	else if(varName == "current-date")
+	{ //this is left for backwards compatibility
+		outStr += dateTimeInfo.cDate;
+		if(indent)
+			indentAmount.add_text(dateTimeInfo.cDate);
+	}
+	else if(varName == "current-UTC-date")
+	{ //this is left for backwards compatibility
+		outStr += dateTimeInfo.currentUTCDate();
+		if(indent)
+			indentAmount.add_text(dateTimeInfo.currentUTCDate());
+	}
+	else if(varName == "load-time")
+	{
+		outStr += "<script>document.write((new Date().toLocaleString()).split(\",\")[1])</script>";
+		if(indent)
+			indentAmount.add_spaces(76);
+	}
+	else if(varName == "load-UTC-time")
+	{
+		outStr += "<script>document.write((new Date().toISOString()).split(\"T\")[1].split(\".\")[0])</script>";
+		if(indent)
+			indentAmount.add_spaces(87);
+	}
+	else if(varName == "load-date")
+	{
+		outStr += "<script>document.write((new Date().toLocaleString()).split(\",\")[0])</script>";
+		if(indent)
+			indentAmount.add_spaces(76);
+	}
+	else if(varName == "load-UTC-date")
+	{
+		outStr += "<script>document.write((new Date().toISOString()).split(\"T\")[0])</script>";
+		if(indent)
+			indentAmount.add_spaces(73);
+	}
+	else if(varName == "build-YYYY")
+	{
+		outStr += dateTimeInfo.currentYYYY();
+		if(indent)
+			indentAmount.add_text(dateTimeInfo.currentYYYY());
+	}
+	else if(varName == "build-YY")
+	{
+		outStr += dateTimeInfo.currentYY();
+		if(indent)
+			indentAmount.add_text(dateTimeInfo.currentYY());
+	}
+	else if(varName == "current-YYYY")
+	{ //this is left for backwards compatibility
+		outStr += dateTimeInfo.currentYYYY();
+		if(indent)
+			indentAmount.add_text(dateTimeInfo.currentYYYY());
+	}
+	else if(varName == "current-YY")
+	{ //this is left for backwards compatibility
+		outStr += dateTimeInfo.currentYY();
+		if(indent)
+			indentAmount.add_text(dateTimeInfo.currentYY());
+	}
+	else if(varName == "load-YYYY")
+	{
+		outStr += "<script>document.write(new Date().getFullYear())</script>";
+		if(indent)
+			indentAmount.add_spaces(57);
+	}
+	else if(varName == "load-YY")
+	{
+		outStr += "<script>document.write(new Date().getFullYear()%100)</script>";
+		if(indent)
+			indentAmount.add_spaces(61);
+	}
+	else if(varName == "build-OS")
+	{
+		outStr += dateTimeInfo.currentOS();
+		if(indent)
+			indentAmount.add_text(dateTimeInfo.currentOS());
+	}
+	else if(varName == "current-OS")
+	{ //this is left for backwards compatibility
+		outStr += dateTimeInfo.currentOS();
+		if(indent)
+			indentAmount.add_text(dateTimeInfo.currentOS());
+	}
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "$[" << varName << "]: no typedef, funcdef or variable named " << quote(varName) << std::endl;
+		os_mtx->unlock();
+		return 1;
 
-								if(parse_replace('f', parsedCondition, "if/else-if condition", readPath, antiDepsOfReadPath, conditionLineNo, "if(" + params[0] + ")", sLineNo, eos))
-									return 1;
+		/*outStr += "@";
+		linePos = sLinePos;
+		if(indent)
+			indentAmount += ' ';*/
+	}
 
-								if(replace_var(parsedCondition, readPath, conditionLineNo, "if/else-if", eos))
-									return 1;
+	return 0;
+}
 
-								if(!get_bool(result, parsedCondition))
-								{
-									if(parsedCondition != "" && expr.compile(parsedCondition))
-										result = expr.evaluate();
-									else
-									{
-										if(!consoleLocked)
-											os_mtx->lock();
-										start_err(eos, readPath, conditionLineNo) << "if/else-if: cannot convert " << quote(parsedCondition) << " to bool" << std::endl;
-										start_err(eos, readPath, conditionLineNo) << "if/else-if: possible errors from ExprTk:" << std::endl;
-										print_exprtk_parser_errs(eos, expr.parser, expr.expr_str, readPath, sLineNo);
-										os_mtx->unlock();
-										return 1;
-									}
-								}
-							}
-						}
-					}
-				}
-				else
-					result = 1;
+int Parser::builtin_input(FnCall& call)
+{
+	const char& lang = call.lang;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	std::string inputPathStr = params[0];
+	bool ifExists = 0, inputRaw = 0, noIndent = 0;
+	ProfileSpan inputSpan("@input", "input", inputPathStr);
+	char inpLang = lang;
+
+	Indent oldIndent = indentAmount;
+	if(noIndent)
+		indentAmount.clear();
 
-				if(result)
-				{
-					if(addOut)
-						addWhitespace = 1;
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "f++")
+				inpLang = 'f';
+			else if(options[o] == "n++")
+				inpLang = 'n';
+			else if(options[o] == "raw")
+				inputRaw = 1;
+			else if(options[o] == "if-exists")
+				ifExists = 1;
+			else if(options[o] == "!i" || options[o] == "!indent")
+				noIndent = 1;
+		}
+	}
 
-					if(addScope)
-					{
-						std::string cScope = vars.layers[vars.layers.size()-1].scope;
-						vars.add_layer(cScope);
-						//vars.add_layer(vars.layers[vars.layers.size()-1].scope); //this is broken on windows!
-					}
+	if(!file_exists(inputPathStr)) 
+	{
+		if(file_exists(readPath.dir + inputPathStr))
+			inputPathStr = readPath.dir + inputPathStr;
+		else if(ifExists) 
+		{
+			skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-					int ret_val;
-					if(iLang == 'n')
-						ret_val = n_read_and_process_fast(1, addOut, blocks[b], bLineNos[b]-1, readPath, antiDepsOfReadPath, outStr, eos);
-					else
-						ret_val = f_read_and_process_fast(addOut, blocks[b], bLineNos[b]-1, readPath, antiDepsOfReadPath, outStr, eos);
+			if(noIndent)
+				indentAmount = oldIndent;
 
-					if(addScope)
-						vars.layers.pop_back();
+			return 0;
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			if(funcName == "input")
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "inputting file " << c_purple << params[0] << c_white << " failed as path does not exist" << std::endl;
+			else
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "injecting file " << c_purple << params[0] << c_white << " failed as path does not exist" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-					if(ret_val == NSM_BREAK)
-						return NSM_BREAK;
-					else if(ret_val)
-						return ret_val;
+	Path inputPath;
+	inputPath.set_file_path_from(inputPathStr);
 
-					break;
-				}
-			}
+	record_dep_hash(inputPath);
+	depFiles.insert(inputPath);
 
-			if(addWhitespace)
-			{
-				std::istringstream iss(whitespace);
-				std::string str, oldLine;
-				int fileLineNo = 0;
+	if(inputPath == toBuild.contentPath)
+		contentAdded = 1;
 
-				while(!iss.eof())
-				{
-					getline(iss, str);
-					if(0 < fileLineNo++)
-						outStr += "\n" + baseIndentAmount;
-					outStr += str;
-					oldLine = str;
-				}
-				if(indent)
-					indentAmount += into_whitespace(oldLine);
-			}
+	if(!inputRaw)
+	{
+		//ensures insert file isn't an anti dep of read path
+		if(antiDepsOfReadPath.count(inputPath))
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			if(funcName == "input")
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "inputting file " << c_purple << inputPath << c_white << " would result in an input loop" << std::endl;
+			else
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "injecting file " << c_purple << inputPath << c_white << " would result in an input loop" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			return 0;
+		std::shared_ptr<const FileContents> fileContents = fileCache.get(inputPath.str());
+		if(!fileContents->ok)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to read file " << inputPath << std::endl;
+			os_mtx->unlock();
+			return 1;
 		}
-		else if(funcName == "is_const")
+		const std::string& fileStr = fileContents->str;
+
+		//adds insert file
+		if(inpLang == 'f')
 		{
-			if(params.size() != 1)
+			if(f_read_and_process(1, fileStr, 0, inputPath, antiDepsOfReadPath, outStr, eos) > 0)
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "is_const: expected 1 parameter, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << "(" << inputPath << ") failed" << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+		}
+		//partials input by many pages are split once, content files are only input once
+		else if((inputPath == toBuild.contentPath ? 
+		         n_read_and_process(1, fileStr, 0, inputPath, antiDepsOfReadPath, outStr, eos) : 
+		         n_read_and_process(1, *templateCache.get(inputPath.str(), fileContents, *this), 0, inputPath, antiDepsOfReadPath, outStr, eos)) > 0)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << "(" << inputPath << ") failed" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
+	else
+	{
+		std::ifstream ifs(inputPath.str());
+		std::string fileLine, oldLine;
+		int fileLineNo = 0;
 
-			VPos vpos;
-
-			if(vars.find(params[0], vpos))
-			{
-				if(addOutput)
-				{
-					if(vars.layers[vpos.layer].constants.count(params[0]))
-						outStr += "1";
-					else
-						outStr += "0";
+		while(!ifs.eof())
+		{
+			getline(ifs, fileLine);
+			if(0 < fileLineNo++)
+				add_newline(outStr, indentAmount);
+			oldLine = fileLine;
+			outStr += fileLine;
+		}
+		indentAmount.add_text(oldLine);
 
-					if(indent)
-						indentAmount += " ";
-				}
-			}
-			else
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "is_const: no variables or functions named " << c_light_blue << params[0] << c_white << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+		ifs.close();
+	}
 
-			return 0;
-		}
-		else if(funcName == "is_private")
-		{
-			if(params.size() != 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "is_private: expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	if(noIndent)
+		indentAmount = oldIndent;
 
-			VPos vpos;
+	return 0;
+}
 
-			if(vars.find(params[0], vpos))
-			{
-				if(addOutput)
-				{
-					if(vars.layers[vpos.layer].privates.count(params[0]))
-						outStr += "1";
-					else
-						outStr += "0";
+int Parser::builtin_item(FnCall& call)
+{
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
 
-					if(indent)
-						indentAmount += " ";
-				}
-			}
-			else
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "is_private: no variables or functions named " << c_light_blue << params[0] << c_white << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	std::string item;
+	int itemLineNo = lineNo;
 
-			return 0;
+	if(read_block(item, linePos, inStr, readPath, lineNo, itemLineNo, funcName, eos))
+		   return 1;
+
+	pagesInfo.items.push_back(item);
+	pagesInfo.itemLineNos.push_back(itemLineNo);
+	pagesInfo.itemCallLineNos.push_back(sLineNo);
+	pagesInfo.itemCallPaths.push_back(readPath);
+
+	//skip_whitespace(0, inStr, lineNo, linePos, readPath, funcNmae, eos);
+
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+
+	return 0;
+}
+
+int Parser::builtin_include(FnCall& call)
+{
+	const char& lang = call.lang;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size() == 0)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "include: no files specified to include" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	char incLang = lang;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); ++o)
+		{
+			if(options[o] == "f++")
+				incLang = 'f';
+			else if(options[o] == "n++")
+				incLang = 'n';
 		}
-		else if(funcName == "imginclude")
+	}
+
+	Path inputPath;
+	std::string includeOutput;
+	Indent oldIndent = indentAmount;
+
+	for(size_t p=0; p<params.size(); p++)
+	{
+		inputPath.set_file_path_from(params[p]);
+
+		if(!includedFiles.count(inputPath))
 		{
-			if(params.size() != 1)
+			includedFiles.insert(inputPath);
+
+			if(!file_exists(params[p]))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "imginclude: expected 1 parameter, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "include: including file " << inputPath << " failed as path does not exist" << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
 
-			std::string imgPathStr = params[0];
-			Path imgPath;
-			imgPath.set_file_path_from(imgPathStr);
-
-			//warns user if img file doesn't exist
-			if(!file_exists(imgPathStr.c_str()))
+			//ensures insert file isn't an anti dep of read path
+			if(antiDepsOfReadPath.count(inputPath))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_warn(eos, readPath, lineNo) << "imginclude: image file " << imgPath << " does not exist" << std::endl;
-				if(!consoleLocked)
-					os_mtx->unlock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "include: including file " << inputPath << " would result in an input loop" << std::endl;
+				os_mtx->unlock();
+				return 1;
 			}
 
-			Path pathToIMGFile(pathBetween(toBuild.outputPath.dir, imgPath.dir), imgPath.file);
-
-			std::string imgInclude = "<img src=\"" + pathToIMGFile.str() + "\"";
-			if(options.size())
-				for(size_t o=0; o<options.size(); ++o)
-					imgInclude += " " + options[o];
-			imgInclude += ">";
-
-			outStr += imgInclude;
-			if(indent)
-				indentAmount += into_whitespace(imgInclude);
+			record_dep_hash(inputPath);
+			depFiles.insert(inputPath);
 
-			return 0;
-		}
-		else if(funcName == "in")
-		{
-			if(params.size() > 1)
+			std::shared_ptr<const FileContents> fileContents = fileCache.get(inputPath.str());
+			if(!fileContents->ok)
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				clear_console_line();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "in: expected 0 or 1 parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "include: failed to read file " << inputPath << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+			const std::string& fileStr = fileContents->str;
 
-			bool fromFile = 0, readBlock = 0, parseBlock = 1;
-			int bLineNo = lineNo;
-			std::string userInput, inputMsg;
-			if(params.size() > 0)
-				inputMsg = params[0];
-
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "b" || options[o] == "block")
-						readBlock = 1;
-					else if(options[o] == "!pb")
-						parseBlock = 0;
-					else if(options[o] == "from-file")
-						fromFile = 1;
-				}
-			}
-
-			if(readBlock)
+			//parses include file
+			indentAmount.clear();
+			if(incLang == 'f')
 			{
-				if(params.size() != 0)
+				if(f_read_and_process(0, fileStr, 0, inputPath, antiDepsOfReadPath, includeOutput, eos) > 0)
 				{
 					if(!consoleLocked)
 						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "in{block}: expected 0 parameters, got " << params.size() << std::endl;
+					start_err_ml(eos, readPath, sLineNo, lineNo) << "include(" << inputPath << ") failed" << std::endl;
 					os_mtx->unlock();
 					return 1;
 				}
-
-				if(read_block(inputMsg, linePos, inStr, readPath, lineNo, bLineNo, "in{block}", eos))
-				   return 1;
-
-				if(parseBlock && parse_replace(lang, inputMsg, "in block", readPath, antiDepsOfReadPath, bLineNo, "in{block}", sLineNo, eos))
-					return 1;
 			}
-
-			if(!fromFile)
+			else if(n_read_and_process(0, fileStr, 0, inputPath, antiDepsOfReadPath, includeOutput, eos) > 0)
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				if(inputMsg.size())
-					std::cout << inputMsg << std::endl;
-				getline(std::cin, userInput);
-				if(!consoleLocked)
-					os_mtx->unlock();
-
-				if(n_read_and_process_fast(0, userInput, 0, Path("", "user input"), antiDepsOfReadPath, outStr, eos) > 0)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "failed to parse user input" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "include(" << inputPath << ") failed" << std::endl;
+				os_mtx->unlock();
+				return 1;
 			}
-			else
-			{
-				std::string output_filename = ".@userfilein" + std::to_string(sys_counter++);
-				int result;
+		}
+	}
 
-				std::string contExtPath = ".nsm/" + outputDir + toBuild.name + ".ext";
+	indentAmount = oldIndent;
 
-				if(file_exists(contExtPath))
-				{
-					std::string ext;
-					std::ifstream ifs(contExtPath);
-					getline(ifs, ext);
-					ifs.close();
-					contExtPath += ext;
-				}
-				else
-					output_filename += contentExt;
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-				std::ofstream ofs(output_filename);
-				ofs << inputMsg;
-				ofs.close();
+	return 0;
+}
 
-				os_mtx->lock();
-				#if defined _WIN32 || defined _WIN64
-					result = system((winTextEditor + " " + output_filename).c_str());
-				#else  //*nix
-					result = system((unixTextEditor + " " + output_filename).c_str());
-				#endif
-				os_mtx->unlock();
+int Parser::builtin_if(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const Indent& baseIndentAmount = call.baseIndentAmount;
+	const char& lang = call.lang;
+	const bool& addOutput = call.addOutput;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	int& conditionLineNo = call.conditionLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	bool addScope = addScopeGlobal, addOut = addOutput, addWhitespace = 0;
+	char iLang = lang;
+	std::string block, parsedCondition, whitespace;
+	std::vector<std::string> blocks, conditions;
+	std::shared_ptr<const SegmentedText> segmentedBlock;
+	std::vector<std::shared_ptr<const SegmentedText> > segmentedBlocks;
+	std::vector<int> bLineNos, cLineNos;
+	int bLineNo = lineNo;
 
-				if(result)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "in{from-file}: text editor system call failed" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "f++")
+				iLang = 'f';
+			else if(options[o] == "n++")
+				iLang = 'n';
+			else if(options[o] == "o")
+				addOut = 1;
+			else if(options[o] == "!o")
+				addOut = 0;
+			if(options[o] == "s")
+				addScope = 1;
+			else if(options[o] == "!s")
+				addScope = 0;
+		}
+	}
 
-				if(!file_exists(output_filename))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "in{from-file}: user did not save file" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	if(linePos >= inStr.size())
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "if: no proceeding block" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-				Path inputPath;
-				inputPath.set_file_path_from(output_filename);
-				//ensures insert file isn't an anti dep of read path
-				if(antiDepsOfReadPath.count(inputPath))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "in{from-file}: inputting file " << inputPath << " would result in an input loop" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	if(read_block(block, segmentedBlock, linePos, inStr, call.segmented, readPath, lineNo, bLineNo, "if(" + params[0] + ")", eos))
+		return 1;
 
-				std::string fileStr = string_from_file(inputPath.str());
+	conditions.push_back(params[0]);
+	cLineNos.push_back(conditionLineNo);
+	blocks.push_back(block);
+	segmentedBlocks.push_back(segmentedBlock);
+	bLineNos.push_back(bLineNo);
 
-				//adds insert file
-				if(n_read_and_process_fast(1, fileStr, 0, inputPath, antiDepsOfReadPath, outStr, eos) > 0)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "in{from-file}: failed to parse input user saved to file" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-				//indent amount updated inside read_and_process
+	if(read_else_blocks(conditions, cLineNos, blocks, segmentedBlocks, bLineNos, whitespace, linePos, inStr, call.segmented, readPath, lineNo, "if(" + params[0] + ")", eos))
+		return 1;
 
-				remove_file(Path("", output_filename));
-			}
+	bool result;
 
-			return 0;
-		}
-	}
-	else if(funcName[0] == 'l')
+	for(size_t b=0; b<blocks.size(); b++)
 	{
-		if(funcName == "lua")
+		if(b < conditions.size())
 		{
-			if(params.size() > 1)
+			if(!get_bool(result, conditions[b]))
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "lua: expected 0-1 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+				VPos vpos;
+				if(vars.find(conditions[b], vpos)) {
+					vars.get_bool_from_var(vpos, result);
+				}
+				else {
+					if(conditions[b] != "" && expr.compile(conditions[b])) {
+						result = expr.evaluate();
+					}
+					else
+					{
+						parsedCondition = conditions[b];
 
-			int bLineNo = lineNo;
-			bool blockOpt = 0, parseBlock = 0, addOut = addOutput;
+						if(parse_replace('f', parsedCondition, "if/else-if condition", readPath, antiDepsOfReadPath, conditionLineNo, "if(" + params[0] + ")", sLineNo, eos))
+							return 1;
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "pb")
-						parseBlock = 1;
-					else if(options[o] == "o")
-						addOut = 1;
-					else if(options[o] == "!o")
-						addOut = 0;
+						if(replace_var(parsedCondition, readPath, conditionLineNo, "if/else-if", eos))
+							return 1;
+
+						if(!get_bool(result, parsedCondition))
+						{
+							if(parsedCondition != "" && expr.compile(parsedCondition))
+								result = expr.evaluate();
+							else
+							{
+								if(!consoleLocked)
+									os_mtx->lock();
+								start_err(eos, readPath, conditionLineNo) << "if/else-if: cannot convert " << quote(parsedCondition) << " to bool" << std::endl;
+								start_err(eos, readPath, conditionLineNo) << "if/else-if: possible errors from ExprTk:" << std::endl;
+								print_exprtk_parser_errs(eos, expr.errors(), expr.expr_str, readPath, sLineNo);
+								os_mtx->unlock();
+								return 1;
+							}
+						}
+					}
 				}
 			}
+		}
+		else
+			result = 1;
 
-			bool fromFile = 0;
+		if(result)
+		{
+			if(addOut)
+				addWhitespace = 1;
 
-			if(!params.size())
+			if(addScope)
 			{
-				blockOpt = 1;
-				params.push_back("");
-				if(read_block(params[0], linePos, inStr, readPath, lineNo, bLineNo, "lua{block}", eos))
-					return 1;
-
-				if(parseBlock && parse_replace(lang, params[0], "lua block", readPath, antiDepsOfReadPath, bLineNo, "lua{block}", sLineNo, eos))
-					return 1;
+				std::string cScope = vars.layers[vars.layers.size()-1].scope;
+				vars.add_layer(cScope);
+				//vars.add_layer(vars.layers[vars.layers.size()-1].scope); //this is broken on windows!
 			}
-			else if(params.size())
-			{
-				fromFile = 1;
 
-				if(!file_exists(params[0]))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "lua: file " << params[0] << " does not exist" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
+			int ret_val;
+			if(iLang == 'n' && segmentedBlocks[b])
+				ret_val = n_read_and_process_fast(1, addOut, segmentedBlocks[b]->text, segmentedBlocks[b].get(), bLineNos[b]-1, readPath, antiDepsOfReadPath, outStr, eos);
+			else if(iLang == 'n')
+				ret_val = n_read_and_process_fast(1, addOut, blocks[b], bLineNos[b]-1, readPath, antiDepsOfReadPath, outStr, eos);
+			else
+				ret_val = f_read_and_process_fast(addOut, blocks[b], bLineNos[b]-1, readPath, antiDepsOfReadPath, outStr, eos);
 
-			//makes sure lua is initialised
-			if(!lua.initialised)
-				lua.init();
+			if(addScope)
+				vars.layers.pop_back();
 
-			int result = (fromFile) ? luaL_dofile(lua.L, params[0].c_str()) : luaL_dostring(lua.L, params[0].c_str());
+			if(ret_val == NSM_BREAK)
+				return NSM_BREAK;
+			else if(ret_val)
+				return ret_val;
 
-			if(result)
-			{
-				std::string errStr = lua_tostring(lua.L, -1);
-				int errLineNo = sLineNo;
-				if(blockOpt)
-					errLineNo = bLineNo;
-				process_lua_error(errStr, errLineNo);
+			break;
+		}
+	}
 
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err(eos, readPath, errLineNo) << "lua: " << errStr << std::endl;
-				os_mtx->unlock();
-			}
+	if(addWhitespace)
+	{
+		std::istringstream iss(whitespace);
+		std::string str, oldLine;
+		int fileLineNo = 0;
 
-			if(addOut)
-			{
-				std::string resultStr = std::to_string(result);
-				outStr += resultStr;
-				if(indent)
-					indentAmount += into_whitespace(resultStr);
-			}
-
-			return result;
-		}
-		else if(funcName.substr(0, 4) == "lua_")
+		while(!iss.eof())
 		{
-			std::string luaFnName = funcName.substr(4, funcName.size()-4);
+			getline(iss, str);
+			if(0 < fileLineNo++)
+				add_newline(outStr, baseIndentAmount);
+			outStr += str;
+			oldLine = str;
+		}
+		if(indent)
+			indentAmount.add_text(oldLine);
+	}
 
-			//makes sure lua is initialised
-			if(!lua.initialised)
-				lua.init();
+	return 0;
+}
 
-			if(luaFnName == "addnsmfns")
-			{
-				if(params.size() != 0)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 0 parameters, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+int Parser::builtin_is_const(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const bool& addOutput = call.addOutput;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
 
-				lua_addnsmfns();
+	VPos vpos;
 
-				return 0;
-			}
-			else if(luaFnName == "gettop")
-			{
-				if(params.size() != 0)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 0 parameters, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	if(vars.find(params[0], vpos))
+	{
+		if(addOutput)
+		{
+			if(vars.layers[vpos.layer].constants.count(params[0]))
+				outStr += "1";
+			else
+				outStr += "0";
 
-				std::string val = std::to_string(lua_gettop(lua.L));
+			if(indent)
+				indentAmount += ' ';
+		}
+	}
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "is_const: no variables or functions named " << c_light_blue << params[0] << c_white << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-				outStr += val;
-				if(indent)
-					indentAmount += into_whitespace(val);
+	return 0;
+}
 
-				return 0;
-			}
-			else if(luaFnName == "getglobal")
-			{
-				if(params.size() != 1)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+int Parser::builtin_is_private(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const bool& addOutput = call.addOutput;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
 
-				lua_getglobal(lua.L, params[0].c_str());
+	VPos vpos;
 
-				return 0;
-			}
-			else if(luaFnName == "setglobal")
-			{
-				if(params.size() != 1)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	if(vars.find(params[0], vpos))
+	{
+		if(addOutput)
+		{
+			if(vars.layers[vpos.layer].privates.count(params[0]))
+				outStr += "1";
+			else
+				outStr += "0";
 
-				lua_setglobal(lua.L, params[0].c_str());
+			if(indent)
+				indentAmount += ' ';
+		}
+	}
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "is_private: no variables or functions named " << c_light_blue << params[0] << c_white << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-				return 0;
-			}
-			else if(luaFnName == "pop")
-			{
-				if(!params.size())
-				{
-					lua_pop(lua.L, 1);
-					return 0;
-				}
+	return 0;
+}
 
-				if(params.size() > 1)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 0-1 parameters, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-				else if(!isInt(params[0]))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": number of stack items to remove from top should be an integer, got " << params[0] << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+int Parser::builtin_imginclude(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	std::string imgPathStr = params[0];
+	Path imgPath;
+	imgPath.set_file_path_from(imgPathStr);
+
+	//warns user if img file doesn't exist
+	if(!file_exists(imgPathStr.c_str()))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_warn(eos, readPath, lineNo) << "imginclude: image file " << imgPath << " does not exist" << std::endl;
+		if(!consoleLocked)
+			os_mtx->unlock();
+	}
 
-				lua_pop(lua.L, std::atoi(params[0].c_str()));
+	Path pathToIMGFile(pathBetween(toBuild.outputPath.dir, imgPath.dir), imgPath.file);
 
-				return 0;
-			}
-			else if(luaFnName == "remove")
-			{
-				if(params.size() != 1)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-				else if(!isInt(params[0]))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": stack index parameter should be an integer, got " << params[0] << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	std::string imgInclude = "<img src=\"" + pathToIMGFile.str() + "\"";
+	if(options.size())
+		for(size_t o=0; o<options.size(); ++o)
+			imgInclude += " " + options[o];
+	imgInclude += ">";
 
-				lua_remove(lua.L, std::atoi(params[0].c_str()));
+	outStr += imgInclude;
+	if(indent)
+		indentAmount.add_text(imgInclude);
 
-				return 0;
-			}
-			else if(luaFnName == "tonumber")
-			{
-				if(params.size() != 1)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-				else if(!isInt(params[0]))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": stack index parameter should be an integer, got " << params[0] << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	return 0;
+}
 
-				int i = std::atoi(params[0].c_str());
+int Parser::builtin_in(FnCall& call)
+{
+	const char& lang = call.lang;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size() > 1)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		clear_console_line();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "in: expected 0 or 1 parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-				if(lua_type(lua.L, i) == LUA_TNUMBER)
-				{
-					std::string val = std::to_string(lua_tonumber(lua.L, i));
+	bool fromFile = 0, readBlock = 0, parseBlock = 1;
+	int bLineNo = lineNo;
+	std::string userInput, inputMsg;
+	if(params.size() > 0)
+		inputMsg = params[0];
 
-					outStr += val;
-					if(indent)
-						indentAmount += into_whitespace(val);
-				}
-				else
-				{
-					if(lua_gettop(lua.L) < abs(i))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "lua_tonumber(" << i << "): Lua stack has " << lua_gettop(lua.L) << " elements" << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-					else
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "lua_tonumber: item number " << params[0] << " on Lua stack is not a number" << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "b" || options[o] == "block")
+				readBlock = 1;
+			else if(options[o] == "!pb")
+				parseBlock = 0;
+			else if(options[o] == "from-file")
+				fromFile = 1;
+		}
+	}
 
-				return 0;
-			}
-			else if(luaFnName == "tostring")
-			{
-				if(params.size() != 1)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-				else if(!isInt(params[0]))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": stack index parameter should be an integer, got " << params[0] << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	if(readBlock)
+	{
+		if(params.size() != 0)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "in{block}: expected 0 parameters, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-				int i = std::atoi(params[0].c_str());
+		if(read_block(inputMsg, linePos, inStr, readPath, lineNo, bLineNo, "in{block}", eos))
+		   return 1;
 
-				if(lua_type(lua.L, i) == LUA_TSTRING)
-				{
-					std::string val = std::string(lua_tostring(lua.L, i));
+		if(parseBlock && parse_replace(lang, inputMsg, "in block", readPath, antiDepsOfReadPath, bLineNo, "in{block}", sLineNo, eos))
+			return 1;
+	}
 
-					outStr += val;
-					if(indent)
-						indentAmount += into_whitespace(val);
-				}
-				else
-				{
-					if(lua_gettop(lua.L) < abs(i))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "lua_tostring(" << i << "): Lua stack has " << lua_gettop(lua.L) << " elements" << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-					else
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "lua_tostring: item number " << params[0] << " on Lua stack is not a string" << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
+	if(!fromFile)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		if(inputMsg.size())
+			std::cout << inputMsg << std::endl;
+		getline(std::cin, userInput);
+		if(!consoleLocked)
+			os_mtx->unlock();
 
-				return 0;
-			}
-			else if(luaFnName == "pushlightuserdata")
-			{
-				if(params.size() != 1)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+		if(n_read_and_process_fast(0, userInput, 0, Path("", "user input"), antiDepsOfReadPath, outStr, eos) > 0)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "failed to parse user input" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
+	else
+	{
+		std::string output_filename = ".@userfilein" + std::to_string(sys_counter++);
+		int result;
 
-				VPos vpos;
-				if(vars.find(params[0], vpos))
-				{
-					if(vpos.type == "bool" || vpos.type == "int" || vpos.type == "double" || vpos.type == "std::double")
-						lua_pushlightuserdata(lua.L, &vars.layers[vpos.layer].doubles[vpos.name]);
-					else if(vpos.type == "char" || vpos.type == "string" || vpos.type == "std::string")
-						lua_pushlightuserdata(lua.L, &vars.layers[vpos.layer].strings[vpos.name]);
-					else if(vpos.type == "std::bool")
-						lua_pushlightuserdata(lua.L, &vars.layers[vpos.layer].bools[vpos.name]);
-					else if(vpos.type == "std::int")
-						lua_pushlightuserdata(lua.L, &vars.layers[vpos.layer].ints[vpos.name]);
-					else if(vpos.type == "std::char")
-						lua_pushlightuserdata(lua.L, &vars.layers[vpos.layer].chars[vpos.name]);
-					else if(vpos.type == "std::llint")
-						lua_pushlightuserdata(lua.L, &vars.layers[vpos.layer].llints[vpos.name]);
-					else if(vpos.type == "std::vector<double>")
-						lua_pushlightuserdata(lua.L, &vars.layers[vpos.layer].doubVecs[vpos.name]);
-					else if(vpos.type == "std::vector<string>")
-						lua_pushlightuserdata(lua.L, &vars.layers[vpos.layer].strVecs[vpos.name]);
-					else if(vpos.type == "fstream")
-						lua_pushlightuserdata(lua.L, &vars.layers[vpos.layer].fstreams[vpos.name]);
-					else if(vpos.type == "ifstream")
-						lua_pushlightuserdata(lua.L, &vars.layers[vpos.layer].ifstreams[vpos.name]);
-					else if(vpos.type == "ofstream")
-						lua_pushlightuserdata(lua.L, &vars.layers[vpos.layer].ofstreams[vpos.name]);
-					else if(vpos.type == "function" || vpos.type == "fn")
-						lua_pushlightuserdata(lua.L, &vars.layers[vpos.layer].functions[vpos.name]);
-					else
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": do not recognise the type " << quote(vpos.type) << " for " << quote(params[0]) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": no variables named " << quote(params[0]) << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-
-				return 0;
-			}
-			else if(luaFnName == "pushnumber")
-			{
-				if(params.size() != 1)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-				else if(!isDouble(params[0]))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": parameter to push on to Lua stack should be a double, got " << params[0] << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-
-				lua_pushnumber(lua.L, std::strtod(params[0].c_str(), NULL));
+		std::string contExtPath = ".nsm/" + outputDir + toBuild.name + ".ext";
 
-				return 0;
-			}
-			else if(luaFnName == "pushstring")
-			{
-				if(params.size() != 1)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+		if(file_exists(contExtPath))
+		{
+			std::string ext;
+			std::ifstream ifs(contExtPath);
+			getline(ifs, ext);
+			ifs.close();
+			contExtPath += ext;
+		}
+		else
+			output_filename += contentExt;
 
-				lua_pushstring(lua.L, params[0].c_str());
+		std::ofstream ofs(output_filename);
+		ofs << inputMsg;
+		ofs.close();
 
-				return 0;
-			}
-			else if(luaFnName == "version")
-			{
-				if(params.size() != 0)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 0 parameters, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+		os_mtx->lock();
+		#if defined _WIN32 || defined _WIN64
+			result = system((winTextEditor + " " + output_filename).c_str());
+		#else  //*nix
+			result = system((unixTextEditor + " " + output_filename).c_str());
+		#endif
+		os_mtx->unlock();
 
-				lua_getglobal(lua.L, "_VERSION");
+		if(result)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "in{from-file}: text editor system call failed" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-				if(lua_type(lua.L, -1) == LUA_TSTRING)
-				{
-					std::string val = std::string(lua_tostring(lua.L, -1));
+		if(!file_exists(output_filename))
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "in{from-file}: user did not save file" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-					outStr += val;
-					if(indent)
-						indentAmount += into_whitespace(val);
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "lua_tostring: item number " << params[0] << " on Lua stack is not a string" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+		Path inputPath;
+		inputPath.set_file_path_from(output_filename);
+		//ensures insert file isn't an anti dep of read path
+		if(antiDepsOfReadPath.count(inputPath))
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "in{from-file}: inputting file " << inputPath << " would result in an input loop" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-				lua_pop(lua.L, 1);
+		std::string fileStr = string_from_file(inputPath.str());
 
-				return 0;
-			}
-			else
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": function does not exist in this scope" << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-		}
-		else if(funcName == "link")
+		//adds insert file
+		if(n_read_and_process_fast(1, fileStr, 0, inputPath, antiDepsOfReadPath, outStr, eos) > 0)
 		{
-			if(params.size() != 1 && params.size() != 2)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "link: expected 1-2 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
-			if(params.size() == 1)
-				params.push_back(params[0]);
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "in{from-file}: failed to parse input user saved to file" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+		//indent amount updated inside read_and_process
 
-			std::string str;
-			int langOpt = 0;
+		remove_file(Path("", output_filename));
+	}
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); ++o)
-				{
-					if(options[o] == "html")
-						langOpt = 0;
-					else if(options[o] == "md")
-						langOpt = 1;
-				}
-			}
-			
+	return 0;
+}
 
-			if(langOpt == 0)
-				str = "<a href=\"" + params[0] + "\">" + params[1] + "</a>";
-			else if(langOpt == 1)
-				str = "[" + params[1] + "](" + params[0] + ")";
+int Parser::builtin_lua(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const char& lang = call.lang;
+	const bool& addOutput = call.addOutput;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	ProfileSpan builtinSpan("@lua", "builtin");
+
+	if(params.size() > 1)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "lua: expected 0-1 parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-			outStr += str;
-			if(indent)
-				indentAmount += into_whitespace(str);
+	int bLineNo = lineNo;
+	bool blockOpt = 0, parseBlock = 0, addOut = addOutput;
 
-			return 0;
-		}
-		else if(funcName == "layer")
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
 		{
-			if(params.size() > 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "layer: expected 0-1 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+			if(options[o] == "pb")
+				parseBlock = 1;
+			else if(options[o] == "o")
+				addOut = 1;
+			else if(options[o] == "!o")
+				addOut = 0;
+		}
+	}
 
-			if(params.size() == 0)
-			{
-				outStr += std::to_string(vars.layers.size()-1);
-				if(indent)
-					indentAmount += into_whitespace(std::to_string(vars.layers.size()-1));
-			}
-			else if(params.size() == 1)
-			{
-				VPos vpos;
+	bool fromFile = 0;
 
-				if(vars.find(params[0], vpos))
-				{
-					outStr += std::to_string(vpos.layer);
-					if(indent)
-						indentAmount += into_whitespace(std::to_string(vpos.layer));
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "layer: no variables/functions named " << params[0] << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
+	if(!params.size())
+	{
+		blockOpt = 1;
+		params.push_back("");
+		if(read_block(params[0], linePos, inStr, readPath, lineNo, bLineNo, "lua{block}", eos))
+			return 1;
 
-			return 0;
-		}
-		#if defined _WIN32 || defined _WIN64
-			else if(funcName == "ls")
-				funcName = "dir";
-		#endif
-		else if(funcName == "lst")
-		{
-			if(params.size() < 1)
-			{
-				if(read_sh_params(params, ' ', linePos, inStr, readPath, lineNo, funcName, eos))
-					return 1;
-			}
+		if(parseBlock && parse_replace(lang, params[0], "lua block", readPath, antiDepsOfReadPath, bLineNo, "lua{block}", sLineNo, eos))
+			return 1;
+	}
+	else if(params.size())
+	{
+		fromFile = 1;
 
-			if(params.size() == 0)
-				params.push_back("./");
-			else if(params.size() > 1) 
-			{
-				for(size_t p=0; p+1<params.size(); ++p)
-					options.push_back(params[p]);
-				params = std::vector<std::string>(1, params[params.size()-1]);
-			}
+		if(!file_exists(params[0]))
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "lua: file " << params[0] << " does not exist" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-			params[0] = replace_home_dir(params[0]);
+	//makes sure lua is initialised
+	if(!lua.pageInitialised)
+		lua.init();
 
-			std::string separator = " ";
-			std::vector<std::string> shOptions;
-			size_t pos = params[0].find_first_of('*');
-			bool hasUnknownOptions = 0;
-			bool toConsole = 0;
-			bool incHidden = 0;
-			bool fullPath = 0;
+	int result = (fromFile) ? luaL_dofile(lua.L, params[0].c_str()) : lua.do_chunk(params[0]);
 
-			if(lolcatActive)
-				toConsole = 0;
-			else if((mode == MODE_INTERP || mode == MODE_SHELL) && (&outStr == &parsedText))
-				toConsole = 1;
+	if(result)
+	{
+		std::string errStr = lua_tostring(lua.L, -1);
+		int errLineNo = sLineNo;
+		if(blockOpt)
+			errLineNo = bLineNo;
+		process_lua_error(errStr, errLineNo);
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); ++o)
-				{
-					if(options[o] == "1")
-						separator = "\n";
-					else if(options[o] == ",")
-						separator = ", ";
-					else if(options[o] == "a")
-						incHidden = 1;
-					else if(options[o] == "!c")
-						toConsole = 0;
-					else if(options[o] == "c")
-						toConsole = 1;
-					else if(options[o] == "P")
-						fullPath = 1;
-					else if(options[o] == "!p" || options[o] == "!v" || options[o] == "1p")
-					{}
-					else
-					{
-						hasUnknownOptions = 1;
-						shOptions.push_back(options[o]);
-					}
-				}
-			}
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err(eos, readPath, errLineNo) << "lua: " << errStr << std::endl;
+		os_mtx->unlock();
+	}
 
-			if(!hasUnknownOptions && params.size() == 1 && (pos == std::string::npos || pos == params[0].size()-1))
-			{
-				std::set<std::string> paths;
-				Path lsPath;
+	if(addOut)
+	{
+		std::string resultStr = std::to_string(result);
+		outStr += resultStr;
+		if(indent)
+			indentAmount.add_text(resultStr);
+	}
 
-				if(pos == params[0].size()-1)
-				{
-					params[0] = params[0].substr(0, params[0].size()-1);
-					lsPath.set_file_path_from(params[0].c_str());
-					makeSearchable(lsPath);
+	return result;
+}
 
-					if(fullPath)
-					{
-						std::string dir;
-						std::set<std::string> lsPaths = lsSetStar(lsPath, incHidden);
-						size_t pos;
-
-						if(params[0].size() && 
-						   params[0][params[0].size()-1] != '/' && 
-						   params[0][params[0].size()-1] != '\\' && 
-						   dir_exists(params[0]))
-						{
-							pos = params[0].size();
-							params[0] += "/";
-						}
-						else
-							pos = params[0].find_last_of("/\\");
+int Parser::builtin_lua_api(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& params = call.params;
+
+	std::string luaFnName = funcName.substr(4, funcName.size()-4);
+
+	//makes sure lua is initialised
+	if(!lua.pageInitialised)
+		lua.init();
 
-						if(pos != std::string::npos)
-							dir = params[0].substr(0, pos+1);
+	if(luaFnName == "addnsmfns")
+	{
+		if(params.size() != 0)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 0 parameters, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-						for(auto path=lsPaths.begin(); path!=lsPaths.end(); ++path)
-							paths.insert(dir + *path);
-					}
-					else
-						paths = lsSetStar(lsPath, incHidden);
+		lua_addnsmfns();
 
-					if(!paths.size())
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "lst: cannot access " << quote(params[0]) << ": no such file or directory" << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-				else if(pos == std::string::npos)
-				{
-					if(!path_exists(params[0]))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "lst: cannot access " << quote(params[0]) << ": no such file or directory" << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-					else if(params[0].find_last_of("/\\") != params[0].size()-1 && dir_exists(params[0]))
-						params[0] += "/";
+		return 0;
+	}
+	else if(luaFnName == "gettop")
+	{
+		if(params.size() != 0)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 0 parameters, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-					lsPath.set_file_path_from(params[0].c_str());
-					makeSearchable(lsPath);
-					if(dir_exists(lsPath.str()))
-					{
-						if(fullPath)
-						{
-							std::string dir;
-							std::set<std::string> lsPaths = lsSetStar(lsPath, incHidden);
-							size_t pos;
-
-							if(params[0].size() && 
-							   params[0][params[0].size()-1] != '/' && 
-							   params[0][params[0].size()-1] != '\\' && 
-							   dir_exists(params[0]))
-							{
-								pos = params[0].size();
-								params[0] += "/";
-							}
-							else
-								pos = params[0].find_last_of("/\\");
+		std::string val = std::to_string(lua_gettop(lua.L));
 
-							if(pos != std::string::npos)
-								dir = params[0].substr(0, pos+1);
+		outStr += val;
+		if(indent)
+			indentAmount.add_text(val);
 
-							for(auto path=lsPaths.begin(); path!=lsPaths.end(); ++path)
-								paths.insert(dir + *path);
-						}
-						else
-							paths = lsSetStar(lsPath, incHidden);
-					}
-					else if(file_exists(lsPath.str()))
-					{
-						lsPath.dir = lsPath.file = "";
-						paths.insert(params[0]);
-					}
-				}
-				
-
-				if(toConsole)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					if(fullPath)
-						coutPaths("", paths, separator, 1, 0);
-					else
-						coutPaths(lsPath.dir, paths, separator, 1, 0);
-					std::cout << std::endl;
-					if(!consoleLocked)
-						os_mtx->unlock();
-
-					if(linePos < inStr.size() && inStr[linePos] == '!')
-						++linePos;
-					else
-						skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
-				}
-				else if(paths.size())
-				{
-					auto path=paths.begin();
+		return 0;
+	}
+	else if(luaFnName == "getglobal")
+	{
+		if(params.size() != 1)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-					if(separator == "\n")
-					{
-						std::string endPath;
+		lua_getglobal(lua.L, params[0].c_str());
 
-						if(path->find_first_of(' ') == std::string::npos)
-							endPath = *path;
-						else
-							endPath = quote(*path);
-						outStr += endPath;
-						++path;
-						for(; path!=paths.end(); ++path)
-						{
-							if(path->find_first_of(' ') == std::string::npos)
-								endPath = *path;
-							else
-								endPath = quote(*path);
-							outStr += "\n" + indentAmount + endPath;
-						}
+		return 0;
+	}
+	else if(luaFnName == "setglobal")
+	{
+		if(params.size() != 1)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-						indentAmount += into_whitespace(endPath);
-					}
-					else
-					{
-						std::string lsStr;
-						if(path->find_first_of(' ') == std::string::npos)
-							lsStr = *path;
-						else
-							lsStr = quote(*path);
-						++path;
-						for(; path!=paths.end(); ++path)
-						{
-							if(path->find_first_of(' ') == std::string::npos)
-								lsStr += separator + *path;
-							else
-								lsStr += separator + quote(*path);
-						}
-						outStr += lsStr;
-						indentAmount += into_whitespace(lsStr);
-					}
-				}
-			}
-			else
-			{
-				#if defined _WIN32 || defined _WIN64
-					funcName = "dir /b"; 
-				#else  //*nix
-					funcName = "ls -d";
-				#endif
-				if(toConsole)
-					return try_system_call_console(funcName, shOptions, params, readPath, antiDepsOfReadPath, sLineNo, lineNo, eos, outStr);
-				else
-					return try_system_call_inject(funcName, shOptions, params, readPath, antiDepsOfReadPath, sLineNo, lineNo, eos, outStr);
-			}
+		lua_setglobal(lua.L, params[0].c_str());
 
+		return 0;
+	}
+	else if(luaFnName == "pop")
+	{
+		if(!params.size())
+		{
+			lua_pop(lua.L, 1);
 			return 0;
 		}
-		else if(funcName == "lolcat")
-		{
-			bool readBlock = 0, parseBlock = 1;
-			int bLineNo = lineNo;
-			std::string txt;
-
-			if(!lolcatInit && !lolcat_init(""))
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_warn(eos, readPath, sLineNo) << "could not find 'lolcat' installed on the machine" << std::endl;
-				if(!consoleLocked)
-					os_mtx->unlock();
-			}
-
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "b" || options[o] == "block")
-						readBlock = 1;
-					else if(options[o] == "!pb")
-						parseBlock = 0;
-				}
-			}
 
-			if(readBlock)
-			{
-				if(params.size() != 0)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "lolcat{block}: expected 0 parameters, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+		if(params.size() > 1)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 0-1 parameters, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+		else if(!isInt(params[0]))
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": number of stack items to remove from top should be an integer, got " << params[0] << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-				if(read_block(txt, linePos, inStr, readPath, lineNo, bLineNo, "lolcat", eos))
-				   return 1;
+		lua_pop(lua.L, std::atoi(params[0].c_str()));
 
-				if(parseBlock && parse_replace(lang, txt, "lolcat block", readPath, antiDepsOfReadPath, bLineNo, "lolcat", sLineNo, eos))
-					return 1;
-			}
+		return 0;
+	}
+	else if(luaFnName == "remove")
+	{
+		if(params.size() != 1)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+		else if(!isInt(params[0]))
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": stack index parameter should be an integer, got " << params[0] << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			VPos vpos;
-			std::string gIndentAmount;
-			for(size_t p=0; p<params.size(); p++)
-			{
-				if(params[p] == "endl")
-					txt += "\r\n";
-				else if(replaceVars && vars.find(params[p], vpos))
-				{
-					gIndentAmount = "";
-					if(!vars.add_str_from_var(vpos, txt, 1, indent, gIndentAmount))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "lolcat: cannot get string of var type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-				else
-					txt += params[p];
-			}
+		lua_remove(lua.L, std::atoi(params[0].c_str()));
 
+		return 0;
+	}
+	else if(luaFnName == "tonumber")
+	{
+		if(params.size() != 1)
+		{
 			if(!consoleLocked)
 				os_mtx->lock();
-			if(lolcatInit)
-				rnbwcout(txt);
-			else
-				eos << txt << std::endl;
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+		else if(!isInt(params[0]))
+		{
 			if(!consoleLocked)
-				os_mtx->unlock();
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": stack index parameter should be an integer, got " << params[0] << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			return 0;
+		int i = std::atoi(params[0].c_str());
+
+		if(lua_type(lua.L, i) == LUA_TNUMBER)
+		{
+			std::string val = std::to_string(lua_tonumber(lua.L, i));
+
+			outStr += val;
+			if(indent)
+				indentAmount.add_text(val);
 		}
-		else if(funcName == "lolcat.cmd")
+		else
 		{
-			if(params.size())
+			if(lua_gettop(lua.L) < abs(i))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "lolcat.cmd: expected 0 parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "lua_tonumber(" << i << "): Lua stack has " << lua_gettop(lua.L) << " elements" << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
-
-			outStr += lolcatCmd;
-
-			return 0;
-		}
-		else if(funcName == "lolcat.activate" || funcName == "lolcat.on")
-		{
-			if(params.size() > 1)
+			else
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "lolcat.on: expected 0-1 parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "lua_tonumber: item number " << params[0] << " on Lua stack is not a number" << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+		}
 
-			if(lolcatActive)
-			{
-				if(mode == MODE_INTERP || mode == MODE_SHELL)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					rnbwcout("lolcat already activated\a");
-					if(!consoleLocked)
-						os_mtx->unlock();
-				}
-
-				return 0;
-			}
-
-			if(params.size() == 1)
-				lolcatCmd = params[0];
-
-			if(!lolcatInit)
-			{
-				if(lolcat_init(lolcatCmd))
-				{
-					#if defined _WIN32 || defined _WIN64
-						if(using_powershell_colours())
-							lolcat_powershell();
-					#endif
-					lolcatActive = 1;
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					if(params.size() == 1)
-						start_warn(eos, readPath, sLineNo) << "could not find " << c_blue << lolcatCmd << c_white << " installed on the machine" << std::endl;
-					else
-						start_warn(eos, readPath, sLineNo) << "could not find 'lolcat' installed on the machine" << std::endl;
-					if(!consoleLocked)
-						os_mtx->unlock();
-				}
-			}
-			else
-			{
-				#if defined _WIN32 || defined _WIN64
-					if(using_powershell_colours())
-						lolcat_powershell();
-				#endif
-				lolcatActive = 1;
-			}
+		return 0;
+	}
+	else if(luaFnName == "tostring")
+	{
+		if(params.size() != 1)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+		else if(!isInt(params[0]))
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": stack index parameter should be an integer, got " << params[0] << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			if(lolcatActive && (mode == MODE_INTERP || mode == MODE_SHELL))
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				rnbwcout("lolcat activated using command " + quote(lolcatCmd));
-				if(!consoleLocked)
-					os_mtx->unlock();
-			}
+		int i = std::atoi(params[0].c_str());
 
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+		if(lua_type(lua.L, i) == LUA_TSTRING)
+		{
+			std::string val = std::string(lua_tostring(lua.L, i));
 
-			return 0;
+			outStr += val;
+			if(indent)
+				indentAmount.add_text(val);
 		}
-		else if(funcName == "lolcat.deactivate" || funcName == "lolcat.off")
+		else
 		{
-			if(params.size() != 0)
+			if(lua_gettop(lua.L) < abs(i))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "lolcat.off: expected 0 parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "lua_tostring(" << i << "): Lua stack has " << lua_gettop(lua.L) << " elements" << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
-
-			if(mode == MODE_INTERP || mode == MODE_SHELL)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				if(lolcatActive)
-					std::cout << "lolcat deactivated" << std::endl;
-				else
-					std::cout << "lolcat not activated\a" << std::endl;
-				if(!consoleLocked)
-					os_mtx->unlock();
-			}
-
-			lolcatActive = 0;
-
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
 			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
-
-			return 0;
-		}
-		else if(funcName == "lolcat.status")
-		{
-			if(params.size())
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "lolcat.status: expected 0 parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "lua_tostring: item number " << params[0] << " on Lua stack is not a string" << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
-
-			if(lolcatActive)
-				outStr += "lolcat is activated using " + quote(lolcatCmd);
-			else
-				outStr += "lolcat is not activated";
-
-			return 0;
 		}
+
+		return 0;
 	}
-	else if(funcName[0] == 'p')
+	else if(luaFnName == "pushlightuserdata")
 	{
-		if(funcName == "pathto")
+		if(params.size() != 1)
 		{
-			if(params.size() != 1)
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+
+		VPos vpos;
+		if(vars.find(params[0], vpos))
+		{
+			if(vpos.type == "bool" || vpos.type == "int" || vpos.type == "double" || vpos.type == "std::double")
+				lua_pushlightuserdata(lua.L, &value_of(vars.layers[vpos.layer].doubles, vpos));
+			else if(vpos.type == "char" || vpos.type == "string" || vpos.type == "std::string")
+				lua_pushlightuserdata(lua.L, &value_of(vars.layers[vpos.layer].strings, vpos));
+			else if(vpos.type == "std::bool")
+				lua_pushlightuserdata(lua.L, &value_of(vars.layers[vpos.layer].bools, vpos));
+			else if(vpos.type == "std::int")
+				lua_pushlightuserdata(lua.L, &value_of(vars.layers[vpos.layer].ints, vpos));
+			else if(vpos.type == "std::char")
+				lua_pushlightuserdata(lua.L, &value_of(vars.layers[vpos.layer].chars, vpos));
+			else if(vpos.type == "std::llint")
+				lua_pushlightuserdata(lua.L, &value_of(vars.layers[vpos.layer].llints, vpos));
+			else if(vpos.type == "std::vector<double>")
+				lua_pushlightuserdata(lua.L, &value_of(vars.layers[vpos.layer].doubVecs, vpos));
+			else if(vpos.type == "std::vector<string>")
+				lua_pushlightuserdata(lua.L, &value_of(vars.layers[vpos.layer].strVecs, vpos));
+			else if(vpos.type == "fstream")
+				lua_pushlightuserdata(lua.L, &vars.layers[vpos.layer].fstreams[vpos.name]);
+			else if(vpos.type == "ifstream")
+				lua_pushlightuserdata(lua.L, &vars.layers[vpos.layer].ifstreams[vpos.name]);
+			else if(vpos.type == "ofstream")
+				lua_pushlightuserdata(lua.L, &vars.layers[vpos.layer].ofstreams[vpos.name]);
+			else if(vpos.type == "function" || vpos.type == "fn")
+			{
+				vars.layers[vpos.layer].luaFns.insert(vpos.name);
+				lua_pushlightuserdata(lua.L, &vars.layers[vpos.layer].functions[vpos.name]);
+			}
+			else
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "pathto: expected 1 parameter, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": do not recognise the type " << quote(vpos.type) << " for " << quote(params[0]) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": no variables named " << quote(params[0]) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			bool fromName = 0, toFile = 0;
-
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "name")
-						fromName = 1;
-					else if(options [o] == "file")
-						toFile = 1;
-				}
+		return 0;
+	}
+	else if(luaFnName == "pushnumber")
+	{
+		if(params.size() != 1)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+		else if(!isDouble(params[0]))
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": parameter to push on to Lua stack should be a double, got " << params[0] << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-				if(fromName && toFile)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "pathto(" << params[0] << ") failed, cannot have both options file and name" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
+		lua_pushnumber(lua.L, std::strtod(params[0].c_str(), NULL));
 
-			if(fromName == 0 && toFile == 0)
-				fromName = toFile = 1;
+		return 0;
+	}
+	else if(luaFnName == "pushstring")
+	{
+		if(params.size() != 1)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			if(fromName)
-			{
-				Name targetName = params[0];
-				TrackedInfo targetInfo;
-				targetInfo.name = targetName;
+		lua_pushstring(lua.L, params[0].c_str());
 
-				if(trackedAll->count(targetInfo))
-				{
-					toFile = 0;
-					Path targetPath = trackedAll->find(targetInfo)->outputPath;
-					//targetPath.set_file_path_from(targetPathStr);
+		return 0;
+	}
+	else if(luaFnName == "version")
+	{
+		if(params.size() != 0)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 0 parameters, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-					if(targetPath.file == "index.html")
-						targetPath.file = "";
+		lua_getglobal(lua.L, "_VERSION");
 
-					Path pathToTarget(pathBetween(toBuild.outputPath.dir, targetPath.dir), targetPath.file);
+		if(lua_type(lua.L, -1) == LUA_TSTRING)
+		{
+			std::string val = std::string(lua_tostring(lua.L, -1));
 
-					//adds path to target
-					outStr += pathToTarget.str();
-					if(indent)
-						indentAmount += into_whitespace(pathToTarget.str());
-				}
-				else if(!toFile) //throws error if target targetName isn't being tracked by Nift
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "pathto(" << targetName << ") failed, Nift not tracking " << targetName << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
+			outStr += val;
+			if(indent)
+				indentAmount.add_text(val);
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "lua_tostring: item number " << params[0] << " on Lua stack is not a string" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			if(toFile)
-			{
-				std::string targetFilePath = params[0];
+		lua_pop(lua.L, 1);
 
-				if(path_exists(targetFilePath.c_str()))
-				{
-					fromName = 0;
-					Path targetPath;
-					targetPath.set_file_path_from(targetFilePath);
+		return 0;
+	}
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": function does not exist in this scope" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-					Path pathToTarget(pathBetween(toBuild.outputPath.dir, targetPath.dir), targetPath.file);
+	return NSM_NOT_BUILTIN;
+}
 
-					//adds path to target
-					outStr += pathToTarget.str();
-					if(indent)
-						indentAmount += into_whitespace(pathToTarget.str());
-				}
-				else if(!fromName) //throws error if targetFilePath doesn't exist
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "pathto: file " << targetFilePath << " does not exist" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "pathto(" << params[0] << "): " << quote(params[0]) << " is neither a tracked name nor a file that exists" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
+int Parser::builtin_link(FnCall& call)
+{
+	const bool& indent = call.indent;
+	std::string& outStr = call.outStr;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
 
-			return 0;
+	if(params.size() == 1)
+		params.push_back(params[0]);
+
+	std::string str;
+	int langOpt = 0;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); ++o)
+		{
+			if(options[o] == "html")
+				langOpt = 0;
+			else if(options[o] == "md")
+				langOpt = 1;
 		}
-		else if(funcName == "pathtopage")
+	}
+	
+
+	if(langOpt == 0)
+		str = "<a href=\"" + params[0] + "\">" + params[1] + "</a>";
+	else if(langOpt == 1)
+		str = "[" + params[1] + "](" + params[0] + ")";
+
+	outStr += str;
+	if(indent)
+		indentAmount.add_text(str);
+
+	return 0;
+}
+
+int Parser::builtin_layer(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size() == 0)
+	{
+		outStr += std::to_string(vars.layers.size()-1);
+		if(indent)
+			indentAmount.add_text(std::to_string(vars.layers.size()-1));
+	}
+	else if(params.size() == 1)
+	{
+		VPos vpos;
+
+		if(vars.find(params[0], vpos))
 		{
-			if(params.size() != 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "pathtopage: expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+			outStr += std::to_string(vpos.layer);
+			if(indent)
+				indentAmount.add_text(std::to_string(vpos.layer));
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "layer: no variables/functions named " << params[0] << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
+
+	return 0;
+}
 
-			Name targetName = params[0];
-			TrackedInfo targetInfo;
-			targetInfo.name = targetName;
+int Parser::builtin_lst(FnCall& call)
+{
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size() < 1)
+	{
+		if(read_sh_params(params, ' ', linePos, inStr, readPath, lineNo, funcName, eos))
+			return 1;
+	}
 
-			if(trackedAll->count(targetInfo))
-			{
-				Path targetPath = trackedAll->find(targetInfo)->outputPath;
-				//targetPath.set_file_path_from(targetPathStr);
+	if(params.size() == 0)
+		params.push_back("./");
+	else if(params.size() > 1) 
+	{
+		for(size_t p=0; p+1<params.size(); ++p)
+			options.push_back(params[p]);
+		params = std::vector<std::string>(1, params[params.size()-1]);
+	}
 
-				if(targetPath.file == "index.html")
-					targetPath.file = "";
+	params[0] = replace_home_dir(params[0]);
 
-				Path pathToTarget(pathBetween(toBuild.outputPath.dir, targetPath.dir), targetPath.file);
+	std::string separator = " ";
+	std::vector<std::string> shOptions;
+	size_t pos = params[0].find_first_of('*');
+	bool hasUnknownOptions = 0;
+	bool toConsole = 0;
+	bool incHidden = 0;
+	bool fullPath = 0;
 
-				//adds path to target
-				outStr += pathToTarget.str();
-				if(indent)
-					indentAmount += into_whitespace(pathToTarget.str());
-			}
-			else //throws error if target targetName isn't being tracked by Nift
+	if(lolcatActive)
+		toConsole = 0;
+	else if((mode == MODE_INTERP || mode == MODE_SHELL) && (&outStr == &parsedText))
+		toConsole = 1;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); ++o)
+		{
+			if(options[o] == "1")
+				separator = "\n";
+			else if(options[o] == ",")
+				separator = ", ";
+			else if(options[o] == "a")
+				incHidden = 1;
+			else if(options[o] == "!c")
+				toConsole = 0;
+			else if(options[o] == "c")
+				toConsole = 1;
+			else if(options[o] == "P")
+				fullPath = 1;
+			else if(options[o] == "!p" || options[o] == "!v" || options[o] == "1p")
+			{}
+			else
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "pathtopage(" << targetName << ") failed, Nift not tracking " << targetName << std::endl;
-				os_mtx->unlock();
-				return 1;
+				hasUnknownOptions = 1;
+				shOptions.push_back(options[o]);
 			}
-
-			return 0;
 		}
-		else if(funcName == "pathtopageno")
+	}
+
+	if(!hasUnknownOptions && params.size() == 1 && (pos == std::string::npos || pos == params[0].size()-1))
+	{
+		std::set<std::string> paths;
+		Path lsPath;
+
+		if(pos == params[0].size()-1)
 		{
-			if(params.size() != 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "pathtopageno: expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+			params[0] = params[0].substr(0, params[0].size()-1);
+			lsPath.set_file_path_from(params[0].c_str());
+			makeSearchable(lsPath);
 
-			if(!isPosInt(params[0]))
+			if(fullPath)
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "pathtopageno: page number should be a non-negative integer, got " << params[0] << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+				std::string dir;
+				std::set<std::string> lsPaths = lsSetStar(lsPath, incHidden);
+				size_t pos;
 
-			size_t pageNo = std::atoi(params[0].c_str());
+				if(params[0].size() && 
+				   params[0][params[0].size()-1] != '/' && 
+				   params[0][params[0].size()-1] != '\\' && 
+				   dir_exists(params[0]))
+				{
+					pos = params[0].size();
+					params[0] += "/";
+				}
+				else
+					pos = params[0].find_last_of("/\\");
+
+				if(pos != std::string::npos)
+					dir = params[0].substr(0, pos+1);
 
-			if(pageNo > pagesInfo.pages.size())
+				for(auto path=lsPaths.begin(); path!=lsPaths.end(); ++path)
+					paths.insert(dir + *path);
+			}
+			else
+				paths = lsSetStar(lsPath, incHidden);
+
+			if(!paths.size())
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "pathtopageno: " << toBuild.name << " has no page number " << params[0];
-				eos << ", currently has " << pagesInfo.pages.size() << " pages" << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "lst: cannot access " << quote(params[0]) << ": no such file or directory" << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
-
-			Path targetPath;
-
-			if(pageNo > 1)
-				targetPath = Path(toBuild.outputPath.dir, pagesInfo.paginateName + params[0] + outputExt);
-			else
-				targetPath = outputDir + toBuild.name + outputExt;
-
-			Path pathToTarget(pathBetween(toBuild.outputPath.dir, targetPath.dir), targetPath.file);
-
-			//adds path to target
-			outStr += pathToTarget.str();
-			if(indent)
-				indentAmount += into_whitespace(pathToTarget.str());
-
-			return 0;
 		}
-		else if(funcName == "pathtofile")
+		else if(pos == std::string::npos)
 		{
-			if(params.size() != 1)
+			if(!path_exists(params[0]))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "pathtofile: expected 1 parameter, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "lst: cannot access " << quote(params[0]) << ": no such file or directory" << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+			else if(params[0].find_last_of("/\\") != params[0].size()-1 && dir_exists(params[0]))
+				params[0] += "/";
 
-			std::string targetFilePath = params[0];
-
-
-			if(!path_exists(targetFilePath.c_str())) 
+			lsPath.set_file_path_from(params[0].c_str());
+			makeSearchable(lsPath);
+			if(dir_exists(lsPath.str()))
 			{
-				if(path_exists(outputDir + targetFilePath)) 
-					targetFilePath = outputDir + targetFilePath;
-				else //throws error if targetFilePath doesn't exist
+				if(fullPath)
 				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "pathtofile: file " << targetFilePath << " does not exist" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
+					std::string dir;
+					std::set<std::string> lsPaths = lsSetStar(lsPath, incHidden);
+					size_t pos;
 
-			Path targetPath;
-			targetPath.set_file_path_from(targetFilePath);
-
-			Path pathToTarget(pathBetween(toBuild.outputPath.dir, targetPath.dir), targetPath.file);
+					if(params[0].size() && 
+					   params[0][params[0].size()-1] != '/' && 
+					   params[0][params[0].size()-1] != '\\' && 
+					   dir_exists(params[0]))
+					{
+						pos = params[0].size();
+						params[0] += "/";
+					}
+					else
+						pos = params[0].find_last_of("/\\");
 
-			//adds path to target
-			outStr += pathToTarget.str();
-			if(indent)
-				indentAmount += into_whitespace(pathToTarget.str());
-				
+					if(pos != std::string::npos)
+						dir = params[0].substr(0, pos+1);
 
-			return 0;
-		}
-		else if(funcName == "private")
-		{
-			if(params.size() < 1)
-			{
-				if(read_sh_params(params, ',', linePos, inStr, readPath, lineNo, funcName, eos))
-					return 1;
+					for(auto path=lsPaths.begin(); path!=lsPaths.end(); ++path)
+						paths.insert(dir + *path);
+				}
+				else
+					paths = lsSetStar(lsPath, incHidden);
 			}
-
-			std::string toParse = "@:=";
-			toParse += "{private";
-			for(size_t o=0; o<options.size(); ++o)
-				toParse += ", " + options[o];
-			toParse += '}';
-			if(params.size())
+			else if(file_exists(lsPath.str()))
 			{
-				int depth=0;
-				for(size_t pos=0; pos<params[0].size(); ++pos)
-				{
-					if(params[0][pos] == '<' || params[0][pos] == '[')
-						++depth;
-					else if(params[0][pos] == '>' || params[0][pos] == ']')
-						--depth;
-					else if(params[0][pos] == '"')
-						pos = params[0].find_first_of('"', pos+1);
-					else if(params[0][pos] == '\'')
-						pos = params[0].find_first_of('\'', pos+1);
-					else if(depth == 0 && params[0][pos] == ' ')
-					{
-						params[0][pos] = ',';
-						break;
-					}
-				}
-				toParse += "(" + params[0];
-				for(size_t p=1; p<params.size(); ++p)
-					toParse += ", " + params[p];
-				toParse += ')';
+				lsPath.dir = lsPath.file = "";
+				paths.insert(params[0]);
 			}
+		}
+		
 
-			if(n_read_and_process_fast(indent, toParse, lineNo-1, readPath, antiDepsOfReadPath, outStr, eos))
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) <<  "private: private definition failed" << std::endl;
+		if(toConsole)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			if(fullPath)
+				coutPaths("", paths, separator, 1, 0);
+			else
+				coutPaths(lsPath.dir, paths, separator, 1, 0);
+			std::cout << std::endl;
+			if(!consoleLocked)
 				os_mtx->unlock();
-				return 1;
-			}
 
 			if(linePos < inStr.size() && inStr[linePos] == '!')
 				++linePos;
 			else
 				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
-
-			return 0;
 		}
-		else if(funcName == "paginate")
+		else if(paths.size())
 		{
-			if(params.size() != 0)
+			auto path=paths.begin();
+
+			if(separator == "\n")
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "paginate: expected 0 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+				std::string endPath;
 
-			pagesInfo.callPath = readPath;
-			pagesInfo.callLineNo = sLineNo;
-			parsedText += "__paginate_here__";
+				if(path->find_first_of(' ') == std::string::npos)
+					endPath = *path;
+				else
+					endPath = quote(*path);
+				outStr += endPath;
+				++path;
+				for(; path!=paths.end(); ++path)
+				{
+					if(path->find_first_of(' ') == std::string::npos)
+						endPath = *path;
+					else
+						endPath = quote(*path);
+					outStr += "\n" + indentAmount + endPath;
+				}
 
-			size_t pos = toBuild.name.find_last_of('/');
-			if(pos == std::string::npos)
-				pos = 0;
-			else
-				++pos;
-			pagesInfo.paginateName = toBuild.name.substr(pos, toBuild.name.size()-pos);
-			if(pagesInfo.paginateName == "index")
-				pagesInfo.paginateName = "";
+				indentAmount.add_text(endPath);
+			}
 			else
-				pagesInfo.paginateName += "-";
-
-			for(; linePos < inStr.size() && inStr[linePos] != '\n'; ++linePos)
 			{
-				if(inStr[linePos] != ' ' && inStr[linePos] != '\t')
+				std::string lsStr;
+				if(path->find_first_of(' ') == std::string::npos)
+					lsStr = *path;
+				else
+					lsStr = quote(*path);
+				++path;
+				for(; path!=paths.end(); ++path)
 				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "paginate: expected nothing after call on this line " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
+					if(path->find_first_of(' ') == std::string::npos)
+						lsStr += separator + *path;
+					else
+						lsStr += separator + quote(*path);
 				}
+				outStr += lsStr;
+				indentAmount.add_text(lsStr);
 			}
-
-			skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
-
-			return 0;
 		}
-		else if(funcName == "paginate.no_items_per_page")
-		{
-			if(params.size() != 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "paginate.no_items_per_page: expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	}
+	else
+	{
+		#if defined _WIN32 || defined _WIN64
+			funcName = "dir /b"; 
+		#else  //*nix
+			funcName = "ls -d";
+		#endif
+		if(toConsole)
+			return try_system_call_console(funcName, shOptions, params, readPath, antiDepsOfReadPath, sLineNo, lineNo, eos, outStr);
+		else
+			return try_system_call_inject(funcName, shOptions, params, readPath, antiDepsOfReadPath, sLineNo, lineNo, eos, outStr);
+	}
 
-			if(!isPosInt(params[0]))
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "paginate.no_items_per_page: expected a positive integer parameter, got " << params[0] << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	return 0;
+}
 
-			pagesInfo.noItemsPerPage = std::atoi(params[0].c_str());
+int Parser::builtin_lolcat(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const char& lang = call.lang;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	bool readBlock = 0, parseBlock = 1;
+	int bLineNo = lineNo;
+	std::string txt;
 
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+	if(!lolcatInit && !lolcat_init(""))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_warn(eos, readPath, sLineNo) << "could not find 'lolcat' installed on the machine" << std::endl;
+		if(!consoleLocked)
+			os_mtx->unlock();
+	}
 
-			return 0;
-		}
-		else if(funcName == "paginate.separator")
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
 		{
-			if(params.size() > 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "paginate.separator: expected 0-1 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
-			if(params.size() == 1)
-			{
-				pagesInfo.separator = params[0];
-				pagesInfo.separatorLineNo = sLineNo;
-			}
-			else
-			{
-				if(read_block(pagesInfo.separator, linePos, inStr, readPath, lineNo, pagesInfo.separatorLineNo, "paginate.separator", eos))
-					   return 1;
+			if(options[o] == "b" || options[o] == "block")
+				readBlock = 1;
+			else if(options[o] == "!pb")
+				parseBlock = 0;
+		}
+	}
 
-				pagesInfo.separator = "\n" + pagesInfo.separator + "\n\n";
-				--pagesInfo.separatorLineNo;
+	if(readBlock)
+	{
+		if(params.size() != 0)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "lolcat{block}: expected 0 parameters, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-				if(parse_replace(lang, pagesInfo.separator, "paginate.separator", readPath, antiDepsOfReadPath, pagesInfo.separatorLineNo, "item", sLineNo, eos))
-					return 1;
+		if(read_block(txt, linePos, inStr, readPath, lineNo, bLineNo, "lolcat", eos))
+		   return 1;
 
-				if(linePos < inStr.size() && inStr[linePos] == '!')
-					++linePos;
-				else
-					skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
-			}
+		if(parseBlock && parse_replace(lang, txt, "lolcat block", readPath, antiDepsOfReadPath, bLineNo, "lolcat", sLineNo, eos))
+			return 1;
+	}
 
-			return 0;
-		}
-		else if(funcName == "paginate.template")
+	VPos vpos;
+	Indent gIndentAmount;
+	for(size_t p=0; p<params.size(); p++)
+	{
+		if(params[p] == "endl")
+			txt += "\r\n";
+		else if(replaceVars && vars.find(params[p], vpos))
 		{
-			if(params.size() != 0)
+			gIndentAmount.clear();
+			if(!vars.add_str_from_var(vpos, txt, 1, indent, gIndentAmount))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "paginate.template: expected 0 parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "lolcat: cannot get string of var type " << quote(vpos.type) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+		}
+		else
+			txt += params[p];
+	}
 
-			pagesInfo.templateCallLineNo = sLineNo;
-			if(read_block(pagesInfo.templateStr, linePos, inStr, readPath, lineNo, pagesInfo.templateLineNo, "paginate.template", eos))
-				   return 1;
+	if(!consoleLocked)
+		os_mtx->lock();
+	if(lolcatInit)
+		rnbwcout(txt);
+	else
+		eos << txt << std::endl;
+	if(!consoleLocked)
+		os_mtx->unlock();
 
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+	return 0;
+}
 
-			return 0;
-		}
-		else if(funcName == "parse")
-		{
-			if(params.size() != 2)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "parse: expected 2 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+int Parser::builtin_lolcat_cmd(FnCall& call)
+{
+	std::string& outStr = call.outStr;
 
-			if(params.size() == 2)
-			{
-				if(isPosInt(params[0]))
-				{
-					int noParses = std::atoi(params[0].c_str());
-					for(int p=1; p<noParses; p++)
-						if(parse_replace(lang, params[1], "parse string", readPath, antiDepsOfReadPath, lineNo, "parse", sLineNo, eos))
-							return 1;
+	outStr += lolcatCmd;
 
-					outStr += params[1];
-					if(indent)
-						indentAmount += into_whitespace(params[1]);
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "parse: first parameter should be a positive integer, got " << params[0] << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
+	return 0;
+}
 
-			return 0;
-		}
-		else if(funcName == "precision")
+int Parser::builtin_lolcat_on(FnCall& call)
+{
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& params = call.params;
+
+	if(lolcatActive)
+	{
+		if(mode == MODE_INTERP || mode == MODE_SHELL)
 		{
-			if(params.size() > 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "precision: expected 0-1 parameters, got " << params.size() << std::endl;
+			if(!consoleLocked)
+				os_mtx->lock();
+			rnbwcout("lolcat already activated\a");
+			if(!consoleLocked)
 				os_mtx->unlock();
-				return 1;
-			}
+		}
 
-			if(params.size())
-			{
-				if(params[0] == "fixed")
-					vars.fixedPrecision = 1;
-				else if(params[0] == "!fixed")
-					vars.fixedPrecision = 0;
-				else if(params[0] == "scientific")
-					vars.scientificPrecision = 1;
-				else if(params[0] == "!scientific")
-					vars.scientificPrecision = 0;
-				else if(params[0] == "hexfloat")
-					vars.fixedPrecision = vars.scientificPrecision = 1;
-				else if(params[0] == "!hexfloat")
-					vars.fixedPrecision = vars.scientificPrecision = 0;
-				else if(params[0] == "defaultfloat")
-					vars.fixedPrecision = vars.scientificPrecision = 0;
-				else if(!isNonNegInt(params[0]))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "precision: parameter should be 'fixed', '!fixed', 'scientific', '!scientific', 'hexfloat', '!hexfloat', 'defaultfloat' or a non-negative integer, got " << params[0] << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-				else
-					vars.precision = std::atoi(params[0].c_str());
-			}
-			else
-			{
-				outStr += std::to_string(vars.precision); //check this
-				if(indent)
-					indentAmount += into_whitespace(std::to_string(vars.precision));
-			}
+		return 0;
+	}
 
-			return 0;
+	if(params.size() == 1)
+		lolcatCmd = params[0];
+
+	if(!lolcatInit)
+	{
+		if(lolcat_init(lolcatCmd))
+		{
+			#if defined _WIN32 || defined _WIN64
+				if(using_powershell_colours())
+					lolcat_powershell();
+			#endif
+			lolcatActive = 1;
 		}
-		else if(funcName == "pwd")
+		else
 		{
-			if(params.size() != 0)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "pwd: expected 0 parameters, got " << params.size() << std::endl;
+			if(!consoleLocked)
+				os_mtx->lock();
+			if(params.size() == 1)
+				start_warn(eos, readPath, sLineNo) << "could not find " << c_blue << lolcatCmd << c_white << " installed on the machine" << std::endl;
+			else
+				start_warn(eos, readPath, sLineNo) << "could not find 'lolcat' installed on the machine" << std::endl;
+			if(!consoleLocked)
 				os_mtx->unlock();
-				return 1;
-			}
+		}
+	}
+	else
+	{
+		#if defined _WIN32 || defined _WIN64
+			if(using_powershell_colours())
+				lolcat_powershell();
+		#endif
+		lolcatActive = 1;
+	}
 
-			std::string pwd = get_pwd();
-			outStr += pwd;
-			if(indent)
-				indentAmount += into_whitespace(pwd);
+	if(lolcatActive && (mode == MODE_INTERP || mode == MODE_SHELL))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		rnbwcout("lolcat activated using command " + quote(lolcatCmd));
+		if(!consoleLocked)
+			os_mtx->unlock();
+	}
 
-			return 0;
-		}
-		else if(funcName == "poke")
-		{
-			if(params.size() == 0)
-			{
-				if(read_sh_params(params, ' ', linePos, inStr, readPath, lineNo, funcName, eos))
-					return 1;
-			}
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-			if(params.size() == 0)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "poke: expected parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	return 0;
+}
 
-			bool createFiles = 1,
-			     mt = 0;
+int Parser::builtin_lolcat_off(FnCall& call)
+{
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	std::string& funcName = call.funcName;
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "dirs")
-						createFiles = 0;
-					else if(options[o] == "mt")
-						mt = 1;
-				}
-			}
+	if(mode == MODE_INTERP || mode == MODE_SHELL)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		if(lolcatActive)
+			std::cout << "lolcat deactivated" << std::endl;
+		else
+			std::cout << "lolcat not activated\a" << std::endl;
+		if(!consoleLocked)
+			os_mtx->unlock();
+	}
 
-			if(mt)
-			{
-				size_t max_p,
-				       no_thrds = std::atoi(params[0].c_str()),
-				       trans = std::ceil((double)(params.size()-1)/(double)no_thrds);
-				std::vector<std::thread> threads;
+	lolcatActive = 0;
 
-				for(size_t min_p = 1; min_p<params.size(); min_p=max_p)
-				{
-					max_p = std::min(min_p+trans, params.size());
-					threads.push_back(std::thread(create_files_thread, params, min_p, max_p));
-				}
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-				for(size_t i=0; i<threads.size(); ++i)
-					threads[i].join();
-			}
-			else
-			{
-				Path path;
-				for(size_t p=0; p<params.size(); p++)
-				{
-					path.set_file_path_from(params[p]);
-					if(createFiles)
-						path.ensureFileExists();
-					else
-					{
-						if(path.file.size())
-						{
-							if(path.dir.size())
-								path.dir += "/" + path.file + "/";
-							else
-								path.dir = "./" + path.file + "/";
-						}
-						path.ensureDirExists();
-					}
-				}
-			}
+	return 0;
+}
 
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+int Parser::builtin_lolcat_status(FnCall& call)
+{
+	std::string& outStr = call.outStr;
 
-			return 0;
-		}
-		else if(funcName == "prompt.char")
-		{
-			if(params.size() != 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "prompt.char: expected 1 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	if(lolcatActive)
+		outStr += "lolcat is activated using " + quote(lolcatCmd);
+	else
+		outStr += "lolcat is not activated";
 
-			change_prompt_char(params[0]);
+	return 0;
+}
 
-			return 0;
-		}
+int Parser::builtin_pathto(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
 
-	}
-	else if(funcName[0] == 'c')
+	bool fromName = 0, toFile = 0;
+
+	if(options.size())
 	{
-		if(funcName == "content")
+		for(size_t o=0; o<options.size(); o++)
 		{
-			if(params.size() != 0)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo)  << "content: expected 0 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+			if(options[o] == "name")
+				fromName = 1;
+			else if(options [o] == "file")
+				toFile = 1;
+		}
 
-			contentAdded = 1;
-			std::string toParse = "@input";
-			if(options.size())
-			{
-				toParse += "{" + options[0];
-				for(size_t o=1; o<options.size(); o++)
-					toParse += ", " + options[o];
-				toParse += '}';
-			}
-			toParse += "(" + quote(toBuild.contentPath.str()) + ")";
+		if(fromName && toFile)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "pathto(" << params[0] << ") failed, cannot have both options file and name" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-			if(n_read_and_process_fast(indent, toParse, lineNo-1, readPath, antiDepsOfReadPath, outStr, eos))
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) <<  "failed to insert content" << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	if(fromName == 0 && toFile == 0)
+		fromName = toFile = 1;
 
-			return 0;
-		}
-		else if(funcName == "continue")
-		{
-			if(params.size() != 0)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "continue: expected 0 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	if(fromName)
+	{
+		Name targetName = params[0];
+		TrackedInfo targetInfo;
+		targetInfo.name = targetName;
 
-			return NSM_CONT; //check this??
-		}
-		else if(funcName == "cpy")
+		if(trackedAll->count(targetInfo))
 		{
-			if(params.size() < 2)
-			{
-				if(read_sh_params(params, ' ', linePos, inStr, readPath, lineNo, funcName, eos))
-					return 1;
-			}
+			toFile = 0;
+			Path targetPath = trackedAll->find(targetInfo)->outputPath;
+			//targetPath.set_file_path_from(targetPathStr);
 
-			if(params.size() < 2)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 2+ parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+			if(targetPath.file == "index.html")
+				targetPath.file = "";
 
-			bool backupFiles = 0,
-			     forceFile = 0,
-			     ifNew = 0,
-			     overwrite = 1,
-			     changePermissions = 0, 
-			     prompt = 0,
-			     verbose = 0;
+			Path pathToTarget(pathBetween(toBuild.outputPath.dir, targetPath.dir), targetPath.file);
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); ++o)
-				{
-					if(options[o] == "b")
-						backupFiles = 1;
-					else if(options[o] == "f")
-						changePermissions = 1;
-					else if(options[o] == "i")
-						prompt = 1;
-					else if(options[o] == "n")
-						overwrite = 0;
-					else if(options[o] == "T")
-						forceFile = 1;
-					else if(options[o] == "u")
-						ifNew = 1;
-					else if(options[o] == "v")
-						verbose = 1;
-				}
-			}
+			//adds path to target
+			outStr += pathToTarget.str();
+			if(indent)
+				indentAmount.add_text(pathToTarget.str());
+		}
+		else if(!toFile) //throws error if target targetName isn't being tracked by Nift
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "pathto(" << targetName << ") failed, Nift not tracking " << targetName << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-			size_t t = params.size()-1;
-			Path source, target;
-			std::string sourceStr, 
-			            targetStr = replace_home_dir(params[t]),
-			            targetParam = params[t];
-			char promptInput = 'n';
+	if(toFile)
+	{
+		std::string targetFilePath = params[0];
 
-			params.pop_back();
+		if(path_exists(targetFilePath.c_str()))
+		{
+			fromName = 0;
+			Path targetPath;
+			targetPath.set_file_path_from(targetFilePath);
 
-			if(params.size() == 1 && 
-			    (forceFile || !dir_exists(targetStr)) && 
-			    params[0].find_first_of('*') == std::string::npos)
-			{
-				if(params[0].size() && (params[0][params[0].size()-1] == '/' || params[0][params[0].size()-1] == '\\'))
-				{
-					int pos=params[0].size()-2;
-					while(pos>=0 && (params[0][pos] == '/' || params[0][pos] == '\\'))
-						--pos;
-					params[0] = params[0].substr(0, pos+1);
-				}
+			Path pathToTarget(pathBetween(toBuild.outputPath.dir, targetPath.dir), targetPath.file);
 
-				sourceStr = replace_home_dir(params[0]);
-				source.set_file_path_from(sourceStr);
-				target.set_file_path_from(targetStr);
+			//adds path to target
+			outStr += pathToTarget.str();
+			if(indent)
+				indentAmount.add_text(pathToTarget.str());
+		}
+		else if(!fromName) //throws error if targetFilePath doesn't exist
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "pathto: file " << targetFilePath << " does not exist" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "pathto(" << params[0] << "): " << quote(params[0]) << " is neither a tracked name nor a file that exists" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-				if(!path_exists(sourceStr))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot copy ";
-					eos << quote(params[0]) << " as path does not exist" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	return 0;
+}
 
-				if(overwrite || !file_exists(targetStr))
-				{
-					if(!ifNew || source.modified_after(target))
-					{
-						if(changePermissions)
-						{
-							if(file_exists(targetStr))
-								chmod(targetStr.c_str(), 0666);
-							else if(dir_exists(targetStr))
-								chmod(targetStr.c_str(), S_IRWXU);
-						}
+int Parser::builtin_pathtopage(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+
+	Name targetName = params[0];
+	TrackedInfo targetInfo;
+	targetInfo.name = targetName;
+
+	if(trackedAll->count(targetInfo))
+	{
+		Path targetPath = trackedAll->find(targetInfo)->outputPath;
+		//targetPath.set_file_path_from(targetPathStr);
 
-						if((prompt && promptInput != 'a') || verbose)
-						{
-							eos << quote(params[0]) << " -> " << quote(params[1]) << std::endl;
+		if(targetPath.file == "index.html")
+			targetPath.file = "";
 
-							if(prompt && promptInput != 'a')
-							{
-								eos << "? " << std::flush;
-								promptInput = nsm_getch();
-								if(promptInput == 'Y' || promptInput == '1')
-									promptInput = 'y';
-								else if(promptInput == 'A')
-									promptInput = 'a';
-							}
-							
-							eos << std::endl;
-						}
+		Path pathToTarget(pathBetween(toBuild.outputPath.dir, targetPath.dir), targetPath.file);
 
-						if(!prompt || promptInput == 'y' || promptInput == 'a')
-						{
-							if(backupFiles && path_exists(targetStr))
-								rename(targetStr.c_str(), (targetStr + "~").c_str());
+		//adds path to target
+		outStr += pathToTarget.str();
+		if(indent)
+			indentAmount.add_text(pathToTarget.str());
+	}
+	else //throws error if target targetName isn't being tracked by Nift
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "pathtopage(" << targetName << ") failed, Nift not tracking " << targetName << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-							if(dir_exists(sourceStr))
-							{
-								if(cpDir(sourceStr, targetStr, sLineNo, readPath, eos, consoleLocked, os_mtx))
-								{
-									if(!consoleLocked)
-										os_mtx->lock();
-									start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to copy directory ";
-									eos << quote(params[0]) << " to " << quote(targetParam) << std::endl;
-									os_mtx->unlock();
-									return 1;
-								}
-							}
-							else if(cpFile(sourceStr, targetStr, sLineNo, readPath, eos, consoleLocked, os_mtx))
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to copy file ";
-								eos << quote(params[0]) << " to " << quote(targetParam) << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-						}
-					}
-				}
-			}
-			else
-			{
-				if(!dir_exists(targetStr))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot copy files to ";
-					eos << quote(targetStr) << " as directory does not exist" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	return 0;
+}
 
-				char endChar = targetStr[targetStr.size()-1];
-				if(endChar != '/' && endChar != '\\')
-					targetStr += "/";
-				target.set_file_path_from(targetStr);
+int Parser::builtin_pathtopageno(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+
+	if(!isPosInt(params[0]))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "pathtopageno: page number should be a non-negative integer, got " << params[0] << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-				struct stat  oldDirPerms;
-				if(changePermissions)
-				{
-					stat(targetStr.c_str(), &oldDirPerms);
-					chmod(target.dir.c_str(), S_IRWXU);
-				}
-				else if(!can_write(targetStr))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot write to " << quote(target.dir) << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	size_t pageNo = std::atoi(params[0].c_str());
 
-				std::vector<Path> sources;
-				for(size_t p=0; p<params.size(); ++p)
-				{
-					if(params[p].size() && (params[p][params[p].size()-1] == '/' || params[p][params[p].size()-1] == '\\'))
-					{
-						int pos=params[p].size()-2; 
-						while(pos>=0 && (params[p][pos] == '/' || params[p][pos] == '\\'))
-							--pos;
-						params[p] = params[p].substr(0, pos+1);
-					}
+	if(pageNo > pagesInfo.pages.size())
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "pathtopageno: " << toBuild.name << " has no page number " << params[0];
+		eos << ", currently has " << pagesInfo.pages.size() << " pages" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-					sourceStr = replace_home_dir(params[p]);
-					source.set_file_path_from(sourceStr);
-					sources.push_back(source);
+	Path targetPath;
 
-					if(!path_exists(sourceStr))
-					{
-						if(sourceStr.find_first_of('*') != std::string::npos)
-						{
-							std::string parsedTxt, toParse = "@lst{!c, 1, P}(" + sourceStr + ")";
-							int parseLineNo = 0;
+	if(pageNo > 1)
+		targetPath = Path(toBuild.outputPath.dir, pagesInfo.paginateName + params[0] + outputExt);
+	else
+		targetPath = outputDir + toBuild.name + outputExt;
 
-							if(n_read_and_process_fast(indent, toParse, parseLineNo, readPath, antiDepsOfReadPath, parsedTxt, eos))
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) <<  funcName << ": failed to list " << quote(sourceStr) << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
+	Path pathToTarget(pathBetween(toBuild.outputPath.dir, targetPath.dir), targetPath.file);
 
-							std::istringstream iss(parsedTxt);
-							while(getline(iss, sourceStr))
-								params.push_back(sourceStr);
+	//adds path to target
+	outStr += pathToTarget.str();
+	if(indent)
+		indentAmount.add_text(pathToTarget.str());
 
-							continue;
-						}
-						else
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot copy ";
-							eos << quote(params[p]) << " as path does not exist" << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-					}
+	return 0;
+}
 
-					target.file = source.file;
-					targetStr = target.str();
+int Parser::builtin_pathtofile(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
 
-					if(overwrite || !file_exists(targetStr))
-					{
-						if(!ifNew || source.modified_after(target))
-						{
-							if(changePermissions && file_exists(targetStr))
-								chmod(targetStr.c_str(), 0666);
+	std::string targetFilePath = params[0];
 
-							if((prompt && promptInput != 'a') || verbose)
-							{
-								if(targetParam.size())
-								{
-									endChar = targetParam[targetParam.size()-1];
-									if(endChar != '/' && endChar != '\\')
-										targetParam += '/';
-								}
 
-								eos << quote(params[p]) << " -> " << quote(targetParam + source.file);
+	if(!path_exists(targetFilePath.c_str())) 
+	{
+		if(path_exists(outputDir + targetFilePath)) 
+			targetFilePath = outputDir + targetFilePath;
+		else //throws error if targetFilePath doesn't exist
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "pathtofile: file " << targetFilePath << " does not exist" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-								if(prompt && promptInput != 'a')
-								{
-									eos << "? " << std::flush;
-									promptInput = nsm_getch();
-									if(promptInput == 'Y' || promptInput == '1')
-										promptInput = 'y';
-									else if(promptInput == 'A')
-										promptInput = 'a';
-								}
-								
-								eos << std::endl;
-							}
+	Path targetPath;
+	targetPath.set_file_path_from(targetFilePath);
 
-							if(!prompt || promptInput == 'y' || promptInput == 'a')
-							{
-								if(backupFiles && path_exists(targetStr))
-									rename(targetStr.c_str(), (targetStr + "~").c_str());
+	Path pathToTarget(pathBetween(toBuild.outputPath.dir, targetPath.dir), targetPath.file);
 
+	//adds path to target
+	outStr += pathToTarget.str();
+	if(indent)
+		indentAmount.add_text(pathToTarget.str());
+		
 
-								if(dir_exists(sourceStr))
-								{
-									if(cpDir(sourceStr, targetStr, sLineNo, readPath, eos, consoleLocked, os_mtx))
-									{
-										if(targetParam.size())
-										{
-											endChar = targetParam[targetParam.size()-1];
-											if(endChar != '/' && endChar != '\\')
-												targetParam += '/';
-										}
-
-										if(!consoleLocked)
-											os_mtx->lock();
-										start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to copy directory ";
-										eos << quote(params[p]) << " to " << quote(targetParam + source.file) << std::endl;
-										os_mtx->unlock();
-										return 1;
-									}
-								}
-								else if(cpFile(sourceStr, targetStr, sLineNo, readPath, eos, consoleLocked, os_mtx))
-								{
-									if(targetParam.size())
-									{
-										endChar = targetParam[targetParam.size()-1];
-										if(endChar != '/' && endChar != '\\')
-											targetParam += '/';
-									}
-
-									if(!consoleLocked)
-										os_mtx->lock();
-									start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to copy file ";
-									eos << quote(params[p]) << " to " << quote(targetParam + source.file) << std::endl;
-									os_mtx->unlock();
-									return 1;
-								}
-							}
-						}
-					}
-				}
+	return 0;
+}
 
-				if(changePermissions)
-					chmod(target.dir.c_str(), oldDirPerms.st_mode);
-			}
-			
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+int Parser::builtin_private(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size() < 1)
+	{
+		if(read_sh_params(params, ',', linePos, inStr, readPath, lineNo, funcName, eos))
+			return 1;
+	}
 
-			return 0;
-		}
-		else if(funcName == "const")
+	std::string toParse = "@:=";
+	toParse += "{private";
+	for(size_t o=0; o<options.size(); ++o)
+		toParse += ", " + options[o];
+	toParse += '}';
+	if(params.size())
+	{
+		int depth=0;
+		for(size_t pos=0; pos<params[0].size(); ++pos)
 		{
-			if(params.size() < 1)
+			if(params[0][pos] == '<' || params[0][pos] == '[')
+				++depth;
+			else if(params[0][pos] == '>' || params[0][pos] == ']')
+				--depth;
+			else if(params[0][pos] == '"')
+				pos = params[0].find_first_of('"', pos+1);
+			else if(params[0][pos] == '\'')
+				pos = params[0].find_first_of('\'', pos+1);
+			else if(depth == 0 && params[0][pos] == ' ')
 			{
-				if(read_sh_params(params, ',', linePos, inStr, readPath, lineNo, funcName, eos))
-					return 1;
+				params[0][pos] = ',';
+				break;
 			}
+		}
+		toParse += "(" + params[0];
+		for(size_t p=1; p<params.size(); ++p)
+			toParse += ", " + params[p];
+		toParse += ')';
+	}
 
-			std::string toParse = "@:=";
-			toParse += "{const";
-			for(size_t o=0; o<options.size(); ++o)
-				toParse += ", " + options[o];
-			toParse += '}';
-			if(params.size())
-			{
-				int depth=0;
-				for(size_t pos=0; pos<params[0].size(); ++pos)
-				{
-					if(params[0][pos] == '<' || params[0][pos] == '[')
-						++depth;
-					else if(params[0][pos] == '>' || params[0][pos] == ']')
-						--depth;
-					else if(params[0][pos] == '"')
-						pos = params[0].find_first_of('"', pos+1);
-					else if(params[0][pos] == '\'')
-						pos = params[0].find_first_of('\'', pos+1);
-					else if(depth == 0 && params[0][pos] == ' ')
-					{
-						params[0][pos] = ',';
-						break;
-					}
-				}
-				toParse += "(" + params[0];
-				for(size_t p=1; p<params.size(); ++p)
-					toParse += ", " + params[p];
-				toParse += ')';
-			}
+	if(n_read_and_process_fast(indent, toParse, lineNo-1, readPath, antiDepsOfReadPath, outStr, eos))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) <<  "private: private definition failed" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-			if(n_read_and_process_fast(indent, toParse, lineNo-1, readPath, antiDepsOfReadPath, outStr, eos))
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) <<  "const: constant definition failed" << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+	return 0;
+}
 
-			return 0;
-		}
-		else if(funcName == "cd")
-		{
-			if(params.size() < 1)
-			{
-				if(read_sh_params(params, ' ', linePos, inStr, readPath, lineNo, funcName, eos))
-					return 1;
-			}
+int Parser::builtin_paginate(FnCall& call)
+{
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& params = call.params;
+
+	pagesInfo.callPath = readPath;
+	pagesInfo.callLineNo = sLineNo;
+	parsedText += "__paginate_here__";
+
+	size_t pos = toBuild.name.find_last_of('/');
+	if(pos == std::string::npos)
+		pos = 0;
+	else
+		++pos;
+	pagesInfo.paginateName = toBuild.name.substr(pos, toBuild.name.size()-pos);
+	if(pagesInfo.paginateName == "index")
+		pagesInfo.paginateName = "";
+	else
+		pagesInfo.paginateName += "-";
 
-			if(params.size() != 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "cd: expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	for(; linePos < inStr.size() && inStr[linePos] != '\n'; ++linePos)
+	{
+		if(inStr[linePos] != ' ' && inStr[linePos] != '\t')
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "paginate: expected nothing after call on this line " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-			std::string target = replace_home_dir(params[0]);
+	skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-			if(!dir_exists(target))
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "cd: cannot change directory to " << quote(params[0]) << " as it is not a directory" << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	return 0;
+}
 
-			if(chdir(target.c_str()))
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "cd: failed to change directory to " << quote(params[0]) << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+int Parser::builtin_paginate_no_items_per_page(FnCall& call)
+{
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& params = call.params;
+
+	if(!isPosInt(params[0]))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "paginate.no_items_per_page: expected a positive integer parameter, got " << params[0] << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+	pagesInfo.noItemsPerPage = std::atoi(params[0].c_str());
 
-			return 0;
-		}
-		else if(funcName == "console")
-		{
-			bool readBlock = 0, parseBlock = 1;
-			int bLineNo = lineNo;
-			std::string txt;
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "b" || options[o] == "block")
-						readBlock = 1;
-					else if(options[o] == "!pb")
-						parseBlock = 0;
-				}
-			}
+	return 0;
+}
 
-			if(!params.size())
-				readBlock = 1;
+int Parser::builtin_paginate_separator(FnCall& call)
+{
+	const char& lang = call.lang;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size() == 1)
+	{
+		pagesInfo.separator = params[0];
+		pagesInfo.separatorLineNo = sLineNo;
+	}
+	else
+	{
+		if(read_block(pagesInfo.separator, linePos, inStr, readPath, lineNo, pagesInfo.separatorLineNo, "paginate.separator", eos))
+			   return 1;
 
-			if(readBlock)
-			{
-				if(params.size() != 0)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "console{block}: expected 0 parameters, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+		pagesInfo.separator = "\n" + pagesInfo.separator + "\n\n";
+		--pagesInfo.separatorLineNo;
 
-				if(read_block(txt, linePos, inStr, readPath, lineNo, bLineNo, "console", eos))
-				   return 1;
+		if(parse_replace(lang, pagesInfo.separator, "paginate.separator", readPath, antiDepsOfReadPath, pagesInfo.separatorLineNo, "item", sLineNo, eos))
+			return 1;
 
-				if(parseBlock && parse_replace(lang, txt, "console block", readPath, antiDepsOfReadPath, bLineNo, "console", sLineNo, eos))
-					return 1;
-			}
+		if(linePos < inStr.size() && inStr[linePos] == '!')
+			++linePos;
+		else
+			skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+	}
 
-			VPos vpos;
-			std::string gIndentAmount;
-			for(size_t p=0; p<params.size(); p++)
-			{
-				if(params[p] == "endl")
-					txt += "\r\n";
-				else if(replaceVars && vars.find(params[p], vpos))
-				{
-					gIndentAmount = "";
-					if(!vars.add_str_from_var(vpos, txt, 1, indent, gIndentAmount))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "console: cannot get string of var type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-				else
-					txt += params[p];
-			}
+	return 0;
+}
 
-			if(!consoleLocked)
-				os_mtx->lock();
-			if(lolcatActive)
-				rnbwcout(txt);
-			else
-				eos << txt << std::endl;
-			if(!consoleLocked)
-				os_mtx->unlock();
+int Parser::builtin_paginate_template(FnCall& call)
+{
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+
+	pagesInfo.templateCallLineNo = sLineNo;
+	if(read_block(pagesInfo.templateStr, linePos, inStr, readPath, lineNo, pagesInfo.templateLineNo, "paginate.template", eos))
+		   return 1;
+
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+	return 0;
+}
 
-			return 0;
-		}
-		else if(funcName == "console.lock")
+int Parser::builtin_parse(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const char& lang = call.lang;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size() == 2)
+	{
+		if(isPosInt(params[0]))
 		{
-			if(params.size() != 0)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "console.lock: expected 0 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
-			if(consoleLocked)
-			{
-				//os_mtx->lock(); //is already locked from this thread
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "console.lock: console is already locked" << std::endl;
-				os_mtx->unlock();
-				consoleLocked = 0;
-				return 1;
-			}
-			else
-			{
-				consoleLocked = 1;
-				consoleLockedOnLine = lineNo;
-				consoleLockedPath = readPath;
-			}
-
-			os_mtx->lock();
-
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+			int noParses = std::atoi(params[0].c_str());
+			for(int p=1; p<noParses; p++)
+				if(parse_replace(lang, params[1], "parse string", readPath, antiDepsOfReadPath, lineNo, "parse", sLineNo, eos))
+					return 1;
 
-			return 0;
+			outStr += params[1];
+			if(indent)
+				indentAmount.add_text(params[1]);
 		}
-		else if(funcName == "console.unlock")
+		else
 		{
-			if(params.size() != 0)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "console.unlock: expected 0 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
-			if(consoleLocked)
-				consoleLocked = 0;
-			else
-			{
+			if(!consoleLocked)
 				os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "console.unlock: console is not locked from this thread" << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "parse: first parameter should be a positive integer, got " << params[0] << std::endl;
 			os_mtx->unlock();
-
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
-
-			return 0;
+			return 1;
 		}
-		else if(funcName == "console.locked")
-		{
-			if(params.size() != 0)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "console.locked: expected 0 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	}
 
-			outStr += std::to_string(consoleLocked);
-			if(indent)
-				indentAmount += " ";
+	return 0;
+}
 
-			return 0;
-		}
-		#if defined _WIN32 || defined _WIN64
-			else if(funcName == "cat")
-				funcName = "type";
-			else if(funcName == "cp")
-				funcName = "copy";
-		#else
-			else if(funcName == "copy")
-				funcName = "cp";
-		#endif
-		else if(funcName == "cssinclude")
+int Parser::builtin_precision(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size())
+	{
+		if(params[0] == "fixed")
+			vars.fixedPrecision = 1;
+		else if(params[0] == "!fixed")
+			vars.fixedPrecision = 0;
+		else if(params[0] == "scientific")
+			vars.scientificPrecision = 1;
+		else if(params[0] == "!scientific")
+			vars.scientificPrecision = 0;
+		else if(params[0] == "hexfloat")
+			vars.fixedPrecision = vars.scientificPrecision = 1;
+		else if(params[0] == "!hexfloat")
+			vars.fixedPrecision = vars.scientificPrecision = 0;
+		else if(params[0] == "defaultfloat")
+			vars.fixedPrecision = vars.scientificPrecision = 0;
+		else if(!isNonNegInt(params[0]))
 		{
-			if(params.size() != 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "cssinclude: expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
-			std::string cssPathStr = params[0];
-			Path cssPath;
-			cssPath.set_file_path_from(cssPathStr);
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "precision: parameter should be 'fixed', '!fixed', 'scientific', '!scientific', 'hexfloat', '!hexfloat', 'defaultfloat' or a non-negative integer, got " << params[0] << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+		else
+			vars.precision = std::atoi(params[0].c_str());
+	}
+	else
+	{
+		outStr += std::to_string(vars.precision); //check this
+		if(indent)
+			indentAmount.add_text(std::to_string(vars.precision));
+	}
 
-			//warns user if css file doesn't exist
-			if(!file_exists(cssPathStr.c_str()))
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_warn(eos, readPath, lineNo) << "cssinclude: css file " << cssPath << " does not exist" << std::endl;
-				if(!consoleLocked)
-					os_mtx->unlock();
-			}
+	return 0;
+}
 
-			Path pathToCSSFile(pathBetween(toBuild.outputPath.dir, cssPath.dir), cssPath.file);
+int Parser::builtin_pwd(FnCall& call)
+{
+	const bool& indent = call.indent;
+	std::string& outStr = call.outStr;
 
-			std::string cssInclude = "<link rel=\"stylesheet\" type=\"text/css\" href=\"" + pathToCSSFile.str() + "\"";
-			if(options.size())
-				for(size_t o=0; o<options.size(); ++o)
-					cssInclude += " " + options[o];
-			cssInclude += ">";
+	std::string pwd = get_pwd();
+	outStr += pwd;
+	if(indent)
+		indentAmount.add_text(pwd);
 
-			outStr += cssInclude;
-			if(indent)
-				indentAmount += into_whitespace(cssInclude);
+	return 0;
+}
 
-			return 0;
-		}
+int Parser::builtin_poke(FnCall& call)
+{
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size() == 0)
+	{
+		if(read_sh_params(params, ' ', linePos, inStr, readPath, lineNo, funcName, eos))
+			return 1;
 	}
-	else if(funcName[0] == '!')
+
+	if(params.size() == 0)
 	{
-		if(funcName == "!" && params.size() == 1)
-		{
-			if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "!", eos))
-				return 1;
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "poke: expected parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-			bool result;
+	bool createFiles = 1,
+	     mt = 0;
 
-			if(!get_bool(result, params[0], readPath, lineNo, "!", eos))
-				return 1;
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "dirs")
+				createFiles = 0;
+			else if(options[o] == "mt")
+				mt = 1;
+		}
+	}
 
-			outStr += std::to_string(!result);
-			indentAmount += " ";
+	if(mt)
+	{
+		size_t max_p,
+		       no_thrds = std::atoi(params[0].c_str()),
+		       trans = std::ceil((double)(params.size()-1)/(double)no_thrds);
+		std::vector<std::thread> threads;
 
-			return 0;
-		}
-		else if(funcName == "!=" && params.size())
+		for(size_t min_p = 1; min_p<params.size(); min_p=max_p)
 		{
-			if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "!=", eos))
-				return 1;
-
-			bool doDouble = 0, doString = 0;
+			max_p = std::min(min_p+trans, params.size());
+			threads.push_back(std::thread(create_files_thread, params, min_p, max_p));
+		}
 
-			for(size_t p=0; p<params.size(); p++)
+		for(size_t i=0; i<threads.size(); ++i)
+			threads[i].join();
+	}
+	else
+	{
+		Path path;
+		for(size_t p=0; p<params.size(); p++)
+		{
+			path.set_file_path_from(params[p]);
+			if(createFiles)
+				path.ensureFileExists();
+			else
 			{
-				if(isDouble(params[p]))
+				if(path.file.size())
 				{
-					if(!doDouble && !isInt(params[p]))
-						doDouble = 1;
-				}
-				else
-				{
-					doString = 1;
-					break;
-				}
-			}
-
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "d" || options[o] == "double")
-					{
-						doDouble = 1;
-						doString = 0;
-					}
-					else if(options[o] == "s" || options[o] == "string")
-					{
-						doString = 1;
-						doDouble = 0;
-					}
-				}
-			}
-
-			std::string result = "1";
-
-			if(doString)
-			{
-				for(size_t p=0; p+1<params.size(); p++)
-				{
-					for(size_t q=p+1; q<params.size(); q++)
-					{
-						if(params[p] == params[q])
-						{
-							result = "0";
-							break;
-						}
-					}
+					if(path.dir.size())
+						path.dir += "/" + path.file + "/";
+					else
+						path.dir = "./" + path.file + "/";
 				}
+				path.ensureDirExists();
 			}
-			else if(doDouble)
-			{
-				std::vector<double> doubles(params.size(), 0.0);
+		}
+	}
 
-				for(size_t p=0; p<params.size(); p++)
-					doubles[p] = std::strtod(params[p].c_str(), NULL);
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-				for(size_t d=0; d+1<doubles.size(); d++)
-				{
-					for(size_t e=d+1; e<doubles.size(); e++)
-					{
-						if(doubles[d] == doubles[e])
-						{
-							d = doubles.size();
-							result = "0";
-							break;
-						}
-					}
-				}
-			}
-			else
-			{
-				std::vector<double> ints(params.size(), 0);
+	return 0;
+}
 
-				for(size_t p=0; p<params.size(); p++)
-					ints[p] = std::atoi(params[p].c_str());
+int Parser::builtin_prompt_char(FnCall& call)
+{
+	std::vector<std::string>& params = call.params;
 
-				for(size_t i=0; i+1<ints.size(); i++)
-				{
-					for(size_t j=i+1; j<ints.size(); j++)
-					{
-						if(ints[i] == ints[j])
-						{
-							i = ints.size();
-							result = "0";
-							break;
-						}
-					}
-				}
-			}
+	change_prompt_char(params[0]);
 
-			outStr += result;
-			if(indent)
-				indentAmount += " ";
+	return 0;
+}
 
-			return 0;
-		}
+int Parser::builtin_content(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size() != 0)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo)  << "content: expected 0 parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
 	}
-	else if(funcName[0] == '|')
+
+	contentAdded = 1;
+	std::string toParse = "@input";
+	if(options.size())
 	{
-		if(funcName == "||" && params.size())
-		{
-			bool return_value = 0;
+		toParse += "{" + options[0];
+		for(size_t o=1; o<options.size(); o++)
+			toParse += ", " + options[o];
+		toParse += '}';
+	}
+	toParse += "(" + quote(toBuild.contentPath.str()) + ")";
 
-			if(doNotParse)
-				parseParams = 0;
-			else
-				parseParams = 1;
+	if(n_read_and_process_fast(indent, toParse, lineNo-1, readPath, antiDepsOfReadPath, outStr, eos))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) <<  "failed to insert content" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-			for(size_t p=0; p<params.size(); p++)
-			{
-				if(parseParams && parse_replace(lang, params[p], "||(param[" + std::to_string(p) + "])", readPath, antiDepsOfReadPath, lineNo, "@||", sLineNo, eos))
-					return 1;
+	return 0;
+}
 
-				if(replace_var(params[p], readPath, conditionLineNo, "||", eos))
-					return 1;
+int Parser::builtin_continue(FnCall& /*call*/)
+{
+	return NSM_CONT; //check this??
+}
 
-				if(!get_bool(return_value, params[p], readPath, conditionLineNo, "||", eos))
-					return 1;
+int Parser::builtin_cpy(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size() < 2)
+	{
+		if(read_sh_params(params, ' ', linePos, inStr, readPath, lineNo, funcName, eos))
+			return 1;
+	}
 
-				if(return_value)
-					break;
-			}
+	if(params.size() < 2)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 2+ parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-			outStr += std::to_string(return_value);
-			if(indent)
-				indentAmount += " ";
+	bool backupFiles = 0,
+	     forceFile = 0,
+	     ifNew = 0,
+	     overwrite = 1,
+	     changePermissions = 0, 
+	     prompt = 0,
+	     verbose = 0;
 
-			return 0;
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); ++o)
+		{
+			if(options[o] == "b")
+				backupFiles = 1;
+			else if(options[o] == "f")
+				changePermissions = 1;
+			else if(options[o] == "i")
+				prompt = 1;
+			else if(options[o] == "n")
+				overwrite = 0;
+			else if(options[o] == "T")
+				forceFile = 1;
+			else if(options[o] == "u")
+				ifNew = 1;
+			else if(options[o] == "v")
+				verbose = 1;
 		}
 	}
-	else if(funcName[0] == '&')
-	{
-		if(funcName == "&&" && params.size())
-		{
-			bool return_value = 1;
-
-			if(doNotParse)
-				parseParams = 0;
-			else
-				parseParams = 1;
-
-			for(size_t p=0; p<params.size(); p++)
-			{
-				if(parseParams && parse_replace(lang, params[p], "&&(param[" + std::to_string(p) + "])", readPath, antiDepsOfReadPath, lineNo, "@&&", sLineNo, eos))
-					return 1;
-
-				if(replace_var(params[p], readPath, conditionLineNo, "&&", eos))
-					return 1;
-
-				if(!get_bool(return_value, params[p], readPath, conditionLineNo, "&&", eos))
-					return 1;
 
-				if(!return_value)
-					break;
-			}
+	size_t t = params.size()-1;
+	Path source, target;
+	std::string sourceStr, 
+	            targetStr = replace_home_dir(params[t]),
+	            targetParam = params[t];
+	char promptInput = 'n';
 
-			outStr += std::to_string(return_value);
-			if(indent)
-				indentAmount += " ";
+	params.pop_back();
 
-			return 0;
-		}
-	}
-	else if(funcName[0] == '=')
+	if(params.size() == 1 && 
+	    (forceFile || !dir_exists(targetStr)) && 
+	    params[0].find_first_of('*') == std::string::npos)
 	{
-		if(funcName == "==" && params.size())
+		if(params[0].size() && (params[0][params[0].size()-1] == '/' || params[0][params[0].size()-1] == '\\'))
 		{
-			if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "==", eos))
-				return 1;
+			int pos=params[0].size()-2;
+			while(pos>=0 && (params[0][pos] == '/' || params[0][pos] == '\\'))
+				--pos;
+			params[0] = params[0].substr(0, pos+1);
+		}
 
-			bool doDouble = 0, doString = 0;
+		sourceStr = replace_home_dir(params[0]);
+		source.set_file_path_from(sourceStr);
+		target.set_file_path_from(targetStr);
 
-			for(size_t p=0; p<params.size(); p++)
-			{
-				if(isDouble(params[p]))
-				{
-					if(!doDouble && !isInt(params[p]))
-						doDouble = 1;
-				}
-				else
-				{
-					doString = 1;
-					break;
-				}
-			}
+		if(!path_exists(sourceStr))
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot copy ";
+			eos << quote(params[0]) << " as path does not exist" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			if(options.size())
+		if(overwrite || !file_exists(targetStr))
+		{
+			if(!ifNew || source.modified_after(target))
 			{
-				for(size_t o=0; o<options.size(); o++)
+				if(changePermissions)
 				{
-					if(options[o] == "d" || options[o] == "double")
-					{
-						doDouble = 1;
-						doString = 0;
-					}
-					else if(options[o] == "s" || options[o] == "string")
-					{
-						doString = 1;
-						doDouble = 0;
-					}
+					if(file_exists(targetStr))
+						chmod(targetStr.c_str(), 0666);
+					else if(dir_exists(targetStr))
+						chmod(targetStr.c_str(), S_IRWXU);
 				}
-			}
-
-			std::string result = "1";
 
-			if(doString)
-			{
-				for(size_t p=1; p<params.size(); p++)
+				if((prompt && promptInput != 'a') || verbose)
 				{
-					if(params[p-1] != params[p])
+					eos << quote(params[0]) << " -> " << quote(params[1]) << std::endl;
+
+					if(prompt && promptInput != 'a')
 					{
-						result = "0";
-						break;
+						eos << "? " << std::flush;
+						promptInput = nsm_getch();
+						if(promptInput == 'Y' || promptInput == '1')
+							promptInput = 'y';
+						else if(promptInput == 'A')
+							promptInput = 'a';
 					}
+					
+					eos << std::endl;
 				}
-			}
-			else if(doDouble)
-			{
-				double cDouble, nDouble = std::strtod(params[0].c_str(), NULL);
-				for(size_t p=1; p<params.size(); p++)
+
+				if(!prompt || promptInput == 'y' || promptInput == 'a')
 				{
-					cDouble = nDouble;
-					nDouble = std::strtod(params[p].c_str(), NULL);
-					if(cDouble != nDouble)
+					if(backupFiles && path_exists(targetStr))
+						rename(targetStr.c_str(), (targetStr + "~").c_str());
+
+					if(dir_exists(sourceStr))
 					{
-						result = "0";
-						break;
+						if(cpDir(sourceStr, targetStr, sLineNo, readPath, eos, consoleLocked, os_mtx))
+						{
+							if(!consoleLocked)
+								os_mtx->lock();
+							start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to copy directory ";
+							eos << quote(params[0]) << " to " << quote(targetParam) << std::endl;
+							os_mtx->unlock();
+							return 1;
+						}
 					}
-				}
-			}
-			else
-			{
-				int cInt, nInt = std::atoi(params[0].c_str());
-				for(size_t p=1; p<params.size(); p++)
-				{
-					cInt = nInt;
-					nInt = std::atoi(params[p].c_str());
-					if(cInt != nInt)
+					else if(cpFile(sourceStr, targetStr, sLineNo, readPath, eos, consoleLocked, os_mtx))
 					{
-						result = "0";
-						break;
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to copy file ";
+						eos << quote(params[0]) << " to " << quote(targetParam) << std::endl;
+						os_mtx->unlock();
+						return 1;
 					}
 				}
 			}
+		}
+	}
+	else
+	{
+		if(!dir_exists(targetStr))
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot copy files to ";
+			eos << quote(targetStr) << " as directory does not exist" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			outStr += result;
-			if(indent)
-				indentAmount += " ";
+		char endChar = targetStr[targetStr.size()-1];
+		if(endChar != '/' && endChar != '\\')
+			targetStr += "/";
+		target.set_file_path_from(targetStr);
 
-			return 0;
+		struct stat  oldDirPerms;
+		if(changePermissions)
+		{
+			stat(targetStr.c_str(), &oldDirPerms);
+			chmod(target.dir.c_str(), S_IRWXU);
 		}
-		else if(funcName == "=" && params.size())
+		else if(!can_write(targetStr))
 		{
-			bool readBlock = 0, parseBlock = 0;
-			char bLang = lang;
-			int bLineNo = lineNo;
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot write to " << quote(target.dir) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			if(options.size())
+		std::vector<Path> sources;
+		for(size_t p=0; p<params.size(); ++p)
+		{
+			if(params[p].size() && (params[p][params[p].size()-1] == '/' || params[p][params[p].size()-1] == '\\'))
 			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "b" || options[o] == "block")
-						readBlock = 1;
-					else if(options[o] == "pb")
-						parseBlock = 1;
-					else if(options[o] == "f++")
-						bLang = 'f';
-					else if(options[o] == "n++")
-						bLang = 'n';
-				}
+				int pos=params[p].size()-2; 
+				while(pos>=0 && (params[p][pos] == '/' || params[p][pos] == '\\'))
+					--pos;
+				params[p] = params[p].substr(0, pos+1);
 			}
 
-			if(readBlock)
-			{
-				params.push_back("");
-				if(read_block(params[params.size()-1], linePos, inStr, readPath, lineNo, bLineNo, "=", eos))
-					return 1;
-
-				if(parseBlock && parse_replace(bLang, params[params.size()-1], "= block", readPath, antiDepsOfReadPath, bLineNo, "=", sLineNo, eos))
-					return 1;
-			}
-			else if(params.size() < 2)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "=: expected 2+ parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+			sourceStr = replace_home_dir(params[p]);
+			source.set_file_path_from(sourceStr);
+			sources.push_back(source);
 
-			VPos vpos;
-			std::string value = params[params.size()-1];
-			for(size_t p=0; p+1<params.size(); p++)
+			if(!path_exists(sourceStr))
 			{
-				if(vars.find(params[p], vpos))
+				if(sourceStr.find_first_of('*') != std::string::npos)
 				{
-					if(!set_var_from_str(vpos, value, readPath, sLineNo, "=", eos))
+					std::string parsedTxt, toParse = "@lst{!c, 1, P}(" + sourceStr + ")";
+					int parseLineNo = 0;
+
+					if(n_read_and_process_fast(indent, toParse, parseLineNo, readPath, antiDepsOfReadPath, parsedTxt, eos))
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) <<  funcName << ": failed to list " << quote(sourceStr) << std::endl;
+						os_mtx->unlock();
 						return 1;
+					}
+
+					std::istringstream iss(parsedTxt);
+					while(getline(iss, sourceStr))
+						params.push_back(sourceStr);
+
+					continue;
 				}
 				else
 				{
 					if(!consoleLocked)
 						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "=: no variable named " << quote(params[p]) << std::endl;
+					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot copy ";
+					eos << quote(params[p]) << " as path does not exist" << std::endl;
 					os_mtx->unlock();
 					return 1;
 				}
 			}
 
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
-
-			return 0;
-		}
-	}
-	else if(funcName[0] == '<')
-	{
-		if(funcName == "<" && params.size())
-		{
-			if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "<", eos))
-				return 1;
-
-			bool doDouble = 0, doString = 0;
-			int typeInt;
+			target.file = source.file;
+			targetStr = target.str();
 
-			for(size_t p=0; p<params.size(); p++)
+			if(overwrite || !file_exists(targetStr))
 			{
-				typeInt = getTypeInt(params[p]);
-
-				if(typeInt == 1)
-					doDouble = 1;
-				else if(typeInt == 2)
+				if(!ifNew || source.modified_after(target))
 				{
-					doString = 1;
-					break;
-				}
-			}
+					if(changePermissions && file_exists(targetStr))
+						chmod(targetStr.c_str(), 0666);
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "d" || options[o] == "double")
-					{
-						doDouble = 1;
-						doString = 0;
-					}
-					else if(options[o] == "s" || options[o] == "string")
+					if((prompt && promptInput != 'a') || verbose)
 					{
-						doString = 1;
-						doDouble = 0;
-					}
-				}
-			}
+						if(targetParam.size())
+						{
+							endChar = targetParam[targetParam.size()-1];
+							if(endChar != '/' && endChar != '\\')
+								targetParam += '/';
+						}
 
-			std::string result = "1";
+						eos << quote(params[p]) << " -> " << quote(targetParam + source.file);
 
-			if(doString)
-			{
-				for(size_t p=1; p<params.size(); p++)
-				{
-					if(params[p-1] >= params[p])
-					{
-						result = "0";
-						break;
-					}
-				}
-			}
-			else if(doDouble)
-			{
-				double cDouble, nDouble = std::strtod(params[0].c_str(), NULL);
-				for(size_t p=1; p<params.size(); p++)
-				{
-					cDouble = nDouble;
-					nDouble = std::strtod(params[p].c_str(), NULL);
-					if(cDouble >= nDouble)
-					{
-						result = "0";
-						break;
+						if(prompt && promptInput != 'a')
+						{
+							eos << "? " << std::flush;
+							promptInput = nsm_getch();
+							if(promptInput == 'Y' || promptInput == '1')
+								promptInput = 'y';
+							else if(promptInput == 'A')
+								promptInput = 'a';
+						}
+						
+						eos << std::endl;
 					}
-				}
-			}
-			else
-			{
-				int cInt, nInt = std::atoi(params[0].c_str());
-				for(size_t p=1; p<params.size(); p++)
-				{
-					cInt = nInt;
-					nInt = std::atoi(params[p].c_str());
-					if(cInt >= nInt)
+
+					if(!prompt || promptInput == 'y' || promptInput == 'a')
 					{
-						result = "0";
-						break;
-					}
-				}
-			}
-
-			outStr += result;
-			if(indent)
-				indentAmount += " ";
-
-			return 0;
-		}
-		else if(funcName == "<=" && params.size())
-		{
-			if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "<=", eos))
-				return 1;
+						if(backupFiles && path_exists(targetStr))
+							rename(targetStr.c_str(), (targetStr + "~").c_str());
 
-			bool doDouble = 0, doString = 0;
-			int typeInt;
 
-			for(size_t p=0; p<params.size(); p++)
-			{
-				typeInt = getTypeInt(params[p]);
+						if(dir_exists(sourceStr))
+						{
+							if(cpDir(sourceStr, targetStr, sLineNo, readPath, eos, consoleLocked, os_mtx))
+							{
+								if(targetParam.size())
+								{
+									endChar = targetParam[targetParam.size()-1];
+									if(endChar != '/' && endChar != '\\')
+										targetParam += '/';
+								}
 
-				if(typeInt == 1)
-					doDouble = 1;
-				else if(typeInt == 2)
-				{
-					doString = 1;
-					break;
-				}
-			}
+								if(!consoleLocked)
+									os_mtx->lock();
+								start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to copy directory ";
+								eos << quote(params[p]) << " to " << quote(targetParam + source.file) << std::endl;
+								os_mtx->unlock();
+								return 1;
+							}
+						}
+						else if(cpFile(sourceStr, targetStr, sLineNo, readPath, eos, consoleLocked, os_mtx))
+						{
+							if(targetParam.size())
+							{
+								endChar = targetParam[targetParam.size()-1];
+								if(endChar != '/' && endChar != '\\')
+									targetParam += '/';
+							}
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "d" || options[o] == "double")
-					{
-						doDouble = 1;
-						doString = 0;
-					}
-					else if(options[o] == "s" || options[o] == "string")
-					{
-						doString = 1;
-						doDouble = 0;
+							if(!consoleLocked)
+								os_mtx->lock();
+							start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to copy file ";
+							eos << quote(params[p]) << " to " << quote(targetParam + source.file) << std::endl;
+							os_mtx->unlock();
+							return 1;
+						}
 					}
 				}
 			}
+		}
 
-			std::string result = "1";
-
-			if(doString)
-			{
-				for(size_t p=1; p<params.size(); p++)
-				{
-					if(params[p-1] > params[p])
-					{
-						result = "0";
-						break;
-					}
-				}
-			}
-			else if(doDouble)
-			{
-				double cDouble, nDouble = std::strtod(params[0].c_str(), NULL);
-				for(size_t p=1; p<params.size(); p++)
-				{
-					cDouble = nDouble;
-					nDouble = std::strtod(params[p].c_str(), NULL);
-					if(cDouble > nDouble)
-					{
-						result = "0";
-						break;
-					}
-				}
-			}
-			else
-			{
-				int cInt, nInt = std::atoi(params[0].c_str());
-				for(size_t p=1; p<params.size(); p++)
-				{
-					cInt = nInt;
-					nInt = std::atoi(params[p].c_str());
-					if(cInt > nInt)
-					{
-						result = "0";
-						break;
-					}
-				}
-			}
+		if(changePermissions)
+			chmod(target.dir.c_str(), oldDirPerms.st_mode);
+	}
+	
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-			outStr += result;
-			if(indent)
-				indentAmount += " ";
+	return 0;
+}
 
-			return 0;
-		}
+int Parser::builtin_const(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size() < 1)
+	{
+		if(read_sh_params(params, ',', linePos, inStr, readPath, lineNo, funcName, eos))
+			return 1;
 	}
-	else if(funcName[0] == '>')
+
+	std::string toParse = "@:=";
+	toParse += "{const";
+	for(size_t o=0; o<options.size(); ++o)
+		toParse += ", " + options[o];
+	toParse += '}';
+	if(params.size())
 	{
-		if(funcName == ">" && params.size())
+		int depth=0;
+		for(size_t pos=0; pos<params[0].size(); ++pos)
 		{
-			if(replaceVars && replace_vars(params, 0, readPath, sLineNo, ">", eos))
-				return 1;
-
-			bool doDouble = 0, doString = 0;
-			int typeInt;
-
-			for(size_t p=0; p<params.size(); p++)
-			{
-				typeInt = getTypeInt(params[p]);
-
-				if(typeInt == 1)
-					doDouble = 1;
-				else if(typeInt == 2)
-				{
-					doString = 1;
-					break;
-				}
-			}
-
-			if(options.size())
+			if(params[0][pos] == '<' || params[0][pos] == '[')
+				++depth;
+			else if(params[0][pos] == '>' || params[0][pos] == ']')
+				--depth;
+			else if(params[0][pos] == '"')
+				pos = params[0].find_first_of('"', pos+1);
+			else if(params[0][pos] == '\'')
+				pos = params[0].find_first_of('\'', pos+1);
+			else if(depth == 0 && params[0][pos] == ' ')
 			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "d" || options[o] == "double")
-					{
-						doDouble = 1;
-						doString = 0;
-					}
-					else if(options[o] == "s" || options[o] == "string")
-					{
-						doString = 1;
-						doDouble = 0;
-					}
-				}
+				params[0][pos] = ',';
+				break;
 			}
+		}
+		toParse += "(" + params[0];
+		for(size_t p=1; p<params.size(); ++p)
+			toParse += ", " + params[p];
+		toParse += ')';
+	}
 
-			std::string result = "1";
+	if(n_read_and_process_fast(indent, toParse, lineNo-1, readPath, antiDepsOfReadPath, outStr, eos))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) <<  "const: constant definition failed" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-			if(doString)
-			{
-				for(size_t p=1; p<params.size(); p++)
-				{
-					if(params[p-1] <= params[p])
-					{
-						result = "0";
-						break;
-					}
-				}
-			}
-			else if(doDouble)
-			{
-				double cDouble, nDouble = std::strtod(params[0].c_str(), NULL);
-				for(size_t p=1; p<params.size(); p++)
-				{
-					cDouble = nDouble;
-					nDouble = std::strtod(params[p].c_str(), NULL);
-					if(cDouble <= nDouble)
-					{
-						result = "0";
-						break;
-					}
-				}
-			}
-			else
-			{
-				int cInt, nInt = std::atoi(params[0].c_str());
-				for(size_t p=1; p<params.size(); p++)
-				{
-					cInt = nInt;
-					nInt = std::atoi(params[p].c_str());
-					if(cInt <= nInt)
-					{
-						result = "0";
-						break;
-					}
-				}
-			}
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-			outStr += result;
-			if(indent)
-				indentAmount += " ";
+	return 0;
+}
 
-			return 0;
-		}
-		else if(funcName == ">=" && params.size())
-		{
-			if(replaceVars && replace_vars(params, 0, readPath, sLineNo, ">=", eos))
-				return 1;
+int Parser::builtin_cd(FnCall& call)
+{
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size() < 1)
+	{
+		if(read_sh_params(params, ' ', linePos, inStr, readPath, lineNo, funcName, eos))
+			return 1;
+	}
 
-			bool doDouble = 0, doString = 0;
-			int typeInt;
+	if(params.size() != 1)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "cd: expected 1 parameter, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-			for(size_t p=0; p<params.size(); p++)
-			{
-				typeInt = getTypeInt(params[p]);
+	std::string target = replace_home_dir(params[0]);
 
-				if(typeInt == 1)
-					doDouble = 1;
-				else if(typeInt == 2)
-				{
-					doString = 1;
-					break;
-				}
-			}
+	if(!dir_exists(target))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "cd: cannot change directory to " << quote(params[0]) << " as it is not a directory" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "d" || options[o] == "double")
-					{
-						doDouble = 1;
-						doString = 0;
-					}
-					else if(options[o] == "s" || options[o] == "string")
-					{
-						doString = 1;
-						doDouble = 0;
-					}
-				}
-			}
+	if(chdir(target.c_str()))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "cd: failed to change directory to " << quote(params[0]) << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-			std::string result = "1";
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-			if(doString)
-			{
-				for(size_t p=1; p<params.size(); p++)
-				{
-					if(params[p-1] <= params[p])
-					{
-						result = "0";
-						break;
-					}
-				}
-			}
-			else if(doDouble)
-			{
-				double cDouble, nDouble = std::strtod(params[0].c_str(), NULL);
-				for(size_t p=1; p<params.size(); p++)
-				{
-					cDouble = nDouble;
-					nDouble = std::strtod(params[p].c_str(), NULL);
-					if(cDouble < nDouble)
-					{
-						result = "0";
-						break;
-					}
-				}
-			}
-			else
-			{
-				int cInt, nInt = std::atoi(params[0].c_str());
-				for(size_t p=1; p<params.size(); p++)
-				{
-					cInt = nInt;
-					nInt = std::atoi(params[p].c_str());
-					if(cInt < nInt)
-					{
-						result = "0";
-						break;
-					}
-				}
-			}
+	return 0;
+}
 
-			outStr += result;
-			if(indent)
-				indentAmount += " ";
+int Parser::builtin_console(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const char& lang = call.lang;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	bool readBlock = 0, parseBlock = 1;
+	int bLineNo = lineNo;
+	std::string txt;
 
-			return 0;
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "b" || options[o] == "block")
+				readBlock = 1;
+			else if(options[o] == "!pb")
+				parseBlock = 0;
 		}
 	}
-	else if(funcName[0] == '+')
+
+	if(!params.size())
+		readBlock = 1;
+
+	if(readBlock)
 	{
-		if(funcName == "+" && params.size())
+		if(params.size() != 0)
 		{
-			if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "+", eos))
-				return 1;
-
-			bool doDouble = 0, doString = 0;
-			int typeInt;
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "console{block}: expected 0 parameters, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			for(size_t p=0; p<params.size(); p++)
-			{
-				typeInt = getTypeInt(params[p]);
+		if(read_block(txt, linePos, inStr, readPath, lineNo, bLineNo, "console", eos))
+		   return 1;
 
-				if(typeInt == 1)
-					doDouble = 1;
-				else if(typeInt == 2)
-				{
-					doString = 1;
-					break;
-				}
-			}
+		if(parseBlock && parse_replace(lang, txt, "console block", readPath, antiDepsOfReadPath, bLineNo, "console", sLineNo, eos))
+			return 1;
+	}
 
-			if(options.size())
+	VPos vpos;
+	Indent gIndentAmount;
+	for(size_t p=0; p<params.size(); p++)
+	{
+		if(params[p] == "endl")
+			txt += "\r\n";
+		else if(replaceVars && vars.find(params[p], vpos))
+		{
+			gIndentAmount.clear();
+			if(!vars.add_str_from_var(vpos, txt, 1, indent, gIndentAmount))
 			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "d" || options[o] == "double")
-					{
-						doDouble = 1;
-						doString = 0;
-					}
-					else if(options[o] == "s" || options[o] == "string")
-					{
-						doString = 1;
-						doDouble = 0;
-					}
-				}
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "console: cannot get string of var type " << quote(vpos.type) << std::endl;
+				os_mtx->unlock();
+				return 1;
 			}
+		}
+		else
+			txt += params[p];
+	}
 
-			if(doString)
-			{
-				for(size_t p=1; p<params.size(); p++)
-					params[0] += params[p];
-			}
-			else if(doDouble)
-			{
-				double ans = std::strtod(params[0].c_str(), NULL);
-				for(size_t p=1; p<params.size(); p++)
-					ans += std::strtod(params[p].c_str(), NULL);
+	if(!consoleLocked)
+		os_mtx->lock();
+	if(lolcatActive)
+		rnbwcout(txt);
+	else
+		eos << txt << std::endl;
+	if(!consoleLocked)
+		os_mtx->unlock();
 
-				params[0] = vars.double_to_string(ans, 0);
-			}
-			else
-			{
-				int ans = std::atoi(params[0].c_str());
-				for(size_t p=1; p<params.size(); p++)
-					ans += std::atoi(params[p].c_str());
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-				params[0] = std::to_string(ans);
-			}
+	return 0;
+}
 
-			outStr += params[0];
-			if(indent)
-				indentAmount += into_whitespace(params[0]);
+int Parser::builtin_console_lock(FnCall& call)
+{
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
 
-			return 0;
-		}
-		else if(funcName == "+=" && params.size())
-		{
-			if(params.size() < 2)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "+=: expected 2+ parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	if(consoleLocked)
+	{
+		//os_mtx->lock(); //is already locked from this thread
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "console.lock: console is already locked" << std::endl;
+		os_mtx->unlock();
+		consoleLocked = 0;
+		return 1;
+	}
+	else
+	{
+		consoleLocked = 1;
+		consoleLockedOnLine = lineNo;
+		consoleLockedPath = readPath;
+	}
 
-			VPos vpos;
-			if(vars.find(params[0], vpos))
-			{
-				if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "+=", eos))
-					return 1;
+	os_mtx->lock();
 
-				bool doDouble = 0, doString = 0;
-				int typeInt;
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-				for(size_t p=0; p<params.size(); p++)
-				{
-					typeInt = getTypeInt(params[p]);
+	return 0;
+}
 
-					if(typeInt == 1)
-						doDouble = 1;
-					else if(typeInt == 2)
-					{
-						doString = 1;
-						break;
-					}
-				}
+int Parser::builtin_console_unlock(FnCall& call)
+{
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
 
-				if(options.size())
-				{
-					for(size_t o=0; o<options.size(); o++)
-					{
-						if(options[o] == "d" || options[o] == "double")
-						{
-							doDouble = 1;
-							doString = 0;
-						}
-						else if(options[o] == "s" || options[o] == "string")
-						{
-							doString = 1;
-							doDouble = 0;
-						}
-					}
-				}
+	if(consoleLocked)
+		consoleLocked = 0;
+	else
+	{
+		os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "console.unlock: console is not locked from this thread" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-				if(doString)
-				{
-					for(size_t p=1; p<params.size(); p++)
-						params[0] += params[p];
-				}
-				else if(doDouble)
-				{
-					double ans = std::strtod(params[0].c_str(), NULL);
-					for(size_t p=1; p<params.size(); p++)
-						ans += std::strtod(params[p].c_str(), NULL);
+	os_mtx->unlock();
 
-					params[0] = vars.double_to_string(ans, 0);
-				}
-				else
-				{
-					int ans = std::atoi(params[0].c_str());
-					for(size_t p=1; p<params.size(); p++)
-						ans += std::atoi(params[p].c_str());
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-					params[0] = std::to_string(ans);
-				}
+	return 0;
+}
 
-				if(!set_var_from_str(vpos, params[0], readPath, sLineNo, "+=", eos))
-					return 1;
-			}
-			else
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "+=: there are no variables defined as " << quote(params[0]) << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+int Parser::builtin_console_locked(FnCall& call)
+{
+	const bool& indent = call.indent;
+	std::string& outStr = call.outStr;
 
-			return 0;
-		}
-		else if(funcName == "++" && params.size())
-		{
-			VPos vpos;
-			for(size_t p=0; p<params.size(); p++)
-			{
-				if(vars.find(params[p], vpos))
-				{
-					if(vars.layers[vpos.layer].constants.count(params[p]))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "++: attempted illegal change of constant variable " << quote(params[p]) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-					else if(vars.layers[vpos.layer].privates.count(params[p]))
-					{
-						if(!vars.layers[vpos.layer].inScopes[params[p]].count(vars.layers[vars.layers.size()-1].scope))
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << "++: attempted illegal change of private variable " << quote(params[p]) << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-					}
+	outStr += std::to_string(consoleLocked);
+	if(indent)
+		indentAmount += ' ';
 
-					if(p == 0 && addOutput)
-					{
-						if(!vars.add_str_from_var(vpos, outStr, 1, indent, indentAmount))
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << "++: cannot get string of var type " << quote(vpos.type) << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-					}
+	return 0;
+}
 
-					if(vpos.type.substr(0, 5) == "std::")
-					{
-						if(vpos.type == "std::int")
-							++vars.layers[vpos.layer].ints[params[p]];
-						else if(vpos.type == "std::bool")
-						{
-							if(vars.layers[vpos.layer].bools[params[p]])
-								vars.layers[vpos.layer].bools[params[p]] = 0;
-							else
-								vars.layers[vpos.layer].bools[params[p]] = 1;
-						}
-						else if(vpos.type == "std::double")
-							++vars.layers[vpos.layer].doubles[params[p]];
-						else if(vpos.type == "std::char")
-							++vars.layers[vpos.layer].chars[params[p]];
-						else if(vpos.type == "std::llint")
-							++vars.layers[vpos.layer].llints[params[p]];
-					}
-					else if(vpos.type == "int")
-						++vars.layers[vpos.layer].doubles[params[p]];
-					else if(vpos.type == "bool")
-					{
-						if(vars.layers[vpos.layer].doubles[params[p]])
-							vars.layers[vpos.layer].doubles[params[p]] = 0;
-						else
-							vars.layers[vpos.layer].doubles[params[p]] = 1;
-					}
-					else if(vpos.type == "double")
-						++vars.layers[vpos.layer].doubles[params[p]];
-					else if(vpos.type == "char" && vars.layers[vpos.layer].strings[params[p]].size())
-						++vars.layers[vpos.layer].strings[params[p]][0];
-					else
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "++: operator not defined for variable ";
-						eos << quote(params[p]) << " of type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "++: no variable named " << quote(params[p]) << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
+int Parser::builtin_cssinclude(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	std::string cssPathStr = params[0];
+	Path cssPath;
+	cssPath.set_file_path_from(cssPathStr);
+
+	//warns user if css file doesn't exist
+	if(!file_exists(cssPathStr.c_str()))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_warn(eos, readPath, lineNo) << "cssinclude: css file " << cssPath << " does not exist" << std::endl;
+		if(!consoleLocked)
+			os_mtx->unlock();
+	}
 
-			return 0;
-		}
-		else if(funcName == "+++" && params.size())
-		{
-			if(hasIncrement)
-				funcName = "++";
+	Path pathToCSSFile(pathBetween(toBuild.outputPath.dir, cssPath.dir), cssPath.file);
 
-			VPos vpos;
-			for(size_t p=0; p<params.size(); p++)
-			{
-				if(vars.find(params[p], vpos))
-				{
-					if(vars.layers[vpos.layer].constants.count(params[p]))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": attempted illegal change of constant variable " << quote(params[p]) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-					else if(vars.layers[vpos.layer].privates.count(params[p]))
-					{
-						if(!vars.layers[vpos.layer].inScopes[params[p]].count(vars.layers[vars.layers.size()-1].scope))
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": attempted illegal change of private variable " << quote(params[p]) << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-					}
+	std::string cssInclude = "<link rel=\"stylesheet\" type=\"text/css\" href=\"" + pathToCSSFile.str() + "\"";
+	if(options.size())
+		for(size_t o=0; o<options.size(); ++o)
+			cssInclude += " " + options[o];
+	cssInclude += ">";
 
-					if(vpos.type.substr(0, 5) == "std::")
-					{
-						if(vpos.type == "std::int")
-							++vars.layers[vpos.layer].ints[params[p]];
-						else if(vpos.type == "std::bool")
-						{
-							if(vars.layers[vpos.layer].bools[params[p]])
-								vars.layers[vpos.layer].bools[params[p]] = 0;
-							else
-								vars.layers[vpos.layer].bools[params[p]] = 1;
-						}
-						else if(vpos.type == "std::double")
-							++vars.layers[vpos.layer].doubles[params[p]];
-						else if(vpos.type == "std::char")
-							++vars.layers[vpos.layer].chars[params[p]];
-						else if(vpos.type == "std::llint")
-							++vars.layers[vpos.layer].llints[params[p]];
-					}
-					else if(vpos.type == "int")
-						++vars.layers[vpos.layer].doubles[params[p]];
-					else if(vpos.type == "bool")
-					{
-						if(vars.layers[vpos.layer].doubles[params[p]])
-							vars.layers[vpos.layer].doubles[params[p]] = 0;
-						else
-							vars.layers[vpos.layer].doubles[params[p]] = 1;
-					}
-					else if(vpos.type == "double")
-						++vars.layers[vpos.layer].doubles[params[p]];
-					else if(vpos.type == "char" && vars.layers[vpos.layer].strings[params[p]].size())
-						++vars.layers[vpos.layer].strings[params[p]][0];
-					else
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": operator not defined for variable ";
-						eos << quote(params[p]) << " of type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
+	outStr += cssInclude;
+	if(indent)
+		indentAmount.add_text(cssInclude);
 
-					if(p == 0 && addOutput)
-					{
-						if(!vars.add_str_from_var(vpos, outStr, 1, indent, indentAmount))
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot get string of var type " << quote(vpos.type) << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-					}
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": no variable named " << quote(params[p]) << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
+	return 0;
+}
 
-			return 0;
+int Parser::builtin_not(FnCall& call)
+{
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(params.size() != 1)
+		return NSM_NOT_BUILTIN;
+
+	if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "!", eos))
+		return 1;
+
+	bool result;
+
+	if(!get_bool(result, params[0], readPath, lineNo, "!", eos))
+		return 1;
+
+	outStr += std::to_string(!result);
+	indentAmount += ' ';
+
+	return 0;
+}
+
+int Parser::builtin_not_equal(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "!=", eos))
+		return 1;
+
+	bool doDouble = 0, doString = 0;
+
+	for(size_t p=0; p<params.size(); p++)
+	{
+		if(isDouble(params[p]))
+		{
+			if(!doDouble && !isInt(params[p]))
+				doDouble = 1;
+		}
+		else
+		{
+			doString = 1;
+			break;
 		}
 	}
-	else if(funcName[0] == '-')
+
+	if(options.size())
 	{
-		if(funcName == "-" && params.size())
+		for(size_t o=0; o<options.size(); o++)
 		{
-			if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "-", eos))
-				return 1;
+			if(options[o] == "d" || options[o] == "double")
+			{
+				doDouble = 1;
+				doString = 0;
+			}
+			else if(options[o] == "s" || options[o] == "string")
+			{
+				doString = 1;
+				doDouble = 0;
+			}
+		}
+	}
 
-			bool doDouble = 0;
-			int typeInt;
+	std::string result = "1";
 
-			for(size_t p=0; p<params.size(); p++)
+	if(doString)
+	{
+		for(size_t p=0; p+1<params.size(); p++)
+		{
+			for(size_t q=p+1; q<params.size(); q++)
 			{
-				typeInt = getTypeInt(params[p]);
-
-				if(typeInt == 1)
-					doDouble = 1;
-				else if(typeInt == 2)
+				if(params[p] == params[q])
 				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "-: cannot perform operator on " << params[p] << std::endl;
-					os_mtx->unlock();
-					return 1;
+					result = "0";
+					break;
 				}
 			}
+		}
+	}
+	else if(doDouble)
+	{
+		std::vector<double> doubles(params.size(), 0.0);
+
+		for(size_t p=0; p<params.size(); p++)
+			doubles[p] = std::strtod(params[p].c_str(), NULL);
 
-			if(options.size())
+		for(size_t d=0; d+1<doubles.size(); d++)
+		{
+			for(size_t e=d+1; e<doubles.size(); e++)
 			{
-				for(size_t o=0; o<options.size(); o++)
+				if(doubles[d] == doubles[e])
 				{
-					if(options[o] == "d" || options[o] == "double")
-						doDouble = 1;
+					d = doubles.size();
+					result = "0";
+					break;
 				}
 			}
+		}
+	}
+	else
+	{
+		std::vector<double> ints(params.size(), 0);
 
-			if(doDouble)
-			{
-				double ans;
-				if(params.size() == 1)
-					ans = -std::strtod(params[0].c_str(), NULL);
-				else
-				{
-					ans = std::strtod(params[0].c_str(), NULL);
-					for(size_t p=1; p<params.size(); p++)
-						ans -= std::strtod(params[p].c_str(), NULL);
-				}
+		for(size_t p=0; p<params.size(); p++)
+			ints[p] = std::atoi(params[p].c_str());
 
-				params[0] = vars.double_to_string(ans, 0);
-			}
-			else
+		for(size_t i=0; i+1<ints.size(); i++)
+		{
+			for(size_t j=i+1; j<ints.size(); j++)
 			{
-				int ans;
-				if(params.size() == 1)
-					ans = -std::atoi(params[0].c_str());
-				else
+				if(ints[i] == ints[j])
 				{
-					ans = std::atoi(params[0].c_str());
-					for(size_t p=1; p<params.size(); p++)
-						ans -= std::atoi(params[p].c_str());
+					i = ints.size();
+					result = "0";
+					break;
 				}
-
-				params[0] = std::to_string(ans);
 			}
+		}
+	}
 
-			outStr += params[0];
-			if(indent)
-				indentAmount += into_whitespace(params[0]);
+	outStr += result;
+	if(indent)
+		indentAmount += ' ';
 
-			return 0;
-		}
-		else if(funcName == "-=" && params.size())
-		{
-			if(params.size() < 2)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "-=: expected 2+ parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
-			VPos vpos;
+	return 0;
+}
 
-			if(vars.find(params[0], vpos))
-			{
-				if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "-=", eos))
-					return 1;
+int Parser::builtin_or(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const char& lang = call.lang;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	int& conditionLineNo = call.conditionLineNo;
+	std::vector<std::string>& params = call.params;
+	bool& doNotParse = call.doNotParse;
+	bool& parseParams = call.parseParams;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	bool return_value = 0;
+
+	if(doNotParse)
+		parseParams = 0;
+	else
+		parseParams = 1;
 
-				bool doDouble = 0;
-				int typeInt;
+	for(size_t p=0; p<params.size(); p++)
+	{
+		if(parseParams && parse_replace(lang, params[p], "||(param[" + std::to_string(p) + "])", readPath, antiDepsOfReadPath, lineNo, "@||", sLineNo, eos))
+			return 1;
 
-				for(size_t p=0; p<params.size(); p++)
-				{
-					typeInt = getTypeInt(params[p]);
+		if(replace_var(params[p], readPath, conditionLineNo, "||", eos))
+			return 1;
 
-					if(typeInt == 1)
-						doDouble = 1;
-					else if(typeInt == 2)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "-=: operator not defined for parameter " << p << " = " << quote(params[p]) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
+		if(!get_bool(return_value, params[p], readPath, conditionLineNo, "||", eos))
+			return 1;
 
-				if(options.size())
-				{
-					for(size_t o=0; o<options.size(); o++)
-					{
-						if(options[o] == "d" || options[o] == "double")
-							doDouble = 1;
-					}
-				}
+		if(return_value)
+			break;
+	}
 
-				if(doDouble)
-				{
-					double ans = std::strtod(params[0].c_str(), NULL);
-					for(size_t p=1; p<params.size(); p++)
-						ans -= std::strtod(params[p].c_str(), NULL);
+	outStr += std::to_string(return_value);
+	if(indent)
+		indentAmount += ' ';
 
-					params[0] = vars.double_to_string(ans, 0);
-				}
-				else
-				{
-					int ans = std::atoi(params[0].c_str());
-					for(size_t p=1; p<params.size(); p++)
-						ans -= std::atoi(params[p].c_str());
+	return 0;
+}
 
-					params[0] = std::to_string(ans);
-				}
+int Parser::builtin_and(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const char& lang = call.lang;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	int& conditionLineNo = call.conditionLineNo;
+	std::vector<std::string>& params = call.params;
+	bool& doNotParse = call.doNotParse;
+	bool& parseParams = call.parseParams;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	bool return_value = 1;
+
+	if(doNotParse)
+		parseParams = 0;
+	else
+		parseParams = 1;
 
-				if(!set_var_from_str(vpos, params[0], readPath, sLineNo, "-=", eos))
-					return 1;
-			}
-			else
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "-=: there are no variables defined as " << quote(params[0]) << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	for(size_t p=0; p<params.size(); p++)
+	{
+		if(parseParams && parse_replace(lang, params[p], "&&(param[" + std::to_string(p) + "])", readPath, antiDepsOfReadPath, lineNo, "@&&", sLineNo, eos))
+			return 1;
 
-			return 0;
-		}
-		else if(funcName == "--" && params.size())
-		{
-			VPos vpos;
-			for(size_t p=0; p<params.size(); p++)
-			{
-				if(vars.find(params[p], vpos))
-				{
-					if(vars.layers[vpos.layer].constants.count(params[p]))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "--: attempted illegal change of constant variable " << quote(params[p]) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-					else if(vars.layers[vpos.layer].privates.count(params[p]))
-					{
-						if(!vars.layers[vpos.layer].inScopes[params[p]].count(vars.layers[vars.layers.size()-1].scope))
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << "--: attempted illegal change of private variable " << quote(params[p]) << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-					}
+		if(replace_var(params[p], readPath, conditionLineNo, "&&", eos))
+			return 1;
 
-					if(p == 0 && addOutput)
-					{
-						if(!vars.add_str_from_var(vpos, outStr, 1, indent, indentAmount))
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << "--: cannot get string of var type " << quote(vpos.type) << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-					}
+		if(!get_bool(return_value, params[p], readPath, conditionLineNo, "&&", eos))
+			return 1;
 
-					if(vpos.type.substr(0, 5) == "std::")
-					{
-						if(vpos.type == "std::int")
-							--vars.layers[vpos.layer].ints[params[p]];
-						else if(vpos.type == "std::bool")
-						{
-							if(vars.layers[vpos.layer].bools[params[p]])
-								vars.layers[vpos.layer].bools[params[p]] = 0;
-							else
-								vars.layers[vpos.layer].bools[params[p]] = 1;
-						}
-						else if(vpos.type == "std::double")
-							--vars.layers[vpos.layer].doubles[params[p]];
-						else if(vpos.type == "std::char")
-							--vars.layers[vpos.layer].chars[params[p]];
-						else if(vpos.type == "std::llint")
-							--vars.layers[vpos.layer].llints[params[p]];
-					}
-					else if(vpos.type == "int")
-						--vars.layers[vpos.layer].doubles[params[p]];
-					else if(vpos.type == "bool")
-					{
-						if(vars.layers[vpos.layer].doubles[params[p]])
-							vars.layers[vpos.layer].doubles[params[p]] = 0;
-						else
-							vars.layers[vpos.layer].doubles[params[p]] = 1;
-					}
-					else if(vpos.type == "double")
-						--vars.layers[vpos.layer].doubles[params[p]];
-					else if(vpos.type == "char" && vars.layers[vpos.layer].strings[params[p]].size())
-						--vars.layers[vpos.layer].strings[params[p]][0];
-					else
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "--: operator not defined for variable ";
-						eos << quote(params[p]) << " of type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "--: no variable named " << quote(params[p]) << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
+		if(!return_value)
+			break;
+	}
 
-			return 0;
-		}
-		else if(funcName == "---" && params.size())
-		{
-			if(hasIncrement)
-				funcName = "--";
+	outStr += std::to_string(return_value);
+	if(indent)
+		indentAmount += ' ';
 
-			VPos vpos;
-			for(size_t p=0; p<params.size(); p++)
-			{
-				if(vars.find(params[p], vpos))
-				{
-					if(vars.layers[vpos.layer].constants.count(params[p]))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": attempted illegal change of constant variable " << quote(params[p]) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-					else if(vars.layers[vpos.layer].privates.count(params[p]))
-					{
-						if(!vars.layers[vpos.layer].inScopes[params[p]].count(vars.layers[vars.layers.size()-1].scope))
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": attempted illegal change of private variable " << quote(params[p]) << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-					}
+	return 0;
+}
 
-					if(vpos.type.substr(0, 5) == "std::")
-					{
-						if(vpos.type == "std::int")
-							--vars.layers[vpos.layer].ints[params[p]];
-						else if(vpos.type == "std::bool")
-						{
-							if(vars.layers[vpos.layer].bools[params[p]])
-								vars.layers[vpos.layer].bools[params[p]] = 0;
-							else
-								vars.layers[vpos.layer].bools[params[p]] = 1;
-						}
-						else if(vpos.type == "std::double")
-							--vars.layers[vpos.layer].doubles[params[p]];
-						else if(vpos.type == "std::char")
-							--vars.layers[vpos.layer].chars[params[p]];
-						else if(vpos.type == "std::llint")
-							--vars.layers[vpos.layer].llints[params[p]];
-					}
-					else if(vpos.type == "int")
-						--vars.layers[vpos.layer].doubles[params[p]];
-					else if(vpos.type == "bool")
-					{
-						if(vars.layers[vpos.layer].doubles[params[p]])
-							vars.layers[vpos.layer].doubles[params[p]] = 0;
-						else
-							vars.layers[vpos.layer].doubles[params[p]] = 1;
-					}
-					else if(vpos.type == "double")
-						--vars.layers[vpos.layer].doubles[params[p]];
-					else if(vpos.type == "char" && vars.layers[vpos.layer].strings[params[p]].size())
-						--vars.layers[vpos.layer].strings[params[p]][0];
-					else
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": operator not defined for variable ";
-						eos << quote(params[p]) << " of type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
+int Parser::builtin_equal(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "==", eos))
+		return 1;
 
-					if(p == 0 && addOutput)
-					{
-						if(!vars.add_str_from_var(vpos, outStr, 1, indent, indentAmount))
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot get string of var type " << quote(vpos.type) << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-					}
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": no variable named " << quote(params[p]) << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
+	bool doDouble = 0, doString = 0;
 
-			return 0;
+	for(size_t p=0; p<params.size(); p++)
+	{
+		if(isDouble(params[p]))
+		{
+			if(!doDouble && !isInt(params[p]))
+				doDouble = 1;
+		}
+		else
+		{
+			doString = 1;
+			break;
 		}
 	}
-	else if(funcName[0] == '*')
+
+	if(options.size())
 	{
-		if(funcName == "*" && params.size())
+		for(size_t o=0; o<options.size(); o++)
 		{
-			if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "*", eos))
-				return 1;
-
-			bool doDouble = 0;
-			int typeInt;
-
-			for(size_t p=0; p<params.size(); p++)
+			if(options[o] == "d" || options[o] == "double")
 			{
-				typeInt = getTypeInt(params[p]);
-
-				if(typeInt == 1)
-					doDouble = 1;
-				else if(typeInt == 2)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "*: cannot perform operator on " << params[p] << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+				doDouble = 1;
+				doString = 0;
 			}
-
-			if(options.size())
+			else if(options[o] == "s" || options[o] == "string")
 			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "d" || options[o] == "double")
-						doDouble = 1;
-				}
+				doString = 1;
+				doDouble = 0;
 			}
+		}
+	}
 
-			if(doDouble)
-			{
-				double ans = std::strtod(params[0].c_str(), NULL);
-				for(size_t p=1; p<params.size(); p++)
-					ans *= std::strtod(params[p].c_str(), NULL);
+	std::string result = "1";
 
-				params[0] = vars.double_to_string(ans, 0);
+	if(doString)
+	{
+		for(size_t p=1; p<params.size(); p++)
+		{
+			if(params[p-1] != params[p])
+			{
+				result = "0";
+				break;
 			}
-			else
+		}
+	}
+	else if(doDouble)
+	{
+		double cDouble, nDouble = std::strtod(params[0].c_str(), NULL);
+		for(size_t p=1; p<params.size(); p++)
+		{
+			cDouble = nDouble;
+			nDouble = std::strtod(params[p].c_str(), NULL);
+			if(cDouble != nDouble)
 			{
-				int ans = std::atoi(params[0].c_str());
-				for(size_t p=1; p<params.size(); p++)
-					ans *= std::atoi(params[p].c_str());
-
-				params[0] = std::to_string(ans);
+				result = "0";
+				break;
 			}
-
-			outStr += params[0];
-			if(indent)
-				indentAmount += into_whitespace(params[0]);
-
-			return 0;
 		}
-		else if(funcName == "*=" && params.size())
+	}
+	else
+	{
+		int cInt, nInt = std::atoi(params[0].c_str());
+		for(size_t p=1; p<params.size(); p++)
 		{
-			if(params.size() < 2)
+			cInt = nInt;
+			nInt = std::atoi(params[p].c_str());
+			if(cInt != nInt)
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "*=: expected 2+ parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
+				result = "0";
+				break;
 			}
+		}
+	}
 
-			VPos vpos;
-			if(vars.find(params[0], vpos))
-			{
-				if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "*=", eos))
-					return 1;
+	outStr += result;
+	if(indent)
+		indentAmount += ' ';
 
-				bool doDouble = 0;
-				int typeInt;
+	return 0;
+}
 
-				for(size_t p=0; p<params.size(); p++)
-				{
-					typeInt = getTypeInt(params[p]);
+int Parser::builtin_assign(FnCall& call)
+{
+	const char& lang = call.lang;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	bool readBlock = 0, parseBlock = 0;
+	char bLang = lang;
+	int bLineNo = lineNo;
 
-					if(typeInt == 1)
-						doDouble = 1;
-					else if(typeInt == 2)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "*=: operator not defined for parameter " << p << " = " << quote(params[p]) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "b" || options[o] == "block")
+				readBlock = 1;
+			else if(options[o] == "pb")
+				parseBlock = 1;
+			else if(options[o] == "f++")
+				bLang = 'f';
+			else if(options[o] == "n++")
+				bLang = 'n';
+		}
+	}
 
-				if(options.size())
-				{
-					for(size_t o=0; o<options.size(); o++)
-					{
-						if(options[o] == "d" || options[o] == "double")
-							doDouble = 1;
-					}
-				}
+	if(readBlock)
+	{
+		params.push_back("");
+		if(read_block(params[params.size()-1], linePos, inStr, readPath, lineNo, bLineNo, "=", eos))
+			return 1;
 
-				if(doDouble)
-				{
-					double ans = std::strtod(params[0].c_str(), NULL);
-					for(size_t p=1; p<params.size(); p++)
-						ans *= std::strtod(params[p].c_str(), NULL);
+		if(parseBlock && parse_replace(bLang, params[params.size()-1], "= block", readPath, antiDepsOfReadPath, bLineNo, "=", sLineNo, eos))
+			return 1;
+	}
+	else if(params.size() < 2)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "=: expected 2+ parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-					params[0] = vars.double_to_string(ans, 0);
-				}
-				else
-				{
-					int ans = std::atoi(params[0].c_str());
-					for(size_t p=1; p<params.size(); p++)
-						ans *= std::atoi(params[p].c_str());
-
-					params[0] = std::to_string(ans);
-				}
-
-				if(!set_var_from_str(vpos, params[0], readPath, sLineNo, "*=", eos))
-					return 1;
-			}
-			else
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "*=: there are no variables defined as " << quote(params[0]) << std::endl;
-				os_mtx->unlock();
+	VPos vpos;
+	std::string value = params[params.size()-1];
+	for(size_t p=0; p+1<params.size(); p++)
+	{
+		if(vars.find(params[p], vpos))
+		{
+			if(!set_var_from_str(vpos, value, readPath, sLineNo, "=", eos))
 				return 1;
-			}
-
-			return 0;
 		}
-	}
-	else if(funcName[0] == '/')
-	{
-		if(funcName == "/" && params.size())
+		else
 		{
-			bool oldFP = vars.fixedPrecision;
-			vars.fixedPrecision = 1;
-
-			/*if(parse_replace(lang, params, "/ params", readPath, antiDepsOfReadPath, sLineNo, "/", sLineNo, eos))
-				return 1;*/ //should change fixed precision earlier for this function!!
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "=: no variable named " << quote(params[p]) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-			if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "/", eos))
-				return 1;
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-			vars.fixedPrecision = oldFP;
+	return 0;
+}
 
-			bool doDouble = 0;
-			int typeInt;
+int Parser::builtin_less(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "<", eos))
+		return 1;
 
-			for(size_t p=0; p<params.size(); p++)
-			{
-				typeInt = getTypeInt(params[p]);
+	bool doDouble = 0, doString = 0;
+	int typeInt;
 
-				if(typeInt == 1)
-					doDouble = 1;
-				else if(typeInt == 2)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "/: cannot perform operator on " << params[p] << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
+	for(size_t p=0; p<params.size(); p++)
+	{
+		typeInt = getTypeInt(params[p]);
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "d" || options[o] == "double")
-						doDouble = 1;
-				}
-			}
+		if(typeInt == 1)
+			doDouble = 1;
+		else if(typeInt == 2)
+		{
+			doString = 1;
+			break;
+		}
+	}
 
-			if(doDouble)
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "d" || options[o] == "double")
 			{
-				double ans = std::strtod(params[0].c_str(), NULL);
-				for(size_t p=1; p<params.size(); p++)
-					ans /= std::strtod(params[p].c_str(), NULL);
-
-				params[0] = vars.double_to_string(ans, 0);
+				doDouble = 1;
+				doString = 0;
 			}
-			else
+			else if(options[o] == "s" || options[o] == "string")
 			{
-				int ans = std::atoi(params[0].c_str());
-				for(size_t p=1; p<params.size(); p++)
-					ans /= std::atoi(params[p].c_str());
-
-				params[0] = std::to_string(ans);
+				doString = 1;
+				doDouble = 0;
 			}
+		}
+	}
 
-			outStr += params[0];
-			if(indent)
-				indentAmount += into_whitespace(params[0]);
+	std::string result = "1";
 
-			return 0;
+	if(doString)
+	{
+		for(size_t p=1; p<params.size(); p++)
+		{
+			if(params[p-1] >= params[p])
+			{
+				result = "0";
+				break;
+			}
 		}
-		else if(funcName == "/=" && params.size())
+	}
+	else if(doDouble)
+	{
+		double cDouble, nDouble = std::strtod(params[0].c_str(), NULL);
+		for(size_t p=1; p<params.size(); p++)
 		{
-			if(params.size() < 2)
+			cDouble = nDouble;
+			nDouble = std::strtod(params[p].c_str(), NULL);
+			if(cDouble >= nDouble)
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "/=: expected 2+ parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
+				result = "0";
+				break;
 			}
-
-			VPos vpos;
-			if(vars.find(params[0], vpos))
+		}
+	}
+	else
+	{
+		int cInt, nInt = std::atoi(params[0].c_str());
+		for(size_t p=1; p<params.size(); p++)
+		{
+			cInt = nInt;
+			nInt = std::atoi(params[p].c_str());
+			if(cInt >= nInt)
 			{
-				bool oldFP = vars.fixedPrecision;
-				vars.fixedPrecision = 1;
-
-				/*if(parse_replace(lang, params, "/ params", readPath, antiDepsOfReadPath, sLineNo, "/", sLineNo, eos))
-					return 1;*/ //should change fixed precision earlier for this function!!
-
-				if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "/=", eos))
-					return 1;
+				result = "0";
+				break;
+			}
+		}
+	}
 
-				vars.fixedPrecision = oldFP;
+	outStr += result;
+	if(indent)
+		indentAmount += ' ';
 
-				bool doDouble = 0;
-				int typeInt;
+	return 0;
+}
 
-				for(size_t p=0; p<params.size(); p++)
-				{
-					typeInt = getTypeInt(params[p]);
+int Parser::builtin_less_equal(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "<=", eos))
+		return 1;
 
-					if(typeInt == 1)
-						doDouble = 1;
-					else if(typeInt == 2)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "/=: operator not defined for parameter " << p << " = " << quote(params[p]) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
+	bool doDouble = 0, doString = 0;
+	int typeInt;
 
-				if(options.size())
-				{
-					for(size_t o=0; o<options.size(); o++)
-					{
-						if(options[o] == "d" || options[o] == "double")
-							doDouble = 1;
-					}
-				}
+	for(size_t p=0; p<params.size(); p++)
+	{
+		typeInt = getTypeInt(params[p]);
 
-				if(doDouble)
-				{
-					double ans = std::strtod(params[0].c_str(), NULL);
-					for(size_t p=1; p<params.size(); p++)
-						ans /= std::strtod(params[p].c_str(), NULL);
+		if(typeInt == 1)
+			doDouble = 1;
+		else if(typeInt == 2)
+		{
+			doString = 1;
+			break;
+		}
+	}
 
-					params[0] = vars.double_to_string(ans, 0);
-				}
-				else
-				{
-					int ans = std::atoi(params[0].c_str());
-					for(size_t p=1; p<params.size(); p++)
-						ans /= std::atoi(params[p].c_str());
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "d" || options[o] == "double")
+			{
+				doDouble = 1;
+				doString = 0;
+			}
+			else if(options[o] == "s" || options[o] == "string")
+			{
+				doString = 1;
+				doDouble = 0;
+			}
+		}
+	}
 
-					params[0] = std::to_string(ans);
-				}
+	std::string result = "1";
 
-				if(!set_var_from_str(vpos, params[0], readPath, sLineNo, "/=", eos))
-					return 1;
+	if(doString)
+	{
+		for(size_t p=1; p<params.size(); p++)
+		{
+			if(params[p-1] > params[p])
+			{
+				result = "0";
+				break;
 			}
-			else
+		}
+	}
+	else if(doDouble)
+	{
+		double cDouble, nDouble = std::strtod(params[0].c_str(), NULL);
+		for(size_t p=1; p<params.size(); p++)
+		{
+			cDouble = nDouble;
+			nDouble = std::strtod(params[p].c_str(), NULL);
+			if(cDouble > nDouble)
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "/=: there are no variables defined as " << quote(params[0]) << std::endl;
-				os_mtx->unlock();
-				return 1;
+				result = "0";
+				break;
 			}
-
-			return 0;
 		}
 	}
-	else if(funcName[0] == '%')
+	else
 	{
-		if(funcName == "%" && params.size())
+		int cInt, nInt = std::atoi(params[0].c_str());
+		for(size_t p=1; p<params.size(); p++)
 		{
-			if(params.size() != 2)
+			cInt = nInt;
+			nInt = std::atoi(params[p].c_str());
+			if(cInt > nInt)
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "%: expected 2 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
+				result = "0";
+				break;
 			}
+		}
+	}
 
-			bool oldFP = vars.fixedPrecision;
-			vars.fixedPrecision = 1;
+	outStr += result;
+	if(indent)
+		indentAmount += ' ';
 
-			/*if(parse_replace(lang, params, "/ params", readPath, antiDepsOfReadPath, sLineNo, "%", sLineNo, eos))
-				return 1;*/ //should change fixed precision earlier for this function!!
+	return 0;
+}
 
-			if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "%", eos))
-				return 1;
+int Parser::builtin_greater(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(replaceVars && replace_vars(params, 0, readPath, sLineNo, ">", eos))
+		return 1;
 
-			vars.fixedPrecision = oldFP;
+	bool doDouble = 0, doString = 0;
+	int typeInt;
 
-			int typeInt;
+	for(size_t p=0; p<params.size(); p++)
+	{
+		typeInt = getTypeInt(params[p]);
 
-			for(size_t p=0; p<params.size(); p++)
-			{
-				typeInt = getTypeInt(params[p]);
+		if(typeInt == 1)
+			doDouble = 1;
+		else if(typeInt == 2)
+		{
+			doString = 1;
+			break;
+		}
+	}
 
-				if(typeInt != 0)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "%: cannot perform operator on " << params[p] << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "d" || options[o] == "double")
+			{
+				doDouble = 1;
+				doString = 0;
 			}
+			else if(options[o] == "s" || options[o] == "string")
+			{
+				doString = 1;
+				doDouble = 0;
+			}
+		}
+	}
 
-			int ans = std::atoi(params[0].c_str())%std::atoi(params[1].c_str());
-
-			params[0] = std::to_string(ans);
-
-			outStr += params[0];
-			if(indent)
-				indentAmount += into_whitespace(params[0]);
+	std::string result = "1";
 
-			return 0;
+	if(doString)
+	{
+		for(size_t p=1; p<params.size(); p++)
+		{
+			if(params[p-1] <= params[p])
+			{
+				result = "0";
+				break;
+			}
 		}
-		else if(funcName == "%=" && params.size())
+	}
+	else if(doDouble)
+	{
+		double cDouble, nDouble = std::strtod(params[0].c_str(), NULL);
+		for(size_t p=1; p<params.size(); p++)
 		{
-			if(params.size() != 2)
+			cDouble = nDouble;
+			nDouble = std::strtod(params[p].c_str(), NULL);
+			if(cDouble <= nDouble)
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "%=: expected 2 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
+				result = "0";
+				break;
 			}
-
-			VPos vpos;
-			if(vars.find(params[0], vpos))
+		}
+	}
+	else
+	{
+		int cInt, nInt = std::atoi(params[0].c_str());
+		for(size_t p=1; p<params.size(); p++)
+		{
+			cInt = nInt;
+			nInt = std::atoi(params[p].c_str());
+			if(cInt <= nInt)
 			{
-				bool oldFP = vars.fixedPrecision;
-				vars.fixedPrecision = 1;
-
-				/*if(parse_replace(lang, params, "/ params", readPath, antiDepsOfReadPath, sLineNo, "%=", sLineNo, eos))
-					return 1;*/ //should change fixed precision earlier for this function!!
-
-				if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "%=", eos))
-					return 1;
+				result = "0";
+				break;
+			}
+		}
+	}
 
-				vars.fixedPrecision = oldFP;
+	outStr += result;
+	if(indent)
+		indentAmount += ' ';
 
-				int typeInt;
+	return 0;
+}
 
-				for(size_t p=0; p<params.size(); p++)
-				{
-					typeInt = getTypeInt(params[p]);
+int Parser::builtin_greater_equal(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(replaceVars && replace_vars(params, 0, readPath, sLineNo, ">=", eos))
+		return 1;
 
-					if(typeInt != 0)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "%=: operator not defined for parameter " << p << " = " << quote(params[p]) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
+	bool doDouble = 0, doString = 0;
+	int typeInt;
 
-				int ans = std::atoi(params[0].c_str())%std::atoi(params[1].c_str());
+	for(size_t p=0; p<params.size(); p++)
+	{
+		typeInt = getTypeInt(params[p]);
 
-				params[0] = std::to_string(ans);
+		if(typeInt == 1)
+			doDouble = 1;
+		else if(typeInt == 2)
+		{
+			doString = 1;
+			break;
+		}
+	}
 
-				if(!set_var_from_str(vpos, params[0], readPath, sLineNo, "%=", eos))
-					return 1;
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "d" || options[o] == "double")
+			{
+				doDouble = 1;
+				doString = 0;
 			}
-			else
+			else if(options[o] == "s" || options[o] == "string")
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "%=: there are no variables defined as " << quote(params[0]) << std::endl;
-				os_mtx->unlock();
-				return 1;
+				doString = 1;
+				doDouble = 0;
 			}
-
-			return 0;
 		}
 	}
-	else if(funcName[0] == '?')
+
+	std::string result = "1";
+
+	if(doString)
 	{
-		if(funcName == "?" && params.size())
+		for(size_t p=1; p<params.size(); p++)
 		{
-			if(params.size() != 3)
+			if(params[p-1] <= params[p])
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "?: expected 3 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
+				result = "0";
+				break;
 			}
-
-			bool result, addOut= addOutput;
-			char ternaryLang = lang;
-
-			if(options.size())
+		}
+	}
+	else if(doDouble)
+	{
+		double cDouble, nDouble = std::strtod(params[0].c_str(), NULL);
+		for(size_t p=1; p<params.size(); p++)
+		{
+			cDouble = nDouble;
+			nDouble = std::strtod(params[p].c_str(), NULL);
+			if(cDouble < nDouble)
 			{
-				for(size_t o=0; o<options.size(); ++o)
-				{
-					if(options[o] == "f++")
-						ternaryLang = 'f';
-					else if(options[o] == "n++")
-						ternaryLang = 'n';
-					else if(options[o] == "o")
-						addOut = 1;
-					else if(options[o] == "!o")
-						addOut = 0;
-				}
+				result = "0";
+				break;
 			}
-
-			if(get_bool(result, params[0]))
-			{}
-			else
+		}
+	}
+	else
+	{
+		int cInt, nInt = std::atoi(params[0].c_str());
+		for(size_t p=1; p<params.size(); p++)
+		{
+			cInt = nInt;
+			nInt = std::atoi(params[p].c_str());
+			if(cInt < nInt)
 			{
-				if(params[0] != "" && expr.compile(params[0]))
-					result = expr.evaluate();
-				else
-				{
-					std::string parsedCondition = params[0];
+				result = "0";
+				break;
+			}
+		}
+	}
 
-					if(!doNotParse && parse_replace('f', parsedCondition, "? condition", readPath, antiDepsOfReadPath, sLineNo, "?", sLineNo, eos))
-						return 1;
+	outStr += result;
+	if(indent)
+		indentAmount += ' ';
 
-					if(replaceVars && replace_var(parsedCondition, readPath, sLineNo, "?", eos))
-						return 1;
+	return 0;
+}
 
-					if(!get_bool(result, parsedCondition))
-					{
-						if(parsedCondition != "" && expr.compile(parsedCondition))
-							result = expr.evaluate();
-						else
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err(eos, readPath, conditionLineNo) << "?: cannot convert " << quote(parsedCondition) << " to bool" << std::endl;
-							start_err(eos, readPath, conditionLineNo) << "?: possible errors from ExprTk:" << std::endl;
-							print_exprtk_parser_errs(eos, expr.parser, expr.expr_str, readPath, sLineNo);
-							os_mtx->unlock();
-							return 1;
-						}
-					}
-				}
+int Parser::builtin_add(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "+", eos))
+		return 1;
+
+	bool doDouble = 0, doString = 0;
+	int typeInt;
+
+	for(size_t p=0; p<params.size(); p++)
+	{
+		typeInt = getTypeInt(params[p]);
+
+		if(typeInt == 1)
+			doDouble = 1;
+		else if(typeInt == 2)
+		{
+			doString = 1;
+			break;
+		}
+	}
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "d" || options[o] == "double")
+			{
+				doDouble = 1;
+				doString = 0;
+			}
+			else if(options[o] == "s" || options[o] == "string")
+			{
+				doString = 1;
+				doDouble = 0;
 			}
+		}
+	}
 
-			std::string block;
+	if(doString)
+	{
+		for(size_t p=1; p<params.size(); p++)
+			params[0] += params[p];
+	}
+	else if(doDouble)
+	{
+		double ans = std::strtod(params[0].c_str(), NULL);
+		for(size_t p=1; p<params.size(); p++)
+			ans += std::strtod(params[p].c_str(), NULL);
 
-			if(result)
-				block = params[1];
-			else
-				block = params[2];
+		params[0] = vars.double_to_string(ans, 0);
+	}
+	else
+	{
+		int ans = std::atoi(params[0].c_str());
+		for(size_t p=1; p<params.size(); p++)
+			ans += std::atoi(params[p].c_str());
 
-			int ret_val;
+		params[0] = std::to_string(ans);
+	}
 
-			if(ternaryLang == 'n')
-				ret_val = n_read_and_process_fast(1, addOut, block, sLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
-			else
-				ret_val = f_read_and_process_fast(addOut, block, sLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
+	outStr += params[0];
+	if(indent)
+		indentAmount.add_text(params[0]);
 
-			if(ret_val == NSM_BREAK)
-				return NSM_BREAK;
-			else if(ret_val)
-				return ret_val;
+	return 0;
+}
 
-			return 0;
-		}
+int Parser::builtin_add_assign(FnCall& call)
+{
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(params.size() < 2)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "+=: expected 2+ parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
 	}
-	else if(funcName[0] == ':')
+
+	VPos vpos;
+	if(vars.find(params[0], vpos))
 	{
-		if(funcName == ":=" && paramsStr != "")
+		if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "+=", eos))
+			return 1;
+
+		bool doDouble = 0, doString = 0;
+		int typeInt;
+
+		for(size_t p=0; p<params.size(); p++)
 		{
-			std::string varType;
-			std::vector<std::pair<std::string, std::vector<std::string> > > inputVars;
-			bool constants = 0, privates = 0, addToExpr = 1, addMemberFns = addMemberFnsGlobal, normalVecDef = 1;
-			int pOption = -1;
-			size_t layer = vars.layers.size()-1;
-			std::string vScope, bScope;
-			std::unordered_set<std::string> inScopes;
+			typeInt = getTypeInt(params[p]);
 
-			size_t pos=0;
-			if(read_def(varType, inputVars, pos, paramsStr, readPath, lineNo, ":=", eos))
-				return 1;
+			if(typeInt == 1)
+				doDouble = 1;
+			else if(typeInt == 2)
+			{
+				doString = 1;
+				break;
+			}
+		}
+
+		if(options.size())
+		{
+			for(size_t o=0; o<options.size(); o++)
+			{
+				if(options[o] == "d" || options[o] == "double")
+				{
+					doDouble = 1;
+					doString = 0;
+				}
+				else if(options[o] == "s" || options[o] == "string")
+				{
+					doString = 1;
+					doDouble = 0;
+				}
+			}
+		}
+
+		if(doString)
+		{
+			for(size_t p=1; p<params.size(); p++)
+				params[0] += params[p];
+		}
+		else if(doDouble)
+		{
+			double ans = std::strtod(params[0].c_str(), NULL);
+			for(size_t p=1; p<params.size(); p++)
+				ans += std::strtod(params[p].c_str(), NULL);
+
+			params[0] = vars.double_to_string(ans, 0);
+		}
+		else
+		{
+			int ans = std::atoi(params[0].c_str());
+			for(size_t p=1; p<params.size(); p++)
+				ans += std::atoi(params[p].c_str());
+
+			params[0] = std::to_string(ans);
+		}
 
-			/*if(!valid_type(varType, readPath, antiDepsOfReadPath, sLineNo, ":=", sLineNo, eos))
+		if(!set_var_from_str(vpos, params[0], readPath, sLineNo, "+=", eos))
+			return 1;
+	}
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "+=: there are no variables defined as " << quote(params[0]) << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	return 0;
+}
+
+int Parser::builtin_pre_increment(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const bool& addOutput = call.addOutput;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	VPos vpos;
+	for(size_t p=0; p<params.size(); p++)
+	{
+		if(vars.find(params[p], vpos))
+		{
+			if(vars.layers[vpos.layer].constants.count(params[p]))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: invalid type: " << quote(varType) << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "++: attempted illegal change of constant variable " << quote(params[p]) << std::endl;
 				os_mtx->unlock();
 				return 1;
-			}*/
-
-			if(varType == "std::vector<double>")
-				addToExpr = 0;
-
-			if(options.size())
+			}
+			else if(vars.layers[vpos.layer].privates.count(params[p]))
 			{
-				for(size_t o=0; o<options.size(); o++)
+				if(!vars.layers[vpos.layer].inScopes[params[p]].count(vars.layers[vars.layers.size()-1].scope))
 				{
-					if(options[o] == "et" || options[o] == "exprtk")
-						addToExpr = 1;
-					else if(options[o] == "!et" || options[o] == "!exprtk")
-						addToExpr = 0;
-					else if(options[o] == "const")
-						constants = 1;
-					else if(options[o] == "mf")
-						addMemberFns = 1;
-					else if(options[o] == "!mf")
-						addMemberFns = 0;
-					else if(options[o] == "private")
-					{
-						privates = 1;
-						pOption = o;
-					}
-					else if(options[o].substr(0, 6) == "layer=")
-					{
-						std::string str = unquote(options[o].substr(6, options[o].size()-6));
-
-						if(!isNonNegInt(str))
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: specified layer " << quote(str) << " is not a non-negative integer" << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-						layer = std::atoi(str.c_str());
-						if(layer >= vars.layers.size())
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: specified layer " << quote(str) << " should be less than the number of layers" << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-					}
-					else if(options[o].substr(0, 7) == "scope+=")
-					{
-						privates = 1;
-						inScopes.insert(unquote(options[o].substr(7, options[o].size()-7)));
-					}
-					else if(options[o] == "...")
-						normalVecDef = 0;
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << "++: attempted illegal change of private variable " << quote(params[p]) << std::endl;
+					os_mtx->unlock();
+					return 1;
 				}
 			}
 
-			bScope = vars.layers[layer].scope;
-			if(pOption != -1)
-				options[pOption] = "scope+=" + vars.layers[layer].scope;
+			if(p == 0 && addOutput)
+			{
+				if(!vars.add_str_from_var(vpos, outStr, 1, indent, indentAmount))
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << "++: cannot get string of var type " << quote(vpos.type) << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
+			}
 
-			if(vars.basic_types.count(varType))
+			if(vpos.type.substr(0, 5) == "std::")
 			{
-				for(size_t v=0; v<inputVars.size(); v++)
+				if(vpos.type == "std::int")
+					++vars.layers[vpos.layer].ints[params[p]];
+				else if(vpos.type == "std::bool")
 				{
-					//checks whether variable exists at current scope
-					if(inputVars[v].first == "")
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: cannot have variable named " << quote(inputVars[v].first) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-					else if(vars.layers[layer].typeOf.count(inputVars[v].first))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: redeclaration of variable/function name " << quote(inputVars[v].first) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-					else if(vars.typeDefs.count(inputVars[v].first))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: cannot have type and variable named " << quote(inputVars[v].first) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
+					if(vars.layers[vpos.layer].bools[params[p]])
+						vars.layers[vpos.layer].bools[params[p]] = 0;
 					else
-					{
-						vars.layers[layer].typeOf[inputVars[v].first] = varType;
-						int pos = find_last_of_special(inputVars[v].first);
-						if(pos)
-							vScope = bScope + inputVars[v].first.substr(0, pos) + ".";
-						else
-							vScope = bScope;
-						vars.layers[layer].inScopes[inputVars[v].first].insert(vScope);
-						for(auto it=inScopes.begin(); it!=inScopes.end(); it++)
-							vars.layers[layer].inScopes[inputVars[v].first].insert(*it);
-						vars.layers[layer].scopeOf[inputVars[v].first] = vScope;
-
-						if(varType == "bool")
-						{
-							if(!inputVars[v].second.size())
-								inputVars[v].second.push_back("0");
-
-							if(inputVars[v].second.size() != 1)
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: bool definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-							else if(inputVars[v].second[0] == "1" || inputVars[v].second[0] == "true")
-							{
-								vars.layers[layer].doubles[inputVars[v].first] = 1;
+						vars.layers[vpos.layer].bools[params[p]] = 1;
+				}
+				else if(vpos.type == "std::double")
+					++vars.layers[vpos.layer].doubles[params[p]];
+				else if(vpos.type == "std::char")
+					++vars.layers[vpos.layer].chars[params[p]];
+				else if(vpos.type == "std::llint")
+					++vars.layers[vpos.layer].llints[params[p]];
+			}
+			else if(vpos.type == "int")
+				++vars.layers[vpos.layer].doubles[params[p]];
+			else if(vpos.type == "bool")
+			{
+				if(vars.layers[vpos.layer].doubles[params[p]])
+					vars.layers[vpos.layer].doubles[params[p]] = 0;
+				else
+					vars.layers[vpos.layer].doubles[params[p]] = 1;
+			}
+			else if(vpos.type == "double")
+				++vars.layers[vpos.layer].doubles[params[p]];
+			else if(vpos.type == "char" && vars.layers[vpos.layer].strings[params[p]].size())
+				++vars.layers[vpos.layer].strings[params[p]][0];
+			else
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "++: operator not defined for variable ";
+				eos << quote(params[p]) << " of type " << quote(vpos.type) << std::endl;
+				os_mtx->unlock();
+				return 1;
+			}
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "++: no variable named " << quote(params[p]) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-								if(addToExpr)
-									symbol_table.add_variable(inputVars[v].first, vars.layers[layer].doubles[inputVars[v].first]);
-							}
-							else if(inputVars[v].second[0] == "0" || inputVars[v].second[0] == "false")
-							{
-								vars.layers[layer].doubles[inputVars[v].first] = 0;
+	return 0;
+}
 
-								if(addToExpr)
-									symbol_table.add_variable(inputVars[v].first, vars.layers[layer].doubles[inputVars[v].first]);
-							}
-							else if(isInt(inputVars[v].second[0]))
-							{
-								vars.layers[layer].doubles[inputVars[v].first] = (bool)std::atoi(inputVars[v].second[0].c_str());
+int Parser::builtin_post_increment(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const bool& addOutput = call.addOutput;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& params = call.params;
+	bool& hasIncrement = call.hasIncrement;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(hasIncrement)
+		funcName = "++";
 
-								if(addToExpr)
-									symbol_table.add_variable(inputVars[v].first, vars.layers[layer].doubles[inputVars[v].first]);
-							}
-							else if(isDouble(inputVars[v].second[0]))
-							{
-								vars.layers[layer].doubles[inputVars[v].first] = (bool)std::strtod(inputVars[v].second[0].c_str(), NULL);
+	VPos vpos;
+	for(size_t p=0; p<params.size(); p++)
+	{
+		if(vars.find(params[p], vpos))
+		{
+			if(vars.layers[vpos.layer].constants.count(params[p]))
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": attempted illegal change of constant variable " << quote(params[p]) << std::endl;
+				os_mtx->unlock();
+				return 1;
+			}
+			else if(vars.layers[vpos.layer].privates.count(params[p]))
+			{
+				if(!vars.layers[vpos.layer].inScopes[params[p]].count(vars.layers[vars.layers.size()-1].scope))
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": attempted illegal change of private variable " << quote(params[p]) << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
+			}
 
-								if(addToExpr)
-									symbol_table.add_variable(inputVars[v].first, vars.layers[layer].doubles[inputVars[v].first]);
-							}
-							else
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not a boolean" << std::endl;
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-						}
-						else if(varType == "int")
-						{
-							if(!inputVars[v].second.size())
-								inputVars[v].second.push_back("0");
+			if(vpos.type.substr(0, 5) == "std::")
+			{
+				if(vpos.type == "std::int")
+					++vars.layers[vpos.layer].ints[params[p]];
+				else if(vpos.type == "std::bool")
+				{
+					if(vars.layers[vpos.layer].bools[params[p]])
+						vars.layers[vpos.layer].bools[params[p]] = 0;
+					else
+						vars.layers[vpos.layer].bools[params[p]] = 1;
+				}
+				else if(vpos.type == "std::double")
+					++vars.layers[vpos.layer].doubles[params[p]];
+				else if(vpos.type == "std::char")
+					++vars.layers[vpos.layer].chars[params[p]];
+				else if(vpos.type == "std::llint")
+					++vars.layers[vpos.layer].llints[params[p]];
+			}
+			else if(vpos.type == "int")
+				++vars.layers[vpos.layer].doubles[params[p]];
+			else if(vpos.type == "bool")
+			{
+				if(vars.layers[vpos.layer].doubles[params[p]])
+					vars.layers[vpos.layer].doubles[params[p]] = 0;
+				else
+					vars.layers[vpos.layer].doubles[params[p]] = 1;
+			}
+			else if(vpos.type == "double")
+				++vars.layers[vpos.layer].doubles[params[p]];
+			else if(vpos.type == "char" && vars.layers[vpos.layer].strings[params[p]].size())
+				++vars.layers[vpos.layer].strings[params[p]][0];
+			else
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": operator not defined for variable ";
+				eos << quote(params[p]) << " of type " << quote(vpos.type) << std::endl;
+				os_mtx->unlock();
+				return 1;
+			}
 
-							if(inputVars[v].second.size() != 1)
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: int definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-							else if(isInt(inputVars[v].second[0]))
-							{
-								vars.layers[layer].doubles[inputVars[v].first] = std::atoi(inputVars[v].second[0].c_str());
+			if(p == 0 && addOutput)
+			{
+				if(!vars.add_str_from_var(vpos, outStr, 1, indent, indentAmount))
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot get string of var type " << quote(vpos.type) << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
+			}
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": no variable named " << quote(params[p]) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-								if(addToExpr)
-									symbol_table.add_variable(inputVars[v].first, vars.layers[layer].doubles[inputVars[v].first]);
-							}
-							else if(isDouble(inputVars[v].second[0]))
-							{
-								vars.layers[layer].doubles[inputVars[v].first] = (int)std::strtod(inputVars[v].second[0].c_str(), NULL);
+	return 0;
+}
 
-								if(addToExpr)
-									symbol_table.add_variable(inputVars[v].first, vars.layers[layer].doubles[inputVars[v].first]);
-							}
-							else
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not an integer" << std::endl;
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-						}
-						else if(varType == "double")
-						{
-							if(!inputVars[v].second.size())
-								inputVars[v].second.push_back("0");
+int Parser::builtin_subtract(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "-", eos))
+		return 1;
 
-							if(inputVars[v].second.size() != 1)
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: double definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-							else if(isDouble(inputVars[v].second[0]))
-							{
-								vars.layers[layer].doubles[inputVars[v].first] = std::strtod(inputVars[v].second[0].c_str(), NULL);
+	bool doDouble = 0;
+	int typeInt;
 
-								if(addToExpr)
-									symbol_table.add_variable(inputVars[v].first, vars.layers[layer].doubles[inputVars[v].first]);
-							}
-							else
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not a double" << std::endl;
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-						}
-						else if(varType == "char")
-						{
-							if(!inputVars[v].second.size())
-								inputVars[v].second.push_back(" ");
+	for(size_t p=0; p<params.size(); p++)
+	{
+		typeInt = getTypeInt(params[p]);
 
-							if(inputVars[v].second.size() != 1)
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: character definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-							else if(inputVars[v].second[0].size() == 1)
-							{
-								vars.layers[layer].strings[inputVars[v].first] = inputVars[v].second[0];
+		if(typeInt == 1)
+			doDouble = 1;
+		else if(typeInt == 2)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "-: cannot perform operator on " << params[p] << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-								if(addToExpr)
-									symbol_table.add_stringvar(inputVars[v].first, vars.layers[layer].strings[inputVars[v].first]);
-							}
-							else
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not a character" << std::endl;
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-						}
-						else if(varType == "string")
-						{
-							if(!inputVars[v].second.size())
-								inputVars[v].second.push_back(" ");
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "d" || options[o] == "double")
+				doDouble = 1;
+		}
+	}
 
-							if(inputVars[v].second.size() != 1)
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: string definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-							else
-							{
-								vars.layers[layer].strings[inputVars[v].first] = inputVars[v].second[0];
+	if(doDouble)
+	{
+		double ans;
+		if(params.size() == 1)
+			ans = -std::strtod(params[0].c_str(), NULL);
+		else
+		{
+			ans = std::strtod(params[0].c_str(), NULL);
+			for(size_t p=1; p<params.size(); p++)
+				ans -= std::strtod(params[p].c_str(), NULL);
+		}
 
-								if(addToExpr)
-									symbol_table.add_stringvar(inputVars[v].first, vars.layers[layer].strings[inputVars[v].first]);
-							}
-						}
-						else if(varType == "std::bool")
-						{
-							if(!inputVars[v].second.size())
-								inputVars[v].second.push_back("0");
+		params[0] = vars.double_to_string(ans, 0);
+	}
+	else
+	{
+		int ans;
+		if(params.size() == 1)
+			ans = -std::atoi(params[0].c_str());
+		else
+		{
+			ans = std::atoi(params[0].c_str());
+			for(size_t p=1; p<params.size(); p++)
+				ans -= std::atoi(params[p].c_str());
+		}
 
-							if(inputVars[v].second.size() != 1)
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: std::bool definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-							else if(inputVars[v].second[0] == "1" || inputVars[v].second[0] == "true")
-								vars.layers[layer].bools[inputVars[v].first] = 1;
-							else if(inputVars[v].second[0] == "0" || inputVars[v].second[0] == "false")
-								vars.layers[layer].bools[inputVars[v].first] = 1;
-							else if(isInt(inputVars[v].second[0]))
-								vars.layers[layer].bools[inputVars[v].first] = (bool)std::atoi(inputVars[v].second[0].c_str());
-							else if(isDouble(inputVars[v].second[0]))
-								vars.layers[layer].bools[inputVars[v].first] = (bool)std::strtod(inputVars[v].second[0].c_str(), NULL);
-							else
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not an std::bool" << std::endl;
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-						}
-						else if(varType == "std::int")
-						{
-							if(!inputVars[v].second.size())
-								inputVars[v].second.push_back("0");
+		params[0] = std::to_string(ans);
+	}
 
-							if(inputVars[v].second.size() != 1)
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: std::int definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-							else if(isInt(inputVars[v].second[0]))
-								vars.layers[layer].ints[inputVars[v].first] = std::atoi(inputVars[v].second[0].c_str());
-							else if(isDouble(inputVars[v].second[0]))
-								vars.layers[layer].ints[inputVars[v].first] = (int)std::strtod(inputVars[v].second[0].c_str(), NULL);
-							else
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not an std::int" << std::endl;
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-						}
-						else if(varType == "std::double")
-						{
-							if(!inputVars[v].second.size())
-								inputVars[v].second.push_back("0");
+	outStr += params[0];
+	if(indent)
+		indentAmount.add_text(params[0]);
 
-							if(inputVars[v].second.size() != 1)
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: std::double definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-							else if(isDouble(inputVars[v].second[0]))
-								vars.layers[layer].doubles[inputVars[v].first] = std::strtod(inputVars[v].second[0].c_str(), NULL);
-							else
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not an std::double" << std::endl;
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-						}
-						else if(varType == "std::char")
-						{
-							if(!inputVars[v].second.size())
-								inputVars[v].second.push_back(" ");
+	return 0;
+}
 
-							if(inputVars[v].second.size() != 1)
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: std::char definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-							else if(inputVars[v].second[0].size() == 1)
-								vars.layers[layer].chars[inputVars[v].first] = inputVars[v].second[0][0];
-							else
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not an std::char" << std::endl;
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-						}
-						else if(varType == "std::string")
-						{
-							if(!inputVars[v].second.size())
-								inputVars[v].second.push_back("");
+int Parser::builtin_subtract_assign(FnCall& call)
+{
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(params.size() < 2)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "-=: expected 2+ parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-							if(inputVars[v].second.size() != 1)
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: std::string definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-							else
-								vars.layers[layer].strings[inputVars[v].first] = inputVars[v].second[0];
-						}
-						else if(varType == "std::llint")
-						{
-							if(!inputVars[v].second.size())
-								inputVars[v].second.push_back("0");
+	VPos vpos;
 
-							if(inputVars[v].second.size() != 1)
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: std::llint definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-							else if(isInt(inputVars[v].second[0]))
-								vars.layers[layer].llints[inputVars[v].first] = std::atoll(inputVars[v].second[0].c_str());
-							else if(isDouble(inputVars[v].second[0]))
-								vars.layers[layer].llints[inputVars[v].first] = (long long int)std::strtod(inputVars[v].second[0].c_str(), NULL);
-							else
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not an integer" << std::endl;
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-						}
-						else if(varType == "std::vector<double>")
-						{
-							int noParams = inputVars[v].second.size();
+	if(vars.find(params[0], vpos))
+	{
+		if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "-=", eos))
+			return 1;
 
-							if(normalVecDef && noParams > 2)
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: std::vector<double> definition for " << quote(inputVars[v].first) << " should have 0-2 input variables, got " << inputVars[v].second.size() << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
+		bool doDouble = 0;
+		int typeInt;
 
-							if(normalVecDef)
-							{
-								size_t vSize = 0;
-								double vValue = 0.0;
+		for(size_t p=0; p<params.size(); p++)
+		{
+			typeInt = getTypeInt(params[p]);
 
-								if(noParams > 0)
-								{
-									if(!isNonNegInt(inputVars[v].second[0]))
-									{
-										if(!consoleLocked)
-											os_mtx->lock();
-										start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: size given for " << quote(inputVars[v].first) << " is not a non-negative integer" << std::endl;
-										start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: size given = " << quote(inputVars[v].second[0]) << std::endl;
-										os_mtx->unlock();
-										return 1;
-									}
-									else
-										vSize = std::atoi(inputVars[v].second[0].c_str());
-								}
+			if(typeInt == 1)
+				doDouble = 1;
+			else if(typeInt == 2)
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "-=: operator not defined for parameter " << p << " = " << quote(params[p]) << std::endl;
+				os_mtx->unlock();
+				return 1;
+			}
+		}
 
-								if(noParams == 2)
-								{
-									if(!isDouble(inputVars[v].second[1]))
-									{
-										if(!consoleLocked)
-											os_mtx->lock();
-										start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not a double" << std::endl;
-										start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[1]) << std::endl;
-										os_mtx->unlock();
-										return 1;
-									}
-									else
-										vValue = std::strtod(inputVars[v].second[1].c_str(), NULL);
-								}
-								vars.layers[layer].doubVecs[inputVars[v].first] = std::vector<double>(vSize, vValue);
-							}
-							else
-							{
-								std::vector<double>* v_ptr = &vars.layers[layer].doubVecs[inputVars[v].first];
-
-								for(int p=0; p<noParams; ++p)
-								{
-									if(isDouble(inputVars[v].second[p]))
-										v_ptr->push_back(std::strtod(inputVars[v].second[p].c_str(), NULL));
-									else
-									{
-										if(!consoleLocked)
-											os_mtx->lock();
-										start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not a double" << std::endl;
-										start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[p]) << std::endl;
-										os_mtx->unlock();
-										return 1;
-									}
-								}
-							}
-
-							if(addToExpr)
-							{
-								size_t vSize = vars.layers[layer].doubVecs[inputVars[v].first].size();
-								if(!vSize)
-									vars.layers[layer].doubVecs[inputVars[v].first].push_back(0.0);
-								symbol_table.add_vector(inputVars[v].first, vars.layers[layer].doubVecs[inputVars[v].first]);
-								if(!vSize)
-									vars.layers[layer].doubVecs[inputVars[v].first].pop_back();
-							}
-
-							if(addMemberFns)
-							{
-								if(add_fn(inputVars[v].first + ".push_back", 'n',
-								          "@std::vector.push_back{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-
-								if(add_fn(inputVars[v].first + ".size", 'n',
-								          "@std::vector.size{mf}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-
-								if(add_fn(inputVars[v].first + ".at", 'n',
-								          "@std::vector.at{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-
-								if(add_fn(inputVars[v].first + ".set", 'n',
-								          "@std::vector.set{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-
-								if(add_fn(inputVars[v].first + ".pop_back", 'n',
-								          "@std::vector.pop_back{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-
-								if(add_fn(inputVars[v].first + ".erase", 'n',
-								          "@std::vector.erase{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-							}
-						}
-						else if(varType == "std::vector<string>")
-						{
-							int noParams = inputVars[v].second.size();
+		if(options.size())
+		{
+			for(size_t o=0; o<options.size(); o++)
+			{
+				if(options[o] == "d" || options[o] == "double")
+					doDouble = 1;
+			}
+		}
 
-							if(normalVecDef && noParams > 2)
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: std::vector<string> definition for " << quote(inputVars[v].first) << " should have 0-2 input variables, got " << inputVars[v].second.size() << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
+		if(doDouble)
+		{
+			double ans = std::strtod(params[0].c_str(), NULL);
+			for(size_t p=1; p<params.size(); p++)
+				ans -= std::strtod(params[p].c_str(), NULL);
 
-							if(normalVecDef)
-							{
-								size_t vSize = 0;
-								std::string vValue = "";
+			params[0] = vars.double_to_string(ans, 0);
+		}
+		else
+		{
+			int ans = std::atoi(params[0].c_str());
+			for(size_t p=1; p<params.size(); p++)
+				ans -= std::atoi(params[p].c_str());
 
-								if(noParams > 0)
-								{
-									if(!isNonNegInt(inputVars[v].second[0]))
-									{
-										if(!consoleLocked)
-											os_mtx->lock();
-										start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: size given for " << quote(inputVars[v].first) << " is not a non-negative integer" << std::endl;
-										start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: size given = " << quote(inputVars[v].second[0]) << std::endl;
-										os_mtx->unlock();
-										return 1;
-									}
-									else
-										vSize = std::atoi(inputVars[v].second[0].c_str());
-								}
+			params[0] = std::to_string(ans);
+		}
 
-								if(noParams == 2)
-									vValue = inputVars[v].second[1];
-								vars.layers[layer].strVecs[inputVars[v].first] = std::vector<std::string>(vSize, vValue);
-							}
-							else
-							{
-								std::vector<std::string>* v_ptr = &vars.layers[layer].strVecs[inputVars[v].first];
+		if(!set_var_from_str(vpos, params[0], readPath, sLineNo, "-=", eos))
+			return 1;
+	}
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "-=: there are no variables defined as " << quote(params[0]) << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-								for(int p=0; p<noParams; ++p)
-									v_ptr->push_back(inputVars[v].second[p]);
-							}
+	return 0;
+}
 
-							if(addMemberFns)
-							{
-								if(add_fn(inputVars[v].first + ".push_back", 'n',
-								          "@std::vector.push_back{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-
-								if(add_fn(inputVars[v].first + ".size", 'n',
-								          "@std::vector.size{mf}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-
-								if(add_fn(inputVars[v].first + ".at", 'n',
-								          "@std::vector.at{mf, !s@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-
-								if(add_fn(inputVars[v].first + ".set", 'n',
-								          "@std::vector.set{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-
-								if(add_fn(inputVars[v].first + ".pop_back", 'n',
-								          "@std::vector.pop_back{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-
-								if(add_fn(inputVars[v].first + ".erase", 'n',
-								          "@std::vector.erase{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-							}
-						}
-						else if(varType == "fstream")
-						{
-							if(inputVars[v].second.size() > 1)
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: fstream definition for " << quote(inputVars[v].first) << " should have 0-1 input variables, got " << inputVars[v].second.size() << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-							else if(!inputVars[v].second.size())
-								vars.layers[layer].fstreams[inputVars[v].first] = std::fstream();
-							else
-							{
-								vars.layers[layer].fstreams[inputVars[v].first].open(inputVars[v].second[0]);
+int Parser::builtin_pre_decrement(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const bool& addOutput = call.addOutput;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
 
-								if(!vars.layers[layer].fstreams[inputVars[v].first].is_open())
-								{
-									if(!consoleLocked)
-										os_mtx->lock();
-									start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: failed to open path for " << quote(inputVars[v].first) << std::endl;
-									start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: path given = " << quote(inputVars[v].second[0]) << std::endl;
-									os_mtx->unlock();
-									return 1;
-								}
-							}
+	VPos vpos;
+	for(size_t p=0; p<params.size(); p++)
+	{
+		if(vars.find(params[p], vpos))
+		{
+			if(vars.layers[vpos.layer].constants.count(params[p]))
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "--: attempted illegal change of constant variable " << quote(params[p]) << std::endl;
+				os_mtx->unlock();
+				return 1;
+			}
+			else if(vars.layers[vpos.layer].privates.count(params[p]))
+			{
+				if(!vars.layers[vpos.layer].inScopes[params[p]].count(vars.layers[vars.layers.size()-1].scope))
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << "--: attempted illegal change of private variable " << quote(params[p]) << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
+			}
 
-							if(addMemberFns)
-							{
-								if(add_fn(inputVars[v].first + ".close", 'n', 
-								          "@stream.close{mf}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")", 
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/, 
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-
-								if(add_fn(inputVars[v].first + ".open", 'n', 
-								          "@stream.open{mf}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")", 
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/, 
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-							}
-						}
-						else if(varType == "ifstream")
-						{
-							if(inputVars[v].second.size() > 1)
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: ifstream definition for " << quote(inputVars[v].first) << " should have 0-1 input variables, got " << inputVars[v].second.size() << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-							else if(!inputVars[v].second.size())
-								vars.layers[layer].ifstreams[inputVars[v].first] = std::ifstream();
-							else if(file_exists(inputVars[v].second[0]))
-							{
-								vars.layers[layer].ifstreams[inputVars[v].first].open(inputVars[v].second[0]);
+			if(p == 0 && addOutput)
+			{
+				if(!vars.add_str_from_var(vpos, outStr, 1, indent, indentAmount))
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << "--: cannot get string of var type " << quote(vpos.type) << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
+			}
 
-								if(!vars.layers[layer].ifstreams[inputVars[v].first].is_open())
-								{
-									if(!consoleLocked)
-										os_mtx->lock();
-									start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: failed to open input path for " << quote(inputVars[v].first) << std::endl;
-									start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: path given = " << quote(inputVars[v].second[0]) << std::endl;
-									os_mtx->unlock();
-									return 1;
-								}
-							}
-							else
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: path given for " << quote(inputVars[v].first) << " is not an existing file" << std::endl;
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: path given = " << quote(inputVars[v].second[0]) << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
+			if(vpos.type.substr(0, 5) == "std::")
+			{
+				if(vpos.type == "std::int")
+					--vars.layers[vpos.layer].ints[params[p]];
+				else if(vpos.type == "std::bool")
+				{
+					if(vars.layers[vpos.layer].bools[params[p]])
+						vars.layers[vpos.layer].bools[params[p]] = 0;
+					else
+						vars.layers[vpos.layer].bools[params[p]] = 1;
+				}
+				else if(vpos.type == "std::double")
+					--vars.layers[vpos.layer].doubles[params[p]];
+				else if(vpos.type == "std::char")
+					--vars.layers[vpos.layer].chars[params[p]];
+				else if(vpos.type == "std::llint")
+					--vars.layers[vpos.layer].llints[params[p]];
+			}
+			else if(vpos.type == "int")
+				--vars.layers[vpos.layer].doubles[params[p]];
+			else if(vpos.type == "bool")
+			{
+				if(vars.layers[vpos.layer].doubles[params[p]])
+					vars.layers[vpos.layer].doubles[params[p]] = 0;
+				else
+					vars.layers[vpos.layer].doubles[params[p]] = 1;
+			}
+			else if(vpos.type == "double")
+				--vars.layers[vpos.layer].doubles[params[p]];
+			else if(vpos.type == "char" && vars.layers[vpos.layer].strings[params[p]].size())
+				--vars.layers[vpos.layer].strings[params[p]][0];
+			else
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "--: operator not defined for variable ";
+				eos << quote(params[p]) << " of type " << quote(vpos.type) << std::endl;
+				os_mtx->unlock();
+				return 1;
+			}
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "--: no variable named " << quote(params[p]) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-							if(addMemberFns)
-							{
-								if(add_fn(inputVars[v].first + ".close", 'n', 
-								          "@stream.close{mf}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")", 
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/, 
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-
-								if(add_fn(inputVars[v].first + ".open", 'n', 
-								          "@stream.open{mf}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")", 
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/, 
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-							}
-						}
-						else if(varType == "ofstream")
-						{
-							if(inputVars[v].second.size() > 1)
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: ofstream definition for " << quote(inputVars[v].first) << " should have 0-1 input variables, got " << inputVars[v].second.size() << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-							else if(!inputVars[v].second.size())
-								vars.layers[layer].ofstreams[inputVars[v].first] = std::ofstream();
-							else
-							{
-								vars.layers[layer].ofstreams[inputVars[v].first].open(inputVars[v].second[0]);
+	return 0;
+}
 
-								if(!vars.layers[layer].ofstreams[inputVars[v].first].is_open())
-								{
-									if(!consoleLocked)
-										os_mtx->lock();
-									start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: failed to open output path for " << quote(inputVars[v].first) << std::endl;
-									start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: path given = " << quote(inputVars[v].second[0]) << std::endl;
-									os_mtx->unlock();
-									return 1;
-								}
-							}
+int Parser::builtin_post_decrement(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const bool& addOutput = call.addOutput;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& params = call.params;
+	bool& hasIncrement = call.hasIncrement;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(hasIncrement)
+		funcName = "--";
 
-							if(addMemberFns)
-							{
-								if(add_fn(inputVars[v].first + ".close", 'n', 
-								          "@stream.close{mf}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")", 
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/, 
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-
-								if(add_fn(inputVars[v].first + ".open", 'n', 
-								          "@stream.open{mf}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")", 
-								          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/, 
-								          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
-									return 1;
-							}
-						}
-					}
-				}
+	VPos vpos;
+	for(size_t p=0; p<params.size(); p++)
+	{
+		if(vars.find(params[p], vpos))
+		{
+			if(vars.layers[vpos.layer].constants.count(params[p]))
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": attempted illegal change of constant variable " << quote(params[p]) << std::endl;
+				os_mtx->unlock();
+				return 1;
 			}
-			else if(valid_type(varType, readPath, antiDepsOfReadPath, lineNo, ":=(" + varType + ")", sLineNo, eos))
+			else if(vars.layers[vpos.layer].privates.count(params[p]))
 			{
-				std::vector<std::string> types;
-				std::string preType, typesStr;
-				size_t pos = varType.find_first_of('<');
-				if(pos < varType.size())
+				if(!vars.layers[vpos.layer].inScopes[params[p]].count(vars.layers[vars.layers.size()-1].scope))
 				{
-					preType = varType.substr(0, pos);
-					typesStr = varType.substr(pos, varType.size()-pos);
-
-					pos = 0;
-					if(read_params(types, pos, typesStr, readPath, lineNo, ":=(" + varType + ")", eos))
-						return 1;
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": attempted illegal change of private variable " << quote(params[p]) << std::endl;
+					os_mtx->unlock();
+					return 1;
 				}
-				else
-					preType = varType;
+			}
 
-				for(size_t v=0; v<inputVars.size(); v++)
+			if(vpos.type.substr(0, 5) == "std::")
+			{
+				if(vpos.type == "std::int")
+					--vars.layers[vpos.layer].ints[params[p]];
+				else if(vpos.type == "std::bool")
 				{
-					//checks whether variable exists at current scope
-					if(inputVars[v].first == "")
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: cannot have variable named " << quote(inputVars[v].first) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-					else if(vars.layers[layer].typeOf.count(inputVars[v].first))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: redeclaration of variable/function name " << quote(inputVars[v].first) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-					else if(vars.typeDefs.count(inputVars[v].first))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: cannot have type and variable named " << quote(inputVars[v].first) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
+					if(vars.layers[vpos.layer].bools[params[p]])
+						vars.layers[vpos.layer].bools[params[p]] = 0;
 					else
-					{
-						/*if(preType == "array")
-						{
-							std::cout << "arrayay" << std::endl;
-						}
-						else if(preType == "map")
-						{
-							std::cout << "mapyay" << std::endl;
-						}
-						else if(preType == "vector")
-						{
-							std::cout << "vecyay" << std::endl;
-						}
-						else */if(vars.typeDefs.count(preType))
-						{
-							/*std::vector<bool> typToDel, optToDel, parToDel;
-							std::vector<bool> typWasConst, optWasConst, parWasConst;
-							std::vector<std::string> oldTypTypes, oldOptTypes, oldParTypes;
-							int old_no_types = 0, old_no_options = 0, old_no_params = 0;
-							std::vector<std::string> oldTyps, oldOpts, oldPars;*/
-
-							std::vector<std::string> oldOpts, oldPars, oldTypes;
-							std::string oldOptType, oldParType, oldTypesType;
-							bool optWasConst = 0, parWasConst = 0, typesWasConst = 0;
-							bool optWasPrivate = 0, parWasPrivate = 0, typesWasPrivate = 0;
+						vars.layers[vpos.layer].bools[params[p]] = 1;
+				}
+				else if(vpos.type == "std::double")
+					--vars.layers[vpos.layer].doubles[params[p]];
+				else if(vpos.type == "std::char")
+					--vars.layers[vpos.layer].chars[params[p]];
+				else if(vpos.type == "std::llint")
+					--vars.layers[vpos.layer].llints[params[p]];
+			}
+			else if(vpos.type == "int")
+				--vars.layers[vpos.layer].doubles[params[p]];
+			else if(vpos.type == "bool")
+			{
+				if(vars.layers[vpos.layer].doubles[params[p]])
+					vars.layers[vpos.layer].doubles[params[p]] = 0;
+				else
+					vars.layers[vpos.layer].doubles[params[p]] = 1;
+			}
+			else if(vpos.type == "double")
+				--vars.layers[vpos.layer].doubles[params[p]];
+			else if(vpos.type == "char" && vars.layers[vpos.layer].strings[params[p]].size())
+				--vars.layers[vpos.layer].strings[params[p]][0];
+			else
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": operator not defined for variable ";
+				eos << quote(params[p]) << " of type " << quote(vpos.type) << std::endl;
+				os_mtx->unlock();
+				return 1;
+			}
 
-							bool varNameToDel = 1, varNameWasConst = 0;
-							std::string oldVarNameType, oldVarName;
+			if(p == 0 && addOutput)
+			{
+				if(!vars.add_str_from_var(vpos, outStr, 1, indent, indentAmount))
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot get string of var type " << quote(vpos.type) << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
+			}
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": no variable named " << quote(params[p]) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-							params = inputVars[v].second;
+	return 0;
+}
 
-							//backs up variables already defined at this scope
-							if(vars.layers[0].typeOf.count("options"))
-							{
-								if(vars.layers[0].constants.count("options"))
-									optWasConst = 1;
-								if(vars.layers[0].privates.count("options"))
-									optWasPrivate = 1;
+int Parser::builtin_multiply(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "*", eos))
+		return 1;
 
-								oldOptType = vars.layers[0].typeOf["options"];
+	bool doDouble = 0;
+	int typeInt;
 
-								if(oldOptType == "std::vector<string>")
-								{
-									oldOpts = vars.layers[0].strVecs["options"];
-									vars.layers[0].strVecs["__options"] = oldOpts;
-								}
+	for(size_t p=0; p<params.size(); p++)
+	{
+		typeInt = getTypeInt(params[p]);
 
-								vars.layers[0].typeOf.erase("options");
-							}
-
-							if(vars.layers[0].typeOf.count("params.name"))
-							{
-								varNameToDel = 0;
-								if(vars.layers[0].constants.count("params.name"))
-									varNameWasConst = 1;
-								oldVarNameType = vars.layers[0].typeOf["params.name"];
-								if(oldVarNameType == "string")
-									oldVarName = vars.layers[0].strings["params.name"];
-							}
-
-							if(vars.layers[0].typeOf.count("params"))
-							{
-								if(vars.layers[0].constants.count("params"))
-									parWasConst = 1;
-								if(vars.layers[0].privates.count("params"))
-									parWasPrivate = 1;
-
-								oldParType = vars.layers[0].typeOf["params"];
-
-								if(oldParType == "std::vector<string>")
-								{
-									oldPars = vars.layers[0].strVecs["params"];
-									vars.layers[0].strVecs["__params"] = oldPars;
-								}
-
-								vars.layers[0].typeOf.erase("params");
-							}
-
-							if(vars.layers[0].typeOf.count("types"))
-							{
-								if(vars.layers[0].constants.count("types"))
-									typesWasConst = 1;
-								if(vars.layers[0].privates.count("types"))
-									typesWasPrivate = 1;
-
-								oldTypesType = vars.layers[0].typeOf["types"];
+		if(typeInt == 1)
+			doDouble = 1;
+		else if(typeInt == 2)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "*: cannot perform operator on " << params[p] << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-								if(oldTypesType == "std::vector<string>")
-								{
-									oldTypes = vars.layers[0].strVecs["types"];
-									//vars.layers[0].strVecs["__types"] = oldTypes;
-								}
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "d" || options[o] == "double")
+				doDouble = 1;
+		}
+	}
 
-								vars.layers[0].typeOf.erase("types");
-							}
+	if(doDouble)
+	{
+		double ans = std::strtod(params[0].c_str(), NULL);
+		for(size_t p=1; p<params.size(); p++)
+			ans *= std::strtod(params[p].c_str(), NULL);
 
-							//defines types/params/options
-							if(addMemberFns && !vars.layers[0].functions.count("options.at"))
-							{
-								std::string toParse = ":={layer=0}(std::vector<string>, options)";
-								std::string trash;
-								if(f_read_and_process_fast(0, toParse, lineNo, readPath, antiDepsOfReadPath, trash, eos) > 0)
-								{
-									if(!consoleLocked)
-										os_mtx->lock();
-									start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to define options vector" << std::endl;
-									os_mtx->unlock();
-									return 1;
-								}
-							}
-							else
-								vars.layers[0].typeOf["options"] = "std::vector<string>";
-							vars.layers[0].strVecs["options"] = options;
-							vars.layers[0].constants.insert("options");
+		params[0] = vars.double_to_string(ans, 0);
+	}
+	else
+	{
+		int ans = std::atoi(params[0].c_str());
+		for(size_t p=1; p<params.size(); p++)
+			ans *= std::atoi(params[p].c_str());
 
-							vars.layers[0].typeOf["params.name"] = "string";
-							vars.layers[0].strings["params.name"] = inputVars[v].first;
-							vars.layers[0].constants.insert("params.name");
+		params[0] = std::to_string(ans);
+	}
 
-							if(addMemberFns && !vars.layers[0].functions.count("params.at"))
-							{
-								std::string toParse = ":={layer=0}(std::vector<string>, params)";
-								std::string trash;
-								if(f_read_and_process_fast(0, toParse, lineNo, readPath, antiDepsOfReadPath, trash, eos) > 0)
-								{
-									if(!consoleLocked)
-										os_mtx->lock();
-									start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to define params vector" << std::endl;
-									os_mtx->unlock();
-									return 1;
-								}
-							}
-							else
-								vars.layers[0].typeOf["params"] = "std::vector<string>";
-							vars.layers[0].strVecs["params"] = params;
-							vars.layers[0].constants.insert("params");
+	outStr += params[0];
+	if(indent)
+		indentAmount.add_text(params[0]);
 
-							if(addMemberFns && !vars.layers[0].functions.count("types.at"))
-							{
-								std::string toParse = ":={layer=0}(std::vector<string>, types)";
-								std::string trash;
-								if(f_read_and_process_fast(0, toParse, lineNo, readPath, antiDepsOfReadPath, trash, eos) > 0)
-								{
-									if(!consoleLocked)
-										os_mtx->lock();
-									start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to define types vector" << std::endl;
-									os_mtx->unlock();
-									return 1;
-								}
-							}
-							else
-								vars.layers[0].typeOf["types"] = "std::vector<string>";
-							vars.layers[0].strVecs["types"] = types;
-							vars.layers[0].constants.insert("types");
+	return 0;
+}
 
-							//parses typedef function
-							std::string defOutput;
-							if(vars.nTypes.count(preType))
-							{
-								if(n_read_and_process_fast(1, vars.typeDefs[preType], vars.typeDefLineNo[preType]-1, vars.typeDefPath[preType], antiDepsOfReadPath, defOutput, eos) > 0)
-								{
-									if(!consoleLocked)
-										os_mtx->lock();
-									start_err_ml(eos, readPath, sLineNo, lineNo) << ":=(" << varType << "): failed here" << std::endl;
-									os_mtx->unlock();
-									return 1;
-								}
-							}
-							else 
-							{
-								if(f_read_and_process_fast(0, vars.typeDefs[preType], vars.typeDefLineNo[preType]-1, vars.typeDefPath[preType], antiDepsOfReadPath, defOutput, eos) > 0)
-								{
-									if(!consoleLocked)
-										os_mtx->lock();
-									start_err_ml(eos, readPath, sLineNo, lineNo) << ":=(" << varType << "): failed here" << std::endl;
-									os_mtx->unlock();
-									return 1;
-								}
-							}
+int Parser::builtin_multiply_assign(FnCall& call)
+{
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(params.size() < 2)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "*=: expected 2+ parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-							//reverts existing variables otherwise deletes them
-							if(!optWasConst)
-								vars.layers[0].constants.erase("options");
-							if(!optWasPrivate)
-								vars.layers[0].privates.erase("options");
-							if(oldOptType == "std::vector<string>")
-							{
-								vars.layers[0].strVecs["options"] = oldOpts;
-								vars.layers[0].strVecs.erase("__options");
-							}
-							else
-							{
-								vars.layers[0].strVecs.erase("options");
-								if(oldOptType == "")
-									vars.layers[0].typeOf.erase("options");
-								else
-									vars.layers[0].typeOf["options"] = oldOptType;
-							}
+	VPos vpos;
+	if(vars.find(params[0], vpos))
+	{
+		if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "*=", eos))
+			return 1;
 
-							if(!varNameWasConst)
-								vars.layers[0].constants.erase("params.name");
-							if(oldVarNameType == "string")
-								vars.layers[0].strings["params.name"] = oldVarName;
-							else
-							{
-								vars.layers[0].strings.erase("params.name");
-								if(varNameToDel)
-									vars.layers[0].typeOf.erase("params.name");
-								else
-									vars.layers[0].typeOf["params.name"] = oldVarNameType;
-							}
+		bool doDouble = 0;
+		int typeInt;
 
-							if(!parWasConst)
-								vars.layers[0].constants.erase("params");
-							if(!parWasPrivate)
-								vars.layers[0].privates.erase("params");
-							if(oldParType == "std::vector<string>")
-							{
-								vars.layers[0].strVecs["params"] = oldPars;
-								vars.layers[0].strVecs.erase("__params");
-							}
-							else
-							{
-								vars.layers[0].strVecs.erase("params");
-								if(oldParType == "")
-									vars.layers[0].typeOf.erase("params");
-								else
-									vars.layers[0].typeOf["params"] = oldParType;
-							}
+		for(size_t p=0; p<params.size(); p++)
+		{
+			typeInt = getTypeInt(params[p]);
 
-							if(!typesWasConst)
-								vars.layers[0].constants.erase("types");
-							if(!typesWasPrivate)
-								vars.layers[0].privates.erase("types");
-							if(oldTypesType == "std::vector<string>")
-							{
-								vars.layers[0].strVecs["types"] = oldTypes;
-								//vars.layers[0].strVecs.erase("__types");
-							}
-							else
-							{
-								vars.layers[0].strVecs.erase("types");
-								if(oldTypesType == "")
-									vars.layers[0].typeOf.erase("types");
-								else
-									vars.layers[0].typeOf["types"] = oldTypesType;
-							}
-						}
-					}
-				}
-			}
-			else
+			if(typeInt == 1)
+				doDouble = 1;
+			else if(typeInt == 2)
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: do not recognise the type " << quote(varType) << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "*=: operator not defined for parameter " << p << " = " << quote(params[p]) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+		}
 
-			//sets whether variables are constants/privates
-			if(constants || privates)// || custScope)
+		if(options.size())
+		{
+			for(size_t o=0; o<options.size(); o++)
 			{
-				for(size_t v=0; v<inputVars.size(); v++)
-				{
-					if(constants)
-						vars.layers[layer].constants.insert(inputVars[v].first);
-					if(privates)
-					{
-						vars.layers[layer].privates.insert(inputVars[v].first);
-						//vars.layers[layer].scopeOf[inputVars[v].first] = inputVars[v].first.substr(0, inputVars[v].first.find_last_of('.')+1);
-					}
-					/*else if(custScope)
-					{
-						vars.layers[layer].privates.insert(inputVars[v].first);
-						//vars.layers[layer].scopeOf[inputVars[v].first] = scopeOf;
-					}*/
-				}
-
-				if(varType == "fstream" || varType == "ifstream" || varType == "ofstream")
-				{
-					for(size_t v=0; v<inputVars.size(); v++)
-					{
-						if(constants)
-						{
-							vars.layers[layer].constants.insert(inputVars[v].first + ".close");
-							vars.layers[layer].constants.insert(inputVars[v].first + ".open");
-						}
-						else if(privates)
-						{
-							vars.layers[layer].privates.insert(inputVars[v].first + ".close");
-							vars.layers[layer].privates.insert(inputVars[v].first + ".open");
-							//vars.layers[layer].scopeOf[inputVars[v].first + ".close"] = inputVars[v].first.substr(0, inputVars[v].first.find_last_of('.')+1);
-						}
-						/*else if(custScope)
-						{
-							vars.layers[layer].privates.insert(inputVars[v].first + ".close");
-							//vars.layers[layer].scopeOf[inputVars[v].first + ".close"] = scopeOf;
-						}*/
-					}
-				}
+				if(options[o] == "d" || options[o] == "double")
+					doDouble = 1;
 			}
+		}
 
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+		if(doDouble)
+		{
+			double ans = std::strtod(params[0].c_str(), NULL);
+			for(size_t p=1; p<params.size(); p++)
+				ans *= std::strtod(params[p].c_str(), NULL);
 
-			return 0;
+			params[0] = vars.double_to_string(ans, 0);
+		}
+		else
+		{
+			int ans = std::atoi(params[0].c_str());
+			for(size_t p=1; p<params.size(); p++)
+				ans *= std::atoi(params[p].c_str());
+
+			params[0] = std::to_string(ans);
 		}
+
+		if(!set_var_from_str(vpos, params[0], readPath, sLineNo, "*=", eos))
+			return 1;
 	}
-	else if(funcName[0] == 'h')
+	else
 	{
-		if(funcName == "hash")
-		{
-			if(params.size() != 1 && params.size() != 2)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "hash: expected 1-2 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "*=: there are no variables defined as " << quote(params[0]) << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); ++o)
-				{
-					if(options[o] == "f")
-					{
-						if(!file_exists(params[0]))
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << "hash: path " << Path(params[0], "") << " does not exist" << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-						params[0] = string_from_file(params[0]);
-					}
-				}
-			}
+	return 0;
+}
 
-			if(params.size() == 1)
-				params.push_back("RS");
-
-			if(params[1] == "RS")
-				params[0] = std::to_string(RSHash(params[0]));
-			else if(params[1]  == "JS")
-				params[0] = std::to_string(JSHash(params[0]));
-			else if(params[1] == "PJW")
-				params[0] = std::to_string(PJWHash(params[0]));
-			else if(params[1] == "ELF")
-				params[0] = std::to_string(ELFHash(params[0]));
-			else if(params[1] == "BKDR")
-				params[0] = std::to_string(BKDRHash(params[0]));
-			else if(params[1] == "SDBM")
-				params[0] = std::to_string(SDBMHash(params[0]));
-			else if(params[1] == "DJB")
-				params[0] = std::to_string(DJBHash(params[0]));
-			else if(params[1] == "DEK")
-				params[0] = std::to_string(DEKHash(params[0]));
-			else if(params[1] == "FNV")
-				params[0] = std::to_string(FNVHash(params[0]));
-			else if(params[1] == "BP")
-				params[0] = std::to_string(BPHash(params[0]));
-			else if(params[1] == "AP")
-				params[0] = std::to_string(APHash(params[0]));
-
-			outStr += params[0];
-			if(indent)
-				indentAmount += into_whitespace(params[0]);
+int Parser::builtin_divide(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	bool oldFP = vars.fixedPrecision;
+	vars.fixedPrecision = 1;
+
+	/*if(parse_replace(lang, params, "/ params", readPath, antiDepsOfReadPath, sLineNo, "/", sLineNo, eos))
+		return 1;*/ //should change fixed precision earlier for this function!!
+
+	if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "/", eos))
+		return 1;
 
-			return 0;
+	vars.fixedPrecision = oldFP;
+
+	bool doDouble = 0;
+	int typeInt;
+
+	for(size_t p=0; p<params.size(); p++)
+	{
+		typeInt = getTypeInt(params[p]);
+
+		if(typeInt == 1)
+			doDouble = 1;
+		else if(typeInt == 2)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "/: cannot perform operator on " << params[p] << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "d" || options[o] == "double")
+				doDouble = 1;
 		}
 	}
-	else if(funcName[0] == 'g')
+
+	if(doDouble)
+	{
+		double ans = std::strtod(params[0].c_str(), NULL);
+		for(size_t p=1; p<params.size(); p++)
+			ans /= std::strtod(params[p].c_str(), NULL);
+
+		params[0] = vars.double_to_string(ans, 0);
+	}
+	else
+	{
+		int ans = std::atoi(params[0].c_str());
+		for(size_t p=1; p<params.size(); p++)
+			ans /= std::atoi(params[p].c_str());
+
+		params[0] = std::to_string(ans);
+	}
+
+	outStr += params[0];
+	if(indent)
+		indentAmount.add_text(params[0]);
+
+	return 0;
+}
+
+int Parser::builtin_divide_assign(FnCall& call)
+{
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(params.size() < 2)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "/=: expected 2+ parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	VPos vpos;
+	if(vars.find(params[0], vpos))
 	{
-		if(funcName == "getline")
+		bool oldFP = vars.fixedPrecision;
+		vars.fixedPrecision = 1;
+
+		/*if(parse_replace(lang, params, "/ params", readPath, antiDepsOfReadPath, sLineNo, "/", sLineNo, eos))
+			return 1;*/ //should change fixed precision earlier for this function!!
+
+		if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "/=", eos))
+			return 1;
+
+		vars.fixedPrecision = oldFP;
+
+		bool doDouble = 0;
+		int typeInt;
+
+		for(size_t p=0; p<params.size(); p++)
 		{
-			if(params.size() == 0)
+			typeInt = getTypeInt(params[p]);
+
+			if(typeInt == 1)
+				doDouble = 1;
+			else if(typeInt == 2)
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "getline: expected parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "/=: operator not defined for parameter " << p << " = " << quote(params[p]) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+		}
 
-			VPos spos, vpos;
-			bool fromConsole = 1;
-
-			if(params[0] != "console")
+		if(options.size())
+		{
+			for(size_t o=0; o<options.size(); o++)
 			{
-				fromConsole = 0;
-				vars.find(params[0], spos);
-
-				if(spos.type != "fstream" && spos.type != "ifstream" && spos.type != "sstream" && spos.type != "isstream")
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "getline: first parameter " << params[0] << " should be console or an input stream variable" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+				if(options[o] == "d" || options[o] == "double")
+					doDouble = 1;
 			}
+		}
 
-			std::string txt;
-			bool result = 1, addResult = 1;
+		if(doDouble)
+		{
+			double ans = std::strtod(params[0].c_str(), NULL);
+			for(size_t p=1; p<params.size(); p++)
+				ans /= std::strtod(params[p].c_str(), NULL);
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); ++o)
-				{
-					if(options[o] == "!r")
-						addResult = 0;
-				}
-			}
+			params[0] = vars.double_to_string(ans, 0);
+		}
+		else
+		{
+			int ans = std::atoi(params[0].c_str());
+			for(size_t p=1; p<params.size(); p++)
+				ans /= std::atoi(params[p].c_str());
 
-			if(params.size() == 1)
-			{
-				if(fromConsole)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					if(getline(std::cin, txt))
-						result = 1;
-					else
-						result = 0;
-					if(!consoleLocked)
-						os_mtx->unlock();
-				}
-				else
-					result = getline_from_stream(spos, txt);
+			params[0] = std::to_string(ans);
+		}
 
-				std::istringstream iss(txt);
-				std::string str, oldLine;
-				int fileLineNo = 0;
+		if(!set_var_from_str(vpos, params[0], readPath, sLineNo, "/=", eos))
+			return 1;
+	}
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "/=: there are no variables defined as " << quote(params[0]) << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-				while(!iss.eof())
-				{
-					getline(iss, str);
-					if(0 < fileLineNo++)
-						outStr += "\n" + indentAmount;
-					outStr += str;
-					oldLine = str;
-				}
-				if(indent)
-					indentAmount += into_whitespace(oldLine);
-			}
-			for(size_t p=1; p<params.size(); p++)
-			{
-				if(fromConsole)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					if(getline(std::cin, txt))
-						result = 1;
-					else
-						result = 0;
-					if(!consoleLocked)
-						os_mtx->unlock();
-				}
-				else
-					result = getline_from_stream(spos, txt);
+	return 0;
+}
 
-				if(!result)
-				{
-					if(addResult)
-					{
-						outStr += "0";
-						if(indent)
-							indentAmount += " ";
-					}
-					break;
-				}
+int Parser::builtin_mod(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(params.size() != 2)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "%: expected 2 parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
+	bool oldFP = vars.fixedPrecision;
+	vars.fixedPrecision = 1;
 
-				if(params[p] == "ofile")
-				{
-					addResult = 0;
-					std::istringstream iss(txt);
-					std::string str, oldLine;
-					int fileLineNo = 0;
+	/*if(parse_replace(lang, params, "/ params", readPath, antiDepsOfReadPath, sLineNo, "%", sLineNo, eos))
+		return 1;*/ //should change fixed precision earlier for this function!!
 
-					while(!iss.eof())
-					{
-						getline(iss, str);
-						if(0 < fileLineNo++)
-							outStr += "\n" + indentAmount;
-						outStr += str;
-						oldLine = str;
-					}
-					if(indent)
-						indentAmount += into_whitespace(oldLine);
-				}
-				else if(vars.find(params[p], vpos) && vpos.type == "string")
-				{
-					result = set_var_from_str(vpos, txt, readPath, lineNo, "getline", eos);
+	if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "%", eos))
+		return 1;
 
-					if(!result)
-					{
-						if(addResult)
-						{
-							outStr += "0";
-							if(indent)
-								indentAmount += " ";
-						}
-						break;
-					}
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "getline: parameter " << params[p] << " is not a defined string variable" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	vars.fixedPrecision = oldFP;
 
-				result = 1;
-			}
+	int typeInt;
 
-			if(result && addResult)
-			{
-				outStr += std::to_string(result);
-				if(indent)
-					indentAmount += into_whitespace(std::to_string(result));
-			}
+	for(size_t p=0; p<params.size(); p++)
+	{
+		typeInt = getTypeInt(params[p]);
 
-			return 0;
+		if(typeInt != 0)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "%: cannot perform operator on " << params[p] << std::endl;
+			os_mtx->unlock();
+			return 1;
 		}
-		else if(funcName == "getenv")
+	}
+
+	int ans = std::atoi(params[0].c_str())%std::atoi(params[1].c_str());
+
+	params[0] = std::to_string(ans);
+
+	outStr += params[0];
+	if(indent)
+		indentAmount.add_text(params[0]);
+
+	return 0;
+}
+
+int Parser::builtin_mod_assign(FnCall& call)
+{
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(params.size() != 2)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "%=: expected 2 parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	VPos vpos;
+	if(vars.find(params[0], vpos))
+	{
+		bool oldFP = vars.fixedPrecision;
+		vars.fixedPrecision = 1;
+
+		/*if(parse_replace(lang, params, "/ params", readPath, antiDepsOfReadPath, sLineNo, "%=", sLineNo, eos))
+			return 1;*/ //should change fixed precision earlier for this function!!
+
+		if(replaceVars && replace_vars(params, 0, readPath, sLineNo, "%=", eos))
+			return 1;
+
+		vars.fixedPrecision = oldFP;
+
+		int typeInt;
+
+		for(size_t p=0; p<params.size(); p++)
 		{
-			if(params.size() != 1)
+			typeInt = getTypeInt(params[p]);
+
+			if(typeInt != 0)
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "getenv: expected 1 parameter, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "%=: operator not defined for parameter " << p << " = " << quote(params[p]) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+		}
 
-			params[0] = get_env(params[0].c_str());
+		int ans = std::atoi(params[0].c_str())%std::atoi(params[1].c_str());
 
-			outStr += params[0];
-			if(indent)
-				indentAmount += into_whitespace(params[0]);
+		params[0] = std::to_string(ans);
 
-			return 0;
+		if(!set_var_from_str(vpos, params[0], readPath, sLineNo, "%=", eos))
+			return 1;
+	}
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "%=: there are no variables defined as " << quote(params[0]) << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	return 0;
+}
+
+int Parser::builtin_ternary(FnCall& call)
+{
+	const char& lang = call.lang;
+	const bool& addOutput = call.addOutput;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	int& conditionLineNo = call.conditionLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& doNotParse = call.doNotParse;
+	bool& replaceVars = call.replaceVars;
+
+	if(!params.size())
+		return NSM_NOT_BUILTIN;
+
+	if(params.size() != 3)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "?: expected 3 parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	bool result, addOut= addOutput;
+	char ternaryLang = lang;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); ++o)
+		{
+			if(options[o] == "f++")
+				ternaryLang = 'f';
+			else if(options[o] == "n++")
+				ternaryLang = 'n';
+			else if(options[o] == "o")
+				addOut = 1;
+			else if(options[o] == "!o")
+				addOut = 0;
 		}
 	}
-	else if(funcName[0] == 'w')
+
+	if(get_bool(result, params[0]))
+	{}
+	else
 	{
-		if(funcName == "write")
+		if(params[0] != "" && expr.compile(params[0]))
+			result = expr.evaluate();
+		else
 		{
-			if(params.size() < 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "write: expected parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
+			std::string parsedCondition = params[0];
+
+			if(!doNotParse && parse_replace('f', parsedCondition, "? condition", readPath, antiDepsOfReadPath, sLineNo, "?", sLineNo, eos))
 				return 1;
-			}
 
-			bool readBlock = 0, parseBlock = 1;
-			char bLang = lang;
-			int bLineNo = lineNo;
-			std::string txt;
+			if(replaceVars && replace_var(parsedCondition, readPath, sLineNo, "?", eos))
+				return 1;
 
-			if(options.size())
+			if(!get_bool(result, parsedCondition))
 			{
-				for(size_t o=0; o<options.size(); o++)
+				if(parsedCondition != "" && expr.compile(parsedCondition))
+					result = expr.evaluate();
+				else
 				{
-					if(options[o] == "b" || options[o] == "block")
-						readBlock = 1;
-					else if(options[o] == "!pb")
-						parseBlock = 0;
-					else if(options[o] == "f++")
-						bLang = 'f';
-					else if(options[o] == "n++")
-						bLang = 'n';
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err(eos, readPath, conditionLineNo) << "?: cannot convert " << quote(parsedCondition) << " to bool" << std::endl;
+					start_err(eos, readPath, conditionLineNo) << "?: possible errors from ExprTk:" << std::endl;
+					print_exprtk_parser_errs(eos, expr.errors(), expr.expr_str, readPath, sLineNo);
+					os_mtx->unlock();
+					return 1;
 				}
 			}
+		}
+	}
 
-			if(readBlock)
-			{
-				if(read_block(txt, linePos, inStr, readPath, lineNo, bLineNo, "write{block}", eos))
-				   return 1;
+	std::string block;
 
-				if(parseBlock && parse_replace(bLang, txt, "write block", readPath, antiDepsOfReadPath, lineNo, "write{block}", sLineNo, eos))
-					return 1;
+	if(result)
+		block = params[1];
+	else
+		block = params[2];
 
-				txt += "\r\n";
-			}
-			else if(params.size() == 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "write: expected 2+ parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	int ret_val;
 
-			VPos vpos;
-			std::string gIndentAmount;
-			for(size_t p=1; p<params.size(); p++)
-			{
-				if(params[p] == "endl")
-					txt += "\r\n";
-				else if(vars.find(params[p], vpos))
-				{
-					gIndentAmount = "";
-					if(!vars.add_str_from_var(vpos, txt, 1, indent, gIndentAmount))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "write: cannot get string of var type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-				else
-					txt += params[p];
-			}
+	if(ternaryLang == 'n')
+		ret_val = n_read_and_process_fast(1, addOut, block, sLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
+	else
+		ret_val = f_read_and_process_fast(addOut, block, sLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
 
-			if(params[0] == "ofile")
-			{
-				std::istringstream iss(txt);
-				std::string str, oldLine;
-				int fileLineNo = 0;
+	if(ret_val == NSM_BREAK)
+		return NSM_BREAK;
+	else if(ret_val)
+		return ret_val;
 
-				while(!iss.eof())
-				{
-					getline(iss, str);
-					if(0 < fileLineNo++)
-						outStr += "\n" + indentAmount;
-					outStr += str;
-					oldLine = str;
-				}
-				if(indent)
-					indentAmount += into_whitespace(oldLine);
-			}
-			else if(params[0] == "console")
+	return 0;
+}
+
+int Parser::builtin_define(FnCall& call)
+{
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::string& paramsStr = call.paramsStr;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	if(paramsStr == "")
+		return NSM_NOT_BUILTIN;
+
+	std::string varType;
+	std::vector<std::pair<std::string, std::vector<std::string> > > inputVars;
+	bool constants = 0, privates = 0, addToExpr = 1, addMemberFns = addMemberFnsGlobal, normalVecDef = 1;
+	int pOption = -1;
+	size_t layer = vars.layers.size()-1;
+	std::string vScope, bScope;
+	std::unordered_set<std::string> inScopes;
+
+	size_t pos=0;
+	if(read_def(varType, inputVars, pos, paramsStr, readPath, lineNo, ":=", eos))
+		return 1;
+
+	/*if(!valid_type(varType, readPath, antiDepsOfReadPath, sLineNo, ":=", sLineNo, eos))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: invalid type: " << quote(varType) << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}*/
+
+	if(varType == "std::vector<double>")
+		addToExpr = 0;
+
+	//streams open files, which clones leave to the page
+	if(itemClone && (varType == "fstream" || varType == "ifstream" || varType == "ofstream"))
+		return 1;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "et" || options[o] == "exprtk")
+				addToExpr = 1;
+			else if(options[o] == "!et" || options[o] == "!exprtk")
+				addToExpr = 0;
+			else if(options[o] == "const")
+				constants = 1;
+			else if(options[o] == "mf")
+				addMemberFns = 1;
+			else if(options[o] == "!mf")
+				addMemberFns = 0;
+			else if(options[o] == "private")
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				if(lolcatActive)
-					rnbwcout(txt);
-				else
-					eos << txt;
-				if(!consoleLocked)
-					os_mtx->unlock();
+				privates = 1;
+				pOption = o;
 			}
-			else
+			else if(options[o].substr(0, 6) == "layer=")
 			{
-				VPos vpos;
-				if(vars.find(params[0], vpos))
-				{
-					if(vpos.type == "fstream")
-						vars.layers[vpos.layer].fstreams[params[0] ] << txt;
-					else if(vpos.type == "ofstream")
-					{
-						vars.layers[vpos.layer].ofstreams[params[0] ] << txt;
-					}
-					else
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "write is not defined for parameter " << quote(params[0]) << " of type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
+				std::string str = unquote(options[o].substr(6, options[o].size()-6));
 
-					}
+				if(!isNonNegInt(str))
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: specified layer " << quote(str) << " is not a non-negative integer" << std::endl;
+					os_mtx->unlock();
+					return 1;
 				}
-				else
+				layer = std::atoi(str.c_str());
+				if(layer >= vars.layers.size())
 				{
 					if(!consoleLocked)
 						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "write: no variable named " << params[0] << std::endl;
+					start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: specified layer " << quote(str) << " should be less than the number of layers" << std::endl;
 					os_mtx->unlock();
 					return 1;
 				}
 			}
-
-			return 0;
+			else if(options[o].substr(0, 7) == "scope+=")
+			{
+				privates = 1;
+				inScopes.insert(unquote(options[o].substr(7, options[o].size()-7)));
+			}
+			else if(options[o] == "...")
+				normalVecDef = 0;
 		}
-		else if(funcName == "while")
+	}
+
+	bScope = vars.layers[layer].scope;
+	if(pOption != -1)
+		options[pOption] = "scope+=" + vars.layers[layer].scope;
+
+	if(vars.basic_types.count(varType))
+	{
+		for(size_t v=0; v<inputVars.size(); v++)
 		{
-			if(params.size() != 1)
+			int varId = name_id(inputVars[v].first);
+
+			//checks whether variable exists at current scope
+			if(inputVars[v].first == "")
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: cannot have variable named " << quote(inputVars[v].first) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
-
-			bool first = 1, addNewLines = 1, addIndent = 1, addScope = addScopeGlobal, addOut = addOutput;
-			char wLang = lang;
-			std::string block, parsedCondition, eob = "\n", wBaseIndentAmount = indentAmount;
-			int bLineNo = lineNo;
-
-			if(read_block(block, linePos, inStr, readPath, lineNo, bLineNo, "while(" + params[0] + ")", eos))
+			else if(vars.layers[layer].typeOf.count(varId))
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: redeclaration of variable/function name " << quote(inputVars[v].first) << std::endl;
+				os_mtx->unlock();
 				return 1;
-
-			if(options.size())
+			}
+			else if(vars.typeDefs.count(inputVars[v].first))
 			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "!o")
-						addOut = 0;
-					else if(options[o] == "!\n")
-						addNewLines = 0;
-					else if(options[o] == "\n")
-						eob = "\n\n";
-					else if(options[o].substr(0, 4) == "eob=")
-					{
-						eob = unquote(options[o].substr(4, options[o].size()-4));
-						if(eob[eob.size()-1] != '\n')
-							addIndent = 0;
-					}
-					else if(options[o] == "s")
-						addScope = 1;
-					else if(options[o] == "!s")
-						addScope = 0;
-					else if(options[o] == "n++")
-						wLang = 'n';
-					else if(options[o] == "f++")
-						wLang = 'f';
-				}
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: cannot have type and variable named " << quote(inputVars[v].first) << std::endl;
+				os_mtx->unlock();
+				return 1;
 			}
-
-			bool boolCond = 0, exprtkCond = 0, varCond = 0, result;
-			Expr condExpr;
-			VPos vpos;
-
-			if(get_bool(result, params[0]))
-				boolCond = 1;
 			else
 			{
-				condExpr.register_symbol_table(symbol_table);
-				if(params[0] != "" && condExpr.compile(params[0]))
-					exprtkCond = 1;
-				else if(replaceVars && vars.find(params[0], vpos))
-						varCond = 1;
-			}
+				vars.layers[layer].typeOf.at(varId, inputVars[v].first) = varType;
+				int pos = find_last_of_special(inputVars[v].first);
+				if(pos)
+					vScope = bScope + inputVars[v].first.substr(0, pos) + ".";
+				else
+					vScope = bScope;
+				vars.layers[layer].inScopes[inputVars[v].first].insert(vScope);
+				for(auto it=inScopes.begin(); it!=inScopes.end(); it++)
+					vars.layers[layer].inScopes[inputVars[v].first].insert(*it);
+				vars.layers[layer].scopeOf[inputVars[v].first] = vScope;
 
-			while(1)
-			{
-				if(boolCond)
-				{
-					if(!result)
-						break;
-				}
-				else if(exprtkCond)
-				{
-					if(!condExpr.evaluate())
-						break;
-				}
-				else if(varCond)
+				if(varType == "bool")
 				{
-					if(!vars.get_bool_from_var(vpos, result))
+					if(!inputVars[v].second.size())
+						inputVars[v].second.push_back("0");
+
+					if(inputVars[v].second.size() != 1)
 					{
 						if(!consoleLocked)
 							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot get bool from variable ";
-						eos << quote(vpos.name) << " of type " << quote(vpos.type) << std::endl;
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: bool definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
 						os_mtx->unlock();
 						return 1;
 					}
+					else if(inputVars[v].second[0] == "1" || inputVars[v].second[0] == "true")
+					{
+						vars.layers[layer].doubles.at(varId, inputVars[v].first) = 1;
 
-					if(!result)
-						break;
-				}
-				else
-				{
-					parsedCondition = params[0];
+						if(addToExpr)
+							exprCache.add_variable(inputVars[v].first, vars.layers[layer].doubles.at(varId, inputVars[v].first));
+					}
+					else if(inputVars[v].second[0] == "0" || inputVars[v].second[0] == "false")
+					{
+						vars.layers[layer].doubles.at(varId, inputVars[v].first) = 0;
 
-					if(parse_replace('f', parsedCondition, "while condition", readPath, antiDepsOfReadPath, conditionLineNo, "while(" + params[0] + ")", sLineNo, eos))
-						return 1;
-
-					if(replaceVars && replace_var(parsedCondition, readPath, conditionLineNo, "while", eos))
-						return 1;
-
-					if(!get_bool(result, parsedCondition))
-					{
-						if(parsedCondition != "" && condExpr.compile(parsedCondition))
-							result = condExpr.evaluate();
-						else
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err(eos, readPath, conditionLineNo) << funcName << ": cannot convert " << quote(parsedCondition) << " to bool" << std::endl;
-							start_err(eos, readPath, sLineNo) << funcName << ": possible errors from exprtk:" << std::endl;
-							print_exprtk_parser_errs(eos, condExpr.parser, condExpr.expr_str, readPath, sLineNo);
-							os_mtx->unlock();
-							return 1;
-						}
+						if(addToExpr)
+							exprCache.add_variable(inputVars[v].first, vars.layers[layer].doubles.at(varId, inputVars[v].first));
 					}
+					else if(isInt(inputVars[v].second[0]))
+					{
+						vars.layers[layer].doubles.at(varId, inputVars[v].first) = (bool)std::atoi(inputVars[v].second[0].c_str());
 
-					if(!result)
-						break;
-				}
+						if(addToExpr)
+							exprCache.add_variable(inputVars[v].first, vars.layers[layer].doubles.at(varId, inputVars[v].first));
+					}
+					else if(isDouble(inputVars[v].second[0]))
+					{
+						vars.layers[layer].doubles.at(varId, inputVars[v].first) = (bool)std::strtod(inputVars[v].second[0].c_str(), NULL);
 
-				if(first)
-					first = 0;
-				else
-				{
-					if(addNewLines && addOut)
+						if(addToExpr)
+							exprCache.add_variable(inputVars[v].first, vars.layers[layer].doubles.at(varId, inputVars[v].first));
+					}
+					else
 					{
-						outStr += eob;
-						if(addIndent)
-						{
-							indentAmount = wBaseIndentAmount;
-							outStr += indentAmount;
-						}
-						else
-							indentAmount += into_whitespace(eob);
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not a boolean" << std::endl;
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
+						os_mtx->unlock();
+						return 1;
 					}
 				}
-
-				if(addScope)
+				else if(varType == "int")
 				{
-					std::string cScope = vars.layers[vars.layers.size()-1].scope;
-					vars.add_layer(cScope);
-					//vars.add_layer(vars.layers[vars.layers.size()-1].scope); //this is broken on windows!
-				}
-
-				int ret_val = 1;
-				if(wLang == 'n')
-					ret_val = n_read_and_process_fast(addOut, addOut, block, bLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
-				else if(wLang == 'f')
-					ret_val = f_read_and_process_fast(addOut, block, bLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
-
-				if(addScope)
-					vars.layers.pop_back();
-
-				if(ret_val == NSM_BREAK)
-					break;
-				else if(ret_val)
-					return ret_val;
-			}
-
-			if(!addOut)
-			{
-				if(linePos < inStr.size() && inStr[linePos] == '!')
-					++linePos;
-				else
-					skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
-			}
-
-			return 0;
-		}
-		else if(funcName == "warning")
-		{
-			if(params.size() != 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "warning: expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
-			if(!consoleLocked)
-				os_mtx->lock();
-			start_warn(eos, readPath, lineNo) << params[0] << std::endl;
-			if(!consoleLocked)
-				os_mtx->unlock();
-
-			return 0;
-		}
-	}
-	else if(funcName[0] == 'r')
-	{
-		if(funcName == "read")
-		{
-			if(params.size() == 0)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "read: expected parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+					if(!inputVars[v].second.size())
+						inputVars[v].second.push_back("0");
 
-			VPos spos, vpos;
-			bool fromConsole = 1;
+					if(inputVars[v].second.size() != 1)
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: int definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
+					else if(isInt(inputVars[v].second[0]))
+					{
+						vars.layers[layer].doubles.at(varId, inputVars[v].first) = std::atoi(inputVars[v].second[0].c_str());
 
-			if(params[0] != "console")
-			{
-				fromConsole = 0;
-				vars.find(params[0], spos);
+						if(addToExpr)
+							exprCache.add_variable(inputVars[v].first, vars.layers[layer].doubles.at(varId, inputVars[v].first));
+					}
+					else if(isDouble(inputVars[v].second[0]))
+					{
+						vars.layers[layer].doubles.at(varId, inputVars[v].first) = (int)std::strtod(inputVars[v].second[0].c_str(), NULL);
 
-				if(spos.type != "fstream" && spos.type != "ifstream" && spos.type != "sstream" && spos.type != "isstream")
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "read: first parameter " << params[0] << " should be console or an input stream variable" << std::endl;
-					os_mtx->unlock();
-					return 1;
+						if(addToExpr)
+							exprCache.add_variable(inputVars[v].first, vars.layers[layer].doubles.at(varId, inputVars[v].first));
+					}
+					else
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not an integer" << std::endl;
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
 				}
-			}
-
-			std::string txt;
-			bool result = 1, addResult = 1;
-
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); ++o)
+				else if(varType == "double")
 				{
-					if(options[o] == "!r")
-						addResult = 0;
-				}
-			}
+					if(!inputVars[v].second.size())
+						inputVars[v].second.push_back("0");
 
-			if(params.size() == 1)
-			{
-				if(fromConsole)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					std::cin >> txt;
-					if(!consoleLocked)
+					if(inputVars[v].second.size() != 1)
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: double definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
 						os_mtx->unlock();
-				}
-				else
-					result = read_str_from_stream(spos, txt);
-
-				std::istringstream iss(txt);
-				std::string str, oldLine;
-				int fileLineNo = 0;
+						return 1;
+					}
+					else if(isDouble(inputVars[v].second[0]))
+					{
+						vars.layers[layer].doubles.at(varId, inputVars[v].first) = std::strtod(inputVars[v].second[0].c_str(), NULL);
 
-				while(!iss.eof())
-				{
-					getline(iss, str);
-					if(0 < fileLineNo++)
-						outStr += "\n" + indentAmount;
-					outStr += str;
-					oldLine = str;
+						if(addToExpr)
+							exprCache.add_variable(inputVars[v].first, vars.layers[layer].doubles.at(varId, inputVars[v].first));
+					}
+					else
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not a double" << std::endl;
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
 				}
-				if(indent)
-					indentAmount += into_whitespace(oldLine);
-			}
-			for(size_t p=1; p<params.size(); p++)
-			{
-				if(fromConsole)
+				else if(varType == "char")
 				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					std::cin >> txt;
-					if(!consoleLocked)
+					if(!inputVars[v].second.size())
+						inputVars[v].second.push_back(" ");
+
+					if(inputVars[v].second.size() != 1)
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: character definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
 						os_mtx->unlock();
-				}
-				else
-					result = read_str_from_stream(spos, txt);
+						return 1;
+					}
+					else if(inputVars[v].second[0].size() == 1)
+					{
+						vars.layers[layer].strings.at(varId, inputVars[v].first) = inputVars[v].second[0];
 
-				if(!result)
-				{
-					if(addResult)
+						if(addToExpr)
+							exprCache.add_stringvar(inputVars[v].first, vars.layers[layer].strings.at(varId, inputVars[v].first));
+					}
+					else
 					{
-						outStr += "0";
-						if(indent)
-							indentAmount += " ";
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not a character" << std::endl;
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
+						os_mtx->unlock();
+						return 1;
 					}
-					break;
 				}
+				else if(varType == "string")
+				{
+					if(!inputVars[v].second.size())
+						inputVars[v].second.push_back(" ");
 
+					if(inputVars[v].second.size() != 1)
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: string definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
+					else
+					{
+						vars.layers[layer].strings.at(varId, inputVars[v].first) = inputVars[v].second[0];
 
-				if(params[p] == "ofile")
+						if(addToExpr)
+							exprCache.add_stringvar(inputVars[v].first, vars.layers[layer].strings.at(varId, inputVars[v].first));
+					}
+				}
+				else if(varType == "std::bool")
 				{
-					addResult = 0;
-					std::istringstream iss(txt);
-					std::string str, oldLine;
-					int fileLineNo = 0;
+					if(!inputVars[v].second.size())
+						inputVars[v].second.push_back("0");
 
-					while(!iss.eof())
+					if(inputVars[v].second.size() != 1)
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: std::bool definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
+					else if(inputVars[v].second[0] == "1" || inputVars[v].second[0] == "true")
+						vars.layers[layer].bools.at(varId, inputVars[v].first) = 1;
+					else if(inputVars[v].second[0] == "0" || inputVars[v].second[0] == "false")
+						vars.layers[layer].bools.at(varId, inputVars[v].first) = 1;
+					else if(isInt(inputVars[v].second[0]))
+						vars.layers[layer].bools.at(varId, inputVars[v].first) = (bool)std::atoi(inputVars[v].second[0].c_str());
+					else if(isDouble(inputVars[v].second[0]))
+						vars.layers[layer].bools.at(varId, inputVars[v].first) = (bool)std::strtod(inputVars[v].second[0].c_str(), NULL);
+					else
 					{
-						getline(iss, str);
-						if(0 < fileLineNo++)
-							outStr += "\n" + indentAmount;
-						outStr += str;
-						oldLine = str;
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not an std::bool" << std::endl;
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
+						os_mtx->unlock();
+						return 1;
 					}
-					if(indent)
-						indentAmount += into_whitespace(oldLine);
 				}
-				else if(vars.find(params[p], vpos))
+				else if(varType == "std::int")
 				{
-					result = set_var_from_str(vpos, txt, readPath, lineNo, "read", eos);
+					if(!inputVars[v].second.size())
+						inputVars[v].second.push_back("0");
 
-					if(!result)
+					if(inputVars[v].second.size() != 1)
 					{
-						if(addResult)
-						{
-							outStr += "0";
-							if(indent)
-								indentAmount += " ";
-						}
-						break;
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: std::int definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
+					else if(isInt(inputVars[v].second[0]))
+						vars.layers[layer].ints.at(varId, inputVars[v].first) = std::atoi(inputVars[v].second[0].c_str());
+					else if(isDouble(inputVars[v].second[0]))
+						vars.layers[layer].ints.at(varId, inputVars[v].first) = (int)std::strtod(inputVars[v].second[0].c_str(), NULL);
+					else
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not an std::int" << std::endl;
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
+						os_mtx->unlock();
+						return 1;
 					}
 				}
-				else
+				else if(varType == "std::double")
 				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "read: parameter " << quote(params[p]) << " is not a defined variable" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-
-				result = 1;
-			}
-
-			if(result && addResult)
-			{
-				outStr += std::to_string(result);
-				if(indent)
-					indentAmount += into_whitespace(std::to_string(result));
-			}
-
-			return 0;
-		}
-		else if(funcName == "rmv")
-		{
-			if(params.size() < 1)
-			{
-				if(read_sh_params(params, ' ', linePos, inStr, readPath, lineNo, funcName, eos))
-					return 1;
-			}
-
-			if(params.size() < 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "rmv: expected parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+					if(!inputVars[v].second.size())
+						inputVars[v].second.push_back("0");
 
-			bool changePermissions = 0,
-			     mt = 0, 
-			     prompt = 0,
-			     verbose = 0;
-
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); ++o)
-				{
-					if(options[o] == "f")
-						changePermissions = 1;
-					else if(options[o] == "i")
-						prompt = 1;
-					else if(options[o] == "mt")
-						mt = 1;
-					else if(options[o] == "v")
-						verbose = 1;
+					if(inputVars[v].second.size() != 1)
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: std::double definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
+					else if(isDouble(inputVars[v].second[0]))
+						vars.layers[layer].doubles.at(varId, inputVars[v].first) = std::strtod(inputVars[v].second[0].c_str(), NULL);
+					else
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not an std::double" << std::endl;
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
 				}
-			}
-
-			if(mt)
-			{
-				size_t max_p,
-				       no_thrds = std::atoi(params[0].c_str()),
-				       trans = std::ceil((double)(params.size()-1)/(double)no_thrds);
-				std::vector<std::thread> threads;
-
-				for(size_t min_p = 1; min_p<params.size(); min_p=max_p)
+				else if(varType == "std::char")
 				{
-					max_p = std::min(min_p+trans, params.size());
-					threads.push_back(std::thread(remove_files_thread, params, min_p, max_p));
-				}
+					if(!inputVars[v].second.size())
+						inputVars[v].second.push_back(" ");
 
-				for(size_t i=0; i<threads.size(); ++i)
-					threads[i].join();
-			}
-			else
-			{
-				Path rmPath;
-				std::string rmPathStr;
-				char promptInput = 'n';
-				
-				for(size_t p=0; p<params.size(); ++p)
-				{
-					if(params[p].size() && (params[p][params[p].size()-1] == '/' || params[p][params[p].size()-1] == '\\'))
+					if(inputVars[v].second.size() != 1)
 					{
-						int pos=params[p].size()-2; 
-						while(pos>=0 && (params[p][pos] == '/' || params[p][pos] == '\\'))
-							--pos;
-						params[p] = params[p].substr(0, pos+1);
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: std::char definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
+						os_mtx->unlock();
+						return 1;
 					}
-
-					if(params[p] == "" || params[p] == "/" || params[p] == "*" || params[p] == "~")
+					else if(inputVars[v].second[0].size() == 1)
+						vars.layers[layer].chars.at(varId, inputVars[v].first) = inputVars[v].second[0][0];
+					else
 					{
 						if(!consoleLocked)
 							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) <<  funcName << ": refuse to remove " << quote(params[p]) << std::endl;
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not an std::char" << std::endl;
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
 						os_mtx->unlock();
 						return 1;
 					}
+				}
+				else if(varType == "std::string")
+				{
+					if(!inputVars[v].second.size())
+						inputVars[v].second.push_back("");
 
-					rmPathStr = replace_home_dir(params[p]);
-					rmPath.set_file_path_from(rmPathStr);
-
-					if(!path_exists(rmPathStr))
+					if(inputVars[v].second.size() != 1)
 					{
-						if(rmPathStr.find_first_of('*') != std::string::npos)
-						{
-							std::string parsedTxt, toParse = "@lst{!c, 1, P}(" + rmPathStr + ")";
-							int parseLineNo = 0;
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: std::string definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
+					else
+						vars.layers[layer].strings.at(varId, inputVars[v].first) = inputVars[v].second[0];
+				}
+				else if(varType == "std::llint")
+				{
+					if(!inputVars[v].second.size())
+						inputVars[v].second.push_back("0");
 
-							if(n_read_and_process_fast(indent, toParse, parseLineNo, readPath, antiDepsOfReadPath, parsedTxt, eos))
-							{
+					if(inputVars[v].second.size() != 1)
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: std::llint definition for " << quote(inputVars[v].first) << " should have 1 input variable, got " << inputVars[v].second.size() << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
+					else if(isInt(inputVars[v].second[0]))
+						vars.layers[layer].llints.at(varId, inputVars[v].first) = std::atoll(inputVars[v].second[0].c_str());
+					else if(isDouble(inputVars[v].second[0]))
+						vars.layers[layer].llints.at(varId, inputVars[v].first) = (long long int)std::strtod(inputVars[v].second[0].c_str(), NULL);
+					else
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not an integer" << std::endl;
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[0]) << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
+				}
+				else if(varType == "std::vector<double>")
+				{
+					int noParams = inputVars[v].second.size();
+
+					if(normalVecDef && noParams > 2)
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: std::vector<double> definition for " << quote(inputVars[v].first) << " should have 0-2 input variables, got " << inputVars[v].second.size() << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
+
+					if(normalVecDef)
+					{
+						size_t vSize = 0;
+						double vValue = 0.0;
+
+						if(noParams > 0)
+						{
+							if(!isNonNegInt(inputVars[v].second[0]))
+							{
 								if(!consoleLocked)
 									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) <<  funcName << ": failed to list " << quote(rmPathStr) << std::endl;
+								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: size given for " << quote(inputVars[v].first) << " is not a non-negative integer" << std::endl;
+								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: size given = " << quote(inputVars[v].second[0]) << std::endl;
 								os_mtx->unlock();
 								return 1;
 							}
-
-							std::istringstream iss(parsedTxt);
-							while(getline(iss, rmPathStr))
-								params.push_back(rmPathStr);
-
-							continue;
+							else
+								vSize = std::atoi(inputVars[v].second[0].c_str());
 						}
-						else
+
+						if(noParams == 2)
 						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot remove ";
-							eos << quote(params[p]) << " as path does not exist" << std::endl;
-							os_mtx->unlock();
-							return 1;
+							if(!isDouble(inputVars[v].second[1]))
+							{
+								if(!consoleLocked)
+									os_mtx->lock();
+								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not a double" << std::endl;
+								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[1]) << std::endl;
+								os_mtx->unlock();
+								return 1;
+							}
+							else
+								vValue = std::strtod(inputVars[v].second[1].c_str(), NULL);
 						}
+						vars.layers[layer].doubVecs.at(varId, inputVars[v].first) = std::vector<double>(vSize, vValue);
 					}
 					else
 					{
-						struct stat  oldDirPerms;
-						if(changePermissions)
-						{
-							chmod(rmPathStr.c_str(), 0666);
-							stat(rmPath.dir.c_str(), &oldDirPerms);
-							chmod(rmPath.dir.c_str(), S_IRWXU);
-						}
+						std::vector<double>* v_ptr = &vars.layers[layer].doubVecs.at(varId, inputVars[v].first);
 
-						if((prompt && promptInput != 'a') || verbose)
+						for(int p=0; p<noParams; ++p)
 						{
-							std::cout << "rmv " << quote(params[p]);
-
-							if(prompt && promptInput != 'a')
+							if(isDouble(inputVars[v].second[p]))
+								v_ptr->push_back(std::strtod(inputVars[v].second[p].c_str(), NULL));
+							else
 							{
-								std::cout << "? " << std::flush;
-								promptInput = nsm_getch();
-								if(promptInput == 'Y' || promptInput == '1')
-									promptInput = 'y';
-								else if(promptInput == 'A')
-									promptInput = 'a';
+								if(!consoleLocked)
+									os_mtx->lock();
+								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given for " << quote(inputVars[v].first) << " is not a double" << std::endl;
+								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: value given = " << quote(inputVars[v].second[p]) << std::endl;
+								os_mtx->unlock();
+								return 1;
 							}
-							
-							std::cout << std::endl;
 						}
+					}
+
+					if(addToExpr)
+					{
+						size_t vSize = vars.layers[layer].doubVecs.at(varId, inputVars[v].first).size();
+						if(!vSize)
+							vars.layers[layer].doubVecs.at(varId, inputVars[v].first).push_back(0.0);
+						exprCache.add_vector(inputVars[v].first, vars.layers[layer].doubVecs.at(varId, inputVars[v].first));
+						if(!vSize)
+							vars.layers[layer].doubVecs.at(varId, inputVars[v].first).pop_back();
+					}
+
+					if(addMemberFns)
+					{
+						if(add_fn(inputVars[v].first + ".push_back", 'n',
+						          "@std::vector.push_back{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
+
+						if(add_fn(inputVars[v].first + ".size", 'n',
+						          "@std::vector.size{mf}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
+
+						if(add_fn(inputVars[v].first + ".at", 'n',
+						          "@std::vector.at{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
+
+						if(add_fn(inputVars[v].first + ".set", 'n',
+						          "@std::vector.set{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
+
+						if(add_fn(inputVars[v].first + ".pop_back", 'n',
+						          "@std::vector.pop_back{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
+
+						if(add_fn(inputVars[v].first + ".erase", 'n',
+						          "@std::vector.erase{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
+					}
+				}
+				else if(varType == "std::vector<string>")
+				{
+					int noParams = inputVars[v].second.size();
+
+					if(normalVecDef && noParams > 2)
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: std::vector<string> definition for " << quote(inputVars[v].first) << " should have 0-2 input variables, got " << inputVars[v].second.size() << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
+
+					if(normalVecDef)
+					{
+						size_t vSize = 0;
+						std::string vValue = "";
 
-						if(!prompt || promptInput == 'y' || promptInput == 'a')
+						if(noParams > 0)
 						{
-							if(dir_exists(rmPathStr))
-							{
-								if(!can_write(rmPath.str()) || delDir(rmPathStr, sLineNo, readPath, eos, consoleLocked, os_mtx))
-								{
-									if(!consoleLocked)
-										os_mtx->lock();
-									start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to remove directory ";
-									eos << quote(params[p]) << std::endl;
-									os_mtx->unlock();
-									return 1;
-								}
-							}
-							else if(!can_write(rmPath.str()) || remove_file(rmPath))
+							if(!isNonNegInt(inputVars[v].second[0]))
 							{
 								if(!consoleLocked)
 									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to remove file ";
-								eos << quote(params[p]) << std::endl;
+								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: size given for " << quote(inputVars[v].first) << " is not a non-negative integer" << std::endl;
+								start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: size given = " << quote(inputVars[v].second[0]) << std::endl;
 								os_mtx->unlock();
 								return 1;
 							}
+							else
+								vSize = std::atoi(inputVars[v].second[0].c_str());
 						}
 
-						if(changePermissions)
-							chmod(rmPath.dir.c_str(), oldDirPerms.st_mode);
+						if(noParams == 2)
+							vValue = inputVars[v].second[1];
+						vars.layers[layer].strVecs.at(varId, inputVars[v].first) = std::vector<std::string>(vSize, vValue);
+					}
+					else
+					{
+						std::vector<std::string>* v_ptr = &vars.layers[layer].strVecs.at(varId, inputVars[v].first);
+
+						for(int p=0; p<noParams; ++p)
+							v_ptr->push_back(inputVars[v].second[p]);
+					}
+
+					if(addMemberFns)
+					{
+						if(add_fn(inputVars[v].first + ".push_back", 'n',
+						          "@std::vector.push_back{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
+
+						if(add_fn(inputVars[v].first + ".size", 'n',
+						          "@std::vector.size{mf}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
+
+						if(add_fn(inputVars[v].first + ".at", 'n',
+						          "@std::vector.at{mf, !s@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
+
+						if(add_fn(inputVars[v].first + ".set", 'n',
+						          "@std::vector.set{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
+
+						if(add_fn(inputVars[v].first + ".pop_back", 'n',
+						          "@std::vector.pop_back{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
+
+						if(add_fn(inputVars[v].first + ".erase", 'n',
+						          "@std::vector.erase{mf@vjoin{<-}(options, ', ')}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")",
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/,
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
 					}
 				}
+				else if(varType == "fstream")
+				{
+					if(inputVars[v].second.size() > 1)
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: fstream definition for " << quote(inputVars[v].first) << " should have 0-1 input variables, got " << inputVars[v].second.size() << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
+					else if(!inputVars[v].second.size())
+						vars.layers[layer].fstreams[inputVars[v].first] = std::fstream();
+					else
+					{
+						vars.layers[layer].fstreams[inputVars[v].first].open(inputVars[v].second[0]);
 
-				if(linePos < inStr.size() && inStr[linePos] == '!')
-					++linePos;
-				else
-					skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
-			}
+						if(!vars.layers[layer].fstreams[inputVars[v].first].is_open())
+						{
+							if(!consoleLocked)
+								os_mtx->lock();
+							start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: failed to open path for " << quote(inputVars[v].first) << std::endl;
+							start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: path given = " << quote(inputVars[v].second[0]) << std::endl;
+							os_mtx->unlock();
+							return 1;
+						}
+					}
 
-			return 0;
-		}
-		else if(funcName == "return")
-		{
-			if(params.size() < 1)
-			{
-				if(read_sh_params(params, ' ', linePos, inStr, readPath, lineNo, funcName, eos))
-					return 1;
-			}
+					if(addMemberFns)
+					{
+						if(add_fn(inputVars[v].first + ".close", 'n', 
+						          "@stream.close{mf}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")", 
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/, 
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
 
-			if(params.size() > 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "return: expected 0-1 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+						if(add_fn(inputVars[v].first + ".open", 'n', 
+						          "@stream.open{mf}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")", 
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/, 
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
+					}
+				}
+				else if(varType == "ifstream")
+				{
+					if(inputVars[v].second.size() > 1)
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: ifstream definition for " << quote(inputVars[v].first) << " should have 0-1 input variables, got " << inputVars[v].second.size() << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
+					else if(!inputVars[v].second.size())
+						vars.layers[layer].ifstreams[inputVars[v].first] = std::ifstream();
+					else if(file_exists(inputVars[v].second[0]))
+					{
+						vars.layers[layer].ifstreams[inputVars[v].first].open(inputVars[v].second[0]);
 
-			if(params.size() == 1)
-			{
-				outStr = params[0];
-				if(indent)
-					indentAmount = into_whitespace(params[0]);
-			}
+						if(!vars.layers[layer].ifstreams[inputVars[v].first].is_open())
+						{
+							if(!consoleLocked)
+								os_mtx->lock();
+							start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: failed to open input path for " << quote(inputVars[v].first) << std::endl;
+							start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: path given = " << quote(inputVars[v].second[0]) << std::endl;
+							os_mtx->unlock();
+							return 1;
+						}
+					}
+					else
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: path given for " << quote(inputVars[v].first) << " is not an existing file" << std::endl;
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: path given = " << quote(inputVars[v].second[0]) << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
 
-			return NSM_RET;
-		}
-		else if(funcName == "replace_all")
-		{
-			if(params.size() != 3)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "replace_all: expected 3 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+					if(addMemberFns)
+					{
+						if(add_fn(inputVars[v].first + ".close", 'n', 
+						          "@stream.close{mf}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")", 
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/, 
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
 
-			std::string str;
+						if(add_fn(inputVars[v].first + ".open", 'n', 
+						          "@stream.open{mf}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")", 
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/, 
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
+					}
+				}
+				else if(varType == "ofstream")
+				{
+					if(inputVars[v].second.size() > 1)
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: ofstream definition for " << quote(inputVars[v].first) << " should have 0-1 input variables, got " << inputVars[v].second.size() << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
+					else if(!inputVars[v].second.size())
+						vars.layers[layer].ofstreams[inputVars[v].first] = std::ofstream();
+					else
+					{
+						vars.layers[layer].ofstreams[inputVars[v].first].open(inputVars[v].second[0]);
 
-			//if(replaceVars && replace_var(params[0], readPath, sLineNo, "replace_all", eos))
-			  //  return 1;
+						if(!vars.layers[layer].ofstreams[inputVars[v].first].is_open())
+						{
+							if(!consoleLocked)
+								os_mtx->lock();
+							start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: failed to open output path for " << quote(inputVars[v].first) << std::endl;
+							start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: path given = " << quote(inputVars[v].second[0]) << std::endl;
+							os_mtx->unlock();
+							return 1;
+						}
+					}
 
-			if(params[0] == "ofile")
-				parsedText = findAndReplaceAll(parsedText, params[1], params[2]);
-			else
-			{
-				params[0] = findAndReplaceAll(params[0], params[1], params[2]);
+					if(addMemberFns)
+					{
+						if(add_fn(inputVars[v].first + ".close", 'n', 
+						          "@stream.close{mf}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")", 
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/, 
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
 
-				outStr += params[0];
-				if(indent)
-					indentAmount += into_whitespace(params[0]);
+						if(add_fn(inputVars[v].first + ".open", 'n', 
+						          "@stream.open{mf}(" + inputVars[v].first + "@vjoin{<-}(params, ', ')" + ")", 
+						          "function", layer, 1 /*isConst*/, privates, 1 /*?isUnscoped?*/, 1 /*addOut*/, 
+						          vars.layers[layer].inScopes[inputVars[v].first], readPath, sLineNo, ":=(" + varType + ")", eos))
+							return 1;
+					}
+				}
 			}
-
-			return 0;
 		}
-		#if defined _WIN32 || defined _WIN64
-			else if(funcName == "rm")
-				funcName = "del";
-		#endif
-		else if(funcName == "refresh_completions")
+	}
+	else if(valid_type(varType, readPath, antiDepsOfReadPath, lineNo, ":=(" + varType + ")", sLineNo, eos))
+	{
+		std::vector<std::string> types;
+		std::string preType, typesStr;
+		size_t pos = varType.find_first_of('<');
+		if(pos < varType.size())
 		{
-			if(params.size() != 0)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "refresh_completions: expected 0 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+			preType = varType.substr(0, pos);
+			typesStr = varType.substr(pos, varType.size()-pos);
 
-			return refresh_completions();
+			pos = 0;
+			if(read_params(types, pos, typesStr, readPath, lineNo, ":=(" + varType + ")", eos))
+				return 1;
 		}
-		else if(funcName == "replace_vars")
+		else
+			preType = varType;
+
+		for(size_t v=0; v<inputVars.size(); v++)
 		{
-			if(params.size() > 1)
+			//checks whether variable exists at current scope
+			if(inputVars[v].first == "")
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 0-1 parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: cannot have variable named " << quote(inputVars[v].first) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
-
-			if(params.size())
-			{
-				if(isInt(params[0]))
-					replaceVarsGlobal = std::atoi(params[0].c_str());
-				else if(isDouble(params[0]))
-					replaceVarsGlobal = std::strtod(params[0].c_str(), NULL);
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot convert " << quote(params[0]) << " to bool" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
-			else
-			{
-				std::string output = std::to_string(replaceVarsGlobal);
-				outStr += output;
-				if(indent)
-					indentAmount += into_whitespace(output);
-			}
-
-			return 0;
-		}
-	}
-	else if(funcName[0] == 'b')
-	{
-		if(funcName == "break")
-		{
-			if(params.size())
+			else if(vars.layers[layer].typeOf.count(inputVars[v].first))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "break: expected 0 parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: redeclaration of variable/function name " << quote(inputVars[v].first) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
-
-			return NSM_BREAK;
-		}
-		else if(funcName.substr(0, 5) == "blank")
-		{
-			return 0;
-		}
-	}
-	else if(funcName[0] == 'f')
-	{
-		if(funcName == "f++")
-		{
-			if(params.size() > 1)
+			else if(vars.typeDefs.count(inputVars[v].first))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "f++: expected 0-1 parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: cannot have type and variable named " << quote(inputVars[v].first) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
-
-			int bLineNo = lineNo;
-			bool addOut = addOutput;
-
-			if(options.size())
+			else
 			{
-				for(size_t o=0; o<options.size(); o++)
+				/*if(preType == "array")
 				{
-					if(options[o] == "o")
-						addOut = 1;
-					else if(options[o] == "!o")
-						addOut = 0;
+					std::cout << "arrayay" << std::endl;
 				}
-			}
-
-			if(params.size())
-			{
-				if(!file_exists(params[0]))
+				else if(preType == "map")
 				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "f++: file " << params[0] << " does not exist" << std::endl;
-					os_mtx->unlock();
-					return 1;
+					std::cout << "mapyay" << std::endl;
 				}
+				else if(preType == "vector")
+				{
+					std::cout << "vecyay" << std::endl;
+				}
+				else */if(vars.typeDefs.count(preType))
+				{
+					/*std::vector<bool> typToDel, optToDel, parToDel;
+					std::vector<bool> typWasConst, optWasConst, parWasConst;
+					std::vector<std::string> oldTypTypes, oldOptTypes, oldParTypes;
+					int old_no_types = 0, old_no_options = 0, old_no_params = 0;
+					std::vector<std::string> oldTyps, oldOpts, oldPars;*/
 
-				params[0] = string_from_file(params[0]);
-			}
-			else
-			{
-				params.push_back("");
-				if(read_block(params[0], linePos, inStr, readPath, lineNo, bLineNo, "f++{block}", eos))
-					return 1;
-			}
-
-			std::string resultStr;
-			int result = f_read_and_process_fast(addOut, params[0], bLineNo-1, readPath, antiDepsOfReadPath, resultStr, eos);
-
-			if(result)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed here" << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
-			if(addOut)
-			{
-				std::string resultStr = std::to_string(result);
-				outStr += resultStr;
-				if(indent)
-					indentAmount += into_whitespace(resultStr);
-			}
-
-
-			return result;
-		}
-		else if(funcName == "for")
-		{
-			if(params.size() != 3 && params.size() != 4)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "for: expected 3-4 parameters separated by ';', got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
-			bool first = 1, addNewLines = 1, addIndent = 1, addScope = addScopeGlobal, addOut = addOutput;
-			char fLang = lang;
-			std::string block, parsedCondition, eob = "\n", wBaseIndentAmount = indentAmount;
-			int bLineNo = lineNo;
-
-			std::string forStr;
+					std::vector<std::string> oldOpts, oldPars, oldTypes;
+					std::string oldOptType, oldParType, oldTypesType;
+					bool optWasConst = 0, parWasConst = 0, typesWasConst = 0;
+					bool optWasPrivate = 0, parWasPrivate = 0, typesWasPrivate = 0;
 
-			if(params.size() == 3)
-				forStr = "for(" + params[0] + "; " + params[1] + "; " + params[2] + ")";
-			else
-				forStr = "for(" + params[0] + "; " + params[1] + "; " + params[2] + "; " + params[3] + ")";
+					bool varNameToDel = 1, varNameWasConst = 0;
+					std::string oldVarNameType, oldVarName;
 
-			if(read_block(block, linePos, inStr, readPath, lineNo, bLineNo, forStr, eos))
-				return 1;
+					params = inputVars[v].second;
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "!o")
-						addOut = 0;
-					else if(options[o] == "!\n")
-						addNewLines = 0;
-					else if(options[o] == "\n")
-						eob = "\n\n";
-					else if(options[o].substr(0, 4) == "eob=")
+					//backs up variables already defined at this scope
+					if(vars.layers[0].typeOf.count("options"))
 					{
-						eob = unquote(options[o].substr(4, options[o].size()-4));
-						if(eob[eob.size()-1] != '\n')
-							addIndent = 0;
-					}
-					else if(options[o] == "s")
-						addScope = 1;
-					else if(options[o] == "!s")
-						addScope = 0;
-					else if(options[o] == "n++")
-						fLang = 'n';
-					else if(options[o] == "f++")
-						fLang = 'f';
-				}
-			}
-
-			//adds layer of scope
-			if(addScope)
-			{
-				std::string cScope = vars.layers[vars.layers.size()-1].scope;
-				vars.add_layer(cScope);
-				//vars.add_layer(vars.layers[vars.layers.size()-1].scope); //this is broken on windows!
-			}
+						if(vars.layers[0].constants.count("options"))
+							optWasConst = 1;
+						if(vars.layers[0].privates.count("options"))
+							optWasPrivate = 1;
 
-			bool boolCond = 0, exprtkCond = 0, varCond = 0, result;
-			bool exprtkInc = 0;
-			Expr preExpr, condExpr, incExpr;
-			VPos vpos;
+						oldOptType = vars.layers[0].typeOf["options"];
 
-			//runs pre-for-loop code
-			if(params[0] != "")
-			{
-				//check if it compiles as exprtk script
-				preExpr.register_symbol_table(symbol_table);
-				if(preExpr.compile(params[0]))
-					preExpr.evaluate();
-				else
-				{
-					//parsedCondition = params[0];
+						if(oldOptType == "std::vector<string>")
+						{
+							oldOpts = vars.layers[0].strVecs["options"];
+							vars.layers[0].strVecs["__options"] = oldOpts;
+						}
 
-					//if(parse_replace('f', parsedCondition, "pre-for-loop code", readPath, antiDepsOfReadPath, conditionLineNo, forStr, sLineNo, eos))
-					  //  return 1;
+						vars.layers[0].typeOf.erase("options");
+					}
 
-					if(f_read_and_process_fast(0, params[0], conditionLineNo-1, readPath, antiDepsOfReadPath, parsedCondition, eos))
+					if(vars.layers[0].typeOf.count("params.name"))
 					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) <<  funcName << ": failed to parse pre-loop code" << std::endl;
-						os_mtx->unlock();
-						return 1;
+						varNameToDel = 0;
+						if(vars.layers[0].constants.count("params.name"))
+							varNameWasConst = 1;
+						oldVarNameType = vars.layers[0].typeOf["params.name"];
+						if(oldVarNameType == "string")
+							oldVarName = vars.layers[0].strings["params.name"];
 					}
-				}
-			}
 
-			if(params[1] == "")
-				params[1] = "1";
+					if(vars.layers[0].typeOf.count("params"))
+					{
+						if(vars.layers[0].constants.count("params"))
+							parWasConst = 1;
+						if(vars.layers[0].privates.count("params"))
+							parWasPrivate = 1;
 
-			//determines condition type
-			if(get_bool(result, params[1]))
-				boolCond = 1;
-			else
-			{
-				condExpr.register_symbol_table(symbol_table);
-				if(params[1] != "" && condExpr.compile(params[1]))
-					exprtkCond = 1;
-				else if(replaceVars && vars.find(params[1], vpos))
-					varCond = 1;
-			}
+						oldParType = vars.layers[0].typeOf["params"];
 
-			//determines post-for-block/increment code type
-			bool hasIncrements = 0;
+						if(oldParType == "std::vector<string>")
+						{
+							oldPars = vars.layers[0].strVecs["params"];
+							vars.layers[0].strVecs["__params"] = oldPars;
+						}
 
-			for(size_t i=1; i<params[2].size(); ++i)
-			{
-				if(params[2][i] == '+' && params[2][i-1] == '+')
-				{
-					hasIncrements = 1;
-					break;
-				}
-				else if(params[2][i] == '-' && params[2][i-1] == '-')
-				{
-					hasIncrements = 1;
-					break;
-				}
-			}
-			if(!hasIncrements)
-			{
-				incExpr.register_symbol_table(symbol_table); 
-				if(params[2] != "" && incExpr.compile(params[2]))
-					exprtkInc = 1;
-			}
+						vars.layers[0].typeOf.erase("params");
+					}
 
-			while(1)
-			{
-				if(boolCond)
-				{
-					if(!result)
-						break;
-				}
-				else if(exprtkCond)
-				{
-					if(!condExpr.evaluate())
-						break;
-				}
-				else if(varCond)
-				{
-					if(!vars.get_bool_from_var(vpos, result))
+					if(vars.layers[0].typeOf.count("types"))
 					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot get bool from variable ";
-						eos << quote(vpos.name) << " of type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
+						if(vars.layers[0].constants.count("types"))
+							typesWasConst = 1;
+						if(vars.layers[0].privates.count("types"))
+							typesWasPrivate = 1;
 
-					if(!result)
-						break;
-				}
-				else
-				{
-					parsedCondition = params[1];
+						oldTypesType = vars.layers[0].typeOf["types"];
 
-					if(parse_replace('f', parsedCondition, "for condition", readPath, antiDepsOfReadPath, conditionLineNo, forStr, sLineNo, eos))
-						return 1;
+						if(oldTypesType == "std::vector<string>")
+						{
+							oldTypes = vars.layers[0].strVecs["types"];
+							//vars.layers[0].strVecs["__types"] = oldTypes;
+						}
 
-					if(replaceVars && replace_var(parsedCondition, readPath, conditionLineNo, "for", eos))
-						return 1;
+						vars.layers[0].typeOf.erase("types");
+					}
 
-					if(!get_bool(result, parsedCondition))//, readPath, conditionLineNo, "for", eos))
+					//defines types/params/options
+					if(addMemberFns && !vars.layers[0].functions.count("options.at"))
 					{
-						if(parsedCondition != "" && condExpr.compile(parsedCondition))
-							result = condExpr.evaluate();
-						else
+						std::string toParse = ":={layer=0}(std::vector<string>, options)";
+						std::string trash;
+						if(f_read_and_process_fast(0, toParse, lineNo, readPath, antiDepsOfReadPath, trash, eos) > 0)
 						{
 							if(!consoleLocked)
 								os_mtx->lock();
-							start_err(eos, readPath, conditionLineNo) << funcName << ": cannot convert " << quote(parsedCondition) << " to bool" << std::endl;
-							start_err(eos, readPath, sLineNo) << funcName << ": possible errors from ExprTk:" << std::endl;
-							print_exprtk_parser_errs(eos, condExpr.parser, condExpr.expr_str, readPath, sLineNo);
+							start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to define options vector" << std::endl;
 							os_mtx->unlock();
 							return 1;
 						}
 					}
+					else
+						vars.layers[0].typeOf["options"] = "std::vector<string>";
+					vars.layers[0].strVecs["options"] = options;
+					vars.layers[0].constants.insert("options");
 
-					if(!result)
-						break;
-				}
+					vars.layers[0].typeOf["params.name"] = "string";
+					vars.layers[0].strings["params.name"] = inputVars[v].first;
+					vars.layers[0].constants.insert("params.name");
 
-				if(first)
-					first = 0;
-				else
-				{
-					if(addNewLines && addOut)
+					if(addMemberFns && !vars.layers[0].functions.count("params.at"))
 					{
-						outStr += eob;
-						if(addIndent)
+						std::string toParse = ":={layer=0}(std::vector<string>, params)";
+						std::string trash;
+						if(f_read_and_process_fast(0, toParse, lineNo, readPath, antiDepsOfReadPath, trash, eos) > 0)
 						{
-							indentAmount = wBaseIndentAmount;
-							outStr += indentAmount;
+							if(!consoleLocked)
+								os_mtx->lock();
+							start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to define params vector" << std::endl;
+							os_mtx->unlock();
+							return 1;
 						}
-						else
-							indentAmount += into_whitespace(eob);
 					}
-				}
-
-				if(addScope)
-				{
-					std::string cScope = vars.layers[vars.layers.size()-1].scope;
-					vars.add_layer(cScope);
-					//vars.add_layer(vars.layers[vars.layers.size()-1].scope); //this is broken on windows!
-				}
-
-				int ret_val = 1;
-				if(fLang == 'n')
-					ret_val = n_read_and_process_fast(addOut, addOut, block, bLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
-				else if(fLang == 'f')
-					ret_val = f_read_and_process_fast(addOut, block, bLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
-
-				if(addScope)
-					vars.layers.pop_back();
-
-				if(ret_val == NSM_BREAK)
-					break;
-				else if(ret_val)
-					return ret_val;
-
-				//runs post-for-block code
-				if(exprtkInc)
-					incExpr.evaluate();
-				else
-				{
-					parsedCondition = params[2];
-
-					if(parse_replace(0, 'f', parsedCondition, "post-for-block code", readPath, antiDepsOfReadPath, conditionLineNo, forStr, sLineNo, eos))
-						return 1;
-				}
-			}
-
-			if(params.size() == 4)
-			{
-				//runs post-for-loop code
-				//could check here whether post-for-loop code compiles as an exprtk script
-				parsedCondition = params[3];
-
-				if(parse_replace('f', parsedCondition, "post-for-loop code", readPath, antiDepsOfReadPath, conditionLineNo, forStr, sLineNo, eos))
-					return 1;
-			}
-
-
-			if(addScope)
-				vars.layers.pop_back();
-
-			if(!addOut)
-			{
-				if(linePos < inStr.size() && inStr[linePos] == '!')
-					++linePos;
-				else
-					skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
-			}
-
-			return 0;
-		}
-		else if(funcName == "function" || funcName == "fn")
-		{
-			if(params.size() != 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
-			std::string block;
-			int bLineNo = lineNo;
-			char fnLang = lang;
-			std::string fnType = funcName;
-			bool parseBlock = 0;
-			size_t layer = vars.layers.size()-1;
-			bool addOut, isConst = 1, isPrivate = 0, unscopedFn = 0;
-			std::unordered_set<std::string> inScopes;
-
-			if(lang == 'n')
-				addOut = 1;
-			else
-				addOut = 0;
+					else
+						vars.layers[0].typeOf["params"] = "std::vector<string>";
+					vars.layers[0].strVecs["params"] = params;
+					vars.layers[0].constants.insert("params");
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "lambda")
-						fnType = "lambda";
-					else if(options[o] == "o")
-						addOut = 1;
-					else if(options[o] == "!o")
-						addOut = 0;
-					else if(options[o] == "f++")
-						fnLang = 'f';
-					else if(options[o] == "n++")
-						fnLang = 'n';
-					else if(options[o] == "!const")
-						isConst = 0;
-					else if(options[o] == "private")
-						isPrivate = 1;
-					else if(options[o].substr(0, 7) == "scope+=")
-						inScopes.insert(unquote(options[o].substr(7, options[o].size()-7)));
-					else if(options[o] == "!s")
-						unscopedFn = 1;
-					else if(options[o] == "s")
-						unscopedFn = 0;
-					else if(options[o] == "pb")
-						parseBlock = 1;
-					else if(options[o].substr(0, 6) == "layer=")
+					if(addMemberFns && !vars.layers[0].functions.count("types.at"))
 					{
-						std::string str = unquote(options[o].substr(6, options[o].size()-6));
-
-						if(!isNonNegInt(str))
+						std::string toParse = ":={layer=0}(std::vector<string>, types)";
+						std::string trash;
+						if(f_read_and_process_fast(0, toParse, lineNo, readPath, antiDepsOfReadPath, trash, eos) > 0)
 						{
 							if(!consoleLocked)
 								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": specified layer " << quote(str) << " is not a non-negative integer" << std::endl;
+							start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to define types vector" << std::endl;
 							os_mtx->unlock();
 							return 1;
 						}
-						layer = std::atoi(str.c_str());
-						if(layer >= vars.layers.size())
+					}
+					else
+						vars.layers[0].typeOf["types"] = "std::vector<string>";
+					vars.layers[0].strVecs["types"] = types;
+					vars.layers[0].constants.insert("types");
+
+					//parses typedef function
+					std::string defOutput;
+					if(vars.nTypes.count(preType))
+					{
+						if(n_read_and_process_fast(1, vars.typeDefs[preType], vars.typeDefLineNo[preType]-1, vars.typeDefPath[preType], antiDepsOfReadPath, defOutput, eos) > 0)
 						{
 							if(!consoleLocked)
 								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << funcName<< ": specified layer " << quote(str) << " should be less than the number of layers" << std::endl;
+							start_err_ml(eos, readPath, sLineNo, lineNo) << ":=(" << varType << "): failed here" << std::endl;
 							os_mtx->unlock();
 							return 1;
 						}
 					}
-				}
-			}
-
-			if(read_block(block, linePos, inStr, readPath, lineNo, bLineNo, fnType + "(" + params[0] + ")", eos))
-				return 1;
-
-			if(parseBlock && parse_replace(lang, block, fnType + " block", readPath, antiDepsOfReadPath, bLineNo, fnType, sLineNo, eos))
-				return 1;
-
-			if(add_fn(params[0], fnLang, block, fnType, layer, isConst, isPrivate, unscopedFn, addOut, inScopes, readPath, bLineNo, funcName, eos))
-				return 1;
-
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
-
-			return 0;
-		}
-		else if(funcName == "forget")
-		{
-			if(params.size() == 0)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "forget: expected parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
-			bool rmFromExprTk = 0;
-
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); ++o)
-				{
-					if(options[o] == "exprtk")
-						rmFromExprTk = 1;
-				}
-			}
-
-			VPos vpos;
-			for(size_t p=0; p<params.size(); p++)
-			{
-				if(vars.find(params[p], vpos))
-				{
-					if(vars.layers[vpos.layer].privates.count(params[p]))
+					else 
 					{
-						if(!vars.layers[vpos.layer].inScopes[params[p]].count(vars.layers[vars.layers.size()-1].scope))
+						if(f_read_and_process_fast(0, vars.typeDefs[preType], vars.typeDefLineNo[preType]-1, vars.typeDefPath[preType], antiDepsOfReadPath, defOutput, eos) > 0)
 						{
 							if(!consoleLocked)
 								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << "forget: attempted illegal removal of private variable " << quote(params[p]) << std::endl;
+							start_err_ml(eos, readPath, sLineNo, lineNo) << ":=(" << varType << "): failed here" << std::endl;
 							os_mtx->unlock();
 							return 1;
 						}
 					}
 
-					
-					if(vpos.type == "bool" || vpos.type == "int" || vpos.type == "double")
+					//reverts existing variables otherwise deletes them
+					if(!optWasConst)
+						vars.layers[0].constants.erase("options");
+					if(!optWasPrivate)
+						vars.layers[0].privates.erase("options");
+					if(oldOptType == "std::vector<string>")
+					{
+						vars.layers[0].strVecs["options"] = oldOpts;
+						vars.layers[0].strVecs.erase("__options");
+					}
+					else
 					{
-						vars.layers[vpos.layer].doubles.erase(params[p]);
-						if(rmFromExprTk && symbol_table.symbol_exists(params[p]))
-							symbol_table.remove_variable(params[p]);
+						vars.layers[0].strVecs.erase("options");
+						if(oldOptType == "")
+							vars.layers[0].typeOf.erase("options");
+						else
+							vars.layers[0].typeOf["options"] = oldOptType;
 					}
-					else if(vpos.type == "char" || vpos.type == "string")
+
+					if(!varNameWasConst)
+						vars.layers[0].constants.erase("params.name");
+					if(oldVarNameType == "string")
+						vars.layers[0].strings["params.name"] = oldVarName;
+					else
 					{
-						vars.layers[vpos.layer].strings.erase(params[p]);
-						if(rmFromExprTk && symbol_table.symbol_exists(params[p]))
-							symbol_table.remove_stringvar(params[p]);
+						vars.layers[0].strings.erase("params.name");
+						if(varNameToDel)
+							vars.layers[0].typeOf.erase("params.name");
+						else
+							vars.layers[0].typeOf["params.name"] = oldVarNameType;
 					}
-					else if(vpos.type.substr(0, 5) == "std::")
+
+					if(!parWasConst)
+						vars.layers[0].constants.erase("params");
+					if(!parWasPrivate)
+						vars.layers[0].privates.erase("params");
+					if(oldParType == "std::vector<string>")
 					{
-						if(vpos.type == "std::bool")
-							vars.layers[vpos.layer].bools.erase(params[p]);
-						if(vpos.type == "std::int")
-							vars.layers[vpos.layer].ints.erase(params[p]);
-						if(vpos.type == "std::double")
-							vars.layers[vpos.layer].doubles.erase(params[p]);
-						else if(vpos.type == "std::char")
-							vars.layers[vpos.layer].chars.erase(params[p]);
-						else if(vpos.type == "std::string")
-							vars.layers[vpos.layer].strings.erase(params[p]);
-						else if(vpos.type == "std::llint")
-							vars.layers[vpos.layer].llints.erase(params[p]);
-						else if(vpos.type == "std::vector<double>")
-						{
-							vars.layers[vpos.layer].doubVecs.erase(params[p]);
-							if(rmFromExprTk && symbol_table.symbol_exists(params[p]))
-								symbol_table.remove_vector(params[p]);
-						}
-						else if(vpos.type == "std::vector<string>")
-							vars.layers[vpos.layer].strVecs.erase(params[p]);
+						vars.layers[0].strVecs["params"] = oldPars;
+						vars.layers[0].strVecs.erase("__params");
 					}
-					else if(vpos.type == "fstream")
-						vars.layers[vpos.layer].fstreams.erase(params[p]);
-					else if(vpos.type == "ifstream")
-						vars.layers[vpos.layer].ifstreams.erase(params[p]);
-					else if(vpos.type == "ofstream")
-						vars.layers[vpos.layer].ofstreams.erase(params[p]);
-					else if(vpos.type == "function" || vpos.type == "fn")
+					else
 					{
-						vars.layers[vpos.layer].functions.erase(params[p]);
-						vars.layers[vpos.layer].paths.erase(params[p]);
-						vars.layers[vpos.layer].ints.erase(params[p]);
+						vars.layers[0].strVecs.erase("params");
+						if(oldParType == "")
+							vars.layers[0].typeOf.erase("params");
+						else
+							vars.layers[0].typeOf["params"] = oldParType;
 					}
 
-					vars.layers[vpos.layer].typeOf.erase(params[p]);
-					vars.layers[vpos.layer].inScopes.erase(params[p]);
-					vars.layers[vpos.layer].scopeOf.erase(params[p]);
-					vars.layers[vpos.layer].constants.erase(params[p]);
-					vars.layers[vpos.layer].privates.erase(params[p]);
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "forget: no variable or function named " << params[p] << std::endl;
-					os_mtx->unlock();
-					return 1;
+					if(!typesWasConst)
+						vars.layers[0].constants.erase("types");
+					if(!typesWasPrivate)
+						vars.layers[0].privates.erase("types");
+					if(oldTypesType == "std::vector<string>")
+					{
+						vars.layers[0].strVecs["types"] = oldTypes;
+						//vars.layers[0].strVecs.erase("__types");
+					}
+					else
+					{
+						vars.layers[0].strVecs.erase("types");
+						if(oldTypesType == "")
+							vars.layers[0].typeOf.erase("types");
+						else
+							vars.layers[0].typeOf["types"] = oldTypesType;
+					}
 				}
 			}
-
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
-
-			return 0;
 		}
-		else if(funcName == "faviconinclude")
+	}
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << ":=: do not recognise the type " << quote(varType) << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	//sets whether variables are constants/privates
+	if(constants || privates)// || custScope)
+	{
+		for(size_t v=0; v<inputVars.size(); v++)
 		{
-			if(params.size() != 1)
+			if(constants)
+				vars.layers[layer].constants.insert(inputVars[v].first);
+			if(privates)
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "faviconinclude: expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
+				vars.layers[layer].privates.insert(inputVars[v].first);
+				//vars.layers[layer].scopeOf[inputVars[v].first] = inputVars[v].first.substr(0, inputVars[v].first.find_last_of('.')+1);
+			}
+			/*else if(custScope)
+			{
+				vars.layers[layer].privates.insert(inputVars[v].first);
+				//vars.layers[layer].scopeOf[inputVars[v].first] = scopeOf;
+			}*/
+		}
+
+		if(varType == "fstream" || varType == "ifstream" || varType == "ofstream")
+		{
+			for(size_t v=0; v<inputVars.size(); v++)
+			{
+				if(constants)
+				{
+					vars.layers[layer].constants.insert(inputVars[v].first + ".close");
+					vars.layers[layer].constants.insert(inputVars[v].first + ".open");
+				}
+				else if(privates)
+				{
+					vars.layers[layer].privates.insert(inputVars[v].first + ".close");
+					vars.layers[layer].privates.insert(inputVars[v].first + ".open");
+					//vars.layers[layer].scopeOf[inputVars[v].first + ".close"] = inputVars[v].first.substr(0, inputVars[v].first.find_last_of('.')+1);
+				}
+				/*else if(custScope)
+				{
+					vars.layers[layer].privates.insert(inputVars[v].first + ".close");
+					//vars.layers[layer].scopeOf[inputVars[v].first + ".close"] = scopeOf;
+				}*/
 			}
+		}
+	}
+
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+
+	return 0;
+}
 
-			std::string faviconPathStr = params[0];
-			Path faviconPath;
-			faviconPath.set_file_path_from(faviconPathStr);
+int Parser::builtin_hash(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
 
-			//warns user if favicon file doesn't exist
-			if(!file_exists(faviconPathStr.c_str()))
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); ++o)
+		{
+			if(options[o] == "f")
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_warn(eos, readPath, lineNo) << "faviconinclude: favicon file " << faviconPath << " does not exist" << std::endl;
-				if(!consoleLocked)
+				if(!file_exists(params[0]))
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << "hash: path " << Path(params[0], "") << " does not exist" << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
+				std::shared_ptr<const FileContents> fileContents = fileCache.get(params[0]);
+				if(!fileContents->ok)
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << "hash: failed to read file " << Path(params[0], "") << std::endl;
 					os_mtx->unlock();
+					return 1;
+				}
+				params[0] = fileContents->str;
 			}
+		}
+	}
 
-			Path pathToFavicon(pathBetween(toBuild.outputPath.dir, faviconPath.dir), faviconPath.file);
+	if(params.size() == 1)
+		params.push_back("RS");
+
+	if(params[1] == "RS")
+		params[0] = std::to_string(RSHash(params[0]));
+	else if(params[1]  == "JS")
+		params[0] = std::to_string(JSHash(params[0]));
+	else if(params[1] == "PJW")
+		params[0] = std::to_string(PJWHash(params[0]));
+	else if(params[1] == "ELF")
+		params[0] = std::to_string(ELFHash(params[0]));
+	else if(params[1] == "BKDR")
+		params[0] = std::to_string(BKDRHash(params[0]));
+	else if(params[1] == "SDBM")
+		params[0] = std::to_string(SDBMHash(params[0]));
+	else if(params[1] == "DJB")
+		params[0] = std::to_string(DJBHash(params[0]));
+	else if(params[1] == "DEK")
+		params[0] = std::to_string(DEKHash(params[0]));
+	else if(params[1] == "FNV")
+		params[0] = std::to_string(FNVHash(params[0]));
+	else if(params[1] == "BP")
+		params[0] = std::to_string(BPHash(params[0]));
+	else if(params[1] == "AP")
+		params[0] = std::to_string(APHash(params[0]));
+
+	outStr += params[0];
+	if(indent)
+		indentAmount.add_text(params[0]);
 
-			std::string faviconInclude = "<link rel=\"icon\" type=\"image/png\" href=\"" + pathToFavicon.str() + "\"";
-			if(options.size())
-				for(size_t o=0; o<options.size(); ++o)
-					faviconInclude += " " + options[o];
-			faviconInclude += ">";
+	return 0;
+}
 
-			outStr += faviconInclude;
-			if(indent)
-				indentAmount += into_whitespace(faviconInclude);
+int Parser::builtin_getline(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	VPos spos, vpos;
+	bool fromConsole = 1;
+
+	if(params[0] != "console")
+	{
+		fromConsole = 0;
+		vars.find(params[0], spos);
 
-			return 0;
+		if(spos.type != "fstream" && spos.type != "ifstream" && spos.type != "sstream" && spos.type != "isstream")
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "getline: first parameter " << params[0] << " should be console or an input stream variable" << std::endl;
+			os_mtx->unlock();
+			return 1;
 		}
 	}
-	else if(funcName[0] == 't')
+
+	std::string txt;
+	bool result = 1, addResult = 1;
+
+	if(options.size())
 	{
-		if(funcName == "typeof")
+		for(size_t o=0; o<options.size(); ++o)
 		{
-			if(params.size() != 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "typeof: expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
-			VPos vpos;
+			if(options[o] == "!r")
+				addResult = 0;
+		}
+	}
 
-			if(vars.find(params[0], vpos))
-			{
-				outStr += vars.layers[vpos.layer].typeOf[params[0]];
-				if(indent)
-					indentAmount += into_whitespace(vars.layers[vpos.layer].typeOf[params[0]]);
-			}
+	if(params.size() == 1)
+	{
+		if(fromConsole)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			if(getline(std::cin, txt))
+				result = 1;
 			else
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "typeof: " << params[0] << " is not defined" << std::endl;
+				result = 0;
+			if(!consoleLocked)
 				os_mtx->unlock();
-				return 1;
-			}
+		}
+		else
+			result = getline_from_stream(spos, txt);
 
-			return 0;
+		std::istringstream iss(txt);
+		std::string str, oldLine;
+		int fileLineNo = 0;
+
+		while(!iss.eof())
+		{
+			getline(iss, str);
+			if(0 < fileLineNo++)
+				add_newline(outStr, indentAmount);
+			outStr += str;
+			oldLine = str;
 		}
-		#if defined _WIN32 || defined _WIN64
-		#else
-			else if(funcName == "type")
-				funcName = "cat";
-		#endif
+		if(indent)
+			indentAmount.add_text(oldLine);
 	}
-	else if(funcName[0] == 'e')
+	for(size_t p=1; p<params.size(); p++)
 	{
-		if(funcName == "exprtk.eval")
+		if(fromConsole)
 		{
-			if(params.size() > 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.eval: expected 0-1 parameters, got " << params.size() << std::endl;
+			if(!consoleLocked)
+				os_mtx->lock();
+			if(getline(std::cin, txt))
+				result = 1;
+			else
+				result = 0;
+			if(!consoleLocked)
 				os_mtx->unlock();
-				return 1;
+		}
+		else
+			result = getline_from_stream(spos, txt);
+
+		if(!result)
+		{
+			if(addResult)
+			{
+				outStr += "0";
+				if(indent)
+					indentAmount += ' ';
 			}
+			break;
+		}
 
-			bool addOut = addOutput, round = 1;
 
-			if(options.size())
+		if(params[p] == "ofile")
+		{
+			addResult = 0;
+			std::istringstream iss(txt);
+			std::string str, oldLine;
+			int fileLineNo = 0;
+
+			while(!iss.eof())
 			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "o")
-						addOut = 1;
-					else if(options[o] == "!o")
-						addOut = 0;
-					else if(options[o] == "!round")
-						round = 0;
-				}
+				getline(iss, str);
+				if(0 < fileLineNo++)
+					add_newline(outStr, indentAmount);
+				outStr += str;
+				oldLine = str;
 			}
+			if(indent)
+				indentAmount.add_text(oldLine);
+		}
+		else if(vars.find(params[p], vpos) && vpos.type == "string")
+		{
+			result = set_var_from_str(vpos, txt, readPath, lineNo, "getline", eos);
 
-			double value;
-			if(params.size())
+			if(!result)
 			{
-				if(exprset.expressions.count(params[0]))
-					value = exprset.evaluate(params[0]);
-				else
+				if(addResult)
 				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.eval: no expression named " << quote(params[0]) << " has been compiled" << std::endl;
-					os_mtx->unlock();
-					return 1;
+					outStr += "0";
+					if(indent)
+						indentAmount += ' ';
 				}
+				break;
 			}
-			else
-				value = expr.evaluate();
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "getline: parameter " << params[p] << " is not a defined string variable" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			if(addOut)
-			{
-				std::string valueStr = vars.double_to_string(value, round);
+		result = 1;
+	}
 
-				outStr += valueStr;
-				if(indent)
-					indentAmount += into_whitespace(valueStr);
-			}
+	if(result && addResult)
+	{
+		outStr += std::to_string(result);
+		if(indent)
+			indentAmount.add_text(std::to_string(result));
+	}
 
-			return 0;
-		}
-		else if(funcName == "exprtk")
-		{
-			if(params.size() > 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk: expected 0-1 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	return 0;
+}
 
-			int bLineNo = lineNo;
-			bool blockOpt = 0, fileOpt = 0, parseBlock = 0, addOut = addOutput, round = 1;
-			char blockLang = lang;
+int Parser::builtin_getenv(FnCall& call)
+{
+	const bool& indent = call.indent;
+	std::string& outStr = call.outStr;
+	std::vector<std::string>& params = call.params;
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "f" || options[o] == "file")
-						fileOpt =  1;
-					if(options[o] == "f++")
-						blockLang = 'f';
-					else if(options[o] == "n++")
-						blockLang = 'n';
-					else if(options[o] == "pb")
-						parseBlock = 1;
-					else if(options[o] == "o")
-						addOut = 1;
-					else if(options[o] == "!o")
-						addOut = 0;
-					else if(options[o] == "!round")
-						round = 0;
-				}
-			}
+	params[0] = get_env(params[0].c_str());
 
-			if(params.size() == 0)
-			{
-				blockOpt = 1;
-				params.push_back("");
-				if(read_block(params[0], linePos, inStr, readPath, lineNo, bLineNo, "exprtk{block}", eos))
-					return 1;
+	outStr += params[0];
+	if(indent)
+		indentAmount.add_text(params[0]);
 
-				if(parseBlock && parse_replace(blockLang, params[0], "exprtk block", readPath, antiDepsOfReadPath, bLineNo, "exprtk{block}", sLineNo, eos))
-					return 1;
-			}
-			else if(fileOpt)
-			{
-				params[0] = string_from_file(params[0]);
+	return 0;
+}
 
-				if(!file_exists(params[0]))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk: file " << params[0] << " does not exist" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
+int Parser::builtin_write(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const char& lang = call.lang;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	bool readBlock = 0, parseBlock = 1;
+	char bLang = lang;
+	int bLineNo = lineNo;
+	std::string txt;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "b" || options[o] == "block")
+				readBlock = 1;
+			else if(options[o] == "!pb")
+				parseBlock = 0;
+			else if(options[o] == "f++")
+				bLang = 'f';
+			else if(options[o] == "n++")
+				bLang = 'n';
+		}
+	}
+
+	if(readBlock)
+	{
+		if(read_block(txt, linePos, inStr, readPath, lineNo, bLineNo, "write{block}", eos))
+		   return 1;
+
+		if(parseBlock && parse_replace(bLang, txt, "write block", readPath, antiDepsOfReadPath, lineNo, "write{block}", sLineNo, eos))
+			return 1;
+
+		txt += "\r\n";
+	}
+	else if(params.size() == 1)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "write: expected 2+ parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-			if(!expr.compile(params[0]))
+	VPos vpos;
+	Indent gIndentAmount;
+	for(size_t p=1; p<params.size(); p++)
+	{
+		if(params[p] == "endl")
+			txt += "\r\n";
+		else if(vars.find(params[p], vpos))
+		{
+			gIndentAmount.clear();
+			if(!vars.add_str_from_var(vpos, txt, 1, indent, gIndentAmount))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err(eos, readPath, sLineNo) << c_green << "exprtk" << c_white << ": failed to compile expression" << std::endl;
-				if(blockOpt)
-					print_exprtk_parser_errs(eos, expr.parser, params[0], readPath, bLineNo);
-				else
-					print_exprtk_parser_errs(eos, expr.parser, params[0], readPath, sLineNo);
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "write: cannot get string of var type " << quote(vpos.type) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+		}
+		else
+			txt += params[p];
+	}
 
-			if(addOut)
-			{
-				std::string value = vars.double_to_string(expr.evaluate(), round);
-
-				outStr += value;
-				if(indent)
-					indentAmount += into_whitespace(value);
-			}
-			else
-				expr.evaluate();
+	if(params[0] == "ofile")
+	{
+		std::istringstream iss(txt);
+		std::string str, oldLine;
+		int fileLineNo = 0;
 
-			return 0;
+		while(!iss.eof())
+		{
+			getline(iss, str);
+			if(0 < fileLineNo++)
+				add_newline(outStr, indentAmount);
+			outStr += str;
+			oldLine = str;
 		}
-		else if(funcName == "exprtk.compile")
+		if(indent)
+			indentAmount.add_text(oldLine);
+	}
+	else if(params[0] == "console")
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		if(lolcatActive)
+			rnbwcout(txt);
+		else
+			eos << txt;
+		if(!consoleLocked)
+			os_mtx->unlock();
+	}
+	else
+	{
+		VPos vpos;
+		if(vars.find(params[0], vpos))
 		{
-			if(params.size() > 2)
+			if(vpos.type == "fstream")
+				vars.layers[vpos.layer].fstreams[params[0] ] << txt;
+			else if(vpos.type == "ofstream")
+			{
+				vars.layers[vpos.layer].ofstreams[params[0] ] << txt;
+			}
+			else
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.compile: expected 0-2 parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "write is not defined for parameter " << quote(params[0]) << " of type " << quote(vpos.type) << std::endl;
 				os_mtx->unlock();
 				return 1;
-			}
-
-			int bLineNo = lineNo;
-			bool blockOpt = 0, fileOpt = 0, parseBlock = 0;
-			char blockLang = lang;
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "b" || options[o] == "block")
-						blockOpt = 1;
-					else if(options[o] == "f" || options[o] == "file")
-						fileOpt = 1;
-					else if(options[o] == "f++")
-						blockLang = 'f';
-					else if(options[o] == "n++")
-						blockLang = 'n';
-					else if(options[o] == "pb")
-						parseBlock = 1;
-				}
 			}
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "write: no variable named " << params[0] << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-			if(params.size() == 0)
-				blockOpt = 1;
-			else if(fileOpt)
-			{
-				if(params.size() != 1)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.compile: expected 1 parameter, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-
-				params.push_back(string_from_file(params[0]));
+	return 0;
+}
 
-				if(!file_exists(params[1]))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.compile: file " << params[0] << " does not exist" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
+int Parser::builtin_while(FnCall& call)
+{
+	const char& lang = call.lang;
+	const bool& addOutput = call.addOutput;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	int& conditionLineNo = call.conditionLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	bool first = 1, addNewLines = 1, addIndent = 1, addScope = addScopeGlobal, addOut = addOutput;
+	char wLang = lang;
+	std::string block, parsedCondition, eob = "\n";
+	std::shared_ptr<const SegmentedText> segmentedBlock;
+	Indent wBaseIndentAmount = indentAmount;
+	int bLineNo = lineNo;
 
-			if(blockOpt)
-			{
-				std::string block_str;
-				if(read_block(block_str, linePos, inStr, readPath, lineNo, bLineNo, "exprtk.compile{block}", eos))
-					return 1;
+	if(read_block(block, segmentedBlock, linePos, inStr, call.segmented, readPath, lineNo, bLineNo, "while(" + params[0] + ")", eos))
+		return 1;
 
-				if(parseBlock && parse_replace(blockLang, block_str, "exprtk block", readPath, antiDepsOfReadPath, bLineNo, "exprtk.compile{block}", sLineNo, eos))
-					return 1;
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "!o")
+				addOut = 0;
+			else if(options[o] == "!\n")
+				addNewLines = 0;
+			else if(options[o] == "\n")
+				eob = "\n\n";
+			else if(options[o].substr(0, 4) == "eob=")
+			{
+				eob = unquote(options[o].substr(4, options[o].size()-4));
+				if(eob[eob.size()-1] != '\n')
+					addIndent = 0;
+			}
+			else if(options[o] == "s")
+				addScope = 1;
+			else if(options[o] == "!s")
+				addScope = 0;
+			else if(options[o] == "n++")
+				wLang = 'n';
+			else if(options[o] == "f++")
+				wLang = 'f';
+		}
+	}
 
-				params.push_back(block_str);
-			}
+	bool boolCond = 0, exprtkCond = 0, varCond = 0, result;
+	Expr condExpr;
+	VPos vpos;
 
-			if(params.size() == 1)
-			{
-				if(!expr.compile(params[0]))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err(eos, readPath, sLineNo) << c_green << "exprtk.compile" << c_white << ": failed to compile expression" << std::endl;
-					if(blockOpt)
-						print_exprtk_parser_errs(eos, expr.parser, params[0], readPath, bLineNo);
-					else
-						print_exprtk_parser_errs(eos, expr.parser, params[0], readPath, sLineNo);
-					os_mtx->unlock();
-					return 1;
-				}
-			}
-			else if(!exprset.compile(params[0], params[1]))
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err(eos, readPath, sLineNo) << c_green << "exprtk.compile" << c_white << ": failed to compile expression" << std::endl;
-				if(blockOpt)
-					print_exprtk_parser_errs(eos, exprset.parser, params[1], readPath, bLineNo);
-				else
-					print_exprtk_parser_errs(eos, exprset.parser, params[1], readPath, sLineNo);
-				os_mtx->unlock();
-				return 1;
-			}
+	if(get_bool(result, params[0]))
+		boolCond = 1;
+	else
+	{
+		condExpr.use_cache(exprCache);
+		if(params[0] != "" && condExpr.compile(params[0]))
+			exprtkCond = 1;
+		else if(replaceVars && vars.find(params[0], vpos))
+				varCond = 1;
+	}
 
-			return 0;
+	while(1)
+	{
+		if(boolCond)
+		{
+			if(!result)
+				break;
 		}
-		else if(funcName == "exprtk.eval_params")
+		else if(exprtkCond)
 		{
-			if(params.size() != 1)
+			if(!condExpr.evaluate())
+				break;
+		}
+		else if(varCond)
+		{
+			if(!vars.get_bool_from_var(vpos, result))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.eval_params: expected 1 parameter, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot get bool from variable ";
+				eos << quote(vpos.name) << " of type " << quote(vpos.type) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
 
-			exprtkParams = (std::strtod(params[0].c_str(), NULL));
-
-			return 0;
+			if(!result)
+				break;
 		}
-		else if(funcName == "exprtk.file")
+		else
 		{
-			if(params.size() != 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk: expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
+			parsedCondition = params[0];
+
+			if(parse_replace('f', parsedCondition, "while condition", readPath, antiDepsOfReadPath, conditionLineNo, "while(" + params[0] + ")", sLineNo, eos))
 				return 1;
-			}
 
-			bool addOut = addOutput, round = 1;
+			if(replaceVars && replace_var(parsedCondition, readPath, conditionLineNo, "while", eos))
+				return 1;
 
-			if(options.size())
+			if(!get_bool(result, parsedCondition))
 			{
-				for(size_t o=0; o<options.size(); o++)
+				if(parsedCondition != "" && condExpr.compile(parsedCondition))
+					result = condExpr.evaluate();
+				else
 				{
-					if(options[o] == "o")
-						addOut = 1;
-					else if(options[o] == "!o")
-						addOut = 0;
-					else if(options[o] == "!round")
-						round = 0;
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err(eos, readPath, conditionLineNo) << funcName << ": cannot convert " << quote(parsedCondition) << " to bool" << std::endl;
+					start_err(eos, readPath, sLineNo) << funcName << ": possible errors from exprtk:" << std::endl;
+					print_exprtk_parser_errs(eos, condExpr.errors(), condExpr.expr_str, readPath, sLineNo);
+					os_mtx->unlock();
+					return 1;
 				}
 			}
 
-			if(!file_exists(params[0]))
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk: file " << params[0] << " does not exist" << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-			
-			params[0] = string_from_file(params[0]);
+			if(!result)
+				break;
+		}
 
-			if(!expr.compile(params[0]))
+		if(first)
+			first = 0;
+		else
+		{
+			if(addNewLines && addOut)
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err(eos, readPath, sLineNo) << c_green << "exprtk" << c_white << ": failed to compile expression" << std::endl;
-				print_exprtk_parser_errs(eos, expr.parser, params[0], readPath, sLineNo);
-				os_mtx->unlock();
-				return 1;
+				outStr += eob;
+				if(addIndent)
+				{
+					indentAmount = wBaseIndentAmount;
+					outStr += indentAmount;
+				}
+				else
+					indentAmount.add_text(eob);
 			}
+		}
 
-			if(addOut)
-			{
-				std::string value = vars.double_to_string(expr.evaluate(), round);
+		if(addScope)
+		{
+			std::string cScope = vars.layers[vars.layers.size()-1].scope;
+			vars.add_layer(cScope);
+			//vars.add_layer(vars.layers[vars.layers.size()-1].scope); //this is broken on windows!
+		}
 
-				outStr += value;
-				if(indent)
-					indentAmount += into_whitespace(value);
-			}
-			else
-				expr.evaluate();
+		int ret_val = 1;
+		if(wLang == 'n' && segmentedBlock)
+			ret_val = n_read_and_process_fast(addOut, addOut, segmentedBlock->text, segmentedBlock.get(), bLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
+		else if(wLang == 'n')
+			ret_val = n_read_and_process_fast(addOut, addOut, block, bLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
+		else if(wLang == 'f')
+			ret_val = f_read_and_process_fast(addOut, block, bLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
 
-			return 0;
+		if(addScope)
+			vars.layers.pop_back();
+
+		if(ret_val == NSM_BREAK)
+			break;
+		else if(ret_val)
+			return ret_val;
+	}
+
+	if(!addOut)
+	{
+		if(linePos < inStr.size() && inStr[linePos] == '!')
+			++linePos;
+		else
+			skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+	}
+
+	return 0;
+}
+
+int Parser::builtin_warning(FnCall& call)
+{
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	std::vector<std::string>& params = call.params;
+
+	if(!consoleLocked)
+		os_mtx->lock();
+	start_warn(eos, readPath, lineNo) << params[0] << std::endl;
+	if(!consoleLocked)
+		os_mtx->unlock();
+
+	return 0;
+}
+
+int Parser::builtin_read(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	VPos spos, vpos;
+	bool fromConsole = 1;
+
+	if(params[0] != "console")
+	{
+		fromConsole = 0;
+		vars.find(params[0], spos);
+
+		if(spos.type != "fstream" && spos.type != "ifstream" && spos.type != "sstream" && spos.type != "isstream")
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "read: first parameter " << params[0] << " should be console or an input stream variable" << std::endl;
+			os_mtx->unlock();
+			return 1;
 		}
-		else if(funcName == "exprtk.load")
+	}
+
+	std::string txt;
+	bool result = 1, addResult = 1;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); ++o)
 		{
-			if(params.size() != 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.load: expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+			if(options[o] == "!r")
+				addResult = 0;
+		}
+	}
 
-			if(exprset.expressions.count(params[0]))
-			{
-				expr.expr_str = exprset.expr_strs[params[0] ];
-				expr.expression = exprset.expressions[params[0] ];
-			}
-			else
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.load: no expression named " << quote(params[0]) << " has been compiled" << std::endl;
+	if(params.size() == 1)
+	{
+		if(fromConsole)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			std::cin >> txt;
+			if(!consoleLocked)
 				os_mtx->unlock();
-				return 1;
-			}
+		}
+		else
+			result = read_str_from_stream(spos, txt);
 
-			return 0;
+		std::istringstream iss(txt);
+		std::string str, oldLine;
+		int fileLineNo = 0;
+
+		while(!iss.eof())
+		{
+			getline(iss, str);
+			if(0 < fileLineNo++)
+				add_newline(outStr, indentAmount);
+			outStr += str;
+			oldLine = str;
 		}
-		else if(funcName == "exprtk.str")
+		if(indent)
+			indentAmount.add_text(oldLine);
+	}
+	for(size_t p=1; p<params.size(); p++)
+	{
+		if(fromConsole)
 		{
-			if(params.size() > 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.str: expected 0-1 parameters, got " << params.size() << std::endl;
+			if(!consoleLocked)
+				os_mtx->lock();
+			std::cin >> txt;
+			if(!consoleLocked)
 				os_mtx->unlock();
-				return 1;
-			}
+		}
+		else
+			result = read_str_from_stream(spos, txt);
 
-			if(params.size())
-			{
-				if(exprset.expressions.count(params[0]))
-				{
-					std::string expr_str = exprset.expr_strs[params[0] ];
-					outStr += expr_str;
-					if(indent)
-						indentAmount += into_whitespace(expr_str);
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.str: no expression named " << quote(params[0]) << " has been compiled" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
-			else
+		if(!result)
+		{
+			if(addResult)
 			{
-				outStr += expr.expr_str;
+				outStr += "0";
 				if(indent)
-					indentAmount += into_whitespace(expr.expr_str);
+					indentAmount += ' ';
 			}
-
-			return 0;
+			break;
 		}
-		else if(funcName == "exprtk.add_variable")
-		{
-			if(params.size() == 0)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.add_variable: expected parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
 
-			VPos vpos;
 
-			for(size_t p=0; p<params.size(); ++p)
+		if(params[p] == "ofile")
+		{
+			addResult = 0;
+			std::istringstream iss(txt);
+			std::string str, oldLine;
+			int fileLineNo = 0;
+
+			while(!iss.eof())
 			{
-				if(vars.find(params[p], vpos))
-				{
-					if(vpos.type == "bool" || vpos.type == "int" || vpos.type == "double" || vpos.type == "std::double")
-						symbol_table.add_variable(params[p], vars.layers[vpos.layer].doubles[params[p]]);
-					else if(vpos.type == "char" || vpos.type == "string" || vpos.type == "std::string")
-						symbol_table.add_stringvar(params[p], vars.layers[vpos.layer].strings[params[p]]);
-					else if(vpos.type == "std::vector<double>")
-						symbol_table.add_vector(params[p], vars.layers[vpos.layer].doubVecs[params[p]]);
-					else
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.add_variable: cannot add variable " << quote(params[p]) << " of type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.add_variable: no variables named " << quote(params[p]) << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+				getline(iss, str);
+				if(0 < fileLineNo++)
+					add_newline(outStr, indentAmount);
+				outStr += str;
+				oldLine = str;
 			}
-
-			return 0;
+			if(indent)
+				indentAmount.add_text(oldLine);
 		}
-		else if(funcName == "exprtk.add_package")
+		else if(vars.find(params[p], vpos))
 		{
-			if(params.size() == 0)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.add_package: expected parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+			result = set_var_from_str(vpos, txt, readPath, lineNo, "read", eos);
 
-			for(size_t p=0; p<params.size(); ++p)
+			if(!result)
 			{
-				if(params[p] == "basicio_package")
-					symbol_table.add_package(basicio_package);
-				else if(params[p] == "fileio_package")
-					symbol_table.add_package(fileio_package);
-				else if(params[p] == "vectorops_package")
-					symbol_table.add_package(vectorops_package);
-				else
+				if(addResult)
 				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.add_package: do not recognise package " << quote(params[p]) << std::endl;
-					os_mtx->unlock();
-					return 1;
+					outStr += "0";
+					if(indent)
+						indentAmount += ' ';
 				}
+				break;
 			}
-
-			return 0;
 		}
-		else if(funcName == "ent")
+		else
 		{
-			if(params.size() != 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "ent: expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
-			std::string ent = params[0];
-
-			if(ent.size() == 1)
-			{
-				/*
-					see http://dev.w3.org/html5/html-author/charref for
-					more character references than you could ever need!
-				*/
-				switch(ent[0])
-				{
-					case '`':
-						outStr += "&grave;";
-						if(indent)
-							indentAmount += std::string(7, ' ');
-						break;
-					case '~':
-						outStr += "&tilde;";
-						if(indent)
-							indentAmount += std::string(7, ' ');
-						break;
-					case '!':
-						outStr += "&excl;";
-						if(indent)
-							indentAmount += std::string(6, ' ');
-						break;
-					case '@':
-						outStr += "&commat;";
-						if(indent)
-							indentAmount += std::string(8, ' ');
-						break;
-					case '#':
-						outStr += "&num;";
-						if(indent)
-							indentAmount += std::string(5, ' ');
-						break;
-					case '$': //MUST HAVE MATHJAX HANDLE THIS WHEN \$
-						outStr += "&dollar;";
-						if(indent)
-							indentAmount += std::string(8, ' ');
-						break;
-					case '%':
-						outStr += "&percnt;";
-						if(indent)
-							indentAmount += std::string(8, ' ');
-						break;
-					case '^':
-						outStr += "&Hat;";
-						if(indent)
-							indentAmount += std::string(5, ' ');
-						break;
-					case '&':
-						outStr += "&amp;";
-						if(indent)
-							indentAmount += std::string(5, ' ');
-						break;
-					case '*':
-						outStr += "&ast;";
-						if(indent)
-							indentAmount += std::string(5, ' ');
-						break;
-					case '?':
-						outStr += "&quest;";
-						if(indent)
-							indentAmount += std::string(7, ' ');
-						break;
-					case '<':
-						outStr += "&lt;";
-						if(indent)
-							indentAmount += std::string(4, ' ');
-						break;
-					case '>':
-						outStr += "&gt;";
-						if(indent)
-							indentAmount += std::string(4, ' ');
-						break;
-					case '(':
-						outStr += "&lpar;";
-						if(indent)
-							indentAmount += std::string(6, ' ');
-						break;
-					case ')':
-						outStr += "&rpar;";
-						if(indent)
-							indentAmount += std::string(6, ' ');
-						break;
-					case '[':
-						outStr += "&lbrack;";
-						if(indent)
-							indentAmount += std::string(8, ' ');
-						break;
-					case ']':
-						outStr += "&rbrack;";
-						if(indent)
-							indentAmount += std::string(8, ' ');
-						break;
-					case '{':
-						outStr += "&lbrace;";
-						if(indent)
-							indentAmount += std::string(8, ' ');
-						break;
-					case '}':
-						outStr += "&rbrace;";
-						if(indent)
-							indentAmount += std::string(8, ' ');
-						break;
-					case '-':
-						outStr += "&minus;";
-						if(indent)
-							indentAmount += std::string(7, ' ');
-						break;
-					case '_':
-						outStr += "&lowbar;";
-						if(indent)
-							indentAmount += std::string(8, ' ');
-						break;
-					case '=':
-						outStr += "&equals;";
-						if(indent)
-							indentAmount += std::string(8, ' ');
-						break;
-					case '+':
-						outStr += "&plus;";
-						if(indent)
-							indentAmount += std::string(6, ' ');
-						break;
-					case '|':
-						outStr += "&vert;";
-						if(indent)
-							indentAmount += std::string(6, ' ');
-						break;
-					case '\\':
-						outStr += "&bsol;";
-						if(indent)
-							indentAmount += std::string(6, ' ');
-						break;
-					case '/':
-						outStr += "&sol;";
-						if(indent)
-							indentAmount += std::string(5, ' ');
-						break;
-					case ';':
-						outStr += "&semi;";
-						if(indent)
-							indentAmount += std::string(6, ' ');
-						break;
-					case ':':
-						outStr += "&colon;";
-						if(indent)
-							indentAmount += std::string(7, ' ');
-						break;
-					case '\'':
-						outStr += "&apos;";
-						if(indent)
-							indentAmount += std::string(6, ' ');
-						break;
-					case '"':
-						outStr += "&quot;";
-						if(indent)
-							indentAmount += std::string(6, ' ');
-						break;
-					case ',':
-						outStr += "&comma;";
-						if(indent)
-							indentAmount += std::string(7, ' ');
-						break;
-					case '.':
-						outStr += "&period;";
-						if(indent)
-							indentAmount += std::string(8, ' ');
-						break;
-					default:
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "ent: do not currently have an entity value for " << quote(ent) << std::endl;
-						os_mtx->unlock();
-						return 1;
-				}
-			}
-			else if(ent == "£")
-			{
-				outStr += "&pound;";
-				if(indent)
-					indentAmount += std::string(7, ' ');
-			}
-			else if(ent == "¥")
-			{
-				outStr += "&yen;";
-				if(indent)
-					indentAmount += std::string(5, ' ');
-			}
-			else if(ent == "€")
-			{
-				outStr += "&euro;";
-				if(indent)
-					indentAmount += std::string(6, ' ');
-			}
-			else if(ent == "§" || ent == "section")
-			{
-				outStr += "&sect;";
-				if(indent)
-					indentAmount += std::string(6, ' ');
-			}
-			else if(ent == "+-")
-			{
-				outStr += "&pm;";
-				if(indent)
-					indentAmount += std::string(4, ' ');
-			}
-			else if(ent == "-+")
-			{
-				outStr += "&mp;";
-				if(indent)
-					indentAmount += std::string(4, ' ');
-			}
-			else if(ent == "!=")
-			{
-				outStr += "&ne;";
-				if(indent)
-					indentAmount += std::string(4, ' ');
-			}
-			else if(ent == "<=")
-			{
-				outStr += "&leq;";
-				if(indent)
-					indentAmount += std::string(5, ' ');
-			}
-			else if(ent == ">=")
-			{
-				outStr += "&geq;";
-				if(indent)
-					indentAmount += std::string(5, ' ');
-			}
-			else if(ent == "->")
-			{
-				outStr += "&rarr;";
-				if(indent)
-					indentAmount += std::string(6, ' ');
-			}
-			else if(ent == "<-")
-			{
-				outStr += "&larr;";
-				if(indent)
-					indentAmount += std::string(6, ' ');
-			}
-			else if(ent == "<->")
-			{
-				outStr += "&harr;";
-				if(indent)
-					indentAmount += std::string(6, ' ');
-			}
-			else if(ent == "==>")
-			{
-				outStr += "&rArr;";
-				if(indent)
-					indentAmount += std::string(6, ' ');
-			}
-			else if(ent == "<==")
-			{
-				outStr += "&lArr;";
-				if(indent)
-					indentAmount += std::string(6, ' ');
-			}
-			else if(ent == "<==>")
-			{
-				outStr += "&hArr;";
-				if(indent)
-					indentAmount += std::string(6, ' ');
-			}
-			else if(ent == "<=!=>")
-			{
-				outStr += "&nhArr;";
-				if(indent)
-					indentAmount += std::string(7, ' ');
-			}
-			else if(ent == "...")
-			{
-				outStr += "&hellip;";
-				if(indent)
-					indentAmount += std::string(8, ' ');
-			}
-			else
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "ent: do not currently have an entity value for " << quote(ent) << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
-			return 0;
-		}
-		else if(funcName == "error")
-		{
-			if(params.size() == 0)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "error: expected parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
 			if(!consoleLocked)
 				os_mtx->lock();
-			start_err_ml(eos, readPath, sLineNo, lineNo) << params[0];
-			for(size_t p=1; p<params.size(); ++p)
-				eos << params[p];
-			eos << std::endl;
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "read: parameter " << quote(params[p]) << " is not a defined variable" << std::endl;
 			os_mtx->unlock();
+			return 1;
+		}
+
+		result = 1;
+	}
+
+	if(result && addResult)
+	{
+		outStr += std::to_string(result);
+		if(indent)
+			indentAmount.add_text(std::to_string(result));
+	}
+
+	return 0;
+}
 
+int Parser::builtin_rmv(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size() < 1)
+	{
+		if(read_sh_params(params, ' ', linePos, inStr, readPath, lineNo, funcName, eos))
 			return 1;
+	}
+
+	if(params.size() < 1)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "rmv: expected parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	bool changePermissions = 0,
+	     mt = 0, 
+	     prompt = 0,
+	     verbose = 0;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); ++o)
+		{
+			if(options[o] == "f")
+				changePermissions = 1;
+			else if(options[o] == "i")
+				prompt = 1;
+			else if(options[o] == "mt")
+				mt = 1;
+			else if(options[o] == "v")
+				verbose = 1;
 		}
-		else if(funcName == "exit")
-		{
-			if(params.size() != 0)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "exit: expected 0 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	}
+
+	if(mt)
+	{
+		size_t max_p,
+		       no_thrds = std::atoi(params[0].c_str()),
+		       trans = std::ceil((double)(params.size()-1)/(double)no_thrds);
+		std::vector<std::thread> threads;
 
-			return NSM_EXIT; //check this??
+		for(size_t min_p = 1; min_p<params.size(); min_p=max_p)
+		{
+			max_p = std::min(min_p+trans, params.size());
+			threads.push_back(std::thread(remove_files_thread, params, min_p, max_p));
 		}
+
+		for(size_t i=0; i<threads.size(); ++i)
+			threads[i].join();
 	}
-	else if(funcName[0] == 'd')
+	else
 	{
-		if(funcName == "dep")
+		Path rmPath;
+		std::string rmPathStr;
+		char promptInput = 'n';
+		
+		for(size_t p=0; p<params.size(); ++p)
 		{
-			if(params.size() == 0)
+			if(params[p].size() && (params[p][params[p].size()-1] == '/' || params[p][params[p].size()-1] == '\\'))
+			{
+				int pos=params[p].size()-2; 
+				while(pos>=0 && (params[p][pos] == '/' || params[p][pos] == '\\'))
+					--pos;
+				params[p] = params[p].substr(0, pos+1);
+			}
+
+			if(params[p] == "" || params[p] == "/" || params[p] == "*" || params[p] == "~")
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "dep: expected parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) <<  funcName << ": refuse to remove " << quote(params[p]) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
 
-			std::string depPathStr;
-			Path depPath;
+			rmPathStr = replace_home_dir(params[p]);
+			rmPath.set_file_path_from(rmPathStr);
 
-			for(size_t p=0; p<params.size(); ++p)
+			if(!path_exists(rmPathStr))
 			{
-				depPathStr = params[p];
-				depPath.set_file_path_from(depPathStr);
-
-				if(incrMode != INCR_MOD)
+				if(rmPathStr.find_first_of('*') != std::string::npos)
 				{
-					checked_hash_mtx.lock();
-					if(!checkedHashFile.count(depPath))
+					std::string parsedTxt, toParse = "@lst{!c, 1, P}(" + rmPathStr + ")";
+					int parseLineNo = 0;
+
+					if(n_read_and_process_fast(indent, toParse, parseLineNo, readPath, antiDepsOfReadPath, parsedTxt, eos))
 					{
-						checkedHashFile.insert(depPath);
-						checked_hash_mtx.unlock();
-						Path hashPath = depPath.getHashPath();
-						std::string hashPathStr = hashPath.str();
-						unsigned int hash = FNVHash(string_from_file(depPathStr));
-						if(!file_exists(hashPathStr) || 
-						   (unsigned) std::atoi(string_from_file(hashPathStr).c_str()) != hash)
-						{
-							hashPath.ensureDirExists();
-							std::ofstream ofs(hashPathStr);
-							ofs << hash << "\n";
-							ofs.close();
-						}
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) <<  funcName << ": failed to list " << quote(rmPathStr) << std::endl;
+						os_mtx->unlock();
+						return 1;
 					}
-					else
-						checked_hash_mtx.unlock();
-				}
-				depFiles.insert(depPath);
 
-				if(depPath == toBuild.contentPath)
-					contentAdded = 1;
+					std::istringstream iss(parsedTxt);
+					while(getline(iss, rmPathStr))
+						params.push_back(rmPathStr);
 
-				if(!path_exists(depPathStr))
+					continue;
+				}
+				else
 				{
 					if(!consoleLocked)
 						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "dep(" << quote(depPathStr) << ") failed as dependency does not exist" << std::endl;
+					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot remove ";
+					eos << quote(params[p]) << " as path does not exist" << std::endl;
 					os_mtx->unlock();
 					return 1;
 				}
 			}
-
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
 			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
-
-			return 0;
-		}
-		else if(funcName == "do-while")
-		{
-			if(params.size() != 1)
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "do-while: expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
-			bool first = 1, addNewLines = 1, addIndent = 1, addScope = addScopeGlobal, addOut = addOutput;
-			char dwLang = lang;
-			std::string block, parsedCondition, eob = "\n", wBaseIndentAmount = indentAmount;
-			int bLineNo = lineNo;
-
-			if(read_block(block, linePos, inStr, readPath, lineNo, bLineNo, "do-while(" + params[0] + ")", eos))
-				return 1;
+				struct stat  oldDirPerms;
+				if(changePermissions)
+				{
+					chmod(rmPathStr.c_str(), 0666);
+					stat(rmPath.dir.c_str(), &oldDirPerms);
+					chmod(rmPath.dir.c_str(), S_IRWXU);
+				}
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
+				if((prompt && promptInput != 'a') || verbose)
 				{
-					if(options[o] == "!o")
-						addOut = 0;
-					else if(options[o] == "!\n")
-						addNewLines = 0;
-					else if(options[o] == "\n")
-						eob = "\n\n";
-					else if(options[o].substr(0, 4) == "eob=")
+					std::cout << "rmv " << quote(params[p]);
+
+					if(prompt && promptInput != 'a')
 					{
-						eob = unquote(options[o].substr(4, options[o].size()-4));
-						if(eob[eob.size()-1] != '\n')
-							addIndent = 0;
+						std::cout << "? " << std::flush;
+						promptInput = nsm_getch();
+						if(promptInput == 'Y' || promptInput == '1')
+							promptInput = 'y';
+						else if(promptInput == 'A')
+							promptInput = 'a';
 					}
-					else if(options[o] == "s")
-						addScope = 1;
-					else if(options[o] == "!s")
-						addScope = 0;
-					else if(options[o] == "n++")
-						dwLang = 'n';
-					else if(options[o] == "f++")
-						dwLang = 'f';
+					
+					std::cout << std::endl;
 				}
-			}
-
-			bool boolCond = 0, exprtkCond = 0, varCond = 0, result;
-			Expr condExpr;
-			VPos vpos;
-
-			if(get_bool(result, params[0]))
-				boolCond = 1;
-			else
-			{
-				condExpr.register_symbol_table(symbol_table);
-				if(params[0] != "" && condExpr.compile(params[0]))
-					exprtkCond = 1;
-				else if(replaceVars && vars.find(params[0], vpos))
-						varCond = 1;
-			}
 
-			while(1)
-			{
-				if(first)
-					first = 0;
-				else
+				if(!prompt || promptInput == 'y' || promptInput == 'a')
 				{
-					if(addNewLines && addOut)
+					if(dir_exists(rmPathStr))
 					{
-						outStr += eob;
-						if(addIndent)
+						if(!can_write(rmPath.str()) || delDir(rmPathStr, sLineNo, readPath, eos, consoleLocked, os_mtx))
 						{
-							indentAmount = wBaseIndentAmount;
-							outStr += indentAmount;
+							if(!consoleLocked)
+								os_mtx->lock();
+							start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to remove directory ";
+							eos << quote(params[p]) << std::endl;
+							os_mtx->unlock();
+							return 1;
 						}
-						else
-							indentAmount += into_whitespace(eob);
+					}
+					else if(!can_write(rmPath.str()) || remove_file(rmPath))
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to remove file ";
+						eos << quote(params[p]) << std::endl;
+						os_mtx->unlock();
+						return 1;
 					}
 				}
 
-				if(addScope)
-				{
-					std::string cScope = vars.layers[vars.layers.size()-1].scope;
-					vars.add_layer(cScope);
-					//vars.add_layer(vars.layers[vars.layers.size()-1].scope); //this is broken on windows!
-				}
+				if(changePermissions)
+					chmod(rmPath.dir.c_str(), oldDirPerms.st_mode);
+			}
+		}
 
-				int ret_val = 1;
-				if(dwLang == 'n')
-					ret_val = n_read_and_process_fast(addOut, addOut, block, bLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
-				else if(dwLang == 'f')
-					ret_val = f_read_and_process_fast(addOut, block, bLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
+		if(linePos < inStr.size() && inStr[linePos] == '!')
+			++linePos;
+		else
+			skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+	}
 
-				if(addScope)
-					vars.layers.pop_back();
+	return 0;
+}
 
-				if(ret_val == NSM_BREAK)
-					break;
-				else if(ret_val)
-					return ret_val;
+int Parser::builtin_return(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size() < 1)
+	{
+		if(read_sh_params(params, ' ', linePos, inStr, readPath, lineNo, funcName, eos))
+			return 1;
+	}
 
-				if(boolCond)
-				{
-					if(!result)
-						break;
-				}
-				else if(exprtkCond)
-				{
-					if(!condExpr.evaluate())
-						break;
-				}
-				else if(varCond)
-				{
-					if(!vars.get_bool_from_var(vpos, result))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot get bool from variable ";
-						eos << quote(vpos.name) << " of type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
+	if(params.size() > 1)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "return: expected 0-1 parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-					if(!result)
-						break;
-				}
-				else
-				{
-					parsedCondition = params[0];
+	if(params.size() == 1)
+	{
+		outStr = params[0];
+		if(indent)
+			indentAmount = into_whitespace(params[0]);
+	}
 
-					if(parse_replace('f', parsedCondition, "do-while condition", readPath, antiDepsOfReadPath, conditionLineNo, "do-while(" + params[0] + ")", sLineNo, eos))
-						return 1;
+	return NSM_RET;
+}
 
-					if(replaceVars && replace_var(parsedCondition, readPath, conditionLineNo, "do-while", eos))
-						return 1;
+int Parser::builtin_replace_all(FnCall& call)
+{
+	const bool& indent = call.indent;
+	std::string& outStr = call.outStr;
+	std::vector<std::string>& params = call.params;
 
-					if(!get_bool(result, parsedCondition))
-					{
-						if(parsedCondition != "" && condExpr.compile(parsedCondition))
-							result = condExpr.evaluate();
-						else
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err(eos, readPath, conditionLineNo) << funcName << ": cannot convert " << quote(parsedCondition) << " to bool" << std::endl;
-							start_err(eos, readPath, sLineNo) << funcName << ": possible errors from exprtk:" << std::endl;
-							print_exprtk_parser_errs(eos, condExpr.parser, condExpr.expr_str, readPath, sLineNo);
-							os_mtx->unlock();
-							return 1;
-						}
-					}
+	std::string str;
 
-					if(!result)
-						break;
-				}
-			}
+	//if(replaceVars && replace_var(params[0], readPath, sLineNo, "replace_all", eos))
+	  //  return 1;
 
-			if(!addOut)
-			{
-				if(linePos < inStr.size() && inStr[linePos] == '!')
-					++linePos;
-				else
-					skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
-			}
+	if(params[0] == "ofile")
+		parsedText = findAndReplaceAll(parsedText, params[1], params[2]);
+	else
+	{
+		params[0] = findAndReplaceAll(params[0], params[1], params[2]);
 
-			return 0;
-		}
-		#if defined _WIN32 || defined _WIN64
-		#else
-			else if(funcName == "dir")
-				funcName = "ls";
-			else if(funcName == "del")
-				funcName = "rm";
-		#endif
+		outStr += params[0];
+		if(indent)
+			indentAmount.add_text(params[0]);
 	}
-	else if(funcName[0] == 's')
+
+	return 0;
+}
+
+int Parser::builtin_refresh_completions(FnCall& /*call*/)
+{
+	return refresh_completions();
+}
+
+int Parser::builtin_replace_vars(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size())
 	{
-		if(funcName == "size")
+		if(isInt(params[0]))
+			replaceVarsGlobal = std::atoi(params[0].c_str());
+		else if(isDouble(params[0]))
+			replaceVarsGlobal = std::strtod(params[0].c_str(), NULL);
+		else
 		{
-			if(params.size() != 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "size: expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot convert " << quote(params[0]) << " to bool" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
+	else
+	{
+		std::string output = std::to_string(replaceVarsGlobal);
+		outStr += output;
+		if(indent)
+			indentAmount.add_text(output);
+	}
 
-			if(replaceVars && replace_var(params[0], readPath, sLineNo, "size", eos))
-				return 1;
+	return 0;
+}
 
-			params[0] = std::to_string(params[0].size());
-			outStr += params[0];
-			if(indent)
-				indentAmount += into_whitespace(params[0]);
+int Parser::builtin_break(FnCall& /*call*/)
+{
+	return NSM_BREAK;
+}
 
-			return 0;
+int Parser::builtin_blank(FnCall& /*call*/)
+{
+	return 0;
+}
+
+int Parser::builtin_fpp(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const bool& addOutput = call.addOutput;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	int bLineNo = lineNo;
+	bool addOut = addOutput;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "o")
+				addOut = 1;
+			else if(options[o] == "!o")
+				addOut = 0;
 		}
-		else if(funcName == "substr")
+	}
+
+	if(params.size())
+	{
+		if(!file_exists(params[0]))
 		{
-			if(params.size() != 3)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "substr: expected 3 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "f++: file " << params[0] << " does not exist" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			if(replaceVars && replace_var(params[0], readPath, sLineNo, "substr", eos))
-				return 1;
+		params[0] = string_from_file(params[0]);
+	}
+	else
+	{
+		params.push_back("");
+		if(read_block(params[0], linePos, inStr, readPath, lineNo, bLineNo, "f++{block}", eos))
+			return 1;
+	}
 
-			size_t pos = std::atoi(params[1].c_str()),
-			    length = std::atoi(params[2].c_str());
-			std::string str, oldLine;
+	std::string resultStr;
+	int result = f_read_and_process_fast(addOut, params[0], bLineNo-1, readPath, antiDepsOfReadPath, resultStr, eos);
 
-			if(!isNonNegInt(params[1]) || pos >= params[0].size())
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "substr: second parameter " << params[1] << " should be a non-negative integer less than the size of the first parameter" << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-			else if(!isNonNegInt(params[2]))
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "substr: third parameter " << params[2] << " should be a non-negative integer" << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	if(result)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed here" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-			str += params[0].substr(pos, length);
+	if(addOut)
+	{
+		std::string resultStr = std::to_string(result);
+		outStr += resultStr;
+		if(indent)
+			indentAmount.add_text(resultStr);
+	}
 
-			std::istringstream iss(str);
-			int fileLineNo = 0;
 
-			while(!iss.eof())
-			{
-				getline(iss, str);
-				if(0 < fileLineNo++)
-					outStr += "\n" + indentAmount;
-				outStr += str;
-				oldLine = str;
-			}
-			if(indent)
-				indentAmount += into_whitespace(oldLine);
+	return result;
+}
 
-			return 0;
+int Parser::builtin_for(FnCall& call)
+{
+	const char& lang = call.lang;
+	const bool& addOutput = call.addOutput;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	int& conditionLineNo = call.conditionLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(params.size() != 3 && params.size() != 4)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "for: expected 3-4 parameters separated by ';', got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	bool first = 1, addNewLines = 1, addIndent = 1, addScope = addScopeGlobal, addOut = addOutput;
+	char fLang = lang;
+	std::string block, parsedCondition, eob = "\n";
+	std::shared_ptr<const SegmentedText> segmentedBlock;
+	Indent wBaseIndentAmount = indentAmount;
+	int bLineNo = lineNo;
+
+	std::string forStr;
+
+	if(params.size() == 3)
+		forStr = "for(" + params[0] + "; " + params[1] + "; " + params[2] + ")";
+	else
+		forStr = "for(" + params[0] + "; " + params[1] + "; " + params[2] + "; " + params[3] + ")";
+
+	if(read_block(block, segmentedBlock, linePos, inStr, call.segmented, readPath, lineNo, bLineNo, forStr, eos))
+		return 1;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "!o")
+				addOut = 0;
+			else if(options[o] == "!\n")
+				addNewLines = 0;
+			else if(options[o] == "\n")
+				eob = "\n\n";
+			else if(options[o].substr(0, 4) == "eob=")
+			{
+				eob = unquote(options[o].substr(4, options[o].size()-4));
+				if(eob[eob.size()-1] != '\n')
+					addIndent = 0;
+			}
+			else if(options[o] == "s")
+				addScope = 1;
+			else if(options[o] == "!s")
+				addScope = 0;
+			else if(options[o] == "n++")
+				fLang = 'n';
+			else if(options[o] == "f++")
+				fLang = 'f';
 		}
-		else if(funcName == "struct")
+	}
+
+	//adds layer of scope
+	if(addScope)
+	{
+		std::string cScope = vars.layers[vars.layers.size()-1].scope;
+		vars.add_layer(cScope);
+		//vars.add_layer(vars.layers[vars.layers.size()-1].scope); //this is broken on windows!
+	}
+
+	bool boolCond = 0, exprtkCond = 0, varCond = 0, result;
+	bool exprtkInc = 0;
+	Expr preExpr, condExpr, incExpr;
+	VPos vpos;
+
+	//runs pre-for-loop code
+	if(params[0] != "")
+	{
+		//check if it compiles as exprtk script
+		preExpr.use_cache(exprCache);
+		if(preExpr.compile(params[0]))
+			preExpr.evaluate();
+		else
 		{
-			if(params.size() != 1)
+			//parsedCondition = params[0];
+
+			//if(parse_replace('f', parsedCondition, "pre-for-loop code", readPath, antiDepsOfReadPath, conditionLineNo, forStr, sLineNo, eos))
+			  //  return 1;
+
+			if(f_read_and_process_fast(0, params[0], conditionLineNo-1, readPath, antiDepsOfReadPath, parsedCondition, eos))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "struct: expected 1 parameter, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) <<  funcName << ": failed to parse pre-loop code" << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+		}
+	}
 
-			std::string block;
-			char structLang = 'f';
-			bool parseBlock = 0;
+	if(params[1] == "")
+		params[1] = "1";
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "f++")
-						structLang = 'f';
-					else if(options[o] == "n++")
-						structLang = 'n';
-					else if(options[o] == "pb")
-						parseBlock = 1;
-				}
-			}
+	//determines condition type
+	if(get_bool(result, params[1]))
+		boolCond = 1;
+	else
+	{
+		condExpr.use_cache(exprCache);
+		if(params[1] != "" && condExpr.compile(params[1]))
+			exprtkCond = 1;
+		else if(replaceVars && vars.find(params[1], vpos))
+			varCond = 1;
+	}
 
-			//checks whether name exists at current scope
-			VPos vpos;
-			if(vars.find(params[0], vpos))
+	//determines post-for-block/increment code type
+	bool hasIncrements = 0;
+
+	for(size_t i=1; i<params[2].size(); ++i)
+	{
+		if(params[2][i] == '+' && params[2][i-1] == '+')
+		{
+			hasIncrements = 1;
+			break;
+		}
+		else if(params[2][i] == '-' && params[2][i-1] == '-')
+		{
+			hasIncrements = 1;
+			break;
+		}
+	}
+	if(!hasIncrements)
+	{
+		incExpr.use_cache(exprCache);
+		if(params[2] != "" && incExpr.compile(params[2]))
+			exprtkInc = 1;
+	}
+
+	while(1)
+	{
+		if(boolCond)
+		{
+			if(!result)
+				break;
+		}
+		else if(exprtkCond)
+		{
+			if(!condExpr.evaluate())
+				break;
+		}
+		else if(varCond)
+		{
+			if(!vars.get_bool_from_var(vpos, result))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "struct: cannot have struct and variable/function named " << quote(params[0]) << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot get bool from variable ";
+				eos << quote(vpos.name) << " of type " << quote(vpos.type) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
-			else if(vars.typeDefs.count(params[0]))
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "struct: redeclaration of struct name " << quote(params[0]) << std::endl;
-				os_mtx->unlock();
+
+			if(!result)
+				break;
+		}
+		else
+		{
+			parsedCondition = params[1];
+
+			if(parse_replace('f', parsedCondition, "for condition", readPath, antiDepsOfReadPath, conditionLineNo, forStr, sLineNo, eos))
 				return 1;
-			}
-			else
-			{
-				vars.typeDefLineNo[params[0]] = lineNo;
 
-				if(read_block(block, linePos, inStr, readPath, lineNo, vars.typeDefLineNo[params[0]], "struct(" + params[0] + ")", eos))
-					return 1;
+			if(replaceVars && replace_var(parsedCondition, readPath, conditionLineNo, "for", eos))
+				return 1;
 
-				if(parseBlock && parse_replace(lang, block, "struct block", readPath, antiDepsOfReadPath, vars.typeDefLineNo[params[0]], "struct(" + params[0] + ")", sLineNo, eos))
+			if(!get_bool(result, parsedCondition))//, readPath, conditionLineNo, "for", eos))
+			{
+				if(parsedCondition != "" && condExpr.compile(parsedCondition))
+					result = condExpr.evaluate();
+				else
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err(eos, readPath, conditionLineNo) << funcName << ": cannot convert " << quote(parsedCondition) << " to bool" << std::endl;
+					start_err(eos, readPath, sLineNo) << funcName << ": possible errors from ExprTk:" << std::endl;
+					print_exprtk_parser_errs(eos, condExpr.errors(), condExpr.expr_str, readPath, sLineNo);
+					os_mtx->unlock();
 					return 1;
-
-				vars.typeDefs[params[0]] = block;
-				if(structLang == 'n')
-					vars.nTypes.insert(params[0]);
-				vars.typeDefPath[params[0]] = readPath;
+				}
 			}
 
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
-
-			return 0;
+			if(!result)
+				break;
 		}
-		else if(funcName.substr(0, 12) == "std::vector.")
-		{
-			std::string vectorFnName = funcName.substr(12, funcName.size()-12);
 
-			if(vectorFnName == "push_back")
+		if(first)
+			first = 0;
+		else
+		{
+			if(addNewLines && addOut)
 			{
-				bool memberFn = 0;
-
-				if(options.size())
+				outStr += eob;
+				if(addIndent)
 				{
-					for(size_t o=0; o<options.size(); ++o)
-					{
-						if(options[o] == "mf")
-							memberFn = 1;
-					}
+					indentAmount = wBaseIndentAmount;
+					outStr += indentAmount;
 				}
-
-				std::string errStr;
-				if(memberFn && params.size())
-					errStr = params[0];
 				else
-					errStr = "std::vector";
+					indentAmount.add_text(eob);
+			}
+		}
 
-				if(params.size() < 2)
-				{
-					if(!params.size())
-						params.push_back("std::vector");
+		if(addScope)
+		{
+			std::string cScope = vars.layers[vars.layers.size()-1].scope;
+			vars.add_layer(cScope);
+			//vars.add_layer(vars.layers[vars.layers.size()-1].scope); //this is broken on windows!
+		}
 
-					if(!consoleLocked)
-						os_mtx->lock();
-					if(memberFn)
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".push_back: expected 1+ parameters, got " << params.size()-1 << std::endl;
-					else
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".push_back: expected 2+ parameters, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+		int ret_val = 1;
+		if(fLang == 'n' && segmentedBlock)
+			ret_val = n_read_and_process_fast(addOut, addOut, segmentedBlock->text, segmentedBlock.get(), bLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
+		else if(fLang == 'n')
+			ret_val = n_read_and_process_fast(addOut, addOut, block, bLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
+		else if(fLang == 'f')
+			ret_val = f_read_and_process_fast(addOut, block, bLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
 
-				VPos vpos;
+		if(addScope)
+			vars.layers.pop_back();
 
-				if(vars.find(params[0], vpos))
-				{
-					if(vars.layers[vpos.layer].constants.count(vpos.name))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err(eos, readPath, lineNo) << errStr << ".push_back: attempted illegal change of constant variable " << quote(params[0]) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
+		if(ret_val == NSM_BREAK)
+			break;
+		else if(ret_val)
+			return ret_val;
 
-					if(memberFn)
-					{
-						if(params[0] == "options")
-							vpos.name = params[0] = "__options";
-						else if(params[0] == "params")
-							vpos.name = params[0] = "__params";
-					}
+		//runs post-for-block code
+		if(exprtkInc)
+			incExpr.evaluate();
+		else
+		{
+			parsedCondition = params[2];
 
-					if(vpos.type == "std::vector<double>")
-					{
-						for(size_t v=1; v<params.size(); v++)
-						{
-							if(!isDouble(params[v]))
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".push_back: value " << quote(params[v]) << " given to push back is not a double" << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-							vars.layers[vpos.layer].doubVecs[params[0] ].push_back(std::strtod(params[v].c_str(), NULL));
-						}
-					}
-					else if(vpos.type == "std::vector<string>")
-					{
-						for(size_t v=1; v<params.size(); v++)
-							vars.layers[vpos.layer].strVecs[params[0] ].push_back(params[v]);
-					}
-					else
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".push_back: do not recognise the type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".push_back: no variables named " << quote(params[0]) << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+			if(parse_replace(0, 'f', parsedCondition, "post-for-block code", readPath, antiDepsOfReadPath, conditionLineNo, forStr, sLineNo, eos))
+				return 1;
+		}
+	}
 
-				return 0;
-			}
-			else if(vectorFnName == "size")
-			{
-				bool memberFn = 0;
+	if(params.size() == 4)
+	{
+		//runs post-for-loop code
+		//could check here whether post-for-loop code compiles as an exprtk script
+		parsedCondition = params[3];
 
-				if(options.size())
-				{
-					for(size_t o=0; o<options.size(); ++o)
-					{
-						if(options[o] == "mf")
-							memberFn = 1;
-					}
-				}
+		if(parse_replace('f', parsedCondition, "post-for-loop code", readPath, antiDepsOfReadPath, conditionLineNo, forStr, sLineNo, eos))
+			return 1;
+	}
 
-				std::string errStr;
-				if(memberFn && params.size())
-					errStr = params[0];
-				else
-					errStr = "std::vector";
 
-				if(params.size() != 1)
-				{
-					if(!params.size())
-						params.push_back("std::vector");
+	if(addScope)
+		vars.layers.pop_back();
 
-					if(!consoleLocked)
-						os_mtx->lock();
-					if(memberFn)
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".size: expected 0 parameters, got " << params.size()-1 << std::endl;
-					else
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".size: expected 1 parameter, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	if(!addOut)
+	{
+		if(linePos < inStr.size() && inStr[linePos] == '!')
+			++linePos;
+		else
+			skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+	}
 
-				VPos vpos;
+	return 0;
+}
 
-				if(vars.find(params[0], vpos))
-				{
-					if(memberFn)
-					{
-						if(params[0] == "options")
-							vpos.name = params[0] = "__options";
-						else if(params[0] == "params")
-							vpos.name = params[0] = "__params";
-					}
+int Parser::builtin_function(FnCall& call)
+{
+	const char& lang = call.lang;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	std::string block;
+	int bLineNo = lineNo;
+	char fnLang = lang;
+	std::string fnType = funcName;
+	bool parseBlock = 0;
+	size_t layer = vars.layers.size()-1;
+	bool addOut, isConst = 1, isPrivate = 0, unscopedFn = 0;
+	std::unordered_set<std::string> inScopes;
 
-					if(vpos.type == "std::vector<double>")
-					{
-						std::string sizeStr = std::to_string(vars.layers[vpos.layer].doubVecs[vpos.name].size());
-						outStr += sizeStr;
-						if(indent)
-							indentAmount += into_whitespace(sizeStr);
-					}
-					else if(vpos.type == "std::vector<string>")
-					{
-						std::string sizeStr = std::to_string(vars.layers[vpos.layer].strVecs[vpos.name].size());
-						outStr += sizeStr;
-						if(indent)
-							indentAmount += into_whitespace(sizeStr);
-					}
-					else
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".size: do not recognise the type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-				else
+	if(lang == 'n')
+		addOut = 1;
+	else
+		addOut = 0;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "lambda")
+				fnType = "lambda";
+			else if(options[o] == "o")
+				addOut = 1;
+			else if(options[o] == "!o")
+				addOut = 0;
+			else if(options[o] == "f++")
+				fnLang = 'f';
+			else if(options[o] == "n++")
+				fnLang = 'n';
+			else if(options[o] == "!const")
+				isConst = 0;
+			else if(options[o] == "private")
+				isPrivate = 1;
+			else if(options[o].substr(0, 7) == "scope+=")
+				inScopes.insert(unquote(options[o].substr(7, options[o].size()-7)));
+			else if(options[o] == "!s")
+				unscopedFn = 1;
+			else if(options[o] == "s")
+				unscopedFn = 0;
+			else if(options[o] == "pb")
+				parseBlock = 1;
+			else if(options[o].substr(0, 6) == "layer=")
+			{
+				std::string str = unquote(options[o].substr(6, options[o].size()-6));
+
+				if(!isNonNegInt(str))
 				{
 					if(!consoleLocked)
 						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".size: no variables named " << quote(params[0]) << std::endl;
+					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": specified layer " << quote(str) << " is not a non-negative integer" << std::endl;
 					os_mtx->unlock();
 					return 1;
 				}
-
-				return 0;
-			}
-			else if(vectorFnName == "at")
-			{
-				bool memberFn = 0;
-
-				if(options.size())
-				{
-					for(size_t o=0; o<options.size(); ++o)
-					{
-						if(options[o] == "mf")
-							memberFn = 1;
-					}
-				}
-
-				std::string errStr;
-				if(memberFn && params.size())
-					errStr = params[0];
-				else
-					errStr = "std::vector";
-
-				if(params.size() != 2)
+				layer = std::atoi(str.c_str());
+				if(layer >= vars.layers.size())
 				{
-					if(!params.size())
-						params.push_back("std::vector");
-
 					if(!consoleLocked)
 						os_mtx->lock();
-					if(memberFn)
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".at: expected 1 parameter, got " << params.size()-1 << std::endl;
-					else
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".at: expected 2 parameters, got " << params.size() << std::endl;
+					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName<< ": specified layer " << quote(str) << " should be less than the number of layers" << std::endl;
 					os_mtx->unlock();
 					return 1;
 				}
+			}
+		}
+	}
 
-				bool round = 1;
+	if(read_block(block, linePos, inStr, readPath, lineNo, bLineNo, fnType + "(" + params[0] + ")", eos))
+		return 1;
 
-				if(options.size())
-				{
-					for(size_t o=0; o<options.size(); ++o)
-					{
-						if(options[o] == "!round")
-							round = 0;
-					}
-				}
+	if(parseBlock && parse_replace(lang, block, fnType + " block", readPath, antiDepsOfReadPath, bLineNo, fnType, sLineNo, eos))
+		return 1;
 
-				VPos vpos;
+	if(add_fn(params[0], fnLang, block, fnType, layer, isConst, isPrivate, unscopedFn, addOut, inScopes, readPath, bLineNo, funcName, eos))
+		return 1;
 
-				if(vars.find(params[0], vpos))
-				{
-					int i = std::atoi(params[1].c_str());
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-					if(i < 0)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".at(" << i << "): negative index" << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
+	return 0;
+}
 
-					if(memberFn)
-					{
-						if(params[0] == "options")
-							vpos.name = params[0] = "__options";
-						else if(params[0] == "params")
-							vpos.name = params[0] = "__params";
-					}
+int Parser::builtin_forget(FnCall& call)
+{
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	bool rmFromExprTk = 0;
 
-					if(vpos.type == "std::vector<double>")
-					{
-						int size = vars.layers[vpos.layer].doubVecs[vpos.name].size();
-						if(i >= size)
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".at(" << i << "): index out of bounds, vector size: " << size << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-						std::string valueStr = vars.double_to_string(vars.layers[vpos.layer].doubVecs[vpos.name][i], round);
-						outStr += valueStr;
-						if(indent)
-							indentAmount += into_whitespace(valueStr);
-					}
-					else if(vpos.type == "std::vector<string>")
-					{
-						int size = vars.layers[vpos.layer].strVecs[vpos.name].size();
-						if(i >= size)
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".at(" << i << "): index out of bounds, vector size: " << size << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-						std::string valueStr = vars.layers[vpos.layer].strVecs[vpos.name][i];
-						outStr += valueStr;
-						if(indent)
-							indentAmount += into_whitespace(valueStr);
-					}
-					else
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".at: do not recognise the type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-				else
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); ++o)
+		{
+			if(options[o] == "exprtk")
+				rmFromExprTk = 1;
+		}
+	}
+
+	VPos vpos;
+	for(size_t p=0; p<params.size(); p++)
+	{
+		if(vars.find(params[p], vpos))
+		{
+			if(vars.layers[vpos.layer].privates.count(params[p]))
+			{
+				if(!vars.layers[vpos.layer].inScopes[params[p]].count(vars.layers[vars.layers.size()-1].scope))
 				{
 					if(!consoleLocked)
 						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".at: no variables named " << quote(params[0]) << std::endl;
+					start_err_ml(eos, readPath, sLineNo, lineNo) << "forget: attempted illegal removal of private variable " << quote(params[p]) << std::endl;
 					os_mtx->unlock();
 					return 1;
 				}
+			}
 
-				return 0;
+			
+			//exprtk refers to the erased value, so it is always unbound from it
+			if(vpos.type == "bool" || vpos.type == "int" || vpos.type == "double")
+			{
+				if(symbol_table.symbol_exists(params[p]) && (rmFromExprTk || exprCache.bound_to(params[p], vars.layers[vpos.layer].doubles[params[p]])))
+					exprCache.remove_variable(params[p]);
+				vars.layers[vpos.layer].doubles.erase(params[p]);
 			}
-			else if(vectorFnName == "set")
+			else if(vpos.type == "char" || vpos.type == "string")
 			{
-				bool memberFn = 0;
-
-				if(options.size())
+				if(symbol_table.symbol_exists(params[p]) && (rmFromExprTk || exprCache.bound_to(params[p], vars.layers[vpos.layer].strings[params[p]])))
+					exprCache.remove_stringvar(params[p]);
+				vars.layers[vpos.layer].strings.erase(params[p]);
+			}
+			else if(vpos.type.substr(0, 5) == "std::")
+			{
+				if(vpos.type == "std::bool")
+					vars.layers[vpos.layer].bools.erase(params[p]);
+				if(vpos.type == "std::int")
+					vars.layers[vpos.layer].ints.erase(params[p]);
+				if(vpos.type == "std::double")
 				{
-					for(size_t o=0; o<options.size(); ++o)
-					{
-						if(options[o] == "mf")
-							memberFn = 1;
-					}
+					if(exprCache.bound_to(params[p], vars.layers[vpos.layer].doubles[params[p]]))
+						exprCache.remove_variable(params[p]);
+					vars.layers[vpos.layer].doubles.erase(params[p]);
 				}
-
-				std::string errStr;
-				if(memberFn && params.size())
-					errStr = params[0];
-				else
-					errStr = "std::vector";
-
-				if(params.size() != 3)
+				else if(vpos.type == "std::char")
+					vars.layers[vpos.layer].chars.erase(params[p]);
+				else if(vpos.type == "std::string")
 				{
-					if(!params.size())
-						params.push_back("std::vector");
-
-					if(!consoleLocked)
-						os_mtx->lock();
-					if(memberFn)
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set: expected 2 parameters, got " << params.size()-1 << std::endl;
-					else
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set: expected 3 parameters, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
+					if(exprCache.bound_to(params[p], vars.layers[vpos.layer].strings[params[p]]))
+						exprCache.remove_stringvar(params[p]);
+					vars.layers[vpos.layer].strings.erase(params[p]);
 				}
-
-				VPos vpos;
-
-				if(vars.find(params[0], vpos))
+				else if(vpos.type == "std::llint")
+					vars.layers[vpos.layer].llints.erase(params[p]);
+				else if(vpos.type == "std::vector<double>")
 				{
-					if(vars.layers[vpos.layer].constants.count(vpos.name))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err(eos, readPath, lineNo) << errStr << ".set: attempted illegal change of constant variable " << quote(params[0]) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-
-					int i = std::atoi(params[1].c_str());
+					if(symbol_table.symbol_exists(params[p]) && (rmFromExprTk || exprCache.bound_to(params[p], vars.layers[vpos.layer].doubVecs[params[p]])))
+						exprCache.remove_vector(params[p]);
+					vars.layers[vpos.layer].doubVecs.erase(params[p]);
+				}
+				else if(vpos.type == "std::vector<string>")
+					vars.layers[vpos.layer].strVecs.erase(params[p]);
+			}
+			else if(vpos.type == "fstream")
+				vars.layers[vpos.layer].fstreams.erase(params[p]);
+			else if(vpos.type == "ifstream")
+				vars.layers[vpos.layer].ifstreams.erase(params[p]);
+			else if(vpos.type == "ofstream")
+				vars.layers[vpos.layer].ofstreams.erase(params[p]);
+			else if(vpos.type == "function" || vpos.type == "fn")
+			{
+				vars.layers[vpos.layer].functions.erase(params[p]);
+				vars.layers[vpos.layer].segmentedFns.erase(params[p]);
+				vars.layers[vpos.layer].luaFns.erase(params[p]);
+				vars.layers[vpos.layer].paths.erase(params[p]);
+				vars.layers[vpos.layer].ints.erase(params[p]);
+			}
 
-					if(i < 0)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set(" << i << "): negative index" << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
+			vars.layers[vpos.layer].typeOf.erase(params[p]);
+			vars.layers[vpos.layer].inScopes.erase(params[p]);
+			vars.layers[vpos.layer].scopeOf.erase(params[p]);
+			vars.layers[vpos.layer].constants.erase(params[p]);
+			vars.layers[vpos.layer].privates.erase(params[p]);
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "forget: no variable or function named " << params[p] << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-					if(memberFn)
-					{
-						if(params[0] == "options")
-							vpos.name = params[0] = "__options";
-						else if(params[0] == "params")
-							vpos.name = params[0] = "__params";
-					}
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-					if(vpos.type == "std::vector<double>")
-					{
-						int size = vars.layers[vpos.layer].doubVecs[vpos.name].size();
-					
-						if(i >= size)
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set(" << i << "): index out of bounds, vector size: " << size << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-						else if(!isDouble(params[2]))
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set(" << i << "): value given is not a double" << std::endl;
-							start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set(" << i << "): value given = " << quote(params[2]) << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
+	return 0;
+}
 
-						vars.layers[vpos.layer].doubVecs[vpos.name][i] = std::strtod(params[2].c_str(), NULL);
-					}
-					else if(vpos.type == "std::vector<string>")
-					{
-						int size = vars.layers[vpos.layer].strVecs[vpos.name].size();
-					
-						if(i >= size)
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set(" << i << "): index out of bounds, vector size: " << size << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
+int Parser::builtin_faviconinclude(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	std::string faviconPathStr = params[0];
+	Path faviconPath;
+	faviconPath.set_file_path_from(faviconPathStr);
+
+	//warns user if favicon file doesn't exist
+	if(!file_exists(faviconPathStr.c_str()))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_warn(eos, readPath, lineNo) << "faviconinclude: favicon file " << faviconPath << " does not exist" << std::endl;
+		if(!consoleLocked)
+			os_mtx->unlock();
+	}
 
-						vars.layers[vpos.layer].strVecs[vpos.name][i] = params[2];
-					}
-					else
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set: do not recognise the type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set: no variables named " << quote(params[0]) << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	Path pathToFavicon(pathBetween(toBuild.outputPath.dir, faviconPath.dir), faviconPath.file);
 
-				return 0;
-			}
-			else if(vectorFnName == "pop_back")
+	std::string faviconInclude = "<link rel=\"icon\" type=\"image/png\" href=\"" + pathToFavicon.str() + "\"";
+	if(options.size())
+		for(size_t o=0; o<options.size(); ++o)
+			faviconInclude += " " + options[o];
+	faviconInclude += ">";
+
+	outStr += faviconInclude;
+	if(indent)
+		indentAmount.add_text(faviconInclude);
+
+	return 0;
+}
+
+int Parser::builtin_typeof(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+
+	VPos vpos;
+
+	if(vars.find(params[0], vpos))
+	{
+		outStr += vars.layers[vpos.layer].typeOf[params[0]];
+		if(indent)
+			indentAmount.add_text(vars.layers[vpos.layer].typeOf[params[0]]);
+	}
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "typeof: " << params[0] << " is not defined" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	return 0;
+}
+
+int Parser::builtin_exprtk_eval(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const bool& addOutput = call.addOutput;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	bool addOut = addOutput, round = 1;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "o")
+				addOut = 1;
+			else if(options[o] == "!o")
+				addOut = 0;
+			else if(options[o] == "!round")
+				round = 0;
+		}
+	}
+
+	double value;
+	if(params.size())
+	{
+		if(exprset.expressions.count(params[0]))
+			value = exprset.evaluate(params[0]);
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.eval: no expression named " << quote(params[0]) << " has been compiled" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
+	else
+		value = expr.evaluate();
+
+	if(addOut)
+	{
+		std::string valueStr = vars.double_to_string(value, round);
+
+		outStr += valueStr;
+		if(indent)
+			indentAmount.add_text(valueStr);
+	}
+
+	return 0;
+}
+
+int Parser::builtin_exprtk(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const char& lang = call.lang;
+	const bool& addOutput = call.addOutput;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	ProfileSpan builtinSpan("@exprtk", "builtin");
+
+	if(params.size() > 1)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk: expected 0-1 parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	int bLineNo = lineNo;
+	bool blockOpt = 0, fileOpt = 0, parseBlock = 0, addOut = addOutput, round = 1;
+	char blockLang = lang;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "f" || options[o] == "file")
+				fileOpt =  1;
+			if(options[o] == "f++")
+				blockLang = 'f';
+			else if(options[o] == "n++")
+				blockLang = 'n';
+			else if(options[o] == "pb")
+				parseBlock = 1;
+			else if(options[o] == "o")
+				addOut = 1;
+			else if(options[o] == "!o")
+				addOut = 0;
+			else if(options[o] == "!round")
+				round = 0;
+		}
+	}
+
+	if(params.size() == 0)
+	{
+		blockOpt = 1;
+		params.push_back("");
+		if(read_block(params[0], linePos, inStr, readPath, lineNo, bLineNo, "exprtk{block}", eos))
+			return 1;
+
+		if(parseBlock && parse_replace(blockLang, params[0], "exprtk block", readPath, antiDepsOfReadPath, bLineNo, "exprtk{block}", sLineNo, eos))
+			return 1;
+	}
+	else if(fileOpt)
+	{
+		params[0] = string_from_file(params[0]);
+
+		if(!file_exists(params[0]))
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk: file " << params[0] << " does not exist" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
+
+	if(!expr.compile(params[0]))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err(eos, readPath, sLineNo) << c_green << "exprtk" << c_white << ": failed to compile expression" << std::endl;
+		if(blockOpt)
+			print_exprtk_parser_errs(eos, expr.errors(), params[0], readPath, bLineNo);
+		else
+			print_exprtk_parser_errs(eos, expr.errors(), params[0], readPath, sLineNo);
+		os_mtx->unlock();
+		return 1;
+	}
+
+	if(addOut)
+	{
+		std::string value = vars.double_to_string(expr.evaluate(), round);
+
+		outStr += value;
+		if(indent)
+			indentAmount.add_text(value);
+	}
+	else
+		expr.evaluate();
+
+	return 0;
+}
+
+int Parser::builtin_exprtk_compile(FnCall& call)
+{
+	const char& lang = call.lang;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	int bLineNo = lineNo;
+	bool blockOpt = 0, fileOpt = 0, parseBlock = 0;
+	char blockLang = lang;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "b" || options[o] == "block")
+				blockOpt = 1;
+			else if(options[o] == "f" || options[o] == "file")
+				fileOpt = 1;
+			else if(options[o] == "f++")
+				blockLang = 'f';
+			else if(options[o] == "n++")
+				blockLang = 'n';
+			else if(options[o] == "pb")
+				parseBlock = 1;
+		}
+	}
+
+	if(params.size() == 0)
+		blockOpt = 1;
+	else if(fileOpt)
+	{
+		if(params.size() != 1)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.compile: expected 1 parameter, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+
+		params.push_back(string_from_file(params[0]));
+
+		if(!file_exists(params[1]))
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.compile: file " << params[0] << " does not exist" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
+
+	if(blockOpt)
+	{
+		std::string block_str;
+		if(read_block(block_str, linePos, inStr, readPath, lineNo, bLineNo, "exprtk.compile{block}", eos))
+			return 1;
+
+		if(parseBlock && parse_replace(blockLang, block_str, "exprtk block", readPath, antiDepsOfReadPath, bLineNo, "exprtk.compile{block}", sLineNo, eos))
+			return 1;
+
+		params.push_back(block_str);
+	}
+
+	if(params.size() == 1)
+	{
+		if(!expr.compile(params[0]))
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err(eos, readPath, sLineNo) << c_green << "exprtk.compile" << c_white << ": failed to compile expression" << std::endl;
+			if(blockOpt)
+				print_exprtk_parser_errs(eos, expr.errors(), params[0], readPath, bLineNo);
+			else
+				print_exprtk_parser_errs(eos, expr.errors(), params[0], readPath, sLineNo);
+			os_mtx->unlock();
+			return 1;
+		}
+	}
+	else if(!exprset.compile(params[0], params[1]))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err(eos, readPath, sLineNo) << c_green << "exprtk.compile" << c_white << ": failed to compile expression" << std::endl;
+		if(blockOpt)
+			print_exprtk_parser_errs(eos, exprCache.errors(params[1]), params[1], readPath, bLineNo);
+		else
+			print_exprtk_parser_errs(eos, exprCache.errors(params[1]), params[1], readPath, sLineNo);
+		os_mtx->unlock();
+		return 1;
+	}
+
+	return 0;
+}
+
+int Parser::builtin_exprtk_cache_stats(FnCall& call)
+{
+	const bool& indent = call.indent;
+	std::string& outStr = call.outStr;
+	std::string& funcName = call.funcName;
+
+	std::string count;
+	if(funcName == "exprtk.cache_hits")
+		count = std::to_string(exprCache.noHits);
+	else
+		count = std::to_string(exprCache.noMisses);
+
+	outStr += count;
+	if(indent)
+		indentAmount.add_text(count);
+
+	return 0;
+}
+
+int Parser::builtin_exprtk_eval_params(FnCall& call)
+{
+	std::vector<std::string>& params = call.params;
+
+	exprtkParams = (std::strtod(params[0].c_str(), NULL));
+
+	return 0;
+}
+
+int Parser::builtin_exprtk_file(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const bool& addOutput = call.addOutput;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	bool addOut = addOutput, round = 1;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "o")
+				addOut = 1;
+			else if(options[o] == "!o")
+				addOut = 0;
+			else if(options[o] == "!round")
+				round = 0;
+		}
+	}
+
+	if(!file_exists(params[0]))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk: file " << params[0] << " does not exist" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+	
+	params[0] = string_from_file(params[0]);
+
+	if(!expr.compile(params[0]))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err(eos, readPath, sLineNo) << c_green << "exprtk" << c_white << ": failed to compile expression" << std::endl;
+		print_exprtk_parser_errs(eos, expr.errors(), params[0], readPath, sLineNo);
+		os_mtx->unlock();
+		return 1;
+	}
+
+	if(addOut)
+	{
+		std::string value = vars.double_to_string(expr.evaluate(), round);
+
+		outStr += value;
+		if(indent)
+			indentAmount.add_text(value);
+	}
+	else
+		expr.evaluate();
+
+	return 0;
+}
+
+int Parser::builtin_exprtk_load(FnCall& call)
+{
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+
+	if(exprset.expressions.count(params[0]))
+	{
+		expr.expr_str = exprset.expr_strs[params[0] ];
+		expr.expression = exprset.expressions[params[0] ];
+		expr.callsVolatile = exprset.volatileNames.count(params[0]);
+	}
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.load: no expression named " << quote(params[0]) << " has been compiled" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	return 0;
+}
+
+int Parser::builtin_exprtk_str(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size())
+	{
+		if(exprset.expressions.count(params[0]))
+		{
+			std::string expr_str = exprset.expr_strs[params[0] ];
+			outStr += expr_str;
+			if(indent)
+				indentAmount.add_text(expr_str);
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.str: no expression named " << quote(params[0]) << " has been compiled" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
+	else
+	{
+		outStr += expr.expr_str;
+		if(indent)
+			indentAmount.add_text(expr.expr_str);
+	}
+
+	return 0;
+}
+
+int Parser::builtin_exprtk_add_variable(FnCall& call)
+{
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+
+	VPos vpos;
+
+	for(size_t p=0; p<params.size(); ++p)
+	{
+		if(vars.find(params[p], vpos))
+		{
+			if(vpos.type == "bool" || vpos.type == "int" || vpos.type == "double" || vpos.type == "std::double")
+				exprCache.add_variable(params[p], vars.layers[vpos.layer].doubles[params[p]]);
+			else if(vpos.type == "char" || vpos.type == "string" || vpos.type == "std::string")
+				exprCache.add_stringvar(params[p], vars.layers[vpos.layer].strings[params[p]]);
+			else if(vpos.type == "std::vector<double>")
+				exprCache.add_vector(params[p], vars.layers[vpos.layer].doubVecs[params[p]]);
+			else
 			{
-				bool memberFn = 0;
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.add_variable: cannot add variable " << quote(params[p]) << " of type " << quote(vpos.type) << std::endl;
+				os_mtx->unlock();
+				return 1;
+			}
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.add_variable: no variables named " << quote(params[p]) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-				if(options.size())
-				{
-					for(size_t o=0; o<options.size(); ++o)
-					{
-						if(options[o] == "mf")
-							memberFn = 1;
-					}
-				}
+	return 0;
+}
 
-				std::string errStr;
-				if(memberFn && params.size())
-					errStr = params[0];
-				else
-					errStr = "std::vector";
+int Parser::builtin_exprtk_add_package(FnCall& call)
+{
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
 
-				if(params.size() != 1)
-				{
-					if(!params.size())
-						params.push_back("std::vector");
+	for(size_t p=0; p<params.size(); ++p)
+	{
+		if(params[p] == "basicio_package")
+			symbol_table.add_package(basicio_package);
+		else if(params[p] == "fileio_package")
+			symbol_table.add_package(fileio_package);
+		else if(params[p] == "vectorops_package")
+			symbol_table.add_package(vectorops_package);
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "exprtk.add_package: do not recognise package " << quote(params[p]) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
+	exprCache.symbols_added();
 
-					if(!consoleLocked)
-						os_mtx->lock();
-					if(memberFn)
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".pop_back: expected 0 parameters, got " << params.size()-1 << std::endl;
-					else
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".pop_back: expected 1 parameter, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	return 0;
+}
 
-				VPos vpos;
+int Parser::builtin_ent(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
 
-				if(vars.find(params[0], vpos))
-				{
-					if(vars.layers[vpos.layer].constants.count(vpos.name))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err(eos, readPath, lineNo) << errStr << ".pop_back: attempted illegal change of constant variable " << quote(params[0]) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
+	std::string ent = params[0];
+
+	if(ent.size() == 1)
+	{
+		/*
+			see http://dev.w3.org/html5/html-author/charref for
+			more character references than you could ever need!
+		*/
+		switch(ent[0])
+		{
+			case '`':
+				outStr += "&grave;";
+				if(indent)
+					indentAmount.add_spaces(7);
+				break;
+			case '~':
+				outStr += "&tilde;";
+				if(indent)
+					indentAmount.add_spaces(7);
+				break;
+			case '!':
+				outStr += "&excl;";
+				if(indent)
+					indentAmount.add_spaces(6);
+				break;
+			case '@':
+				outStr += "&commat;";
+				if(indent)
+					indentAmount.add_spaces(8);
+				break;
+			case '#':
+				outStr += "&num;";
+				if(indent)
+					indentAmount.add_spaces(5);
+				break;
+			case '$': //MUST HAVE MATHJAX HANDLE THIS WHEN \$
+				outStr += "&dollar;";
+				if(indent)
+					indentAmount.add_spaces(8);
+				break;
+			case '%':
+				outStr += "&percnt;";
+				if(indent)
+					indentAmount.add_spaces(8);
+				break;
+			case '^':
+				outStr += "&Hat;";
+				if(indent)
+					indentAmount.add_spaces(5);
+				break;
+			case '&':
+				outStr += "&amp;";
+				if(indent)
+					indentAmount.add_spaces(5);
+				break;
+			case '*':
+				outStr += "&ast;";
+				if(indent)
+					indentAmount.add_spaces(5);
+				break;
+			case '?':
+				outStr += "&quest;";
+				if(indent)
+					indentAmount.add_spaces(7);
+				break;
+			case '<':
+				outStr += "&lt;";
+				if(indent)
+					indentAmount.add_spaces(4);
+				break;
+			case '>':
+				outStr += "&gt;";
+				if(indent)
+					indentAmount.add_spaces(4);
+				break;
+			case '(':
+				outStr += "&lpar;";
+				if(indent)
+					indentAmount.add_spaces(6);
+				break;
+			case ')':
+				outStr += "&rpar;";
+				if(indent)
+					indentAmount.add_spaces(6);
+				break;
+			case '[':
+				outStr += "&lbrack;";
+				if(indent)
+					indentAmount.add_spaces(8);
+				break;
+			case ']':
+				outStr += "&rbrack;";
+				if(indent)
+					indentAmount.add_spaces(8);
+				break;
+			case '{':
+				outStr += "&lbrace;";
+				if(indent)
+					indentAmount.add_spaces(8);
+				break;
+			case '}':
+				outStr += "&rbrace;";
+				if(indent)
+					indentAmount.add_spaces(8);
+				break;
+			case '-':
+				outStr += "&minus;";
+				if(indent)
+					indentAmount.add_spaces(7);
+				break;
+			case '_':
+				outStr += "&lowbar;";
+				if(indent)
+					indentAmount.add_spaces(8);
+				break;
+			case '=':
+				outStr += "&equals;";
+				if(indent)
+					indentAmount.add_spaces(8);
+				break;
+			case '+':
+				outStr += "&plus;";
+				if(indent)
+					indentAmount.add_spaces(6);
+				break;
+			case '|':
+				outStr += "&vert;";
+				if(indent)
+					indentAmount.add_spaces(6);
+				break;
+			case '\\':
+				outStr += "&bsol;";
+				if(indent)
+					indentAmount.add_spaces(6);
+				break;
+			case '/':
+				outStr += "&sol;";
+				if(indent)
+					indentAmount.add_spaces(5);
+				break;
+			case ';':
+				outStr += "&semi;";
+				if(indent)
+					indentAmount.add_spaces(6);
+				break;
+			case ':':
+				outStr += "&colon;";
+				if(indent)
+					indentAmount.add_spaces(7);
+				break;
+			case '\'':
+				outStr += "&apos;";
+				if(indent)
+					indentAmount.add_spaces(6);
+				break;
+			case '"':
+				outStr += "&quot;";
+				if(indent)
+					indentAmount.add_spaces(6);
+				break;
+			case ',':
+				outStr += "&comma;";
+				if(indent)
+					indentAmount.add_spaces(7);
+				break;
+			case '.':
+				outStr += "&period;";
+				if(indent)
+					indentAmount.add_spaces(8);
+				break;
+			default:
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "ent: do not currently have an entity value for " << quote(ent) << std::endl;
+				os_mtx->unlock();
+				return 1;
+		}
+	}
+	else if(ent == "£")
+	{
+		outStr += "&pound;";
+		if(indent)
+			indentAmount.add_spaces(7);
+	}
+	else if(ent == "¥")
+	{
+		outStr += "&yen;";
+		if(indent)
+			indentAmount.add_spaces(5);
+	}
+	else if(ent == "€")
+	{
+		outStr += "&euro;";
+		if(indent)
+			indentAmount.add_spaces(6);
+	}
+	else if(ent == "§" || ent == "section")
+	{
+		outStr += "&sect;";
+		if(indent)
+			indentAmount.add_spaces(6);
+	}
+	else if(ent == "+-")
+	{
+		outStr += "&pm;";
+		if(indent)
+			indentAmount.add_spaces(4);
+	}
+	else if(ent == "-+")
+	{
+		outStr += "&mp;";
+		if(indent)
+			indentAmount.add_spaces(4);
+	}
+	else if(ent == "!=")
+	{
+		outStr += "&ne;";
+		if(indent)
+			indentAmount.add_spaces(4);
+	}
+	else if(ent == "<=")
+	{
+		outStr += "&leq;";
+		if(indent)
+			indentAmount.add_spaces(5);
+	}
+	else if(ent == ">=")
+	{
+		outStr += "&geq;";
+		if(indent)
+			indentAmount.add_spaces(5);
+	}
+	else if(ent == "->")
+	{
+		outStr += "&rarr;";
+		if(indent)
+			indentAmount.add_spaces(6);
+	}
+	else if(ent == "<-")
+	{
+		outStr += "&larr;";
+		if(indent)
+			indentAmount.add_spaces(6);
+	}
+	else if(ent == "<->")
+	{
+		outStr += "&harr;";
+		if(indent)
+			indentAmount.add_spaces(6);
+	}
+	else if(ent == "==>")
+	{
+		outStr += "&rArr;";
+		if(indent)
+			indentAmount.add_spaces(6);
+	}
+	else if(ent == "<==")
+	{
+		outStr += "&lArr;";
+		if(indent)
+			indentAmount.add_spaces(6);
+	}
+	else if(ent == "<==>")
+	{
+		outStr += "&hArr;";
+		if(indent)
+			indentAmount.add_spaces(6);
+	}
+	else if(ent == "<=!=>")
+	{
+		outStr += "&nhArr;";
+		if(indent)
+			indentAmount.add_spaces(7);
+	}
+	else if(ent == "...")
+	{
+		outStr += "&hellip;";
+		if(indent)
+			indentAmount.add_spaces(8);
+	}
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "ent: do not currently have an entity value for " << quote(ent) << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	return 0;
+}
 
-					if(memberFn)
-					{
-						if(params[0] == "options")
-							vpos.name = params[0] = "__options";
-						else if(params[0] == "params")
-							vpos.name = params[0] = "__params";
-					}
+int Parser::builtin_error(FnCall& call)
+{
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+
+	if(!consoleLocked)
+		os_mtx->lock();
+	start_err_ml(eos, readPath, sLineNo, lineNo) << params[0];
+	for(size_t p=1; p<params.size(); ++p)
+		eos << params[p];
+	eos << std::endl;
+	os_mtx->unlock();
 
-					if(vpos.type == "std::vector<double>")
-						vars.layers[vpos.layer].doubVecs[vpos.name].pop_back();
-					else if(vpos.type == "std::vector<string>")
-						vars.layers[vpos.layer].strVecs[vpos.name].pop_back();
-					else
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".pop_back: do not recognise the type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".pop_back: no variables named " << quote(params[0]) << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	return 1;
+}
 
-				return 0;
-			}
-			else if(vectorFnName == "erase")
-			{
-				bool memberFn = 0;
+int Parser::builtin_exit(FnCall& /*call*/)
+{
+	return NSM_EXIT; //check this??
+}
 
-				if(options.size())
-				{
-					for(size_t o=0; o<options.size(); ++o)
-					{
-						if(options[o] == "mf")
-							memberFn = 1;
-					}
-				}
+int Parser::builtin_dep(FnCall& call)
+{
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& params = call.params;
+
+	std::string depPathStr;
+	Path depPath;
 
-				std::string errStr;
-				if(memberFn && params.size())
-					errStr = params[0];
-				else
-					errStr = "std::vector";
+	for(size_t p=0; p<params.size(); ++p)
+	{
+		depPathStr = params[p];
+		depPath.set_file_path_from(depPathStr);
 
-				if(params.size() != 2 && params.size() != 3)
-				{
-					if(!params.size())
-						params.push_back("std::vector");
+		record_dep_hash(depPath);
+		depFiles.insert(depPath);
 
-					if(!consoleLocked)
-						os_mtx->lock();
-					if(memberFn)
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".erase: expected 1-2 parameters, got " << params.size()-1 << std::endl;
-					else   
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".erase: expected 2-3 parameters, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+		if(depPath == toBuild.contentPath)
+			contentAdded = 1;
 
-				VPos vpos;
+		if(!path_exists(depPathStr))
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "dep(" << quote(depPathStr) << ") failed as dependency does not exist" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-				if(vars.find(params[0], vpos))
-				{
-					if(vars.layers[vpos.layer].constants.count(vpos.name))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err(eos, readPath, lineNo) << errStr << ".erase: attempted illegal change of constant variable " << quote(params[0]) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-					if(memberFn)
-					{
-						if(params[0] == "options")
-							vpos.name = params[0] = "__options";
-						else if(params[0] == "params")
-							vpos.name = params[0] = "__params";
-					}
+	return 0;
+}
+
+int Parser::builtin_do_while(FnCall& call)
+{
+	const char& lang = call.lang;
+	const bool& addOutput = call.addOutput;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	int& conditionLineNo = call.conditionLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	bool first = 1, addNewLines = 1, addIndent = 1, addScope = addScopeGlobal, addOut = addOutput;
+	char dwLang = lang;
+	std::string block, parsedCondition, eob = "\n";
+	std::shared_ptr<const SegmentedText> segmentedBlock;
+	Indent wBaseIndentAmount = indentAmount;
+	int bLineNo = lineNo;
 
-					int i = std::atoi(params[1].c_str()), j;
-					int size = vars.layers[vpos.layer].doubVecs[vpos.name].size();
+	if(read_block(block, segmentedBlock, linePos, inStr, call.segmented, readPath, lineNo, bLineNo, "do-while(" + params[0] + ")", eos))
+		return 1;
 
-					if(i < 0)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".erase: negative index" << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-					else if(i >= size)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".erase: index out of bounds, vector size: " << size << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "!o")
+				addOut = 0;
+			else if(options[o] == "!\n")
+				addNewLines = 0;
+			else if(options[o] == "\n")
+				eob = "\n\n";
+			else if(options[o].substr(0, 4) == "eob=")
+			{
+				eob = unquote(options[o].substr(4, options[o].size()-4));
+				if(eob[eob.size()-1] != '\n')
+					addIndent = 0;
+			}
+			else if(options[o] == "s")
+				addScope = 1;
+			else if(options[o] == "!s")
+				addScope = 0;
+			else if(options[o] == "n++")
+				dwLang = 'n';
+			else if(options[o] == "f++")
+				dwLang = 'f';
+		}
+	}
 
-					if(params.size() > 2)
-					{
-						j = std::atoi(params[2].c_str());
+	bool boolCond = 0, exprtkCond = 0, varCond = 0, result;
+	Expr condExpr;
+	VPos vpos;
 
-						if(j < 0)
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".erase: negative index" << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-						else if(j > size)
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".erase: index out of bounds, vector size: " << size << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-					}
+	if(get_bool(result, params[0]))
+		boolCond = 1;
+	else
+	{
+		condExpr.use_cache(exprCache);
+		if(params[0] != "" && condExpr.compile(params[0]))
+			exprtkCond = 1;
+		else if(replaceVars && vars.find(params[0], vpos))
+				varCond = 1;
+	}
 
-					if(vpos.type == "std::vector<double>")
-					{
-						if(params.size() == 2)
-							vars.layers[vpos.layer].doubVecs[vpos.name].erase(vars.layers[vpos.layer].doubVecs[vpos.name].begin() + i);
-						else
-							vars.layers[vpos.layer].doubVecs[vpos.name].erase(vars.layers[vpos.layer].doubVecs[vpos.name].begin() + i, 
-							                                                  vars.layers[vpos.layer].doubVecs[vpos.name].begin() + j);
-					}
-					else if(vpos.type == "std::vector<string>")
-					{
-						if(params.size() == 2)
-							vars.layers[vpos.layer].strVecs[vpos.name].erase(vars.layers[vpos.layer].strVecs[vpos.name].begin() + i);
-						else
-							vars.layers[vpos.layer].strVecs[vpos.name].erase(vars.layers[vpos.layer].strVecs[vpos.name].begin() + i, 
-							                                                  vars.layers[vpos.layer].strVecs[vpos.name].begin() + j);
-					}
-					else
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".erase: do not recognise the type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-				else
+	while(1)
+	{
+		if(first)
+			first = 0;
+		else
+		{
+			if(addNewLines && addOut)
+			{
+				outStr += eob;
+				if(addIndent)
 				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".erase: no variables named " << quote(params[0]) << std::endl;
-					os_mtx->unlock();
-					return 1;
+					indentAmount = wBaseIndentAmount;
+					outStr += indentAmount;
 				}
-
-				return 0;
+				else
+					indentAmount.add_text(eob);
 			}
-			else
+		}
+
+		if(addScope)
+		{
+			std::string cScope = vars.layers[vars.layers.size()-1].scope;
+			vars.add_layer(cScope);
+			//vars.add_layer(vars.layers[vars.layers.size()-1].scope); //this is broken on windows!
+		}
+
+		int ret_val = 1;
+		if(dwLang == 'n' && segmentedBlock)
+			ret_val = n_read_and_process_fast(addOut, addOut, segmentedBlock->text, segmentedBlock.get(), bLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
+		else if(dwLang == 'n')
+			ret_val = n_read_and_process_fast(addOut, addOut, block, bLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
+		else if(dwLang == 'f')
+			ret_val = f_read_and_process_fast(addOut, block, bLineNo-1, readPath, antiDepsOfReadPath, outStr, eos);
+
+		if(addScope)
+			vars.layers.pop_back();
+
+		if(ret_val == NSM_BREAK)
+			break;
+		else if(ret_val)
+			return ret_val;
+
+		if(boolCond)
+		{
+			if(!result)
+				break;
+		}
+		else if(exprtkCond)
+		{
+			if(!condExpr.evaluate())
+				break;
+		}
+		else if(varCond)
+		{
+			if(!vars.get_bool_from_var(vpos, result))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": function does not exist in this scope" << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot get bool from variable ";
+				eos << quote(vpos.name) << " of type " << quote(vpos.type) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+
+			if(!result)
+				break;
 		}
-		else if(funcName.substr(0, 7) == "stream.")
+		else
 		{
-			std::string streamFnName = funcName.substr(7, funcName.size()-7);
+			parsedCondition = params[0];
 
-			if(streamFnName == "open")
-			{
-				bool memberFn = 0;
+			if(parse_replace('f', parsedCondition, "do-while condition", readPath, antiDepsOfReadPath, conditionLineNo, "do-while(" + params[0] + ")", sLineNo, eos))
+				return 1;
 
-				if(options.size())
-				{
-					for(size_t o=0; o<options.size(); ++o)
-					{
-						if(options[o] == "mf")
-							memberFn = 1;
-					}
-				}
+			if(replaceVars && replace_var(parsedCondition, readPath, conditionLineNo, "do-while", eos))
+				return 1;
 
-				std::string errStr;
-				if(memberFn && params.size())
-					errStr = params[0];
+			if(!get_bool(result, parsedCondition))
+			{
+				if(parsedCondition != "" && condExpr.compile(parsedCondition))
+					result = condExpr.evaluate();
 				else
-					errStr = "std::vector";
-
-				if(params.size() != 2)
 				{
 					if(!consoleLocked)
 						os_mtx->lock();
-					if(memberFn)
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".open: expected 1 parameter, got " << params.size()-1 << std::endl;
-					else
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".open: expected 2 parameters, got " << params.size() << std::endl;
+					start_err(eos, readPath, conditionLineNo) << funcName << ": cannot convert " << quote(parsedCondition) << " to bool" << std::endl;
+					start_err(eos, readPath, sLineNo) << funcName << ": possible errors from exprtk:" << std::endl;
+					print_exprtk_parser_errs(eos, condExpr.errors(), condExpr.expr_str, readPath, sLineNo);
 					os_mtx->unlock();
 					return 1;
 				}
+			}
 
-				VPos vpos;
+			if(!result)
+				break;
+		}
+	}
 
-				if(vars.find(params[0], vpos))
-				{
-					if(vpos.type == "fstream")
-						vars.layers[vpos.layer].fstreams[params[0]].open(params[1]);
-					else if(vpos.type == "ifstream") 
-					{
-						if(dir_exists(params[1]) || !file_exists(params[1]))
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".open: cannot open " << quote(params[1]) << " as file does not exist" << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-						vars.layers[vpos.layer].ifstreams[params[0]].open(params[1]);
-					}
-					else if(vpos.type == "ofstream")
-						vars.layers[vpos.layer].ofstreams[params[0]].open(params[1]);
-					else
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".open: not defined for variable " << quote(params[0]) << " of type " << quote(vpos.type) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".open: no variable named " << quote(params[0]) << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	if(!addOut)
+	{
+		if(linePos < inStr.size() && inStr[linePos] == '!')
+			++linePos;
+		else
+			skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+	}
+
+	return 0;
+}
+
+int Parser::builtin_size(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(replaceVars && replace_var(params[0], readPath, sLineNo, "size", eos))
+		return 1;
+
+	params[0] = std::to_string(params[0].size());
+	outStr += params[0];
+	if(indent)
+		indentAmount.add_text(params[0]);
+
+	return 0;
+}
+
+int Parser::builtin_substr(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	if(replaceVars && replace_var(params[0], readPath, sLineNo, "substr", eos))
+		return 1;
+
+	size_t pos = std::atoi(params[1].c_str()),
+	    length = std::atoi(params[2].c_str());
+	std::string str, oldLine;
+
+	if(!isNonNegInt(params[1]) || pos >= params[0].size())
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "substr: second parameter " << params[1] << " should be a non-negative integer less than the size of the first parameter" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+	else if(!isNonNegInt(params[2]))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "substr: third parameter " << params[2] << " should be a non-negative integer" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	str += params[0].substr(pos, length);
+
+	std::istringstream iss(str);
+	int fileLineNo = 0;
+
+	while(!iss.eof())
+	{
+		getline(iss, str);
+		if(0 < fileLineNo++)
+			add_newline(outStr, indentAmount);
+		outStr += str;
+		oldLine = str;
+	}
+	if(indent)
+		indentAmount.add_text(oldLine);
+
+	return 0;
+}
+
+int Parser::builtin_struct(FnCall& call)
+{
+	const char& lang = call.lang;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	std::string block;
+	char structLang = 'f';
+	bool parseBlock = 0;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "f++")
+				structLang = 'f';
+			else if(options[o] == "n++")
+				structLang = 'n';
+			else if(options[o] == "pb")
+				parseBlock = 1;
+		}
+	}
+
+	//checks whether name exists at current scope
+	VPos vpos;
+	if(vars.find(params[0], vpos))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "struct: cannot have struct and variable/function named " << quote(params[0]) << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+	else if(vars.typeDefs.count(params[0]))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "struct: redeclaration of struct name " << quote(params[0]) << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+	else
+	{
+		vars.typeDefLineNo[params[0]] = lineNo;
 
-				return 0;
-			}
-			else if(streamFnName == "close")
-			{
-				bool memberFn = 0;
+		if(read_block(block, linePos, inStr, readPath, lineNo, vars.typeDefLineNo[params[0]], "struct(" + params[0] + ")", eos))
+			return 1;
 
-				if(options.size())
-				{
-					for(size_t o=0; o<options.size(); ++o)
-					{
-						if(options[o] == "mf")
-							memberFn = 1;
-					}
-				}
+		if(parseBlock && parse_replace(lang, block, "struct block", readPath, antiDepsOfReadPath, vars.typeDefLineNo[params[0]], "struct(" + params[0] + ")", sLineNo, eos))
+			return 1;
 
-				std::string errStr;
-				if(memberFn && params.size())
-					errStr = params[0];
-				else
-					errStr = "std::vector";
+		vars.typeDefs[params[0]] = block;
+		if(structLang == 'n')
+			vars.nTypes.insert(params[0]);
+		vars.typeDefPath[params[0]] = readPath;
+	}
 
-				if(memberFn)
-				{
-					if(params.size() > 1)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".close: expected 0 parameters, got " << params.size()-1 << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-				else if(!params.size())
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".close: expected parameters, got " << params.size() << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-				VPos vpos;
+	return 0;
+}
 
-				for(size_t p=0; p<params.size(); p++)
-				{
-					if(vars.find(params[p], vpos))
-					{
-						if(vpos.type == "fstream")
-							vars.layers[vpos.layer].fstreams[params[p]].close();
-						else if(vpos.type == "ifstream")
-							vars.layers[vpos.layer].ifstreams[params[p]].close();
-						else if(vpos.type == "ofstream")
-							vars.layers[vpos.layer].ofstreams[params[p]].close();
-						else
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".close: not defined for variable " << quote(params[p]) << " of type " << quote(vpos.type) << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-					}
-					else
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".close: no variables named " << quote(params[p]) << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
+int Parser::builtin_vector(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	std::string vectorFnName = funcName.substr(12, funcName.size()-12);
+
+	if(vectorFnName == "push_back")
+	{
+		bool memberFn = 0;
 
-				return 0;
+		if(options.size())
+		{
+			for(size_t o=0; o<options.size(); ++o)
+			{
+				if(options[o] == "mf")
+					memberFn = 1;
 			}
 		}
-		else if(funcName == "script")
+
+		std::string errStr;
+		if(memberFn && params.size())
+			errStr = params[0];
+		else
+			errStr = "std::vector";
+
+		if(params.size() < 2)
+		{
+			if(!params.size())
+				params.push_back("std::vector");
+
+			if(!consoleLocked)
+				os_mtx->lock();
+			if(memberFn)
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".push_back: expected 1+ parameters, got " << params.size()-1 << std::endl;
+			else
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".push_back: expected 2+ parameters, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+
+		VPos vpos;
+
+		if(vars.find(params[0], vpos))
 		{
-			if(params.size() == 0)
+			if(vars.layers[vpos.layer].constants.count(vpos.name))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "script: no path provided" << std::endl;
+				start_err(eos, readPath, lineNo) << errStr << ".push_back: attempted illegal change of constant variable " << quote(params[0]) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
 
-			bool ifExists = 0,
-			     attachContentPath = 0,
-			     makeBackup = 1;
-			bool blockOpt = 0, parseBlock = 0;
-			int bLineNo = lineNo;
-			bool noReturnValue = 0;
-			int console = 0, inject = 0, injectRaw = 0, noOutput = 0;
-			int c = sys_counter++;
-			std::string output_filename = ".@scriptoutput" + std::to_string(c);
-
-			if(options.size())
+			if(memberFn)
 			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "b" || options[o] == "block")
-						blockOpt = 1;
-					else if(options[o] == "pb")
-						parseBlock = 1;
-					if(options[o] == "!bs")
-						makeBackup = 0;
-					else if(options[o] == "if-exists")
-						ifExists = 1;
-					else if(options[o] == "console")
-						console = 1;
-					else if(options[o] == "inject")
-						inject = 1;
-					else if(options[o] == "raw")
-						injectRaw = 1;
-					else if(options[o] == "!o")
-						noOutput = 1;
-					else if(options[o] == "!ret")
-						noReturnValue = 1;
-					else if(options[o] == "content")
-						attachContentPath = 1;
-				}
+				if(params[0] == "options")
+					vpos.name = params[0] = "__options";
+				else if(params[0] == "params")
+					vpos.name = params[0] = "__params";
+				vpos.id = name_id(vpos.name);
 			}
 
-			if(blockOpt)
+			if(vpos.type == "std::vector<double>")
 			{
-				std::string block;
-				if(read_block(block, linePos, inStr, readPath, lineNo, bLineNo, "script{block}", eos))
-					return 1;
-
-				if(parseBlock && parse_replace(lang, block, "script block", readPath, antiDepsOfReadPath, bLineNo, "script{block}", sLineNo, eos))
-					return 1;
-
-				Path scriptPath;
-				scriptPath.set_file_path_from(params[0]);
-				scriptPath.ensureDirExists();
-				std::ofstream ofs(params[0]);
-				ofs << block << std::endl;
-				ofs.close();
-				if(chmod(params[0].c_str(), 0777))
+				for(size_t v=1; v<params.size(); v++)
 				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "script: failed to set executable permissions for " << scriptPath << std::endl;
-					os_mtx->unlock();
-					return 1;
+					if(!isDouble(params[v]))
+					{
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".push_back: value " << quote(params[v]) << " given to push back is not a double" << std::endl;
+						os_mtx->unlock();
+						return 1;
+					}
+					vars.layers[vpos.layer].doubVecs[params[0] ].push_back(std::strtod(params[v].c_str(), NULL));
 				}
 			}
-
-			if(params.size() > 1)
+			else if(vpos.type == "std::vector<string>")
 			{
-				params[1] = quote(params[1]);
-				for(size_t i=2; i<params.size(); i++)
-					params[1] += " " + quote(params[i]);
+				for(size_t v=1; v<params.size(); v++)
+					vars.layers[vpos.layer].strVecs[params[0] ].push_back(params[v]);
 			}
-			else if(params.size() == 1)
-				params.push_back("");
-
-			size_t pos = params[0].substr(1, params[0].size()-1).find_last_of('.');
-			std::string cScriptExt = "";
-			if(pos != std::string::npos)
-				cScriptExt = params[0].substr(pos+1, params[0].size()-pos-1);
-			std::string execPath = "./.script" + std::to_string(c) + cScriptExt;
-			std::string exec_str;
-
-			if(console + inject + injectRaw + noOutput > 1)
+			else
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "script(" << quote(execPath) << "): console and raw options are incompatible with each other" << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".push_back: do not recognise the type " << quote(vpos.type) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
-			else if(!(console + inject + injectRaw + noOutput))
-			{
-				if(lang == 'n')
-					inject = 1;
-				else
-					console = 1;
-			}
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".push_back: no variables named " << quote(params[0]) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
+		return 0;
+	}
+	else if(vectorFnName == "size")
+	{
+		bool memberFn = 0;
 
-			if(attachContentPath)
+		if(options.size())
+		{
+			for(size_t o=0; o<options.size(); ++o)
 			{
-				contentAdded = 1;
-				params[1] = quote(toBuild.contentPath.str()) + " " + params[1];
+				if(options[o] == "mf")
+					memberFn = 1;
 			}
+		}
 
-			#if defined _WIN32 || defined _WIN64
-				if(unquote(execPath).substr(0, 2) == "./")
-					execPath = unquote(execPath).substr(2, unquote(execPath).size()-2);
-			#else  //*nix
-			#endif
+		std::string errStr;
+		if(memberFn && params.size())
+			errStr = params[0];
+		else
+			errStr = "std::vector";
 
-			Path scriptPath;
-			scriptPath.set_file_path_from(params[0]);
-			if(scriptPath == toBuild.contentPath)
-				contentAdded = 1;
+		if(params.size() != 1)
+		{
+			if(!params.size())
+				params.push_back("std::vector");
+
+			if(!consoleLocked)
+				os_mtx->lock();
+			if(memberFn)
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".size: expected 0 parameters, got " << params.size()-1 << std::endl;
+			else
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".size: expected 1 parameter, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			if(incrMode != INCR_MOD)
+		VPos vpos;
+
+		if(vars.find(params[0], vpos))
+		{
+			if(memberFn)
 			{
-				checked_hash_mtx.lock();
-				if(!checkedHashFile.count(scriptPath))
-				{
-					checkedHashFile.insert(scriptPath);
-					checked_hash_mtx.unlock();
-					Path hashPath = scriptPath.getHashPath();
-					std::string hashPathStr = hashPath.str();
-					unsigned int hash = FNVHash(string_from_file(scriptPath.str()));
-					if(!file_exists(hashPathStr) || 
-					   (unsigned) std::atoi(string_from_file(hashPathStr).c_str()) != hash)
-					{
-						hashPath.ensureDirExists();
-						std::ofstream ofs(hashPathStr);
-						ofs << hash << "\n";
-						ofs.close();
-					}
-				}
-				else
-					checked_hash_mtx.unlock();
+				if(params[0] == "options")
+					vpos.name = params[0] = "__options";
+				else if(params[0] == "params")
+					vpos.name = params[0] = "__params";
+				vpos.id = name_id(vpos.name);
 			}
-			depFiles.insert(scriptPath);
 
-			if(file_exists(params[0]))
+			if(vpos.type == "std::vector<double>")
 			{
-				//copies script to backup location
-				if(makeBackup)
-				{
-					if(cpFile(params[0], params[0] + ".backup", sLineNo, readPath, eos, consoleLocked, os_mtx))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "script: failed to copy " << quote(params[0]) << " to " << quote(params[0] + ".backup") << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-				}
-
-				//moves script to main directory
-				//note if just copy original script or move copied script get 'Text File Busy' errors (can be quite rare)
-				//sometimes this fails (on Windows) for some reason, so keeps trying until successful
-				int mcount = 0;
-				while(rename(params[0].c_str(), execPath.c_str()))
-				{
-					if(++mcount == 100)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_warn(eos, readPath, lineNo) << "script: have tried to move " << quote(params[0]) << " to " << quote(execPath) << " 100 times already, may need to abort" << std::endl;
-						start_warn(eos) << "you may need to move " << quote(execPath) << " back to " << quote(params[0]) << std::endl;
-						if(!consoleLocked)
-							os_mtx->unlock();
-					}
-				}
-
-				int result;
-				if(file_exists("/.flatpak-info"))
-					exec_str = "flatpak-spawn --host bash -c " + quote(execPath + " " + params[1]);
-				else
-					exec_str = execPath + " " + params[1];
-
-				if(console)
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-				}
-				else
-					exec_str += " > " + output_filename;
-
-				result = system(exec_str.c_str());
-
-				if(console && !consoleLocked)
-					os_mtx->unlock();
-
-				//moves script back to original location
-				//sometimes this fails (on Windows) for some reason, so keeps trying until successful
-				mcount = 0;
-				while(rename(execPath.c_str(), params[0].c_str()))
-				{
-					if(++mcount == 100)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_warn(eos, readPath, lineNo) << "script: have tried to move " << execPath << " to " << params[0] << " 100 times already, may need to abort" << std::endl;
-						start_warn(eos) << "you may need to move " << quote(execPath) << " back to " << quote(params[0]) << std::endl;
-						if(!consoleLocked)
-							os_mtx->unlock();
-					}
-				}
-
-				//deletes backup copy
-				if(makeBackup)
-					remove_file(Path("", params[0] + ".backup"));
-
-				if(console)
-				{
-					if(result)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "script{console}(" << quote(params[0]) << ") failed" << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-
-					if(mode != MODE_INTERP && !noReturnValue) //check this
-					{
-						std::string resultStr = std::to_string(result);
-						outStr += resultStr;
-						if(indent)
-							outStr += into_whitespace(resultStr);
-					}
-				}
-				else if(noOutput)
-				{
-					if(result)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "script{!o}(" << quote(params[0]) << ") failed, ";
-						eos << "see " << quote(output_filename) << " for pre-error script output" << std::endl;
-						os_mtx->unlock();
-						//remove_file(Path("./", output_filename));
-						return 1;
-					}
-
-					if(!noReturnValue)
-					{
-						std::string resultStr = std::to_string(result);
-						outStr += resultStr;
-						if(indent)
-							outStr += into_whitespace(resultStr);
-					}
-
-					remove_file(Path("./", output_filename));
-				}
-				else if(injectRaw)
-				{
-					if(result)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "script{raw}(" << quote(params[0]) << ") failed, ";
-						eos << "see " << quote(output_filename) << " for pre-error script output" << std::endl;
-						os_mtx->unlock();
-						//remove_file(Path("./", output_filename));
-						return 1;
-					}
-
-					std::ifstream ifs(output_filename);
-					std::string fileLine, oldLine;
-					int fileLineNo = 0;
-
-					while(!ifs.eof())
-					{
-						getline(ifs, fileLine);
-						if(0 < fileLineNo++)
-							outStr += "\n" + indentAmount;
-						oldLine = fileLine;
-						outStr += fileLine;
-					}
-					if(indent)
-						indentAmount += into_whitespace(oldLine);
-
-					ifs.close();
+				std::string sizeStr = std::to_string(value_of(vars.layers[vpos.layer].doubVecs, vpos).size());
+				outStr += sizeStr;
+				if(indent)
+					indentAmount.add_text(sizeStr);
+			}
+			else if(vpos.type == "std::vector<string>")
+			{
+				std::string sizeStr = std::to_string(value_of(vars.layers[vpos.layer].strVecs, vpos).size());
+				outStr += sizeStr;
+				if(indent)
+					indentAmount.add_text(sizeStr);
+			}
+			else
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".size: do not recognise the type " << quote(vpos.type) << std::endl;
+				os_mtx->unlock();
+				return 1;
+			}
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".size: no variables named " << quote(params[0]) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-					remove_file(Path("./", output_filename));
-				}
-				else //inject
-				{
-					if(result)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "script{inject}(" << quote(params[0]) << ") failed, ";
-						eos << "see " << quote(output_filename) << " for pre-error script output" << std::endl;
-						os_mtx->unlock();
-						//remove_file(Path("./", output_filename));
-						return 1;
-					}
+		return 0;
+	}
+	else if(vectorFnName == "at")
+	{
+		bool memberFn = 0;
 
-					std::string fileStr = string_from_file(output_filename);
+		if(options.size())
+		{
+			for(size_t o=0; o<options.size(); ++o)
+			{
+				if(options[o] == "mf")
+					memberFn = 1;
+			}
+		}
 
-					//indent amount updated inside read_and_process
-					if(n_read_and_process(1, fileStr, 0, Path("", scriptPath.str() + " output - " + output_filename), antiDepsOfReadPath, outStr, eos) > 0)
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "script: failed to process output of script " << quote(params[0] + " " + params[1]) << std::endl;
-						os_mtx->unlock();
-						//remove_file(Path("./", output_filename));
-						return 1;
-					}
+		std::string errStr;
+		if(memberFn && params.size())
+			errStr = params[0];
+		else
+			errStr = "std::vector";
 
-					remove_file(Path("./", output_filename));
-				}
-			}
-			else if(ifExists)
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+		if(params.size() != 2)
+		{
+			if(!params.size())
+				params.push_back("std::vector");
+
+			if(!consoleLocked)
+				os_mtx->lock();
+			if(memberFn)
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".at: expected 1 parameter, got " << params.size()-1 << std::endl;
 			else
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".at: expected 2 parameters, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+
+		bool round = 1;
+
+		if(options.size())
+		{
+			for(size_t o=0; o<options.size(); ++o)
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "script(" << quote(params[0]) << ") failed as script " << quote(params[0]) << " does not exist" << std::endl;
-				os_mtx->unlock();
-				return 1;
+				if(options[o] == "!round")
+					round = 0;
 			}
-
-			return 0;
 		}
-		else if(funcName == "system" || funcName == "sys")
+
+		VPos vpos;
+
+		if(vars.find(params[0], vpos))
 		{
-			if(params.size() > 1)
+			int i = std::atoi(params[1].c_str());
+
+			if(i < 0)
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 0-1 parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".at(" << i << "): negative index" << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
 
-			int console = 0, inject = 0, injectRaw = 0, noOutput = 0;
-			int bLineNo = lineNo;
-			bool parseBlock = 0;
-			bool attachContentPath = 0;
-			bool noReturnValue = 0;
-
-			if(options.size())
+			if(memberFn)
 			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "pb")
-						parseBlock = 1;
-					else if(options[o] == "console")
-						console = 1;
-					else if(options[o] == "inject" || options[o] == "inj")
-						inject = 1;
-					else if(options[o] == "raw")
-						injectRaw = 1;
-					else if(options[o] == "!o")
-						noOutput = 1;
-					else if(options[o] == "!ret")
-						noReturnValue = 1;
-					else if(options[o] == "content")
-						attachContentPath = 1;
-				}
+				if(params[0] == "options")
+					vpos.name = params[0] = "__options";
+				else if(params[0] == "params")
+					vpos.name = params[0] = "__params";
+				vpos.id = name_id(vpos.name);
 			}
 
-			if(params.size() == 0)
+			if(vpos.type == "std::vector<double>")
 			{
-				params.push_back("");
-				if(read_block(params[0], linePos, inStr, readPath, lineNo, bLineNo, "system{block}", eos))
-					return 1;
-
-				if(parseBlock && parse_replace(lang, params[0], funcName + " block", readPath, antiDepsOfReadPath, bLineNo, funcName + "{block}", sLineNo, eos))
+				int size = value_of(vars.layers[vpos.layer].doubVecs, vpos).size();
+				if(i >= size)
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".at(" << i << "): index out of bounds, vector size: " << size << std::endl;
+					os_mtx->unlock();
 					return 1;
+				}
+				std::string valueStr = vars.double_to_string(value_of(vars.layers[vpos.layer].doubVecs, vpos)[i], round);
+				outStr += valueStr;
+				if(indent)
+					indentAmount.add_text(valueStr);
 			}
-
-			std::string sys_call = params[0];
-			std::string exec_str;
-			std::string output_filename = ".@systemoutput" + std::to_string(sys_counter++);
-
-			#if defined _WIN32 || defined _WIN64
-				if(unquote(sys_call).substr(0, 2) == "./")
-					sys_call = unquote(sys_call).substr(2, unquote(sys_call).size()-2);
-			#else  //*nix
-			#endif
-
-			if(attachContentPath)
+			else if(vpos.type == "std::vector<string>")
 			{
-				contentAdded = 1;
-				sys_call += " " + quote(toBuild.contentPath.str());
+				int size = value_of(vars.layers[vpos.layer].strVecs, vpos).size();
+				if(i >= size)
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".at(" << i << "): index out of bounds, vector size: " << size << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
+				std::string valueStr = value_of(vars.layers[vpos.layer].strVecs, vpos)[i];
+				outStr += valueStr;
+				if(indent)
+					indentAmount.add_text(valueStr);
 			}
-
-			if(console + inject + injectRaw + noOutput > 1)
+			else
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << "(" << quote(sys_call) << "): console, inject, raw and !o options are incompatible with each other" << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".at: do not recognise the type " << quote(vpos.type) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
-			else if(!(console + inject + injectRaw + noOutput))
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".at: no variables named " << quote(params[0]) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+
+		return 0;
+	}
+	else if(vectorFnName == "set")
+	{
+		bool memberFn = 0;
+
+		if(options.size())
+		{
+			for(size_t o=0; o<options.size(); ++o)
 			{
-				if(lang == 'n')
-					inject = 1;
-				else
-					console = 1;
+				if(options[o] == "mf")
+					memberFn = 1;
 			}
+		}
 
-			//checks whether we're running from flatpak
-			int result;
-			if(file_exists("/.flatpak-info"))
-				exec_str = "flatpak-spawn --host bash -c " + quote(sys_call);
+		std::string errStr;
+		if(memberFn && params.size())
+			errStr = params[0];
+		else
+			errStr = "std::vector";
+
+		if(params.size() != 3)
+		{
+			if(!params.size())
+				params.push_back("std::vector");
+
+			if(!consoleLocked)
+				os_mtx->lock();
+			if(memberFn)
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set: expected 2 parameters, got " << params.size()-1 << std::endl;
 			else
-				exec_str = sys_call;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set: expected 3 parameters, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			if(console)
+		VPos vpos;
+
+		if(vars.find(params[0], vpos))
+		{
+			if(vars.layers[vpos.layer].constants.count(vpos.name))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-
-				if(lolcatActive)
-				{
-					for(size_t i=0; i<exec_str.size(); ++i)
-					{
-						size_t pos = exec_str.find_first_of(";\n", i);
-						std::string lineStr = exec_str.substr(i, pos-i);
-						i = pos;
-
-						if(i == std::string::npos)
-						{
-							lineStr = exec_str;
-							strip_trailing_whitespace_multiline(lineStr);
-							if(!is_whitespace(lineStr) && lineStr[lineStr.size()-1] != ';')
-								exec_str += " | " + lolcatCmd;
-							break;
-						}
-						else
-						{
-							if(!is_whitespace(lineStr))
-							{
-								exec_str.replace(i, 1, " | " + lolcatCmd + exec_str[i]);
-								i += 3 + lolcatCmd.size();
-							}
-						}
-					}
-				}
+				start_err(eos, readPath, lineNo) << errStr << ".set: attempted illegal change of constant variable " << quote(params[0]) << std::endl;
+				os_mtx->unlock();
+				return 1;
 			}
-			else
-				exec_str += " > " + output_filename;
 
-			result = system(exec_str.c_str());
+			int i = std::atoi(params[1].c_str());
 
-			if(console && !consoleLocked)
+			if(i < 0)
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set(" << i << "): negative index" << std::endl;
 				os_mtx->unlock();
+				return 1;
+			}
 
-			if(console)
+			if(memberFn)
 			{
-				if(result)
+				if(params[0] == "options")
+					vpos.name = params[0] = "__options";
+				else if(params[0] == "params")
+					vpos.name = params[0] = "__params";
+				vpos.id = name_id(vpos.name);
+			}
+
+			if(vpos.type == "std::vector<double>")
+			{
+				int size = value_of(vars.layers[vpos.layer].doubVecs, vpos).size();
+			
+				if(i >= size)
 				{
 					if(!consoleLocked)
 						os_mtx->lock();
-					if(mode == MODE_INTERP || mode == MODE_SHELL)
-						std::cout << "\a" << std::flush;
-					else
-						start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << "{console}(" << quote(sys_call) << ") failed" << std::endl;
+					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set(" << i << "): index out of bounds, vector size: " << size << std::endl;
 					os_mtx->unlock();
 					return 1;
 				}
-
-				if(mode != MODE_INTERP && !noReturnValue) //check this
-				{
-					std::string resultStr = std::to_string(result);
-					outStr += resultStr;
-					if(indent)
-						outStr += into_whitespace(resultStr);
-				}
-			}
-			else if(noOutput)
-			{
-				if(result)
+				else if(!isDouble(params[2]))
 				{
 					if(!consoleLocked)
 						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << "{!o}(" << quote(sys_call) << ") failed, ";
-					eos << "see " << quote(output_filename) << " for pre-error system output" << std::endl;
+					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set(" << i << "): value given is not a double" << std::endl;
+					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set(" << i << "): value given = " << quote(params[2]) << std::endl;
 					os_mtx->unlock();
-					//remove_file(Path("./", output_filename));
 					return 1;
 				}
 
-				if(!noReturnValue)
-				{
-					std::string resultStr = std::to_string(result);
-					outStr += resultStr;
-					if(indent)
-						outStr += into_whitespace(resultStr);
-				}
-
-				remove_file(Path("./", output_filename));
+				value_of(vars.layers[vpos.layer].doubVecs, vpos)[i] = std::strtod(params[2].c_str(), NULL);
 			}
-			else if(injectRaw)
+			else if(vpos.type == "std::vector<string>")
 			{
-				if(result)
+				int size = value_of(vars.layers[vpos.layer].strVecs, vpos).size();
+			
+				if(i >= size)
 				{
 					if(!consoleLocked)
 						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << "{raw}(" << quote(sys_call) << ") failed, ";
-					eos << "see " << quote(output_filename) << " for pre-error system output" << std::endl;
+					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set(" << i << "): index out of bounds, vector size: " << size << std::endl;
 					os_mtx->unlock();
-					//remove_file(Path("./", output_filename));
 					return 1;
 				}
 
-				std::ifstream ifs(output_filename);
-				std::string fileLine, oldLine;
-				int fileLineNo = 0;
+				value_of(vars.layers[vpos.layer].strVecs, vpos)[i] = params[2];
+			}
+			else
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set: do not recognise the type " << quote(vpos.type) << std::endl;
+				os_mtx->unlock();
+				return 1;
+			}
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".set: no variables named " << quote(params[0]) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+
+		return 0;
+	}
+	else if(vectorFnName == "pop_back")
+	{
+		bool memberFn = 0;
 
-				while(!ifs.eof())
-				{
-					getline(ifs, fileLine);
-					if(0 < fileLineNo++)
-						outStr += "\n" + indentAmount;
-					oldLine = fileLine;
-					outStr += fileLine;
-				}
-				if(indent)
-					indentAmount += into_whitespace(oldLine);
+		if(options.size())
+		{
+			for(size_t o=0; o<options.size(); ++o)
+			{
+				if(options[o] == "mf")
+					memberFn = 1;
+			}
+		}
+
+		std::string errStr;
+		if(memberFn && params.size())
+			errStr = params[0];
+		else
+			errStr = "std::vector";
+
+		if(params.size() != 1)
+		{
+			if(!params.size())
+				params.push_back("std::vector");
+
+			if(!consoleLocked)
+				os_mtx->lock();
+			if(memberFn)
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".pop_back: expected 0 parameters, got " << params.size()-1 << std::endl;
+			else
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".pop_back: expected 1 parameter, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+
+		VPos vpos;
+
+		if(vars.find(params[0], vpos))
+		{
+			if(vars.layers[vpos.layer].constants.count(vpos.name))
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err(eos, readPath, lineNo) << errStr << ".pop_back: attempted illegal change of constant variable " << quote(params[0]) << std::endl;
+				os_mtx->unlock();
+				return 1;
+			}
+
+			if(memberFn)
+			{
+				if(params[0] == "options")
+					vpos.name = params[0] = "__options";
+				else if(params[0] == "params")
+					vpos.name = params[0] = "__params";
+				vpos.id = name_id(vpos.name);
+			}
+
+			if(vpos.type == "std::vector<double>")
+				value_of(vars.layers[vpos.layer].doubVecs, vpos).pop_back();
+			else if(vpos.type == "std::vector<string>")
+				value_of(vars.layers[vpos.layer].strVecs, vpos).pop_back();
+			else
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".pop_back: do not recognise the type " << quote(vpos.type) << std::endl;
+				os_mtx->unlock();
+				return 1;
+			}
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".pop_back: no variables named " << quote(params[0]) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+
+		return 0;
+	}
+	else if(vectorFnName == "erase")
+	{
+		bool memberFn = 0;
+
+		if(options.size())
+		{
+			for(size_t o=0; o<options.size(); ++o)
+			{
+				if(options[o] == "mf")
+					memberFn = 1;
+			}
+		}
+
+		std::string errStr;
+		if(memberFn && params.size())
+			errStr = params[0];
+		else
+			errStr = "std::vector";
+
+		if(params.size() != 2 && params.size() != 3)
+		{
+			if(!params.size())
+				params.push_back("std::vector");
+
+			if(!consoleLocked)
+				os_mtx->lock();
+			if(memberFn)
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".erase: expected 1-2 parameters, got " << params.size()-1 << std::endl;
+			else   
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".erase: expected 2-3 parameters, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+
+		VPos vpos;
+
+		if(vars.find(params[0], vpos))
+		{
+			if(vars.layers[vpos.layer].constants.count(vpos.name))
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err(eos, readPath, lineNo) << errStr << ".erase: attempted illegal change of constant variable " << quote(params[0]) << std::endl;
+				os_mtx->unlock();
+				return 1;
+			}
 
-				ifs.close();
+			if(memberFn)
+			{
+				if(params[0] == "options")
+					vpos.name = params[0] = "__options";
+				else if(params[0] == "params")
+					vpos.name = params[0] = "__params";
+				vpos.id = name_id(vpos.name);
+			}
 
-				remove_file(Path("./", output_filename));
+			int i = std::atoi(params[1].c_str()), j = 0;
+			int size = value_of(vars.layers[vpos.layer].doubVecs, vpos).size();
+
+			if(i < 0)
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".erase: negative index" << std::endl;
+				os_mtx->unlock();
+				return 1;
 			}
-			else //inject
+			else if(i >= size)
 			{
-				if(result)
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".erase: index out of bounds, vector size: " << size << std::endl;
+				os_mtx->unlock();
+				return 1;
+			}
+
+			if(params.size() > 2)
+			{
+				j = std::atoi(params[2].c_str());
+
+				if(j < 0)
 				{
 					if(!consoleLocked)
 						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << "{inject}(" << quote(sys_call) << ") failed, ";
-					eos << "see " << quote(output_filename) << " for pre-error system output" << std::endl;
+					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".erase: negative index" << std::endl;
 					os_mtx->unlock();
-					//remove_file(Path("./", output_filename));
 					return 1;
 				}
-
-				std::string fileStr = string_from_file(output_filename);
-
-				//indent amount updated inside read_and_process
-				if(n_read_and_process(1, fileStr, 0, Path("", sys_call + " - " + output_filename), antiDepsOfReadPath, outStr, eos) > 0)
+				else if(j > size)
 				{
 					if(!consoleLocked)
 						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to process output of system call " << quote(sys_call) << std::endl;
+					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".erase: index out of bounds, vector size: " << size << std::endl;
 					os_mtx->unlock();
-					//remove_file(Path("./", output_filename));
 					return 1;
 				}
-
-				remove_file(Path("./", output_filename));
 			}
 
-			return 0;
-		}
-		else if(funcName == "scope")
-		{
-			if(params.size() && params.size() != 1)
+			if(vpos.type == "std::vector<double>")
+			{
+				if(params.size() == 2)
+					value_of(vars.layers[vpos.layer].doubVecs, vpos).erase(value_of(vars.layers[vpos.layer].doubVecs, vpos).begin() + i);
+				else
+					value_of(vars.layers[vpos.layer].doubVecs, vpos).erase(value_of(vars.layers[vpos.layer].doubVecs, vpos).begin() + i, 
+					                                                  value_of(vars.layers[vpos.layer].doubVecs, vpos).begin() + j);
+			}
+			else if(vpos.type == "std::vector<string>")
+			{
+				if(params.size() == 2)
+					value_of(vars.layers[vpos.layer].strVecs, vpos).erase(value_of(vars.layers[vpos.layer].strVecs, vpos).begin() + i);
+				else
+					value_of(vars.layers[vpos.layer].strVecs, vpos).erase(value_of(vars.layers[vpos.layer].strVecs, vpos).begin() + i, 
+					                                                  value_of(vars.layers[vpos.layer].strVecs, vpos).begin() + j);
+			}
+			else
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "scope: expected 0-1 parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".erase: do not recognise the type " << quote(vpos.type) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".erase: no variables named " << quote(params[0]) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+
+		return 0;
+	}
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": function does not exist in this scope" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-			bool inScopes = 0;
+	return NSM_NOT_BUILTIN;
+}
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "in")
-						inScopes = 1;
-				}
-			}
+int Parser::builtin_stream(FnCall& call)
+{
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	std::string streamFnName = funcName.substr(7, funcName.size()-7);
 
-			if(params.size() == 0)
+	if(streamFnName == "open")
+	{
+		bool memberFn = 0;
+
+		if(options.size())
+		{
+			for(size_t o=0; o<options.size(); ++o)
 			{
-				outStr += vars.layers[vars.layers.size()-1].scope;
-				if(indent)
-					indentAmount += into_whitespace(vars.layers[vars.layers.size()-1].scope);
+				if(options[o] == "mf")
+					memberFn = 1;
 			}
-			else if(params.size() == 1)
-			{
-				VPos vpos;
+		}
 
-				if(vars.find(params[0], vpos))
-				{
-					if(inScopes)
-					{
-						std::string inScopesStr = "{";
-						if(vars.layers[vpos.layer].inScopes[params[0]].size())
-						{
-							auto it = vars.layers[vpos.layer].inScopes[params[0]].begin();
-							inScopesStr += *it++;
-							while(it != vars.layers[vpos.layer].inScopes[params[0]].end())
-								inScopesStr += "; " + *it++;
-						}
-						inScopesStr += "}";
-						outStr += inScopesStr;
-						if(indent)
-							indentAmount += into_whitespace(inScopesStr);
-					}
-					else
-					{
-						outStr += vars.layers[vpos.layer].scopeOf[params[0]];
-						if(indent)
-							indentAmount += into_whitespace(vars.layers[vpos.layer].scopeOf[params[0]]);
-					}
-				}
-				else
+		std::string errStr;
+		if(memberFn && params.size())
+			errStr = params[0];
+		else
+			errStr = "std::vector";
+
+		if(params.size() != 2)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			if(memberFn)
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".open: expected 1 parameter, got " << params.size()-1 << std::endl;
+			else
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".open: expected 2 parameters, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+
+		VPos vpos;
+
+		if(vars.find(params[0], vpos))
+		{
+			if(vpos.type == "fstream")
+				vars.layers[vpos.layer].fstreams[params[0]].open(params[1]);
+			else if(vpos.type == "ifstream") 
+			{
+				if(dir_exists(params[1]) || !file_exists(params[1]))
 				{
 					if(!consoleLocked)
 						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "scope: no variables/functions named " << params[0] << std::endl;
+					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".open: cannot open " << quote(params[1]) << " as file does not exist" << std::endl;
 					os_mtx->unlock();
 					return 1;
 				}
+				vars.layers[vpos.layer].ifstreams[params[0]].open(params[1]);
 			}
-
-			return 0;
-		}
-	}
-	else if(funcName[0] == 'q')
-	{
-		if(funcName == "quote")
-		{
-			if(params.size() != 1)
+			else if(vpos.type == "ofstream")
+				vars.layers[vpos.layer].ofstreams[params[0]].open(params[1]);
+			else
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "quote: expected 1 parameter, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".open: not defined for variable " << quote(params[0]) << " of type " << quote(vpos.type) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+		}
+		else
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".open: no variable named " << quote(params[0]) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			std::string str;
+		return 0;
+	}
+	else if(streamFnName == "close")
+	{
+		bool memberFn = 0;
 
-			if(replaceVars && replace_var(params[0], readPath, sLineNo, "quote", eos))
-				return 1;
+		if(options.size())
+		{
+			for(size_t o=0; o<options.size(); ++o)
+			{
+				if(options[o] == "mf")
+					memberFn = 1;
+			}
+		}
 
-			params[0] = quote(params[0]);
-			outStr += params[0];
-			if(indent)
-				indentAmount += into_whitespace(params[0]);
+		std::string errStr;
+		if(memberFn && params.size())
+			errStr = params[0];
+		else
+			errStr = "std::vector";
 
-			return 0;
-		}
-		else if(funcName == "quit")
+		if(memberFn)
 		{
-			if(params.size() != 0)
+			if(params.size() > 1)
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "quit: expected 0 parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".close: expected 0 parameters, got " << params.size()-1 << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
-
-			return NSM_QUIT; //check this??
 		}
-	}
-	else if(funcName[0] == 'u')
-	{
-		if(funcName == "unquote")
+		else if(!params.size())
 		{
-			if(params.size() != 1)
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".close: expected parameters, got " << params.size() << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+
+		VPos vpos;
+
+		for(size_t p=0; p<params.size(); p++)
+		{
+			if(vars.find(params[p], vpos))
+			{
+				if(vpos.type == "fstream")
+					vars.layers[vpos.layer].fstreams[params[p]].close();
+				else if(vpos.type == "ifstream")
+					vars.layers[vpos.layer].ifstreams[params[p]].close();
+				else if(vpos.type == "ofstream")
+					vars.layers[vpos.layer].ofstreams[params[p]].close();
+				else
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".close: not defined for variable " << quote(params[p]) << " of type " << quote(vpos.type) << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
+			}
+			else
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "unquote: expected 1 parameter, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << errStr << ".close: no variables named " << quote(params[p]) << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+		}
 
-			std::string str;
-
-			if(replaceVars && replace_var(params[0], readPath, sLineNo, "unquote", eos))
-				return 1;
+		return 0;
+	}
 
-			params[0] = unquote(params[0]);
-			outStr += params[0];
-			if(indent)
-				indentAmount += into_whitespace(params[0]);
+	return NSM_NOT_BUILTIN;
+}
 
-			return 0;
-		}
+int Parser::builtin_script(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const char& lang = call.lang;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size() == 0)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "script: no path provided" << std::endl;
+		os_mtx->unlock();
+		return 1;
 	}
-	else if(funcName[0] == 'm')
+
+	bool ifExists = 0,
+	     attachContentPath = 0,
+	     makeBackup = 1;
+	bool blockOpt = 0, parseBlock = 0;
+	int bLineNo = lineNo;
+	bool noReturnValue = 0;
+	bool cache = 0;
+	std::vector<std::string> cacheInputs, cacheEnvVars;
+	int console = 0, inject = 0, injectRaw = 0, noOutput = 0;
+	int c = sys_counter++;
+	std::string output_filename = ".@scriptoutput" + std::to_string(c);
+
+	if(options.size())
 	{
-		if(funcName == "mve")
+		for(size_t o=0; o<options.size(); o++)
 		{
-			if(params.size() < 2)
-			{
-				if(read_sh_params(params, ' ', linePos, inStr, readPath, lineNo, funcName, eos))
-					return 1;
-			}
+			if(options[o] == "b" || options[o] == "block")
+				blockOpt = 1;
+			else if(options[o] == "pb")
+				parseBlock = 1;
+			if(options[o] == "!bs")
+				makeBackup = 0;
+			else if(options[o] == "if-exists")
+				ifExists = 1;
+			else if(options[o] == "console")
+				console = 1;
+			else if(options[o] == "inject")
+				inject = 1;
+			else if(options[o] == "raw")
+				injectRaw = 1;
+			else if(options[o] == "!o")
+				noOutput = 1;
+			else if(options[o] == "!ret")
+				noReturnValue = 1;
+			else if(options[o] == "content")
+				attachContentPath = 1;
+			else if(options[o] == "cache")
+				cache = 1;
+			else if(options[o].substr(0, 3) == "in=")
+				cacheInputs.push_back(unquote(options[o].substr(3, options[o].size()-3)));
+			else if(options[o].substr(0, 4) == "env=")
+				cacheEnvVars.push_back(unquote(options[o].substr(4, options[o].size()-4)));
+		}
+	}
 
-			if(params.size() < 2)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 2+ parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+	if(blockOpt)
+	{
+		std::string block;
+		if(read_block(block, linePos, inStr, readPath, lineNo, bLineNo, "script{block}", eos))
+			return 1;
 
-			bool backupFiles = 0,
-			     forceFile = 0,
-			     ifNew = 0,
-			     overwrite = 1,
-			     changePermissions = 0, 
-			     prompt = 0,
-			     verbose = 0;
+		if(parseBlock && parse_replace(lang, block, "script block", readPath, antiDepsOfReadPath, bLineNo, "script{block}", sLineNo, eos))
+			return 1;
 
-			if(options.size())
-			{
-				for(size_t o=0; o<options.size(); ++o)
-				{
-					if(options[o] == "b")
-						backupFiles = 1;
-					else if(options[o] == "f")
-						changePermissions = 1;
-					else if(options[o] == "i")
-						prompt = 1;
-					else if(options[o] == "n")
-						overwrite = 0;
-					else if(options[o] == "T")
-						forceFile = 1;
-					else if(options[o] == "u")
-						ifNew = 1;
-					else if(options[o] == "v")
-						verbose = 1;
-				}
-			}
+		Path scriptPath;
+		scriptPath.set_file_path_from(params[0]);
+		scriptPath.ensureDirExists();
+		std::ofstream ofs(params[0]);
+		ofs << block << std::endl;
+		ofs.close();
+		if(chmod(params[0].c_str(), 0777))
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "script: failed to set executable permissions for " << scriptPath << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-			size_t t = params.size()-1;
-			Path source, target;
-			std::string sourceStr, 
-			            targetStr = replace_home_dir(params[t]),
-			            targetParam = params[t];
-			char promptInput = 'n';
+	if(params.size() > 1)
+	{
+		params[1] = quote(params[1]);
+		for(size_t i=2; i<params.size(); i++)
+			params[1] += " " + quote(params[i]);
+	}
+	else if(params.size() == 1)
+		params.push_back("");
 
-			params.pop_back();
+	size_t pos = params[0].substr(1, params[0].size()-1).find_last_of('.');
+	std::string cScriptExt = "";
+	if(pos != std::string::npos)
+		cScriptExt = params[0].substr(pos+1, params[0].size()-pos-1);
+	std::string execPath = "./.script" + std::to_string(c) + cScriptExt;
+	std::string exec_str;
 
-			if(params.size() == 1 && 
-			    (forceFile || !dir_exists(targetStr)) && 
-			    params[0].find_first_of('*') == std::string::npos)
-			{
-				if(params[0].size() && (params[0][params[0].size()-1] == '/' || params[0][params[0].size()-1] == '\\'))
-				{
-					int pos=params[0].size()-2;
-					while(pos>=0 && (params[0][pos] == '/' || params[0][pos] == '\\'))
-						--pos;
-					params[0] = params[0].substr(0, pos+1);
-				}
+	if(console + inject + injectRaw + noOutput > 1)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "script(" << quote(execPath) << "): console and raw options are incompatible with each other" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+	else if(!(console + inject + injectRaw + noOutput))
+	{
+		if(lang == 'n')
+			inject = 1;
+		else
+			console = 1;
+	}
 
-				sourceStr = replace_home_dir(params[0]);
-				source.set_file_path_from(sourceStr);
-				target.set_file_path_from(targetStr);
 
-				if(!path_exists(sourceStr))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot move ";
-					eos << quote(params[0]) << " as path does not exist" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
+	if(attachContentPath)
+	{
+		contentAdded = 1;
+		params[1] = quote(toBuild.contentPath.str()) + " " + params[1];
+	}
 
-				if(overwrite || !file_exists(targetStr))
-				{
-					if(!ifNew || source.modified_after(target))
-					{
-						if(changePermissions)
-						{
-							if(file_exists(targetStr))
-								chmod(targetStr.c_str(), 0666);
-							else if(dir_exists(targetStr))
-								chmod(targetStr.c_str(), S_IRWXU);
-						}
+	#if defined _WIN32 || defined _WIN64
+		if(unquote(execPath).substr(0, 2) == "./")
+			execPath = unquote(execPath).substr(2, unquote(execPath).size()-2);
+	#else  //*nix
+	#endif
 
-						if((prompt && promptInput != 'a') || verbose)
-						{
-							eos << quote(params[0]) << " -> " << quote(params[1]) << std::endl;
+	Path scriptPath;
+	scriptPath.set_file_path_from(params[0]);
+	if(scriptPath == toBuild.contentPath)
+		contentAdded = 1;
 
-							if(prompt && promptInput != 'a')
-							{
-								eos << "? " << std::flush;
-								promptInput = nsm_getch();
-								if(promptInput == 'Y' || promptInput == '1')
-									promptInput = 'y';
-								else if(promptInput == 'A')
-									promptInput = 'a';
-							}
-							
-							eos << std::endl;
-						}
+	record_dep_hash(scriptPath);
+	depFiles.insert(scriptPath);
 
-						if(!prompt || promptInput == 'y' || promptInput == 'a')
-						{
-							if(backupFiles && path_exists(targetStr))
-								rename(targetStr.c_str(), (targetStr + "~").c_str());
+	if(cache && console)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "script{cache}(" << quote(params[0]) << "): console output cannot be cached, use the inject, raw or !o option" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-							if(!can_write(targetStr) || rename(sourceStr.c_str(), targetStr.c_str()))
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to move ";
-								eos << quote(params[0]) << " to " << quote(params[1]) << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-						}
-					}
-				}
-			}
-			else
+	//the script itself is always an input of its cached output
+	std::string cacheKey, scriptOutput;
+	bool cacheHit = 0;
+	if(cache && file_exists(params[0]))
+	{
+		for(size_t i=0; i<cacheInputs.size(); ++i)
+		{
+			Path inputPath;
+			inputPath.set_file_path_from(cacheInputs[i]);
+			record_dep_hash(inputPath);
+			depFiles.insert(inputPath);
+		}
+		cacheInputs.insert(cacheInputs.begin(), params[0]);
+
+		cacheKey = sys_cache_key("script " + params[0] + " " + params[1], cacheInputs, cacheEnvVars);
+		cacheHit = sysCache.get(cacheKey, scriptOutput);
+	}
+
+	if(file_exists(params[0]))
+	{
+		int result = 0;
+
+		if(!cacheHit)
+		{
+			//copies script to backup location
+			if(makeBackup)
 			{
-				if(!dir_exists(targetStr))
+				if(cpFile(params[0], params[0] + ".backup", sLineNo, readPath, eos, consoleLocked, os_mtx))
 				{
 					if(!consoleLocked)
 						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot move files to ";
-					eos << quote(targetStr) << " as directory does not exist" << std::endl;
+					start_err_ml(eos, readPath, sLineNo, lineNo) << "script: failed to copy " << quote(params[0]) << " to " << quote(params[0] + ".backup") << std::endl;
 					os_mtx->unlock();
 					return 1;
 				}
+			}
 
-				char endChar = targetStr[targetStr.size()-1];
-				if(endChar != '/' && endChar != '\\')
-					targetStr += "/";
-				target.set_file_path_from(targetStr);
-
-				struct stat  oldDirPerms;
-				if(changePermissions)
-				{
-					stat(targetStr.c_str(), &oldDirPerms);
-					chmod(target.dir.c_str(), S_IRWXU);
-				}
-				else if(!can_write(targetStr))
+			//moves script to main directory
+			//note if just copy original script or move copied script get 'Text File Busy' errors (can be quite rare)
+			//sometimes this fails (on Windows) for some reason, so keeps trying until successful
+			int mcount = 0;
+			while(rename(params[0].c_str(), execPath.c_str()))
+			{
+				if(++mcount == 100)
 				{
 					if(!consoleLocked)
 						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot write to " << quote(target.dir) << std::endl;
-					os_mtx->unlock();
-					return 1;
+					start_warn(eos, readPath, lineNo) << "script: have tried to move " << quote(params[0]) << " to " << quote(execPath) << " 100 times already, may need to abort" << std::endl;
+					start_warn(eos) << "you may need to move " << quote(execPath) << " back to " << quote(params[0]) << std::endl;
+					if(!consoleLocked)
+						os_mtx->unlock();
 				}
+			}
 
-				std::vector<Path> sources;
-				for(size_t p=0; p<params.size(); ++p)
-				{
-					if(params[p].size() && (params[p][params[p].size()-1] == '/' || params[p][params[p].size()-1] == '\\'))
-					{
-						int pos=params[p].size()-2; 
-						while(pos>=0 && (params[p][pos] == '/' || params[p][pos] == '\\'))
-							--pos;
-						params[p] = params[p].substr(0, pos+1);
-					}
-
-					sourceStr = replace_home_dir(params[p]);
-					source.set_file_path_from(sourceStr);
-					sources.push_back(source);
-
-					if(!path_exists(sourceStr))
-					{
-						if(sourceStr.find_first_of('*') != std::string::npos)
-						{
-							std::string parsedTxt, toParse = "@lst{!c, 1, P}(" + sourceStr + ")";
-							int parseLineNo = 0;
-
-							if(n_read_and_process_fast(indent, toParse, parseLineNo, readPath, antiDepsOfReadPath, parsedTxt, eos))
-							{
-								if(!consoleLocked)
-									os_mtx->lock();
-								start_err_ml(eos, readPath, sLineNo, lineNo) <<  funcName << ": failed to list " << quote(sourceStr) << std::endl;
-								os_mtx->unlock();
-								return 1;
-							}
-
-							std::istringstream iss(parsedTxt);
-							while(getline(iss, sourceStr))
-								params.push_back(sourceStr);
-
-							continue;
-						}
-						else
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot move ";
-							eos << quote(params[p]) << " as path does not exist" << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-					}
-
-					target.file = source.file;
-					targetStr = target.str();
-
-					if(overwrite || !file_exists(targetStr))
-					{
-						if(!ifNew || source.modified_after(target))
-						{
-							if(changePermissions && file_exists(targetStr))
-								chmod(targetStr.c_str(), 0666);
-
-							if((prompt && promptInput != 'a') || verbose)
-							{
-								if(targetParam.size())
-								{
-									endChar = targetParam[targetParam.size()-1];
-									if(endChar != '/' && endChar != '\\')
-										targetParam += '/';
-								}
-
-								eos << quote(params[p]) << " -> " << quote(targetParam + source.file);
+			if(file_exists("/.flatpak-info"))
+				exec_str = "flatpak-spawn --host bash -c " + quote(execPath + " " + params[1]);
+			else
+				exec_str = execPath + " " + params[1];
 
-								if(prompt && promptInput != 'a')
-								{
-									eos << "? " << std::flush;
-									promptInput = nsm_getch();
-									if(promptInput == 'Y' || promptInput == '1')
-										promptInput = 'y';
-									else if(promptInput == 'A')
-										promptInput = 'a';
-								}
-								
-								eos << std::endl;
-							}
+			if(console)
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+			}
+			else
+				exec_str += " > " + output_filename;
 
-							if(!prompt || promptInput == 'y' || promptInput == 'a')
-							{
-								if(backupFiles && path_exists(targetStr))
-									rename(targetStr.c_str(), (targetStr + "~").c_str());
+			result = system(exec_str.c_str());
 
+			if(console && !consoleLocked)
+				os_mtx->unlock();
 
-								if(!can_write(targetStr) || rename(sourceStr.c_str(), targetStr.c_str()))
-								{
-									if(targetParam.size())
-									{
-										endChar = targetParam[targetParam.size()-1];
-										if(endChar != '/' && endChar != '\\')
-											targetParam += '/';
-									}
-
-									if(!consoleLocked)
-										os_mtx->lock();
-									start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to move ";
-									eos << quote(params[p]) << " to " << quote(targetParam + source.file) << std::endl;
-									os_mtx->unlock();
-									return 1;
-								}
-							}
-						}
-					}
+			//moves script back to original location
+			//sometimes this fails (on Windows) for some reason, so keeps trying until successful
+			mcount = 0;
+			while(rename(execPath.c_str(), params[0].c_str()))
+			{
+				if(++mcount == 100)
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_warn(eos, readPath, lineNo) << "script: have tried to move " << execPath << " to " << params[0] << " 100 times already, may need to abort" << std::endl;
+					start_warn(eos) << "you may need to move " << quote(execPath) << " back to " << quote(params[0]) << std::endl;
+					if(!consoleLocked)
+						os_mtx->unlock();
 				}
-
-				if(changePermissions)
-					chmod(target.dir.c_str(), oldDirPerms.st_mode);
 			}
 
-			if(linePos < inStr.size() && inStr[linePos] == '!')
-				++linePos;
-			else
-				skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+			//deletes backup copy
+			if(makeBackup)
+				remove_file(Path("", params[0] + ".backup"));
 
-			return 0;
+			if(!console && !noOutput)
+				scriptOutput = string_from_file(output_filename);
+			if(cache && !result)
+				sysCache.put(cacheKey, scriptOutput);
 		}
-		#if defined _WIN32 || defined _WIN64
-			else if(funcName == "mv")
-				funcName = "move";
-		#else
-			else if(funcName == "move")
-				funcName = "mv";
-		#endif
-	}
-	else if(funcName[0] == 'n')
-	{
-		if(funcName == "n++")
+
+		if(console)
 		{
-			if(params.size() > 1)
+			if(result)
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "n++: expected 0-1 parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "script{console}(" << quote(params[0]) << ") failed" << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
 
-			int bLineNo = lineNo;
-			bool addOut = addOutput;
-
-			if(options.size())
+			if(mode != MODE_INTERP && !noReturnValue) //check this
 			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "o")
-						addOut = 1;
-					else if(options[o] == "!o")
-						addOut = 0;
-				}
+				std::string resultStr = std::to_string(result);
+				outStr += resultStr;
+				if(indent)
+					outStr += into_whitespace(resultStr);
 			}
-
-			if(params.size())
+		}
+		else if(noOutput)
+		{
+			if(result)
 			{
-				if(!file_exists(params[0]))
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "n++: file " << params[0] << " does not exist" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-
-				params[0] = string_from_file(params[0]);
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "script{!o}(" << quote(params[0]) << ") failed, ";
+				eos << "see " << quote(output_filename) << " for pre-error script output" << std::endl;
+				os_mtx->unlock();
+				//remove_file(Path("./", output_filename));
+				return 1;
 			}
-			else
+
+			if(!noReturnValue)
 			{
-				params.push_back("");
-				if(read_block(params[0], linePos, inStr, readPath, lineNo, bLineNo, "n++{block}", eos))
-					return 1;
+				std::string resultStr = std::to_string(result);
+				outStr += resultStr;
+				if(indent)
+					outStr += into_whitespace(resultStr);
 			}
 
-			std::string resultStr;
-			int result = n_read_and_process_fast(1, addOut, params[0], bLineNo-1, readPath, antiDepsOfReadPath, resultStr, eos);
-
+			remove_file(Path("./", output_filename));
+		}
+		else if(injectRaw)
+		{
 			if(result)
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed here" << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "script{raw}(" << quote(params[0]) << ") failed, ";
+				eos << "see " << quote(output_filename) << " for pre-error script output" << std::endl;
 				os_mtx->unlock();
+				//remove_file(Path("./", output_filename));
 				return 1;
 			}
 
-			if(addOut)
+			//adds every line, including the empty one after a trailing newline
+			size_t linePos = 0, endPos, oldLinePos = 0;
+			while(1)
 			{
-				std::string resultStr = std::to_string(result);
-				outStr += resultStr;
-				if(indent)
-					indentAmount += into_whitespace(resultStr);
+				endPos = scriptOutput.find('\n', linePos);
+				if(linePos)
+					add_newline(outStr, indentAmount);
+				oldLinePos = linePos;
+				if(endPos == std::string::npos)
+				{
+					outStr.append(scriptOutput, linePos, std::string::npos);
+					break;
+				}
+				outStr.append(scriptOutput, linePos, endPos - linePos);
+				linePos = endPos + 1;
 			}
+			if(indent)
+				indentAmount.add_text(scriptOutput, oldLinePos, scriptOutput.size() - oldLinePos);
 
-
-			return result;
+			remove_file(Path("./", output_filename));
 		}
-		else if(funcName == "nsm_lang" && (mode == MODE_INTERP || mode == MODE_SHELL))
+		else //inject
 		{
-			if(params.size() != 1)
+			if(result)
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "script{inject}(" << quote(params[0]) << ") failed, ";
+				eos << "see " << quote(output_filename) << " for pre-error script output" << std::endl;
 				os_mtx->unlock();
+				//remove_file(Path("./", output_filename));
 				return 1;
 			}
 
-			size_t pos = params[0].find_first_of("fFnNtTlLeExX", 0);
+			//indent amount updated inside read_and_process
+			if(n_read_and_process(1, scriptOutput, 0, Path("", scriptPath.str() + " output - " + output_filename), antiDepsOfReadPath, outStr, eos) > 0)
+			{
+				if(!consoleLocked)
+					os_mtx->lock();
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "script: failed to process output of script " << quote(params[0] + " " + params[1]) << std::endl;
+				os_mtx->unlock();
+				//remove_file(Path("./", output_filename));
+				return 1;
+			}
+
+			remove_file(Path("./", output_filename));
+		}
+	}
+	else if(ifExists)
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "script(" << quote(params[0]) << ") failed as script " << quote(params[0]) << " does not exist" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	return 0;
+}
+
+int Parser::builtin_system(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const char& lang = call.lang;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	ProfileSpan builtinSpan("@system", "builtin");
+
+	int console = 0, inject = 0, injectRaw = 0, noOutput = 0;
+	int bLineNo = lineNo;
+	bool parseBlock = 0;
+	bool attachContentPath = 0;
+	bool noReturnValue = 0;
+	bool noShell = 0;
+	bool cache = 0;
+	double timeout = 0;
+	std::vector<std::string> cacheInputs, cacheEnvVars;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "pb")
+				parseBlock = 1;
+			else if(options[o] == "console")
+				console = 1;
+			else if(options[o] == "cache")
+				cache = 1;
+			else if(options[o].substr(0, 3) == "in=")
+				cacheInputs.push_back(unquote(options[o].substr(3, options[o].size()-3)));
+			else if(options[o].substr(0, 4) == "env=")
+				cacheEnvVars.push_back(unquote(options[o].substr(4, options[o].size()-4)));
+			else if(options[o] == "inject" || options[o] == "inj")
+				inject = 1;
+			else if(options[o] == "raw")
+				injectRaw = 1;
+			else if(options[o] == "!o")
+				noOutput = 1;
+			else if(options[o] == "!ret")
+				noReturnValue = 1;
+			else if(options[o] == "content")
+				attachContentPath = 1;
+			else if(options[o] == "!sh")
+				noShell = 1;
+			else if(options[o].substr(0, 8) == "timeout=")
+			{
+				std::string timeoutStr = unquote(options[o].substr(8, options[o].size()-8));
+				if(!isDouble(timeoutStr) || (timeout = std::strtod(timeoutStr.c_str(), NULL)) < 0)
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": timeout should be a non-negative number of seconds, got " << quote(timeoutStr) << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
+			}
+		}
+	}
+
+	if(noShell)
+	{
+		if(params.size() == 0)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << "{!sh}: expected the program and its arguments as parameters" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
+	else if(params.size() > 1)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 0-1 parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	if(params.size() == 0)
+	{
+		params.push_back("");
+		if(read_block(params[0], linePos, inStr, readPath, lineNo, bLineNo, "system{block}", eos))
+			return 1;
+
+		if(parseBlock && parse_replace(lang, params[0], funcName + " block", readPath, antiDepsOfReadPath, bLineNo, funcName + "{block}", sLineNo, eos))
+			return 1;
+	}
+
+	std::string sys_call = params[0];
+
+	#if defined _WIN32 || defined _WIN64
+		if(unquote(sys_call).substr(0, 2) == "./")
+			sys_call = unquote(sys_call).substr(2, unquote(sys_call).size()-2);
+	#else  //*nix
+	#endif
+
+	if(attachContentPath)
+	{
+		contentAdded = 1;
+		sys_call += " " + quote(toBuild.contentPath.str());
+		if(noShell)
+			params.push_back(toBuild.contentPath.str());
+	}
+
+	if(noShell)
+	{
+		sys_call = params[0];
+		for(size_t p=1; p<params.size(); ++p)
+			sys_call += " " + quote(params[p]);
+	}
+
+	if(console + inject + injectRaw + noOutput > 1)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << "(" << quote(sys_call) << "): console, inject, raw and !o options are incompatible with each other" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	int whereTo;
+	if(console)
+		whereTo = SYS_CONSOLE;
+	else if(inject)
+		whereTo = SYS_INJECT;
+	else if(injectRaw)
+		whereTo = SYS_RAW;
+	else if(noOutput)
+		whereTo = SYS_NO_OUT;
+	else if(lang == 'n')
+		whereTo = SYS_INJECT;
+	else
+		whereTo = SYS_CONSOLE;
+
+	if(!cache)
+		return system_call(funcName, sys_call, noShell ? &params : NULL, whereTo, noReturnValue, timeout, NULL, indent, readPath, antiDepsOfReadPath, sLineNo, lineNo, eos, outStr);
+
+	if(whereTo == SYS_CONSOLE)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << "{cache}(" << quote(sys_call) << "): console output cannot be cached, use the inject, raw or !o option" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	//declared inputs are dependencies as well as part of the key
+	for(size_t i=0; i<cacheInputs.size(); ++i)
+	{
+		Path inputPath;
+		inputPath.set_file_path_from(cacheInputs[i]);
+		record_dep_hash(inputPath);
+		depFiles.insert(inputPath);
+	}
+
+	std::string cacheKey = sys_cache_key((noShell ? "argv " : "sh ") + sys_call, cacheInputs, cacheEnvVars);
+
+	return system_call(funcName, sys_call, noShell ? &params : NULL, whereTo, noReturnValue, timeout, &cacheKey, indent, readPath, antiDepsOfReadPath, sLineNo, lineNo, eos, outStr);
+}
+
+int Parser::builtin_scope(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	bool inScopes = 0;
 
-			if(pos != std::string::npos)
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "in")
+				inScopes = 1;
+		}
+	}
+
+	if(params.size() == 0)
+	{
+		outStr += vars.layers[vars.layers.size()-1].scope;
+		if(indent)
+			indentAmount.add_text(vars.layers[vars.layers.size()-1].scope);
+	}
+	else if(params.size() == 1)
+	{
+		VPos vpos;
+
+		if(vars.find(params[0], vpos))
+		{
+			if(inScopes)
 			{
-				if(params[0][pos] == 'f' || params[0][pos] == 'F') 
-					return LANG_FPP;
-				else if(params[0][pos] == 'x' || params[0][pos] == 'X')
-					return LANG_EXPRTK;
-				else if(params[0][pos] == 'n' || params[0][pos] == 'N' || params[0][pos] == 't' || params[0][pos] == 'T')
-					return LANG_NPP;
-				else if(params[0][pos] == 'l' || params[0][pos] == 'L')
-					return LANG_LUA;
+				std::string inScopesStr = "{";
+				if(vars.layers[vpos.layer].inScopes[params[0]].size())
+				{
+					auto it = vars.layers[vpos.layer].inScopes[params[0]].begin();
+					inScopesStr += *it++;
+					while(it != vars.layers[vpos.layer].inScopes[params[0]].end())
+						inScopesStr += "; " + *it++;
+				}
+				inScopesStr += "}";
+				outStr += inScopesStr;
+				if(indent)
+					indentAmount.add_text(inScopesStr);
 			}
 			else
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": do not recognise the language " << quote(params[0]) << std::endl;
-				os_mtx->unlock();
-				return 1;
+				outStr += vars.layers[vpos.layer].scopeOf[params[0]];
+				if(indent)
+					indentAmount.add_text(vars.layers[vpos.layer].scopeOf[params[0]]);
 			}
 		}
-		else if(funcName == "nsm_mode" && (mode == MODE_INTERP || mode == MODE_SHELL))
+		else
 		{
-			if(params.size() != 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "scope: no variables/functions named " << params[0] << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
 
-			int pos = params[0].find_first_of("sSiI", 0);
+	return 0;
+}
 
-			if(pos >= 0)
-			{
-				if(params[0][pos] == 's' || params[0][pos] == 'S')
-					return MODE_SHELL;
-				else if(params[0][pos] == 'i' || params[0][pos] == 'I')
-					return MODE_INTERP;
-			}
-			else
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": do not recognise mode " << quote(params[0]) << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+int Parser::builtin_quote(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	std::string str;
+
+	if(replaceVars && replace_var(params[0], readPath, sLineNo, "quote", eos))
+		return 1;
+
+	params[0] = quote(params[0]);
+	outStr += params[0];
+	if(indent)
+		indentAmount.add_text(params[0]);
+
+	return 0;
+}
+
+int Parser::builtin_quit(FnCall& /*call*/)
+{
+	return NSM_QUIT; //check this??
+}
+
+int Parser::builtin_unquote(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+	bool& replaceVars = call.replaceVars;
+
+	std::string str;
+
+	if(replaceVars && replace_var(params[0], readPath, sLineNo, "unquote", eos))
+		return 1;
+
+	params[0] = unquote(params[0]);
+	outStr += params[0];
+	if(indent)
+		indentAmount.add_text(params[0]);
+
+	return 0;
+}
+
+int Parser::builtin_mve(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size() < 2)
+	{
+		if(read_sh_params(params, ' ', linePos, inStr, readPath, lineNo, funcName, eos))
+			return 1;
+	}
+
+	if(params.size() < 2)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 2+ parameters, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	bool backupFiles = 0,
+	     forceFile = 0,
+	     ifNew = 0,
+	     overwrite = 1,
+	     changePermissions = 0, 
+	     prompt = 0,
+	     verbose = 0;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); ++o)
+		{
+			if(options[o] == "b")
+				backupFiles = 1;
+			else if(options[o] == "f")
+				changePermissions = 1;
+			else if(options[o] == "i")
+				prompt = 1;
+			else if(options[o] == "n")
+				overwrite = 0;
+			else if(options[o] == "T")
+				forceFile = 1;
+			else if(options[o] == "u")
+				ifNew = 1;
+			else if(options[o] == "v")
+				verbose = 1;
 		}
 	}
-	else if(funcName[0] == 'j')
+
+	size_t t = params.size()-1;
+	Path source, target;
+	std::string sourceStr, 
+	            targetStr = replace_home_dir(params[t]),
+	            targetParam = params[t];
+	char promptInput = 'n';
+
+	params.pop_back();
+
+	if(params.size() == 1 && 
+	    (forceFile || !dir_exists(targetStr)) && 
+	    params[0].find_first_of('*') == std::string::npos)
 	{
-		if(funcName == "join")
+		if(params[0].size() && (params[0][params[0].size()-1] == '/' || params[0][params[0].size()-1] == '\\'))
 		{
-			if(params.size() < 1 || params.size() > 4)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "join: expected 1-4 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+			int pos=params[0].size()-2;
+			while(pos>=0 && (params[0][pos] == '/' || params[0][pos] == '\\'))
+				--pos;
+			params[0] = params[0].substr(0, pos+1);
+		}
 
-			std::string output, separator = ", ";
-			bool addAtStart = 0, addAtEnd = 0;
-			VPos vpos;
+		sourceStr = replace_home_dir(params[0]);
+		source.set_file_path_from(sourceStr);
+		target.set_file_path_from(targetStr);
 
-			if(params.size() >= 2)
-				separator = params[1];
+		if(!path_exists(sourceStr))
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot move ";
+			eos << quote(params[0]) << " as path does not exist" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			if(options.size())
+		if(overwrite || !file_exists(targetStr))
+		{
+			if(!ifNew || source.modified_after(target))
 			{
-				for(size_t o=0; o<options.size(); o++)
+				if(changePermissions)
 				{
-					if(options[o] == "<-")
-						addAtStart = 1;
-					else if(options[o] == "->")
-						addAtEnd = 1;
-					else if(options[o] == "<->")
-						addAtStart = addAtEnd = 1;
+					if(file_exists(targetStr))
+						chmod(targetStr.c_str(), 0666);
+					else if(dir_exists(targetStr))
+						chmod(targetStr.c_str(), S_IRWXU);
 				}
-			}
-
-			if(params.size() == 4 || 
-			   (vars.find(params[0] + ".size", vpos) && 
-			    (vpos.type == "std::int" || vpos.type == "int")))
-			{
-				int sizeOf = 0;
-				int spos = 0, epos = 0;
 
-				if(params.size() < 4)
+				if((prompt && promptInput != 'a') || verbose)
 				{
-					if(vpos.type == "std::int")
-						sizeOf = vars.layers[vpos.layer].ints[params[0] + ".size"];
-					else
-						sizeOf = vars.layers[vpos.layer].doubles[params[0] + ".size"];
-					epos = sizeOf-1;
-				}
+					eos << quote(params[0]) << " -> " << quote(params[1]) << std::endl;
 
-				if(params.size() > 2)
-				{
-					if(!isNonNegInt(params[2]))
-					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "join: ";
-						eos << "third parameter " << params[2] << " should be a non-negative integer less than the ";
-						eos << "size of struct specified in first parameter" << std::endl;
-						os_mtx->unlock();
-						return 1;
-					}
-					spos = std::atoi(params[2].c_str());
-					if(params.size() < 4 && spos >= sizeOf)
+					if(prompt && promptInput != 'a')
 					{
-						if(!consoleLocked)
-							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "join: ";
-						eos << "third parameter " << params[2] << " should be a non-negative integer less than the ";
-						eos << "size of struct specified in first parameter" << std::endl;
-						os_mtx->unlock();
-						return 1;
+						eos << "? " << std::flush;
+						promptInput = nsm_getch();
+						if(promptInput == 'Y' || promptInput == '1')
+							promptInput = 'y';
+						else if(promptInput == 'A')
+							promptInput = 'a';
 					}
+					
+					eos << std::endl;
 				}
-				if(params.size() > 3)
+
+				if(!prompt || promptInput == 'y' || promptInput == 'a')
 				{
-					if(!isNonNegInt(params[3]))
+					if(backupFiles && path_exists(targetStr))
+						rename(targetStr.c_str(), (targetStr + "~").c_str());
+
+					if(!can_write(targetStr) || rename(sourceStr.c_str(), targetStr.c_str()))
 					{
 						if(!consoleLocked)
 							os_mtx->lock();
-						start_err_ml(eos, readPath, sLineNo, lineNo) << "join: ";
-						eos << "fourth parameter " << params[3] << " should be a non-negative integer less than the ";
-						eos << "size of struct specified in first parameter" << std::endl;
+						start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to move ";
+						eos << quote(params[0]) << " to " << quote(params[1]) << std::endl;
 						os_mtx->unlock();
 						return 1;
 					}
-					epos = std::atoi(params[3].c_str());
-					sizeOf = epos - spos;
-				}
-
-				if(spos <= epos)
-				{
-					if(addAtStart)
-						output += separator + "$[" + params[0] + "[" + std::to_string(spos) + "]]";
-					else
-						output += "$[" + params[0] + "[" + std::to_string(spos) + "]]";
 				}
-
-				for(int i=spos+1; i<=epos; i++)
-					output += separator + "$[" + params[0] + "[" + std::to_string(i) + "]]";
-
-				if(spos <= epos && addAtEnd)
-					output += separator;
-
-				if(parse_replace(lang, output, "join output", readPath, antiDepsOfReadPath, lineNo, "join", sLineNo, eos))
-					return 1;
-
-				outStr += output;
-				if(indent)
-					indentAmount += into_whitespace(output);
-			}
-			else
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "join: " << params[0] << ".size is not a defined integer" << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
-			return 0;
-		}
-		else if(funcName == "jsinclude")
-		{
-			if(params.size() != 1)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "jsinclude: expected 1 parameter, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-
-			std::string jsPathStr = params[0];
-			Path jsPath;
-			jsPath.set_file_path_from(jsPathStr);
-
-			//warns user if js file doesn't exist
-			if(!file_exists(jsPathStr.c_str()))
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_warn(eos, readPath, lineNo) << "jsinclude: javascript file " << jsPath << " does not exist" << std::endl;
-				if(!consoleLocked)
-					os_mtx->unlock();
 			}
-
-			Path pathToJSFile(pathBetween(toBuild.outputPath.dir, jsPath.dir), jsPath.file);
-
-			std::string jsInclude="<script src=\"" + pathToJSFile.str() + "\"";
-			if(options.size())
-				for(size_t o=0; o<options.size(); ++o)
-					jsInclude += " " + options[o];
-			jsInclude+="></script>";
-
-			outStr += jsInclude;
-			if(indent)
-				indentAmount += into_whitespace(jsInclude);
-
-			return 0;
 		}
 	}
-	else if(funcName[0] == 'v')
+	else
 	{
-		if(funcName == "vjoin")
+		if(!dir_exists(targetStr))
 		{
-			if(params.size() < 1 || params.size() > 4)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: expected 1-4 parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot move files to ";
+			eos << quote(targetStr) << " as directory does not exist" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			bool round = 1;
-			std::string output, separator = ", ";
-			bool addAtStart = 0, addAtEnd = 0;
-			VPos vpos;
+		char endChar = targetStr[targetStr.size()-1];
+		if(endChar != '/' && endChar != '\\')
+			targetStr += "/";
+		target.set_file_path_from(targetStr);
 
-			if(params.size() == 2)
-				separator = params[1];
+		struct stat  oldDirPerms;
+		if(changePermissions)
+		{
+			stat(targetStr.c_str(), &oldDirPerms);
+			chmod(target.dir.c_str(), S_IRWXU);
+		}
+		else if(!can_write(targetStr))
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot write to " << quote(target.dir) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			if(options.size())
+		std::vector<Path> sources;
+		for(size_t p=0; p<params.size(); ++p)
+		{
+			if(params[p].size() && (params[p][params[p].size()-1] == '/' || params[p][params[p].size()-1] == '\\'))
 			{
-				for(size_t o=0; o<options.size(); o++)
-				{
-					if(options[o] == "<-")
-						addAtStart = 1;
-					else if(options[o] == "->")
-						addAtEnd = 1;
-					else if(options[o] == "<->")
-						addAtStart = addAtEnd = 1;
-					else if(options[o] == "!round")
-						round = 0;
-				}
+				int pos=params[p].size()-2; 
+				while(pos>=0 && (params[p][pos] == '/' || params[p][pos] == '\\'))
+					--pos;
+				params[p] = params[p].substr(0, pos+1);
 			}
 
-			if(vars.find(params[0], vpos))
+			sourceStr = replace_home_dir(params[p]);
+			source.set_file_path_from(sourceStr);
+			sources.push_back(source);
+
+			if(!path_exists(sourceStr))
 			{
-				if(vpos.type == "std::vector<string>")
+				if(sourceStr.find_first_of('*') != std::string::npos)
 				{
-					std::vector<std::string>* v = &vars.layers[vpos.layer].strVecs[params[0] ];
-
-					int sizeOf = v->size();
-
-					int spos = 0, epos = sizeOf-1;
+					std::string parsedTxt, toParse = "@lst{!c, 1, P}(" + sourceStr + ")";
+					int parseLineNo = 0;
 
-					if(params.size() > 2)
+					if(n_read_and_process_fast(indent, toParse, parseLineNo, readPath, antiDepsOfReadPath, parsedTxt, eos))
 					{
-						if(!isNonNegInt(params[2]))
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: ";
-							eos << "third parameter " << params[2] << " should be a non-negative integer less than the ";
-							eos << "size of vector specified in first parameter" << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-						spos = std::atoi(params[2].c_str());
-						if(spos >= sizeOf)
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: ";
-							eos << "third parameter " << params[2] << " should be a non-negative integer less than the ";
-							eos << "size of vector specified in first parameter" << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-					}
-					if(params.size() > 3)
-					{
-						if(!isNonNegInt(params[3]))
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: ";
-							eos << "fourth parameter " << params[3] << " should be a non-negative integer less than the ";
-							eos << "size of vector specified in first parameter" << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-						epos = std::atoi(params[3].c_str());
-						if(epos >= sizeOf)
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: ";
-							eos << "fourth parameter " << params[3] << " should be a non-negative integer less than the ";
-							eos << "size of vector specified in first parameter" << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-					}
-
-					if(spos <= epos)
-					{
-						if(addAtStart)
-							output += separator;
-						output += v->at(spos);
+						if(!consoleLocked)
+							os_mtx->lock();
+						start_err_ml(eos, readPath, sLineNo, lineNo) <<  funcName << ": failed to list " << quote(sourceStr) << std::endl;
+						os_mtx->unlock();
+						return 1;
 					}
 
-					for(int i=spos+1; i<=epos; i++)
-						output += separator + v->at(i);
-
-					if(spos <= epos && addAtEnd)
-						output += separator;
+					std::istringstream iss(parsedTxt);
+					while(getline(iss, sourceStr))
+						params.push_back(sourceStr);
 
-					outStr += output;
-					if(indent)
-						indentAmount += into_whitespace(output);
+					continue;
 				}
-				else if(vpos.type == "std::vector<double>")
+				else
 				{
-					std::vector<double>* v = &vars.layers[vpos.layer].doubVecs[params[0] ];
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot move ";
+					eos << quote(params[p]) << " as path does not exist" << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
+			}
 
-					int sizeOf = v->size();
+			target.file = source.file;
+			targetStr = target.str();
 
-					int spos = 0, epos = sizeOf-1;
+			if(overwrite || !file_exists(targetStr))
+			{
+				if(!ifNew || source.modified_after(target))
+				{
+					if(changePermissions && file_exists(targetStr))
+						chmod(targetStr.c_str(), 0666);
 
-					if(params.size() > 2)
+					if((prompt && promptInput != 'a') || verbose)
 					{
-						if(!isNonNegInt(params[2]))
+						if(targetParam.size())
 						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: ";
-							eos << "third parameter " << params[2] << " should be a non-negative integer less than the ";
-							eos << "size of vector specified in first parameter" << std::endl;
-							os_mtx->unlock();
-							return 1;
+							endChar = targetParam[targetParam.size()-1];
+							if(endChar != '/' && endChar != '\\')
+								targetParam += '/';
 						}
-						spos = std::atoi(params[2].c_str());
-						if(spos >= sizeOf)
+
+						eos << quote(params[p]) << " -> " << quote(targetParam + source.file);
+
+						if(prompt && promptInput != 'a')
 						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: ";
-							eos << "third parameter " << params[2] << " should be a non-negative integer less than the ";
-							eos << "size of vector specified in first parameter" << std::endl;
-							os_mtx->unlock();
-							return 1;
+							eos << "? " << std::flush;
+							promptInput = nsm_getch();
+							if(promptInput == 'Y' || promptInput == '1')
+								promptInput = 'y';
+							else if(promptInput == 'A')
+								promptInput = 'a';
 						}
+						
+						eos << std::endl;
 					}
-					if(params.size() > 3)
-					{
-						if(!isNonNegInt(params[3]))
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: ";
-							eos << "fourth parameter " << params[3] << " should be a non-negative integer less than the ";
-							eos << "size of vector specified in first parameter" << std::endl;
-							os_mtx->unlock();
-							return 1;
-						}
-						epos = std::atoi(params[3].c_str());
-						if(epos >= sizeOf)
+
+					if(!prompt || promptInput == 'y' || promptInput == 'a')
+					{
+						if(backupFiles && path_exists(targetStr))
+							rename(targetStr.c_str(), (targetStr + "~").c_str());
+
+
+						if(!can_write(targetStr) || rename(sourceStr.c_str(), targetStr.c_str()))
 						{
+							if(targetParam.size())
+							{
+								endChar = targetParam[targetParam.size()-1];
+								if(endChar != '/' && endChar != '\\')
+									targetParam += '/';
+							}
+
 							if(!consoleLocked)
 								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: ";
-							eos << "fourth parameter " << params[3] << " should be a non-negative integer less than the ";
-							eos << "size of vector specified in first parameter" << std::endl;
+							start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to move ";
+							eos << quote(params[p]) << " to " << quote(targetParam + source.file) << std::endl;
 							os_mtx->unlock();
 							return 1;
 						}
 					}
+				}
+			}
+		}
 
-					if(spos <= epos)
-					{
-						if(addAtStart)
-							output += separator;
-						output += vars.double_to_string(v->at(spos), round);
-					}
+		if(changePermissions)
+			chmod(target.dir.c_str(), oldDirPerms.st_mode);
+	}
 
-					for(int i=spos+1; i<=epos; i++)
-						output += separator + vars.double_to_string(v->at(i), round);
+	if(linePos < inStr.size() && inStr[linePos] == '!')
+		++linePos;
+	else
+		skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
 
-					if(spos <= epos && addAtEnd)
-						output += separator;
+	return 0;
+}
 
-					outStr += output;
-					if(indent)
-						indentAmount += into_whitespace(output);
-				}
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: not defined for variable " << quote(params[0]) << " of type " << quote(vpos.type)<< std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
-			else
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: no variables named " << quote(params[0]) << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+int Parser::builtin_npp(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const bool& addOutput = call.addOutput;
+	const std::string& inStr = call.inStr;
+	int& lineNo = call.lineNo;
+	size_t& linePos = call.linePos;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
 
-			return 0;
+	int bLineNo = lineNo;
+	bool addOut = addOutput;
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "o")
+				addOut = 1;
+			else if(options[o] == "!o")
+				addOut = 0;
 		}
-		else if(funcName == "valid_type")
+	}
+
+	if(params.size())
+	{
+		if(!file_exists(params[0]))
 		{
-			if(params.size() == 0)
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << "valid_type: expected parameters, got " << params.size() << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "n++: file " << params[0] << " does not exist" << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
 
-			for(size_t p=1; p<params.size(); p++)
-				params[0] += ", " + params[p];
+		params[0] = string_from_file(params[0]);
+	}
+	else
+	{
+		params.push_back("");
+		if(read_block(params[0], linePos, inStr, readPath, lineNo, bLineNo, "n++{block}", eos))
+			return 1;
+	}
 
-			outStr += std::to_string(valid_type(params[0], readPath, antiDepsOfReadPath, lineNo, "valid_type", sLineNo, eos));
-			if(indent)
-				indentAmount += " ";
+	std::string resultStr;
+	int result = n_read_and_process_fast(1, addOut, params[0], bLineNo-1, readPath, antiDepsOfReadPath, resultStr, eos);
 
-			return 0;
+	if(result)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed here" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	if(addOut)
+	{
+		std::string resultStr = std::to_string(result);
+		outStr += resultStr;
+		if(indent)
+			indentAmount.add_text(resultStr);
+	}
+
+
+	return result;
+}
+
+int Parser::builtin_nsm_lang(FnCall& call)
+{
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& params = call.params;
+
+	if(mode != MODE_INTERP && mode != MODE_SHELL)
+		return NSM_NOT_BUILTIN;
+
+	if(params.size() != 1)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	size_t pos = params[0].find_first_of("fFnNtTlLeExX", 0);
+
+	if(pos != std::string::npos)
+	{
+		if(params[0][pos] == 'f' || params[0][pos] == 'F') 
+			return LANG_FPP;
+		else if(params[0][pos] == 'x' || params[0][pos] == 'X')
+			return LANG_EXPRTK;
+		else if(params[0][pos] == 'n' || params[0][pos] == 'N' || params[0][pos] == 't' || params[0][pos] == 'T')
+			return LANG_NPP;
+		else if(params[0][pos] == 'l' || params[0][pos] == 'L')
+			return LANG_LUA;
+	}
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": do not recognise the language " << quote(params[0]) << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	return NSM_NOT_BUILTIN;
+}
+
+int Parser::builtin_nsm_mode(FnCall& call)
+{
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& params = call.params;
+
+	if(mode != MODE_INTERP && mode != MODE_SHELL)
+		return NSM_NOT_BUILTIN;
+
+	if(params.size() != 1)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 1 parameter, got " << params.size() << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	int pos = params[0].find_first_of("sSiI", 0);
+
+	if(pos >= 0)
+	{
+		if(params[0][pos] == 's' || params[0][pos] == 'S')
+			return MODE_SHELL;
+		else if(params[0][pos] == 'i' || params[0][pos] == 'I')
+			return MODE_INTERP;
+	}
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": do not recognise mode " << quote(params[0]) << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	return NSM_NOT_BUILTIN;
+}
+
+int Parser::builtin_join(FnCall& call)
+{
+	const bool& indent = call.indent;
+	const char& lang = call.lang;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	std::string output, separator = ", ";
+	bool addAtStart = 0, addAtEnd = 0;
+	VPos vpos;
+
+	if(params.size() >= 2)
+		separator = params[1];
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "<-")
+				addAtStart = 1;
+			else if(options[o] == "->")
+				addAtEnd = 1;
+			else if(options[o] == "<->")
+				addAtStart = addAtEnd = 1;
 		}
 	}
-	else if(funcName[0] == 'a')
+
+	if(params.size() == 4 || 
+	   (vars.find(params[0] + ".size", vpos) && 
+	    (vpos.type == "std::int" || vpos.type == "int")))
 	{
-		if(funcName == "add_member_fns")
+		int sizeOf = 0;
+		int spos = 0, epos = 0;
+
+		if(params.size() < 4)
 		{
-			if(params.size() > 1)
+			if(vpos.type == "std::int")
+				sizeOf = vars.layers[vpos.layer].ints[params[0] + ".size"];
+			else
+				sizeOf = vars.layers[vpos.layer].doubles[params[0] + ".size"];
+			epos = sizeOf-1;
+		}
+
+		if(params.size() > 2)
+		{
+			if(!isNonNegInt(params[2]))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 0-1 parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "join: ";
+				eos << "third parameter " << params[2] << " should be a non-negative integer less than the ";
+				eos << "size of struct specified in first parameter" << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
-
-			if(params.size())
-			{
-				if(isInt(params[0]))
-					addMemberFnsGlobal = std::atoi(params[0].c_str());
-				else if(isDouble(params[0]))
-					addMemberFnsGlobal = std::strtod(params[0].c_str(), NULL);
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot convert " << quote(params[0]) << " to bool" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
-			else
-			{
-				std::string output = std::to_string(addMemberFnsGlobal);
-				outStr += output;
-				if(indent)
-					indentAmount += into_whitespace(output);
-			}
-
-			return 0;
-		}
-		else if(funcName == "add_scope")
-		{
-			if(params.size() > 1)
+			spos = std::atoi(params[2].c_str());
+			if(params.size() < 4 && spos >= sizeOf)
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected 0-1 parameters, got " << params.size() << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "join: ";
+				eos << "third parameter " << params[2] << " should be a non-negative integer less than the ";
+				eos << "size of struct specified in first parameter" << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
-
-			if(params.size())
-			{
-				if(isInt(params[0]))
-					addScopeGlobal = std::atoi(params[0].c_str());
-				else if(isDouble(params[0]))
-					addScopeGlobal = std::strtod(params[0].c_str(), NULL);
-				else
-				{
-					if(!consoleLocked)
-						os_mtx->lock();
-					start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot convert " << quote(params[0]) << " to bool" << std::endl;
-					os_mtx->unlock();
-					return 1;
-				}
-			}
-			else
-			{
-				std::string output = std::to_string(addScopeGlobal);
-				outStr += output;
-				if(indent)
-					indentAmount += into_whitespace(output);
-			}
-
-			return 0;
 		}
-	}
-
-	VPos vpos;
-	if(vars.find_fn(funcName, vpos))
-	{
-		size_t layer = vars.layers.size()-1;
-
-		if(vars.layers[vpos.layer].privates.count(funcName))
+		if(params.size() > 3)
 		{
-			if(!vars.layers[vpos.layer].inScopes[funcName].count(vars.layers[layer].scope))
+			if(!isNonNegInt(params[3]))
 			{
 				if(!consoleLocked)
 					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": attempted illegal access of private function" << std::endl;
+				start_err_ml(eos, readPath, sLineNo, lineNo) << "join: ";
+				eos << "fourth parameter " << params[3] << " should be a non-negative integer less than the ";
+				eos << "size of struct specified in first parameter" << std::endl;
 				os_mtx->unlock();
 				return 1;
 			}
+			epos = std::atoi(params[3].c_str());
+			sizeOf = epos - spos;
 		}
 
-		bool addScope = addScopeGlobal, addOut = 1;
+		if(spos <= epos)
+		{
+			if(addAtStart)
+				output += separator + "$[" + params[0] + "[" + std::to_string(spos) + "]]";
+			else
+				output += "$[" + params[0] + "[" + std::to_string(spos) + "]]";
+		}
 
-		std::vector<std::string> oldOpts, oldPars;
-		std::string oldOptType, oldParType;
-		bool optWasConst = 0, parWasConst = 0;
-		bool optWasPrivate = 0, parWasPrivate = 0;
-		bool addMemberFns = addMemberFnsGlobal;
+		for(int i=spos+1; i<=epos; i++)
+			output += separator + "$[" + params[0] + "[" + std::to_string(i) + "]]";
 
-		std::string oldScope;
+		if(spos <= epos && addAtEnd)
+			output += separator;
 
-		if(vars.layers[vpos.layer].noOutput.count(funcName))
-			addOut = 0;
-		if(vars.layers[vpos.layer].unscopedFns.count(funcName))
-			addScope = 0;
+		if(parse_replace(lang, output, "join output", readPath, antiDepsOfReadPath, lineNo, "join", sLineNo, eos))
+			return 1;
 
-		if(options.size())
-		{
-			for(size_t o=0; o<options.size(); o++)
-			{
-				if(options[o] == "mf")
-					addMemberFns = 1;
-				else if(options[o] == "!mf")
-					addMemberFns = 0;
-				else if(options[o] == "o")
-					addOut = 1;
-				else if(options[o] == "!o")
-					addOut = 0;
-				else if(options[o] == "s")
-					addScope = 1;
-				else if(options[o] == "!s")
-					addScope = 0;
-			}
-		}
+		outStr += output;
+		if(indent)
+			indentAmount.add_text(output);
+	}
+	else
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "join: " << params[0] << ".size is not a defined integer" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-		//adds scope to variables
-		if(addScope)
-		{
-			//vars.add_layer(vars.layers[vpos.layer].scopeOf[funcName]);
-			vars.add_layer(funcName.substr(0, funcName.find_last_of('.')+1));
-			//++layer;
-		}
-		else
-		{
-			oldScope = vars.layers[layer].scope;
-			vars.layers[layer].scope = funcName.substr(0, find_last_of_special(funcName)+1);
-		}
+	return 0;
+}
 
-		//backs up options/params variables already defined at this scope
-		if(vars.layers[0].typeOf.count("options"))
-		{
-			if(vars.layers[0].constants.count("options"))
-				optWasConst = 1;
-			if(vars.layers[0].privates.count("options"))
-				optWasPrivate = 1;
+int Parser::builtin_jsinclude(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	std::string jsPathStr = params[0];
+	Path jsPath;
+	jsPath.set_file_path_from(jsPathStr);
+
+	//warns user if js file doesn't exist
+	if(!file_exists(jsPathStr.c_str()))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_warn(eos, readPath, lineNo) << "jsinclude: javascript file " << jsPath << " does not exist" << std::endl;
+		if(!consoleLocked)
+			os_mtx->unlock();
+	}
+
+	Path pathToJSFile(pathBetween(toBuild.outputPath.dir, jsPath.dir), jsPath.file);
+
+	std::string jsInclude="<script src=\"" + pathToJSFile.str() + "\"";
+	if(options.size())
+		for(size_t o=0; o<options.size(); ++o)
+			jsInclude += " " + options[o];
+	jsInclude+="></script>";
 
-			oldOptType = vars.layers[0].typeOf["options"];
+	outStr += jsInclude;
+	if(indent)
+		indentAmount.add_text(jsInclude);
 
-			if(oldOptType == "std::vector<string>")
-			{
-				oldOpts = vars.layers[0].strVecs["options"];
-				vars.layers[0].strVecs["__options"] = oldOpts;
-			}
+	return 0;
+}
+
+int Parser::builtin_vjoin(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& options = call.options;
+	std::vector<std::string>& params = call.params;
+
+	bool round = 1;
+	std::string output, separator = ", ";
+	bool addAtStart = 0, addAtEnd = 0;
+	VPos vpos;
 
-			vars.layers[0].typeOf.erase("options");
+	if(params.size() == 2)
+		separator = params[1];
+
+	if(options.size())
+	{
+		for(size_t o=0; o<options.size(); o++)
+		{
+			if(options[o] == "<-")
+				addAtStart = 1;
+			else if(options[o] == "->")
+				addAtEnd = 1;
+			else if(options[o] == "<->")
+				addAtStart = addAtEnd = 1;
+			else if(options[o] == "!round")
+				round = 0;
 		}
+	}
 
-		if(vars.layers[0].typeOf.count("params"))
+	if(vars.find(params[0], vpos))
+	{
+		if(vpos.type == "std::vector<string>")
 		{
-			if(vars.layers[0].constants.count("params"))
-				parWasConst = 1;
-			if(vars.layers[0].privates.count("params"))
-				parWasPrivate = 1;
+			std::vector<std::string>* v = &vars.layers[vpos.layer].strVecs[params[0] ];
 
-			oldParType = vars.layers[0].typeOf["params"];
+			int sizeOf = v->size();
 
-			if(oldParType == "std::vector<string>")
+			int spos = 0, epos = sizeOf-1;
+
+			if(params.size() > 2)
 			{
-				oldPars = vars.layers[0].strVecs["params"];
-				vars.layers[0].strVecs["__params"] = oldPars;
+				if(!isNonNegInt(params[2]))
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: ";
+					eos << "third parameter " << params[2] << " should be a non-negative integer less than the ";
+					eos << "size of vector specified in first parameter" << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
+				spos = std::atoi(params[2].c_str());
+				if(spos >= sizeOf)
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: ";
+					eos << "third parameter " << params[2] << " should be a non-negative integer less than the ";
+					eos << "size of vector specified in first parameter" << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
 			}
-
-			vars.layers[0].typeOf.erase("params");
-		}
-
-		//defines params/options vectors
-		if(addMemberFns && !vars.layers[0].functions.count("options.at"))
-		{
-			std::string toParse = ":={layer=0}(std::vector<string>, options)";
-			std::string trash;
-			if(f_read_and_process_fast(0, toParse, lineNo, readPath, antiDepsOfReadPath, trash, eos) > 0)
+			if(params.size() > 3)
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to define options vector" << std::endl;
-				os_mtx->unlock();
-				return 1;
+				if(!isNonNegInt(params[3]))
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: ";
+					eos << "fourth parameter " << params[3] << " should be a non-negative integer less than the ";
+					eos << "size of vector specified in first parameter" << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
+				epos = std::atoi(params[3].c_str());
+				if(epos >= sizeOf)
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: ";
+					eos << "fourth parameter " << params[3] << " should be a non-negative integer less than the ";
+					eos << "size of vector specified in first parameter" << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
 			}
-		}
-		else
-			vars.layers[0].typeOf["options"] = "std::vector<string>";
-		vars.layers[0].strVecs["options"] = options;
-		vars.layers[0].constants.insert("options");
 
-		if(addMemberFns && !vars.layers[0].functions.count("params.at"))
-		{
-			std::string toParse = ":={layer=0}(std::vector<string>, params)";
-			std::string trash;
-			if(f_read_and_process_fast(0, toParse, lineNo, readPath, antiDepsOfReadPath, trash, eos) > 0)
+			if(spos <= epos)
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to define params vector" << std::endl;
-				os_mtx->unlock();
-				return 1;
+				if(addAtStart)
+					output += separator;
+				output += v->at(spos);
 			}
-		}
-		else
-			vars.layers[0].typeOf["params"] = "std::vector<string>";
 
-		vars.layers[0].strVecs["params"] = params;
-		vars.layers[0].constants.insert("params");
+			for(int i=spos+1; i<=epos; i++)
+				output += separator + v->at(i);
 
-		std::string fnOutput;
-		if(lang == 'n')
+			if(spos <= epos && addAtEnd)
+				output += separator;
+
+			outStr += output;
+			if(indent)
+				indentAmount.add_text(output);
+		}
+		else if(vpos.type == "std::vector<double>")
 		{
-			if(n_read_and_process_fast(1, addOut, vars.layers[vpos.layer].functions[funcName], vars.layers[vpos.layer].ints[funcName]-1, vars.layers[vpos.layer].paths[funcName], antiDepsOfReadPath, fnOutput, eos) > 0)
+			std::vector<double>* v = &vars.layers[vpos.layer].doubVecs[params[0] ];
+
+			int sizeOf = v->size();
+
+			int spos = 0, epos = sizeOf-1;
+
+			if(params.size() > 2)
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed here" << std::endl;
-				os_mtx->unlock();
-				return 1;
+				if(!isNonNegInt(params[2]))
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: ";
+					eos << "third parameter " << params[2] << " should be a non-negative integer less than the ";
+					eos << "size of vector specified in first parameter" << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
+				spos = std::atoi(params[2].c_str());
+				if(spos >= sizeOf)
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: ";
+					eos << "third parameter " << params[2] << " should be a non-negative integer less than the ";
+					eos << "size of vector specified in first parameter" << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
 			}
-		}
-		else
-		{
-			if(f_read_and_process_fast(addOut, vars.layers[vpos.layer].functions[funcName], vars.layers[vpos.layer].ints[funcName]-1, vars.layers[vpos.layer].paths[funcName], antiDepsOfReadPath, fnOutput, eos) > 0)
+			if(params.size() > 3)
 			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed here" << std::endl;
-				os_mtx->unlock();
-				return 1;
+				if(!isNonNegInt(params[3]))
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: ";
+					eos << "fourth parameter " << params[3] << " should be a non-negative integer less than the ";
+					eos << "size of vector specified in first parameter" << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
+				epos = std::atoi(params[3].c_str());
+				if(epos >= sizeOf)
+				{
+					if(!consoleLocked)
+						os_mtx->lock();
+					start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: ";
+					eos << "fourth parameter " << params[3] << " should be a non-negative integer less than the ";
+					eos << "size of vector specified in first parameter" << std::endl;
+					os_mtx->unlock();
+					return 1;
+				}
 			}
-		}
-		outStr += fnOutput;
 
-		//removes added scope to variables
-		if(addScope)
-			vars.layers.pop_back();
-		else
-			vars.layers[layer].scope = oldScope;
+			if(spos <= epos)
+			{
+				if(addAtStart)
+					output += separator;
+				output += vars.double_to_string(v->at(spos), round);
+			}
 
-		//reverts existing options/params variables otherwise deletes them
-		if(!optWasConst)
-			vars.layers[0].constants.erase("options");
-		if(!optWasPrivate)
-			vars.layers[0].privates.erase("options");
-		if(oldOptType == "std::vector<string>")
-		{
-			vars.layers[0].strVecs["options"] = oldOpts;
-			vars.layers[0].strVecs.erase("__options");
-		}
-		else
-		{
-			vars.layers[0].strVecs.erase("options");
-			if(oldOptType == "")
-				vars.layers[0].typeOf.erase("options");
-			else
-				vars.layers[0].typeOf["options"] = oldOptType;
-		}
+			for(int i=spos+1; i<=epos; i++)
+				output += separator + vars.double_to_string(v->at(i), round);
 
-		if(!parWasConst)
-			vars.layers[0].constants.erase("params");
-		if(!parWasPrivate)
-			vars.layers[0].privates.erase("params");
-		if(oldParType == "std::vector<string>")
-		{
-			vars.layers[0].strVecs["params"] = oldPars;
-			vars.layers[0].strVecs.erase("__params");
+			if(spos <= epos && addAtEnd)
+				output += separator;
+
+			outStr += output;
+			if(indent)
+				indentAmount.add_text(output);
 		}
 		else
 		{
-			vars.layers[0].strVecs.erase("params");
-			if(oldParType == "")
-				vars.layers[0].typeOf.erase("params");
-			else
-				vars.layers[0].typeOf["params"] = oldParType;
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: not defined for variable " << quote(params[0]) << " of type " << quote(vpos.type)<< std::endl;
+			os_mtx->unlock();
+			return 1;
 		}
 	}
-	else if(valid_type(funcName, readPath, antiDepsOfReadPath, lineNo, "valid_type(" + funcName + ")", sLineNo, eos))
+	else
 	{
-		if(params.size() < 1)
-		{
-			if(read_sh_params(params, ',', linePos, inStr, readPath, lineNo, funcName, eos))
-				return 1;
-		}
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(eos, readPath, sLineNo, lineNo) << "vjoin: no variables named " << quote(params[0]) << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
 
-		if(!params.size())
+	return 0;
+}
+
+int Parser::builtin_valid_type(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::set<Path>& antiDepsOfReadPath = call.antiDepsOfReadPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::vector<std::string>& params = call.params;
+
+	for(size_t p=1; p<params.size(); p++)
+		params[0] += ", " + params[p];
+
+	outStr += std::to_string(valid_type(params[0], readPath, antiDepsOfReadPath, lineNo, "valid_type", sLineNo, eos));
+	if(indent)
+		indentAmount += ' ';
+
+	return 0;
+}
+
+int Parser::builtin_add_member_fns(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size())
+	{
+		if(isInt(params[0]))
+			addMemberFnsGlobal = std::atoi(params[0].c_str());
+		else if(isDouble(params[0]))
+			addMemberFnsGlobal = std::strtod(params[0].c_str(), NULL);
+		else
 		{
 			if(!consoleLocked)
 				os_mtx->lock();
-			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": expected parameters, got " << params.size() << std::endl;
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot convert " << quote(params[0]) << " to bool" << std::endl;
 			os_mtx->unlock();
 			return 1;
 		}
+	}
+	else
+	{
+		std::string output = std::to_string(addMemberFnsGlobal);
+		outStr += output;
+		if(indent)
+			indentAmount.add_text(output);
+	}
 
-		std::string toParse;
-		if(lang == 'n')
-			toParse = "@";
-		toParse += ":=";
-		if(options.size())
-		{
-			toParse += "{" + options[0];
-			for(size_t o=1; o<options.size(); ++o)
-				toParse += ", " + options[o];
-			toParse += '}';
-		}
-		toParse += "(" + funcName;
-		for(size_t p=0; p<params.size(); ++p)
-			toParse += ", " + params[p];
-		toParse += ')';
+	return 0;
+}
 
-		if(lang == 'f')
-		{
-			if(f_read_and_process_fast(addOutput, toParse, lineNo-1, readPath, antiDepsOfReadPath, outStr, eos))
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) <<  funcName << ": definition failed" << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
-		}
+int Parser::builtin_add_scope(FnCall& call)
+{
+	const bool& indent = call.indent;
+	int& lineNo = call.lineNo;
+	const Path& readPath = call.readPath;
+	std::string& outStr = call.outStr;
+	std::ostream& eos = call.eos;
+	int& sLineNo = call.sLineNo;
+	std::string& funcName = call.funcName;
+	std::vector<std::string>& params = call.params;
+
+	if(params.size())
+	{
+		if(isInt(params[0]))
+			addScopeGlobal = std::atoi(params[0].c_str());
+		else if(isDouble(params[0]))
+			addScopeGlobal = std::strtod(params[0].c_str(), NULL);
 		else
 		{
-			if(n_read_and_process_fast(indent, toParse, lineNo-1, readPath, antiDepsOfReadPath, outStr, eos))
-			{
-				if(!consoleLocked)
-					os_mtx->lock();
-				start_err_ml(eos, readPath, sLineNo, lineNo) <<  funcName << ": definition failed" << std::endl;
-				os_mtx->unlock();
-				return 1;
-			}
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": cannot convert " << quote(params[0]) << " to bool" << std::endl;
+			os_mtx->unlock();
+			return 1;
 		}
+	}
+	else
+	{
+		std::string output = std::to_string(addScopeGlobal);
+		outStr += output;
+		if(indent)
+			indentAmount.add_text(output);
+	}
+
+	return 0;
+}
+
+//calls a builtin added with register_builtin
+int Parser::call_registered_builtin(FnCall& call)
+{
+	std::string output;
+	if(call.builtin->fn(*this, call.options, call.params, call.readPath, call.sLineNo, output, call.eos))
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		start_err_ml(call.eos, call.readPath, call.sLineNo, call.lineNo) << call.funcName << ": failed" << std::endl;
+		os_mtx->unlock();
+		return 1;
+	}
+
+	call.outStr += output;
+	if(call.indent)
+		indentAmount.add_text(output);
+
+	return 0;
+}
+
+/*
+	reads the call at pos ahead of time the same way read_and_process_fn
+	would, returns 1 if it's left to be read when it's reached. errors are
+	reported when the call is reached rather than here, and nothing is read
+	ahead of time while the console is locked as reporting an error here
+	would unlock it.
+*/
+int Parser::tokenise_call(const std::string& inStr, const size_t& pos, CallToken& call)
+{
+	std::ostream eos(NULL);
+	Path readPath;
+	size_t linePos = pos;
+	int lineNo = 0;
+
+	if(consoleLocked)
+		return 1;
+
+	if(inStr[linePos] == '@')
+		++linePos;
 
-		if(linePos < inStr.size() && inStr[linePos] == '!')
-			++linePos;
-		else
-			skip_whitespace(0, inStr, lineNo, linePos, readPath, funcName, eos);
+	//comments, escapes and expressions read_and_process_fn deals with before reading a name
+	if(linePos >= inStr.size() ||
+	   (inStr[linePos] == '$' && inStr[linePos+1] == '`') ||
+	   inStr[linePos] == '#' ||
+	   inStr[linePos] == '\\' ||
+	   inStr.compare(linePos, 2, "/*") == 0 ||
+	   inStr.compare(linePos, 2, "//") == 0 ||
+	   inStr.compare(linePos, 3, "!\\n") == 0 ||
+	   inStr.compare(linePos, 3, "-->") == 0 ||
+	   inStr.compare(linePos, 4, "--//") == 0 ||
+	   inStr.compare(linePos, 3, "--#") == 0 ||
+	   inStr.compare(linePos, 3, "<--") == 0 ||
+	   inStr.compare(linePos, 2, "*/") == 0 ||
+	   inStr.compare(linePos, 9, "pagetitle") == 0 ||
+	   inStr.compare(linePos, 12, "inputcontent") == 0)
+		return 1;
 
-		return 0;
-	}
-	else if(zeroParams)
+	call = CallToken();
+
+	if(read_func_name(call.funcName, call.parseFuncName, linePos, inStr, readPath, lineNo, eos))
+		return 1;
+	call.nameEnd = call.optionsEnd = call.end = linePos;
+	call.nameLines = lineNo;
+	lineNo = 0;
+	if(!call.parseFuncName)
+		call.nameId = name_id(call.funcName);
+
+	if(linePos < inStr.size() && inStr[linePos] == '{')
 	{
-		if(lang == 'n')
+		if(read_optionsStr(call.optionsStr, call.parseOptions, linePos, inStr, readPath, lineNo, call.funcName, eos))
+			return 1;
+		call.optionsEnd = call.end = linePos;
+		call.optionsLines = lineNo;
+		lineNo = 0;
+
+		if(!call.parseOptions)
 		{
-			linePos = sLinePos;
+			size_t oPos = 0;
+			if(read_options(call.options, oPos, call.optionsStr, readPath, lineNo, call.funcName, eos))
+				return 1;
+			call.optionsSplitLines = lineNo;
+			lineNo = 0;
+		}
+	}
 
-			if(inStr[sLinePos] == '$')
-				++linePos;
+	//how parameters are read depends on the name and options
+	if(call.parseFuncName)
+		return 0;
 
-			if(addOutput)
-			{
-				if(inStr[sLinePos] == '$')
-					outStr += "$";
-				else
-					outStr += "@";
-				if(indent)
-					indentAmount += " ";
-			}
+	bool doNotParse = 0, oneParamOpt = 0;
+	for(size_t o=0; o<call.options.size(); ++o)
+	{
+		if(call.options[o] == "1p")
+			oneParamOpt = 1;
+		else if(call.options[o] == "!p")
+			doNotParse = 1;
+	}
 
+	const std::string& funcName = call.funcName;
+	if(funcName == "if" || funcName == "for" || funcName == "while" || funcName == "do-while" || funcName == "?")
+	{
+		if(read_params(call.params, ';', linePos, inStr, readPath, lineNo, funcName, eos))
+			return 1;
+	}
+	else if(funcName == "||" || funcName == "&&")
+	{
+		if(read_params(call.params, linePos, inStr, readPath, lineNo, funcName, eos))
+			return 1;
+	}
+	else if(funcName == ":=")
+	{
+		if(read_paramsStr(call.paramsStr, call.parseParams, linePos, inStr, readPath, lineNo, funcName, eos))
+			return 1;
+	}
+	else if(linePos < inStr.size() && (inStr[linePos] == '(' || inStr[linePos] == '['))
+	{
+		if(call.parseOptions)
 			return 0;
+		else if(doNotParse)
+		{
+			if(read_params(call.params, linePos, inStr, readPath, lineNo, funcName, eos))
+				return 1;
 		}
 		else
 		{
-			if(addOutput)
+			if(read_paramsStr(call.paramsStr, call.parseParams, linePos, inStr, readPath, lineNo, funcName, eos))
+				return 1;
+
+			if(!call.parseParams && !oneParamOpt)
 			{
-				if(inStr[sLinePos] == '"')
-					funcName = "\"" + funcName + "\"";
-				else if(inStr[sLinePos] == '\'')
-					funcName = "'" + funcName + "'";
-				outStr += funcName + optionsStr;
-				if(indent)
-					indentAmount += into_whitespace(funcName + optionsStr);
-				return 0;
+				int splitLines = 0;
+				size_t pPos = 0;
+				if(read_params(call.params, pPos, call.paramsStr, readPath, splitLines, funcName, eos))
+					return 1;
+				call.paramsSplit = 1;
+				call.paramsSplitLines = splitLines;
 			}
-			else
-			{
-				//std::string trash, toParse = "sys(" + funcName;
-
-				/*if(options.size())
-				{
-					for(size_t o=0; o<options.size(); ++o)
-						#if defined _WIN32 || defined _WIN64
-							toParse += " /" + options[o];
-						#else  // *nix
-							toParse += " -" + options[o];
-						#endif
-				}
-				else if(toParse[toParse.size()-1] == ';')
-					toParse = toParse.substr(0, toParse.size()-1);
-				else
-				{
-					for(;linePos < inStr.size() && inStr[linePos] != '\n'; ++linePos)
-					{
-						if(inStr[linePos] == ';')
-						{
-							++linePos;
-							break;
-						}
-						toParse += inStr[linePos];
-					}
-				}
-				toParse += ")";*/
-
-				std::string trash,
-				            toParse;
-				if(mode == MODE_INTERP || mode == MODE_SHELL)
-				{
-					toParse = inStr.substr(sLinePos, inStr.size() - sLinePos);
-					linePos = inStr.size();
-				}
-				else
-					toParse = inStr.substr(sLinePos, (linePos = inStr.find_first_of("\n", sLinePos)) - sLinePos);
-
-				if(expr.compile(toParse) && expr.evaluate())
-					return 0;
-				else
-				{
-					std::string parseReplace = toParse;
+		}
+	}
 
-					lineNo = sLineNo;
+	call.paramsRead = 1;
+	call.end = linePos;
+	call.paramsLines = lineNo;
+	if(call.params.size())
+		call.paramId = name_id(call.params[0]);
 
-					if(parse_replace(lang, parseReplace, "expression", readPath, antiDepsOfReadPath, lineNo-1, parseReplace, sLineNo, eos))
-			   			return 1;
+	return 0;
+}
 
-			   		lineNo = sLineNo;
+//reads the blocks of if, while, for and do-while calls ahead of time
+void Parser::tokenise_blocks(SegmentedText& segmented, const CallToken& call)
+{
+	const std::string& funcName = call.funcName;
+	if(!call.paramsRead || (funcName != "if" && funcName != "while" && funcName != "for" && funcName != "do-while"))
+		return;
 
-			   		if(expr.compile(parseReplace) && expr.evaluate())
-			   			return 0;
-					else if(f_read_and_process(0, "sys{!p}(" + toParse + ")", lineNo-1, readPath, antiDepsOfReadPath, trash, eos))
-					{
-						if(mode != MODE_INTERP && mode != MODE_SHELL)
-						{
-							if(!consoleLocked)
-								os_mtx->lock();
-							start_err_ml(eos, readPath, sLineNo, lineNo) << c_light_blue << funcName << c_white << ": function does not exist in this scope";
-							eos << " and failed as a system call" << std::endl;
-							print_exprtk_parser_errs(eos, expr.parser, expr.expr_str, readPath, sLineNo);
-							os_mtx->unlock();
-						}
-						return 1;
-					}
-				}
+	size_t linePos = call.end;
+	if(linePos >= segmented.text.size() || tokenise_block(segmented, linePos) || funcName != "if")
+		return;
 
-				return 0;
-			}
-		}
-	}
-	else if(lang == 'f')
+	//else-if and else blocks, read the same way as read_else_blocks
+	const std::string& inStr = segmented.text;
+	std::ostream eos(NULL);
+	std::vector<std::string> params;
+	int lineNo = 0;
+	while(linePos < inStr.size() && inStr[linePos] != '!')
 	{
-		if(addOutput)
-		{
-			if(inStr[sLinePos] == '"')
-				funcName = "\"" + funcName + "\"";
-			else if(inStr[sLinePos] == '\'')
-				funcName = "'" + funcName + "'";
-			outStr += funcName + optionsStr + paramsStr;
-			if(indent)
-				indentAmount += into_whitespace(funcName + optionsStr + paramsStr);
-			return 0;
-		}
-		else
+		if(skip_whitespace(1, inStr, lineNo, linePos, Path(), funcName, eos) || inStr.compare(linePos, 4, "else"))
+			return;
+		linePos += 4;
+
+		if(inStr.compare(linePos, 3, "-if") == 0)
 		{
-			std::string trash;
-			return try_system_call(funcName, options, params, readPath, antiDepsOfReadPath, sLineNo, lineNo, eos, trash);
+			linePos += 3;
+			params.clear();
+			if(read_params(params, linePos, inStr, Path(), lineNo, funcName, eos))
+				return;
 		}
+
+		if(tokenise_block(segmented, linePos))
+			return;
 	}
-	else
-	{
-		if(!consoleLocked)
-			os_mtx->lock();
-		start_err_ml(eos, readPath, sLineNo, lineNo) << c_light_blue << funcName << c_white << ": function does not exist" << std::endl;
-		os_mtx->unlock();
+}
+
+//reads the block at linePos ahead of time and splits it up, returns 1 if it's left to be read
+int Parser::tokenise_block(SegmentedText& segmented, size_t& linePos)
+{
+	std::ostream eos(NULL);
+	BlockToken token;
+	std::string block;
+	int lineNo = 0, bLineNo = 0;
+
+	token.start = linePos;
+	if(read_block(block, linePos, segmented.text, Path(), lineNo, bLineNo, "block", eos))
 		return 1;
-	}
+	token.end = linePos;
+	token.noLines = lineNo;
+	token.noBlockLines = bLineNo;
+
+	std::shared_ptr<FileContents> contents(new FileContents());
+	contents->str.swap(block);
+	contents->hash = FNVHash(contents->str);
+	token.block.reset(new SegmentedText(contents, *this));
+	segmented.blocks.push_back(token);
 
 	return 0;
 }
@@ -14555,19 +15775,19 @@ int Parser::try_system_call(const int& whereTo,
                             std::ostream& eos,
                             std::string& outStr)
 {
-	std::string trash, toParse = "sys"; 
-	if(whereTo == 1)
-		toParse += "{console, !ret}";
-	else if(whereTo == 2)
-		toParse += "{inject, !ret}";
-	toParse += "(" + funcName;
+	std::string sys_call = funcName;
 	for(size_t o=0; o<options.size(); ++o)
-		toParse += " " + options[o];
+		sys_call += " " + options[o];
 	for(size_t p=0; p<params.size(); ++p)
-		toParse += " " + params[p];
-	toParse += ")";
+		sys_call += " " + params[p];
+
+	int result;
+	if(whereTo == 2)
+		result = system_call("sys", sys_call, NULL, SYS_INJECT, 1, 0, NULL, 0, readPath, antiDepsOfReadPath, sLineNo, lineNo, eos, outStr);
+	else
+		result = system_call("sys", sys_call, NULL, SYS_CONSOLE, whereTo == 1, 0, NULL, 0, readPath, antiDepsOfReadPath, sLineNo, lineNo, eos, outStr);
 
-	if(f_read_and_process(0, toParse, sLineNo-1, readPath, antiDepsOfReadPath, outStr, eos))
+	if(result)
 	{
 		if(!consoleLocked)
 			os_mtx->lock();
@@ -14580,6 +15800,186 @@ int Parser::try_system_call(const int& whereTo,
 	return 0;
 }
 
+//runs sys_call (or args without a shell when given) sending the output to whereTo,
+//output is reused from sysCache when cacheKey is given
+int Parser::system_call(const std::string& funcName,
+                        const std::string& sys_call,
+                        const std::vector<std::string>* args,
+                        const int& whereTo,
+                        const bool& noReturnValue,
+                        const double& timeout,
+                        const std::string* cacheKey,
+                        const bool& indent,
+                        const Path& readPath,
+                        std::set<Path>& antiDepsOfReadPath,
+                        const int& sLineNo,
+                        const int& lineNo,
+                        std::ostream& eos,
+                        std::string& outStr)
+{
+	std::string exec_str;
+	std::vector<std::string> execArgs;
+
+	//checks whether we're running from flatpak
+	if(file_exists("/.flatpak-info"))
+	{
+		if(args)
+		{
+			execArgs.push_back("flatpak-spawn");
+			execArgs.push_back("--host");
+		}
+		else
+			exec_str = "flatpak-spawn --host bash -c " + quote(sys_call);
+	}
+	else if(!args)
+		exec_str = sys_call;
+	if(args)
+		execArgs.insert(execArgs.end(), args->begin(), args->end());
+
+	if(whereTo == SYS_CONSOLE)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+
+		if(lolcatActive && !args)
+		{
+			for(size_t i=0; i<exec_str.size(); ++i)
+			{
+				size_t pos = exec_str.find_first_of(";\n", i);
+				std::string lineStr = exec_str.substr(i, pos-i);
+				i = pos;
+
+				if(i == std::string::npos)
+				{
+					lineStr = exec_str;
+					strip_trailing_whitespace_multiline(lineStr);
+					if(!is_whitespace(lineStr) && lineStr[lineStr.size()-1] != ';')
+						exec_str += " | " + lolcatCmd;
+					break;
+				}
+				else
+				{
+					if(!is_whitespace(lineStr))
+					{
+						exec_str.replace(i, 1, " | " + lolcatCmd + exec_str[i]);
+						i += 3 + lolcatCmd.size();
+					}
+				}
+			}
+		}
+	}
+
+	//output is captured straight from a pipe rather than going through a file
+	int result = 0;
+	bool timedOut = 0;
+	std::string output;
+	std::string* outputPtr = (whereTo == SYS_CONSOLE) ? NULL : &output;
+	if(!cacheKey || !sysCache.get(*cacheKey, output))
+	{
+		if(args)
+			result = spawn_argv(execArgs, outputPtr, timeout, timedOut);
+		else
+			result = spawn_shell(exec_str, outputPtr, timeout, timedOut);
+
+		//only successful output is cached, so cached calls always return 0
+		if(cacheKey && !result)
+			sysCache.put(*cacheKey, output);
+	}
+
+	if(whereTo == SYS_CONSOLE && !consoleLocked)
+		os_mtx->unlock();
+
+	std::string optionStr;
+	if(whereTo == SYS_CONSOLE)
+		optionStr = "{console}";
+	else if(whereTo == SYS_NO_OUT)
+		optionStr = "{!o}";
+	else if(whereTo == SYS_RAW)
+		optionStr = "{raw}";
+	else
+		optionStr = "{inject}";
+
+	if(result)
+	{
+		if(!consoleLocked)
+			os_mtx->lock();
+		if(whereTo == SYS_CONSOLE && (mode == MODE_INTERP || mode == MODE_SHELL))
+			std::cout << "\a" << std::flush;
+		else
+		{
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << optionStr << "(" << quote(sys_call) << ") ";
+			if(timedOut)
+				eos << "timed out after " << timeout << " seconds";
+			else
+				eos << "failed";
+
+			//output is only written to a file when there is an error to look in to
+			if(whereTo != SYS_CONSOLE)
+			{
+				std::string output_filename = ".@systemoutput" + std::to_string(sys_counter++);
+				std::ofstream ofs(output_filename, std::ios::binary);
+				ofs << output;
+				ofs.close();
+				eos << ", see " << quote(output_filename) << " for pre-error system output";
+			}
+			eos << std::endl;
+		}
+		os_mtx->unlock();
+		return 1;
+	}
+
+	if(whereTo == SYS_CONSOLE || whereTo == SYS_NO_OUT)
+	{
+		if(!noReturnValue && (whereTo == SYS_NO_OUT || mode != MODE_INTERP)) //check this
+		{
+			std::string resultStr = std::to_string(result);
+			outStr += resultStr;
+			if(indent)
+				outStr += into_whitespace(resultStr);
+		}
+	}
+	else if(whereTo == SYS_RAW)
+	{
+		//adds every line, including the empty one after a trailing newline
+		size_t linePos = 0, endPos, oldLinePos = 0;
+		while(1)
+		{
+			endPos = output.find('\n', linePos);
+			if(linePos)
+				add_newline(outStr, indentAmount);
+			oldLinePos = linePos;
+			if(endPos == std::string::npos)
+			{
+				outStr.append(output, linePos, std::string::npos);
+				break;
+			}
+			outStr.append(output, linePos, endPos - linePos);
+			linePos = endPos + 1;
+		}
+		if(indent)
+			indentAmount.add_text(output, oldLinePos, output.size() - oldLinePos);
+	}
+	else //inject
+	{
+		//stops at the first null character as reading output files did
+		size_t nullPos = output.find('\0');
+		if(nullPos != std::string::npos)
+			output.resize(nullPos);
+
+		//indent amount updated inside read_and_process
+		if(n_read_and_process(1, output, 0, Path("", sys_call + " - output"), antiDepsOfReadPath, outStr, eos) > 0)
+		{
+			if(!consoleLocked)
+				os_mtx->lock();
+			start_err_ml(eos, readPath, sLineNo, lineNo) << funcName << ": failed to process output of system call " << quote(sys_call) << std::endl;
+			os_mtx->unlock();
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
 int Parser::parse_replace(const char& lang,
                   std::string& str,
                   const std::string& strType,
@@ -14607,8 +16007,8 @@ int Parser::parse_replace(const bool& addOutput,
 	std::string iStr = str;
 	str = "";
 
-	std::string oldIndent = indentAmount;
-	indentAmount = "";
+	Indent oldIndent = indentAmount;
+	indentAmount.clear();
 
 	if(lang == 'n')
 	{
@@ -14647,7 +16047,7 @@ int Parser::parse_replace(const char& lang,
                   const int& callLineNo,
                   std::ostream& eos)
 {
-	std::string oldIndent = indentAmount;
+	Indent oldIndent = indentAmount;
 
 	for(size_t s=0; s<strs.size(); s++)
 	{
@@ -14656,7 +16056,7 @@ int Parser::parse_replace(const char& lang,
 
 		if(lang == 'n')
 		{
-			indentAmount = "";
+			indentAmount.clear();
 
 			if(n_read_and_process_fast(1, 1, iStr, lineNo-1, readPath, antiDepsOfReadPath, strs[s], eos) > 0)
 			{
@@ -14669,7 +16069,7 @@ int Parser::parse_replace(const char& lang,
 		}
 		else if(lang == 'f')
 		{
-			indentAmount = "";
+			indentAmount.clear();
 
 			if(f_read_and_process_fast(1, iStr, lineNo-1, readPath, antiDepsOfReadPath, strs[s], eos) > 0)
 			{
@@ -14700,37 +16100,37 @@ int Parser::replace_var(std::string& str,
 		{
 			if(vpos.type == "std::bool")
 			{
-				if(vars.layers[vpos.layer].bools[vpos.name])
+				if(value_of(vars.layers[vpos.layer].bools, vpos))
 					str = "1";
 				else
 					str = "0";
 			}
 			else if(vpos.type == "std::int")
-				str = std::to_string(vars.layers[vpos.layer].ints[vpos.name]);
+				str = std::to_string(value_of(vars.layers[vpos.layer].ints, vpos));
 			else if(vpos.type == "std::double")
-				str = vars.double_to_string(vars.layers[vpos.layer].doubles[vpos.name], 0);
+				str = vars.double_to_string(value_of(vars.layers[vpos.layer].doubles, vpos), 0);
 			else if(vpos.type == "std::char")
-				str = vars.layers[vpos.layer].chars[vpos.name];
+				str = value_of(vars.layers[vpos.layer].chars, vpos);
 			else if(vpos.type == "std::string")
-				str = vars.layers[vpos.layer].strings[vpos.name];
+				str = value_of(vars.layers[vpos.layer].strings, vpos);
 			else if(vpos.type == "std::llint")
-				str = std::to_string(vars.layers[vpos.layer].llints[vpos.name]);
+				str = std::to_string(value_of(vars.layers[vpos.layer].llints, vpos));
 		}
 		else if(vpos.type == "bool")
 		{
-			if(vars.layers[vpos.layer].doubles[vpos.name])
+			if(value_of(vars.layers[vpos.layer].doubles, vpos))
 				str = "1";
 			else
 				str = "0";
 		}
 		else if(vpos.type == "int")
-			str = std::to_string((int)vars.layers[vpos.layer].doubles[vpos.name]);
+			str = std::to_string((int)value_of(vars.layers[vpos.layer].doubles, vpos));
 		else if(vpos.type == "double")
-			str = vars.double_to_string(vars.layers[vpos.layer].doubles[vpos.name], 0);
+			str = vars.double_to_string(value_of(vars.layers[vpos.layer].doubles, vpos), 0);
 		else if(vpos.type == "char")
 		{
-			if(vars.layers[vpos.layer].strings[vpos.name].size())
-				str = vars.layers[vpos.layer].strings[vpos.name][0];
+			if(value_of(vars.layers[vpos.layer].strings, vpos).size())
+				str = value_of(vars.layers[vpos.layer].strings, vpos)[0];
 			else
 			{
 				if(!consoleLocked)
@@ -14741,7 +16141,7 @@ int Parser::replace_var(std::string& str,
 			}
 		}
 		else if(vpos.type == "string")
-			str = vars.layers[vpos.layer].strings[vpos.name];
+			str = value_of(vars.layers[vpos.layer].strings, vpos);
 		else
 		{
 			if(!consoleLocked)
@@ -14958,15 +16358,15 @@ int Parser::set_var_from_str(const VPos& vpos,
 		}
 	}
 
-	std::string varType = vars.layers[vpos.layer].typeOf[vpos.name];
+	std::string varType = value_of(vars.layers[vpos.layer].typeOf, vpos);
 	if(varType.substr(0, 5) == "std::")
 	{
 		if(varType == "std::bool")
 		{
 			if(isInt(value))
-				vars.layers[vpos.layer].bools[vpos.name] = (bool)std::atoi(value.c_str());
+				value_of(vars.layers[vpos.layer].bools, vpos) = (bool)std::atoi(value.c_str());
 			else if(isDouble(value))
-				vars.layers[vpos.layer].bools[vpos.name] = (bool)std::strtod(value.c_str(), NULL);
+				value_of(vars.layers[vpos.layer].bools, vpos) = (bool)std::strtod(value.c_str(), NULL);
 			else
 			{
 				if(!consoleLocked)
@@ -14980,9 +16380,9 @@ int Parser::set_var_from_str(const VPos& vpos,
 		else if(varType == "std::int")
 		{
 			if(isInt(value))
-				vars.layers[vpos.layer].ints[vpos.name] = std::atoi(value.c_str());
+				value_of(vars.layers[vpos.layer].ints, vpos) = std::atoi(value.c_str());
 			else if(isDouble(value))
-				vars.layers[vpos.layer].ints[vpos.name] = (int)std::strtod(value.c_str(), NULL);
+				value_of(vars.layers[vpos.layer].ints, vpos) = (int)std::strtod(value.c_str(), NULL);
 			else
 			{
 				if(!consoleLocked)
@@ -14996,7 +16396,7 @@ int Parser::set_var_from_str(const VPos& vpos,
 		else if(varType == "std::double")
 		{
 			if(isDouble(value))
-				vars.layers[vpos.layer].doubles[vpos.name] = std::strtod(value.c_str(), NULL);
+				value_of(vars.layers[vpos.layer].doubles, vpos) = std::strtod(value.c_str(), NULL);
 			else
 			{
 				if(!consoleLocked)
@@ -15010,7 +16410,7 @@ int Parser::set_var_from_str(const VPos& vpos,
 		else if(varType == "std::char")
 		{
 			if(value.size() == 1)
-				vars.layers[vpos.layer].chars[vpos.name] = value[0];
+				value_of(vars.layers[vpos.layer].chars, vpos) = value[0];
 			else
 			{
 				if(!consoleLocked)
@@ -15022,13 +16422,13 @@ int Parser::set_var_from_str(const VPos& vpos,
 			}
 		}
 		else if(varType == "std::string")
-			vars.layers[vpos.layer].strings[vpos.name] = value;
+			value_of(vars.layers[vpos.layer].strings, vpos) = value;
 		else if(varType == "std::llint")
 		{
 			if(isInt(value))
-				vars.layers[vpos.layer].llints[vpos.name] = std::atoll(value.c_str());
+				value_of(vars.layers[vpos.layer].llints, vpos) = std::atoll(value.c_str());
 			else if(isDouble(value))
-				vars.layers[vpos.layer].ints[vpos.name] = (long long int)std::strtod(value.c_str(), NULL);
+				value_of(vars.layers[vpos.layer].ints, vpos) = (long long int)std::strtod(value.c_str(), NULL);
 			else
 			{
 				if(!consoleLocked)
@@ -15043,9 +16443,9 @@ int Parser::set_var_from_str(const VPos& vpos,
 	else if(varType == "bool")
 	{
 		if(isInt(value))
-			vars.layers[vpos.layer].doubles[vpos.name] = (bool)std::atoi(value.c_str());
+			value_of(vars.layers[vpos.layer].doubles, vpos) = (bool)std::atoi(value.c_str());
 		else if(isDouble(value))
-			vars.layers[vpos.layer].doubles[vpos.name] = (bool)std::strtod(value.c_str(), NULL);
+			value_of(vars.layers[vpos.layer].doubles, vpos) = (bool)std::strtod(value.c_str(), NULL);
 		else
 		{
 			if(!consoleLocked)
@@ -15059,9 +16459,9 @@ int Parser::set_var_from_str(const VPos& vpos,
 	else if(varType == "int")
 	{
 		if(isInt(value))
-			vars.layers[vpos.layer].doubles[vpos.name] = std::atoi(value.c_str());
+			value_of(vars.layers[vpos.layer].doubles, vpos) = std::atoi(value.c_str());
 		else if(isDouble(value))
-			vars.layers[vpos.layer].doubles[vpos.name] = (int)std::strtod(value.c_str(), NULL);
+			value_of(vars.layers[vpos.layer].doubles, vpos) = (int)std::strtod(value.c_str(), NULL);
 		else
 		{
 			if(!consoleLocked)
@@ -15075,7 +16475,7 @@ int Parser::set_var_from_str(const VPos& vpos,
 	else if(varType == "double")
 	{
 		if(isDouble(value))
-			vars.layers[vpos.layer].doubles[vpos.name] = std::strtod(value.c_str(), NULL);
+			value_of(vars.layers[vpos.layer].doubles, vpos) = std::strtod(value.c_str(), NULL);
 		else
 		{
 			if(!consoleLocked)
@@ -15089,7 +16489,7 @@ int Parser::set_var_from_str(const VPos& vpos,
 	else if(varType == "char")
 	{
 		if(value.size() == 1)
-			vars.layers[vpos.layer].strings[vpos.name] = value[0];
+			value_of(vars.layers[vpos.layer].strings, vpos) = value[0];
 		else
 		{
 			if(!consoleLocked)
@@ -15101,7 +16501,7 @@ int Parser::set_var_from_str(const VPos& vpos,
 		}
 	}
 	else if(varType == "string")
-		vars.layers[vpos.layer].strings[vpos.name] = value;
+		value_of(vars.layers[vpos.layer].strings, vpos) = value;
 	else
 	{
 		if(!consoleLocked)
@@ -15183,6 +16583,8 @@ int Parser::add_fn(const std::string& fnName,
 		vars.layers[layer].nFns.insert(fnName);
 
 	vars.layers[layer].functions[fnName] = fnBlock;
+	vars.layers[layer].segmentedFns[fnName].reset();
+	vars.segment_fn(layer, fnName, *this);
 	vars.layers[layer].typeOf[fnName] = fnType;
 	vars.layers[layer].scopeOf[fnName] = scopeOf;
 	vars.layers[layer].paths[fnName] = readPath;
@@ -16710,19 +18112,50 @@ int Parser::read_block(std::string& block,
 	return 0;
 }
 
+//reads a block, handing back the block split up when it was read ahead of time
+int Parser::read_block(std::string& block,
+                       std::shared_ptr<const SegmentedText>& segmentedBlock,
+                       size_t& linePos,
+                       const std::string& inStr,
+                       const SegmentedText* segmented,
+                       const Path& readPath,
+                       int& lineNo,
+                       int& bLineNo,
+                       const std::string& callType,
+                       std::ostream& eos)
+{
+	const BlockToken* token;
+	if(segmented && (token = block_at(*segmented, linePos)))
+	{
+		block = token->block->text;
+		segmentedBlock = token->block;
+		linePos = token->end;
+		lineNo += token->noLines;
+		bLineNo += token->noBlockLines;
+
+		return 0;
+	}
+
+	segmentedBlock.reset();
+	return read_block(block, linePos, inStr, readPath, lineNo, bLineNo, callType, eos);
+}
+
 int Parser::read_else_blocks(std::vector<std::string>& conditions,
                              std::vector<int>& cLineNos,
                              std::vector<std::string>& blocks,
+                             std::vector<std::shared_ptr<const SegmentedText> >& segmentedBlocks,
                              std::vector<int>& bLineNos,
                              std::string& whitespace,
                              size_t& linePos,
                              const std::string& inStr,
+                             const SegmentedText* segmented,
                              const Path& readPath,
                              int& lineNo,
                              const std::string& callType,
                              std::ostream& eos)
 {
 	std::string block, condition, extraLine;
+	std::shared_ptr<const SegmentedText> segmentedBlock;
 	std::vector<std::string> params;
 	int bLineNo = lineNo;
 
@@ -16777,10 +18210,11 @@ int Parser::read_else_blocks(std::vector<std::string>& conditions,
 				conditions.push_back(params[0]);
 			}
 
-			if(read_block(block, linePos, inStr, readPath, lineNo, bLineNo, callType, eos))
+			if(read_block(block, segmentedBlock, linePos, inStr, segmented, readPath, lineNo, bLineNo, callType, eos))
 				return 1;
 
 			blocks.push_back(block);
+			segmentedBlocks.push_back(segmentedBlock);
 			bLineNos.push_back(bLineNo);
 		}
 		else
@@ -5,6 +5,7 @@
 #include <cmath>
 #include <math.h>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <set>
@@ -12,6 +13,8 @@
 #include <algorithm>
 //#include <bits/stdc++.h> //doesn't work on osx, algorithm works instead
 
+#include "BuildState.h"
+#include "Builtins.h"
 #include "DateTimeInfo.h"
 #include "Expr.h"
 #include "ExprtkFns.h"
@@ -19,9 +22,16 @@
 #include "hashtk/HashTk.h"
 #include "LuaFns.h"
 #include "Lua.h"
+#include "OutputWriter.h"
 #include "Pagination.h"
+#include "Profiler.h"
 #include "RapidJSON.h"
+#include "Scanner.h"
+#include "Spawn.h"
+#include "SysCache.h"
 #include "SystemInfo.h"
+#include "TemplateCache.h"
+#include "ThreadPool.h"
 #include "TrackedInfo.h"
 #include "Variables.h"
 
@@ -30,6 +40,7 @@
 int find_last_of_special(const std::string& s);
 
 void setIncrMode(const int& IncrMode);
+void record_dep_hash(const Path& dep);
 
 struct Parser
 {
@@ -39,7 +50,7 @@ struct Parser
 	DateTimeInfo dateTimeInfo;
 	int codeBlockDepth,
 	    htmlCommentDepth;
-	std::string indentAmount;
+	Indent indentAmount;
 	bool addMemberFnsGlobal, addScopeGlobal, replaceVarsGlobal;
 	bool contentAdded;
 	std::string promptChar;
@@ -54,6 +65,9 @@ struct Parser
 	std::vector<std::string> tabCompletionStrs;
 
 	Pagination pagesInfo;
+	std::vector<std::unique_ptr<Parser> > itemParsers; //clones pagination items are rendered on in parallel, made as needed
+	bool volatileRead; //set when a builtin with BUILTIN_VOLATILE or a time/date variable is used
+	bool itemClone;    //see make_item_clone
 
 	Variables vars;
 	Lua lua;
@@ -61,6 +75,7 @@ struct Parser
 	exprtk::rtl::io::package<double>       basicio_package; //could potentially make these pointers and
 	exprtk::rtl::io::file::package<double> fileio_package;  //only initialise if/when added
 	exprtk::rtl::vecops::package<double>   vectorops_package;
+	ExprCache exprCache;
 	Expr expr;
 	ExprSet exprset;
 
@@ -77,6 +92,7 @@ struct Parser
 	Directory contentDir,
 	          outputDir;
 	bool backupScripts, consoleLocked;
+	int prebuildExists, postbuildExists; //global pre/post-build scripts, -1 until checked once per build thread
 	Path consoleLockedPath;
 	int consoleLockedOnLine;
 	std::string contentExt,
@@ -98,12 +114,13 @@ struct Parser
 	       const std::string& UnixTextEditor,
 	       const std::string& WinTextEditor);
 
+	void add_exprtk_symbols();
+	void make_item_clone();
 	int lua_addnsmfns();
 	int lolcat_init(const std::string& lolcat_cmd);
 
 	int run_script(std::ostream& os,
 	               const Path& scriptPath, 
-	               const bool& makeBackup, 
 	               const bool& outputWhatDoing);
 
 	int refresh_completions();
@@ -115,6 +132,22 @@ struct Parser
 	          std::atomic<double>& estNoPagesFinished,
 	          std::atomic<int>& noPagesToBuild,
 	          std::ostream& eos);
+	void clear_page_state();
+	void copy_page_state(const Parser& page);
+	bool items_parallelisable() const;
+	std::string page_fingerprint(const std::string& context, const std::string& varsBefore, const size_t& p) const;
+	void skip_page(const size_t& p);
+	int render_items(const Pagination& info,
+	                 const size_t& p,
+	                 std::string& page,
+	                 std::set<Path>& antiDepsOfReadPath,
+	                 std::ostream& eos);
+	void render_items_in_parallel(const size_t& firstPage,
+	                              const std::string& context,
+	                              const std::string& varsBefore,
+	                              const Path& outputPathBackup,
+	                              const std::set<Path>& antiDepsOfReadPath,
+	                              RenderedItems& ahead);
 	int n_read_and_process(const bool& indent,
 	                       const std::string& inStr,
 	                       int lineNo,
@@ -129,6 +162,20 @@ struct Parser
 	                            std::set<Path>& antiDepsOfReadPath,
 	                            std::string& outStr,
 	                            std::ostream& eos);
+	int n_read_and_process(const bool& indent,
+	                       const SegmentedText& segmented,
+	                       int lineNo,
+	                       const Path& readPath,
+	                       std::set<Path> antiDepsOfReadPath,
+	                       std::string& outStr,
+	                       std::ostream& eos);
+	int n_read_and_process_fast(const bool& indent,
+	                            const SegmentedText& segmented,
+	                            int lineNo,
+	                            const Path& readPath,
+	                            std::set<Path>& antiDepsOfReadPath,
+	                            std::string& outStr,
+	                            std::ostream& eos);
 	int n_read_and_process_fast(const bool& indent,
 	                            const bool& addOutput,
 	                            const std::string& inStr,
@@ -137,6 +184,15 @@ struct Parser
 	                            std::set<Path>& antiDepsOfReadPath,
 	                            std::string& outStr,
 	                            std::ostream& eos);
+	int n_read_and_process_fast(const bool& indent,
+	                            const bool& addOutput,
+	                            const std::string& inStr,
+	                            const SegmentedText* segmented,
+	                            int lineNo,
+	                            const Path& readPath,
+	                            std::set<Path>& antiDepsOfReadPath,
+	                            std::string& outStr,
+	                            std::ostream& eos);
 	int f_read_and_process(const bool& addOutput,
 	                       const std::string& inStr,
 	                       int lineNo,
@@ -152,10 +208,12 @@ struct Parser
 	                            std::string& outStr,
 	                            std::ostream& eos);
 	int read_and_process_fn(const bool& indent,
-	                        const std::string& baseIndentAmount,
+	                        const Indent& baseIndentAmount,
 	                        const char& lang,
 	                        const bool& addOutput,
 	                        const std::string& inStr,
+	                        const SegmentedText* segmented,
+	                        const CallToken* token,
 	                        int& lineNo,
 	                        size_t& linePos,
 	                        const Path& readPath,
@@ -163,6 +221,139 @@ struct Parser
 	                        std::string& outStr,
 	                        std::ostream& eos);
 
+	//reads calls and blocks ahead of time when splitting up text (see TemplateCache.h)
+	int tokenise_call(const std::string& inStr, const size_t& pos, CallToken& call);
+	void tokenise_blocks(SegmentedText& segmented, const CallToken& call);
+	int tokenise_block(SegmentedText& segmented, size_t& linePos);
+
+	//builtin handlers, called by read_and_process_fn through the builtin table (see Builtins.cpp)
+	int builtin_dollar(FnCall& call);
+	int builtin_input(FnCall& call);
+	int builtin_item(FnCall& call);
+	int builtin_include(FnCall& call);
+	int builtin_if(FnCall& call);
+	int builtin_is_const(FnCall& call);
+	int builtin_is_private(FnCall& call);
+	int builtin_imginclude(FnCall& call);
+	int builtin_in(FnCall& call);
+	int builtin_lua(FnCall& call);
+	int builtin_lua_api(FnCall& call);
+	int builtin_link(FnCall& call);
+	int builtin_layer(FnCall& call);
+	int builtin_lst(FnCall& call);
+	int builtin_lolcat(FnCall& call);
+	int builtin_lolcat_cmd(FnCall& call);
+	int builtin_lolcat_on(FnCall& call);
+	int builtin_lolcat_off(FnCall& call);
+	int builtin_lolcat_status(FnCall& call);
+	int builtin_pathto(FnCall& call);
+	int builtin_pathtopage(FnCall& call);
+	int builtin_pathtopageno(FnCall& call);
+	int builtin_pathtofile(FnCall& call);
+	int builtin_private(FnCall& call);
+	int builtin_paginate(FnCall& call);
+	int builtin_paginate_no_items_per_page(FnCall& call);
+	int builtin_paginate_separator(FnCall& call);
+	int builtin_paginate_template(FnCall& call);
+	int builtin_parse(FnCall& call);
+	int builtin_precision(FnCall& call);
+	int builtin_pwd(FnCall& call);
+	int builtin_poke(FnCall& call);
+	int builtin_prompt_char(FnCall& call);
+	int builtin_content(FnCall& call);
+	int builtin_continue(FnCall& call);
+	int builtin_cpy(FnCall& call);
+	int builtin_const(FnCall& call);
+	int builtin_cd(FnCall& call);
+	int builtin_console(FnCall& call);
+	int builtin_console_lock(FnCall& call);
+	int builtin_console_unlock(FnCall& call);
+	int builtin_console_locked(FnCall& call);
+	int builtin_cssinclude(FnCall& call);
+	int builtin_not(FnCall& call);
+	int builtin_not_equal(FnCall& call);
+	int builtin_or(FnCall& call);
+	int builtin_and(FnCall& call);
+	int builtin_equal(FnCall& call);
+	int builtin_assign(FnCall& call);
+	int builtin_less(FnCall& call);
+	int builtin_less_equal(FnCall& call);
+	int builtin_greater(FnCall& call);
+	int builtin_greater_equal(FnCall& call);
+	int builtin_add(FnCall& call);
+	int builtin_add_assign(FnCall& call);
+	int builtin_pre_increment(FnCall& call);
+	int builtin_post_increment(FnCall& call);
+	int builtin_subtract(FnCall& call);
+	int builtin_subtract_assign(FnCall& call);
+	int builtin_pre_decrement(FnCall& call);
+	int builtin_post_decrement(FnCall& call);
+	int builtin_multiply(FnCall& call);
+	int builtin_multiply_assign(FnCall& call);
+	int builtin_divide(FnCall& call);
+	int builtin_divide_assign(FnCall& call);
+	int builtin_mod(FnCall& call);
+	int builtin_mod_assign(FnCall& call);
+	int builtin_ternary(FnCall& call);
+	int builtin_define(FnCall& call);
+	int builtin_hash(FnCall& call);
+	int builtin_getline(FnCall& call);
+	int builtin_getenv(FnCall& call);
+	int builtin_write(FnCall& call);
+	int builtin_while(FnCall& call);
+	int builtin_warning(FnCall& call);
+	int builtin_read(FnCall& call);
+	int builtin_rmv(FnCall& call);
+	int builtin_return(FnCall& call);
+	int builtin_replace_all(FnCall& call);
+	int builtin_refresh_completions(FnCall& call);
+	int builtin_replace_vars(FnCall& call);
+	int builtin_break(FnCall& call);
+	int builtin_blank(FnCall& call);
+	int builtin_fpp(FnCall& call);
+	int builtin_for(FnCall& call);
+	int builtin_function(FnCall& call);
+	int builtin_forget(FnCall& call);
+	int builtin_faviconinclude(FnCall& call);
+	int builtin_typeof(FnCall& call);
+	int builtin_exprtk_eval(FnCall& call);
+	int builtin_exprtk(FnCall& call);
+	int builtin_exprtk_compile(FnCall& call);
+	int builtin_exprtk_cache_stats(FnCall& call);
+	int builtin_exprtk_eval_params(FnCall& call);
+	int builtin_exprtk_file(FnCall& call);
+	int builtin_exprtk_load(FnCall& call);
+	int builtin_exprtk_str(FnCall& call);
+	int builtin_exprtk_add_variable(FnCall& call);
+	int builtin_exprtk_add_package(FnCall& call);
+	int builtin_ent(FnCall& call);
+	int builtin_error(FnCall& call);
+	int builtin_exit(FnCall& call);
+	int builtin_dep(FnCall& call);
+	int builtin_do_while(FnCall& call);
+	int builtin_size(FnCall& call);
+	int builtin_substr(FnCall& call);
+	int builtin_struct(FnCall& call);
+	int builtin_vector(FnCall& call);
+	int builtin_stream(FnCall& call);
+	int builtin_script(FnCall& call);
+	int builtin_system(FnCall& call);
+	int builtin_scope(FnCall& call);
+	int builtin_quote(FnCall& call);
+	int builtin_quit(FnCall& call);
+	int builtin_unquote(FnCall& call);
+	int builtin_mve(FnCall& call);
+	int builtin_npp(FnCall& call);
+	int builtin_nsm_lang(FnCall& call);
+	int builtin_nsm_mode(FnCall& call);
+	int builtin_join(FnCall& call);
+	int builtin_jsinclude(FnCall& call);
+	int builtin_vjoin(FnCall& call);
+	int builtin_valid_type(FnCall& call);
+	int builtin_add_member_fns(FnCall& call);
+	int builtin_add_scope(FnCall& call);
+	int call_registered_builtin(FnCall& call);
+
 	inline int skip_whitespace(const bool& checkEOF,
 	                           const std::string& inStr,
 	                           int& lineNo,
@@ -210,6 +401,20 @@ struct Parser
 	                    const int& lineNo,
 	                    std::ostream& eos,
 	                    std::string& outStr);
+	int system_call(const std::string& funcName,
+	                const std::string& sys_call,
+	                const std::vector<std::string>* args,
+	                const int& whereTo,
+	                const bool& noReturnValue,
+	                const double& timeout,
+	                const std::string* cacheKey,
+	                const bool& indent,
+	                const Path& readPath,
+	                std::set<Path>& antiDepsOfReadPath,
+	                const int& sLineNo,
+	                const int& lineNo,
+	                std::ostream& eos,
+	                std::string& outStr);
 
 	int parse_replace(const char& lang,
 	                  std::string& str,
@@ -353,6 +558,16 @@ struct Parser
 	               int& bLineNo,
 	               const std::string& callType,
 	               std::ostream& eos);
+	int read_block(std::string& block,
+	               std::shared_ptr<const SegmentedText>& segmentedBlock,
+	               size_t& linePos,
+	               const std::string& inStr,
+	               const SegmentedText* segmented,
+	               const Path& readPath,
+	               int& lineNo,
+	               int& bLineNo,
+	               const std::string& callType,
+	               std::ostream& eos);
 	int read_block_del(std::string& block,
 	               size_t& linePos,
 	               const std::string& inStr,
@@ -364,10 +579,12 @@ struct Parser
 	int read_else_blocks(std::vector<std::string>& conditions,
 	                     std::vector<int>& cLineNos,
 	                     std::vector<std::string>& blocks,
+	                     std::vector<std::shared_ptr<const SegmentedText> >& segmentedBlocks,
 	                     std::vector<int>& bLineNos,
 	                     std::string& whitespace,
 	                     size_t& linePos,
 	                     const std::string& inStr,
+	                     const SegmentedText* segmented,
 	                     const Path& readPath,
 	                     int& lineNo,
 	                     const std::string& callType,
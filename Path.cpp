@@ -79,6 +79,20 @@ bool Path::modified_after(const Path& path2) const
 		return 0;
 }
 
+//returns whether file was modified after given time
+//a file that can't be stat'd is treated as modified
+bool Path::modified_after(const time_t& time) const
+{
+	struct stat sb;
+	if(stat(str().c_str(), &sb))
+		return 1;
+
+	if(difftime(sb.st_mtime, time) > 0)
+		return 1;
+	else
+		return 0;
+}
+
 Path Path::getDepsPath() const
 {
 	return Path(dir,  strippedExtension(file) + ".deps.json");
@@ -187,7 +201,8 @@ const std::string warnStr = "warning";
 
 std::ostream& start_err(std::ostream& eos)
 {
-	clear_console_line();
+	if(eos.rdbuf())
+		clear_console_line();
 
 	if(&eos == &std::cout)
 		eos << c_red << "\a" << errStr << c_white << ": ";
@@ -199,7 +214,8 @@ std::ostream& start_err(std::ostream& eos)
 
 std::ostream& start_err(std::ostream& eos, const Path& readPath)
 {
-	clear_console_line();
+	if(eos.rdbuf())
+		clear_console_line();
 
 	if(&eos == &std::cout)
 	{
@@ -215,7 +231,8 @@ std::ostream& start_err(std::ostream& eos, const Path& readPath)
 
 std::ostream& start_err(std::ostream& eos, const Path& readPath, const int& lineNo)
 {
-	clear_console_line();
+	if(eos.rdbuf())
+		clear_console_line();
 
 	if(&eos == &std::cout)
 	{
@@ -235,7 +252,8 @@ std::ostream& start_err_ml(std::ostream& eos, const Path& readPath, const int& s
 	if(sLineNo == eLineNo)
 		return start_err(eos, readPath, sLineNo);
 
-	clear_console_line();
+	if(eos.rdbuf())
+		clear_console_line();
 	if(&eos == &std::cout)
 	{
 		eos << c_red << "\a" << errStr << c_white << ": ";
@@ -251,7 +269,8 @@ std::ostream& start_err_ml(std::ostream& eos, const Path& readPath, const int& s
 
 std::ostream& start_warn(std::ostream& eos)
 {
-	clear_console_line();
+	if(eos.rdbuf())
+		clear_console_line();
 
 	if(&eos == &std::cout)
 		eos << c_aqua << "\a" << warnStr << c_white << ": ";
@@ -263,7 +282,8 @@ std::ostream& start_warn(std::ostream& eos)
 
 std::ostream& start_warn(std::ostream& eos, const Path& readPath)
 {
-	clear_console_line();
+	if(eos.rdbuf())
+		clear_console_line();
 
 	if(&eos == &std::cout)
 	{
@@ -279,7 +299,8 @@ std::ostream& start_warn(std::ostream& eos, const Path& readPath)
 
 std::ostream& start_warn(std::ostream& eos, const Path& readPath, const int& lineNo)
 {
-	clear_console_line();
+	if(eos.rdbuf())
+		clear_console_line();
 
 	if(&eos == &std::cout)
 	{
@@ -36,6 +36,8 @@ struct Path
 
 	//returns whether first file was modified after second file
 	bool modified_after(const Path& path2) const;
+	//returns whether file was modified after given time
+	bool modified_after(const time_t& time) const;
 
 	bool ensureDirExists() const;
 	bool ensureFileExists() const;
@@ -60,6 +62,7 @@ bool operator<(const Path& path1, const Path& path2);
 
 void clear_console_line();
 
+//errors written to a stream without a buffer are thrown away without touching the console
 std::ostream& start_err(std::ostream& eos);
 std::ostream& start_err(std::ostream& eos, const Path& readPath);
 std::ostream& start_err(std::ostream& eos, const Path& readPath, const int& lineNo);
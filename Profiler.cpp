@@ -0,0 +1,172 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <iomanip>
+
+Profiler profiler;
+
+static thread_local ProfileThread* cThread = NULL;
+
+Profiler::Profiler()
+{
+	enabled = 0;
+	tracePath = Path(".nift/", "profile.json");
+}
+
+//clears events from any previous build and restarts the clock
+void Profiler::start()
+{
+	mtx.lock();
+	for(size_t t=0; t<threads.size(); ++t)
+		threads[t]->events.clear();
+	origin = std::chrono::steady_clock::now();
+	mtx.unlock();
+}
+
+double Profiler::now() const
+{
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - origin).count();
+}
+
+ProfileThread* Profiler::this_thread()
+{
+	if(!cThread)
+	{
+		mtx.lock();
+		threads.push_back(std::unique_ptr<ProfileThread>(new ProfileThread()));
+		cThread = threads.back().get();
+		cThread->tid = threads.size();
+		mtx.unlock();
+	}
+
+	return cThread;
+}
+
+void Profiler::add(const char* name, const char* cat, const std::string& detail, const double& start)
+{
+	ProfileEvent event;
+	event.name = name;
+	event.cat = cat;
+	event.detail = detail;
+	event.start = start;
+	event.dur = now() - start;
+	this_thread()->events.push_back(event);
+}
+
+static std::string json_escape(const std::string& str)
+{
+	std::string escaped;
+	for(size_t i=0; i<str.size(); ++i)
+	{
+		if(str[i] == '"' || str[i] == '\\')
+			escaped += '\\';
+		else if(str[i] == '\n')
+		{
+			escaped += "\\n";
+			continue;
+		}
+		else if(str[i] == '\t')
+		{
+			escaped += "\\t";
+			continue;
+		}
+		escaped += str[i];
+	}
+	return escaped;
+}
+
+//total time and number of spans for something profiled
+struct ProfileTotal
+{
+	double time;
+	size_t count;
+
+	ProfileTotal()
+	{
+		time = 0;
+		count = 0;
+	}
+};
+
+static void output_slowest(std::ostream& os,
+                           const std::string& heading,
+                           const std::map<std::string, ProfileTotal>& totals,
+                           const size_t& noSlowest)
+{
+	std::vector<std::pair<double, std::string> > slowest;
+	for(auto total=totals.begin(); total!=totals.end(); ++total)
+		slowest.push_back(std::make_pair(total->second.time, total->first));
+	std::sort(slowest.rbegin(), slowest.rend());
+
+	if(!noSlowest || !slowest.size())
+		return;
+
+	os << c_light_blue << heading << c_white << std::endl;
+	for(size_t s=0; s<noSlowest && s<slowest.size(); ++s)
+	{
+		const ProfileTotal& total = totals.at(slowest[s].second);
+		os << " " << slowest[s].second << ": " << std::fixed << std::setprecision(3) << total.time/1000.0 << "ms";
+		if(total.count > 1)
+			os << " (" << total.count << " times)";
+		os << std::endl;
+	}
+}
+
+//writes trace file then outputs slowest pages, inputs and builtins
+int Profiler::save(std::ostream& os, const size_t& noSlowest)
+{
+	std::map<std::string, ProfileTotal> pageTotals, inputTotals, builtinTotals;
+
+	tracePath.ensureDirExists();
+	std::ofstream ofs(tracePath.str());
+	if(!ofs.is_open())
+	{
+		start_err(os, tracePath) << "failed to write profile trace file" << std::endl;
+		return 1;
+	}
+
+	ofs << "{\"traceEvents\": [\n";
+	bool first = 1;
+	for(size_t t=0; t<threads.size(); ++t)
+	{
+		const std::vector<ProfileEvent>& events = threads[t]->events;
+		for(size_t e=0; e<events.size(); ++e)
+		{
+			const ProfileEvent& event = events[e];
+
+			if(!first)
+				ofs << ",\n";
+			first = 0;
+			ofs << "{\"name\": \"" << event.name << "\", \"cat\": \"" << event.cat << "\", \"ph\": \"X\", ";
+			ofs << "\"ts\": " << (long long)event.start << ", \"dur\": " << (long long)event.dur << ", ";
+			ofs << "\"pid\": 1, \"tid\": " << threads[t]->tid;
+			if(event.detail.size())
+				ofs << ", \"args\": {\"detail\": \"" << json_escape(event.detail) << "\"}";
+			ofs << "}";
+
+			ProfileTotal* total = NULL;
+			if(std::string(event.cat) == "page")
+				total = &pageTotals[event.detail];
+			else if(std::string(event.cat) == "input")
+				total = &inputTotals[event.detail];
+			else if(std::string(event.cat) == "builtin")
+				total = &builtinTotals[event.name];
+			if(total)
+			{
+				total->time += event.dur;
+				total->count++;
+			}
+		}
+	}
+	ofs << "\n]}\n";
+	ofs.close();
+
+	output_slowest(os, "slowest files to build:", pageTotals, noSlowest);
+	output_slowest(os, "slowest templates and inputs:", inputTotals, noSlowest);
+	output_slowest(os, "slowest builtins:", builtinTotals, noSlowest);
+	os.unsetf(std::ios::floatfield);
+	os.precision(4);
+	os << "profile trace written to " << tracePath << ", open with about:tracing or ui.perfetto.dev" << std::endl;
+
+	return 0;
+}
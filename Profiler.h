@@ -0,0 +1,91 @@
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "FileSystem.h"
+
+//span of time spent doing something, times are in microseconds since profiling started
+struct ProfileEvent
+{
+	const char *name, *cat;
+	std::string detail;
+	double start, dur;
+};
+
+//events are recorded per thread so recording never needs a lock
+struct ProfileThread
+{
+	size_t tid;
+	std::vector<ProfileEvent> events;
+};
+
+/*
+	records spans of build work (per page, per thread) when builds are run
+	with --profile, then writes them as a Chrome about:tracing/Perfetto json
+	file along with a summary of the slowest pages, inputs and builtins
+*/
+struct Profiler
+{
+	bool enabled;
+	std::chrono::steady_clock::time_point origin;
+	std::mutex mtx;
+	std::vector<std::unique_ptr<ProfileThread> > threads;
+	Path tracePath;
+
+	Profiler();
+
+	void start();
+	double now() const;
+	ProfileThread* this_thread();
+	void add(const char* name, const char* cat, const std::string& detail, const double& start);
+	int save(std::ostream& os, const size_t& noSlowest);
+};
+
+extern Profiler profiler;
+
+//records the span from construction to destruction if profiling is enabled
+struct ProfileSpan
+{
+	const char *name, *cat;
+	std::string detail;
+	double start;
+	bool on;
+
+	ProfileSpan(const char* Name, const char* Cat)
+	{
+		on = profiler.enabled;
+		if(on)
+		{
+			name = Name;
+			cat = Cat;
+			start = profiler.now();
+		}
+	}
+
+	ProfileSpan(const char* Name, const char* Cat, const std::string& Detail)
+	{
+		on = profiler.enabled;
+		if(on)
+		{
+			name = Name;
+			cat = Cat;
+			detail = Detail;
+			start = profiler.now();
+		}
+	}
+
+	~ProfileSpan()
+	{
+		if(on)
+			profiler.add(name, cat, detail, start);
+	}
+};
+
+#endif //PROFILER_H_
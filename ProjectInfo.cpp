@@ -84,6 +84,7 @@ int create_config_file(const Path& configPath, const std::string& outputExt, boo
 	project.paginateThreads = -1;
 
 	project.incrMode = INCR_MOD;
+	project.buildStateMode = BSTATE_FILES;
 
 	project.terminal = "normal";
 
@@ -685,6 +686,16 @@ int ProjectInfo::open_config(const Path& configPath, const bool& global, const b
 			incrMode = INCR_HASH;
 		else if(incrModeStr == "hybrid")
 			incrMode = INCR_HYB;
+
+		std::string buildStateStr;
+		if(obj.HasMember("build-state") && obj["build-state"].IsString())
+			buildStateStr = obj["build-state"].GetString();
+
+		if(buildStateStr == "database")
+			buildStateMode = BSTATE_DB;
+		else
+			buildStateMode = BSTATE_FILES;
+		buildState.enabled = (buildStateMode == BSTATE_DB);
 	}
 
 	if(obj.HasMember("lolcat-default") && obj["lolcat-default"].IsBool())
@@ -989,6 +1000,10 @@ int ProjectInfo::save_config(const std::string& configPathStr, const bool& globa
 			ofs << "\t\t\"incremental-mode\": \"hash\",\n";
 		else 
 			ofs << "\t\t\"incremental-mode\": \"modified\",\n";
+		if(buildStateMode == BSTATE_DB)
+			ofs << "\t\t\"build-state\": \"database\",\n";
+		else
+			ofs << "\t\t\"build-state\": \"files\",\n";
 		ofs << "\t\t\"root-branch\": \"" << rootBranch << "\",\n";
 		ofs << "\t\t\"output-branch\": \"" << outputBranch << "\",\n";
 	}
@@ -1463,6 +1478,15 @@ int ProjectInfo::remove_hash_files()
 
 	std::cout << "removing hashes.." << std::endl;
 
+	if(buildStateMode == BSTATE_DB)
+	{
+		buildState.enabled = 1;
+		if(buildState.open(std::cout))
+			return 1;
+		buildState.clear_hashes();
+		return buildState.commit(trackedAll, std::cout);
+	}
+
 	Path dep, infoPath;
 	std::string str;
 	for(auto cInfo=trackedAll.begin(); cInfo!=trackedAll.end(); ++cInfo)
@@ -1500,6 +1524,219 @@ int ProjectInfo::remove_hash_files()
 	return 0;
 }
 
+//folds build state fragments from sharded builds into the project's build state
+int ProjectInfo::merge_build_state(std::vector<Path> fragmentPaths)
+{
+	if(buildStateMode != BSTATE_DB)
+	{
+		start_err(std::cout) << "merge-build-state: build state is " << quote("files") << ", shards write info and hash files under .nift/ which can be copied together instead" << std::endl;
+		return 1;
+	}
+
+	if(open_tracking(1) || buildState.open(std::cout))
+		return 1;
+
+	//defaults to all fragments left by sharded builds
+	if(!fragmentPaths.size())
+	{
+		std::vector<std::string> files = lsVec(".nift/");
+		std::sort(files.begin(), files.end());
+		for(size_t f=0; f<files.size(); ++f)
+			if(files[f].substr(0, 18) == "build-state.shard-" && files[f].size() > 3 && files[f].substr(files[f].size()-3, 3) == ".db")
+				fragmentPaths.push_back(Path(".nift/", files[f]));
+	}
+
+	if(!fragmentPaths.size())
+	{
+		start_err(std::cout) << "merge-build-state: no build state fragments found, they are written by build-all --shard i/n" << std::endl;
+		return 1;
+	}
+
+	//carries on past fragments that fail so the rest are still merged
+	int result = 0;
+	size_t noMerged = 0;
+	for(size_t f=0; f<fragmentPaths.size(); ++f)
+	{
+		if(buildState.merge(fragmentPaths[f], trackedAll, std::cout))
+			result = 1;
+		else
+			++noMerged;
+	}
+
+	if(buildState.commit(trackedAll, std::cout))
+		return 1;
+
+	if(noMerged == 1)
+		std::cout << "merged 1 build state fragment" << std::endl;
+	else
+		std::cout << "merged " << noMerged << " build state fragments" << std::endl;
+
+	return result;
+}
+
+int ProjectInfo::set_build_state(const std::string& modeStr)
+{
+	if(open_tracking(1))
+		return 1;
+
+	Path infoPath;
+
+	if(modeStr == "database")
+	{
+		if(buildStateMode == BSTATE_DB)
+		{
+			start_err(std::cout) << "set_build_state: build state is already " << quote(modeStr) << std::endl;
+			return 1;
+		}
+
+		std::cout << "migrating info and hash files to " << buildState.dbPath << ".." << std::endl;
+
+		buildState.enabled = 1;
+		if(buildState.open(std::cout))
+			return 1;
+
+		std::set<Path> hashPaths;
+		for(auto cInfo=trackedAll.begin(); cInfo!=trackedAll.end(); ++cInfo)
+		{
+			infoPath = cInfo->outputPath.getInfoPath();
+
+			if(!file_exists(infoPath.str()))
+				continue;
+
+			rapidjson::Document doc;
+			doc.Parse(string_from_file(infoPath.str()).c_str());
+
+			if(!doc.IsObject() ||
+			   !doc.HasMember("name") || !doc["name"].IsString() ||
+			   !doc.HasMember("title") || !doc["title"].IsString() ||
+			   !doc.HasMember("template") || !doc["template"].IsString() ||
+			   !doc.HasMember("dependencies") || !doc["dependencies"].IsArray())
+			{
+				start_warn(std::cout, infoPath) << "skipping invalid page info file, page will be rebuilt" << std::endl;
+				continue;
+			}
+
+			PageRecord record;
+			record.name = doc["name"].GetString();
+			record.title = doc["title"].GetString();
+			record.templatePath = doc["template"].GetString();
+
+			struct stat sb;
+			stat(infoPath.str().c_str(), &sb);
+			record.builtTime = sb.st_mtime;
+
+			std::vector<std::string> deps;
+			rapidjson::Value arr(rapidjson::kArrayType);
+			arr = doc["dependencies"].GetArray();
+			for(auto depStr=arr.Begin(); depStr!=arr.End(); ++depStr)
+			{
+				if(!depStr->IsString())
+					continue;
+
+				deps.push_back(depStr->GetString());
+
+				//hashes from hash files have no fingerprint so get checked against content next build
+				Path dep(deps.back()), hashPath = dep.getHashPath();
+				if(file_exists(hashPath.str()))
+				{
+					DepFingerprint fp;
+					fp.hash = std::atoi(string_from_file(hashPath.str()).c_str());
+					fp.hashed = 1;
+					buildState.set_fingerprint(dep, fp);
+					hashPaths.insert(hashPath);
+				}
+			}
+
+			buildState.set_page(cInfo->outputPath.str(), record, deps);
+		}
+
+		if(buildState.commit(trackedAll, std::cout))
+			return 1;
+
+		//removes migrated info and hash files
+		for(auto cInfo=trackedAll.begin(); cInfo!=trackedAll.end(); ++cInfo)
+		{
+			infoPath = cInfo->outputPath.getInfoPath();
+			if(file_exists(infoPath.str()))
+			{
+				chmod(infoPath.str().c_str(), 0666);
+				remove_path(infoPath);
+			}
+		}
+		for(auto hashPath=hashPaths.begin(); hashPath!=hashPaths.end(); ++hashPath)
+			remove_path(*hashPath);
+
+		buildStateMode = BSTATE_DB;
+	}
+	else if(modeStr == "files")
+	{
+		if(buildStateMode == BSTATE_FILES)
+		{
+			start_err(std::cout) << "set_build_state: build state is already " << quote(modeStr) << std::endl;
+			return 1;
+		}
+
+		std::cout << "migrating " << buildState.dbPath << " to info and hash files.." << std::endl;
+
+		buildState.enabled = 1;
+		if(buildState.open(std::cout))
+			return 1;
+
+		PageRecord record;
+		std::vector<Path> deps;
+		std::vector<std::string> depStrs;
+		for(auto cInfo=trackedAll.begin(); cInfo!=trackedAll.end(); ++cInfo)
+		{
+			if(!buildState.get_page(cInfo->outputPath, record, deps))
+				continue;
+
+			char lastBuilt[80];
+			time_t builtTime = record.builtTime;
+			struct tm tstruct = *localtime(&builtTime);
+			strftime(lastBuilt, sizeof(lastBuilt), "%X %A %B %d %Y", &tstruct);
+
+			depStrs.clear();
+			for(auto dep=deps.begin(); dep!=deps.end(); ++dep)
+			{
+				depStrs.push_back(dep->str());
+
+				DepFingerprint fp;
+				if(buildState.get_fingerprint(*dep, fp))
+				{
+					Path hashPath = dep->getHashPath();
+					hashPath.ensureDirExists();
+					std::ofstream ofs(hashPath.str());
+					ofs << fp.hash << "\n";
+					ofs.close();
+				}
+			}
+
+			//info file modified time is used as the time the page was last built
+			infoPath = cInfo->outputPath.getInfoPath();
+			write_info_file(infoPath, lastBuilt, record.name, record.title, record.templatePath, depStrs);
+			set_modified_time(infoPath.str(), builtTime);
+		}
+
+		if(file_exists(buildState.dbPath.str()))
+			remove_path(buildState.dbPath);
+		buildState.clear();
+		buildState.enabled = 0;
+
+		buildStateMode = BSTATE_FILES;
+	}
+	else
+	{
+		start_err(std::cout) << "set_build_state: do not recognise build state " << quote(modeStr) << std::endl;
+		return 1;
+	}
+
+	save_local_config();
+
+	std::cout << "successfully changed build state to " << quote(modeStr) << std::endl;
+
+	return 0;
+}
+
 bool ProjectInfo::tracking(const TrackedInfo& trackedInfo)
 {
 	return trackedAll.count(trackedInfo);
@@ -3808,65 +4045,55 @@ void build_progress(const int& no_to_build, const int& addBuildStatus)
 	}
 }
 
-std::atomic<size_t> paginationCounter;
-
-void pagination_thread(const Pagination& pagesInfo,
-                       const std::string& paginateName,
-                       const std::string& outputExt,
-                       const Path& mainOutputPath)
+//writes page cPageNo of pagination to its output file
+void pagination_task(Pagination& pagesInfo,
+                     const size_t& cPageNo,
+                     const std::string& outputExt,
+                     const Path& mainOutputPath,
+                     std::ostream& eos,
+                     std::atomic<bool>& writeFailed)
 {
-	std::string pageStr;
-	size_t cPageNo;
+	const std::string& page = pagesInfo.pages[cPageNo];
+	std::string indentStr = pagesInfo.indentAmount.str();
 
-	while(1)
+	//splices the page into the parsed output, indenting each new line
+	OutputSink pageSink;
+	pageSink.splice(pagesInfo.splitFile, 0, pagesInfo.splitStart);
+	size_t linePos = 0, endPos;
+	while((endPos = page.find('\n', linePos)) != std::string::npos)
 	{
-		cPageNo = paginationCounter++;
-		if(cPageNo >= pagesInfo.noPages)
-			break;
-
-		std::istringstream iss(pagesInfo.pages[cPageNo]);
-		std::string issLine;
-		int fileLineNo = 0;
-
-		pageStr = pagesInfo.splitFile.first;
-
-		while(!iss.eof())
-		{
-			getline(iss, issLine);
-			if(0 < fileLineNo++)
-				pageStr += "\n" + pagesInfo.indentAmount;
-			pageStr += issLine;
-		}
-
-		pageStr += pagesInfo.splitFile.second;
-
-		Path outputPath = mainOutputPath;
-		if(cPageNo)
-			outputPath.file = paginateName + std::to_string(cPageNo+1) + outputExt;
-
-		chmod(outputPath.str().c_str(), 0666);
-
-		//removing file here gives significant speed improvements
-		//same improvements NOT observed for output files or info files at scale
-		//not sure why!
-		remove_file(outputPath); 
+		pageSink.splice(page, linePos, endPos + 1 - linePos);
+		pageSink.splice(indentStr);
+		linePos = endPos + 1;
+	}
+	pageSink.splice(page, linePos, page.size() - linePos);
+	pageSink.splice(pagesInfo.splitFile, pagesInfo.splitEnd, pagesInfo.splitFile.size() - pagesInfo.splitEnd);
+	pageSink.splice("\n", 1);
 
-		std::ofstream ofs(outputPath.str());
-		ofs << pageStr << "\n";
-		ofs.close();
+	ProfileSpan pageSpan("write page", "pagination", pagesInfo.paginateName);
 
-		chmod(outputPath.str().c_str(), 0444);
+	Path outputPath = mainOutputPath;
+	if(cPageNo)
+		outputPath.file = pagesInfo.paginateName + std::to_string(cPageNo+1) + outputExt;
 
-		estNoPagesFinished = estNoPagesFinished + 0.55;
-		noPagesFinished++;
+	//pages which haven't changed are left alone
+	if(outputWriter.write(outputPath, pageSink))
+	{
+		os_mtx.lock();
+		start_err(eos) << "failed to write paginated output file " << outputPath << std::endl;
+		os_mtx.unlock();
+		writeFailed = 1;
+		return;
 	}
+	pagesInfo.set_output(cPageNo, outputPath);
 
+	estNoPagesFinished = estNoPagesFinished + 0.55;
+	noPagesFinished++;
 }
 
 void build_thread(std::ostream& eos,
-                  const int& no_paginate_threads,
                   std::set<TrackedInfo>* trackedAll,
-                  const int& no_to_build,
+                  const size_t& worker,
                   const Directory& ContentDir,
                   const Directory& OutputDir,
                   const std::string& ContentExt,
@@ -3889,18 +4116,12 @@ void build_thread(std::ostream& eos,
 	              UnixTextEditor, 
 	              WinTextEditor);
 	std::set<TrackedInfo>::iterator cInfo;
+	Timer pageTimer;
 
-	while(counter < no_to_build)
+	while(pageScheduler.next(worker, cInfo))
 	{
-		set_mtx.lock();
-		if(counter >= no_to_build)
-		{
-			set_mtx.unlock();
-			return;
-		}
-		counter++;
-		cInfo = nextInfo++;
-		set_mtx.unlock();
+		ProfileSpan pageSpan("build", "page", cInfo->name);
+		pageTimer.start();
 
 		int result = parser.build(*cInfo, estNoPagesFinished, noPagesToBuild, eos);
 
@@ -3910,49 +4131,87 @@ void build_thread(std::ostream& eos,
 		{
 			Path outputPathBackup = parser.toBuild.outputPath;
 
-			std::string innerPageStr;
+			std::string innerPageStr, varsBefore;
 			std::set<Path> antiDepsOfReadPath;
 			for(size_t p=0; p<parser.pagesInfo.noPages; ++p)
 			{
-				
+				if(parser.pagesInfo.skipped[p])
+				{
+					estNoPagesFinished = estNoPagesFinished + 0.4;
+					continue;
+				}
+
+				ProfileSpan paginateSpan("paginate", "pagination");
 				if(p)
 					parser.toBuild.outputPath.file = parser.pagesInfo.paginateName + std::to_string(p+1) + parser.outputExt;
 				antiDepsOfReadPath.clear();
 				parser.pagesInfo.cPageNo = p+1;
 				innerPageStr = parser.pagesInfo.templateStr;
-				result = parser.parse_replace('n', 
-				                       innerPageStr, 
-				                       "pagination template string", 
-				                       parser.pagesInfo.callPath, 
-				                       antiDepsOfReadPath, 
-				                       parser.pagesInfo.templateLineNo, 
-				                       "paginate.template", 
-				                       parser.pagesInfo.templateCallLineNo, 
-				                       eos);
-				if(result)
+				parser.depFiles.clear();
+				parser.volatileRead = parser.exprCache.volatileUsed = 0;
+				varsBefore = parser.vars.fingerprint();
+				if(parser.parse_replace('n', 
+				                        innerPageStr, 
+				                        "pagination template string", 
+				                        parser.pagesInfo.callPath, 
+				                        antiDepsOfReadPath, 
+				                        parser.pagesInfo.templateLineNo, 
+				                        "paginate.template", 
+				                        parser.pagesInfo.templateCallLineNo, 
+				                        eos))
 				{
 					if(!parser.consoleLocked)
 						parser.os_mtx->lock();
 					start_err(eos, parser.pagesInfo.callPath, parser.pagesInfo.callLineNo) << "paginate: failed here" << std::endl;
 					parser.os_mtx->unlock();
+					result = 1;
 					break;
 				}
 
-				parser.pagesInfo.pages[p] = innerPageStr;
+				//pages are always built while the pagination template reads anything volatile or changes variables,
+				//skipping the page would skip the changes later pages rely on
+				if(parser.volatileRead || parser.exprCache.volatileUsed || parser.vars.fingerprint() != varsBefore)
+					parser.pagesInfo.states[p].fingerprint = "";
+				parser.pagesInfo.add_deps(p, parser.depFiles);
+				parser.pagesInfo.pages[p].swap(innerPageStr);
 				estNoPagesFinished = estNoPagesFinished + 0.4;
 			}
 
-			//pagination threads
-			std::vector<std::thread> threads;
-			for(int i=0; i<no_paginate_threads; i++)
-				threads.push_back(std::thread(pagination_thread, 
-				                  parser.pagesInfo,
-				                  parser.pagesInfo.paginateName,
-				                  parser.outputExt,
-				                  outputPathBackup));
+			//pagination tasks write pages straight from parser.pagesInfo rather than copies
+			std::atomic<bool> writeFailed(0);
+			TaskGroup paginationGroup;
+			for(size_t p=0; p<parser.pagesInfo.noPages; ++p)
+			{
+				if(parser.pagesInfo.skipped[p])
+				{
+					outputWriter.noSkipped++;
+					estNoPagesFinished = estNoPagesFinished + 0.55;
+					noPagesFinished++;
+					continue;
+				}
+
+				threadPool.submit(std::bind(pagination_task, 
+				                            std::ref(parser.pagesInfo),
+				                            p,
+				                            std::cref(parser.outputExt),
+				                            std::cref(outputPathBackup),
+				                            std::ref(eos),
+				                            std::ref(writeFailed)),
+				                  &paginationGroup);
+			}
+
+			threadPool.wait(paginationGroup);
+			if(writeFailed)
+				result = 1;
 
-			for(int i=0; i<no_paginate_threads; i++)
-				threads[i].join();
+			//page states are saved once pages are written, for skipping unchanged pages next build
+			if(!result && outputWriter.write(outputPathBackup.getPaginationPath(), parser.pagesInfo.states_json(), ""))
+			{
+				os_mtx.lock();
+				start_err(eos) << "failed to write pagination file " << outputPathBackup.getPaginationPath() << std::endl;
+				os_mtx.unlock();
+				result = 1;
+			}
 		}
 
 		if(result)
@@ -3968,6 +4227,7 @@ void build_thread(std::ostream& eos,
 			built_mtx.unlock();
 		}
 
+		pageScheduler.finished(worker, cInfo->name, pageTimer.getTime());
 		noFinished++;
 	}
 }
@@ -3984,6 +4244,9 @@ int ProjectInfo::build_names(std::ostream& os, const int& addBuildStatus, const
 
 	std::set<Name> untrackedNames, failedNames;
 
+	if(buildState.enabled && buildState.open(os))
+		return 1;
+
 	std::set<TrackedInfo> trackedInfoToBuild;
 	for(auto name=namesToBuild.begin(); name != namesToBuild.end(); ++name)
 	{
@@ -4006,11 +4269,10 @@ int ProjectInfo::build_names(std::ostream& os, const int& addBuildStatus, const
 	              winTextEditor);
 
 	//checks for pre-build scripts
-	if(parser.run_script(os, Path("", "pre-build" + scriptExt), backupScripts, 1))
+	if(parser.run_script(os, Path("", "pre-build" + scriptExt), 1))
 		return 1;
 
-	nextInfo = trackedInfoToBuild.begin();
-	counter = noFinished = estNoPagesFinished = noPagesFinished = 0;
+	noFinished = estNoPagesFinished = noPagesFinished = 0;
 
 	os_mtx.lock();
 	if(addBuildStatus) // should we check if os is std::cout?
@@ -4035,13 +4297,19 @@ int ProjectInfo::build_names(std::ostream& os, const int& addBuildStatus, const
 
 	setIncrMode(incrMode);
 
-	std::vector<std::thread> threads;
+	pageScheduler.open_stats();
+	outputWriter.reset();
+	fileCache.clear();
+	pageScheduler.seed(trackedInfoToBuild, no_threads, 1);
+
+	//build threads run on the process-wide pool, extra threads are there for pagination tasks
+	threadPool.ensure(no_threads + no_paginate_threads);
+	TaskGroup buildGroup;
 	for(int i=0; i<no_threads; i++)
-		threads.push_back(std::thread(build_thread,  
-						  std::ref(std::cout),
-						  no_paginate_threads, 
+		threadPool.submit(std::bind(build_thread, 
+						  std::ref(std::cout), 
 						  &trackedAll, 
-						  trackedInfoToBuild.size(), 
+						  i, 
 						  contentDir, 
 						  outputDir, 
 						  contentExt, 
@@ -4050,13 +4318,12 @@ int ProjectInfo::build_names(std::ostream& os, const int& addBuildStatus, const
 						  defaultTemplate, 
 						  backupScripts, 
 						  unixTextEditor, 
-						  winTextEditor));
+						  winTextEditor), &buildGroup);
 
 	cPhase = BUILD_PHASE;
 	std::thread thrd(build_progress, trackedInfoToBuild.size(), addBuildStatus);
 
-	for(int i=0; i<no_threads; i++)
-		threads[i].join();
+	threadPool.wait(buildGroup);
 	cPhase = END_PHASE;
 
 	thrd.detach();
@@ -4064,6 +4331,12 @@ int ProjectInfo::build_names(std::ostream& os, const int& addBuildStatus, const
 	if(addBuildStatus)
 		clear_console_line();
 
+	pageScheduler.stop();
+	if(buildState.enabled && buildState.commit(trackedAll, os))
+		return 1;
+	pageScheduler.save_stats(trackedAll);
+	outputWriter.report(os);
+
 	if(failedNames.size() || untrackedNames.size())
 	{
 		if(noPagesFinished)
@@ -4124,14 +4397,14 @@ int ProjectInfo::build_names(std::ostream& os, const int& addBuildStatus, const
 		std::cout << c_light_blue << pkgStr << c_white << "all " << namesToBuild.size() << " specified files built successfully" << std::endl;
 
 		//checks for post-build scripts
-		if(parser.run_script(os, Path("", "post-build" + scriptExt), backupScripts, 1))
+		if(parser.run_script(os, Path("", "post-build" + scriptExt), 1))
 			return 1;
 	}
 
 	return 0;
 }
 
-int ProjectInfo::build_all(std::ostream& os, const int& addBuildStatus)
+int ProjectInfo::build_all(std::ostream& os, const int& addBuildStatus, const int& shard, const int& noShards)
 {
 	if(check_watch_dirs())
 		return 1;
@@ -4142,6 +4415,27 @@ int ProjectInfo::build_all(std::ostream& os, const int& addBuildStatus)
 		return 0;
 	}
 
+	//shards only build their own pages, picked by a stable hash of page names
+	std::set<TrackedInfo> shardInfo;
+	const std::set<TrackedInfo>* toBuild = &trackedAll;
+	if(noShards > 1)
+	{
+		for(auto cInfo=trackedAll.begin(); cInfo!=trackedAll.end(); ++cInfo)
+			if(FNVHash(cInfo->name) % noShards == (unsigned int)(shard-1))
+				shardInfo.insert(*cInfo);
+		toBuild = &shardInfo;
+
+		//each shard records its build state to a fragment for merge-build-state
+		if(buildState.enabled)
+		{
+			buildState.dbPath = shard_state_path(shard, noShards);
+			buildState.loaded = 0;
+		}
+	}
+
+	if(buildState.enabled && buildState.open(os))
+		return 1;
+
 	Parser parser(&trackedAll, 
 	              &os_mtx, 
 	              contentDir, 
@@ -4155,16 +4449,18 @@ int ProjectInfo::build_all(std::ostream& os, const int& addBuildStatus)
 	              winTextEditor);
 
 	//checks for pre-build scripts
-	if(parser.run_script(os, Path("", "pre-build" + scriptExt), backupScripts, 1))
+	if(parser.run_script(os, Path("", "pre-build" + scriptExt), 1))
 		return 1;
 
-	nextInfo = trackedAll.begin();
-	counter = noFinished = estNoPagesFinished = noPagesFinished = 0;
+	noFinished = estNoPagesFinished = noPagesFinished = 0;
 
 	os_mtx.lock();
 	if(addBuildStatus)
 		clear_console_line();
-	std::cout << "building project.." << std::endl;
+	if(noShards > 1)
+		std::cout << "building shard " << shard << "/" << noShards << " of project.." << std::endl;
+	else
+		std::cout << "building project.." << std::endl;
 	os_mtx.unlock();
 
 	if(addBuildStatus)
@@ -4184,13 +4480,19 @@ int ProjectInfo::build_all(std::ostream& os, const int& addBuildStatus)
 
 	setIncrMode(incrMode);
 
-	std::vector<std::thread> threads;
+	pageScheduler.open_stats();
+	outputWriter.reset();
+	fileCache.clear();
+	pageScheduler.seed(*toBuild, no_threads, 1);
+
+	//build threads run on the process-wide pool, extra threads are there for pagination tasks
+	threadPool.ensure(no_threads + no_paginate_threads);
+	TaskGroup buildGroup;
 	for(int i=0; i<no_threads; i++)
-		threads.push_back(std::thread(build_thread, 
+		threadPool.submit(std::bind(build_thread, 
 		                              std::ref(std::cout), 
-		                              no_paginate_threads,
 		                              &trackedAll, 
-		                              trackedAll.size(), 
+		                              i, 
 		                              contentDir, 
 		                              outputDir, 
 		                              contentExt, 
@@ -4199,13 +4501,12 @@ int ProjectInfo::build_all(std::ostream& os, const int& addBuildStatus)
 		                              defaultTemplate, 
 		                              backupScripts, 
 		                              unixTextEditor, 
-		                              winTextEditor));
+		                              winTextEditor), &buildGroup);
 
 	cPhase = BUILD_PHASE;
-	std::thread thrd(build_progress, trackedAll.size(), addBuildStatus);
+	std::thread thrd(build_progress, toBuild->size(), addBuildStatus);
 
-	for(int i=0; i<no_threads; i++)
-		threads[i].join();
+	threadPool.wait(buildGroup);
 	cPhase = END_PHASE;
 
 	thrd.detach();
@@ -4213,6 +4514,12 @@ int ProjectInfo::build_all(std::ostream& os, const int& addBuildStatus)
 	if(addBuildStatus)
 		clear_console_line();
 
+	pageScheduler.stop();
+	if(buildState.enabled && buildState.commit(*toBuild, os))
+		return 1;
+	pageScheduler.save_stats(trackedAll);
+	outputWriter.report(os);
+
 	if(failedNames.size() > 0)
 	{
 		if(noPagesFinished)
@@ -4248,10 +4555,13 @@ int ProjectInfo::build_all(std::ostream& os, const int& addBuildStatus)
 
 		if(noPagesFinished)
 			os << "paginated files: " << noPagesFinished << std::endl;
-		os << c_light_blue << pkgStr << c_white << "all " << noFinished << " tracked files built successfully" << std::endl;
+		if(noShards > 1)
+			os << c_light_blue << pkgStr << c_white << "all " << noFinished << " tracked files in shard " << shard << "/" << noShards << " built successfully" << std::endl;
+		else
+			os << c_light_blue << pkgStr << c_white << "all " << noFinished << " tracked files built successfully" << std::endl;
 
 		//checks for post-build scripts
-		if(parser.run_script(os, Path("", "post-build" + scriptExt), backupScripts, 1))
+		if(parser.run_script(os, Path("", "post-build" + scriptExt), 1))
 			return 1;
 	}
 
@@ -4268,31 +4578,43 @@ std::set<TrackedInfo> updatedInfo;
 std::set<Path> modifiedFiles,
                removedFiles;
 
+//page still to have its dependencies checked against the dependency cache
+struct PageCheck
+{
+	std::set<TrackedInfo>::iterator info;
+	time_t builtTime;
+	std::vector<DepStatus*> deps, userDeps;
+	bool updated; //set when found via the reverse dependency index
+
+	PageCheck()
+	{
+		updated = 0;
+	}
+};
+
+std::mutex check_mtx;
+std::vector<PageCheck> pageChecks;
+std::atomic<size_t> nextCheck;
+size_t noChangedDeps, noAffectedPages;
+
 void dep_thread(std::ostream& os,
                 const bool& addExpl,
-                const int& incrMode,
-                const int& no_to_check,
+                const size_t& worker,
                 const Directory& contentDir,
                 const Directory& outputDir,
                 const std::string& contentExt,
                 const std::string& outputExt)
 {
 	std::set<TrackedInfo>::iterator cInfo;
+	PageRecord record;
+	std::vector<Path> deps;
 
-	while(counter < no_to_check)
+	while(pageScheduler.next(worker, cInfo))
 	{
-		set_mtx.lock();
-		if(counter >= no_to_check)
-		{
-			set_mtx.unlock();
-			return;
-		}
-		counter++;
-		cInfo = nextInfo++;
-		set_mtx.unlock();
+		ProfileSpan depSpan("find deps", "deps", cInfo->name);
 
 		//checks whether content and template files exist
-		if(!file_exists(cInfo->contentPath.str()))
+		if(!depCache.listed(cInfo->contentPath))
 		{
 			if(addExpl)
 			{
@@ -4305,7 +4627,7 @@ void dep_thread(std::ostream& os,
 			problem_mtx.unlock();
 			continue;
 		}
-		if(!file_exists(cInfo->templatePath.str()))
+		if(!depCache.listed(cInfo->templatePath))
 		{
 			if(addExpl)
 			{
@@ -4322,8 +4644,39 @@ void dep_thread(std::ostream& os,
 		//gets path of info file from last time output file was built
 		Path infoPath = cInfo->outputPath.getInfoPath();
 
+		if(buildState.enabled)
+		{
+			//checks whether page has a record in the build state database
+			if(!buildState.get_page(cInfo->outputPath, record))
+			{
+				if(addExpl)
+				{
+					os_mtx.lock();
+					os << cInfo->outputPath << ": yet to be built" << std::endl;
+					os_mtx.unlock();
+				}
+				updated_mtx.lock();
+				updatedInfo.insert(*cInfo);
+				updated_mtx.unlock();
+				continue;
+			}
+			//records outlive untracking so also checks output file is still there
+			else if(!depCache.listed(cInfo->outputPath))
+			{
+				if(addExpl)
+				{
+					os_mtx.lock();
+					os << cInfo->outputPath << ": output file does not exist" << std::endl;
+					os_mtx.unlock();
+				}
+				updated_mtx.lock();
+				updatedInfo.insert(*cInfo);
+				updated_mtx.unlock();
+				continue;
+			}
+		}
 		//checks whether info path exists
-		if(!file_exists(infoPath.str()))
+		else if(!file_exists(infoPath.str()))
 		{
 			if(addExpl)
 			{
@@ -4373,66 +4726,116 @@ void dep_thread(std::ostream& os,
 				problem_mtx.unlock();
 				continue;
 			}
+			else if(!doc.HasMember("dependencies") || !doc["dependencies"].IsArray()) 
+			{
+				start_err(std::cout, infoPath) << "page info file has no dependencies array" << std::endl;
+				problem_mtx.lock();
+				problemNames.insert(cInfo->name);
+				problem_mtx.unlock();
+				continue;
+			}
 
-			TrackedInfo prevInfo = make_info(
-				doc["name"].GetString(), 
-				Title(doc["title"].GetString()), 
-				Path(doc["template"].GetString()), 
-				contentDir, 
-				outputDir, 
-				contentExt, 
-				outputExt
-			);
-			//note we haven't checked for non-default content/output extension, pretty sure we don't need to here
+			record.name = doc["name"].GetString();
+			record.title = doc["title"].GetString();
+			record.templatePath = doc["template"].GetString();
 
+			struct stat sb;
+			stat(infoPath.str().c_str(), &sb);
+			record.builtTime = sb.st_mtime;
 
-			if(cInfo->name != prevInfo.name)
+			rapidjson::Value arr(rapidjson::kArrayType);
+			arr = doc["dependencies"].GetArray();
+
+			deps.clear();
+			for(auto depStr=arr.Begin(); depStr!=arr.End(); ++depStr) 
 			{
-				if(addExpl)
+				if(!depStr->IsString()) 
 				{
-					os_mtx.lock();
-					os << cInfo->outputPath << ": name changed to " << cInfo->name << " from " << prevInfo.name << std::endl;
-					os_mtx.unlock();
+					start_err(std::cout, infoPath) << "dependencies array has non-string element" << std::endl;
+					problem_mtx.lock();
+					problemNames.insert(cInfo->name);
+					problem_mtx.unlock();
+					continue;
 				}
-				updated_mtx.lock();
-				updatedInfo.insert(*cInfo);
-				updated_mtx.unlock();
-				continue;
+
+				deps.push_back(Path(depStr->GetString()));
 			}
+		}
 
-			if(cInfo->title != prevInfo.title)
+		TrackedInfo prevInfo = make_info(
+			record.name, 
+			Title(record.title), 
+			Path(record.templatePath), 
+			contentDir, 
+			outputDir, 
+			contentExt, 
+			outputExt
+		);
+		//note we haven't checked for non-default content/output extension, pretty sure we don't need to here
+
+		if(cInfo->name != prevInfo.name)
+		{
+			if(addExpl)
 			{
-				if(addExpl)
-				{
-					os_mtx.lock();
-					os << cInfo->outputPath << ": title changed to " << cInfo->title << " from " << prevInfo.title << std::endl;
-					os_mtx.unlock();
-				}
-				updated_mtx.lock();
-				updatedInfo.insert(*cInfo);
-				updated_mtx.unlock();
-				continue;
+				os_mtx.lock();
+				os << cInfo->outputPath << ": name changed to " << cInfo->name << " from " << prevInfo.name << std::endl;
+				os_mtx.unlock();
 			}
+			updated_mtx.lock();
+			updatedInfo.insert(*cInfo);
+			updated_mtx.unlock();
+			continue;
+		}
 
-			if(cInfo->templatePath != prevInfo.templatePath)
+		if(cInfo->title != prevInfo.title)
+		{
+			if(addExpl)
 			{
-				if(addExpl)
-				{
-					os_mtx.lock();
-					os << cInfo->outputPath << ": template path changed to " << cInfo->templatePath << " from " << prevInfo.templatePath << std::endl;
-					os_mtx.unlock();
-				}
-				updated_mtx.lock();
-				updatedInfo.insert(*cInfo);
-				updated_mtx.unlock();
-				continue;
+				os_mtx.lock();
+				os << cInfo->outputPath << ": title changed to " << cInfo->title << " from " << prevInfo.title << std::endl;
+				os_mtx.unlock();
+			}
+			updated_mtx.lock();
+			updatedInfo.insert(*cInfo);
+			updated_mtx.unlock();
+			continue;
+		}
+
+		if(cInfo->templatePath != prevInfo.templatePath)
+		{
+			if(addExpl)
+			{
+				os_mtx.lock();
+				os << cInfo->outputPath << ": template path changed to " << cInfo->templatePath << " from " << prevInfo.templatePath << std::endl;
+				os_mtx.unlock();
 			}
+			updated_mtx.lock();
+			updatedInfo.insert(*cInfo);
+			updated_mtx.unlock();
+			continue;
+		}
+
+		PageCheck check;
+		check.info = cInfo;
+		check.builtTime = record.builtTime;
+		//with the build state database changed dependencies are expanded to pages using the reverse index instead
+		if(!buildState.enabled)
+			for(auto dep=deps.begin(); dep!=deps.end(); ++dep) 
+				check.deps.push_back(depCache.add(*dep));
 
+		//checks for user-defined dependencies
+		Path depsPath = cInfo->contentPath.getDepsPath();
+
+		if(depCache.listed(depsPath))
+		{
+			rapidjson::Document doc;
 			rapidjson::Value arr(rapidjson::kArrayType);
 
+			doc.Parse(string_from_file(depsPath.str()).c_str());
+
 			if(!doc.HasMember("dependencies") || !doc["dependencies"].IsArray()) 
 			{
-				start_err(std::cout, infoPath) << "page info file has no dependencies array" << std::endl;
+				start_err(std::cout, depsPath) << "deps file has no dependencies array" << std::endl;
 				problem_mtx.lock();
 				problemNames.insert(cInfo->name);
 				problem_mtx.unlock();
@@ -4441,164 +4844,292 @@ void dep_thread(std::ostream& os,
 
 			arr = doc["dependencies"].GetArray();
 
-			for(auto depStr=arr.Begin(); depStr!=arr.End(); ++depStr) 
+			for(auto it=arr.Begin(); it!=arr.End(); ++it)
 			{
-				if(!depStr->IsString()) 
+				if(!it->IsString()) 
 				{
-					start_err(std::cout, infoPath) << "dependencies array has non-string element" << std::endl;
+					start_err(std::cout, depsPath) << "dependencies array has non-string element" << std::endl;
 					problem_mtx.lock();
 					problemNames.insert(cInfo->name);
 					problem_mtx.unlock();
 					continue;
 				}
 
-				Path dep(depStr->GetString());
+				check.userDeps.push_back(depCache.add(Path(it->GetString())));
+			}
+		}
+
+		check_mtx.lock();
+		pageChecks.push_back(check);
+		check_mtx.unlock();
+	}
+}
 
-				if(!file_exists(dep.str()))
+//checks dependencies of pages against statuses from the dependency cache
+void dep_check_thread(std::ostream& os,
+                      const bool& addExpl,
+                      const int& incrMode)
+{
+	size_t c;
+	while((c = nextCheck++) < pageChecks.size())
+	{
+		const PageCheck& check = pageChecks[c];
+		std::set<TrackedInfo>::iterator cInfo = check.info;
+		bool updated = check.updated;
+
+		for(auto dep=check.deps.begin(); !updated && dep!=check.deps.end(); ++dep) 
+		{
+			const DepStatus& status = **dep;
+
+			if(!status.exists)
+			{
+				if(addExpl)
 				{
-					if(addExpl)
-					{
-						os_mtx.lock();
-						os << cInfo->outputPath << ": dependency path " << dep << " removed since last build" << std::endl;
-						os_mtx.unlock();
-					}
-					removed_mtx.lock();
-					removedFiles.insert(dep);
-					removed_mtx.unlock();
-					updated_mtx.lock();
-					updatedInfo.insert(*cInfo);
-					updated_mtx.unlock();
-					break;
+					os_mtx.lock();
+					os << cInfo->outputPath << ": dependency path " << status.path << " removed since last build" << std::endl;
+					os_mtx.unlock();
 				}
-				else if(incrMode != INCR_HASH && dep.modified_after(infoPath))
+				removed_mtx.lock();
+				removedFiles.insert(status.path);
+				removed_mtx.unlock();
+				updated = 1;
+				break;
+			}
+			else if(incrMode != INCR_HASH && difftime(status.mtime, check.builtTime) > 0)
+			{
+				if(addExpl)
 				{
-					if(addExpl)
-					{
-						os_mtx.lock();
-						os << cInfo->outputPath << ": dependency path " << dep << " modified since last build" << std::endl;
-						os_mtx.unlock();
-					}
-					modified_mtx.lock();
-					modifiedFiles.insert(dep);
-					modified_mtx.unlock();
-					updated_mtx.lock();
-					updatedInfo.insert(*cInfo);
-					updated_mtx.unlock();
-					break;
+					os_mtx.lock();
+					os << cInfo->outputPath << ": dependency path " << status.path << " modified since last build" << std::endl;
+					os_mtx.unlock();
 				}
-				else if(incrMode != INCR_MOD)
+				modified_mtx.lock();
+				modifiedFiles.insert(status.path);
+				modified_mtx.unlock();
+				updated = 1;
+				break;
+			}
+			else if(incrMode != INCR_MOD && !status.isDir && !status.hashRecorded)
+			{
+				if(addExpl)
 				{
-					//gets path of info file from last time output file was built
-					Path hashPath = dep.getHashPath();
-					std::string hashPathStr = hashPath.str();
-
-					if(!file_exists(hashPathStr))
-					{
-						if(addExpl)
-						{
-							os_mtx.lock();
-							os << cInfo->outputPath << ": " << "hash file " << hashPath << " does not exist" << std::endl;
-							os_mtx.unlock();
-						}
-						updated_mtx.lock();
-						updatedInfo.insert(*cInfo);
-						updated_mtx.unlock();
-						break;
-					}
-					else if((unsigned) std::atoi(string_from_file(hashPathStr).c_str()) != FNVHash(string_from_file(dep.str())))
-					{
-						if(addExpl)
-						{
-							os_mtx.lock();
-							os << cInfo->outputPath << ": dependency path " << dep << " modified since last build" << std::endl;
-							os_mtx.unlock();
-						}
-						modified_mtx.lock();
-						modifiedFiles.insert(dep);
-						modified_mtx.unlock();
-						updated_mtx.lock();
-						updatedInfo.insert(*cInfo);
-						updated_mtx.unlock();
-						break;
-					}
+					os_mtx.lock();
+					os << cInfo->outputPath << ": " << "no hash recorded for dependency path " << status.path << std::endl;
+					os_mtx.unlock();
 				}
+				updated = 1;
+				break;
 			}
-
-			//checks for user-defined dependencies
-			Path depsPath = cInfo->contentPath.getDepsPath();
-			Path dep;
-
-			if(file_exists(depsPath.str()))
+			else if(incrMode != INCR_MOD && !status.isDir && status.hashChanged)
 			{
-				rapidjson::Document doc;
-				rapidjson::Value arr(rapidjson::kArrayType);
-
-				doc.Parse(string_from_file(depsPath.str()).c_str());
-
-				if(!doc.HasMember("dependencies") || !doc["dependencies"].IsArray()) 
+				if(addExpl)
 				{
-					start_err(std::cout, depsPath) << "deps file has no dependencies array" << std::endl;
-					problem_mtx.lock();
-					problemNames.insert(cInfo->name);
-					problem_mtx.unlock();
-					continue;
+					os_mtx.lock();
+					os << cInfo->outputPath << ": dependency path " << status.path << " modified since last build" << std::endl;
+					os_mtx.unlock();
 				}
+				modified_mtx.lock();
+				modifiedFiles.insert(status.path);
+				modified_mtx.unlock();
+				updated = 1;
+				break;
+			}
+		}
 
-				arr = doc["dependencies"].GetArray();
+		for(auto dep=check.userDeps.begin(); !updated && dep!=check.userDeps.end(); ++dep)
+		{
+			const DepStatus& status = **dep;
 
-				for(auto it=arr.Begin(); it!=arr.End(); ++it)
+			if(!status.exists)
+			{
+				if(addExpl)
 				{
-					if(!it->IsString()) 
-					{
-						start_err(std::cout, depsPath) << "dependencies array has non-string element" << std::endl;
-						problem_mtx.lock();
-						problemNames.insert(cInfo->name);
-						problem_mtx.unlock();
-						continue;
-					}
-
-					dep = Path(it->GetString());
-
-					if(!path_exists(dep.str()))
-					{
-						if(addExpl)
-						{
-							os_mtx.lock();
-							os << cInfo->outputPath << ": user defined dependency path " << dep << " does not exist" << std::endl;
-							os_mtx.unlock();
-						}
-						removed_mtx.lock();
-						removedFiles.insert(dep);
-						removed_mtx.unlock();
-						updated_mtx.lock();
-						updatedInfo.insert(*cInfo);
-						updated_mtx.unlock();
-						break;
-					}
-					else if(dep.modified_after(infoPath))
-					{
-						if(addExpl)
-						{
-							os_mtx.lock();
-							os << cInfo->outputPath << ": user defined dependency path " << dep << " modified since last build" << std::endl;
-							os_mtx.unlock();
-						}
-						modified_mtx.lock();
-						modifiedFiles.insert(dep);
-						modified_mtx.unlock();
-						updated_mtx.lock();
-						updatedInfo.insert(*cInfo);
-						updated_mtx.unlock();
-						break;
-					}
+					os_mtx.lock();
+					os << cInfo->outputPath << ": user defined dependency path " << status.path << " does not exist" << std::endl;
+					os_mtx.unlock();
+				}
+				removed_mtx.lock();
+				removedFiles.insert(status.path);
+				removed_mtx.unlock();
+				updated = 1;
+			}
+			else if(difftime(status.mtime, check.builtTime) > 0)
+			{
+				if(addExpl)
+				{
+					os_mtx.lock();
+					os << cInfo->outputPath << ": user defined dependency path " << status.path << " modified since last build" << std::endl;
+					os_mtx.unlock();
 				}
+				modified_mtx.lock();
+				modifiedFiles.insert(status.path);
+				modified_mtx.unlock();
+				updated = 1;
 			}
 		}
 
+		if(updated)
+		{
+			updated_mtx.lock();
+			updatedInfo.insert(*cInfo);
+			updated_mtx.unlock();
+		}
+
 		noFinished++;
 	}
 }
 
+const int DEP_REMOVED = 0,
+          DEP_MODIFIED = 1,
+          DEP_NO_HASH = 2;
+
+//marks page as needing building due to a dependency found via the reverse dependency index
+void mark_dep_updated(std::ostream& os,
+                      const bool& addExpl,
+                      PageCheck& check,
+                      const DepStatus& status,
+                      const int& reason)
+{
+	if(check.updated)
+		return;
+	check.updated = 1;
+	noAffectedPages++;
+
+	if(addExpl)
+	{
+		os_mtx.lock();
+		if(reason == DEP_REMOVED)
+			os << check.info->outputPath << ": dependency path " << status.path << " removed since last build" << std::endl;
+		else if(reason == DEP_MODIFIED)
+			os << check.info->outputPath << ": dependency path " << status.path << " modified since last build" << std::endl;
+		else
+			os << check.info->outputPath << ": " << "no hash recorded for dependency path " << status.path << std::endl;
+		os_mtx.unlock();
+	}
+
+	if(reason == DEP_REMOVED)
+		removedFiles.insert(status.path);
+	else if(reason == DEP_MODIFIED)
+		modifiedFiles.insert(status.path);
+}
+
+void dep_index_report(std::ostream& os)
+{
+	os << "dependency index: " << depCache.distinct.size() << " distinct dependencies checked, ";
+	os << noChangedDeps << " changed affecting " << noAffectedPages << " pages" << std::endl;
+}
+
+/*
+	expands dependencies that changed since the pages depending on them
+	were built to those pages, skipping dependencies that have not
+	changed since before the oldest build of any page depending on them
+*/
+void expand_changed_deps(std::ostream& os,
+                         const bool& addExpl,
+                         const int& incrMode,
+                         const std::vector<std::pair<unsigned int, DepStatus*> >& indexedDeps)
+{
+	std::unordered_map<const std::string*, size_t> checkIndex;
+	for(size_t c=0; c<pageChecks.size(); ++c)
+	{
+		auto page = buildState.pages.find(pageChecks[c].info->outputPath.str());
+		if(page != buildState.pages.end())
+			checkIndex[&page->first] = c;
+	}
+
+	noChangedDeps = noAffectedPages = 0;
+
+	for(auto dep=indexedDeps.begin(); dep!=indexedDeps.end(); ++dep)
+	{
+		const DepStatus& status = *dep->second;
+		//directories are not hashed, only their modified times are checked
+		bool removed = !status.exists,
+		     modSkip = (incrMode == INCR_HASH || difftime(status.mtime, buildState.oldestBuilt[dep->first]) <= 0),
+		     hashSkip = (incrMode == INCR_MOD || status.isDir || (status.hashRecorded && !status.hashChanged));
+
+		if(!removed && modSkip && hashSkip)
+			continue;
+		noChangedDeps++;
+
+		std::unordered_set<const std::string*>& pageKeys = buildState.dependents[dep->first];
+		for(auto pageKey=pageKeys.begin(); pageKey!=pageKeys.end(); ++pageKey)
+		{
+			auto c = checkIndex.find(*pageKey);
+			if(c == checkIndex.end())
+				continue;
+			PageCheck& check = pageChecks[c->second];
+
+			if(removed)
+				mark_dep_updated(os, addExpl, check, status, DEP_REMOVED);
+			else if(incrMode != INCR_HASH && difftime(status.mtime, check.builtTime) > 0)
+				mark_dep_updated(os, addExpl, check, status, DEP_MODIFIED);
+			else if(incrMode != INCR_MOD && !status.isDir && !status.hashRecorded)
+				mark_dep_updated(os, addExpl, check, status, DEP_NO_HASH);
+			else if(incrMode != INCR_MOD && !status.isDir && status.hashChanged)
+				mark_dep_updated(os, addExpl, check, status, DEP_MODIFIED);
+		}
+	}
+}
+
+void check_deps(std::ostream& os,
+                const bool& addExpl,
+                const int& incrMode,
+                const int& no_threads,
+                const std::set<TrackedInfo>& toCheck,
+                const Directory& contentDir,
+                const Directory& outputDir,
+                const std::string& contentExt,
+                const std::string& outputExt)
+{
+	pageChecks.clear();
+	depCache.clear();
+	fileCache.clear();
+
+	//loads what each page was last built from
+	pageScheduler.seed(toCheck, no_threads, 0);
+
+	std::vector<std::thread> threads;
+	for(int i=0; i<no_threads; i++)
+		threads.push_back(std::thread(dep_thread, 
+		                              std::ref(os), 
+		                              addExpl, 
+		                              i, 
+		                              contentDir, 
+		                              outputDir, 
+		                              contentExt, 
+		                              outputExt));
+
+	for(int i=0; i<no_threads; i++)
+		threads[i].join();
+
+	//with the build state database every distinct dependency is checked once and expanded to its dependents
+	std::vector<std::pair<unsigned int, DepStatus*> > indexedDeps;
+	if(buildState.enabled)
+		for(unsigned int id=0; id<buildState.paths.size(); ++id)
+			if(buildState.dependents[id].size())
+				indexedDeps.push_back(std::make_pair(id, depCache.add(Path(buildState.paths[id]))));
+
+	//stats/hashes each distinct dependency once
+	{
+		ProfileSpan checkSpan("check deps", "deps");
+		depCache.check_all(no_threads, incrMode);
+	}
+
+	if(buildState.enabled)
+		expand_changed_deps(os, addExpl, incrMode, indexedDeps);
+
+	nextCheck = 0;
+	threads.clear();
+	for(int i=0; i<no_threads; i++)
+		threads.push_back(std::thread(dep_check_thread, 
+		                              std::ref(os), 
+		                              addExpl, 
+		                              incrMode));
+
+	for(int i=0; i<no_threads; i++)
+		threads[i].join();
+}
+
 void dep_thread_old(std::ostream& os,
                 const bool& addExpl,
                 const int& incrMode,
@@ -4766,6 +5297,7 @@ void dep_thread_old(std::ostream& os,
 					//gets path of info file from last time output file was built
 					Path hashPath = dep.getHashPath();
 					std::string hashPathStr = hashPath.str();
+					std::shared_ptr<const FileContents> contents = fileCache.get(dep.str());
 
 					if(!file_exists(hashPathStr))
 					{
@@ -4780,7 +5312,7 @@ void dep_thread_old(std::ostream& os,
 						updated_mtx.unlock();
 						break;
 					}
-					else if((unsigned) std::atoi(string_from_file(hashPathStr).c_str()) != FNVHash(string_from_file(dep.str())))
+					else if(!contents->ok || (unsigned) std::atoi(string_from_file(hashPathStr).c_str()) != contents->hash)
 					{
 						if(addExpl)
 						{
@@ -4863,6 +5395,9 @@ int ProjectInfo::build_updated(std::ostream& os, const int& addBuildStatus, cons
 		return 0;
 	}
 
+	if(buildState.enabled && buildState.open(os))
+		return 1;
+
 	builtNames.clear();
 	failedNames.clear();
 	problemNames.clear();
@@ -4884,8 +5419,7 @@ int ProjectInfo::build_updated(std::ostream& os, const int& addBuildStatus, cons
 	else
 		no_paginate_threads = paginateThreads;
 
-	nextInfo = trackedAll.begin();
-	counter = noFinished = estNoPagesFinished = noPagesFinished = 0;
+	noFinished = estNoPagesFinished = noPagesFinished = 0;
 
 	if(addBuildStatus)
 	{
@@ -4896,28 +5430,30 @@ int ProjectInfo::build_updated(std::ostream& os, const int& addBuildStatus, cons
 		timer.start();
 	}
 
-	std::vector<std::thread> threads;
-	for(int i=0; i<no_threads; i++)
-		threads.push_back(std::thread(dep_thread, 
-		                              std::ref(os), 
-		                              addExpl, 
-		                              incrMode,
-		                              trackedAll.size(), 
-		                              contentDir, 
-		                              outputDir, 
-		                              contentExt, 
-		                              outputExt));
-
 	cPhase = UPDATE_PHASE;
 	std::thread thrd(build_progress, trackedAll.size(), addBuildStatus);
 
-	for(int i=0; i<no_threads; i++)
-		threads[i].join();
+	check_deps(os, 
+	           addExpl, 
+	           incrMode, 
+	           no_threads, 
+	           trackedAll, 
+	           contentDir, 
+	           outputDir, 
+	           contentExt, 
+	           outputExt);
 	cPhase = DUMMY_PHASE;
 
 	thrd.detach();
 	if(addBuildStatus)
 		clear_console_line();
+	if(addExpl)
+	{
+		if(buildState.enabled)
+			dep_index_report(os);
+		else
+			depCache.report(os);
+	}
 
 	size_t noToDisplay = std::max(5, -5 + (int)console_height());
 
@@ -5007,13 +5543,12 @@ int ProjectInfo::build_updated(std::ostream& os, const int& addBuildStatus, cons
 		          winTextEditor);
 
 		//checks for pre-build scripts
-		if(parser.run_script(os, Path("", "pre-build" + scriptExt), backupScripts, 1))
+		if(parser.run_script(os, Path("", "pre-build" + scriptExt), 1))
 			return 1;
 
 		setIncrMode(incrMode);
 
-		nextInfo = updatedInfo.begin();
-		counter = noFinished = 0;
+		noFinished = 0;
 
 		//os_mtx.lock();
 		if(addBuildStatus)
@@ -5024,13 +5559,18 @@ int ProjectInfo::build_updated(std::ostream& os, const int& addBuildStatus, cons
 		if(addBuildStatus)
 			timer.start();
 
-		threads.clear();
+		pageScheduler.open_stats();
+		outputWriter.reset();
+		pageScheduler.seed(updatedInfo, no_threads, 1);
+
+		//build threads run on the process-wide pool, extra threads are there for pagination tasks
+		threadPool.ensure(no_threads + no_paginate_threads);
+		TaskGroup buildGroup;
 		for(int i=0; i<no_threads; i++)
-			threads.push_back(std::thread(build_thread, 
+			threadPool.submit(std::bind(build_thread, 
 			                              std::ref(os), 
-			                              no_paginate_threads, 
 			                              &trackedAll, 
-			                              updatedInfo.size(), 
+			                              i, 
 			                              contentDir, 
 			                              outputDir, 
 			                              contentExt, 
@@ -5039,19 +5579,24 @@ int ProjectInfo::build_updated(std::ostream& os, const int& addBuildStatus, cons
 			                              defaultTemplate, 
 			                              backupScripts, 
 			                              unixTextEditor, 
-			                              winTextEditor));
+			                              winTextEditor), &buildGroup);
 
 		cPhase = BUILD_PHASE;
 		std::thread thrd(build_progress, updatedInfo.size(), addBuildStatus);
 
-		for(int i=0; i<no_threads; i++)
-			threads[i].join();
+		threadPool.wait(buildGroup);
 		cPhase = END_PHASE;
 
 		thrd.detach();
 		if(addBuildStatus)
 			clear_console_line();
 
+		pageScheduler.stop();
+		if(buildState.enabled && buildState.commit(trackedAll, os))
+			return 1;
+		pageScheduler.save_stats(trackedAll);
+		outputWriter.report(os);
+
 		if(failedNames.size() > 0)
 		{
 			if(noPagesFinished)
@@ -5121,7 +5666,7 @@ int ProjectInfo::build_updated(std::ostream& os, const int& addBuildStatus, cons
 			}
 
 			//checks for post-build scripts
-			if(parser.run_script(os, Path("", "post-build" + scriptExt), backupScripts, 1))
+			if(parser.run_script(os, Path("", "post-build" + scriptExt), 1))
 				return 1;
 		}
 	}
@@ -5146,6 +5691,9 @@ int ProjectInfo::status(std::ostream& os, const int& addBuildStatus, const bool&
 		return 0;
 	}
 
+	if(buildState.enabled && buildState.open(os))
+		return 1;
+
 	builtNames.clear();
 	failedNames.clear();
 	problemNames.clear();
@@ -5159,8 +5707,7 @@ int ProjectInfo::status(std::ostream& os, const int& addBuildStatus, const bool&
 	else
 		no_threads = buildThreads;
 
-	nextInfo = trackedAll.begin();
-	counter = noFinished = 0;
+	noFinished = 0;
 
 	os_mtx.lock();
 	std::cout << "checking for updates.." << std::endl;
@@ -5169,28 +5716,30 @@ int ProjectInfo::status(std::ostream& os, const int& addBuildStatus, const bool&
 	if(addBuildStatus)
 		timer.start();
 
-	std::vector<std::thread> threads;
-	for(int i=0; i<no_threads; i++)
-		threads.push_back(std::thread(dep_thread, 
-		                              std::ref(os), 
-		                              addExpl, 
-		                              incrMode,
-		                              trackedAll.size(), 
-		                              contentDir, 
-		                              outputDir, 
-		                              contentExt, 
-		                              outputExt));
-
 	cPhase = UPDATE_PHASE;
 	std::thread thrd(build_progress, trackedAll.size(), addBuildStatus);
 
-	for(int i=0; i<no_threads; i++)
-		threads[i].join();
+	check_deps(os, 
+	           addExpl, 
+	           incrMode, 
+	           no_threads, 
+	           trackedAll, 
+	           contentDir, 
+	           outputDir, 
+	           contentExt, 
+	           outputExt);
 	cPhase = END_PHASE;
 
 	thrd.detach();
 	if(addBuildStatus)
 		clear_console_line();
+	if(addExpl)
+	{
+		if(buildState.enabled)
+			dep_index_report(os);
+		else
+			depCache.report(os);
+	}
 
 	size_t noToDisplay = std::max(5, -5 + (int)console_height());
 
@@ -3,8 +3,11 @@
 
 #include <thread>
 
+#include "DepCache.h"
 #include "GitInfo.h"
 #include "Parser.h"
+#include "Scheduler.h"
+#include "ThreadPool.h"
 #include "Timer.h"
 #include "WatchList.h"
 
@@ -42,7 +45,7 @@ struct ProjectInfo
 	Directory contentDir,
 	          outputDir;
 	bool backupScripts, lolcatDefault;
-	int buildThreads, paginateThreads, incrMode;
+	int buildThreads, paginateThreads, incrMode, buildStateMode;
 	std::string contentExt,
 	            outputExt,
 	            scriptExt,
@@ -96,6 +99,8 @@ struct ProjectInfo
 
 	int set_incr_mode(const std::string& modeStr);
 	int remove_hash_files();
+	int set_build_state(const std::string& modeStr);
+	int merge_build_state(std::vector<Path> fragmentPaths);
 
 	bool tracking(const TrackedInfo& trackedInfo);
 	bool tracking(const Name& name);
@@ -149,7 +154,10 @@ struct ProjectInfo
 	int build_names(std::ostream& os, 
 	                const int& addBuildStatus, 
 	                const std::vector<Name>& namesToBuild);
-	int build_all(std::ostream& os, const int& addBuildStatus);
+	int build_all(std::ostream& os, 
+	              const int& addBuildStatus, 
+	              const int& shard, 
+	              const int& noShards);
 	int build_updated(std::ostream& os, 
 	                  const int& addBuildStatus, 
 	                  const bool& addExpl, 
@@ -0,0 +1,147 @@
+#include "Scanner.h"
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define SCAN_SSE2_
+#endif
+
+#if (defined __GNUC__ || defined __clang__) && (defined __x86_64__ || defined __i386__) && defined SCAN_SSE2_
+	#include <immintrin.h>
+	#define SCAN_AVX2_
+#endif
+
+#if defined _MSC_VER
+	#include <intrin.h>
+#endif
+
+typedef size_t (*FindSpecialFn)(const char* str, size_t pos, const size_t& size);
+
+//lookup table of special characters
+struct SpecialTable
+{
+	bool special[256];
+
+	SpecialTable()
+	{
+		for(int c=0; c<256; ++c)
+			special[c] = 0;
+		special[(unsigned char)'\\'] = special[(unsigned char)'<'] = special[(unsigned char)'-'] = 1;
+		special[(unsigned char)'@'] = special[(unsigned char)'$'] = special[(unsigned char)'\n'] = 1;
+	}
+};
+
+static const SpecialTable specialTable;
+
+size_t find_special_scalar(const char* str, size_t pos, const size_t& size)
+{
+	for(; pos < size; ++pos)
+		if(specialTable.special[(unsigned char)str[pos]])
+			return pos;
+
+	return size;
+}
+
+#if defined SCAN_SSE2_
+	//index of the lowest set bit, mask is non-zero
+	static inline int lowest_bit(const unsigned int& mask)
+	{
+		#if defined _MSC_VER
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return index;
+		#else
+			return __builtin_ctz(mask);
+		#endif
+	}
+
+	static size_t find_special_sse2(const char* str, size_t pos, const size_t& size)
+	{
+		const __m128i backslash = _mm_set1_epi8('\\'), lt = _mm_set1_epi8('<'), dash = _mm_set1_epi8('-'),
+		              at = _mm_set1_epi8('@'), dollar = _mm_set1_epi8('$'), newline = _mm_set1_epi8('\n');
+
+		for(; pos + 16 <= size; pos += 16)
+		{
+			__m128i chunk = _mm_loadu_si128((const __m128i*)(str + pos));
+			__m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, backslash), _mm_cmpeq_epi8(chunk, lt)),
+			                               _mm_or_si128(_mm_cmpeq_epi8(chunk, dash), _mm_cmpeq_epi8(chunk, at)));
+			matches = _mm_or_si128(matches, _mm_or_si128(_mm_cmpeq_epi8(chunk, dollar), _mm_cmpeq_epi8(chunk, newline)));
+
+			unsigned int mask = _mm_movemask_epi8(matches);
+			if(mask)
+				return pos + lowest_bit(mask);
+		}
+
+		return find_special_scalar(str, pos, size);
+	}
+#endif
+
+#if defined SCAN_AVX2_
+	__attribute__((target("avx2")))
+	static size_t find_special_avx2(const char* str, size_t pos, const size_t& size)
+	{
+		const __m256i backslash = _mm256_set1_epi8('\\'), lt = _mm256_set1_epi8('<'), dash = _mm256_set1_epi8('-'),
+		              at = _mm256_set1_epi8('@'), dollar = _mm256_set1_epi8('$'), newline = _mm256_set1_epi8('\n');
+
+		for(; pos + 32 <= size; pos += 32)
+		{
+			__m256i chunk = _mm256_loadu_si256((const __m256i*)(str + pos));
+			__m256i matches = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, backslash), _mm256_cmpeq_epi8(chunk, lt)),
+			                                  _mm256_or_si256(_mm256_cmpeq_epi8(chunk, dash), _mm256_cmpeq_epi8(chunk, at)));
+			matches = _mm256_or_si256(matches, _mm256_or_si256(_mm256_cmpeq_epi8(chunk, dollar), _mm256_cmpeq_epi8(chunk, newline)));
+
+			unsigned int mask = _mm256_movemask_epi8(matches);
+			if(mask)
+				return pos + __builtin_ctz(mask);
+		}
+
+		return find_special_sse2(str, pos, size);
+	}
+#endif
+
+static FindSpecialFn choose_find_special(const char*& name)
+{
+	#if defined SCAN_AVX2_
+		if(__builtin_cpu_supports("avx2"))
+		{
+			name = "avx2";
+			return find_special_avx2;
+		}
+	#endif
+
+	#if defined SCAN_SSE2_
+		name = "sse2";
+		return find_special_sse2;
+	#else
+		name = "scalar";
+		return find_special_scalar;
+	#endif
+}
+
+//chosen on first use, thread safe as a function local static
+static const FindSpecialFn& find_special_fn(const char*& name)
+{
+	static const char* chosenName = NULL;
+	static const FindSpecialFn chosen = choose_find_special(chosenName);
+
+	name = chosenName;
+	return chosen;
+}
+
+size_t find_special(const char* str, size_t pos, const size_t& size)
+{
+	const char* name;
+	return find_special_fn(name)(str, pos, size);
+}
+
+size_t find_special(const std::string& str, const size_t& pos)
+{
+	const char* name;
+	return find_special_fn(name)(str.c_str(), pos, str.size());
+}
+
+const char* special_scanner()
+{
+	const char* name;
+	find_special_fn(name);
+	return name;
+}
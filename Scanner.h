@@ -0,0 +1,19 @@
+#ifndef SCANNER_H_
+#define SCANNER_H_
+
+#include <string>
+
+/*
+	finds the next character the n++ parser doesn't output as is
+	(\ < - @ $ or a newline) at or after pos, returns size if there
+	isn't one. uses AVX2 or SSE2 when available, checked at run time
+	for AVX2, with a scalar fallback.
+*/
+size_t find_special(const char* str, size_t pos, const size_t& size);
+size_t find_special(const std::string& str, const size_t& pos);
+size_t find_special_scalar(const char* str, size_t pos, const size_t& size);
+
+//name of the implementation find_special uses
+const char* special_scanner();
+
+#endif //SCANNER_H_
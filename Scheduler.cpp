@@ -0,0 +1,278 @@
+#include "Scheduler.h"
+
+#include <algorithm>
+
+PageScheduler pageScheduler;
+
+WorkerQueue::WorkerQueue()
+{
+	noJobs = noStolen = 0;
+	busyTime = idleTime = 0;
+}
+
+PageScheduler::PageScheduler()
+{
+	timesLoaded = 0;
+	statsPath = Path(".nift/", "build-stats.json");
+	wallTime = 0;
+}
+
+int PageScheduler::open_stats()
+{
+	if(timesLoaded)
+		return 0;
+	timesLoaded = 1;
+	buildTimes.clear();
+
+	if(!file_exists(statsPath.str()))
+		return 0;
+
+	rapidjson::Document doc;
+	doc.Parse(string_from_file(statsPath.str()).c_str());
+
+	if(!doc.IsObject() || !doc.HasMember("build-times") || !doc["build-times"].IsObject())
+	{
+		start_warn(std::cout, statsPath) << "build stats file is not valid, ignoring build times from previous builds" << std::endl;
+		return 0;
+	}
+
+	for(auto page=doc["build-times"].MemberBegin(); page!=doc["build-times"].MemberEnd(); ++page)
+		if(page->value.IsNumber())
+			buildTimes[page->name.GetString()] = page->value.GetDouble();
+
+	return 0;
+}
+
+int PageScheduler::save_stats(const std::set<TrackedInfo>& trackedAll)
+{
+	//forgets build times of pages no longer tracked
+	for(auto page=buildTimes.begin(); page!=buildTimes.end();)
+	{
+		TrackedInfo info;
+		info.name = page->first;
+		if(!trackedAll.count(info))
+			page = buildTimes.erase(page);
+		else
+			++page;
+	}
+
+	statsPath.ensureDirExists();
+	std::ofstream ofs(statsPath.str());
+	if(!ofs.is_open())
+	{
+		start_err(std::cout, statsPath) << "failed to write build stats file" << std::endl;
+		return 1;
+	}
+
+	//page names are escaped by the writer
+	rapidjson::StringBuffer sb;
+	rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(sb);
+	writer.SetIndent('\t', 1);
+
+	writer.StartObject();
+	writer.Key("workers");
+	writer.StartArray();
+	for(size_t w=0; w<workers.size(); ++w)
+	{
+		writer.StartObject();
+		writer.Key("pages");
+		writer.Uint64(workers[w]->noJobs);
+		writer.Key("stolen");
+		writer.Uint64(workers[w]->noStolen);
+		writer.Key("busy");
+		writer.Double(workers[w]->busyTime);
+		writer.Key("idle");
+		writer.Double(workers[w]->idleTime);
+		writer.EndObject();
+	}
+	writer.EndArray();
+	writer.Key("build-times");
+	writer.StartObject();
+	for(auto page=buildTimes.begin(); page!=buildTimes.end(); ++page)
+	{
+		writer.Key(page->first.c_str(), page->first.size());
+		writer.Double(page->second);
+	}
+	writer.EndObject();
+	writer.EndObject();
+
+	ofs << sb.GetString();
+	ofs.close();
+
+	return 0;
+}
+
+bool more_costly(const std::pair<double, std::set<TrackedInfo>::iterator>& job1,
+                 const std::pair<double, std::set<TrackedInfo>::iterator>& job2)
+{
+	return job1.first > job2.first;
+}
+
+void PageScheduler::seed(const std::set<TrackedInfo>& toDo, const int& noWorkers, const bool& costAware)
+{
+	workers.clear();
+	for(int w=0; w<noWorkers; ++w)
+		workers.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+
+	if(!noWorkers)
+		return;
+
+	if(!costAware)
+	{
+		//deals out contiguous blocks so each worker mostly touches its own deque
+		size_t w = 0, blockSize = toDo.size()/noWorkers + 1, noDealt = 0;
+		for(auto info=toDo.begin(); info!=toDo.end(); ++info, ++noDealt)
+		{
+			if(noDealt == blockSize)
+			{
+				++w;
+				noDealt = 0;
+			}
+			workers[w]->jobs.push_back(info);
+		}
+	}
+	else
+	{
+		//pages not built before are assumed to take the average time
+		double totalTime = 0, avgTime = 0;
+		size_t noKnown = 0;
+		for(auto info=toDo.begin(); info!=toDo.end(); ++info)
+		{
+			auto time = buildTimes.find(info->name);
+			if(time != buildTimes.end())
+			{
+				totalTime += time->second;
+				++noKnown;
+			}
+		}
+		if(noKnown)
+			avgTime = totalTime/noKnown;
+
+		std::vector<std::pair<double, std::set<TrackedInfo>::iterator> > jobs;
+		for(auto info=toDo.begin(); info!=toDo.end(); ++info)
+		{
+			auto time = buildTimes.find(info->name);
+			jobs.push_back(std::make_pair(time != buildTimes.end() ? time->second : avgTime, info));
+		}
+		std::stable_sort(jobs.begin(), jobs.end(), more_costly);
+
+		//longest job first onto whichever worker has the least queued so far
+		std::vector<double> queuedTime(noWorkers, 0);
+		for(size_t j=0; j<jobs.size(); ++j)
+		{
+			size_t w = std::min_element(queuedTime.begin(), queuedTime.end()) - queuedTime.begin();
+			workers[w]->jobs.push_back(jobs[j].second);
+			queuedTime[w] += jobs[j].first;
+		}
+	}
+
+	timer.start();
+}
+
+bool PageScheduler::next(const size_t& worker, std::set<TrackedInfo>::iterator& info)
+{
+	WorkerQueue& own = *workers[worker];
+
+	own.mtx.lock();
+	if(own.jobs.size())
+	{
+		info = own.jobs.front();
+		own.jobs.pop_front();
+		own.noJobs++;
+		own.mtx.unlock();
+		return 1;
+	}
+	own.mtx.unlock();
+
+	//steals from the back, where the cheapest jobs are
+	for(size_t v=1; v<workers.size(); ++v)
+	{
+		WorkerQueue& victim = *workers[(worker + v) % workers.size()];
+
+		victim.mtx.lock();
+		if(victim.jobs.size())
+		{
+			info = victim.jobs.back();
+			victim.jobs.pop_back();
+			victim.mtx.unlock();
+
+			own.noJobs++;
+			own.noStolen++;
+			return 1;
+		}
+		victim.mtx.unlock();
+	}
+
+	return 0;
+}
+
+void PageScheduler::finished(const size_t& worker, const Name& name, const double& buildTime)
+{
+	workers[worker]->busyTime += buildTime;
+
+	timesMtx.lock();
+	buildTimes[name] = buildTime;
+	timesMtx.unlock();
+}
+
+//works out how long each worker sat idle once all workers have joined
+void PageScheduler::stop()
+{
+	wallTime = timer.getTime();
+	for(size_t w=0; w<workers.size(); ++w)
+		workers[w]->idleTime = std::max(0.0, wallTime - workers[w]->busyTime);
+}
+
+//outputs worker statistics from the last build along with the slowest pages to build
+int PageScheduler::report(std::ostream& os, const size_t& noSlowest)
+{
+	if(!file_exists(statsPath.str()))
+	{
+		start_err(os) << "no build stats recorded yet, they are recorded each time files are built" << std::endl;
+		return 1;
+	}
+
+	rapidjson::Document doc;
+	doc.Parse(string_from_file(statsPath.str()).c_str());
+
+	if(!doc.IsObject() || !doc.HasMember("workers") || !doc["workers"].IsArray())
+	{
+		start_err(os, statsPath) << "build stats file has no workers array" << std::endl;
+		return 1;
+	}
+
+	os.precision(4);
+	size_t w = 0;
+	for(auto worker=doc["workers"].Begin(); worker!=doc["workers"].End(); ++worker, ++w)
+	{
+		if(!worker->IsObject() || 
+		   !worker->HasMember("pages") || !(*worker)["pages"].IsNumber() ||
+		   !worker->HasMember("stolen") || !(*worker)["stolen"].IsNumber() ||
+		   !worker->HasMember("busy") || !(*worker)["busy"].IsNumber() ||
+		   !worker->HasMember("idle") || !(*worker)["idle"].IsNumber())
+		{
+			start_err(os, statsPath) << "build stats file has invalid worker" << std::endl;
+			return 1;
+		}
+
+		os << c_light_blue << "worker " << w+1 << ": " << c_white;
+		os << (*worker)["pages"].GetUint64() << " files (" << (*worker)["stolen"].GetUint64() << " stolen), ";
+		os << "busy " << (*worker)["busy"].GetDouble() << "s, ";
+		os << "idle " << (*worker)["idle"].GetDouble() << "s" << std::endl;
+	}
+
+	timesLoaded = 0;
+	open_stats();
+
+	std::vector<std::pair<double, Name> > slowest;
+	for(auto page=buildTimes.begin(); page!=buildTimes.end(); ++page)
+		slowest.push_back(std::make_pair(page->second, page->first));
+	std::sort(slowest.rbegin(), slowest.rend());
+
+	if(noSlowest && slowest.size())
+		os << c_light_blue << "slowest files to build:" << c_white << std::endl;
+	for(size_t p=0; p<noSlowest && p<slowest.size(); ++p)
+		os << " " << slowest[p].second << ": " << slowest[p].first << "s" << std::endl;
+
+	return 0;
+}
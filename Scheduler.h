@@ -0,0 +1,55 @@
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "RapidJSON.h"
+#include "Timer.h"
+#include "TrackedInfo.h"
+
+//pages queued for one worker thread along with what the worker got up to
+struct WorkerQueue
+{
+	std::mutex mtx;
+	std::deque<std::set<TrackedInfo>::iterator> jobs;
+	size_t noJobs, noStolen;
+	double busyTime, idleTime;
+
+	WorkerQueue();
+};
+
+/*
+	hands out pages to build/dep threads. each worker has its own deque
+	which it takes from the front of, once empty it steals from the back
+	of another worker's deque. when building, deques are seeded with the
+	pages expected to take longest first using how long each page took
+	to build last time, so huge pages don't end up starting last.
+*/
+struct PageScheduler
+{
+	std::vector<std::unique_ptr<WorkerQueue> > workers;
+	std::mutex timesMtx;
+	std::map<Name, double> buildTimes; //seconds each page took to build last time
+	bool timesLoaded;
+	Path statsPath;
+	Timer timer;
+	double wallTime;
+
+	PageScheduler();
+
+	int open_stats();
+	int save_stats(const std::set<TrackedInfo>& trackedAll);
+	int report(std::ostream& os, const size_t& noSlowest);
+
+	void seed(const std::set<TrackedInfo>& toDo, const int& noWorkers, const bool& costAware);
+	bool next(const size_t& worker, std::set<TrackedInfo>::iterator& info);
+	void finished(const size_t& worker, const Name& name, const double& buildTime);
+	void stop();
+};
+
+extern PageScheduler pageScheduler;
+
+#endif //SCHEDULER_H_
@@ -0,0 +1,345 @@
+#include "Spawn.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined _WIN32 || defined _WIN64
+#else  //*nix
+	#include <cerrno>
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <signal.h>
+	#include <spawn.h>
+	#include <mutex>
+	#include <sys/wait.h>
+	#include <thread>
+	#include <unistd.h>
+
+	extern char** environ;
+
+	//ms between checks for the command exiting while capturing output
+	const int SPAWN_POLL_MS = 20;
+	//reads of what is left in the pipe once the command has exited
+	const int SPAWN_DRAIN_READS = 1024;
+#endif
+
+#if defined _WIN32 || defined _WIN64
+	//quotes arg so CommandLineToArgvW gives it back unchanged
+	static std::string quote_arg(const std::string& arg)
+	{
+		std::string quoted = "\"";
+		size_t noSlashes = 0;
+
+		for(size_t i=0; i<arg.size(); ++i)
+		{
+			if(arg[i] == '\\')
+				++noSlashes;
+			else
+			{
+				//backslashes before a quote are doubled and the quote escaped
+				if(arg[i] == '"')
+					quoted.append(noSlashes + 1, '\\');
+				noSlashes = 0;
+			}
+			quoted += arg[i];
+		}
+
+		//as are backslashes before the closing quote
+		quoted.append(noSlashes, '\\');
+		quoted += '"';
+
+		return quoted;
+	}
+
+	//escapes characters cmd.exe treats specially, so the command line reaches the program as is
+	static std::string escape_cmd(const std::string& cmd)
+	{
+		std::string escaped;
+
+		for(size_t i=0; i<cmd.size(); ++i)
+		{
+			switch(cmd[i])
+			{
+				case '(': case ')': case '%': case '!': case '^':
+				case '"': case '<': case '>': case '&': case '|':
+					escaped += '^';
+					break;
+			}
+			escaped += cmd[i];
+		}
+
+		return escaped;
+	}
+
+	//timeouts aren't supported here
+	static int spawn_cmd(const std::string& cmd, std::string* output)
+	{
+		if(!output)
+			return system(cmd.c_str());
+
+		FILE* pipe = _popen(cmd.c_str(), "rb");
+		if(!pipe)
+			return -1;
+
+		char buf[65536];
+		size_t n;
+		while((n = fread(buf, 1, sizeof(buf), pipe)) > 0)
+			output->append(buf, n);
+
+		return _pclose(pipe);
+	}
+
+	int spawn_shell(const std::string& cmd, std::string* output, const double& /*timeout*/, bool& timedOut)
+	{
+		timedOut = 0;
+		return spawn_cmd(cmd, output);
+	}
+
+	int spawn_argv(const std::vector<std::string>& args, std::string* output, const double& timeout, bool& timedOut)
+	{
+		std::string cmd;
+		for(size_t a=0; a<args.size(); ++a)
+		{
+			if(a)
+				cmd += " ";
+			cmd += quote_arg(args[a]);
+		}
+
+		return spawn_shell(escape_cmd(cmd), output, timeout, timedOut);
+	}
+#else  //*nix
+	#if !defined __linux__
+		//pipe then setting close on exec isn't atomic, so pipes are opened and
+		//commands spawned one at a time to stop other commands inheriting them
+		static std::mutex spawnMtx;
+	#endif
+
+	//pipe whose ends are closed in other spawned processes, so they can't hold the write end open
+	static int open_pipe(int fds[2])
+	{
+		#if defined __linux__
+			return pipe2(fds, O_CLOEXEC);
+		#else
+			if(pipe(fds))
+				return -1;
+			fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+			fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+			return 0;
+		#endif
+	}
+
+	//path execvp would run for name, names containing a slash are used as they are
+	static std::string find_in_path(const std::string& name)
+	{
+		const char* pathVar = std::getenv("PATH");
+		if(name.find('/') != std::string::npos || !pathVar)
+			return name;
+
+		std::string dirs = pathVar, dir, candidate;
+		size_t start = 0, end;
+		while(1)
+		{
+			end = dirs.find(':', start);
+			dir = dirs.substr(start, (end == std::string::npos) ? std::string::npos : end - start);
+			candidate = ((dir == "") ? "." : dir) + "/" + name;
+			if(!access(candidate.c_str(), X_OK))
+				return candidate;
+			if(end == std::string::npos)
+				break;
+			start = end + 1;
+		}
+
+		return name;
+	}
+
+	static long long now_ms()
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	static void kill_spawned(const pid_t& pid, const bool& ownGroup)
+	{
+		if(ownGroup)
+			kill(-pid, SIGKILL);
+		else
+			kill(pid, SIGKILL);
+	}
+
+	static int spawn(const char* path, const bool& searchPath, char* const argv[], std::string* output, const double& timeout, bool& timedOut)
+	{
+		timedOut = 0;
+
+		#if !defined __linux__
+			spawnMtx.lock();
+		#endif
+
+		int fds[2] = {-1, -1};
+		if(output && open_pipe(fds))
+		{
+			#if !defined __linux__
+				spawnMtx.unlock();
+			#endif
+			return -1;
+		}
+
+		posix_spawn_file_actions_t actions;
+		posix_spawnattr_t attr;
+		posix_spawn_file_actions_init(&actions);
+		posix_spawnattr_init(&attr);
+
+		if(output)
+			posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+
+		//own process group so anything it starts is killed too on timing out,
+		//not done for console output as it would lose the terminal
+		bool ownGroup = output && timeout > 0;
+		if(ownGroup)
+		{
+			posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP);
+			posix_spawnattr_setpgroup(&attr, 0);
+		}
+
+		pid_t pid;
+		int err;
+		if(searchPath)
+			err = posix_spawnp(&pid, path, &actions, &attr, argv, environ);
+		else
+			err = posix_spawn(&pid, path, &actions, &attr, argv, environ);
+
+		posix_spawn_file_actions_destroy(&actions);
+		posix_spawnattr_destroy(&attr);
+
+		if(output)
+			close(fds[1]);
+		#if !defined __linux__
+			spawnMtx.unlock();
+		#endif
+		if(err)
+		{
+			if(output)
+				close(fds[0]);
+			errno = err;
+			return -1;
+		}
+
+		long long deadline = (timeout > 0) ? now_ms() + (long long)(timeout*1000) : 0;
+
+		int status;
+		bool exited = 0;
+		if(output)
+		{
+			char buf[65536];
+			ssize_t n;
+			int waitMs, ready;
+			struct pollfd pfd;
+			pfd.fd = fds[0];
+			pfd.events = POLLIN;
+
+			while(1)
+			{
+				waitMs = SPAWN_POLL_MS;
+				if(deadline)
+				{
+					long long msLeft = deadline - now_ms();
+					if(msLeft <= 0)
+					{
+						timedOut = 1;
+						break;
+					}
+					else if(msLeft < waitMs)
+						waitMs = msLeft;
+				}
+
+				ready = poll(&pfd, 1, waitMs);
+				if(ready < 0 && errno != EINTR)
+					break;
+				else if(ready > 0)
+				{
+					n = read(fds[0], buf, sizeof(buf));
+					if(n == 0 || (n < 0 && errno != EINTR))
+						break;
+					else if(n > 0)
+						output->append(buf, n);
+				}
+
+				//stops once the command exits rather than at end of file, as
+				//anything it left running in the background (eg. cmd &) holds
+				//the write end open. what it wrote is still in the pipe.
+				if(waitpid(pid, &status, WNOHANG) == pid)
+				{
+					exited = 1;
+					fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+					for(int r=0; r<SPAWN_DRAIN_READS && (n = read(fds[0], buf, sizeof(buf))) > 0; ++r)
+						output->append(buf, n);
+					break;
+				}
+			}
+			close(fds[0]);
+		}
+
+		if(exited)
+			return status;
+		else if(deadline && !timedOut)
+		{
+			//polls for the exit, sleeping a little longer each time up to 10ms
+			int sleepMs = 1;
+			pid_t waited;
+			while((waited = waitpid(pid, &status, WNOHANG)) == 0 || (waited < 0 && errno == EINTR))
+			{
+				if(now_ms() >= deadline)
+				{
+					timedOut = 1;
+					break;
+				}
+				std::this_thread::sleep_for(std::chrono::milliseconds(sleepMs));
+				if(sleepMs < 10)
+					++sleepMs;
+			}
+			if(!timedOut)
+				return (waited < 0) ? -1 : status;
+		}
+
+		if(timedOut)
+			kill_spawned(pid, ownGroup);
+
+		while(waitpid(pid, &status, 0) < 0)
+			if(errno != EINTR)
+				return -1;
+
+		return status;
+	}
+
+	int spawn_shell(const std::string& cmd, std::string* output, const double& timeout, bool& timedOut)
+	{
+		char* const argv[] = {(char*)"sh", (char*)"-c", (char*)cmd.c_str(), NULL};
+
+		return spawn("/bin/sh", 0, argv, output, timeout, timedOut);
+	}
+
+	int spawn_argv(const std::vector<std::string>& args, std::string* output, const double& timeout, bool& timedOut)
+	{
+		timedOut = 0;
+		if(!args.size())
+			return -1;
+
+		std::vector<char*> argv;
+		for(size_t a=0; a<args.size(); ++a)
+			argv.push_back((char*)args[a].c_str());
+		argv.push_back(NULL);
+
+		int status = spawn(argv[0], 1, &argv[0], output, timeout, timedOut);
+
+		//files without a #! line are run with the shell, as execvp does
+		if(status == -1 && errno == ENOEXEC)
+		{
+			std::string filePath = find_in_path(args[0]);
+			argv[0] = (char*)filePath.c_str();
+			argv.insert(argv.begin(), (char*)"sh");
+
+			status = spawn("/bin/sh", 0, &argv[0], output, timeout, timedOut);
+		}
+
+		return status;
+	}
+#endif
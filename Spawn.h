@@ -0,0 +1,23 @@
+#ifndef SPAWN_H_
+#define SPAWN_H_
+
+#include <string>
+#include <vector>
+
+/*
+	runs commands without system() and temporary output files. stdout is
+	captured through a pipe when output is given, otherwise it is left going
+	to the console, stderr always goes to the console. capturing stops once
+	the command exits, anything it left running in the background isn't
+	waited on. build threads can spawn at the same time, apart from without
+	pipe2 where opening the pipe and spawning is done one at a time. a
+	timeout of zero waits for as long as the command takes, otherwise the
+	command (and with captured output anything it started) is killed once
+	timeout seconds have passed. spawn_argv runs files without a #! line
+	with /bin/sh like execvp. both return a wait status like system(), -1
+	if nothing could be spawned.
+*/
+int spawn_shell(const std::string& cmd, std::string* output, const double& timeout, bool& timedOut);
+int spawn_argv(const std::vector<std::string>& args, std::string* output, const double& timeout, bool& timedOut);
+
+#endif //SPAWN_H_
@@ -0,0 +1,136 @@
+#include "SysCache.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "Path.h"
+
+SysCache sysCache;
+
+std::string sys_cache_key(const std::string& cmd, const std::vector<std::string>& inputs, const std::vector<std::string>& envVars)
+{
+	//commands are run from the working directory, so the same command elsewhere is a different key
+	std::string key = cmd + "\ncwd " + get_pwd();
+
+	for(size_t i=0; i<inputs.size(); ++i)
+	{
+		std::shared_ptr<const FileContents> contents = fileCache.get(inputs[i]);
+		if(contents->ok)
+			key += "\nin " + inputs[i] + " " + std::to_string(contents->hash) + " " + std::to_string(contents->str.size());
+		else
+			key += "\nin " + inputs[i] + " missing";
+	}
+
+	for(size_t e=0; e<envVars.size(); ++e)
+	{
+		const char* value = std::getenv(envVars[e].c_str());
+		if(value)
+			key += "\nenv " + envVars[e] + "=" + value;
+		else
+			key += "\nenv " + envVars[e] + " unset";
+	}
+
+	return key;
+}
+
+//persistent entries are only kept inside projects
+static bool in_project()
+{
+	return dir_exists(".nift/");
+}
+
+static std::string entry_path(const std::string& key)
+{
+	return ".nift/sys-cache/" + hex_digest(key);
+}
+
+SysCache::SysCache()
+{
+	noBytes = 0;
+	noHits = noMisses = 0;
+}
+
+bool SysCache::get(const std::string& key, std::string& output)
+{
+	mtx.lock();
+	auto found = outputs.find(key);
+	if(found != outputs.end())
+	{
+		output = *found->second;
+		mtx.unlock();
+		++noHits;
+		return 1;
+	}
+	mtx.unlock();
+
+	if(in_project())
+	{
+		std::ifstream ifs(entry_path(key), std::ios::binary);
+		size_t keySize;
+		if(ifs >> keySize && ifs.get() == '\n')
+		{
+			std::string entryKey(keySize, '\0');
+			if(keySize == key.size() && ifs.read(&entryKey[0], keySize) && entryKey == key)
+			{
+				std::ostringstream oss;
+				oss << ifs.rdbuf();
+				output = oss.str();
+
+				mtx.lock();
+				if(noBytes + output.size() <= SYS_CACHE_MAX_BYTES && !outputs.count(key))
+				{
+					outputs[key] = std::make_shared<const std::string>(output);
+					noBytes += output.size();
+				}
+				mtx.unlock();
+
+				++noHits;
+				return 1;
+			}
+		}
+	}
+
+	++noMisses;
+	return 0;
+}
+
+void SysCache::put(const std::string& key, const std::string& output)
+{
+	mtx.lock();
+	if(noBytes + output.size() <= SYS_CACHE_MAX_BYTES && !outputs.count(key))
+	{
+		outputs[key] = std::make_shared<const std::string>(output);
+		noBytes += output.size();
+	}
+	mtx.unlock();
+
+	if(in_project())
+	{
+		Path(".nift/sys-cache/", "").ensureDirExists();
+
+		std::string pathStr = entry_path(key),
+		            tmpPathStr = pathStr + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+		std::ofstream ofs(tmpPathStr, std::ios::binary);
+		ofs << key.size() << "\n" << key << output;
+		ofs.close();
+
+		if(!ofs || std::rename(tmpPathStr.c_str(), pathStr.c_str()))
+			std::remove(tmpPathStr.c_str());
+	}
+}
+
+//forgets cached output, including the project's .nift/sys-cache/
+int SysCache::clean()
+{
+	mtx.lock();
+	outputs.clear();
+	noBytes = 0;
+	mtx.unlock();
+
+	if(in_project())
+		return delDir(".nift/sys-cache/");
+	return 0;
+}
@@ -0,0 +1,43 @@
+#ifndef SYS_CACHE_H_
+#define SYS_CACHE_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "FileCache.h"
+
+const size_t SYS_CACHE_MAX_BYTES = 64*1024*1024;
+
+//key for a command, made from the command and working directory along with fingerprints of its declared input files and environment variables
+std::string sys_cache_key(const std::string& cmd, const std::vector<std::string>& inputs, const std::vector<std::string>& envVars);
+
+/*
+	output of successful @system/@script calls made with the cache option,
+	keyed by sys_cache_key. kept in memory for reuse across pages and in
+	.nift/sys-cache/ for reuse across builds, one file per key which is
+	written to a temporary file then renamed so build threads can share it.
+	only kept in memory outside of projects. the full key is stored with
+	the output and checked on reading, so file name collisions are harmless.
+	entries are never expired, nsm clean removes them all.
+*/
+struct SysCache
+{
+	std::mutex mtx;
+	std::unordered_map<std::string, std::shared_ptr<const std::string> > outputs;
+	size_t noBytes;
+	std::atomic<size_t> noHits, noMisses;
+
+	SysCache();
+
+	bool get(const std::string& key, std::string& output);
+	void put(const std::string& key, const std::string& output);
+	int clean();
+};
+
+extern SysCache sysCache;
+
+#endif //SYS_CACHE_H_
@@ -0,0 +1,144 @@
+#include "TemplateCache.h"
+
+#include <algorithm>
+
+#include "Parser.h"
+#include "Scanner.h"
+
+TemplateCache templateCache;
+
+CallToken::CallToken()
+{
+	parseFuncName = parseOptions = parseParams = 0;
+	paramsRead = paramsSplit = 0;
+	nameEnd = optionsEnd = end = 0;
+	nameLines = optionsLines = optionsSplitLines = paramsLines = paramsSplitLines = 0;
+	nameId = paramId = -1;
+}
+
+static bool block_before(const BlockToken& a, const BlockToken& b)
+{
+	return a.start < b.start;
+}
+
+SegmentedText::SegmentedText(const std::shared_ptr<const FileContents>& Contents, Parser& parser) : contents(Contents), text(Contents->str)
+{
+	Segment segment;
+	segment.call = 0;
+	CallToken call;
+	size_t pos = 0;
+	while(pos < text.size())
+	{
+		size_t endPos = find_special(text, pos);
+		if(endPos > pos)
+		{
+			segment.type = SEG_LITERAL;
+			segment.start = pos;
+			segment.end = pos = endPos;
+			segment.noLines = 0;
+			segments.push_back(segment);
+		}
+		else if(text.compare(pos, 4, "<#--") == 0)
+		{
+			size_t closePos = text.find("--#>", pos + 4);
+			if(closePos == std::string::npos)
+			{
+				//parser reports the missing close
+				++pos;
+				continue;
+			}
+
+			segment.type = SEG_RAW_COMMENT;
+			segment.start = pos;
+			segment.end = closePos + 4;
+			segment.noLines = std::count(text.begin() + pos + 4, text.begin() + closePos, '\n');
+			segments.push_back(segment);
+			pos = segment.end;
+		}
+		else if(text[pos] == '\\')
+		{
+			//escaped @, # and $ aren't calls
+			if(pos+1 < text.size() && (text[pos+1] == '@' || text[pos+1] == '#' || text[pos+1] == '$'))
+				pos += 2;
+			else
+				++pos;
+		}
+		else if((text[pos] == '@' || (text[pos] == '$' && pos+1 < text.size() && (text[pos+1] == '{' || text[pos+1] == '[' || text[pos+1] == '`'))) &&
+		        !parser.tokenise_call(text, pos, call))
+		{
+			segment.type = SEG_CALL;
+			segment.start = pos;
+			segment.end = call.end;
+			segment.noLines = 0;
+			segment.call = calls.size();
+			segments.push_back(segment);
+			calls.push_back(call);
+			parser.tokenise_blocks(*this, calls.back());
+			segment.call = 0;
+			pos = segment.end;
+		}
+		else
+			++pos;
+	}
+
+	//blocks inside blocks are found after the else blocks of the outer call
+	std::sort(blocks.begin(), blocks.end(), block_before);
+}
+
+const Segment* segment_at(const SegmentedText& segmented, size_t& seg, const size_t& pos)
+{
+	while(seg < segmented.segments.size() && segmented.segments[seg].end <= pos)
+		++seg;
+
+	if(seg < segmented.segments.size() && segmented.segments[seg].start <= pos)
+		return &segmented.segments[seg];
+
+	return NULL;
+}
+
+const BlockToken* block_at(const SegmentedText& segmented, const size_t& pos)
+{
+	size_t lo = 0, hi = segmented.blocks.size();
+	while(lo < hi)
+	{
+		size_t mid = (lo + hi)/2;
+		if(segmented.blocks[mid].start < pos)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if(lo < segmented.blocks.size() && segmented.blocks[lo].start == pos)
+		return &segmented.blocks[lo];
+
+	return NULL;
+}
+
+std::shared_ptr<const SegmentedText> TemplateCache::get(const std::string& pathStr, const std::shared_ptr<const FileContents>& contents, Parser& parser)
+{
+	mtx.lock();
+	auto found = segmented.find(pathStr);
+	if(found != segmented.end() && found->second->contents == contents)
+	{
+		std::shared_ptr<const SegmentedText> result = found->second;
+		mtx.unlock();
+		return result;
+	}
+	mtx.unlock();
+
+	//splits outside the lock, threads splitting the same file at once is harmless
+	std::shared_ptr<const SegmentedText> result(new SegmentedText(contents, parser));
+
+	mtx.lock();
+	segmented[pathStr] = result;
+	mtx.unlock();
+
+	return result;
+}
+
+void TemplateCache::clear()
+{
+	mtx.lock();
+	segmented.clear();
+	mtx.unlock();
+}
@@ -0,0 +1,95 @@
+#ifndef TEMPLATE_CACHE_H_
+#define TEMPLATE_CACHE_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "FileCache.h"
+
+struct Parser;
+
+#define SEG_LITERAL 0
+#define SEG_RAW_COMMENT 1
+#define SEG_CALL 2
+
+//literal run, raw <#-- --#> comment or function call found when splitting up n++ text
+struct Segment
+{
+	size_t start, end; //end is one past the segment
+	int type;
+	int noLines; //newlines inside raw comments
+	size_t call; //index of the call in calls
+};
+
+/*
+	@fn{options}(params) call read ahead of time by the parser's own
+	readers, along with how far each read moved the line number. options
+	and params are only split when they don't need parsing first, params
+	are only read when how they're read doesn't depend on parsing either.
+*/
+struct CallToken
+{
+	std::string funcName, optionsStr, paramsStr;
+	std::vector<std::string> options, params;
+	bool parseFuncName, parseOptions, parseParams;
+	bool paramsRead, paramsSplit;
+	size_t nameEnd, optionsEnd, end;
+	int nameLines, optionsLines, optionsSplitLines, paramsLines, paramsSplitLines;
+	int nameId, paramId; //interned funcName and params[0] (see Variables.h), -1 if not read
+
+	CallToken();
+};
+
+struct SegmentedText;
+
+//block read ahead of time, split and tokenised itself
+struct BlockToken
+{
+	size_t start, end;
+	int noLines, noBlockLines; //how far lineNo and bLineNo moved reading the block
+	std::shared_ptr<const SegmentedText> block;
+};
+
+/*
+	n++ text split up ahead of time into literal runs (characters the
+	parser would output one at a time), raw comments and function calls,
+	sorted by start, with the blocks of if/while/for/do-while calls.
+	immutable once split, shared read only between build threads.
+*/
+struct SegmentedText
+{
+	std::shared_ptr<const FileContents> contents;
+	const std::string& text;
+	std::vector<Segment> segments;
+	std::vector<CallToken> calls;
+	std::vector<BlockToken> blocks; //sorted by start
+
+	SegmentedText(const std::shared_ptr<const FileContents>& Contents, Parser& parser);
+};
+
+//finds the segment containing pos, advancing seg which only moves forward
+const Segment* segment_at(const SegmentedText& segmented, size_t& seg, const size_t& pos);
+
+//finds the block read ahead of time starting at pos, NULL if there isn't one
+const BlockToken* block_at(const SegmentedText& segmented, const size_t& pos);
+
+/*
+	template and input files split in to segments cached by path, reused for
+	as long as the file cache hands back the same contents. calls are read
+	by the parser asking for the file.
+*/
+struct TemplateCache
+{
+	std::mutex mtx;
+	std::unordered_map<std::string, std::shared_ptr<const SegmentedText> > segmented;
+
+	std::shared_ptr<const SegmentedText> get(const std::string& pathStr, const std::shared_ptr<const FileContents>& contents, Parser& parser);
+	void clear();
+};
+
+extern TemplateCache templateCache;
+
+#endif //TEMPLATE_CACHE_H_
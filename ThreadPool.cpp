@@ -0,0 +1,122 @@
+#include "ThreadPool.h"
+
+ThreadPool threadPool;
+
+TaskGroup::TaskGroup()
+{
+	noPending = 0;
+}
+
+//runs task then lets anyone waiting on its group know if it was the last one
+void run_task(PoolTask& task)
+{
+	task.fn();
+
+	//the group may be gone as soon as its mutex is released with no tasks pending
+	task.group->mtx.lock();
+	if(--task.group->noPending == 0)
+		task.group->cv.notify_all();
+	task.group->mtx.unlock();
+}
+
+void pool_thread(ThreadPool* pool)
+{
+	PoolTask task;
+
+	while(1)
+	{
+		std::unique_lock<std::mutex> lock(pool->mtx);
+		while(!pool->stopping && !pool->tasks.size())
+			pool->cv.wait(lock);
+		if(pool->stopping && !pool->tasks.size())
+			return;
+		task = pool->tasks.front();
+		pool->tasks.pop_front();
+		lock.unlock();
+
+		run_task(task);
+	}
+}
+
+ThreadPool::ThreadPool()
+{
+	stopping = 0;
+}
+
+ThreadPool::~ThreadPool()
+{
+	mtx.lock();
+	stopping = 1;
+	cv.notify_all();
+	mtx.unlock();
+
+	for(size_t t=0; t<threads.size(); ++t)
+		threads[t].join();
+}
+
+//grows pool to at least noThreads threads, pool never shrinks
+void ThreadPool::ensure(const size_t& noThreads)
+{
+	mtx.lock();
+	while(threads.size() < noThreads)
+		threads.push_back(std::thread(pool_thread, this));
+	mtx.unlock();
+}
+
+void ThreadPool::submit(const std::function<void()>& fn, TaskGroup* group)
+{
+	PoolTask task;
+	task.fn = fn;
+	task.group = group;
+
+	group->mtx.lock();
+	group->noPending++;
+	group->mtx.unlock();
+
+	mtx.lock();
+	tasks.push_back(task);
+	cv.notify_one();
+	mtx.unlock();
+}
+
+//runs a queued task from group on calling thread, returns 0 if none were queued
+bool ThreadPool::run_one(TaskGroup* group)
+{
+	PoolTask task;
+
+	//searches from the back as a group's tasks are usually the most recently submitted
+	mtx.lock();
+	std::deque<PoolTask>::iterator t = tasks.end();
+	while(t != tasks.begin())
+	{
+		--t;
+		if(t->group == group)
+		{
+			task = *t;
+			tasks.erase(t);
+			mtx.unlock();
+
+			run_task(task);
+
+			return 1;
+		}
+	}
+	mtx.unlock();
+
+	return 0;
+}
+
+void ThreadPool::wait(TaskGroup& group)
+{
+	while(1)
+	{
+		if(run_one(&group))
+			continue;
+
+		//remaining tasks are running on other threads
+		std::unique_lock<std::mutex> lock(group.mtx);
+		if(!group.noPending)
+			return;
+		group.cv.wait(lock);
+	}
+}
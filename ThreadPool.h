@@ -0,0 +1,54 @@
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//tasks submitted together that can be waited on together
+struct TaskGroup
+{
+	size_t noPending; //guarded by mtx
+	std::mutex mtx;
+	std::condition_variable cv;
+
+	TaskGroup();
+};
+
+struct PoolTask
+{
+	std::function<void()> fn;
+	TaskGroup* group;
+};
+
+/*
+	process-wide pool of threads shared by build and pagination work.
+	threads waiting on a group of tasks run that group's queued tasks
+	themselves while they wait, so tasks that submit and wait on more
+	tasks (eg. building a page which paginates) can't starve the pool.
+	only the group's own tasks are run so a wait never ends up nested
+	inside unrelated work.
+*/
+struct ThreadPool
+{
+	std::mutex mtx;
+	std::condition_variable cv;
+	std::deque<PoolTask> tasks;
+	std::vector<std::thread> threads;
+	bool stopping;
+
+	ThreadPool();
+	~ThreadPool();
+
+	void ensure(const size_t& noThreads);
+	void submit(const std::function<void()>& fn, TaskGroup* group);
+	bool run_one(TaskGroup* group);
+	void wait(TaskGroup& group);
+};
+
+extern ThreadPool threadPool;
+
+#endif //THREAD_POOL_H_
@@ -1,5 +1,7 @@
 #include "Variables.h"
 
+#include <algorithm>
+
 std::string Variables::double_to_string(const double& d, const bool& round)
 {
 	std::ostringstream oss;
@@ -24,12 +26,104 @@ std::string Variables::double_to_string(const double& d, const bool& round)
 }
 
 
+int type_id(const std::string& type)
+{
+	static const std::unordered_map<std::string, int> typeIds = {
+		{"bool", VT_BOOL}, {"int", VT_INT}, {"double", VT_DOUBLE}, {"char", VT_CHAR}, {"string", VT_STRING},
+		{"std::bool", VT_STD_BOOL}, {"std::int", VT_STD_INT}, {"std::llint", VT_STD_LLINT},
+		{"std::double", VT_STD_DOUBLE}, {"std::char", VT_STD_CHAR}, {"std::string", VT_STD_STRING},
+		{"function", VT_FN}, {"fn", VT_FN}
+	};
+
+	auto found = typeIds.find(type);
+	if(found == typeIds.end())
+		return type.substr(0, 5) == "std::" ? VT_STD_OTHER : VT_OTHER;
+	return found->second;
+}
+
+static std::mutex names_mtx;
+static std::unordered_map<std::string, int> nameIds;
+
+//ids already handed to this thread are looked up without locking
+int name_id(const std::string& name)
+{
+	static thread_local std::unordered_map<std::string, int> threadIds;
+
+	auto found = threadIds.find(name);
+	if(found != threadIds.end())
+		return found->second;
+
+	names_mtx.lock();
+	int id = nameIds.emplace(name, nameIds.size()).first->second;
+	names_mtx.unlock();
+
+	threadIds[name] = id;
+	return id;
+}
+
+VType::VType()
+{
+	id = VT_UNKNOWN;
+}
+
+VType& VType::operator=(const std::string& type)
+{
+	str = type;
+	id = type_id(type);
+	return *this;
+}
+
+VType::operator const std::string&() const
+{
+	return str;
+}
+
+//adds text a line at a time so following lines are indented, a trailing newline is dropped
+static void add_lines(std::string& str, const std::string& text, const bool& indent, Indent& indentAmount)
+{
+	size_t linePos = 0, endPos, oldLinePos = 0, oldLineLen = 0;
+	while(linePos < text.size())
+	{
+		endPos = text.find('\n', linePos);
+		if(endPos == std::string::npos)
+			endPos = text.size();
+
+		if(linePos)
+			add_newline(str, indentAmount);
+		str.append(text, linePos, endPos - linePos);
+		oldLinePos = linePos;
+		oldLineLen = endPos - linePos;
+		linePos = endPos + 1;
+	}
+	if(indent)
+		indentAmount.add_text(text, oldLinePos, oldLineLen);
+}
+
+static void add_char(std::string& str, const char& c, const bool& indent, Indent& indentAmount)
+{
+	if(c == '\n')
+		add_newline(str, indentAmount);
+	else
+	{
+		str += c;
+		if(indent)
+		{
+			if(c == '\t')
+				indentAmount += '\t';
+			else
+				indentAmount += ' ';
+		}
+	}
+}
+
 VLayer::VLayer()
 {
 }
 
 VPos::VPos()
 {
+	typeId = VT_UNKNOWN;
+	id = -1;
 }
 
 Variables::Variables()
@@ -68,14 +162,22 @@ int Variables::add_layer(const std::string& scope)
 }
 
 bool Variables::find(const std::string& name, VPos& vpos)
+{
+	return find(name_id(name), vpos);
+}
+
+bool Variables::find(const int& id, VPos& vpos)
 {
 	for(int l=layers.size()-1; l>=0; --l)
 	{
-		if(layers[l].typeOf.count(name))
+		auto found = layers[l].typeOf.held.find(id);
+		if(found != layers[l].typeOf.held.end())
 		{
-			vpos.name = name;
+			vpos.name = found->second.name;
 			vpos.layer = l;
-			vpos.type = layers[l].typeOf[name];
+			vpos.type = found->second.value.str;
+			vpos.typeId = found->second.value.id;
+			vpos.id = id;
 
 			return 1;
 		}
@@ -85,14 +187,22 @@ bool Variables::find(const std::string& name, VPos& vpos)
 }
 
 bool Variables::find_fn(const std::string& name, VPos& vpos)
+{
+	return find_fn(name_id(name), name, vpos);
+}
+
+bool Variables::find_fn(const int& id, const std::string& name, VPos& vpos)
 {
 	for(int l=layers.size()-1; l>=0; --l)
 	{
-		if(layers[l].functions.count(name))
+		const VType* type = layers[l].typeOf.get(id);
+		if(type && layers[l].functions.count(name))
 		{
 			vpos.name = name;
 			vpos.layer = l;
-			vpos.type = layers[l].typeOf[name];
+			vpos.type = type->str;
+			vpos.typeId = type->id;
+			vpos.id = id;
 
 			return 1;
 		}
@@ -101,75 +211,64 @@ bool Variables::find_fn(const std::string& name, VPos& vpos)
 	return 0;
 }
 
-int Variables::get_bool_from_var(const VPos& vpos, bool& val)
+//body of a function split in to segments, split again if lua may have changed the body
+std::shared_ptr<const SegmentedText> Variables::segment_fn(const size_t& layer, const std::string& name, Parser& parser)
 {
-	val = 0;
-	if(vpos.type.substr(0, 5) == "std::")
-	{
-		if(vpos.type == "std::bool")
-		{
-			val = layers[vpos.layer].bools[vpos.name];
-			return 1;
-		}
-		else if(vpos.type == "std::int")
-		{
-			val = layers[vpos.layer].ints[vpos.name];
-			return 1;
-		}
-		else if(vpos.type == "std::double")
-		{
-			val = layers[vpos.layer].doubles[vpos.name];
-			return 1;
-		}
-		else if(vpos.type == "std::llint")
-		{
-			val = layers[vpos.layer].llints[vpos.name];
-			return 1;
-		}
-	}
-	else if(vpos.type == "bool" ||
-	        vpos.type == "int" ||
-	        vpos.type == "double")
+	std::shared_ptr<const SegmentedText>& segmented = layers[layer].segmentedFns[name];
+	const std::string& body = layers[layer].functions[name];
+
+	//definitions reset segmentedFns, so only bodies handed to lua need checking
+	if(segmented && layers[layer].luaFns.count(name))
+		if(segmented->text.size() != body.size() || segmented->contents->hash != FNVHash(body))
+			segmented.reset();
+
+	if(!segmented)
 	{
-		val = layers[vpos.layer].doubles[vpos.name];
-		return 1;
+		std::shared_ptr<FileContents> contents(new FileContents());
+		contents->str = body;
+		contents->hash = FNVHash(body);
+		segmented.reset(new SegmentedText(contents, parser));
 	}
 
-	return 0;
+	return segmented;
+}
+
+//type id of vpos, interning vpos.type if it wasn't set by find
+static int type_of(const VPos& vpos)
+{
+	if(vpos.typeId == VT_UNKNOWN)
+		return type_id(vpos.type);
+	return vpos.typeId;
+}
+
+int Variables::get_bool_from_var(const VPos& vpos, bool& val)
+{
+	double d;
+	int result = get_double_from_var(vpos, d);
+	val = d;
+	return result;
 }
 
 int Variables::get_double_from_var(const VPos& vpos, double& val)
 {
 	val = 0;
-	if(vpos.type.substr(0, 5) == "std::")
+	switch(type_of(vpos))
 	{
-		if(vpos.type == "std::bool")
-		{
-			val = layers[vpos.layer].bools[vpos.name];
+		case VT_STD_BOOL:
+			val = value_of(layers[vpos.layer].bools, vpos);
 			return 1;
-		}
-		else if(vpos.type == "std::int")
-		{
-			val = layers[vpos.layer].ints[vpos.name];
+		case VT_STD_INT:
+			val = value_of(layers[vpos.layer].ints, vpos);
 			return 1;
-		}
-		else if(vpos.type == "std::double")
-		{
-			val = layers[vpos.layer].doubles[vpos.name];
+		case VT_STD_DOUBLE:
+		case VT_BOOL:
+		case VT_INT:
+		case VT_DOUBLE:
+			val = value_of(layers[vpos.layer].doubles, vpos);
 			return 1;
-		}
-		else if(vpos.type == "std::llint")
-		{
-			val = layers[vpos.layer].llints[vpos.name];
+		case VT_STD_LLINT:
+			val = value_of(layers[vpos.layer].llints, vpos);
 			return 1;
-		}
-	}
-	else if(vpos.type == "bool" ||
-	        vpos.type == "int" ||
-	        vpos.type == "double")
-	{
-		val = layers[vpos.layer].doubles[vpos.name];
-		return 1;
 	}
 
 	return 0;
@@ -177,322 +276,356 @@ int Variables::get_double_from_var(const VPos& vpos, double& val)
 
 int Variables::get_str_from_var(const VPos& vpos, std::string& str, const bool& round, const bool& indent)
 {
-	std::string indentAmount = "";
+	Indent indentAmount;
 	return add_str_from_var(vpos, str, round, indent, indentAmount);
 }
 
-int Variables::add_str_from_var(const VPos& vpos, std::string& str, const bool& round, const bool& indent, std::string& indentAmount)
+int Variables::add_str_from_var(const VPos& vpos, std::string& str, const bool& round, const bool& indent, Indent& indentAmount)
 {
-	if(vpos.type.substr(0, 5) == "std::")
+	std::string val;
+
+	switch(type_of(vpos))
 	{
-		if(vpos.type == "std::bool")
-		{
-			if(layers[vpos.layer].bools[vpos.name])
-				str += "1";
-			else
-				str += "0";
+		case VT_STD_BOOL:
+			str += value_of(layers[vpos.layer].bools, vpos) ? '1' : '0';
 			if(indent)
 				indentAmount += ' ';
-
 			return 1;
-		}
-		else if(vpos.type == "std::int")
-		{
-			std::string val = std::to_string(layers[vpos.layer].ints[vpos.name]);
-			str += val;
+		case VT_BOOL:
+			str += value_of(layers[vpos.layer].doubles, vpos) ? '1' : '0';
 			if(indent)
-				indentAmount += into_whitespace(val);
-
+				indentAmount += ' ';
 			return 1;
-		}
-		else if(vpos.type == "std::double")
-		{
-			std::string val = double_to_string(layers[vpos.layer].doubles[vpos.name], round);
-			str += val;
-			if(indent)
-				indentAmount += into_whitespace(val);
-
+		case VT_STD_INT:
+			val = std::to_string(value_of(layers[vpos.layer].ints, vpos));
+			break;
+		case VT_INT:
+			val = std::to_string((int)value_of(layers[vpos.layer].doubles, vpos));
+			break;
+		case VT_STD_LLINT:
+			val = std::to_string(value_of(layers[vpos.layer].llints, vpos));
+			break;
+		case VT_STD_DOUBLE:
+		case VT_DOUBLE:
+			val = double_to_string(value_of(layers[vpos.layer].doubles, vpos), round);
+			break;
+		case VT_STD_CHAR:
+			add_char(str, value_of(layers[vpos.layer].chars, vpos), indent, indentAmount);
 			return 1;
-		}
-		else if(vpos.type == "std::char")
+		case VT_CHAR:
 		{
-			char val = layers[vpos.layer].chars[vpos.name];
-			if(val == '\n')
-				str += "\n" + indentAmount;
-			else
-			{
-				str += val;
-				if(indent)
-				{
-					if(val == '\t')
-						indentAmount += '\t';
-					else
-						indentAmount += ' ';
-				}
-			}
-
+			const std::string& valStr = value_of(layers[vpos.layer].strings, vpos);
+			add_char(str, valStr.size() ? valStr[0] : ' ', indent, indentAmount);
 			return 1;
 		}
-		else if(vpos.type == "std::string")
-		{
-			std::istringstream iss(layers[vpos.layer].strings[vpos.name]);
-			std::string ssLine, oldLine;
-			int ssLineNo = 0;
-
-			while(getline(iss, ssLine))
-			{
-				if(0 < ssLineNo++)
-					str += "\n" + indentAmount;
-				oldLine = ssLine;
-				str += ssLine;
-			}
-			if(indent)
-				indentAmount += into_whitespace(oldLine);
-
+		case VT_STD_STRING:
+		case VT_STRING:
+			add_lines(str, value_of(layers[vpos.layer].strings, vpos), indent, indentAmount);
 			return 1;
-		}
-		else if(vpos.type == "std::llint")
-		{
-			str += std::to_string(layers[vpos.layer].llints[vpos.name]);
-			if(indent)
-				indentAmount += into_whitespace(std::to_string(layers[vpos.layer].llints[vpos.name]));
-
+		case VT_FN:
+			add_lines(str, layers[vpos.layer].functions[vpos.name], indent, indentAmount);
 			return 1;
-		}
-	}
-	else if(vpos.type == "bool")
-	{
-		if(layers[vpos.layer].doubles[vpos.name])
-			str += "1";
-		else
-			str += "0";
-		if(indent)
-			indentAmount += ' ';
-
-		return 1;
+		default:
+			return 0;
 	}
-	else if(vpos.type == "int")
-	{
-		std::string val = std::to_string((int)layers[vpos.layer].doubles[vpos.name]);
-		str += val;
-		if(indent)
-			indentAmount += into_whitespace(val);
 
-		return 1;
-	}
-	else if(vpos.type == "double")
-	{
-		std::string val = double_to_string(layers[vpos.layer].doubles[vpos.name], round);
-		str += val;
-		if(indent)
-			indentAmount += into_whitespace(val);
+	str += val;
+	if(indent)
+		indentAmount.add_text(val);
 
-		return 1;
-	}
-	else if(vpos.type == "char")
-	{
-		std::string valStr = layers[vpos.layer].strings[vpos.name];
-		char val;
-		if(valStr.size())
-			val = valStr[0];
-		else
-			val = ' ';
+	return 1;
+}
 
-		if(val == '\n')
-			str += "\n" + indentAmount;
-		else
-		{
-			str += val;
-			if(indent)
-			{
-				if(val == '\t')
-					indentAmount += '\t';
-				else
-					indentAmount += ' ';
-			}
-		}
+//whether the variable at vpos can be set from the current scope
+static bool can_set(std::vector<VLayer>& layers, const VPos& vpos)
+{
+	VLayer& layer = layers[vpos.layer];
 
-		return 1;
-	}
-	else if(vpos.type == "string")
+	if(layer.constants.size() && layer.constants.count(vpos.name))
+		return 0;
+	if(layer.privates.size() && layer.privates.count(vpos.name))
 	{
-		std::istringstream iss(layers[vpos.layer].strings[vpos.name]);
-		std::string ssLine, oldLine;
-		int ssLineNo = 0;
-
-		while(getline(iss, ssLine))
-		{
-			if(0 < ssLineNo++)
-				str += "\n" + indentAmount;
-			oldLine = ssLine;
-			str += ssLine;
-		}
-		if(indent)
-			indentAmount += into_whitespace(oldLine);
-
-		return 1;
+		if(!layer.inScopes[vpos.name].count(layers[layers.size()-1].scope))
+			return 0;
 	}
-	else if(vpos.type == "function" || vpos.type == "fn")
-	{
-		std::istringstream iss(layers[vpos.layer].functions[vpos.name]);
-		std::string ssLine, oldLine;
-		int ssLineNo = 0;
 
-		while(getline(iss, ssLine))
-		{
-			if(0 < ssLineNo++)
-				str += "\n" + indentAmount;
-			oldLine = ssLine;
-			str += ssLine;
-		}
-		if(indent)
-			indentAmount += into_whitespace(oldLine);
-
-		return 1;
-	}
+	return 1;
+}
 
-	return 0;
+//type of the variable at vpos as currently declared
+static int declared_type(std::vector<VLayer>& layers, const VPos& vpos)
+{
+	if(vpos.typeId != VT_UNKNOWN)
+		return vpos.typeId;
+	return value_of(layers[vpos.layer].typeOf, vpos).id;
 }
 
 int Variables::set_var_from_str(const VPos& vpos, const std::string& value)
 {
-	if(layers[vpos.layer].constants.count(vpos.name))
-	{
+	if(!can_set(layers, vpos))
 		return 0;
-	}
-	if(layers[vpos.layer].privates.count(vpos.name))
-	{
-		if(!layers[vpos.layer].inScopes[vpos.name].count(layers[layers.size()-1].scope))
-			return 0;
-	}
 
-	std::string varType = layers[vpos.layer].typeOf[vpos.name];
-	if(varType.substr(0, 5) == "std::")
+	VLayer& layer = layers[vpos.layer];
+	switch(declared_type(layers, vpos))
 	{
-		if(varType == "std::bool")
-		{
+		case VT_STD_BOOL:
 			if(isInt(value))
-				layers[vpos.layer].bools[vpos.name] = (bool)std::atoi(value.c_str());
+				value_of(layer.bools, vpos) = (bool)std::atoi(value.c_str());
 			else if(isDouble(value))
-				layers[vpos.layer].bools[vpos.name] = (bool)std::strtod(value.c_str(), NULL);
+				value_of(layer.bools, vpos) = (bool)std::strtod(value.c_str(), NULL);
 			else
 				return 0;
-		}
-		else if(varType == "std::int")
-		{
+			break;
+		case VT_STD_INT:
 			if(isInt(value))
-				layers[vpos.layer].ints[vpos.name] = std::atoi(value.c_str());
+				value_of(layer.ints, vpos) = std::atoi(value.c_str());
 			else if(isDouble(value))
-				layers[vpos.layer].ints[vpos.name] = (int)std::strtod(value.c_str(), NULL);
+				value_of(layer.ints, vpos) = (int)std::strtod(value.c_str(), NULL);
 			else
 				return 0;
-		}
-		else if(varType == "std::double")
-		{
+			break;
+		case VT_STD_DOUBLE:
+		case VT_DOUBLE:
 			if(isDouble(value))
-				layers[vpos.layer].doubles[vpos.name] = std::strtod(value.c_str(), NULL);
+				value_of(layer.doubles, vpos) = std::strtod(value.c_str(), NULL);
 			else
 				return 0;
-		}
-		else if(varType == "std::char")
-		{
+			break;
+		case VT_STD_CHAR:
 			if(value.size() == 1)
-				layers[vpos.layer].chars[vpos.name] = value[0];
+				value_of(layer.chars, vpos) = value[0];
 			else
 				return 0;
-		}
-		else if(varType == "std::string")
-			layers[vpos.layer].strings[vpos.name] = value;
-		else if(varType == "std::llint")
-		{
+			break;
+		case VT_STD_STRING:
+		case VT_STRING:
+			value_of(layer.strings, vpos) = value;
+			break;
+		case VT_STD_LLINT:
 			if(isInt(value))
-				layers[vpos.layer].llints[vpos.name] = std::atoll(value.c_str());
+				value_of(layer.llints, vpos) = std::atoll(value.c_str());
 			else if(isDouble(value))
-				layers[vpos.layer].ints[vpos.name] = (long long int)std::strtod(value.c_str(), NULL);
+				value_of(layer.ints, vpos) = (long long int)std::strtod(value.c_str(), NULL);
 			else
 				return 0;
-		}
-	}
-	else if(varType == "bool")
-	{
-		if(isInt(value))
-			layers[vpos.layer].doubles[vpos.name] = (bool)std::atoi(value.c_str());
-		else if(isDouble(value))
-			layers[vpos.layer].doubles[vpos.name] = (bool)std::strtod(value.c_str(), NULL);
-		else
-			return 0;
-	}
-	else if(varType == "int")
-	{
-		if(isInt(value))
-			layers[vpos.layer].doubles[vpos.name] = std::atoi(value.c_str());
-		else if(isDouble(value))
-			layers[vpos.layer].doubles[vpos.name] = (int)std::strtod(value.c_str(), NULL);
-		else
-			return 0;
-	}
-	else if(varType == "double")
-	{
-		if(isDouble(value))
-			layers[vpos.layer].doubles[vpos.name] = std::strtod(value.c_str(), NULL);
-		else
-			return 0;
-	}
-	else if(varType == "char")
-	{
-		if(value.size() == 1)
-			layers[vpos.layer].strings[vpos.name] = value[0];
-		else
+			break;
+		case VT_BOOL:
+			if(isInt(value))
+				value_of(layer.doubles, vpos) = (bool)std::atoi(value.c_str());
+			else if(isDouble(value))
+				value_of(layer.doubles, vpos) = (bool)std::strtod(value.c_str(), NULL);
+			else
+				return 0;
+			break;
+		case VT_INT:
+			if(isInt(value))
+				value_of(layer.doubles, vpos) = std::atoi(value.c_str());
+			else if(isDouble(value))
+				value_of(layer.doubles, vpos) = (int)std::strtod(value.c_str(), NULL);
+			else
+				return 0;
+			break;
+		case VT_CHAR:
+			if(value.size() == 1)
+				value_of(layer.strings, vpos) = value[0];
+			else
+				return 0;
+			break;
+		case VT_STD_OTHER:
+			break;
+		default:
 			return 0;
 	}
-	else if(varType == "string")
-		layers[vpos.layer].strings[vpos.name] = value;
-	else
-		return 0;
 
 	return 1;
 }
 
 int Variables::set_var_from_double(const VPos& vpos, const double& value)
 {
-	if(layers[vpos.layer].constants.count(vpos.name))
-	{
+	if(!can_set(layers, vpos))
 		return 0;
-	}
-	if(layers[vpos.layer].privates.count(vpos.name))
+
+	VLayer& layer = layers[vpos.layer];
+	switch(declared_type(layers, vpos))
 	{
-		if(!layers[vpos.layer].inScopes[vpos.name].count(layers[layers.size()-1].scope))
+		case VT_STD_BOOL:
+			value_of(layer.bools, vpos) = (bool)value;
+			break;
+		case VT_STD_INT:
+			value_of(layer.ints, vpos) = (int)value;
+			break;
+		case VT_STD_DOUBLE:
+		case VT_DOUBLE:
+			value_of(layer.doubles, vpos) = value;
+			break;
+		case VT_STD_CHAR:
+			value_of(layer.chars, vpos) = std::to_string(value)[0];
+			break;
+		case VT_STD_STRING:
+			value_of(layer.strings, vpos) = std::to_string(value);
+			break;
+		case VT_STD_LLINT:
+			value_of(layer.llints, vpos) = (long long int)value;
+			break;
+		case VT_BOOL:
+			value_of(layer.doubles, vpos) = (bool)value;
+			break;
+		case VT_INT:
+			value_of(layer.doubles, vpos) = (int)value;
+			break;
+		case VT_CHAR:
+			value_of(layer.strings, vpos) = std::to_string(value)[0];
+			break;
+		case VT_STRING:
+			value_of(layer.strings, vpos) = std::to_string(value);
+			break;
+		case VT_STD_OTHER:
+			break;
+		default:
 			return 0;
 	}
 
-	std::string varType = layers[vpos.layer].typeOf[vpos.name];
-	if(varType.substr(0, 5) == "std::")
+	return 1;
+}
+
+//entries are sorted before hashing so the order of hash maps doesn't matter
+static void add_entry(std::vector<std::string>& entries, const std::string& layerStr, const char& kind, const std::string& name, const std::string& value)
+{
+	entries.push_back(layerStr + kind + std::to_string(name.size()) + ":" + name + value);
+}
+
+static std::string bytes_of(const double& d)
+{
+	return std::string((const char*)&d, sizeof(d));
+}
+
+std::string Variables::fingerprint() const
+{
+	std::vector<std::string> entries;
+	std::string layerStr, value;
+
+	for(size_t l=0; l<layers.size(); ++l)
 	{
-		if(varType == "std::bool")
-			layers[vpos.layer].bools[vpos.name] = (bool)value;
-		else if(varType == "std::int")
-			layers[vpos.layer].ints[vpos.name] = (int)value;
-		else if(varType == "std::double")
-			layers[vpos.layer].doubles[vpos.name] = value;
-		else if(varType == "std::char")
-			layers[vpos.layer].chars[vpos.name] = std::to_string(value)[0];
-		else if(varType == "std::string")
-			layers[vpos.layer].strings[vpos.name] = std::to_string(value);
-		else if(varType == "std::llint")
-			layers[vpos.layer].llints[vpos.name] = (long long int)value;
+		const VLayer& layer = layers[l];
+		layerStr = std::to_string(l) + " " + layer.scope + "\n";
+
+		for(auto it=layer.typeOf.held.begin(); it!=layer.typeOf.held.end(); ++it)
+			add_entry(entries, layerStr, 't', it->second.name, it->second.value.str);
+		for(auto it=layer.scopeOf.begin(); it!=layer.scopeOf.end(); ++it)
+			add_entry(entries, layerStr, 's', it->first, it->second);
+		for(auto it=layer.inScopes.begin(); it!=layer.inScopes.end(); ++it)
+			for(auto name=it->second.begin(); name!=it->second.end(); ++name)
+				add_entry(entries, layerStr, 'S', it->first, *name);
+		for(auto it=layer.constants.begin(); it!=layer.constants.end(); ++it)
+			add_entry(entries, layerStr, 'c', *it, "");
+		for(auto it=layer.privates.begin(); it!=layer.privates.end(); ++it)
+			add_entry(entries, layerStr, 'p', *it, "");
+		for(auto it=layer.functions.begin(); it!=layer.functions.end(); ++it)
+			add_entry(entries, layerStr, 'f', it->first, it->second);
+		for(auto it=layer.nFns.begin(); it!=layer.nFns.end(); ++it)
+			add_entry(entries, layerStr, 'n', *it, "");
+		for(auto it=layer.unscopedFns.begin(); it!=layer.unscopedFns.end(); ++it)
+			add_entry(entries, layerStr, 'u', *it, "");
+		for(auto it=layer.noOutput.begin(); it!=layer.noOutput.end(); ++it)
+			add_entry(entries, layerStr, 'o', *it, "");
+		for(auto it=layer.paths.begin(); it!=layer.paths.end(); ++it)
+			add_entry(entries, layerStr, 'P', it->first, it->second.str());
+
+		for(auto it=layer.bools.held.begin(); it!=layer.bools.held.end(); ++it)
+			add_entry(entries, layerStr, 'b', it->second.name, it->second.value ? "1" : "0");
+		for(auto it=layer.ints.held.begin(); it!=layer.ints.held.end(); ++it)
+			add_entry(entries, layerStr, 'i', it->second.name, std::to_string(it->second.value));
+		for(auto it=layer.llints.held.begin(); it!=layer.llints.held.end(); ++it)
+			add_entry(entries, layerStr, 'l', it->second.name, std::to_string(it->second.value));
+		for(auto it=layer.doubles.held.begin(); it!=layer.doubles.held.end(); ++it)
+			add_entry(entries, layerStr, 'd', it->second.name, bytes_of(it->second.value));
+		for(auto it=layer.chars.held.begin(); it!=layer.chars.held.end(); ++it)
+			add_entry(entries, layerStr, 'C', it->second.name, std::string(1, it->second.value));
+		for(auto it=layer.strings.held.begin(); it!=layer.strings.held.end(); ++it)
+			add_entry(entries, layerStr, 'x', it->second.name, it->second.value);
+		for(auto it=layer.doubVecs.held.begin(); it!=layer.doubVecs.held.end(); ++it)
+		{
+			const std::vector<double>& vec = it->second.value;
+			value.clear();
+			for(size_t d=0; d<vec.size(); ++d)
+				value += bytes_of(vec[d]);
+			add_entry(entries, layerStr, 'D', it->second.name, value);
+		}
+		for(auto it=layer.strVecs.held.begin(); it!=layer.strVecs.held.end(); ++it)
+		{
+			const std::vector<std::string>& vec = it->second.value;
+			value.clear();
+			for(size_t v=0; v<vec.size(); ++v)
+				value += std::to_string(vec[v].size()) + ":" + vec[v];
+			add_entry(entries, layerStr, 'X', it->second.name, value);
+		}
 	}
-	else if(varType == "bool")
-		layers[vpos.layer].doubles[vpos.name] = (bool)value;
-	else if(varType == "int")
-		layers[vpos.layer].doubles[vpos.name] = (int)value;
-	else if(varType == "double")
-		layers[vpos.layer].doubles[vpos.name] = value;
-	else if(varType == "char")
-		layers[vpos.layer].strings[vpos.name] = std::to_string(value)[0];
-	else if(varType == "string")
-		layers[vpos.layer].strings[vpos.name] = std::to_string(value);
-	else
-		return 0;
 
-	return 1;
+	for(auto it=typeDefs.begin(); it!=typeDefs.end(); ++it)
+		add_entry(entries, "", 'T', it->first, it->second);
+	for(auto it=nTypes.begin(); it!=nTypes.end(); ++it)
+		add_entry(entries, "", 'N', *it, "");
+	add_entry(entries, "", 'r', std::to_string(precision), std::to_string(fixedPrecision) + std::to_string(scientificPrecision));
+
+	std::sort(entries.begin(), entries.end());
+
+	std::string all;
+	for(size_t e=0; e<entries.size(); ++e)
+		all += std::to_string(entries[e].size()) + ":" + entries[e];
+
+	return hex_digest(all);
+}
+
+bool Variables::has_streams() const
+{
+	for(size_t l=0; l<layers.size(); ++l)
+		if(layers[l].fstreams.size() || layers[l].ifstreams.size() || layers[l].ofstreams.size())
+			return 1;
+
+	return 0;
+}
+
+//copies everything but file streams, which can't be copied (check has_streams first)
+void Variables::copy_from(const Variables& other)
+{
+	layers.resize(other.layers.size());
+	for(size_t l=0; l<layers.size(); ++l)
+	{
+		VLayer& layer = layers[l];
+		const VLayer& otherLayer = other.layers[l];
+
+		layer.scope = otherLayer.scope;
+		layer.constants = otherLayer.constants;
+		layer.privates = otherLayer.privates;
+		layer.inScopes = otherLayer.inScopes;
+		layer.scopeOf = otherLayer.scopeOf;
+		layer.typeOf = otherLayer.typeOf;
+		layer.functions = otherLayer.functions;
+		layer.segmentedFns = otherLayer.segmentedFns;
+		layer.luaFns = otherLayer.luaFns;
+		layer.nFns = otherLayer.nFns;
+		layer.unscopedFns = otherLayer.unscopedFns;
+		layer.noOutput = otherLayer.noOutput;
+		layer.paths = otherLayer.paths;
+		layer.bools = otherLayer.bools;
+		layer.ints = otherLayer.ints;
+		layer.llints = otherLayer.llints;
+		layer.doubles = otherLayer.doubles;
+		layer.chars = otherLayer.chars;
+		layer.strings = otherLayer.strings;
+		layer.doubVecs = otherLayer.doubVecs;
+		layer.strVecs = otherLayer.strVecs;
+		layer.fstreams.clear();
+		layer.ifstreams.clear();
+		layer.ofstreams.clear();
+	}
+
+	basic_types = other.basic_types;
+	typeDefs = other.typeDefs;
+	nTypes = other.nTypes;
+	typeDefPath = other.typeDefPath;
+	typeDefLineNo = other.typeDefLineNo;
+	precision = other.precision;
+	fixedPrecision = other.fixedPrecision;
+	scientificPrecision = other.scientificPrecision;
 }
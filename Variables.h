@@ -11,10 +11,123 @@
 #include <unordered_set>
 #include <vector>
 
+#include "Indent.h"
 #include "NumFns.h"
 #include "Path.h"
 #include "StrFns.h"
+#include "TemplateCache.h"
+
+//variable types interned from their names, so accesses switch rather than compare strings
+const int VT_UNKNOWN    = -1; //not interned yet
+const int VT_OTHER      = 0;
+const int VT_BOOL       = 1;
+const int VT_INT        = 2;
+const int VT_DOUBLE     = 3;
+const int VT_CHAR       = 4;
+const int VT_STRING     = 5;
+const int VT_STD_BOOL   = 6;
+const int VT_STD_INT    = 7;
+const int VT_STD_LLINT  = 8;
+const int VT_STD_DOUBLE = 9;
+const int VT_STD_CHAR   = 10;
+const int VT_STD_STRING = 11;
+const int VT_FN         = 12;
+const int VT_STD_OTHER  = 13; //std:: types without a scalar value
+
+int type_id(const std::string& type);
+
+//interned id of a variable or function name, the same for every thread
+int name_id(const std::string& name);
+
+//declared type of a variable along with its interned type id
+struct VType
+{
+	std::string str;
+	int id;
+
+	VType();
+	VType& operator=(const std::string& type);
+	operator const std::string&() const;
+};
 
+/*
+	values of one type in a layer keyed by interned name id, so finding a
+	value hashes an int rather than the name. each value is held in a node
+	of its own which stays put as others come and go, exprtk and lua hold
+	references to them. indexing by name interns the name first.
+*/
+template <typename T>
+struct Slots
+{
+	struct Slot
+	{
+		std::string name;
+		T value;
+	};
+
+	std::unordered_map<int, Slot> held;
+
+	//value of id, added if there isn't one
+	T& at(const int& id, const std::string& name)
+	{
+		auto found = held.find(id);
+		if(found != held.end())
+			return found->second.value;
+
+		Slot& slot = held[id];
+		slot.name = name;
+		return slot.value;
+	}
+
+	//value of id, NULL if there isn't one
+	const T* get(const int& id) const
+	{
+		auto found = held.find(id);
+		if(found == held.end())
+			return NULL;
+		return &found->second.value;
+	}
+
+	const T* get(const std::string& name) const
+	{
+		return get(name_id(name));
+	}
+
+	T& operator[](const std::string& name)
+	{
+		return at(name_id(name), name);
+	}
+
+	size_t count(const int& id) const
+	{
+		return held.count(id);
+	}
+
+	size_t count(const std::string& name) const
+	{
+		return held.count(name_id(name));
+	}
+
+	size_t erase(const int& id)
+	{
+		return held.erase(id);
+	}
+
+	size_t erase(const std::string& name)
+	{
+		return held.erase(name_id(name));
+	}
+
+	size_t size() const
+	{
+		return held.size();
+	}
+};
+
+/*
+	variables are found by interned name id in typeOf, values are held in
+	slots which exprtk and lua refer to directly
+*/
 struct VLayer
 {
 	std::string scope;
@@ -22,21 +135,23 @@ struct VLayer
 
 	std::unordered_map<std::string, std::unordered_set<std::string> > inScopes;
 	std::unordered_map<std::string, std::string> scopeOf;
-	std::unordered_map<std::string, std::string> typeOf;
+	Slots<VType> typeOf;
 
 	std::unordered_map<std::string, std::string> functions;
+	std::unordered_map<std::string, std::shared_ptr<const SegmentedText> > segmentedFns;
+	std::unordered_set<std::string> luaFns; //functions lua has been handed a pointer to, their bodies may change without being redefined
 	std::unordered_set<std::string> nFns, unscopedFns, noOutput;
 	std::map<std::string, Path> paths;
 	//std::map<std::string, int> funcDefLineNo;
 
-	std::map<std::string, bool> bools;
-	std::unordered_map<std::string, int> ints;
-	std::map<std::string, long long int> llints;
-	std::map<std::string, double> doubles;
-	std::map<std::string, char> chars;
-	std::map<std::string, std::string> strings;
-	std::map<std::string, std::vector<double> > doubVecs;
-	std::map<std::string, std::vector<std::string> > strVecs;
+	Slots<bool> bools;
+	Slots<int> ints;
+	Slots<long long int> llints;
+	Slots<double> doubles;
+	Slots<char> chars;
+	Slots<std::string> strings;
+	Slots<std::vector<double> > doubVecs;
+	Slots<std::vector<std::string> > strVecs;
 	std::map<std::string, std::fstream> fstreams;
 	std::map<std::string, std::ifstream> ifstreams;
 	std::map<std::string, std::ofstream> ofstreams;
@@ -46,12 +161,22 @@ struct VLayer
 
 struct VPos
 {
-	int layer;
+	int layer, typeId; //typeId is VT_UNKNOWN when type is set without find
+	int id; //interned name, -1 when not found by find
 	std::string name, type;
 
 	VPos();
 };
 
+//value at vpos, by the id find interned rather than the name when there is one
+template <typename T>
+T& value_of(Slots<T>& slots, const VPos& vpos)
+{
+	if(vpos.id >= 0)
+		return slots.at(vpos.id, vpos.name);
+	return slots[vpos.name];
+}
+
 struct Variables
 {
 	std::vector<VLayer> layers;
@@ -70,7 +195,15 @@ struct Variables
 
 	int add_layer(const std::string& scope);
 	bool find(const std::string& name, VPos& vpos);
+	bool find(const int& id, VPos& vpos);
 	bool find_fn(const std::string& name, VPos& vpos);
+	bool find_fn(const int& id, const std::string& name, VPos& vpos);
+	std::shared_ptr<const SegmentedText> segment_fn(const size_t& layer, const std::string& name, Parser& parser);
+
+	//digest of every variable, function and type definition, to tell whether any were changed
+	std::string fingerprint() const;
+	bool has_streams() const;
+	void copy_from(const Variables& other);
 
 	int get_bool_from_var(const VPos& vpos, bool& val);
 	int get_double_from_var(const VPos& vpos, double& val);
@@ -82,7 +215,7 @@ struct Variables
 	                     std::string& str,
 	                     const bool& round,
 	                     const bool& indent,
-	                     std::string& indentAmount);
+	                     Indent& indentAmount);
 
 	int set_var_from_str(const VPos& vpos, const std::string& value);
 	int set_var_from_double(const VPos& vpos, const double& value);
@@ -0,0 +1,247 @@
+#!/bin/bash
+# generates a synthetic project and times nsm on it
+#
+# usage: bench/bench.sh (path-to-nsm)
+#
+# project shape is set with environment variables:
+#   BENCH_PAGES      number of pages                           (default 1000)
+#   BENCH_DEPTH      depth of @input partials below template   (default 3)
+#   BENCH_FANOUT     partials each template/partial inputs     (default 3)
+#   BENCH_PAGINATE   every nth page paginates, 0 for none      (default 50)
+#   BENCH_ITEMS      pagination items on paginating pages      (default 40)
+#   BENCH_SCRIPTED   every nth page runs exprtk & lua loops    (default 10)
+#   BENCH_SYSTEM     every nth page makes an @system call      (default 100)
+#   BENCH_THREADS    number of build threads, blank for nsm's  (default blank)
+#   BENCH_DIR        where to generate the project             (default mktemp -d)
+#   BENCH_OUT        results are written to BENCH_OUT.json/csv (default bench-results)
+#   BENCH_KEEP       set to 1 to keep the generated project
+
+set -e
+
+NSM=$(cd "$(dirname "${1:-./nsm}")" && pwd)/$(basename "${1:-./nsm}")
+PAGES=${BENCH_PAGES:-1000}
+DEPTH=${BENCH_DEPTH:-3}
+FANOUT=${BENCH_FANOUT:-3}
+PAGINATE=${BENCH_PAGINATE:-50}
+ITEMS=${BENCH_ITEMS:-40}
+SCRIPTED=${BENCH_SCRIPTED:-10}
+SYSTEM=${BENCH_SYSTEM:-100}
+THREADS=${BENCH_THREADS:-}
+OUT=${BENCH_OUT:-bench-results}
+case "$OUT" in
+	/*) ;;
+	*) OUT=$(pwd)/$OUT ;;
+esac
+
+if [ ! -x "$NSM" ]; then
+	echo "bench: cannot find nsm binary $NSM, run make first" >&2
+	exit 1
+fi
+
+WORK=${BENCH_DIR:-$(mktemp -d "${TMPDIR:-/tmp}/nsm-bench.XXXXXX")}
+mkdir -p "$WORK"
+SITE=$WORK/site
+LOG=$WORK/bench.log
+rm -rf "$SITE"
+mkdir -p "$SITE"
+: > "$LOG"
+
+cleanup()
+{
+	if [ "$BENCH_KEEP" != "1" ] && [ -z "$BENCH_DIR" ]; then
+		chmod -R u+w "$WORK" 2>/dev/null || true
+		rm -rf "$WORK"
+	fi
+}
+trap cleanup EXIT
+
+# peak RSS comes from GNU time when installed, otherwise from python's getrusage
+GNU_TIME=""
+if [ -x /usr/bin/time ] && /usr/bin/time -f "%M" -o /dev/null true 2>/dev/null; then
+	GNU_TIME=/usr/bin/time
+fi
+PYTHON=$(command -v python3 || true)
+RSS_PY='import resource, subprocess, sys
+ret = subprocess.call(sys.argv[2:], stdout=open(sys.argv[1], "a"), stderr=subprocess.STDOUT)
+print(resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss)
+sys.exit(ret)'
+
+LABELS=()
+SECS=()
+RSS=()
+
+# measure label cmd args..
+measure()
+{
+	local label=$1
+	shift
+	local start end rss=""
+
+	echo "== $label" >> "$LOG"
+	start=$(date +%s%N)
+	if [ -n "$GNU_TIME" ]; then
+		"$GNU_TIME" -f "%M" -o "$WORK/rss" "$@" >> "$LOG" 2>&1 || fail "$label"
+		rss=$(tail -n 1 "$WORK/rss")
+	elif [ -n "$PYTHON" ]; then
+		rss=$("$PYTHON" -c "$RSS_PY" "$LOG" "$@") || fail "$label"
+	else
+		"$@" >> "$LOG" 2>&1 || fail "$label"
+	fi
+	end=$(date +%s%N)
+
+	LABELS+=("$label")
+	SECS+=("$(awk "BEGIN { printf \"%.4f\", ($end - $start)/1000000000 }")")
+	RSS+=("$rss")
+	printf "%-26s %10ss %12s KB\n" "$label" "${SECS[${#SECS[@]}-1]}" "${rss:--}"
+}
+
+fail()
+{
+	echo "bench: $1 failed, see output below" >&2
+	tail -n 20 "$LOG" >&2
+	exit 1
+}
+
+## generates project
+
+cd "$SITE"
+"$NSM" init .html >> "$LOG" 2>&1
+if [ -n "$THREADS" ]; then
+	"$NSM" no-build-thrds "$THREADS" >> "$LOG" 2>&1
+fi
+
+mkdir -p templates/partials content/pages
+
+# partial l<d>_<k> inputs every partial on the next level down
+for (( d=DEPTH; d>=1; d-- )); do
+	for (( k=0; k<FANOUT; k++ )); do
+		f=templates/partials/l${d}_${k}.html
+		echo "<div class=\"l$d p$k\">" > "$f"
+		echo "	<p>partial $d.$k for \$[title]</p>" >> "$f"
+		if [ "$d" -lt "$DEPTH" ]; then
+			for (( c=0; c<FANOUT; c++ )); do
+				echo "	@input(\"templates/partials/l$((d+1))_$c.html\")" >> "$f"
+			done
+		fi
+		echo "</div>" >> "$f"
+	done
+done
+
+{
+	echo "<!doctype html>"
+	echo "<html>"
+	echo "	<head>"
+	echo "		<title>\$[title]</title>"
+	echo "	</head>"
+	echo "	<body>"
+	if [ "$DEPTH" -gt 0 ]; then
+		for (( k=0; k<FANOUT; k++ )); do
+			echo "		@input(\"templates/partials/l1_$k.html\")"
+		done
+	fi
+	echo "		<main>"
+	echo "			@content"
+	echo "		</main>"
+	echo "	</body>"
+	echo "</html>"
+} > templates/template.html
+
+for (( p=1; p<=PAGES; p++ )); do
+	f=content/pages/page$p.html
+	{
+		echo "<h1>page $p</h1>"
+		for (( l=0; l<8; l++ )); do
+			echo "<p>paragraph $l of page $p with some filler text to parse</p>"
+		done
+
+		if [ "$SCRIPTED" -gt 0 ] && [ $((p % SCRIPTED)) -eq 0 ]; then
+			echo "@exprtk"
+			echo "{"
+			echo "	var s := 0;"
+			echo "	for(var i := 0; i < 2000; i += 1) { s += i*i; };"
+			echo "	s;"
+			echo "}"
+			echo "@lua_addnsmfns"
+			echo "@lua{!o}"
+			echo "{"
+			echo "	local s = 0"
+			echo "	for i=1,2000 do s = s + i*i end"
+			echo "	nsm_write(ofile, tostring(s))"
+			echo "}"
+		fi
+
+		if [ "$SYSTEM" -gt 0 ] && [ $((p % SYSTEM)) -eq 0 ]; then
+			echo "@sys(\"echo system output $p\")"
+		fi
+
+		if [ "$PAGINATE" -gt 0 ] && [ $((p % PAGINATE)) -eq 0 ]; then
+			echo "@paginate.no_items_per_page(10)"
+			echo "@paginate.template"
+			echo "{"
+			echo "	<section>"
+			echo "		\$[paginate.page]"
+			echo "		<p>page \$[paginate.page_no] of \$[paginate.no_pages]</p>"
+			echo "	</section>"
+			echo "}"
+			echo "@paginate"
+			for (( i=1; i<=ITEMS; i++ )); do
+				echo "@item"
+				echo "{"
+				echo "	<p>item $i of page $p</p>"
+				echo "}"
+			done
+		fi
+	} > "$f"
+done
+
+## times commands
+
+measure track-dir "$NSM" track-dir content/pages/
+measure build-all "$NSM" build-all
+if grep -q "failed to build" "$LOG"; then
+	fail build-all
+fi
+measure build-updated-noop "$NSM" build-updated
+echo "<p>changed</p>" >> content/pages/page1.html
+measure build-updated-one "$NSM" build-updated
+touch -d "+2 seconds" "templates/partials/l${DEPTH}_0.html" 2>/dev/null || touch "templates/partials/l${DEPTH}_0.html"
+measure status "$NSM" status
+measure build-updated-partial "$NSM" build-updated
+
+## writes results
+
+NO_OUTPUT=$(find output -type f | wc -l | tr -d ' ')
+
+{
+	echo "{"
+	echo "	\"nsm\": \"$("$NSM" version 2>/dev/null | head -n 1 | sed 's/\x1b\[[0-9;]*m//g' | tr -d '"')\","
+	echo "	\"pages\": $PAGES,"
+	echo "	\"depth\": $DEPTH,"
+	echo "	\"fanout\": $FANOUT,"
+	echo "	\"paginate\": $PAGINATE,"
+	echo "	\"items\": $ITEMS,"
+	echo "	\"scripted\": $SCRIPTED,"
+	echo "	\"system\": $SYSTEM,"
+	echo "	\"threads\": \"$THREADS\","
+	echo "	\"output-files\": $NO_OUTPUT,"
+	echo "	\"results\": ["
+	for (( r=0; r<${#LABELS[@]}; r++ )); do
+		echo -n "		{\"step\": \"${LABELS[$r]}\", \"seconds\": ${SECS[$r]}, \"peak-rss-kb\": ${RSS[$r]:-null}}"
+		if [ $r -lt $((${#LABELS[@]}-1)) ]; then
+			echo ","
+		else
+			echo ""
+		fi
+	done
+	echo "	]"
+	echo "}"
+} > "$OUT.json"
+
+{
+	echo "step,seconds,peak-rss-kb"
+	for (( r=0; r<${#LABELS[@]}; r++ )); do
+		echo "${LABELS[$r]},${SECS[$r]},${RSS[$r]}"
+	done
+} > "$OUT.csv"
+
+echo "results written to $OUT.json and $OUT.csv"
@@ -0,0 +1,97 @@
+/*
+	times calls going through Parser::read_and_process_fn, from reading
+	the name through to the builtin table handing the call to its handler,
+	for builtins early and late in the old first character chain, a builtin
+	added with register_builtin and a user-defined function.
+
+	usage: make bench-dispatch
+	       bench/dispatch_bench (no-calls)
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+
+#include "../Parser.h"
+
+static std::mutex os_mtx;
+
+static int bench_echo(Parser& /*parser*/,
+                      const std::vector<std::string>& /*options*/,
+                      const std::vector<std::string>& params,
+                      const Path& /*readPath*/,
+                      const int& /*lineNo*/,
+                      std::string& output,
+                      std::ostream& /*eos*/)
+{
+	if(params.size())
+		output = params[0];
+	return 0;
+}
+
+//nanoseconds per call processing noCalls copies of call, best of noRuns
+static double time_calls(Parser& parser, const std::string& call, const size_t& noCalls)
+{
+	const size_t perStr = 1000, noRuns = 5;
+	std::string inStr, outStr;
+	for(size_t c=0; c<perStr; ++c)
+		inStr += call;
+	std::set<Path> antiDepsOfReadPath;
+	Path readPath("", "bench");
+	double best = -1;
+
+	for(size_t r=0; r<noRuns; ++r)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for(size_t c=0; c<noCalls; c+=perStr)
+		{
+			outStr.clear();
+			if(parser.n_read_and_process_fast(0, 0, inStr, 0, readPath, antiDepsOfReadPath, outStr, std::cout) > 0)
+			{
+				std::cout << "dispatch_bench: failed to process " << call << std::endl;
+				return -1;
+			}
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		double ns = std::chrono::duration<double, std::nano>(end - start).count()/noCalls;
+		if(best < 0 || ns < best)
+			best = ns;
+	}
+
+	return best;
+}
+
+static void output_row(Parser& parser, const std::string& label, const std::string& call, const size_t& noCalls)
+{
+	std::cout << std::left << std::setw(24) << label << std::setw(20) << call << std::right;
+	std::cout << std::setw(10) << time_calls(parser, call, noCalls) << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t noCalls = 2000000;
+	if(argc > 1)
+		noCalls = std::strtoul(argv[1], NULL, 10);
+
+	if(register_builtin("bench.echo", 0, 1, 0, bench_echo))
+		return 1;
+
+	std::set<TrackedInfo> trackedAll;
+	Parser parser(&trackedAll, &os_mtx, "content/", "output/", ".content", ".html", ".f", Path("template/", "page.template"), 0, "nano", "notepad");
+
+	std::string trash;
+	std::set<Path> antiDepsOfReadPath;
+	if(parser.n_read_and_process_fast(0, 0, "@fn(bench_fn){}", 0, Path("", "bench"), antiDepsOfReadPath, trash, std::cout) > 0)
+		return 1;
+
+	std::cout << noCalls << " calls each, best of 5 runs" << std::endl;
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << std::left << std::setw(44) << "call" << std::right << std::setw(10) << "ns/call" << std::endl;
+	output_row(parser, "early builtin", "@console.locked()", noCalls);
+	output_row(parser, "late builtin", "@add_scope()", noCalls);
+	output_row(parser, "registered builtin", "@bench.echo()", noCalls);
+	output_row(parser, "user-defined function", "@bench_fn()", noCalls);
+
+	return 0;
+}
@@ -0,0 +1,142 @@
+/*
+	times outputting the literal text of a large template, comparing the
+	character at a time loop n_read_and_process_fast used to have against
+	finding the next special character and appending the run in one go.
+
+	usage: make bench-scan
+	       bench/scan_bench (template-MB) (passes)
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "../Indent.h"
+#include "../Scanner.h"
+
+//html heavy template text with the odd n++ special character
+static std::string make_template(const size_t& noBytes)
+{
+	const char* lines[] = {
+		"\t\t<div class=\"content\">",
+		"\t\t\t<p>Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore.</p>",
+		"\t\t\t<p>Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo.</p>",
+		"\t\t\t<a href=\"https://example.com/some/fairly/long/path/to/a/page.html\" title=\"a link title\">link text</a>",
+		"\t\t\t<span>Duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla.</span>",
+		"\t\t</div>"
+	};
+	size_t noLines = sizeof(lines)/sizeof(lines[0]);
+
+	std::string text;
+	for(size_t l=0; text.size() < noBytes; ++l)
+	{
+		text += lines[l % noLines];
+		text += '\n';
+	}
+
+	return text;
+}
+
+static bool is_special(const char& c)
+{
+	return c == '\\' || c == '<' || c == '-' || c == '@' || c == '$' || c == '\n';
+}
+
+//old loop, one character at a time with indent tracking
+static void output_by_char(const std::string& inStr, std::string& outStr, std::string& indentAmount)
+{
+	for(size_t linePos=0; linePos<inStr.size(); ++linePos)
+	{
+		if(inStr[linePos] == '\n')
+		{
+			outStr += '\n';
+			indentAmount.clear();
+		}
+		else if(is_special(inStr[linePos]))
+		{
+			outStr += inStr[linePos];
+			indentAmount += ' ';
+		}
+		else
+		{
+			if(inStr[linePos] == '\t')
+				indentAmount += '\t';
+			else
+				indentAmount += ' ';
+			outStr += inStr[linePos];
+		}
+	}
+}
+
+//runs between special characters appended in one go, indent kept compact
+static void output_by_run(const std::string& inStr, std::string& outStr, Indent& indentAmount, const bool& scalar)
+{
+	const char* str = inStr.c_str();
+	size_t linePos = 0, endPos;
+	while(linePos < inStr.size())
+	{
+		if(inStr[linePos] == '\n')
+		{
+			outStr += '\n';
+			indentAmount.clear();
+			++linePos;
+			continue;
+		}
+
+		if(scalar)
+			endPos = find_special_scalar(str, linePos+1, inStr.size());
+		else
+			endPos = find_special(str, linePos+1, inStr.size());
+
+		indentAmount.add_text(inStr, linePos, endPos - linePos);
+		outStr.append(inStr, linePos, endPos - linePos);
+		linePos = endPos;
+	}
+}
+
+//MB per second over passes of the template
+static double time_output(const std::string& text, const size_t& noPasses, const int& method, size_t& outSize)
+{
+	auto start = std::chrono::steady_clock::now();
+	for(size_t p=0; p<noPasses; ++p)
+	{
+		std::string outStr, indentStr;
+		Indent indentAmount;
+		if(method == 0)
+			output_by_char(text, outStr, indentStr);
+		else
+			output_by_run(text, outStr, indentAmount, method == 1);
+		outSize = outStr.size();
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	double secs = std::chrono::duration<double>(end - start).count();
+	return (text.size()*noPasses)/(1024.0*1024.0)/secs;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t noMB = 16, noPasses = 10;
+	if(argc > 1)
+		noMB = std::strtoul(argv[1], NULL, 10);
+	if(argc > 2)
+		noPasses = std::strtoul(argv[2], NULL, 10);
+
+	std::string text = make_template(noMB*1024*1024);
+	const char* labels[] = {"by character", "runs (scalar scan)", "runs (best scan)"};
+
+	std::cout << noMB << "MB template, " << noPasses << " passes, best scan is " << special_scanner() << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+	for(int m=0; m<3; ++m)
+	{
+		size_t outSize = 0;
+		double mbPerSec = time_output(text, noPasses, m, outSize);
+		std::cout << std::left << std::setw(22) << labels[m] << std::right << std::setw(10) << mbPerSec << " MB/s";
+		if(outSize != text.size())
+			std::cout << "  (output size " << outSize << ", expected " << text.size() << ")";
+		std::cout << std::endl;
+	}
+
+	return 0;
+}
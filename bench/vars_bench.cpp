@@ -0,0 +1,85 @@
+/*
+	times reading and changing variables through Parser::read_and_process_fn,
+	with the variables a few layers below where they're used, along with a
+	user-defined function that defines a variable of its own.
+
+	usage: make bench-vars
+	       bench/vars_bench (no-calls)
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+
+#include "../Parser.h"
+
+static std::mutex os_mtx;
+
+//nanoseconds per call processing noCalls copies of call, best of noRuns
+static double time_calls(Parser& parser, const std::string& call, const size_t& noCalls)
+{
+	const size_t perStr = 1000, noRuns = 5;
+	std::string inStr, outStr;
+	for(size_t c=0; c<perStr; ++c)
+		inStr += call;
+	std::set<Path> antiDepsOfReadPath;
+	Path readPath("", "bench");
+	double best = -1;
+
+	for(size_t r=0; r<noRuns; ++r)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for(size_t c=0; c<noCalls; c+=perStr)
+		{
+			outStr.clear();
+			if(parser.n_read_and_process_fast(0, 0, inStr, 0, readPath, antiDepsOfReadPath, outStr, std::cout) > 0)
+			{
+				std::cout << "vars_bench: failed to process " << call << std::endl;
+				return -1;
+			}
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		double ns = std::chrono::duration<double, std::nano>(end - start).count()/noCalls;
+		if(best < 0 || ns < best)
+			best = ns;
+	}
+
+	return best;
+}
+
+static void output_row(Parser& parser, const std::string& label, const std::string& call, const size_t& noCalls)
+{
+	std::cout << std::left << std::setw(24) << label << std::setw(20) << call << std::right;
+	std::cout << std::setw(10) << time_calls(parser, call, noCalls) << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t noCalls = 1000000;
+	if(argc > 1)
+		noCalls = std::strtoul(argv[1], NULL, 10);
+
+	std::set<TrackedInfo> trackedAll;
+	Parser parser(&trackedAll, &os_mtx, "content/", "output/", ".content", ".html", ".f", Path("template/", "page.template"), 0, "nano", "notepad");
+
+	std::string trash;
+	std::set<Path> antiDepsOfReadPath;
+	std::string defs = "@:=(std::string, s=\"text\")@:=(int, i=0)@:=(std::int, n=0)@fn(bench_fn){@:=(int, x=1)$[x]}";
+	if(parser.n_read_and_process_fast(0, 0, defs, 0, Path("", "bench"), antiDepsOfReadPath, trash, std::cout) > 0)
+		return 1;
+	for(int l=0; l<4; ++l)
+		parser.vars.add_layer("");
+
+	std::cout << noCalls << " calls each, best of 5 runs" << std::endl;
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << std::left << std::setw(44) << "call" << std::right << std::setw(10) << "ns/call" << std::endl;
+	output_row(parser, "read string", "$[s]", noCalls);
+	output_row(parser, "read int", "$[i]", noCalls);
+	output_row(parser, "increment int", "@++(i)", noCalls);
+	output_row(parser, "increment std::int", "@++(n)", noCalls);
+	output_row(parser, "set string", "@=(s, \"abc\")", noCalls);
+	output_row(parser, "user-defined function", "@bench_fn()", noCalls/10);
+
+	return 0;
+}
@@ -10,6 +10,7 @@
 	https://n-ham.com
 */
 
+#include "BuildWatcher.h"
 #include "GitInfo.h"
 #include "ProjectInfo.h"
 
@@ -72,9 +73,9 @@ int build_auto()
 
 		ofs.open(".build-auto-log.txt");
 
-		if(!parser.run_script(ofs, Path("", "pre-build" + project.scriptExt), project.backupScripts, 1))
+		if(!parser.run_script(ofs, Path("", "pre-build" + project.scriptExt), 1))
 			if(!project.build_updated(ofs, 0, 1, 1))
-				parser.run_script(ofs, Path("", "post-build" + project.scriptExt), project.backupScripts, 1);
+				parser.run_script(ofs, Path("", "post-build" + project.scriptExt), 1);
 
 		ofs.close();
 
@@ -86,6 +87,82 @@ int build_auto()
 	return 0;
 }
 
+#if defined __linux__
+//event driven alternative to build_auto, falls back to polling if inotify is unavailable
+int build_auto_events()
+{
+	std::ofstream ofs;
+	ProjectInfo project;
+	BuildWatcher watcher;
+
+	if(project.open(1))
+	{
+		start_err(std::cout) << "build_auto(): failed to open project, no longer serving" << std::endl;
+		return 1;
+	}
+
+	if(watcher.open(&project))
+	{
+		start_warn(std::cout) << "build_auto(): failed to initialise inotify, polling for changes instead" << std::endl;
+		return build_auto();
+	}
+
+	//brings output up to date before waiting for changes
+	ofs.open(".build-auto-log.txt");
+	project.build_updated(ofs, 0, 1, 1);
+	ofs.close();
+
+	if(watcher.index_all())
+		return 1;
+
+	while(!watcher.wait_for_changes(auto_build))
+	{
+		ofs.open(".build-auto-log.txt");
+
+		if(watcher.reload)
+		{
+			//config or tracking changed so reloads project, including build state
+			buildState.loaded = 0;
+			if(project.open(0))
+			{
+				start_err(ofs) << "build_auto(): failed to reload project" << std::endl;
+				ofs.close();
+				watcher.reload = 0;
+				continue;
+			}
+
+			project.build_updated(ofs, 0, 1, 1);
+			watcher.rewatch = 1;
+		}
+		else if(watcher.retrack)
+		{
+			project.build_updated(ofs, 0, 1, 1);
+			watcher.rewatch = 1;
+		}
+		else
+		{
+			std::vector<Name> names = watcher.changed_names();
+			project.build_names(ofs, 0, names);
+			watcher.reindex(names);
+		}
+
+		ofs.close();
+
+		if(watcher.rewatch && watcher.index_all())
+			return 1;
+	}
+
+	remove_file(Path("./", ".build-auto-log.txt"));
+
+	return 0;
+}
+#else  //other platforms poll for changes
+int build_auto_events()
+{
+	return build_auto();
+}
+#endif
+
 void unrecognisedCommand(const std::string& cmd)
 {
 	start_err(std::cout) << "Nift does not recognise the command " << quote(cmd) << std::endl;
@@ -282,7 +359,8 @@ int main(int argc, const char* argv[])
 		std::cout << "| sh                | par: (lang-opt)                          |" << std::endl;
 		std::cout << "| build-names       | par: name-1 .. name-k                    |" << std::endl;
 		std::cout << "| build(-updated)   | build updated output files               |" << std::endl;
-		std::cout << "| build-all         | build all tracked output files           |" << std::endl;
+		std::cout << "| build-all         | par: (--shard i/n)                       |" << std::endl;
+		std::cout << "| build.. --profile | also write build trace & slowest files   |" << std::endl;
 		std::cout << "| build-auto        | par: (sleep-sec)                         |" << std::endl;
 		std::cout << "| browse            | browse page: (name or path)              |" << std::endl;
 		std::cout << "| mve-output-dir    | par: dir-path                            |" << std::endl;
@@ -295,6 +373,10 @@ int main(int argc, const char* argv[])
 		std::cout << "| no-build-thrds    | par: (no-threads) [-n == n*cores]        |" << std::endl;
 		std::cout << "| backup-scripts    | par: (option)                            |" << std::endl;
 		std::cout << "| incr-mode         | par: (mode)                              |" << std::endl;
+		std::cout << "| build-state       | par: (files or database)                 |" << std::endl;
+		std::cout << "| build-stats       | par: (no-slowest)                        |" << std::endl;
+		std::cout << "| merge-build-state | par: (fragment-1 .. fragment-k)          |" << std::endl;
+		std::cout << "| clean             | remove cached @system/@script output     |" << std::endl;
 		std::cout << "| watch             | par: dir (cont-ext) (template) (out-ext) |" << std::endl;
 		std::cout << "| unwatch           | par: dir (cont-ext)                      |" << std::endl;
 		std::cout << "| edit or open      | par: name-1 .. name-k                    |" << std::endl;
@@ -390,7 +472,7 @@ int main(int argc, const char* argv[])
 			project.track(name, title, Path("templates/", "template.js"), ".js", ".js");
 
 
-			project.build_all(std::cout, 0);
+			project.build_all(std::cout, 0, 1, 1);
 		}
 		else
 		{
@@ -1080,6 +1162,10 @@ int main(int argc, const char* argv[])
 		   cmd != "info-tracking" &&
 		   cmd != "info-watching" &&
 		   cmd != "incr-mode" &&
+		   cmd != "build-state" &&
+		   cmd != "build-stats" &&
+		   cmd != "clean" &&
+		   cmd != "merge-build-state" &&
 		   cmd != "open" &&
 		   cmd != "track" &&
 		   cmd != "track-from-file" &&
@@ -1206,6 +1292,24 @@ int main(int argc, const char* argv[])
 		if(project.open_local_config(1))
 			return 1;
 
+		//strips --profile from build commands, spans are recorded until the build finishes
+		if(cmd == "build" || cmd == "build-names" || cmd == "build-updated" || cmd == "build-all")
+		{
+			for(int p=2; p<argc; ++p)
+			{
+				if(std::string(argv[p]) == "--profile")
+				{
+					for(int q=p; q+1<argc; ++q)
+						argv[q] = argv[q+1];
+					--argc;
+					--noParams;
+					profiler.enabled = 1;
+					profiler.start();
+					break;
+				}
+			}
+		}
+
 		if(cmd == "build")
 		{
 			if(noParams == 1 || (noParams == 2 && argv[2][0] == '-'))
@@ -1449,6 +1553,64 @@ int main(int argc, const char* argv[])
 			else
 				return project.set_incr_mode(argv[2]);
 		}
+		else if(cmd == "build-state")
+		{
+			if(noParams > 2)
+				return parError(noParams, argv, "1-2");
+
+			if(noParams == 1)
+			{
+				if(project.buildStateMode == BSTATE_DB)
+					std::cout << "database" << std::endl;
+				else
+					std::cout << "files" << std::endl;
+
+				return 0;
+			}
+			else
+				return project.set_build_state(argv[2]);
+		}
+		else if(cmd == "merge-build-state")
+		{
+			std::vector<Path> fragmentPaths;
+			for(int p=2; p<=noParams; ++p)
+				fragmentPaths.push_back(Path(std::string(argv[p])));
+
+			return project.merge_build_state(fragmentPaths);
+		}
+		else if(cmd == "build-stats")
+		{
+			if(noParams > 2)
+				return parError(noParams, argv, "1-2");
+
+			size_t noSlowest = 5;
+			if(noParams == 2)
+			{
+				if(!isNonNegInt(std::string(argv[2])))
+				{
+					start_err(std::cout) << "build-stats: number of slowest files should be a non-negative integer" << std::endl;
+					return 1;
+				}
+				noSlowest = std::atoi(argv[2]);
+			}
+
+			return pageScheduler.report(std::cout, noSlowest);
+		}
+		else if(cmd == "clean")
+		{
+			//ensures correct number of parameters given
+			if(noParams != 1)
+				return parError(noParams, argv, "1");
+
+			if(sysCache.clean())
+			{
+				start_err(std::cout) << "clean: failed to remove " << Path(".nift/sys-cache/", "") << std::endl;
+				return 1;
+			}
+
+			std::cout << "removed cached @system/@script output" << std::endl;
+			return 0;
+		}
 		else if(cmd == "watch")
 		{
 			//ensures correct number of parameters given
@@ -2222,6 +2384,9 @@ int main(int argc, const char* argv[])
 				}
 			}
 
+			if(profiler.enabled)
+				profiler.save(std::cout, 10);
+
 			std::cout.precision(4);
 			std::cout << "time taken: " << timer.getTime() << " seconds" << std::endl;
 
@@ -2255,6 +2420,9 @@ int main(int argc, const char* argv[])
 			else
 				result = project.build_names(std::cout, 2, namesToBuild);
 
+			if(profiler.enabled)
+				profiler.save(std::cout, 10);
+
 			std::cout.precision(4);
 			std::cout << "time taken: " << timer.getTime() << " seconds" << std::endl;
 
@@ -2263,28 +2431,47 @@ int main(int argc, const char* argv[])
 		else if(cmd == "build-all")
 		{
 			//ensures correct number of parameters given
-			if(noParams > 2)
-				return parError(noParams, argv, "1-2");
+			if(noParams > 4)
+				return parError(noParams, argv, "1-4");
 
-			int result;
+			int result, addBuildStatus = 0, shard = 1, noShards = 1;
 
-			if(noParams == 1)
-				result = project.build_all(std::cout, 0);
-			else
+			for(int p=2; p<=noParams; ++p)
 			{
-				std::string optStr = argv[2];
+				std::string optStr = argv[p];
 
 				if(optStr == "-p")
-					result = project.build_all(std::cout, 1);
+					addBuildStatus = 1;
 				else if(optStr == "-n")
-					result = project.build_all(std::cout, 2);
+					addBuildStatus = 2;
+				else if(optStr == "--shard" && p < noParams)
+				{
+					//shard given as i/n with 1 <= i <= n
+					std::string shardStr = argv[++p];
+					size_t slashPos = shardStr.find('/');
+					if(slashPos == std::string::npos || 
+					   !isPosInt(shardStr.substr(0, slashPos)) || 
+					   !isPosInt(shardStr.substr(slashPos+1)) ||
+					   std::atoi(shardStr.substr(0, slashPos).c_str()) > std::atoi(shardStr.substr(slashPos+1).c_str()))
+					{
+						start_err(std::cout) << "build-all: shard should be of the form i/n with 1 <= i <= n, got " << quote(shardStr) << std::endl;
+						return 1;
+					}
+					shard = std::atoi(shardStr.substr(0, slashPos).c_str());
+					noShards = std::atoi(shardStr.substr(slashPos+1).c_str());
+				}
 				else
 				{
-					start_err(std::cout) << "do not recognise build-all option " << quote(argv[2]) << std::endl;
+					start_err(std::cout) << "do not recognise build-all option " << quote(argv[p]) << std::endl;
 					return 1;
 				}
 			}
 
+			result = project.build_all(std::cout, addBuildStatus, shard, noShards);
+
+			if(profiler.enabled)
+				profiler.save(std::cout, 10);
+
 			std::cout.precision(4);
 			std::cout << "time taken: " << timer.getTime() << " seconds" << std::endl;
 
@@ -2296,8 +2483,11 @@ int main(int argc, const char* argv[])
 			if(noParams > 2)
 				return parError(noParams, argv, "1 or 2");
 
+			bool pollForChanges = 0;
+
 			if(noParams == 2 && isDouble(std::string(argv[2])))
 			{
+				pollForChanges = 1;
 				double sleepTimeSec = std::strtod(argv[2], NULL);
 				sleepTime = sleepTimeSec*1000000;
 				noParams = 1;
@@ -2326,12 +2516,12 @@ int main(int argc, const char* argv[])
 			      project.winTextEditor);
 
 			//checks for pre-build-auto scripts
-			if(parser.run_script(std::cout, Path("", "pre-build-auto" + project.scriptExt), project.backupScripts, 1))
+			if(parser.run_script(std::cout, Path("", "pre-build-auto" + project.scriptExt), 1))
 				return 1;
 
 			auto_build = 1;
 
-			std::thread build_auto_thread(build_auto);
+			std::thread build_auto_thread(pollForChanges ? build_auto : build_auto_events);
 			if(noParams == 1)
 			{
 				std::thread read_build_auto_commands_thread(read_build_auto_commands);
@@ -2340,7 +2530,7 @@ int main(int argc, const char* argv[])
 			build_auto_thread.join();
 
 			//checks for post-build-auto scripts
-			if(parser.run_script(std::cout, Path("", "post-build-auto" + project.scriptExt), project.backupScripts, 1))
+			if(parser.run_script(std::cout, Path("", "post-build-auto" + project.scriptExt), 1))
 				return 1;
 		}
 		else if(cmd == "browse")
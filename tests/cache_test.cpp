@@ -0,0 +1,121 @@
+/*
+	checks the hit and miss paths of the file cache and the @system/@script
+	output cache: unchanged files are handed back from the cache, changed
+	files are reread, missing files and directories are reported and never
+	cached, and cached command output is only reused for the same key.
+
+	usage: make test
+	       tests/cache_test
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../FileCache.h"
+#include "../SysCache.h"
+
+static int noFailed = 0;
+
+static void check(const bool& passed, const std::string& what)
+{
+	if(!passed)
+	{
+		std::cout << "FAILED: " << what << std::endl;
+		++noFailed;
+	}
+}
+
+static void write_file(const std::string& pathStr, const std::string& str)
+{
+	std::ofstream ofs(pathStr, std::ios::binary);
+	ofs << str;
+}
+
+int main()
+{
+	char dir[] = "/tmp/nsm-cache-test.XXXXXX";
+	if(!mkdtemp(dir) || chdir(dir))
+	{
+		std::cout << "FAILED: cannot make temporary directory" << std::endl;
+		return 1;
+	}
+
+	//file cache hits and misses
+	{
+		write_file("a.txt", "hello");
+		std::shared_ptr<const FileContents> first = fileCache.get("a.txt");
+		check(first->ok && first->str == "hello", "file not read");
+		check(first->hash == FNVHash("hello"), "file hashed incorrectly");
+		check(fileCache.get("a.txt") == first, "unchanged file not handed back from cache");
+
+		write_file("a.txt", "hello world");
+		std::shared_ptr<const FileContents> second = fileCache.get("a.txt");
+		check(second != first, "changed file handed back from cache");
+		check(second->ok && second->str == "hello world", "changed file not reread");
+		check(first->str == "hello", "contents changed under an earlier reader");
+
+		std::shared_ptr<const FileContents> missing = fileCache.get("missing.txt");
+		check(!missing->ok && missing->str == "", "missing file not reported");
+		write_file("missing.txt", "here now");
+		std::shared_ptr<const FileContents> found = fileCache.get("missing.txt");
+		check(found->ok && found->str == "here now", "missing file was cached");
+
+		mkdir("d", 0755);
+		check(!fileCache.get("d")->ok, "directory read as a file");
+
+		write_file("nul.txt", std::string("before\0after", 12));
+		check(fileCache.get("nul.txt")->str == "before", "contents not cut at null character");
+
+		fileCache.clear();
+		check(fileCache.get("a.txt") != second, "cache not cleared");
+	}
+
+	//command output cache hits and misses outside of a project
+	{
+		std::vector<std::string> inputs(1, "a.txt"), envVars(1, "NSM_CACHE_TEST");
+		unsetenv("NSM_CACHE_TEST");
+		std::string key = sys_cache_key("cat a.txt", inputs, envVars), output;
+
+		check(!sysCache.get(key, output) && sysCache.noMisses == 1, "empty cache hit");
+		sysCache.put(key, "out");
+		check(sysCache.get(key, output) && output == "out" && sysCache.noHits == 1, "cached output missed");
+
+		write_file("a.txt", "changed");
+		check(sys_cache_key("cat a.txt", inputs, envVars) != key, "key ignores input file contents");
+		setenv("NSM_CACHE_TEST", "1", 1);
+		fileCache.clear();
+		write_file("a.txt", "hello world");
+		check(sys_cache_key("cat a.txt", inputs, envVars) != key, "key ignores environment variables");
+		unsetenv("NSM_CACHE_TEST");
+		check(sys_cache_key("cat a.txt", inputs, envVars) == key, "key not reproducible");
+		check(sys_cache_key("cat  a.txt", inputs, envVars) != key, "key ignores command");
+		check(!chdir("d") && sys_cache_key("cat a.txt", inputs, envVars) != key, "key ignores working directory");
+		check(!chdir(".."), "cannot change back to temporary directory");
+	}
+
+	//command output kept across builds inside a project
+	{
+		mkdir(".nift", 0755);
+		std::string key = sys_cache_key("echo kept", std::vector<std::string>(), std::vector<std::string>()), output;
+		sysCache.put(key, "kept");
+
+		SysCache nextBuild;
+		check(nextBuild.get(key, output) && output == "kept", "output not kept across builds");
+		check(!nextBuild.get(key + " ", output), "output reused for a different key");
+
+		check(nextBuild.clean() == 0 && !dir_exists(".nift/sys-cache/"), "cached output not removed");
+		check(!SysCache().get(key, output), "output kept after cleaning");
+	}
+
+	if(system(("rm -rf " + std::string(dir)).c_str()))
+		std::cout << "cache_test: failed to remove " << dir << std::endl;
+
+	if(noFailed)
+		return 1;
+	std::cout << "cache_test: ok" << std::endl;
+	return 0;
+}
@@ -0,0 +1,105 @@
+/*
+	checks building output as slices and writing it out: appended text
+	stays where it is as chunks fill up, spliced text is referred to in
+	place with neighbouring slices joined, and writes of more slices than
+	one writev takes are written in full and left alone when unchanged.
+
+	usage: make test
+	       tests/sink_test
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../OutputWriter.h"
+
+static int noFailed = 0;
+
+static void check(const bool& passed, const std::string& what)
+{
+	if(!passed)
+	{
+		std::cout << "FAILED: " << what << std::endl;
+		++noFailed;
+	}
+}
+
+static std::string read_file(const std::string& pathStr)
+{
+	std::ifstream ifs(pathStr, std::ios::binary);
+	std::stringstream ss;
+	ss << ifs.rdbuf();
+	return ss.str();
+}
+
+int main()
+{
+	char dir[] = "/tmp/nsm-sink-test.XXXXXX";
+	if(!mkdtemp(dir) || chdir(dir))
+	{
+		std::cout << "FAILED: cannot make temporary directory" << std::endl;
+		return 1;
+	}
+
+	//appended text is copied and stays valid as chunks fill up
+	{
+		OutputSink sink;
+		std::string expected, line;
+		for(size_t l=0; l<20000; ++l)
+		{
+			line = "line " + std::to_string(l) + "\n";
+			sink.append(line);
+			expected += line;
+		}
+		check(sink.size() == expected.size() && sink.str() == expected, "appended text changed as chunks filled up");
+		check(sink.chunks.size() > 1 && sink.slices.size() == sink.chunks.size(), "appends to the same chunk not joined in to one slice");
+	}
+
+	//spliced text is referred to where it is, neighbouring pieces are joined
+	{
+		std::string str = "hello world";
+		OutputSink sink;
+		sink.splice(str, 0, 5);
+		sink.splice(str, 5, 6);
+		sink.splice("", 0);
+		check(sink.slices.size() == 1 && sink.slices[0].str == str.c_str(), "neighbouring splices not joined");
+		sink.append("!");
+		check(sink.slices.size() == 2 && sink.str() == "hello world!", "append after splice gave wrong output");
+	}
+
+	//more slices than one writev call takes
+	{
+		std::vector<std::string> pieces;
+		for(size_t p=0; p<5000; ++p)
+			pieces.push_back(std::to_string(p) + " ");
+
+		OutputSink sink;
+		for(size_t p=0; p<pieces.size(); ++p)
+			sink.splice(pieces[p]);
+		check(sink.slices.size() == pieces.size(), "separate strings joined in to one slice");
+
+		outputWriter.reset();
+		check(outputWriter.write(Path("", "many.txt"), sink) == 0, "failed to write many slices");
+		check(read_file("many.txt") == sink.str(), "many slices written incorrectly");
+		check(outputWriter.noWritten == 1, "file with many slices not counted as written");
+
+		struct stat before, after;
+		stat("many.txt", &before);
+		check(outputWriter.write(Path("", "many.txt"), sink) == 0 && outputWriter.noSkipped == 1, "unchanged output not skipped");
+		stat("many.txt", &after);
+		check(before.st_ino == after.st_ino && before.st_mtime == after.st_mtime, "unchanged output rewritten");
+	}
+
+	if(system(("rm -rf " + std::string(dir)).c_str()))
+		std::cout << "sink_test: failed to remove " << dir << std::endl;
+
+	if(noFailed)
+		return 1;
+	std::cout << "sink_test: ok" << std::endl;
+	return 0;
+}
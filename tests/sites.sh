@@ -0,0 +1,227 @@
+#!/bin/bash
+# builds small generated projects with nsm and checks what comes out
+#
+# usage: tests/sites.sh (path-to-nsm)
+#
+#   TESTS_KEEP    set to 1 to keep the generated projects
+
+NSM=$(cd "$(dirname "${1:-./nsm}")" && pwd)/$(basename "${1:-./nsm}")
+
+if [ ! -x "$NSM" ]; then
+	echo "sites: cannot find nsm binary $NSM, run make first" >&2
+	exit 1
+fi
+
+WORK=$(mktemp -d "${TMPDIR:-/tmp}/nsm-tests.XXXXXX")
+NO_FAILED=0
+
+cleanup()
+{
+	if [ "$TESTS_KEEP" != "1" ]; then
+		chmod -R u+w "$WORK" 2>/dev/null || true
+		rm -rf "$WORK"
+	else
+		echo "sites: projects kept in $WORK"
+	fi
+}
+trap cleanup EXIT
+
+fail()
+{
+	echo "FAILED: $1"
+	NO_FAILED=$((NO_FAILED+1))
+}
+
+# new_site name: makes a fresh project and moves in to it
+new_site()
+{
+	cd "$WORK"
+	mkdir "$1"
+	cd "$1"
+	"$NSM" init .html > /dev/null 2>&1
+	printf '@content\n' > templates/page.html
+}
+
+# track_pages dir: tracks every content file in content/dir
+track_pages()
+{
+	"$NSM" track-dir "content/$1/" .html templates/page.html > /dev/null 2>&1
+}
+
+## corrupt shard fragments are reported and their shard's pages rebuilt
+
+new_site shards
+"$NSM" build-state database > /dev/null 2>&1
+mkdir -p content/pages
+for p in 1 2 3 4 5 6 7 8; do
+	echo "page $p" > content/pages/p$p.html
+done
+track_pages pages
+"$NSM" build-all --shard 1/2 > /dev/null 2>&1
+noInShard=$("$NSM" build-all --shard 2/2 2>&1 | sed -n 's/.*all \([0-9]*\) tracked files in shard 2\/2 built.*/\1/p')
+cp .nift/build-state.shard-1-of-2.db shard-1.db
+cp .nift/build-state.shard-2-of-2.db shard-2.db
+"$NSM" merge-build-state shard-1.db shard-2.db > /dev/null 2>&1 || fail "merge-build-state failed"
+"$NSM" status 2>&1 | grep -q "tracked files are already up to date" || fail "pages need building after merging shards"
+rm .nift/build-state.db
+"$NSM" merge-build-state shard-1.db > /dev/null 2>&1
+echo "not a build state" > .nift/build-state.shard-2-of-2.db
+if "$NSM" merge-build-state .nift/build-state.shard-2-of-2.db > merge.log 2>&1; then
+	fail "merge-build-state succeeded with a corrupt fragment"
+fi
+grep -q "shard 2/2 will be rebuilt" merge.log || fail "corrupt fragment not reported"
+noToBuild=$("$NSM" status -a 2>&1 | grep -c "yet to be built")
+[ -n "$noInShard" ] && [ "$noToBuild" = "$noInShard" ] || fail "expected $noInShard pages from corrupt shard to need building, got $noToBuild"
+
+## compiled exprtk expressions are reused until their symbols go away
+
+new_site exprcache
+cat > content/index.html <<'EOF'
+@exprtk.cache_hits @exprtk.cache_misses
+$`1+2`
+$`1+2`
+@:=(double, x=3)
+$`x*2`
+$`x*2`
+@forget(x)
+@:=(double, x=5)
+$`x*2`
+@exprtk.cache_hits @exprtk.cache_misses
+EOF
+printf '@content\n' > templates/template.html
+"$NSM" build-all > /dev/null 2>&1 || fail "exprcache build failed"
+values=$(tr -s ' \t\n' ' ' < output/index.html)
+set -- $values
+[ "$3 $4 $5 $6 $7" = "3 3 6 6 10" ] || fail "cached expressions gave wrong values: $values"
+[ "$(($8-$1)) $(($9-$2))" = "2 3" ] || fail "expected 2 expression cache hits and 3 misses: $values"
+
+## each page's lua scripts get the nsm functions and none of the last page's globals
+
+new_site luapages
+"$NSM" no-build-thrds 1 > /dev/null 2>&1
+"$NSM" new-script-ext .lua > /dev/null 2>&1
+mkdir -p content/pages
+for p in 1 2 3; do
+	echo "page $p" > content/pages/p$p.html
+	printf 'print("p%s " .. tostring(sys ~= nil) .. " " .. tostring(leaked))\nleaked = %s\n' $p $p > content/pages/p$p-pre-build.lua
+done
+track_pages pages
+"$NSM" build-all 2>&1 | grep "^p[0-9] " > lua.log
+[ "$(cat lua.log | tr '\n' ' ')" = "p1 true nil p2 true nil p3 true nil " ] || fail "lua state not reset between pages: $(cat lua.log | tr '\n' ' ')"
+
+## function bodies are split again once changed from lua or redefined
+
+new_site fnbodies
+cat > content/index.html <<'EOF'
+@fn(f) {hello}
+@f
+@lua_pushlightuserdata(f)
+@lua_setglobal(fbody)
+@lua_addnsmfns
+@lua{!o}
+{
+	nsm_setstring(fbody, "bye")
+}
+@f
+@f
+@forget(f)
+@fn(f) {again}
+@f
+EOF
+printf '@content\n' > templates/template.html
+"$NSM" build-all > /dev/null 2>&1 || fail "fnbodies build failed"
+[ "$(tr -s ' \t\n' ' ' < output/index.html)" = "hello bye bye again " ] || fail "stale function body used: $(tr -s ' \t\n' ' ' < output/index.html)"
+
+## unchanged pagination pages are left alone unless their items read something volatile
+
+new_site pagination
+printf '@content\n' > templates/template.html
+# write_items note: pages of items where item 3 has note added
+write_items()
+{
+	echo '@paginate.no_items_per_page(2)'
+	echo '@paginate'
+	printf '@item\n{\n\titem %s\n}\n' 1 2 "3 $1" 4
+	printf '@item\n{\n\t$[build-time]\n}\n@item\n{\n\titem 6\n}\n'
+	printf '@item\n{\n\t@pathto(/)\n}\n@item\n{\n\titem 8\n}\n'
+}
+# no_paginated: number of pagination pages built by the last profiled build
+no_paginated()
+{
+	grep -o '"name": "paginate"' .nift/profile.json | wc -l
+}
+write_items > content/index.html
+"$NSM" build-all --profile > /dev/null 2>&1 || fail "pagination build failed"
+[ "$(no_paginated)" = "4" ] || fail "expected 4 pagination pages built, got $(no_paginated)"
+"$NSM" build-all --profile > /dev/null 2>&1
+[ "$(no_paginated)" = "2" ] || fail "expected only the 2 pages reading the time and paths rebuilt, got $(no_paginated)"
+write_items edited > content/index.html
+"$NSM" build-all --profile > /dev/null 2>&1
+[ "$(no_paginated)" = "3" ] || fail "expected the page with an edited item rebuilt as well, got $(no_paginated)"
+grep -rq "item 3 edited" output || fail "edited item not in output"
+"$NSM" new-title / "renamed" > /dev/null 2>&1
+"$NSM" build-all --profile > /dev/null 2>&1
+[ "$(no_paginated)" = "4" ] || fail "expected every page rebuilt once retitled, got $(no_paginated)"
+
+## pages whose pagination template changes variables are always built, later pages rely on the changes
+
+new_site pagetemplate
+printf '@content\n' > templates/template.html
+{
+	echo '@paginate.no_items_per_page(1)'
+	printf '@paginate.template\n{\n\t@if($[paginate.page_no] == 1)\n\t{\n\t\t@:={layer=0}(int, counter=0)\n\t}\n'
+	printf '\t@++(counter)\n\tcount $[counter]\n\t$[paginate.page]\n}\n'
+	echo '@paginate'
+	printf '@item\n{\n\titem 1\n}\n@item\n{\n\t$[build-time]\n}\n@item\n{\n\titem 3\n}\n'
+} > content/index.html
+"$NSM" build-all --profile > /dev/null 2>&1 || fail "pagination template build failed"
+"$NSM" build-all --profile > build.log 2>&1
+grep -q "error" build.log && fail "pagination template failed once pages were skipped: $(grep error build.log | head -1)"
+[ "$(no_paginated)" = "3" ] || fail "expected every page with a counter in its template rebuilt, got $(no_paginated)"
+[ "$(grep -h count output/*.html | sort | tr -d '\t\n')" = "count 1count 2count 3" ] || fail "pagination template counter off: $(grep -h count output/*.html | tr -d '\t\n')"
+
+## pagination pages are spliced in to the page's output, indented where paginate was called
+
+new_site splice
+printf '<ul>\n\t@content\n</ul>\n' > templates/template.html
+printf '@paginate.no_items_per_page(2)\n@paginate.separator(<hr>)\n@paginate\n' > content/index.html
+printf '@item\n{\n\t<li>%s</li>\n\t<li>%s</li>\n}\n' 1 2 3 4 5 6 >> content/index.html
+"$NSM" build-all > /dev/null 2>&1 || fail "splice build failed"
+[ "$(cat output/index.html)" = "$(printf '<ul>\n\t\n\t<li>1</li>\n\t<li>2</li><hr><li>3</li>\n\t<li>4</li>\n</ul>')" ] || fail "first page spliced incorrectly: $(cat output/index.html)"
+[ "$(cat output/-2.html)" = "$(printf '<ul>\n\t\n\t<li>5</li>\n\t<li>6</li>\n</ul>')" ] || fail "second page spliced incorrectly: $(cat output/-2.html)"
+
+## pagination items rendered in parallel come out as if rendered one at a time
+
+new_site parallel
+sed -i 's/"paginate-threads": -\?[0-9]*/"paginate-threads": 4/' .nift/config.json
+printf '@content\n' > templates/template.html
+{
+	echo '@:=(int, total=0)'
+	echo '@paginate.no_items_per_page(4)'
+	echo '@paginate'
+	for i in $(seq 1 1200); do
+		printf '@item\n{\n'
+		case $i in
+			300) printf "\t\$\`println('printed 300')\`\n" ;;
+			500) printf '\t@sys("echo ran >> sys.log")\n' ;;
+			700) printf '\t@+=(total, 1)\n' ;;
+		esac
+		printf '\t@exprtk(1) item %s $`%s*2` $[total]\n}\n' $i $i
+	done
+} > content/index.html
+"$NSM" build-all --profile > build.log 2>&1 || fail "parallel build failed"
+noThreads=$(grep '"name": "@exprtk"' .nift/profile.json | grep -o '"tid": [0-9]*' | sort -u | wc -l)
+[ "$noThreads" -gt 1 ] || fail "items not rendered in parallel"
+for i in $(seq 1 1200); do
+	echo "item $i $((i*2)) $((i >= 700))"
+done | sort > expected.txt
+cat output/*.html | grep -o 'item [0-9]* [0-9]* [0-9]*' | sort > got.txt
+cmp -s expected.txt got.txt || fail "items rendered in parallel differ from sequential rendering"
+[ "$(grep -c "printed 300" build.log)" = "1" ] || fail "exprtk output from items printed $(grep -c "printed 300" build.log) times"
+[ "$(cat sys.log 2>/dev/null | wc -l)" = "1" ] || fail "command in items run $(cat sys.log 2>/dev/null | wc -l) times"
+
+if [ "$NO_FAILED" != "0" ]; then
+	echo "sites: $NO_FAILED failed"
+	exit 1
+fi
+echo "sites: ok"
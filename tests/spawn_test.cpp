@@ -0,0 +1,128 @@
+/*
+	checks spawning commands with captured output: output and exit statuses
+	come back, scripts without a #! line run with the shell, capturing stops
+	once the command exits even with something left running in the
+	background, timeouts kill the command and threads can spawn at the same
+	time.
+
+	usage: make test
+	       tests/spawn_test
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+#include "../Spawn.h"
+
+static int noFailed = 0;
+
+static void check(const bool& passed, const std::string& what)
+{
+	if(!passed)
+	{
+		std::cout << "FAILED: " << what << std::endl;
+		++noFailed;
+	}
+}
+
+static double seconds_since(const std::chrono::steady_clock::time_point& start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void spawn_task(const int t, bool* passed)
+{
+	bool timedOut;
+	std::string output;
+	int status = spawn_shell("echo " + std::to_string(t), &output, 0, timedOut);
+	*passed = (status == 0 && output == std::to_string(t) + "\n");
+}
+
+int main()
+{
+	bool timedOut;
+
+	{
+		std::string output;
+		int status = spawn_shell("echo hello; exit 3", &output, 0, timedOut);
+		check(output == "hello\n", "output not captured");
+		check(WIFEXITED(status) && WEXITSTATUS(status) == 3, "exit status not returned");
+	}
+
+	{
+		std::vector<std::string> args;
+		args.push_back("printf");
+		args.push_back("%s|");
+		args.push_back("a b");
+		args.push_back("\"c\"");
+		std::string output;
+		check(spawn_argv(args, &output, 0, timedOut) == 0, "spawn_argv failed");
+		check(output == "a b|\"c\"|", "arguments not passed unchanged");
+	}
+
+	//scripts without a #! line are run with the shell
+	{
+		char dir[] = "/tmp/nsm-spawn-test.XXXXXX";
+		check(mkdtemp(dir) != NULL, "cannot make temporary directory");
+		std::string scriptPath = std::string(dir) + "/script";
+		std::ofstream(scriptPath.c_str()) << "echo \"script $1\"\n";
+		chmod(scriptPath.c_str(), 0755);
+
+		std::vector<std::string> args;
+		args.push_back(scriptPath);
+		args.push_back("ran");
+		std::string output;
+		check(spawn_argv(args, &output, 0, timedOut) == 0 && output == "script ran\n", "script without #! line not run");
+
+		std::remove(scriptPath.c_str());
+		rmdir(dir);
+	}
+
+	//more than fits in a pipe, written right before exiting
+	{
+		std::string output;
+		spawn_shell("head -c 1000000 /dev/zero | tr '\\0' x", &output, 0, timedOut);
+		check(output.size() == 1000000 && output.find_first_not_of('x') == std::string::npos, "large output not captured in full");
+	}
+
+	//the background sleep keeps the pipe open after the shell exits
+	{
+		std::string output;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		int status = spawn_shell("echo started; sleep 5 &", &output, 0, timedOut);
+		check(seconds_since(start) < 2, "capture waited on a background command");
+		check(status == 0 && output == "started\n", "output before background command lost");
+	}
+
+	{
+		std::string output;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		spawn_shell("echo before; sleep 5", &output, 0.3, timedOut);
+		check(timedOut && seconds_since(start) < 2, "command not killed on timing out");
+		check(output == "before\n", "output before timing out lost");
+	}
+
+	{
+		std::thread threads[8];
+		bool passed[8];
+		for(int t=0; t<8; ++t)
+			threads[t] = std::thread(spawn_task, t, &passed[t]);
+		for(int t=0; t<8; ++t)
+		{
+			threads[t].join();
+			check(passed[t], "spawning from thread " + std::to_string(t) + " failed");
+		}
+	}
+
+	if(noFailed)
+		return 1;
+	std::cout << "spawn_test: ok" << std::endl;
+	return 0;
+}
@@ -0,0 +1,106 @@
+/*
+	checks waiting on thread pool task groups: every task has run by the
+	time wait returns, groups on the stack can go straight after waiting,
+	nested waits make progress and a wait only runs its own group's tasks.
+
+	usage: make test
+	       tests/threadpool_test
+*/
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+#include "../ThreadPool.h"
+
+static int noFailed = 0;
+
+static void check(const bool& passed, const std::string& what)
+{
+	if(!passed)
+	{
+		std::cout << "FAILED: " << what << std::endl;
+		++noFailed;
+	}
+}
+
+static void count_task(std::atomic<size_t>* count)
+{
+	++*count;
+}
+
+//submits and waits on an inner group from inside a pool task
+static void nested_task(std::atomic<size_t>* count, const size_t& noInner)
+{
+	TaskGroup inner;
+	for(size_t i=0; i<noInner; ++i)
+		threadPool.submit(std::bind(count_task, count), &inner);
+	threadPool.wait(inner);
+}
+
+static void blocked_task(std::atomic<bool>* release)
+{
+	while(!*release)
+		std::this_thread::yield();
+}
+
+static void note_thread_task(std::thread::id* ranOn)
+{
+	*ranOn = std::this_thread::get_id();
+}
+
+int main()
+{
+	threadPool.ensure(4);
+
+	//groups live on the stack and are destroyed as soon as wait returns
+	for(size_t r=0; r<2000; ++r)
+	{
+		std::atomic<size_t> count(0);
+		TaskGroup group;
+		for(size_t t=0; t<8; ++t)
+			threadPool.submit(std::bind(count_task, &count), &group);
+		threadPool.wait(group);
+		if(count != 8)
+		{
+			check(0, "tasks still pending after wait");
+			break;
+		}
+	}
+
+	//tasks which wait on groups of their own
+	{
+		std::atomic<size_t> count(0);
+		TaskGroup outer;
+		for(size_t t=0; t<64; ++t)
+			threadPool.submit(std::bind(nested_task, &count, 16), &outer);
+		threadPool.wait(outer);
+		check(count == 64*16, "nested waits did not run every task");
+	}
+
+	//a wait leaves other groups' tasks for the pool
+	{
+		std::atomic<bool> release(0);
+		std::thread::id otherRanOn;
+		std::atomic<size_t> count(0);
+		TaskGroup blockers, other, mine;
+
+		for(size_t t=0; t<4; ++t)
+			threadPool.submit(std::bind(blocked_task, &release), &blockers);
+		threadPool.submit(std::bind(note_thread_task, &otherRanOn), &other);
+		threadPool.submit(std::bind(count_task, &count), &mine);
+		threadPool.wait(mine);
+		check(count == 1, "wait did not run its own task");
+		check(otherRanOn != std::this_thread::get_id(), "wait ran a task from another group");
+
+		release = 1;
+		threadPool.wait(blockers);
+		threadPool.wait(other);
+		check(otherRanOn != std::thread::id(), "task from other group never ran");
+	}
+
+	if(noFailed)
+		return 1;
+	std::cout << "threadpool_test: ok" << std::endl;
+	return 0;
+}